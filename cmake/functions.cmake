@@ -54,3 +54,50 @@ function(erhe_target_sources_grouped target)
     target_sources("${target}" PRIVATE "${ARGV${i}}")
   endforeach()
 endfunction()
+
+# ---- Add benchmark executable ----
+
+#[==[
+Adds a headless benchmark or check executable, when ERHE_BUILD_BENCHMARKS is
+ON. Otherwise does nothing.
+
+erhe_add_benchmark(<target>
+                   [RUNTIME_OUTPUT_DIRECTORY <dir>]
+                   SOURCES <files>...
+                   LIBRARIES <libraries>...)
+
+Sources are relative to the calling CMakeLists.txt directory, which is also
+added to include directories. RUNTIME_OUTPUT_DIRECTORY is for benchmarks
+which load resources relative to working directory; it is also used as
+Visual Studio debugger working directory.
+]==]
+function(erhe_add_benchmark target)
+  if(NOT ${ERHE_BUILD_BENCHMARKS})
+    return()
+  endif()
+
+  cmake_parse_arguments(PARSE_ARGV 1 arg "" "RUNTIME_OUTPUT_DIRECTORY" "SOURCES;LIBRARIES")
+  if(NOT arg_SOURCES)
+    message(FATAL_ERROR "erhe_add_benchmark(${target}): SOURCES missing")
+  endif()
+
+  add_executable(${target})
+  erhe_target_sources_grouped(${target} TREE "${CMAKE_CURRENT_SOURCE_DIR}" FILES ${arg_SOURCES})
+  target_link_libraries(${target} PRIVATE ${arg_LIBRARIES})
+  target_include_directories(${target} PRIVATE ${CMAKE_CURRENT_SOURCE_DIR})
+  set_target_properties(
+    ${target} PROPERTIES
+    CXX_STANDARD          20
+    CXX_STANDARD_REQUIRED YES
+    CXX_EXTENSIONS        NO
+  )
+  if(arg_RUNTIME_OUTPUT_DIRECTORY)
+    set_target_properties(
+      ${target} PROPERTIES
+      RUNTIME_OUTPUT_DIRECTORY      "${arg_RUNTIME_OUTPUT_DIRECTORY}"
+      VS_DEBUGGER_WORKING_DIRECTORY "${arg_RUNTIME_OUTPUT_DIRECTORY}"
+    )
+  endif()
+  erhe_target_settings(${target})
+  set_property(TARGET ${target} PROPERTY FOLDER "erhe-benchmarks")
+endfunction()
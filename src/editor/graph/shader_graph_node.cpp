@@ -131,7 +131,7 @@ void Shader_graph_node::node_editor(Editor_context& editor_context, ax::NodeEdit
     {
         ImGui::TableNextRow();
         ImGui::TableSetColumnIndex(1);
-        ImGui::TextUnformatted(m_name.c_str());
+        ImGui::TextUnformatted(get_name().c_str());
     }
 
     ImGui::TableNextRow();
@@ -37,7 +37,11 @@ auto Catmull_clark_subdivision_operation::describe() const -> std::string
 Catmull_clark_subdivision_operation::Catmull_clark_subdivision_operation(Mesh_operation_parameters&& context)
     : Mesh_operation{std::move(context)}
 {
-    make_entries(erhe::geometry::operation::catmull_clark_subdivision);
+    make_entries(
+        [](const erhe::geometry::Geometry& before_geometry, erhe::geometry::Geometry& after_geometry) {
+            erhe::geometry::operation::catmull_clark_subdivision(before_geometry, after_geometry);
+        }
+    );
 }
 
 auto Sqrt3_subdivision_operation::describe() const -> std::string
@@ -48,7 +52,11 @@ auto Sqrt3_subdivision_operation::describe() const -> std::string
 Sqrt3_subdivision_operation::Sqrt3_subdivision_operation(Mesh_operation_parameters&& context)
     : Mesh_operation{std::move(context)}
 {
-    make_entries(erhe::geometry::operation::sqrt3_subdivision);
+    make_entries(
+        [](const erhe::geometry::Geometry& before_geometry, erhe::geometry::Geometry& after_geometry) {
+            erhe::geometry::operation::sqrt3_subdivision(before_geometry, after_geometry);
+        }
+    );
 }
 
 auto Triangulate_operation::describe() const -> std::string
@@ -81,7 +89,11 @@ auto Kis_operation::describe() const -> std::string
 Kis_operation::Kis_operation(Mesh_operation_parameters&& context)
     : Mesh_operation{std::move(context)}
 {
-    make_entries(erhe::geometry::operation::kis);
+    make_entries(
+        [](const erhe::geometry::Geometry& before_geometry, erhe::geometry::Geometry& after_geometry) {
+            erhe::geometry::operation::kis(before_geometry, after_geometry);
+        }
+    );
 }
 
 auto Subdivide_operation::describe() const -> std::string
@@ -136,7 +148,11 @@ auto Dual_operation::describe() const -> std::string
 Dual_operation::Dual_operation(Mesh_operation_parameters&& context)
     : Mesh_operation{std::move(context)}
 {
-    make_entries(erhe::geometry::operation::dual);
+    make_entries(
+        [](const erhe::geometry::Geometry& before_geometry, erhe::geometry::Geometry& after_geometry) {
+            erhe::geometry::operation::dual(before_geometry, after_geometry);
+        }
+    );
 }
 
 auto Ambo_operation::describe() const -> std::string
@@ -158,7 +174,11 @@ auto Truncate_operation::describe() const -> std::string
 Truncate_operation::Truncate_operation(Mesh_operation_parameters&& context)
     : Mesh_operation{std::move(context)}
 {
-    make_entries(erhe::geometry::operation::truncate);
+    make_entries(
+        [](const erhe::geometry::Geometry& before_geometry, erhe::geometry::Geometry& after_geometry) {
+            erhe::geometry::operation::truncate(before_geometry, after_geometry);
+        }
+    );
 }
 
 auto Reverse_operation::describe() const -> std::string
@@ -115,9 +115,9 @@ auto Content_library_node::combo(
 ) const -> bool
 {
     const bool empty_entry = empty_option || (!in_out_selected_entry);
-    const char* preview_value = in_out_selected_entry ? in_out_selected_entry->get_label().c_str() : "(none)";
+    const std::string preview_value = in_out_selected_entry ? in_out_selected_entry->get_label() : std::string{"(none)"};
     bool selection_changed = false;
-    const bool begin = ImGui::BeginCombo(label, preview_value, ImGuiComboFlags_NoArrowButton | ImGuiComboFlags_HeightLarge);
+    const bool begin = ImGui::BeginCombo(label, preview_value.c_str(), ImGuiComboFlags_NoArrowButton | ImGuiComboFlags_HeightLarge);
     if (begin) {
         if (empty_entry) {
             bool is_selected = !in_out_selected_entry;
@@ -0,0 +1,213 @@
+// Headless dataformat conversion benchmark. Times the span conversion
+// functions against calling the single value functions for each value,
+// and the strided convert() against calling the single element convert()
+// for each vertex, and checks that both produce identical bytes.
+//
+//   dataformat-benchmark --count 4000000 --iterations 5
+
+#include "erhe_dataformat/dataformat.hpp"
+#include "erhe_dataformat/dataformat_log.hpp"
+#include "erhe_log/log.hpp"
+
+#include <cxxopts.hpp>
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+class Options
+{
+public:
+    Options(int argc, char** argv)
+    {
+        cxxopts::Options options{"dataformat-benchmark", "Times span and strided conversions against per element conversions"};
+
+        options.add_options()
+            ("count",      "Number of values, or vertices for convert()", cxxopts::value<int>()->default_value("4000000"), "<count>")
+            ("iterations", "Number of timed runs for each conversion",     cxxopts::value<int>()->default_value("5"), "<count>")
+            ("help",       "Print help");
+
+        try {
+            auto arguments = options.parse(argc, argv);
+            if (arguments.count("help")) {
+                fmt::print("{}\n", options.help());
+                return;
+            }
+            count      = std::max(1, arguments["count"     ].as<int>());
+            iterations = std::max(1, arguments["iterations"].as<int>());
+            valid      = true;
+        } catch (const std::exception& e) {
+            fmt::print("Error parsing command line arguments: {}\n", e.what());
+        }
+    }
+
+    bool valid     {false};
+    int  count     {0};
+    int  iterations{0};
+};
+
+namespace {
+
+using erhe::dataformat::Format;
+
+template <typename Function>
+auto time_best_ms(const int iterations, Function&& function) -> double
+{
+    double best_ms = 0.0;
+    for (int i = 0; i < iterations; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        function();
+        const auto end = std::chrono::steady_clock::now();
+        const double ms = std::chrono::duration<double, std::milli>(end - start).count();
+        best_ms = (i == 0) ? ms : std::min(best_ms, ms);
+    }
+    return best_ms;
+}
+
+void print_result(const char* name, const double per_element_ms, const double batch_ms, const bool match)
+{
+    fmt::print(
+        "{:48} per element {:8.2f} ms  batch {:8.2f} ms  speedup {:5.2f}x{}\n",
+        name, per_element_ms, batch_ms, per_element_ms / batch_ms, match ? "" : "  MISMATCH"
+    );
+}
+
+template <typename Source>
+auto make_source(const std::size_t count, std::mt19937& random) -> std::vector<Source>
+{
+    std::vector<Source> values(count);
+    if constexpr (std::is_floating_point_v<Source>) {
+        // Slightly out of range to include clamping
+        std::uniform_real_distribution<float> distribution{-1.2f, 1.2f};
+        for (Source& value : values) {
+            value = distribution(random);
+        }
+    } else {
+        std::uniform_int_distribution<int> distribution{std::numeric_limits<Source>::min(), std::numeric_limits<Source>::max()};
+        for (Source& value : values) {
+            value = static_cast<Source>(distribution(random));
+        }
+    }
+    return values;
+}
+
+template <typename Source, typename Destination>
+auto run_span_case(
+    const char*          name,
+    Destination          (*scalar_function)(Source),
+    void                 (*span_function)(std::span<const Source>, std::span<Destination>),
+    const Options&       options,
+    std::mt19937&        random
+) -> bool
+{
+    const std::vector<Source> source = make_source<Source>(static_cast<std::size_t>(options.count), random);
+    std::vector<Destination>  per_element_result(source.size());
+    std::vector<Destination>  batch_result      (source.size());
+
+    const double per_element_ms = time_best_ms(options.iterations, [&]() {
+        for (std::size_t i = 0, end = source.size(); i < end; ++i) {
+            per_element_result[i] = scalar_function(source[i]);
+        }
+    });
+    const double batch_ms = time_best_ms(options.iterations, [&]() {
+        span_function(source, batch_result);
+    });
+    const bool match = (std::memcmp(per_element_result.data(), batch_result.data(), source.size() * sizeof(Destination)) == 0);
+    print_result(name, per_element_ms, batch_ms, match);
+    return match;
+}
+
+// Interleaved vertex destination or source with this stride
+constexpr std::size_t c_vertex_stride = 32;
+
+auto run_convert_case(
+    const Format   src_format,
+    const Format   dst_format,
+    const Options& options,
+    std::mt19937&  random
+) -> bool
+{
+    const std::size_t count           = static_cast<std::size_t>(options.count);
+    const bool        src_is_float    =
+        (erhe::dataformat::get_format_kind        (src_format) == erhe::dataformat::Format_kind::format_kind_float) &&
+        (erhe::dataformat::get_component_byte_size(src_format) == sizeof(float)); // unorm and snorm are float kind, too
+    const std::size_t src_stride      = src_is_float ? erhe::dataformat::get_format_size(src_format) : c_vertex_stride;
+    const std::size_t dst_stride      = src_is_float ? c_vertex_stride : erhe::dataformat::get_format_size(dst_format);
+    const std::size_t component_count = erhe::dataformat::get_component_count(src_format);
+
+    // Float sources are kept in range, single element convert() verifies range
+    std::vector<uint8_t> source(count * src_stride);
+    if (src_is_float) {
+        const bool snorm = std::strstr(erhe::dataformat::c_str(dst_format), "snorm") != nullptr;
+        std::uniform_real_distribution<float> distribution{snorm ? -1.0f : 0.0f, 1.0f};
+        for (std::size_t i = 0; i < count * component_count; ++i) {
+            const float value = distribution(random);
+            std::memcpy(source.data() + i * sizeof(float), &value, sizeof(float));
+        }
+    } else {
+        std::uniform_int_distribution<int> distribution{0, 255};
+        for (uint8_t& byte : source) {
+            byte = static_cast<uint8_t>(distribution(random));
+        }
+    }
+
+    std::vector<uint8_t> per_element_result(count * dst_stride);
+    std::vector<uint8_t> batch_result      (count * dst_stride);
+    const double per_element_ms = time_best_ms(options.iterations, [&]() {
+        for (std::size_t i = 0; i < count; ++i) {
+            erhe::dataformat::convert(source.data() + i * src_stride, src_format, per_element_result.data() + i * dst_stride, dst_format, 1.0f);
+        }
+    });
+    const double batch_ms = time_best_ms(options.iterations, [&]() {
+        erhe::dataformat::convert(source.data(), src_format, src_stride, batch_result.data(), dst_format, dst_stride, count, 1.0f);
+    });
+    const bool match = (per_element_result == batch_result);
+    const std::string name = fmt::format("{} -> {}", erhe::dataformat::c_str(src_format), erhe::dataformat::c_str(dst_format));
+    print_result(name.c_str(), per_element_ms, batch_ms, match);
+    return match;
+}
+
+} // anonymous namespace
+
+auto main(int argc, char** argv) -> int
+{
+    Options options{argc, argv};
+    if (!options.valid) {
+        return 1;
+    }
+
+    erhe::log::console_init();
+    erhe::log::log_to_console();
+    erhe::log::initialize_log_sinks();
+    erhe::dataformat::initialize_logging();
+
+    std::mt19937 random{1};
+    bool         all_match = true;
+
+    fmt::print("Span functions, {} values, best of {}\n", options.count, options.iterations);
+    all_match = run_span_case<float, int16_t >("float_to_snorm16", erhe::dataformat::float_to_snorm16, erhe::dataformat::float_to_snorm16, options, random) && all_match;
+    all_match = run_span_case<float, int8_t  >("float_to_snorm8",  erhe::dataformat::float_to_snorm8,  erhe::dataformat::float_to_snorm8,  options, random) && all_match;
+    all_match = run_span_case<float, uint16_t>("float_to_unorm16", erhe::dataformat::float_to_unorm16, erhe::dataformat::float_to_unorm16, options, random) && all_match;
+    all_match = run_span_case<float, uint8_t >("float_to_unorm8",  erhe::dataformat::float_to_unorm8,  erhe::dataformat::float_to_unorm8,  options, random) && all_match;
+    all_match = run_span_case<int16_t,  float>("snorm16_to_float", erhe::dataformat::snorm16_to_float, erhe::dataformat::snorm16_to_float, options, random) && all_match;
+    all_match = run_span_case<int8_t,   float>("snorm8_to_float",  erhe::dataformat::snorm8_to_float,  erhe::dataformat::snorm8_to_float,  options, random) && all_match;
+    all_match = run_span_case<uint16_t, float>("unorm16_to_float", erhe::dataformat::unorm16_to_float, erhe::dataformat::unorm16_to_float, options, random) && all_match;
+    all_match = run_span_case<uint8_t,  float>("unorm8_to_float",  erhe::dataformat::unorm8_to_float,  erhe::dataformat::unorm8_to_float,  options, random) && all_match;
+
+    fmt::print("Strided convert(), {} vertices, stride {}, best of {}\n", options.count, c_vertex_stride, options.iterations);
+    all_match = run_convert_case(Format::format_32_vec4_float, Format::format_8_vec4_unorm,  options, random) && all_match;
+    all_match = run_convert_case(Format::format_32_vec3_float, Format::format_16_vec3_snorm, options, random) && all_match;
+    all_match = run_convert_case(Format::format_32_vec2_float, Format::format_16_vec2_unorm, options, random) && all_match;
+    all_match = run_convert_case(Format::format_32_vec2_float, Format::format_8_vec2_unorm,  options, random) && all_match;
+    all_match = run_convert_case(Format::format_8_vec4_unorm,  Format::format_32_vec4_float, options, random) && all_match;
+    all_match = run_convert_case(Format::format_16_vec2_snorm, Format::format_32_vec2_float, options, random) && all_match;
+
+    return all_match ? 0 : 1;
+}
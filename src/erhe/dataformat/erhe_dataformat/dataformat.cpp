@@ -3,6 +3,22 @@
 #include <algorithm>
 #include <cstring>
 #include <limits>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#   define ERHE_DATAFORMAT_SSE2 1
+#   include <emmintrin.h>
+#   if defined(__AVX2__)
+#       define ERHE_DATAFORMAT_AVX2 1
+#       include <immintrin.h>
+#   endif
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#   define ERHE_DATAFORMAT_NEON 1
+#   include <arm_neon.h>
+#   if defined(__aarch64__) || defined(_M_ARM64)
+#       define ERHE_DATAFORMAT_NEON_DIV 1 // vdivq_f32() is AArch64 only
+#   endif
+#endif
 
 namespace erhe::dataformat {
 
@@ -74,6 +90,271 @@ float unorm8_to_float(uint8_t v)
     return static_cast<float>(v) / 255.0f;
 }
 
+namespace {
+
+// Vector versions of the scalar conversions above:
+// unorm: clamp(v * scale + 0.5, 0, scale), truncated
+// snorm: clamp(v * scale +- 0.5, -scale - 1, scale), truncated
+#if defined(ERHE_DATAFORMAT_SSE2)
+inline auto unorm_x4(const float* source, const float scale) -> __m128i
+{
+    __m128 a = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(source), _mm_set1_ps(scale)), _mm_set1_ps(0.5f));
+    a = _mm_min_ps(_mm_max_ps(a, _mm_setzero_ps()), _mm_set1_ps(scale));
+    return _mm_cvttps_epi32(a);
+}
+
+inline auto snorm_x4(const float* source, const float scale) -> __m128i
+{
+    const __m128 v    = _mm_loadu_ps(source);
+    const __m128 half = _mm_or_ps(_mm_and_ps(v, _mm_set1_ps(-0.0f)), _mm_set1_ps(0.5f));
+    __m128 a = _mm_add_ps(_mm_mul_ps(v, _mm_set1_ps(scale)), half);
+    a = _mm_min_ps(_mm_max_ps(a, _mm_set1_ps(-scale - 1.0f)), _mm_set1_ps(scale));
+    return _mm_cvttps_epi32(a);
+}
+#elif defined(ERHE_DATAFORMAT_NEON)
+inline auto unorm_x4(const float* source, const float scale) -> int32x4_t
+{
+    float32x4_t a = vaddq_f32(vmulq_f32(vld1q_f32(source), vdupq_n_f32(scale)), vdupq_n_f32(0.5f));
+    a = vminq_f32(vmaxq_f32(a, vdupq_n_f32(0.0f)), vdupq_n_f32(scale));
+    return vcvtq_s32_f32(a);
+}
+
+inline auto snorm_x4(const float* source, const float scale) -> int32x4_t
+{
+    const float32x4_t v    = vld1q_f32(source);
+    const uint32x4_t  sign = vandq_u32(vreinterpretq_u32_f32(v), vdupq_n_u32(0x80000000u));
+    const float32x4_t half = vreinterpretq_f32_u32(vorrq_u32(sign, vreinterpretq_u32_f32(vdupq_n_f32(0.5f))));
+    float32x4_t a = vaddq_f32(vmulq_f32(v, vdupq_n_f32(scale)), half);
+    a = vminq_f32(vmaxq_f32(a, vdupq_n_f32(-scale - 1.0f)), vdupq_n_f32(scale));
+    return vcvtq_s32_f32(a);
+}
+#endif
+
+} // anonymous namespace
+
+void float_to_snorm16(const std::span<const float> source, const std::span<int16_t> destination)
+{
+    ERHE_VERIFY(destination.size() >= source.size());
+    const std::size_t count = source.size();
+    std::size_t i = 0;
+#if defined(ERHE_DATAFORMAT_SSE2)
+    for (; i + 4 <= count; i += 4) {
+        const __m128i v = snorm_x4(source.data() + i, 32767.0f);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(destination.data() + i), _mm_packs_epi32(v, v));
+    }
+#elif defined(ERHE_DATAFORMAT_NEON)
+    for (; i + 4 <= count; i += 4) {
+        vst1_s16(destination.data() + i, vqmovn_s32(snorm_x4(source.data() + i, 32767.0f)));
+    }
+#endif
+    for (; i < count; ++i) {
+        destination[i] = float_to_snorm16(source[i]);
+    }
+}
+
+void float_to_snorm8(const std::span<const float> source, const std::span<int8_t> destination)
+{
+    ERHE_VERIFY(destination.size() >= source.size());
+    const std::size_t count = source.size();
+    std::size_t i = 0;
+#if defined(ERHE_DATAFORMAT_SSE2)
+    for (; i + 4 <= count; i += 4) {
+        const __m128i v   = snorm_x4(source.data() + i, 127.0f);
+        const __m128i v16 = _mm_packs_epi32(v, v);
+        const int32_t v8  = _mm_cvtsi128_si32(_mm_packs_epi16(v16, v16));
+        memcpy(destination.data() + i, &v8, 4);
+    }
+#elif defined(ERHE_DATAFORMAT_NEON)
+    for (; i + 4 <= count; i += 4) {
+        const int16x4_t v16 = vqmovn_s32(snorm_x4(source.data() + i, 127.0f));
+        const int8x8_t  v8  = vqmovn_s16(vcombine_s16(v16, v16));
+        int8_t lanes[8];
+        vst1_s8(lanes, v8);
+        memcpy(destination.data() + i, lanes, 4);
+    }
+#endif
+    for (; i < count; ++i) {
+        destination[i] = float_to_snorm8(source[i]);
+    }
+}
+
+void float_to_unorm16(const std::span<const float> source, const std::span<uint16_t> destination)
+{
+    ERHE_VERIFY(destination.size() >= source.size());
+    const std::size_t count = source.size();
+    std::size_t i = 0;
+#if defined(ERHE_DATAFORMAT_SSE2)
+    for (; i + 4 <= count; i += 4) {
+        // SSE2 has only signed saturating pack; bias to signed range and back
+        const __m128i v      = _mm_sub_epi32(unorm_x4(source.data() + i, 65535.0f), _mm_set1_epi32(32768));
+        const __m128i packed = _mm_xor_si128(_mm_packs_epi32(v, v), _mm_set1_epi16(static_cast<short>(0x8000)));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(destination.data() + i), packed);
+    }
+#elif defined(ERHE_DATAFORMAT_NEON)
+    for (; i + 4 <= count; i += 4) {
+        vst1_u16(destination.data() + i, vqmovun_s32(unorm_x4(source.data() + i, 65535.0f)));
+    }
+#endif
+    for (; i < count; ++i) {
+        destination[i] = float_to_unorm16(source[i]);
+    }
+}
+
+void float_to_unorm8(const std::span<const float> source, const std::span<uint8_t> destination)
+{
+    ERHE_VERIFY(destination.size() >= source.size());
+    const std::size_t count = source.size();
+    std::size_t i = 0;
+#if defined(ERHE_DATAFORMAT_SSE2)
+    for (; i + 4 <= count; i += 4) {
+        const __m128i v   = unorm_x4(source.data() + i, 255.0f);
+        const __m128i v16 = _mm_packs_epi32(v, v);
+        const int32_t v8  = _mm_cvtsi128_si32(_mm_packus_epi16(v16, v16));
+        memcpy(destination.data() + i, &v8, 4);
+    }
+#elif defined(ERHE_DATAFORMAT_NEON)
+    for (; i + 4 <= count; i += 4) {
+        const uint16x4_t v16 = vqmovun_s32(unorm_x4(source.data() + i, 255.0f));
+        const uint8x8_t  v8  = vqmovn_u16(vcombine_u16(v16, v16));
+        uint8_t lanes[8];
+        vst1_u8(lanes, v8);
+        memcpy(destination.data() + i, lanes, 4);
+    }
+#endif
+    for (; i < count; ++i) {
+        destination[i] = float_to_unorm8(source[i]);
+    }
+}
+
+// The *_to_float() span functions divide like the scalar versions, so
+// that results are identical. Eight values at a time with AVX2.
+void snorm16_to_float(const std::span<const int16_t> source, const std::span<float> destination)
+{
+    ERHE_VERIFY(destination.size() >= source.size());
+    const std::size_t count = source.size();
+    std::size_t i = 0;
+#if defined(ERHE_DATAFORMAT_AVX2)
+    for (; i + 8 <= count; i += 8) {
+        const __m256i v = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source.data() + i)));
+        const __m256  f = _mm256_div_ps(_mm256_cvtepi32_ps(v), _mm256_set1_ps(32767.0f));
+        _mm256_storeu_ps(destination.data() + i, _mm256_max_ps(f, _mm256_set1_ps(-1.0f)));
+    }
+#endif
+#if defined(ERHE_DATAFORMAT_SSE2)
+    for (; i + 4 <= count; i += 4) {
+        const __m128i v16 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(source.data() + i));
+        const __m128i v   = _mm_srai_epi32(_mm_unpacklo_epi16(v16, v16), 16);
+        const __m128  f   = _mm_div_ps(_mm_cvtepi32_ps(v), _mm_set1_ps(32767.0f));
+        _mm_storeu_ps(destination.data() + i, _mm_max_ps(f, _mm_set1_ps(-1.0f)));
+    }
+#elif defined(ERHE_DATAFORMAT_NEON_DIV)
+    for (; i + 4 <= count; i += 4) {
+        const int32x4_t   v = vmovl_s16(vld1_s16(source.data() + i));
+        const float32x4_t f = vdivq_f32(vcvtq_f32_s32(v), vdupq_n_f32(32767.0f));
+        vst1q_f32(destination.data() + i, vmaxq_f32(f, vdupq_n_f32(-1.0f)));
+    }
+#endif
+    for (; i < count; ++i) {
+        destination[i] = snorm16_to_float(source[i]);
+    }
+}
+
+void snorm8_to_float(const std::span<const int8_t> source, const std::span<float> destination)
+{
+    ERHE_VERIFY(destination.size() >= source.size());
+    const std::size_t count = source.size();
+    std::size_t i = 0;
+#if defined(ERHE_DATAFORMAT_AVX2)
+    for (; i + 8 <= count; i += 8) {
+        const __m256i v = _mm256_cvtepi8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(source.data() + i)));
+        const __m256  f = _mm256_div_ps(_mm256_cvtepi32_ps(v), _mm256_set1_ps(127.0f));
+        _mm256_storeu_ps(destination.data() + i, _mm256_max_ps(f, _mm256_set1_ps(-1.0f)));
+    }
+#endif
+#if defined(ERHE_DATAFORMAT_SSE2)
+    for (; i + 4 <= count; i += 4) {
+        int32_t v8;
+        memcpy(&v8, source.data() + i, 4);
+        const __m128i a   = _mm_cvtsi32_si128(v8);
+        const __m128i v16 = _mm_srai_epi16(_mm_unpacklo_epi8(a, a), 8);
+        const __m128i v   = _mm_srai_epi32(_mm_unpacklo_epi16(v16, v16), 16);
+        const __m128  f   = _mm_div_ps(_mm_cvtepi32_ps(v), _mm_set1_ps(127.0f));
+        _mm_storeu_ps(destination.data() + i, _mm_max_ps(f, _mm_set1_ps(-1.0f)));
+    }
+#elif defined(ERHE_DATAFORMAT_NEON_DIV)
+    for (; i + 4 <= count; i += 4) {
+        int32_t v8;
+        memcpy(&v8, source.data() + i, 4);
+        const int32x4_t   v = vmovl_s16(vget_low_s16(vmovl_s8(vreinterpret_s8_s32(vdup_n_s32(v8)))));
+        const float32x4_t f = vdivq_f32(vcvtq_f32_s32(v), vdupq_n_f32(127.0f));
+        vst1q_f32(destination.data() + i, vmaxq_f32(f, vdupq_n_f32(-1.0f)));
+    }
+#endif
+    for (; i < count; ++i) {
+        destination[i] = snorm8_to_float(source[i]);
+    }
+}
+
+void unorm16_to_float(const std::span<const uint16_t> source, const std::span<float> destination)
+{
+    ERHE_VERIFY(destination.size() >= source.size());
+    const std::size_t count = source.size();
+    std::size_t i = 0;
+#if defined(ERHE_DATAFORMAT_AVX2)
+    for (; i + 8 <= count; i += 8) {
+        const __m256i v = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source.data() + i)));
+        _mm256_storeu_ps(destination.data() + i, _mm256_div_ps(_mm256_cvtepi32_ps(v), _mm256_set1_ps(65535.0f)));
+    }
+#endif
+#if defined(ERHE_DATAFORMAT_SSE2)
+    for (; i + 4 <= count; i += 4) {
+        const __m128i v16 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(source.data() + i));
+        const __m128i v   = _mm_unpacklo_epi16(v16, _mm_setzero_si128());
+        _mm_storeu_ps(destination.data() + i, _mm_div_ps(_mm_cvtepi32_ps(v), _mm_set1_ps(65535.0f)));
+    }
+#elif defined(ERHE_DATAFORMAT_NEON_DIV)
+    for (; i + 4 <= count; i += 4) {
+        const uint32x4_t v = vmovl_u16(vld1_u16(source.data() + i));
+        vst1q_f32(destination.data() + i, vdivq_f32(vcvtq_f32_u32(v), vdupq_n_f32(65535.0f)));
+    }
+#endif
+    for (; i < count; ++i) {
+        destination[i] = unorm16_to_float(source[i]);
+    }
+}
+
+void unorm8_to_float(const std::span<const uint8_t> source, const std::span<float> destination)
+{
+    ERHE_VERIFY(destination.size() >= source.size());
+    const std::size_t count = source.size();
+    std::size_t i = 0;
+#if defined(ERHE_DATAFORMAT_AVX2)
+    for (; i + 8 <= count; i += 8) {
+        const __m256i v = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(source.data() + i)));
+        _mm256_storeu_ps(destination.data() + i, _mm256_div_ps(_mm256_cvtepi32_ps(v), _mm256_set1_ps(255.0f)));
+    }
+#endif
+#if defined(ERHE_DATAFORMAT_SSE2)
+    for (; i + 4 <= count; i += 4) {
+        int32_t v8;
+        memcpy(&v8, source.data() + i, 4);
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i v    = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(v8), zero), zero);
+        _mm_storeu_ps(destination.data() + i, _mm_div_ps(_mm_cvtepi32_ps(v), _mm_set1_ps(255.0f)));
+    }
+#elif defined(ERHE_DATAFORMAT_NEON_DIV)
+    for (; i + 4 <= count; i += 4) {
+        uint32_t v8;
+        memcpy(&v8, source.data() + i, 4);
+        const uint32x4_t v = vmovl_u16(vget_low_u16(vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(v8)))));
+        vst1q_f32(destination.data() + i, vdivq_f32(vcvtq_f32_u32(v), vdupq_n_f32(255.0f)));
+    }
+#endif
+    for (; i < count; ++i) {
+        destination[i] = unorm8_to_float(source[i]);
+    }
+}
+
 auto c_str(Format format) -> const char*
 {
     switch (format) {
@@ -1425,4 +1706,421 @@ void convert(const void* src, Format src_format, void* dst, Format dst_format, f
     }
 }
 
+namespace {
+
+// Elements per block in batch convert(); block values use 4 components
+// per element, unused components are zero like in single element convert().
+constexpr std::size_t convert_block_size = 256;
+
+enum class Component_encoding : unsigned int {
+    unorm,
+    snorm,
+    uint,
+    sint,
+    float32
+};
+
+class Component_layout
+{
+public:
+    Component_encoding encoding;
+    std::size_t        component_byte_size;
+    std::size_t        component_count;
+};
+
+auto get_component_layout(const Format format) -> Component_layout
+{
+    const std::size_t byte_size = get_component_byte_size(format);
+    const std::size_t count     = get_component_count(format);
+    switch (format) {
+        case Format::format_8_scalar_unorm:
+        case Format::format_8_vec2_unorm:
+        case Format::format_8_vec3_unorm:
+        case Format::format_8_vec4_unorm:
+        case Format::format_16_scalar_unorm:
+        case Format::format_16_vec2_unorm:
+        case Format::format_16_vec3_unorm:
+        case Format::format_16_vec4_unorm:   return Component_layout{Component_encoding::unorm,   byte_size, count};
+        case Format::format_8_scalar_snorm:
+        case Format::format_8_vec2_snorm:
+        case Format::format_8_vec3_snorm:
+        case Format::format_8_vec4_snorm:
+        case Format::format_16_scalar_snorm:
+        case Format::format_16_vec2_snorm:
+        case Format::format_16_vec3_snorm:
+        case Format::format_16_vec4_snorm:   return Component_layout{Component_encoding::snorm,   byte_size, count};
+        case Format::format_8_scalar_uint:
+        case Format::format_8_vec2_uint:
+        case Format::format_8_vec3_uint:
+        case Format::format_8_vec4_uint:
+        case Format::format_16_scalar_uint:
+        case Format::format_16_vec2_uint:
+        case Format::format_16_vec3_uint:
+        case Format::format_16_vec4_uint:
+        case Format::format_32_scalar_uint:
+        case Format::format_32_vec2_uint:
+        case Format::format_32_vec3_uint:
+        case Format::format_32_vec4_uint:    return Component_layout{Component_encoding::uint,    byte_size, count};
+        case Format::format_8_scalar_sint:
+        case Format::format_8_vec2_sint:
+        case Format::format_8_vec3_sint:
+        case Format::format_8_vec4_sint:
+        case Format::format_16_scalar_sint:
+        case Format::format_16_vec2_sint:
+        case Format::format_16_vec3_sint:
+        case Format::format_16_vec4_sint:
+        case Format::format_32_scalar_sint:
+        case Format::format_32_vec2_sint:
+        case Format::format_32_vec3_sint:
+        case Format::format_32_vec4_sint:    return Component_layout{Component_encoding::sint,    byte_size, count};
+        case Format::format_32_scalar_float:
+        case Format::format_32_vec2_float:
+        case Format::format_32_vec3_float:
+        case Format::format_32_vec4_float:   return Component_layout{Component_encoding::float32, byte_size, count};
+        default: {
+            ERHE_FATAL("Unsupported path in convert()");
+        }
+    }
+}
+
+class Convert_block
+{
+public:
+    alignas(16) float        f_value [convert_block_size * 4];
+    alignas(16) int32_t      i_value [convert_block_size * 4];
+    alignas(16) uint32_t     ui_value[convert_block_size * 4];
+    alignas(16) std::uint8_t raw     [convert_block_size * 4 * sizeof(uint16_t)];
+};
+
+template <typename T, std::size_t N>
+void gather(const std::uint8_t* src, const std::size_t src_stride, const std::size_t element_count, T* out)
+{
+    for (std::size_t e = 0; e < element_count; ++e, src += src_stride, out += 4) {
+        T values[4] = { T{0}, T{0}, T{0}, T{0} };
+        memcpy(&values[0], src, N * sizeof(T));
+        memcpy(out, &values[0], 4 * sizeof(T));
+    }
+}
+
+template <typename T>
+void gather(const std::uint8_t* src, const std::size_t src_stride, const std::size_t component_count, const std::size_t element_count, T* out)
+{
+    switch (component_count) {
+        case 1:  gather<T, 1>(src, src_stride, element_count, out); break;
+        case 2:  gather<T, 2>(src, src_stride, element_count, out); break;
+        case 3:  gather<T, 3>(src, src_stride, element_count, out); break;
+        default: {
+            if (src_stride == 4 * sizeof(T)) {
+                memcpy(out, src, element_count * 4 * sizeof(T));
+            } else {
+                gather<T, 4>(src, src_stride, element_count, out);
+            }
+            break;
+        }
+    }
+}
+
+template <typename T, std::size_t N>
+void scatter(const T* in, const std::size_t element_count, std::uint8_t* dst, const std::size_t dst_stride)
+{
+    for (std::size_t e = 0; e < element_count; ++e, in += 4, dst += dst_stride) {
+        memcpy(dst, in, N * sizeof(T));
+    }
+}
+
+template <typename T>
+void scatter(const T* in, const std::size_t component_count, const std::size_t element_count, std::uint8_t* dst, const std::size_t dst_stride)
+{
+    switch (component_count) {
+        case 1:  scatter<T, 1>(in, element_count, dst, dst_stride); break;
+        case 2:  scatter<T, 2>(in, element_count, dst, dst_stride); break;
+        case 3:  scatter<T, 3>(in, element_count, dst, dst_stride); break;
+        default: {
+            if (dst_stride == 4 * sizeof(T)) {
+                memcpy(dst, in, element_count * 4 * sizeof(T));
+            } else {
+                scatter<T, 4>(in, element_count, dst, dst_stride);
+            }
+            break;
+        }
+    }
+}
+
+template <typename T>
+void unpack_integers(const Component_layout& layout, const std::uint8_t* src, const std::size_t src_stride, const std::size_t element_count, Convert_block& block, auto* out)
+{
+    T* raw = reinterpret_cast<T*>(block.raw);
+    gather<T>(src, src_stride, layout.component_count, element_count, raw);
+    for (std::size_t i = 0, end = element_count * 4; i < end; ++i) {
+        out[i] = raw[i];
+    }
+}
+
+template <typename T>
+void pack_integers(const Component_layout& layout, const auto* in, const std::size_t element_count, Convert_block& block, std::uint8_t* dst, const std::size_t dst_stride)
+{
+    using Value = std::remove_cvref_t<decltype(in[0])>;
+    T* raw = reinterpret_cast<T*>(block.raw);
+    for (std::size_t i = 0, end = element_count * 4; i < end; ++i) {
+        const Value lo = static_cast<Value>(std::numeric_limits<T>::lowest());
+        const Value hi = static_cast<Value>(std::numeric_limits<T>::max());
+        raw[i] = static_cast<T>(std::clamp(in[i], lo, hi));
+    }
+    scatter<T>(raw, layout.component_count, element_count, dst, dst_stride);
+}
+
+void unpack_block(const Component_layout& layout, const std::uint8_t* src, const std::size_t src_stride, const std::size_t element_count, Convert_block& block)
+{
+    const std::size_t value_count = element_count * 4;
+    const std::size_t count       = layout.component_count;
+    switch (layout.encoding) {
+        case Component_encoding::unorm: {
+            if (layout.component_byte_size == 1) {
+                gather<uint8_t>(src, src_stride, count, element_count, reinterpret_cast<uint8_t*>(block.raw));
+                unorm8_to_float(std::span<const uint8_t>{reinterpret_cast<const uint8_t*>(block.raw), value_count}, std::span<float>{block.f_value, value_count});
+            } else {
+                gather<uint16_t>(src, src_stride, count, element_count, reinterpret_cast<uint16_t*>(block.raw));
+                unorm16_to_float(std::span<const uint16_t>{reinterpret_cast<const uint16_t*>(block.raw), value_count}, std::span<float>{block.f_value, value_count});
+            }
+            break;
+        }
+        case Component_encoding::snorm: {
+            if (layout.component_byte_size == 1) {
+                gather<int8_t>(src, src_stride, count, element_count, reinterpret_cast<int8_t*>(block.raw));
+                snorm8_to_float(std::span<const int8_t>{reinterpret_cast<const int8_t*>(block.raw), value_count}, std::span<float>{block.f_value, value_count});
+            } else {
+                gather<int16_t>(src, src_stride, count, element_count, reinterpret_cast<int16_t*>(block.raw));
+                snorm16_to_float(std::span<const int16_t>{reinterpret_cast<const int16_t*>(block.raw), value_count}, std::span<float>{block.f_value, value_count});
+            }
+            break;
+        }
+        case Component_encoding::uint: {
+            switch (layout.component_byte_size) {
+                case 1:  unpack_integers<uint8_t >(layout, src, src_stride, element_count, block, block.ui_value); break;
+                case 2:  unpack_integers<uint16_t>(layout, src, src_stride, element_count, block, block.ui_value); break;
+                default: gather<uint32_t>(src, src_stride, count, element_count, block.ui_value); break;
+            }
+            break;
+        }
+        case Component_encoding::sint: {
+            switch (layout.component_byte_size) {
+                case 1:  unpack_integers<int8_t >(layout, src, src_stride, element_count, block, block.i_value); break;
+                case 2:  unpack_integers<int16_t>(layout, src, src_stride, element_count, block, block.i_value); break;
+                default: gather<int32_t>(src, src_stride, count, element_count, block.i_value); break;
+            }
+            break;
+        }
+        case Component_encoding::float32: {
+            gather<float>(src, src_stride, count, element_count, block.f_value);
+            break;
+        }
+    }
+}
+
+void pack_block(const Component_layout& layout, const std::size_t element_count, Convert_block& block, std::uint8_t* dst, const std::size_t dst_stride)
+{
+    const std::size_t value_count = element_count * 4;
+    const std::size_t count       = layout.component_count;
+    switch (layout.encoding) {
+        case Component_encoding::unorm: {
+            if (layout.component_byte_size == 1) {
+                float_to_unorm8(std::span<const float>{block.f_value, value_count}, std::span<uint8_t>{reinterpret_cast<uint8_t*>(block.raw), value_count});
+                scatter<uint8_t>(reinterpret_cast<const uint8_t*>(block.raw), count, element_count, dst, dst_stride);
+            } else {
+                float_to_unorm16(std::span<const float>{block.f_value, value_count}, std::span<uint16_t>{reinterpret_cast<uint16_t*>(block.raw), value_count});
+                scatter<uint16_t>(reinterpret_cast<const uint16_t*>(block.raw), count, element_count, dst, dst_stride);
+            }
+            break;
+        }
+        case Component_encoding::snorm: {
+            if (layout.component_byte_size == 1) {
+                float_to_snorm8(std::span<const float>{block.f_value, value_count}, std::span<int8_t>{reinterpret_cast<int8_t*>(block.raw), value_count});
+                scatter<int8_t>(reinterpret_cast<const int8_t*>(block.raw), count, element_count, dst, dst_stride);
+            } else {
+                float_to_snorm16(std::span<const float>{block.f_value, value_count}, std::span<int16_t>{reinterpret_cast<int16_t*>(block.raw), value_count});
+                scatter<int16_t>(reinterpret_cast<const int16_t*>(block.raw), count, element_count, dst, dst_stride);
+            }
+            break;
+        }
+        case Component_encoding::uint: {
+            switch (layout.component_byte_size) {
+                case 1:  pack_integers<uint8_t >(layout, block.ui_value, element_count, block, dst, dst_stride); break;
+                case 2:  pack_integers<uint16_t>(layout, block.ui_value, element_count, block, dst, dst_stride); break;
+                default: scatter<uint32_t>(block.ui_value, count, element_count, dst, dst_stride); break;
+            }
+            break;
+        }
+        case Component_encoding::sint: {
+            switch (layout.component_byte_size) {
+                case 1:  pack_integers<int8_t >(layout, block.i_value, element_count, block, dst, dst_stride); break;
+                case 2:  pack_integers<int16_t>(layout, block.i_value, element_count, block, dst, dst_stride); break;
+                default: scatter<int32_t>(block.i_value, count, element_count, dst, dst_stride); break;
+            }
+            break;
+        }
+        case Component_encoding::float32: {
+            scatter<float>(block.f_value, count, element_count, dst, dst_stride);
+            break;
+        }
+    }
+}
+
+// Same rules as the Format_kind conversions in single element convert()
+void convert_block_kind(const Format_kind src_kind, const Format_kind dst_kind, const std::size_t value_count, Convert_block& block)
+{
+    if (src_kind == dst_kind) {
+        return;
+    }
+    for (std::size_t i = 0; i < value_count; ++i) {
+        switch (dst_kind) {
+            case Format_kind::format_kind_float: {
+                block.f_value[i] = (src_kind == Format_kind::format_kind_signed_integer)
+                    ? static_cast<float>(block.i_value[i])
+                    : static_cast<float>(block.ui_value[i]);
+                break;
+            }
+            case Format_kind::format_kind_signed_integer: {
+                block.i_value[i] = (src_kind == Format_kind::format_kind_float)
+                    ? static_cast<int32_t>(block.f_value[i])
+                    : static_cast<int32_t>(std::min(block.ui_value[i], static_cast<uint32_t>(std::numeric_limits<int32_t>::max())));
+                break;
+            }
+            case Format_kind::format_kind_unsigned_integer: {
+                block.ui_value[i] = (src_kind == Format_kind::format_kind_float)
+                    ? ((block.f_value[i] > 0.0f) ? static_cast<uint32_t>(block.f_value[i]) : 0u)
+                    : static_cast<uint32_t>(std::max(0, block.i_value[i]));
+                break;
+            }
+        }
+    }
+}
+
+} // anonymous namespace
+
+void convert(
+    const void*       src,
+    const Format      src_format,
+    const std::size_t src_stride,
+    void*             dst,
+    const Format      dst_format,
+    const std::size_t dst_stride,
+    const std::size_t count,
+    const float       scale
+)
+{
+    std::uint8_t*     dst_bytes = static_cast<std::uint8_t*>(dst);
+    const std::size_t dst_size  = get_format_size(dst_format);
+    if (src == nullptr) {
+        for (std::size_t i = 0; i < count; ++i) {
+            memset(dst_bytes + i * dst_stride, 0, dst_size);
+        }
+        return;
+    }
+    const std::uint8_t* src_bytes = static_cast<const std::uint8_t*>(src);
+    if ((dst_format == src_format) && (scale == 1.0f)) {
+        if ((src_stride == dst_size) && (dst_stride == dst_size)) {
+            memcpy(dst_bytes, src_bytes, count * dst_size);
+        } else {
+            for (std::size_t i = 0; i < count; ++i) {
+                memcpy(dst_bytes + i * dst_stride, src_bytes + i * src_stride, dst_size);
+            }
+        }
+        return;
+    }
+
+    const Component_layout src_layout  = get_component_layout(src_format);
+    const Component_layout dst_layout  = get_component_layout(dst_format);
+    const Format_kind      src_kind    = get_format_kind(src_format);
+    const Format_kind      dst_kind    = get_format_kind(dst_format);
+    const bool             normalized  = (dst_layout.encoding == Component_encoding::unorm) || (dst_layout.encoding == Component_encoding::snorm);
+    const bool             apply_scale = normalized && (scale != 1.0f);
+
+    Convert_block block;
+    for (std::size_t offset = 0; offset < count; offset += convert_block_size) {
+        const std::size_t element_count = std::min(convert_block_size, count - offset);
+        const std::size_t value_count   = element_count * 4;
+        unpack_block(src_layout, src_bytes + offset * src_stride, src_stride, element_count, block);
+        convert_block_kind(src_kind, dst_kind, value_count, block);
+        if (apply_scale) {
+            for (std::size_t i = 0; i < value_count; ++i) {
+                block.f_value[i] = block.f_value[i] / scale;
+            }
+        }
+        pack_block(dst_layout, element_count, block, dst_bytes + offset * dst_stride, dst_stride);
+    }
+}
+
+namespace {
+
+template <std::size_t N>
+void pack_float32(const float* source, void* destination)
+{
+    memcpy(destination, source, N * sizeof(float));
+}
+
+template <std::size_t N>
+void pack_unorm8(const float* source, void* destination)
+{
+    uint8_t* const out = static_cast<uint8_t*>(destination);
+    for (std::size_t i = 0; i < N; ++i) {
+        out[i] = float_to_unorm8(source[i]);
+    }
+}
+
+template <std::size_t N>
+void pack_snorm8(const float* source, void* destination)
+{
+    int8_t* const out = static_cast<int8_t*>(destination);
+    for (std::size_t i = 0; i < N; ++i) {
+        out[i] = float_to_snorm8(source[i]);
+    }
+}
+
+template <std::size_t N>
+void pack_unorm16(const float* source, void* destination)
+{
+    uint16_t* const out = static_cast<uint16_t*>(destination);
+    for (std::size_t i = 0; i < N; ++i) {
+        out[i] = float_to_unorm16(source[i]);
+    }
+}
+
+template <std::size_t N>
+void pack_snorm16(const float* source, void* destination)
+{
+    int16_t* const out = static_cast<int16_t*>(destination);
+    for (std::size_t i = 0; i < N; ++i) {
+        out[i] = float_to_snorm16(source[i]);
+    }
+}
+
+} // anonymous namespace
+
+auto get_float_pack_function(const Format format) -> Float_pack_function
+{
+    switch (format) {
+        case Format::format_8_scalar_unorm:  return &pack_unorm8<1>;
+        case Format::format_8_vec2_unorm:    return &pack_unorm8<2>;
+        case Format::format_8_vec3_unorm:    return &pack_unorm8<3>;
+        case Format::format_8_vec4_unorm:    return &pack_unorm8<4>;
+        case Format::format_8_scalar_snorm:  return &pack_snorm8<1>;
+        case Format::format_8_vec2_snorm:    return &pack_snorm8<2>;
+        case Format::format_8_vec3_snorm:    return &pack_snorm8<3>;
+        case Format::format_8_vec4_snorm:    return &pack_snorm8<4>;
+        case Format::format_16_scalar_unorm: return &pack_unorm16<1>;
+        case Format::format_16_vec2_unorm:   return &pack_unorm16<2>;
+        case Format::format_16_vec3_unorm:   return &pack_unorm16<3>;
+        case Format::format_16_vec4_unorm:   return &pack_unorm16<4>;
+        case Format::format_16_scalar_snorm: return &pack_snorm16<1>;
+        case Format::format_16_vec2_snorm:   return &pack_snorm16<2>;
+        case Format::format_16_vec3_snorm:   return &pack_snorm16<3>;
+        case Format::format_16_vec4_snorm:   return &pack_snorm16<4>;
+        case Format::format_32_scalar_float: return &pack_float32<1>;
+        case Format::format_32_vec2_float:   return &pack_float32<2>;
+        case Format::format_32_vec3_float:   return &pack_float32<3>;
+        case Format::format_32_vec4_float:   return &pack_float32<4>;
+        default:                             return nullptr;
+    }
+}
+
 } // namespace erhe::dataformat
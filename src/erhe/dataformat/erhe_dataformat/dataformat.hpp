@@ -2,6 +2,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <span>
 
 namespace erhe::dataformat {
 
@@ -14,6 +15,19 @@ float unorm16_to_float(uint16_t v);
 uint8_t float_to_unorm8(float v);
 float unorm8_to_float(uint8_t v);
 
+// Span variants of the above. Four values are converted at a time using
+// SSE2 or NEON when available (eight with AVX2 for *_to_float()); results
+// match the scalar functions.
+// destination.size() must be at least source.size().
+void float_to_snorm16(std::span<const float> source, std::span<int16_t>  destination);
+void float_to_snorm8 (std::span<const float> source, std::span<int8_t>   destination);
+void float_to_unorm16(std::span<const float> source, std::span<uint16_t> destination);
+void float_to_unorm8 (std::span<const float> source, std::span<uint8_t>  destination);
+void snorm16_to_float(std::span<const int16_t>  source, std::span<float> destination);
+void snorm8_to_float (std::span<const int8_t>   source, std::span<float> destination);
+void unorm16_to_float(std::span<const uint16_t> source, std::span<float> destination);
+void unorm8_to_float (std::span<const uint8_t>  source, std::span<float> destination);
+
 enum class Format {
     format_undefined = 0,
     format_8_scalar_unorm,
@@ -111,4 +125,28 @@ enum class Format_kind {
 [[nodiscard]] auto get_format_size(Format format) -> std::size_t;
 void convert(const void* src, Format src_format, void* dst, Format dst_format, float scale);
 
+// Converts count elements. Strides are in bytes. Same result as calling
+// the single element convert() for each element, except values which do
+// not fit dst_format are clamped instead of verified. Elements are
+// converted in blocks, using the span functions above; prefer this over
+// a loop calling the single element convert().
+void convert(
+    const void* src,
+    Format      src_format,
+    std::size_t src_stride,
+    void*       dst,
+    Format      dst_format,
+    std::size_t dst_stride,
+    std::size_t count,
+    float       scale
+);
+
+// Writes one element of format from get_component_count(format) floats.
+// Resolve once per attribute and reuse, instead of switching on format per element.
+// Scalar; for many elements use the strided convert() above.
+using Float_pack_function = void (*)(const float* source, void* destination);
+
+// Returns nullptr if format has no float, unorm or snorm packing
+[[nodiscard]] auto get_float_pack_function(Format format) -> Float_pack_function;
+
 } // namespace erhe::dataformat
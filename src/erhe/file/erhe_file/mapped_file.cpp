@@ -0,0 +1,160 @@
+#include "erhe_file/mapped_file.hpp"
+#include "erhe_file/file.hpp"
+#include "erhe_file/file_log.hpp"
+
+#if defined(ERHE_OS_WINDOWS)
+#   include <Windows.h>
+#else
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+#include <utility>
+
+namespace erhe::file {
+
+Mapped_file::Mapped_file() = default;
+
+Mapped_file::~Mapped_file() noexcept
+{
+    close();
+}
+
+Mapped_file::Mapped_file(Mapped_file&& other) noexcept
+    : m_data          {std::exchange(other.m_data,           nullptr)}
+    , m_size          {std::exchange(other.m_size,           0)}
+    , m_file_handle   {std::exchange(other.m_file_handle,    nullptr)}
+    , m_mapping_handle{std::exchange(other.m_mapping_handle, nullptr)}
+{
+}
+
+auto Mapped_file::operator=(Mapped_file&& other) noexcept -> Mapped_file&
+{
+    if (this != &other) {
+        close();
+        m_data           = std::exchange(other.m_data,           nullptr);
+        m_size           = std::exchange(other.m_size,           0);
+        m_file_handle    = std::exchange(other.m_file_handle,    nullptr);
+        m_mapping_handle = std::exchange(other.m_mapping_handle, nullptr);
+    }
+    return *this;
+}
+
+auto Mapped_file::is_open() const -> bool
+{
+    return m_data != nullptr;
+}
+
+auto Mapped_file::get_text() const -> std::string_view
+{
+    return std::string_view{m_data, m_size};
+}
+
+#if defined(ERHE_OS_WINDOWS)
+auto Mapped_file::open(const std::string_view description, const std::filesystem::path& path) -> bool
+{
+    close();
+
+    const bool file_is_ok = check_is_existing_non_empty_regular_file(description, path);
+    if (!file_is_ok) {
+        return false;
+    }
+
+    HANDLE file = CreateFileW(
+        path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr
+    );
+    if (file == INVALID_HANDLE_VALUE) {
+        log_file->error("{}: Could not open file '{}' for reading", description, to_string(path));
+        return false;
+    }
+    LARGE_INTEGER file_size{};
+    if (!GetFileSizeEx(file, &file_size) || (file_size.QuadPart <= 0)) {
+        log_file->error("{}: Could not get size of file '{}'", description, to_string(path));
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        log_file->error("{}: Could not map file '{}'", description, to_string(path));
+        CloseHandle(file);
+        return false;
+    }
+    const void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (data == nullptr) {
+        log_file->error("{}: Could not map view of file '{}'", description, to_string(path));
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    m_data           = static_cast<const char*>(data);
+    m_size           = static_cast<std::size_t>(file_size.QuadPart);
+    m_file_handle    = file;
+    m_mapping_handle = mapping;
+    return true;
+}
+
+void Mapped_file::close()
+{
+    if (m_data != nullptr) {
+        UnmapViewOfFile(m_data);
+    }
+    if (m_mapping_handle != nullptr) {
+        CloseHandle(static_cast<HANDLE>(m_mapping_handle));
+    }
+    if (m_file_handle != nullptr) {
+        CloseHandle(static_cast<HANDLE>(m_file_handle));
+    }
+    m_data           = nullptr;
+    m_size           = 0;
+    m_file_handle    = nullptr;
+    m_mapping_handle = nullptr;
+}
+#else
+auto Mapped_file::open(const std::string_view description, const std::filesystem::path& path) -> bool
+{
+    close();
+
+    const bool file_is_ok = check_is_existing_non_empty_regular_file(description, path);
+    if (!file_is_ok) {
+        return false;
+    }
+
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        log_file->error("{}: Could not open file '{}' for reading", description, to_string(path));
+        return false;
+    }
+    struct stat file_status{};
+    if ((::fstat(fd, &file_status) != 0) || (file_status.st_size <= 0)) {
+        log_file->error("{}: Could not get size of file '{}'", description, to_string(path));
+        ::close(fd);
+        return false;
+    }
+    const std::size_t size = static_cast<std::size_t>(file_status.st_size);
+    void* data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // Mapping stays valid after the descriptor is closed
+    if (data == MAP_FAILED) {
+        log_file->error("{}: Could not map file '{}'", description, to_string(path));
+        return false;
+    }
+    ::madvise(data, size, MADV_SEQUENTIAL);
+
+    m_data = static_cast<const char*>(data);
+    m_size = size;
+    return true;
+}
+
+void Mapped_file::close()
+{
+    if (m_data != nullptr) {
+        ::munmap(const_cast<char*>(m_data), m_size);
+    }
+    m_data = nullptr;
+    m_size = 0;
+}
+#endif
+
+} // namespace erhe::file
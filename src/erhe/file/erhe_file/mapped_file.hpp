@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <string_view>
+
+namespace erhe::file {
+
+// Read-only memory mapping of a whole file. Text parsers can tokenize
+// get_text() in place, without copying the file contents.
+class Mapped_file
+{
+public:
+    Mapped_file  ();
+    ~Mapped_file () noexcept;
+    Mapped_file  (const Mapped_file&) = delete;
+    auto operator=(const Mapped_file&) = delete;
+    Mapped_file  (Mapped_file&& other) noexcept;
+    auto operator=(Mapped_file&& other) noexcept -> Mapped_file&;
+
+    // Returns false if file does not exist, or is not regular file, or is empty
+    [[nodiscard]] auto open    (std::string_view description, const std::filesystem::path& path) -> bool;
+    void               close   ();
+    [[nodiscard]] auto is_open () const -> bool;
+    [[nodiscard]] auto get_text() const -> std::string_view;
+
+private:
+    const char* m_data          {nullptr};
+    std::size_t m_size          {0};
+    void*       m_file_handle   {nullptr}; // Windows only
+    void*       m_mapping_handle{nullptr}; // Windows only
+};
+
+} // namespace erhe::file
@@ -0,0 +1,113 @@
+#include "erhe_file/text_tokenizer.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace erhe::file {
+
+Line_reader::Line_reader(const std::string_view text)
+    : m_text{text}
+{
+}
+
+auto Line_reader::next(std::string_view& line) -> bool
+{
+    if (m_position >= m_text.size()) {
+        return false;
+    }
+    const std::size_t begin = m_position;
+    const void*       found = std::memchr(m_text.data() + begin, '\n', m_text.size() - begin);
+    std::size_t       end   = (found != nullptr)
+        ? static_cast<std::size_t>(static_cast<const char*>(found) - m_text.data())
+        : m_text.size();
+    m_position = end + 1;
+    if ((end > begin) && (m_text[end - 1] == '\r')) {
+        --end;
+    }
+    line = m_text.substr(begin, end - begin);
+    return true;
+}
+
+Token_reader::Token_reader(const std::string_view line, const std::string_view delimiters)
+    : m_line      {line}
+    , m_delimiters{delimiters}
+{
+}
+
+auto Token_reader::next(std::string_view& token) -> bool
+{
+    const std::size_t begin = m_line.find_first_not_of(m_delimiters, m_position);
+    if (begin == std::string_view::npos) {
+        m_position = m_line.size();
+        return false;
+    }
+    std::size_t end = m_line.find_first_of(m_delimiters, begin);
+    if (end == std::string_view::npos) {
+        end = m_line.size();
+    }
+    m_position = end;
+    token = m_line.substr(begin, end - begin);
+    return true;
+}
+
+auto Token_reader::rest() const -> std::string_view
+{
+    return trim(m_line.substr(std::min(m_position, m_line.size())), m_delimiters);
+}
+
+auto trim(const std::string_view text, const std::string_view characters) -> std::string_view
+{
+    const std::size_t begin = text.find_first_not_of(characters);
+    if (begin == std::string_view::npos) {
+        return {};
+    }
+    const std::size_t end = text.find_last_not_of(characters);
+    return text.substr(begin, end - begin + 1);
+}
+
+auto parse_float(std::string_view token, float& value) -> bool
+{
+    if (!token.empty() && (token.front() == '+')) {
+        token.remove_prefix(1);
+    }
+#if defined(__cpp_lib_to_chars)
+    const char* const end = token.data() + token.size();
+    const std::from_chars_result result = std::from_chars(token.data(), end, value);
+    return (result.ec == std::errc{}) && (result.ptr == end);
+#else
+    // Standard library without floating point std::from_chars()
+    char buffer[64];
+    if (token.empty() || (token.size() >= sizeof(buffer))) {
+        return false;
+    }
+    std::memcpy(buffer, token.data(), token.size());
+    buffer[token.size()] = '\0';
+    char* end = nullptr;
+    value = std::strtof(buffer, &end);
+    return end == buffer + token.size();
+#endif
+}
+
+auto split_line_chunks(const std::string_view text, const std::size_t chunk_count) -> std::vector<std::string_view>
+{
+    std::vector<std::string_view> chunks;
+    if (text.empty()) {
+        return chunks;
+    }
+    const std::size_t target_size = std::max<std::size_t>(text.size() / std::max<std::size_t>(chunk_count, 1), 1);
+    chunks.reserve(std::max<std::size_t>(chunk_count, 1));
+    std::size_t begin = 0;
+    while (begin < text.size()) {
+        std::size_t end = std::min(begin + target_size, text.size());
+        if (end < text.size()) {
+            const std::size_t line_end = text.find('\n', end - 1);
+            end = (line_end == std::string_view::npos) ? text.size() : line_end + 1;
+        }
+        chunks.push_back(text.substr(begin, end - begin));
+        begin = end;
+    }
+    return chunks;
+}
+
+} // namespace erhe::file
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <charconv>
+#include <cstddef>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+namespace erhe::file {
+
+// Splits text into lines. Returned lines are views into the text, without
+// line terminators. Both LF and CRLF line endings are accepted.
+class Line_reader
+{
+public:
+    explicit Line_reader(std::string_view text);
+
+    [[nodiscard]] auto next(std::string_view& line) -> bool;
+
+private:
+    std::string_view m_text;
+    std::size_t      m_position{0};
+};
+
+// Splits a line into tokens separated by any of the delimiter characters.
+// Returned tokens are views into the line.
+class Token_reader
+{
+public:
+    static constexpr std::string_view whitespace{" \t\v\f\r"};
+
+    explicit Token_reader(std::string_view line, std::string_view delimiters = whitespace);
+
+    [[nodiscard]] auto next(std::string_view& token) -> bool;
+
+    // Rest of the line after tokens read so far, without leading and trailing delimiters
+    [[nodiscard]] auto rest() const -> std::string_view;
+
+private:
+    std::string_view m_line;
+    std::string_view m_delimiters;
+    std::size_t      m_position{0};
+};
+
+[[nodiscard]] auto trim(std::string_view text, std::string_view characters = Token_reader::whitespace) -> std::string_view;
+
+// Parses whole token as number. Returns false if token is not a valid number.
+[[nodiscard]] auto parse_float(std::string_view token, float& value) -> bool;
+
+template <typename T>
+[[nodiscard]] auto parse_integer(std::string_view token, T& value) -> bool
+{
+    if (!token.empty() && (token.front() == '+')) {
+        token.remove_prefix(1);
+    }
+    const char* const end = token.data() + token.size();
+    const std::from_chars_result result = std::from_chars(token.data(), end, value);
+    return (result.ec == std::errc{}) && (result.ptr == end);
+}
+
+// Splits text into about chunk_count chunks of whole lines, of roughly
+// equal size. Chunks can be parsed in parallel, and results merged in chunk
+// order to get the same result as from parsing the whole text.
+[[nodiscard]] auto split_line_chunks(std::string_view text, std::size_t chunk_count) -> std::vector<std::string_view>;
+
+} // namespace erhe::file
@@ -0,0 +1,241 @@
+// Headless geometry operation benchmark. Generates a torus, then times
+// Geometry::process() and the conway operations without executor and with
+// an executor, and checks that both produce identical vertices, facets,
+// corners and computed attributes.
+//
+//   geometry-operation-benchmark --steps 400 --iterations 3
+
+#include "erhe_geometry/geometry.hpp"
+#include "erhe_geometry/geometry_log.hpp"
+#include "erhe_geometry/operation/catmull_clark_subdivision.hpp"
+#include "erhe_geometry/operation/dual.hpp"
+#include "erhe_geometry/operation/kis.hpp"
+#include "erhe_geometry/operation/sqrt3_subdivision.hpp"
+#include "erhe_geometry/operation/truncate.hpp"
+#include "erhe_geometry/shapes/torus.hpp"
+#include "erhe_log/log.hpp"
+
+#include <cxxopts.hpp>
+#include <fmt/format.h>
+#include <geogram/basic/common.h>
+#include <taskflow/taskflow.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <utility>
+
+class Options
+{
+public:
+    Options(int argc, char** argv)
+    {
+        cxxopts::Options options{"geometry-operation-benchmark", "Times serial and parallel geometry processing and operations"};
+
+        options.add_options()
+            ("steps",      "Torus has steps x steps quads",                    cxxopts::value<int>()->default_value("400"), "<count>")
+            ("iterations", "Number of timed runs for each mode",               cxxopts::value<int>()->default_value("3"), "<count>")
+            ("threads",    "Executor worker count, 0 for hardware concurrency", cxxopts::value<int>()->default_value("0"), "<count>")
+            ("help",       "Print help");
+
+        try {
+            auto arguments = options.parse(argc, argv);
+            if (arguments.count("help")) {
+                fmt::print("{}\n", options.help());
+                return;
+            }
+            steps      = std::max(3, arguments["steps"     ].as<int>());
+            iterations = std::max(1, arguments["iterations"].as<int>());
+            threads    = std::max(0, arguments["threads"   ].as<int>());
+            valid      = true;
+        } catch (const std::exception& e) {
+            fmt::print("Error parsing command line arguments: {}\n", e.what());
+        }
+    }
+
+    bool valid     {false};
+    int  steps     {0};
+    int  iterations{0};
+    int  threads   {0};
+};
+
+namespace {
+
+using erhe::geometry::Geometry;
+
+const uint64_t c_process_flags =
+    Geometry::process_flag_connect |
+    Geometry::process_flag_build_edges |
+    Geometry::process_flag_compute_facet_centroids |
+    Geometry::process_flag_compute_smooth_vertex_normals |
+    Geometry::process_flag_generate_facet_texture_coordinates;
+
+template <typename T>
+auto same_attribute(const Attribute_present<T>& lhs, const Attribute_present<T>& rhs, const GEO::index_t count) -> bool
+{
+    for (GEO::index_t i = 0; i < count; ++i) {
+        const bool present = lhs.has(i);
+        if (present != rhs.has(i)) {
+            return false;
+        }
+        if (present) {
+            const T lhs_value = lhs.attribute[i];
+            const T rhs_value = rhs.attribute[i];
+            if (std::memcmp(&lhs_value, &rhs_value, sizeof(T)) != 0) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+auto same_geometry(const Geometry& lhs, const Geometry& rhs) -> bool
+{
+    const GEO::Mesh& lhs_mesh = lhs.get_mesh();
+    const GEO::Mesh& rhs_mesh = rhs.get_mesh();
+    if (
+        (lhs_mesh.vertices     .nb() != rhs_mesh.vertices     .nb()) ||
+        (lhs_mesh.facets       .nb() != rhs_mesh.facets       .nb()) ||
+        (lhs_mesh.facet_corners.nb() != rhs_mesh.facet_corners.nb()) ||
+        (lhs_mesh.edges        .nb() != rhs_mesh.edges        .nb())
+    ) {
+        return false;
+    }
+    for (GEO::index_t vertex : lhs_mesh.vertices) {
+        const GEO::vec3f lhs_point = get_pointf(lhs_mesh.vertices, vertex);
+        const GEO::vec3f rhs_point = get_pointf(rhs_mesh.vertices, vertex);
+        if (std::memcmp(&lhs_point, &rhs_point, sizeof(GEO::vec3f)) != 0) {
+            return false;
+        }
+    }
+    for (GEO::index_t facet : lhs_mesh.facets) {
+        if (
+            (lhs_mesh.facets.corners_begin(facet) != rhs_mesh.facets.corners_begin(facet)) ||
+            (lhs_mesh.facets.corners_end  (facet) != rhs_mesh.facets.corners_end  (facet))
+        ) {
+            return false;
+        }
+    }
+    for (GEO::index_t corner : lhs_mesh.facet_corners) {
+        if (lhs_mesh.facet_corners.vertex(corner) != rhs_mesh.facet_corners.vertex(corner)) {
+            return false;
+        }
+    }
+    const Mesh_attributes& lhs_attributes = lhs.get_attributes();
+    const Mesh_attributes& rhs_attributes = rhs.get_attributes();
+    return
+        same_attribute(lhs_attributes.facet_centroid,       rhs_attributes.facet_centroid,       lhs_mesh.facets       .nb()) &&
+        same_attribute(lhs_attributes.facet_normal,         rhs_attributes.facet_normal,         lhs_mesh.facets       .nb()) &&
+        same_attribute(lhs_attributes.vertex_normal_smooth, rhs_attributes.vertex_normal_smooth, lhs_mesh.vertices     .nb()) &&
+        same_attribute(lhs_attributes.corner_texcoord_0,    rhs_attributes.corner_texcoord_0,    lhs_mesh.facet_corners.nb());
+}
+
+auto make_source(const Options& options) -> std::unique_ptr<Geometry>
+{
+    auto geometry = std::make_unique<Geometry>("torus");
+    erhe::geometry::shapes::make_torus(geometry->get_mesh(), 1.0f, 0.25f, options.steps, options.steps);
+    return geometry;
+}
+
+class Run_result
+{
+public:
+    double                    best_ms{0.0};
+    std::unique_ptr<Geometry> geometry;
+};
+
+// Setup is not timed; run() produces the geometry to compare
+auto time_runs(
+    const int                                                    iterations,
+    const std::function<std::unique_ptr<Geometry>()>&            setup,
+    const std::function<void(std::unique_ptr<Geometry>& input)>& run
+) -> Run_result
+{
+    Run_result result;
+    for (int i = 0; i < iterations; ++i) {
+        std::unique_ptr<Geometry> geometry = setup();
+        const auto start = std::chrono::steady_clock::now();
+        run(geometry);
+        const auto end = std::chrono::steady_clock::now();
+        const double ms = std::chrono::duration<double, std::milli>(end - start).count();
+        result.best_ms  = (i == 0) ? ms : std::min(result.best_ms, ms);
+        result.geometry = std::move(geometry);
+    }
+    return result;
+}
+
+void print_result(const char* name, const Run_result& serial, const Run_result& parallel, const bool match)
+{
+    fmt::print(
+        "{:28} {:8} facets  serial {:9.2f} ms  parallel {:9.2f} ms  speedup {:5.2f}x{}\n",
+        name, serial.geometry->get_mesh().facets.nb(), serial.best_ms, parallel.best_ms, serial.best_ms / parallel.best_ms,
+        match ? "" : "  DIFFERS"
+    );
+}
+
+} // anonymous namespace
+
+auto main(int argc, char** argv) -> int
+{
+    Options options{argc, argv};
+    if (!options.valid) {
+        return 1;
+    }
+
+    erhe::log::console_init();
+    erhe::log::log_to_console();
+    erhe::log::initialize_log_sinks();
+    erhe::geometry::initialize_logging();
+    GEO::initialize(GEO::GEOGRAM_INSTALL_NONE);
+
+    tf::Executor executor{(options.threads > 0) ? static_cast<std::size_t>(options.threads) : std::max(1u, std::thread::hardware_concurrency())};
+    fmt::print(
+        "torus {} x {}, best of {}, {} workers\n",
+        options.steps, options.steps, options.iterations, executor.num_workers()
+    );
+
+    bool all_match = true;
+
+    // Geometry::process() on the generated torus
+    {
+        const auto setup = [&options]() { return make_source(options); };
+        const Run_result serial   = time_runs(options.iterations, setup, [](std::unique_ptr<Geometry>& geometry) { geometry->process(c_process_flags, nullptr); });
+        const Run_result parallel = time_runs(options.iterations, setup, [&executor](std::unique_ptr<Geometry>& geometry) { geometry->process(c_process_flags, &executor); });
+        const bool       match    = same_geometry(*serial.geometry, *parallel.geometry);
+        print_result("Geometry::process", serial, parallel, match);
+        all_match = all_match && match;
+    }
+
+    // Operations share one processed source; each run writes a new destination
+    std::unique_ptr<Geometry> source = make_source(options);
+    source->process(c_process_flags, &executor);
+
+    using Operation = void (*)(const Geometry& source, Geometry& destination, tf::Executor* executor);
+    const std::pair<Operation, const char*> operations[] = {
+        { erhe::geometry::operation::kis,                       "kis"                       },
+        { erhe::geometry::operation::dual,                      "dual"                      },
+        { erhe::geometry::operation::truncate,                  "truncate"                  },
+        { erhe::geometry::operation::sqrt3_subdivision,         "sqrt3_subdivision"         },
+        { erhe::geometry::operation::catmull_clark_subdivision, "catmull_clark_subdivision" }
+    };
+    for (const std::pair<Operation, const char*>& entry : operations) {
+        const Operation   operation = entry.first;
+        const char* const name      = entry.second;
+        const auto setup = [name]() { return std::make_unique<Geometry>(name); };
+        const auto run   = [&source, operation](tf::Executor* operation_executor) {
+            return [&source, operation, operation_executor](std::unique_ptr<Geometry>& destination) {
+                operation(*source, *destination, operation_executor);
+            };
+        };
+        const Run_result serial   = time_runs(options.iterations, setup, run(nullptr));
+        const Run_result parallel = time_runs(options.iterations, setup, run(&executor));
+        const bool       match    = same_geometry(*serial.geometry, *parallel.geometry);
+        print_result(name, serial, parallel, match);
+        all_match = all_match && match;
+    }
+
+    return all_match ? 0 : 1;
+}
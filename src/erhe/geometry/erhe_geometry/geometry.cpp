@@ -1,5 +1,6 @@
 #include "erhe_geometry/geometry.hpp"
 #include "erhe_geometry/geometry_log.hpp"
+#include "erhe_geometry/parallel_for.hpp"
 #include "erhe_log/log_geogram.hpp"
 #include "erhe_verify/verify.hpp"
 
@@ -12,8 +13,10 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
 #include <cmath>
-#include <unordered_map>
+#include <numeric>
+#include <utility>
 
 void set_point(GEO::MeshVertices& mesh_vertices, GEO::index_t vertex, GEO::vec3 p)
 {
@@ -276,42 +279,81 @@ auto get_mesh_info(const GEO::Mesh& mesh) -> Mesh_info
     };
 }
 
-void compute_facet_normals(GEO::Mesh& mesh, Mesh_attributes& attributes)
+void compute_facet_normals(GEO::Mesh& mesh, Mesh_attributes& attributes, tf::Executor* const executor)
 {
     Attribute_present<GEO::vec3f>& facet_normal_attribute = attributes.facet_normal;
-    for (GEO::index_t facet = 0, end = mesh.facets.nb(); facet < end; ++facet) {
-        const GEO::vec3f facet_normal = GEO::normalize(mesh_facet_normalf(mesh, facet));
-        facet_normal_attribute.set(facet, facet_normal);
-    }
+    erhe::geometry::parallel_for(
+        executor, mesh.facets.nb(),
+        [&mesh, &facet_normal_attribute](const std::size_t i) {
+            const GEO::index_t facet        = static_cast<GEO::index_t>(i);
+            const GEO::vec3f   facet_normal = GEO::normalize(mesh_facet_normalf(mesh, facet));
+            facet_normal_attribute.set(facet, facet_normal);
+        }
+    );
 }
 
-void compute_facet_centroids(GEO::Mesh& mesh, Mesh_attributes& attributes)
+void compute_facet_centroids(GEO::Mesh& mesh, Mesh_attributes& attributes, tf::Executor* const executor)
 {
     Attribute_present<GEO::vec3f>& facet_centroid = attributes.facet_centroid;
-    for (GEO::index_t facet = 0, end = mesh.facets.nb(); facet < end; ++facet) {
-        const GEO::vec3f centroid = mesh_facet_centerf(mesh, facet);
-        facet_centroid.set(facet, centroid);
-    }
+    erhe::geometry::parallel_for(
+        executor, mesh.facets.nb(),
+        [&mesh, &facet_centroid](const std::size_t i) {
+            const GEO::index_t facet    = static_cast<GEO::index_t>(i);
+            const GEO::vec3f   centroid = mesh_facet_centerf(mesh, facet);
+            facet_centroid.set(facet, centroid);
+        }
+    );
 }
 
-void compute_mesh_vertex_normal_smooth(GEO::Mesh& mesh, Mesh_attributes& attributes)
+void compute_mesh_vertex_normal_smooth(GEO::Mesh& mesh, Mesh_attributes& attributes, tf::Executor* const executor)
 {
-    Attribute_present<GEO::vec3f>& vertex_normal_smooth = attributes.vertex_normal_smooth;
-    vertex_normal_smooth.fill(GEO::vec3f{0.0f, 0.0f, 0.0f});
-    for (GEO::index_t facet : mesh.facets) {
-        GEO::vec3f facet_normal = GEO::normalize(mesh_facet_normalf(mesh, facet));
-        for (GEO::index_t corner : mesh.facets.corners(facet)) {
-            GEO::index_t vertex = mesh.facet_corners.vertex(corner);
-            const GEO::vec3f old_sum = vertex_normal_smooth.get(vertex);
-            const GEO::vec3f new_sum = old_sum + facet_normal;
-            vertex_normal_smooth.set(vertex, new_sum);
+    const GEO::index_t facet_count  = mesh.facets.nb();
+    const GEO::index_t vertex_count = mesh.vertices.nb();
+
+    std::vector<GEO::vec3f>   facet_normals  (facet_count);
+    std::vector<GEO::index_t> corner_to_facet(mesh.facet_corners.nb(), GEO::NO_INDEX);
+    erhe::geometry::parallel_for(
+        executor, facet_count,
+        [&mesh, &facet_normals, &corner_to_facet](const std::size_t i) {
+            const GEO::index_t facet = static_cast<GEO::index_t>(i);
+            facet_normals[facet] = GEO::normalize(mesh_facet_normalf(mesh, facet));
+            for (GEO::index_t corner : mesh.facets.corners(facet)) {
+                corner_to_facet[corner] = facet;
+            }
+        }
+    );
+
+    // Vertex corners in corner order; facet corners are laid out in facet
+    // order, so each vertex sums facet normals in the same order as a
+    // single pass over facets would.
+    erhe::geometry::Index_adjacency vertex_to_corners;
+    vertex_to_corners.begin_counts(vertex_count);
+    for (GEO::index_t corner : mesh.facet_corners) {
+        if (corner_to_facet[corner] != GEO::NO_INDEX) {
+            vertex_to_corners.count(mesh.facet_corners.vertex(corner));
         }
     }
-    for (GEO::index_t vertex : mesh.vertices) {
-        const GEO::vec3f sum = vertex_normal_smooth.get(vertex);
-        const GEO::vec3f normalized = GEO::normalize(sum);
-        vertex_normal_smooth.set(vertex, normalized);
+    vertex_to_corners.end_counts();
+    for (GEO::index_t corner : mesh.facet_corners) {
+        if (corner_to_facet[corner] != GEO::NO_INDEX) {
+            vertex_to_corners.push(mesh.facet_corners.vertex(corner), corner);
+        }
     }
+    vertex_to_corners.end_push();
+
+    Attribute_present<GEO::vec3f>& vertex_normal_smooth = attributes.vertex_normal_smooth;
+    vertex_normal_smooth.fill(GEO::vec3f{0.0f, 0.0f, 0.0f});
+    erhe::geometry::parallel_for(
+        executor, vertex_count,
+        [&vertex_to_corners, &corner_to_facet, &facet_normals, &vertex_normal_smooth](const std::size_t i) {
+            const GEO::index_t vertex = static_cast<GEO::index_t>(i);
+            GEO::vec3f sum{0.0f, 0.0f, 0.0f};
+            for (const GEO::index_t corner : vertex_to_corners.row(vertex)) {
+                sum = sum + facet_normals[corner_to_facet[corner]];
+            }
+            vertex_normal_smooth.set(vertex, GEO::normalize(sum));
+        }
+    );
 }
 
 #if 0
@@ -476,13 +518,16 @@ void generate_mesh_facet_texture_coordinates(GEO::Mesh& mesh, GEO::index_t facet
     }
 }
 
-void generate_mesh_facet_texture_coordinates(GEO::Mesh& mesh, Mesh_attributes& attributes)
+void generate_mesh_facet_texture_coordinates(GEO::Mesh& mesh, Mesh_attributes& attributes, tf::Executor* const executor)
 {
     //compute_facet_normals(mesh, attributes);
     //compute_facet_centroids(mesh, attributes);
-    for (GEO::index_t facet : mesh.facets) {
-        generate_mesh_facet_texture_coordinates(mesh, facet, attributes);
-    }
+    erhe::geometry::parallel_for(
+        executor, mesh.facets.nb(),
+        [&mesh, &attributes](const std::size_t facet) {
+            generate_mesh_facet_texture_coordinates(mesh, static_cast<GEO::index_t>(facet), attributes);
+        }
+    );
 }
 
 #if 0
@@ -782,6 +827,54 @@ void transform_mesh(GEO::Mesh& mesh, const GEO::mat4f& transform)
 
 namespace erhe::geometry {
 
+void Index_adjacency::clear()
+{
+    offsets.clear();
+    values.clear();
+    cursors.clear();
+}
+
+void Index_adjacency::begin_counts(const std::size_t row_count)
+{
+    offsets.assign(row_count + 1, 0);
+    values.clear();
+    cursors.clear();
+}
+
+void Index_adjacency::end_counts()
+{
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    values.resize(offsets.back());
+    cursors.assign(offsets.begin(), offsets.end() - 1);
+}
+
+void Index_adjacency::end_push()
+{
+    ERHE_VERIFY(std::equal(cursors.begin(), cursors.end(), offsets.begin() + 1));
+    cursors.clear();
+    cursors.shrink_to_fit();
+}
+
+auto Index_adjacency::row_count() const -> std::size_t
+{
+    return offsets.empty() ? 0 : offsets.size() - 1;
+}
+
+auto Index_adjacency::row(const GEO::index_t row) const -> std::span<const GEO::index_t>
+{
+    return std::span<const GEO::index_t>{values.data() + offsets[row], values.data() + offsets[row + 1]};
+}
+
+auto Index_adjacency::row(const GEO::index_t row) -> std::span<GEO::index_t>
+{
+    return std::span<GEO::index_t>{values.data() + offsets[row], values.data() + offsets[row + 1]};
+}
+
+auto Index_adjacency::get_memory_usage() const -> std::size_t
+{
+    return (offsets.capacity() + values.capacity() + cursors.capacity()) * sizeof(GEO::index_t);
+}
+
 Geometry::Geometry()
     : m_mesh      {3, true}
     , m_attributes{m_mesh}
@@ -891,15 +984,53 @@ void Geometry::copy_with_transform(const Geometry& source, const GEO::mat4f& tra
     transform(source, *this, transform_);
 
     if (&source != this) {
-        m_name                = source.get_name();
-        m_vertex_to_corners   = source.m_vertex_to_corners;
-        m_corner_to_facet     = source.m_corner_to_facet;
-        m_edge_to_facets      = source.m_edge_to_facets;
-        m_vertex_to_edges     = source.m_vertex_to_edges;
-        m_vertex_pair_to_edge = source.m_vertex_pair_to_edge;
+        m_name              = source.get_name();
+        m_vertex_to_corners = source.m_vertex_to_corners;
+        m_corner_to_facet   = source.m_corner_to_facet;
+        m_edge_to_facets    = source.m_edge_to_facets;
+        m_vertex_to_edges   = source.m_vertex_to_edges;
     }
 }
 
+namespace {
+
+[[nodiscard]] auto get_attributes_memory_usage(const GEO::AttributesManager& attributes) -> std::size_t
+{
+    const std::size_t element_count = attributes.size();
+    GEO::vector<std::string> attribute_names;
+    attributes.list_attribute_names(attribute_names);
+    std::size_t byte_count = 0;
+    for (const std::string& attribute_name : attribute_names) {
+        const GEO::AttributeStore* attribute_store = attributes.find_attribute_store(attribute_name);
+        if (attribute_store == nullptr) {
+            continue;
+        }
+        byte_count += element_count * attribute_store->element_size() * attribute_store->dimension();
+    }
+    return byte_count;
+}
+
+}
+
+auto Geometry::get_memory_usage() const -> std::size_t
+{
+    const std::size_t index_size = sizeof(GEO::index_t);
+    return
+        // Mesh connectivity; points are stored as vertex attribute
+        (m_mesh.facets.nb() + 1) * index_size +
+        m_mesh.facet_corners.nb() * 2 * index_size +
+        m_mesh.edges.nb() * 2 * index_size +
+        get_attributes_memory_usage(m_mesh.vertices     .attributes()) +
+        get_attributes_memory_usage(m_mesh.facets       .attributes()) +
+        get_attributes_memory_usage(m_mesh.facet_corners.attributes()) +
+        get_attributes_memory_usage(m_mesh.edges        .attributes()) +
+        // Connectivity built by update_connectivity() and build_edges()
+        m_vertex_to_corners.get_memory_usage() +
+        m_edge_to_facets.get_memory_usage() +
+        m_vertex_to_edges.get_memory_usage() +
+        m_corner_to_facet.capacity() * index_size;
+}
+
 auto Geometry::get_name() const -> const std::string&
 {
     return m_name;
@@ -915,14 +1046,14 @@ auto Geometry::get_mesh() const -> const GEO::Mesh&
     return m_mesh;
 }
 
-auto Geometry::get_vertex_corners(GEO::index_t vertex) const -> const std::vector<GEO::index_t>&
+auto Geometry::get_vertex_corners(GEO::index_t vertex) const -> std::span<const GEO::index_t>
 {
-    return m_vertex_to_corners[vertex];
+    return m_vertex_to_corners.row(vertex);
 }
 
-auto Geometry::get_vertex_edges(GEO::index_t vertex) const -> const std::vector<GEO::index_t>&
+auto Geometry::get_vertex_edges(GEO::index_t vertex) const -> std::span<const GEO::index_t>
 {
-    return m_vertex_to_edges[vertex];
+    return m_vertex_to_edges.row(vertex);
 }
 
 auto Geometry::get_corner_facet(GEO::index_t corner) const -> GEO::index_t
@@ -930,20 +1061,28 @@ auto Geometry::get_corner_facet(GEO::index_t corner) const -> GEO::index_t
     return m_corner_to_facet[corner];
 }
 
-auto Geometry::get_edge_facets(GEO::index_t edge) const -> const std::vector<GEO::index_t>&
+auto Geometry::get_edge_facets(GEO::index_t edge) const -> std::span<const GEO::index_t>
 {
-    ERHE_VERIFY(edge < m_edge_to_facets.size());
-    return m_edge_to_facets[edge];
+    ERHE_VERIFY(edge < m_edge_to_facets.row_count());
+    return m_edge_to_facets.row(edge);
 }
 
 auto Geometry::get_edge(const GEO::index_t v0, const GEO::index_t v1) const -> GEO::index_t
 {
     ERHE_VERIFY(v0 != v1);
+    if ((v0 >= m_vertex_to_edges.row_count()) || (v1 >= m_vertex_to_edges.row_count())) {
+        return GEO::NO_EDGE;
+    }
+    // Edges are stored with lower vertex first; scan the shorter of the two vertex edge lists
     const GEO::index_t lo = std::min(v0, v1);
     const GEO::index_t hi = std::max(v0, v1);
-    const auto i = m_vertex_pair_to_edge.find({lo, hi});
-    if (i != m_vertex_pair_to_edge.end()) {
-        return i->second;
+    const std::span<const GEO::index_t> lo_edges = m_vertex_to_edges.row(lo);
+    const std::span<const GEO::index_t> hi_edges = m_vertex_to_edges.row(hi);
+    const bool                          use_lo   = lo_edges.size() <= hi_edges.size();
+    for (const GEO::index_t edge : use_lo ? lo_edges : hi_edges) {
+        if (m_mesh.edges.vertex(edge, use_lo ? 1 : 0) == (use_lo ? hi : lo)) {
+            return edge;
+        }
     }
     return GEO::NO_EDGE;
 }
@@ -963,160 +1102,218 @@ void Geometry::set_name(std::string_view name)
     m_name = std::string{name};
 }
 
-void Geometry::build_edges()
+void Geometry::build_edges(tf::Executor* const executor)
 {
     m_mesh.edges.clear();
 
-    GEO::index_t facet_edge_count = 0;
-
-    m_vertex_pair_to_edge.clear();
-    m_vertex_to_edges.clear();
-    m_vertex_to_edges.resize(m_mesh.vertices.nb());
-
-    // First pass - shared edges
-    for (GEO::index_t facet : m_mesh.facets) {
-        const GEO::index_t facet_corner_count = m_mesh.facets.nb_corners(facet);
-        for (GEO::index_t local_facet_corner = 0; local_facet_corner < facet_corner_count; ++local_facet_corner) {
-            const GEO::index_t corner       = m_mesh.facets.corner(facet, local_facet_corner);
-            const GEO::index_t next_corner_ = m_mesh.facets.corner(facet, (local_facet_corner + 1) % facet_corner_count);
-            const GEO::index_t next_corner  = m_mesh.facets.next_corner_around_facet(facet, corner);
-            ERHE_VERIFY(next_corner_ == next_corner);
-            const GEO::index_t a            = m_mesh.facet_corners.vertex(corner);
-            const GEO::index_t b            = m_mesh.facet_corners.vertex(next_corner);
-            ++facet_edge_count;
-            ERHE_VERIFY(a != b);
-            if (a < b) { // This does not work for non-shared edges going wrong direction
-                const GEO::index_t edge = m_mesh.edges.create_edge(a, b);
-                const std::pair<GEO::index_t, GEO::index_t> key{a, b};
-                m_vertex_pair_to_edge.insert({key, edge});
-                m_vertex_to_edges[a].push_back(edge);
-                m_vertex_to_edges[b].push_back(edge);
-
-                //erhe::geometry::log_geometry->info(
-                //    "pass 1: created edge {} from facet {} corners {} and {} - vertices {} and {}",
-                //    edge, facet, corner, next_corner, a, b
-                //);
-            //} else {
-            //    erhe::geometry::log_geometry->info(
-            //        "pass 1: NOT created edge from facet {} corners {} and {} - vertices {} and {}",
-            //        facet, corner, next_corner, a, b
-            //    );
-            }
-        }
-    }
+    const GEO::index_t vertex_count     = m_mesh.vertices.nb();
+    const GEO::index_t facet_edge_count = m_mesh.facet_corners.nb();
 
-    // Second pass - non-shared edges wrong direction or non-manifold wrong direction
-        for (GEO::index_t facet : m_mesh.facets) {
+    // Collect facet edges, one per facet corner. Corners of each facet are
+    // contiguous, so facet edge index is the corner index.
+    class Facet_edge
+    {
+    public:
+        GEO::index_t lo;
+        GEO::index_t hi;
+        GEO::index_t facet;
+        bool         forward; // lo is the first vertex of the facet edge
+    };
+    std::vector<Facet_edge> facet_edges(facet_edge_count);
+    erhe::geometry::parallel_for(
+        executor, m_mesh.facets.nb(),
+        [this, &facet_edges](const std::size_t i) {
+            const GEO::index_t facet              = static_cast<GEO::index_t>(i);
             const GEO::index_t facet_corner_count = m_mesh.facets.nb_corners(facet);
             for (GEO::index_t local_facet_corner = 0; local_facet_corner < facet_corner_count; ++local_facet_corner) {
                 const GEO::index_t corner      = m_mesh.facets.corner(facet, local_facet_corner);
                 const GEO::index_t next_corner = m_mesh.facets.corner(facet, (local_facet_corner + 1) % facet_corner_count);
                 const GEO::index_t a           = m_mesh.facet_corners.vertex(corner);
                 const GEO::index_t b           = m_mesh.facet_corners.vertex(next_corner);
-            const GEO::index_t lo          = std::min(a, b);
-            const GEO::index_t hi          = std::max(a, b);
-            ERHE_VERIFY(lo != hi);
-            const std::pair<GEO::index_t, GEO::index_t> key{lo, hi};
-            const auto i = m_vertex_pair_to_edge.find(key);
-            if (i != m_vertex_pair_to_edge.end()) {
-                //const GEO::index_t edge = i->second;
-                //erhe::geometry::log_geometry->info(
-                //    "pass 2: found existing edge {} from facet {} corners {} and {} - vertices {} and {}",
-                //    edge, facet, corner, next_corner, a, b
-                //);
-                continue;
+                ERHE_VERIFY(a != b);
+                facet_edges[corner] = Facet_edge{
+                    .lo      = std::min(a, b),
+                    .hi      = std::max(a, b),
+                    .facet   = facet,
+                    .forward = a < b
+                };
             }
-            const GEO::index_t edge = m_mesh.edges.create_edge(lo, hi);
-            m_vertex_pair_to_edge.insert({key, edge});
-            m_vertex_to_edges[a].push_back(edge);
-            m_vertex_to_edges[b].push_back(edge);
-
-            //erhe::geometry::log_geometry->info(
-            //    "pass 2: created edge {} from facet {} corners {} and {} - vertices {} and {}",
-            //    edge, facet, corner, next_corner, a, b
-            //);
         }
+    );
+
+    // Counting sort facet edges by lo vertex. Within each row facet edges
+    // stay in facet corner order.
+    Index_adjacency lo_to_facet_edges;
+    lo_to_facet_edges.begin_counts(vertex_count);
+    for (const Facet_edge& facet_edge : facet_edges) {
+        lo_to_facet_edges.count(facet_edge.lo);
     }
+    lo_to_facet_edges.end_counts();
+    for (GEO::index_t facet_edge = 0; facet_edge < facet_edge_count; ++facet_edge) {
+        lo_to_facet_edges.push(facet_edges[facet_edge].lo, facet_edge);
+    }
+    lo_to_facet_edges.end_push();
+
+    // Group facet edges with equal (lo, hi) into unique edges. Each unique
+    // edge is keyed by its first forward facet edge, or its first facet edge
+    // if there is none, so that edge numbering matches creation order: first
+    // edges in facet direction (shared edges), then the remaining ones.
+    //
+    // Rows are independent: each row is sorted and its runs counted, a
+    // prefix sum gives the first unique edge of each row, and rows are then
+    // numbered in parallel with the same result as a serial pass.
+    std::vector<GEO::index_t> row_unique_offsets(static_cast<std::size_t>(vertex_count) + 1, 0);
+    erhe::geometry::parallel_for(
+        executor, vertex_count,
+        [&lo_to_facet_edges, &facet_edges, &row_unique_offsets](const std::size_t i) {
+            const GEO::index_t            lo  = static_cast<GEO::index_t>(i);
+            const std::span<GEO::index_t> row = lo_to_facet_edges.row(lo);
+            std::stable_sort(
+                row.begin(), row.end(),
+                [&facet_edges](const GEO::index_t lhs, const GEO::index_t rhs) {
+                    return facet_edges[lhs].hi < facet_edges[rhs].hi;
+                }
+            );
+            GEO::index_t run_count = 0;
+            for (std::size_t j = 0; j < row.size(); ++j) {
+                if ((j == 0) || (facet_edges[row[j]].hi != facet_edges[row[j - 1]].hi)) {
+                    ++run_count;
+                }
+            }
+            row_unique_offsets[i + 1] = run_count;
+        }
+    );
+    for (GEO::index_t lo = 0; lo < vertex_count; ++lo) {
+        row_unique_offsets[lo + 1] += row_unique_offsets[lo];
+    }
+    const GEO::index_t unique_count = row_unique_offsets[vertex_count];
+
+    std::vector<GEO::index_t> facet_edge_to_unique(facet_edge_count, GEO::NO_INDEX);
+    std::vector<GEO::index_t> key_to_unique       (facet_edge_count, GEO::NO_INDEX);
+    erhe::geometry::parallel_for(
+        executor, vertex_count,
+        [&lo_to_facet_edges, &facet_edges, &row_unique_offsets, &facet_edge_to_unique, &key_to_unique](const std::size_t i) {
+            const std::span<const GEO::index_t> row    = std::as_const(lo_to_facet_edges).row(static_cast<GEO::index_t>(i));
+            GEO::index_t                        unique = row_unique_offsets[i];
+            for (std::size_t run_begin = 0, run_end = 0; run_begin < row.size(); run_begin = run_end) {
+                const GEO::index_t hi  = facet_edges[row[run_begin]].hi;
+                GEO::index_t       key = row[run_begin];
+                for (run_end = run_begin; (run_end < row.size()) && (facet_edges[row[run_end]].hi == hi); ++run_end) {
+                    const GEO::index_t facet_edge = row[run_end];
+                    facet_edge_to_unique[facet_edge] = unique;
+                    if (!facet_edges[key].forward && facet_edges[facet_edge].forward) {
+                        key = facet_edge;
+                    }
+                }
+                key_to_unique[key] = unique;
+                ++unique;
+            }
+            ERHE_VERIFY(unique == row_unique_offsets[i + 1]);
+        }
+    );
 
-    m_edge_to_facets.clear();
-    const GEO::index_t edge_count = m_mesh.edges.nb();
-    m_edge_to_facets.resize(edge_count);
-    for (GEO::index_t facet : m_mesh.facets) {
-        const GEO::index_t facet_corner_count = m_mesh.facets.nb_corners(facet);
-        for (GEO::index_t local_facet_corner = 0; local_facet_corner < facet_corner_count; ++local_facet_corner) {
-            const GEO::index_t corner      = m_mesh.facets.corner(facet, local_facet_corner);
-            const GEO::index_t next_corner = m_mesh.facets.corner(facet, (local_facet_corner + 1) % facet_corner_count);
-            const GEO::index_t a           = m_mesh.facet_corners.vertex(corner);
-            const GEO::index_t b           = m_mesh.facet_corners.vertex(next_corner);
-            const GEO::index_t lo          = std::min(a, b);
-            const GEO::index_t hi          = std::max(a, b);
-            ERHE_VERIFY(lo != hi);
-            const std::pair<GEO::index_t, GEO::index_t> key{lo, hi};
-            const auto edge_i = m_vertex_pair_to_edge.find(key);
-            ERHE_VERIFY(m_vertex_pair_to_edge.find(key) != m_vertex_pair_to_edge.end());
-            const GEO::index_t edge = edge_i->second;
-            ERHE_VERIFY(edge < edge_count);
-            m_edge_to_facets[edge].push_back(facet);
-            //m_vertex_to_edges[lo].push_back(edge);
-            //m_vertex_to_edges[hi].push_back(edge);
+    // Create edges
+    std::vector<GEO::index_t> unique_to_edge(unique_count, GEO::NO_EDGE);
+    for (const bool forward : { true, false }) {
+        for (GEO::index_t key = 0; key < facet_edge_count; ++key) {
+            const GEO::index_t unique = key_to_unique[key];
+            if ((unique == GEO::NO_INDEX) || (facet_edges[key].forward != forward)) {
+                continue;
+            }
+            unique_to_edge[unique] = m_mesh.edges.create_edge(facet_edges[key].lo, facet_edges[key].hi);
         }
     }
+    const GEO::index_t edge_count = m_mesh.edges.nb();
+    ERHE_VERIFY(edge_count == unique_count);
+
+    // Vertex to edges, in edge order
+    m_vertex_to_edges.begin_counts(vertex_count);
+    for (GEO::index_t edge = 0; edge < edge_count; ++edge) {
+        m_vertex_to_edges.count(m_mesh.edges.vertex(edge, 0));
+        m_vertex_to_edges.count(m_mesh.edges.vertex(edge, 1));
+    }
+    m_vertex_to_edges.end_counts();
+    for (GEO::index_t edge = 0; edge < edge_count; ++edge) {
+        m_vertex_to_edges.push(m_mesh.edges.vertex(edge, 0), edge);
+        m_vertex_to_edges.push(m_mesh.edges.vertex(edge, 1), edge);
+    }
+    m_vertex_to_edges.end_push();
+
+    // Edge to facets, in facet order
+    m_edge_to_facets.begin_counts(edge_count);
+    for (GEO::index_t facet_edge = 0; facet_edge < facet_edge_count; ++facet_edge) {
+        m_edge_to_facets.count(unique_to_edge[facet_edge_to_unique[facet_edge]]);
+    }
+    m_edge_to_facets.end_counts();
+    for (GEO::index_t facet_edge = 0; facet_edge < facet_edge_count; ++facet_edge) {
+        m_edge_to_facets.push(unique_to_edge[facet_edge_to_unique[facet_edge]], facet_edges[facet_edge].facet);
+    }
+    m_edge_to_facets.end_push();
 }
 
-void Geometry::process(const uint64_t flags)
+void Geometry::process(const uint64_t flags, tf::Executor* const executor)
 {
     if (flags & process_flag_connect) {
         m_mesh.facets.connect();
     }
     if (flags & process_flag_build_edges) {
-        update_connectivity();
-        build_edges();
+        update_connectivity(executor);
+        build_edges(executor);
     }
     if (flags & process_flag_merge_coplanar_neighbors) {
         merge_coplanar_neighbors();
-        update_connectivity();
-        build_edges();
+        update_connectivity(executor);
+        build_edges(executor);
     }
     if (flags & process_flag_compute_smooth_vertex_normals) {
-        compute_mesh_vertex_normal_smooth(m_mesh, m_attributes);
+        compute_mesh_vertex_normal_smooth(m_mesh, m_attributes, executor);
     }
     if (flags & process_flag_compute_facet_centroids) {
-        compute_facet_centroids(m_mesh, m_attributes);
+        compute_facet_centroids(m_mesh, m_attributes, executor);
     }
     if (flags & process_flag_generate_facet_texture_coordinates) {
-        generate_mesh_facet_texture_coordinates();
+        generate_mesh_facet_texture_coordinates(executor);
     }
     if (flags & process_flag_debug_trace) {
         debug_trace();
     }
 }
 
-void Geometry::generate_mesh_facet_texture_coordinates()
+void Geometry::generate_mesh_facet_texture_coordinates(tf::Executor* const executor)
 {
-    ::generate_mesh_facet_texture_coordinates(m_mesh, m_attributes);
+    ::generate_mesh_facet_texture_coordinates(m_mesh, m_attributes, executor);
 }
 
 void build_extra_connectivity(
-    GEO::Mesh&                              mesh,
-    std::vector<std::vector<GEO::index_t>>& vertex_to_corners,
-    std::vector<GEO::index_t>&              corner_to_facet
+    GEO::Mesh&                 mesh,
+    Index_adjacency&           vertex_to_corners,
+    std::vector<GEO::index_t>& corner_to_facet,
+    tf::Executor* const        executor
 )
 {
     const GEO::index_t corner_count = mesh.facet_corners.nb();
     const GEO::index_t vertex_count = mesh.vertices.nb();
-    corner_to_facet.resize(corner_count);
-    vertex_to_corners.clear();
-    vertex_to_corners.resize(vertex_count);
+    vertex_to_corners.begin_counts(vertex_count);
     for (GEO::index_t corner : mesh.facet_corners) {
-        const GEO::index_t vertex = mesh.facet_corners.vertex(corner);
-        vertex_to_corners[vertex].push_back(corner);
-        corner_to_facet[corner] = GEO::NO_INDEX;
+        vertex_to_corners.count(mesh.facet_corners.vertex(corner));
     }
-    for (GEO::index_t facet : mesh.facets) {
-        for (GEO::index_t corner : mesh.facets.corners(facet)) {
-            corner_to_facet[corner] = facet;
-        }
+    vertex_to_corners.end_counts();
+    for (GEO::index_t corner : mesh.facet_corners) {
+        vertex_to_corners.push(mesh.facet_corners.vertex(corner), corner);
     }
+    vertex_to_corners.end_push();
+
+    // Each facet owns its corners
+    corner_to_facet.assign(corner_count, GEO::NO_INDEX);
+    erhe::geometry::parallel_for(
+        executor, mesh.facets.nb(),
+        [&mesh, &corner_to_facet](const std::size_t i) {
+            const GEO::index_t facet = static_cast<GEO::index_t>(i);
+            for (GEO::index_t corner : mesh.facets.corners(facet)) {
+                corner_to_facet[corner] = facet;
+            }
+        }
+    );
 
     class Vertex_corner_info
     {
@@ -1128,65 +1325,73 @@ void build_extra_connectivity(
         bool         used       {false};
     };
 
-    std::vector<Vertex_corner_info> vertex_corner_infos;
-    vertex_corner_infos.reserve(20);
-
-    for (GEO::index_t vertex : mesh.vertices) {
-        std::vector<GEO::index_t>& vertex_corners = vertex_to_corners[vertex];
-        if (vertex_corners.size() < 3) {
-            return;
-        }
-        vertex_corner_infos.clear();
+    // Corners are ordered around vertices up to the first vertex with less
+    // than three corners; from there on vertices keep corner order.
+    GEO::index_t ordered_vertex_count = 0;
+    while ((ordered_vertex_count < vertex_count) && (vertex_to_corners.row(ordered_vertex_count).size() >= 3)) {
+        ++ordered_vertex_count;
+    }
 
-        // for each corner, find the matching facet, and record what are prev and next vertices in that facet
-        for (GEO::index_t vertex_corner : vertex_corners) {
-            const GEO::index_t facet              = corner_to_facet[vertex_corner];
-            const GEO::index_t facet_corner_count = mesh.facets.nb_corners(facet);
-            for (GEO::index_t local_facet_corner = 0; local_facet_corner < facet_corner_count; ++local_facet_corner) {
-                const GEO::index_t facet_corner = mesh.facets.corner(facet, local_facet_corner);
-                if (facet_corner == vertex_corner) {
-                    const GEO::index_t prev_facet_corner = mesh.facets.corner(facet, (local_facet_corner + facet_corner_count - 1) % facet_corner_count);
-                    const GEO::index_t next_facet_corner = mesh.facets.corner(facet, (local_facet_corner + 1) % facet_corner_count);
-                    vertex_corner_infos.push_back(
-                        Vertex_corner_info{
-                            .vertex      = vertex,
-                            .corner      = vertex_corner,
-                            .prev_vertex = mesh.facet_corners.vertex(prev_facet_corner),
-                            .next_vertex = mesh.facet_corners.vertex(next_facet_corner),
-                            .used        = false
-                        }
-                    );
-                    break;
+    // Vertices only reorder their own row
+    erhe::geometry::parallel_for(
+        executor, ordered_vertex_count,
+        [&mesh, &vertex_to_corners, &corner_to_facet](const std::size_t i) {
+            const GEO::index_t            vertex         = static_cast<GEO::index_t>(i);
+            const std::span<GEO::index_t> vertex_corners = vertex_to_corners.row(vertex);
+
+            static thread_local std::vector<Vertex_corner_info> vertex_corner_infos;
+            vertex_corner_infos.clear();
+
+            // for each corner, find the matching facet, and record what are prev and next vertices in that facet
+            for (GEO::index_t vertex_corner : vertex_corners) {
+                const GEO::index_t facet              = corner_to_facet[vertex_corner];
+                const GEO::index_t facet_corner_count = mesh.facets.nb_corners(facet);
+                for (GEO::index_t local_facet_corner = 0; local_facet_corner < facet_corner_count; ++local_facet_corner) {
+                    const GEO::index_t facet_corner = mesh.facets.corner(facet, local_facet_corner);
+                    if (facet_corner == vertex_corner) {
+                        const GEO::index_t prev_facet_corner = mesh.facets.corner(facet, (local_facet_corner + facet_corner_count - 1) % facet_corner_count);
+                        const GEO::index_t next_facet_corner = mesh.facets.corner(facet, (local_facet_corner + 1) % facet_corner_count);
+                        vertex_corner_infos.push_back(
+                            Vertex_corner_info{
+                                .vertex      = vertex,
+                                .corner      = vertex_corner,
+                                .prev_vertex = mesh.facet_corners.vertex(prev_facet_corner),
+                                .next_vertex = mesh.facet_corners.vertex(next_facet_corner),
+                                .used        = false
+                            }
+                        );
+                        break;
+                    }
                 }
             }
-        }
 
-        // Find chained entries
-        for (GEO::index_t left_slot = 0, end = static_cast<GEO::index_t>(vertex_corner_infos.size()); left_slot < end; ++left_slot) {
-            const GEO::index_t  left_next_slot = (left_slot + 1) % end;
-            Vertex_corner_info& left_entry     = vertex_corner_infos[left_slot];
-            Vertex_corner_info& next           = vertex_corner_infos[left_next_slot];
-            for (GEO::index_t right_slot = 0; right_slot< end; ++right_slot) {
-                Vertex_corner_info& right_entry = vertex_corner_infos[right_slot];
-                if (right_entry.used) {
-                    continue;
-                }
-                if (right_entry.next_vertex == left_entry.prev_vertex) {
-                    right_entry.used = true;
-                    if (right_slot != left_next_slot) {
-                        std::swap(next, right_entry);
+            // Find chained entries
+            for (GEO::index_t left_slot = 0, end = static_cast<GEO::index_t>(vertex_corner_infos.size()); left_slot < end; ++left_slot) {
+                const GEO::index_t  left_next_slot = (left_slot + 1) % end;
+                Vertex_corner_info& left_entry     = vertex_corner_infos[left_slot];
+                Vertex_corner_info& next           = vertex_corner_infos[left_next_slot];
+                for (GEO::index_t right_slot = 0; right_slot< end; ++right_slot) {
+                    Vertex_corner_info& right_entry = vertex_corner_infos[right_slot];
+                    if (right_entry.used) {
+                        continue;
+                    }
+                    if (right_entry.next_vertex == left_entry.prev_vertex) {
+                        right_entry.used = true;
+                        if (right_slot != left_next_slot) {
+                            std::swap(next, right_entry);
+                        }
+                        break;
                     }
-                    break;
                 }
+                vertex_corners[left_slot] = left_entry.corner;
             }
-            vertex_corners[left_slot] = left_entry.corner;
         }
-    }
+    );
 }
 
-void Geometry::update_connectivity()
+void Geometry::update_connectivity(tf::Executor* const executor)
 {
-    build_extra_connectivity(m_mesh, m_vertex_to_corners, m_corner_to_facet);
+    build_extra_connectivity(m_mesh, m_vertex_to_corners, m_corner_to_facet, executor);
 }
 
 
@@ -1238,7 +1443,7 @@ void Geometry::merge_coplanar_neighbors()
     for (GEO::index_t edge : m_mesh.edges) {
         std::optional<GEO::vec3f> reference_normal;
         bool can_merge = true;
-        for (GEO::index_t facet : m_edge_to_facets.at(edge)) {
+        for (GEO::index_t facet : get_edge_facets(edge)) {
             GEO::vec3f facet_normal = mesh_facet_normalf(m_mesh, facet);
             if (!reference_normal.has_value()) {
                 reference_normal = facet_normal;
@@ -1273,7 +1478,7 @@ void Geometry::merge_coplanar_neighbors()
             .v0               = m_mesh.edges.vertex(edge, 0),
             .v1               = m_mesh.edges.vertex(edge, 1),
             .facets_to_delete = facets_to_delete,
-            .edge_facets      = m_edge_to_facets.at(edge)
+            .edge_facets      = get_edge_facets(edge)
         };
         ERHE_VERIFY(context.edge_facets.size() == 2);
 
@@ -1319,14 +1524,14 @@ void Geometry::debug_trace() const
     for (GEO::index_t vertex : m_mesh.vertices) {
         GEO::vec3f position = get_pointf(m_mesh.vertices, vertex);
         log_geometry->info("vertex {:2} position = {}", vertex, position);
-        if (vertex < m_vertex_to_corners.size()) {
+        if (vertex < m_vertex_to_corners.row_count()) {
             std::stringstream corners_ss;
             std::stringstream facets_ss;
             corners_ss << fmt::format("vertex {:2} corners = ", vertex);
             facets_ss  << fmt::format("vertex {:2} facets = ", vertex);
             bool first = true;
             bool have_facets = true;
-            for (GEO::index_t corner : m_vertex_to_corners.at(vertex)) {
+            for (GEO::index_t corner : m_vertex_to_corners.row(vertex)) {
                 if (!first) {
                     corners_ss << ", ";
                     facets_ss << ", ";
@@ -1370,9 +1575,9 @@ void Geometry::debug_trace() const
         const GEO::index_t vertex_0 = m_mesh.edges.vertex(edge, 0);
         const GEO::index_t vertex_1 = m_mesh.edges.vertex(edge, 1);
         ss << fmt::format("edge {:2} = {:2} .. {:2}", edge, vertex_0, vertex_1);
-        if (edge < m_edge_to_facets.size()) {
+        if (edge < m_edge_to_facets.row_count()) {
             ss << " : ";
-            for (GEO::index_t facet : m_edge_to_facets.at(edge)) {
+            for (GEO::index_t facet : m_edge_to_facets.row(edge)) {
                 ss << fmt::format("{:2} ", facet);
             }
         }
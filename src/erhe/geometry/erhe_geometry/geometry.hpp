@@ -8,10 +8,15 @@
 #include <functional>
 #include <memory>
 #include <optional>
+#include <span>
+#include <vector>
 
 namespace spdlog {
     class logger;
 }
+namespace tf {
+    class Executor;
+}
 
 namespace GEO {
     typedef Matrix<4, GEO::Numeric::float32> mat4f;
@@ -294,12 +299,14 @@ void transform_mesh(
     Mesh_attributes&       destination_attributes,
     const GEO::mat4f&      transform
 );
-void compute_facet_normals                   (GEO::Mesh& mesh, Mesh_attributes& attributes);
-void compute_facet_centroids                 (GEO::Mesh& mesh, Mesh_attributes& attributes);
-void compute_mesh_vertex_normal_smooth       (GEO::Mesh& mesh, Mesh_attributes& attributes);
+// Functions taking an executor run per facet / per vertex work in parallel
+// when it is given; results are identical to serial execution.
+void compute_facet_normals                   (GEO::Mesh& mesh, Mesh_attributes& attributes, tf::Executor* executor = nullptr);
+void compute_facet_centroids                 (GEO::Mesh& mesh, Mesh_attributes& attributes, tf::Executor* executor = nullptr);
+void compute_mesh_vertex_normal_smooth       (GEO::Mesh& mesh, Mesh_attributes& attributes, tf::Executor* executor = nullptr);
 auto compute_mesh_tangents                   (GEO::Mesh& mesh, bool make_facets_flat) -> bool;
 void generate_mesh_facet_texture_coordinates (GEO::Mesh& mesh, GEO::index_t facet, Mesh_attributes& attributes);
-void generate_mesh_facet_texture_coordinates (GEO::Mesh& mesh, Mesh_attributes& attributes);
+void generate_mesh_facet_texture_coordinates (GEO::Mesh& mesh, Mesh_attributes& attributes, tf::Executor* executor = nullptr);
 
 [[nodiscard]] inline auto min_axis(const GEO::vec3f v) -> GEO::vec3f
 {
@@ -444,12 +451,16 @@ inline void gram_schmidt(const GEO::vec3f& a, const GEO::vec3f& b, const GEO::ve
 
 [[nodiscard]] auto make_convex_hull(const GEO::Mesh& source, GEO::Mesh& destination) -> bool;
 
+// Interpolates destination keys in [dst_key_begin, dst_key_end). Disjoint
+// key ranges can be interpolated concurrently.
 template <typename T>
 inline void interpolate_attribute(
     const Attribute_present<T>&                                     source_,
     Attribute_present<T>&                                           destination_,
-    const std::vector<std::vector<std::pair<float, GEO::index_t>>>& key_dst_to_src
-) 
+    const std::vector<std::vector<std::pair<float, GEO::index_t>>>& key_dst_to_src,
+    const GEO::index_t                                              dst_key_begin,
+    const GEO::index_t                                              dst_key_end
+)
 {
     const GEO::Attribute<T>&    source              = source_.attribute;
     const GEO::Attribute<bool>& source_present      = source_.present;
@@ -461,7 +472,7 @@ inline void interpolate_attribute(
         return;
     }
 
-    for (GEO::index_t dst_key = 0, end = static_cast<GEO::index_t>(key_dst_to_src.size()); dst_key < end; ++dst_key) {
+    for (GEO::index_t dst_key = dst_key_begin; dst_key < dst_key_end; ++dst_key) {
         const std::vector<std::pair<float, GEO::index_t>>& src_keys = key_dst_to_src[dst_key];
         float sum_weights{0.0f};
         for (auto j : src_keys) {
@@ -517,6 +528,16 @@ inline void interpolate_attribute(
     }
 }
 
+template <typename T>
+inline void interpolate_attribute(
+    const Attribute_present<T>&                                     source,
+    Attribute_present<T>&                                           destination,
+    const std::vector<std::vector<std::pair<float, GEO::index_t>>>& key_dst_to_src
+)
+{
+    interpolate_attribute(source, destination, key_dst_to_src, 0, static_cast<GEO::index_t>(key_dst_to_src.size()));
+}
+
 template <typename T>
 inline void copy_attribute(const Attribute_present<T>& source, Attribute_present<T>& destination)
 {
@@ -683,6 +704,29 @@ auto mesh_facet_centerf(const GEO::Mesh& M, GEO::index_t f) -> GEO::vec3f;
 
 namespace erhe::geometry {
 
+// Index lists stored in compressed sparse row form: entries of row i are
+// values[offsets[i]] .. values[offsets[i + 1] - 1]. Rows are built with a
+// counting sort; count entries per row, take prefix sum, then scatter.
+class Index_adjacency
+{
+public:
+    void clear();
+    void begin_counts(std::size_t row_count);
+    void count       (GEO::index_t row) { ++offsets[row + 1]; }
+    void end_counts  ();                  // prefix sum, allocates values and resets cursors
+    void push        (GEO::index_t row, GEO::index_t value) { values[cursors[row]++] = value; }
+    void end_push    ();                  // releases cursors
+
+    [[nodiscard]] auto row_count       () const -> std::size_t;
+    [[nodiscard]] auto row             (GEO::index_t row) const -> std::span<const GEO::index_t>;
+    [[nodiscard]] auto row             (GEO::index_t row) -> std::span<GEO::index_t>;
+    [[nodiscard]] auto get_memory_usage() const -> std::size_t;
+
+    std::vector<GEO::index_t> offsets;
+    std::vector<GEO::index_t> values;
+    std::vector<GEO::index_t> cursors;
+};
+
 class Geometry
 {
 public:
@@ -692,13 +736,14 @@ public:
     [[nodiscard]] auto get_name          () const -> const std::string&;
     [[nodiscard]] auto get_mesh          () -> GEO::Mesh&;
     [[nodiscard]] auto get_mesh          () const -> const GEO::Mesh&;
-    [[nodiscard]] auto get_vertex_corners(GEO::index_t vertex) const -> const std::vector<GEO::index_t>&;
-    [[nodiscard]] auto get_vertex_edges  (GEO::index_t vertex) const -> const std::vector<GEO::index_t>&;
+    [[nodiscard]] auto get_vertex_corners(GEO::index_t vertex) const -> std::span<const GEO::index_t>;
+    [[nodiscard]] auto get_vertex_edges  (GEO::index_t vertex) const -> std::span<const GEO::index_t>;
     [[nodiscard]] auto get_corner_facet  (GEO::index_t corner) const -> GEO::index_t;
-    [[nodiscard]] auto get_edge_facets   (GEO::index_t edge) const -> const std::vector<GEO::index_t>&;
+    [[nodiscard]] auto get_edge_facets   (GEO::index_t edge) const -> std::span<const GEO::index_t>;
     [[nodiscard]] auto get_edge          (GEO::index_t v0, GEO::index_t v1) const -> GEO::index_t;
     [[nodiscard]] auto get_attributes    () -> Mesh_attributes&;
     [[nodiscard]] auto get_attributes    () const -> const Mesh_attributes&;
+    [[nodiscard]] auto get_memory_usage  () const -> std::size_t; // approximate, in bytes
 
     void merge_with_transform(const Geometry& src, const GEO::mat4f& transform);
     void copy_with_transform(const Geometry& source, const GEO::mat4f& transform);
@@ -713,10 +758,11 @@ public:
     static constexpr uint64_t process_flag_debug_trace                        = (1u << 5u);
     static constexpr uint64_t process_flag_merge_coplanar_neighbors           = (1u << 6u);
 
-    void process(uint64_t flags);
-    void generate_mesh_facet_texture_coordinates();
-    void build_edges();
-    void update_connectivity();
+    // Per facet, per vertex and per adjacency row passes use executor when given
+    void process(uint64_t flags, tf::Executor* executor = nullptr);
+    void generate_mesh_facet_texture_coordinates(tf::Executor* executor = nullptr);
+    void build_edges        (tf::Executor* executor = nullptr);
+    void update_connectivity(tf::Executor* executor = nullptr);
     void merge_coplanar_neighbors();
 
     void debug_trace() const;
@@ -758,34 +804,22 @@ private:
             return std::find(facets_to_delete.begin(), facets_to_delete.end(), facet) != facets_to_delete.end();
         };
 
-        GEO::index_t                     edge;
-        GEO::index_t                     v0;
-        GEO::index_t                     v1;
-        GEO::vector<GEO::index_t>&       facets_to_delete;
-        std::vector<GEO::index_t>        merged_face_corners;
-        const std::vector<GEO::index_t>& edge_facets;
+        GEO::index_t                   edge;
+        GEO::index_t                   v0;
+        GEO::index_t                   v1;
+        GEO::vector<GEO::index_t>&     facets_to_delete;
+        std::vector<GEO::index_t>      merged_face_corners;
+        std::span<const GEO::index_t>  edge_facets;
     };
     void collect_corners_from_facet(Edge_collapse_context& edge_collapse_context, GEO::index_t facet, std::optional<GEO::index_t> trigger_vertex);
 
     GEO::Mesh                              m_mesh;
     Mesh_attributes                        m_attributes;
     std::string                            m_name;
-    std::vector<std::vector<GEO::index_t>> m_vertex_to_corners;
+    Index_adjacency                        m_vertex_to_corners;
     std::vector<GEO::index_t>              m_corner_to_facet;
-    std::vector<std::vector<GEO::index_t>> m_edge_to_facets;
-    std::vector<std::vector<GEO::index_t>> m_vertex_to_edges;
-
-    struct Edge_hash
-    {
-        std::size_t operator()(const std::pair<GEO::index_t, GEO::index_t>& edge) const
-        {
-            return
-                std::hash<GEO::index_t>()(edge.first) ^
-                std::hash<GEO::index_t>()(edge.second ^ 0xcafecafe);
-        }
-    };
-
-    std::unordered_map<std::pair<GEO::index_t, GEO::index_t>, GEO::index_t, Edge_hash> m_vertex_pair_to_edge;
+    Index_adjacency                        m_edge_to_facets;
+    Index_adjacency                        m_vertex_to_edges;
 
     mutable std::vector<Debug_text> m_debug_texts;
     mutable std::vector<Debug_line> m_debug_lines;
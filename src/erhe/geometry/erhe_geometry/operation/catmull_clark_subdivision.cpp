@@ -2,15 +2,18 @@
 #include "erhe_geometry/operation/geometry_operation.hpp"
 #include "erhe_geometry/geometry.hpp"
 #include "erhe_geometry/geometry_log.hpp"
+#include "erhe_geometry/parallel_for.hpp"
 #include "erhe_profile/profile.hpp"
 #include "erhe_verify/verify.hpp"
 
+#include <vector>
+
 namespace erhe::geometry::operation {
 
 class Catmull_clark_subdivision : public Geometry_operation
 {
 public:
-    Catmull_clark_subdivision(const Geometry& source, Geometry& destination);
+    Catmull_clark_subdivision(const Geometry& source, Geometry& destination, tf::Executor* executor);
     void build();
 };
 
@@ -28,8 +31,8 @@ public:
 //
 // For each corner in the src facet, add one quad
 // (centroid, previous edge 'edge midpoint', corner, next edge 'edge midpoint')
-Catmull_clark_subdivision::Catmull_clark_subdivision(const Geometry& source, Geometry& destination)
-    : Geometry_operation{source, destination}
+Catmull_clark_subdivision::Catmull_clark_subdivision(const Geometry& source, Geometry& destination, tf::Executor* executor)
+    : Geometry_operation{source, destination, executor}
 {
 }
 
@@ -44,19 +47,29 @@ void Catmull_clark_subdivision::build()
     // Make initial P's with ------
     //                          n
     {
-        for (GEO::index_t vertex : source_mesh.vertices) {
-            const std::vector<GEO::index_t>& corners = source.get_vertex_corners(vertex);
-            if (corners.size() >= 3) {
-                const float n = static_cast<float>(corners.size());
-                // n = 0   -> centroid points, safe to skip
-                // n = 1,2 -> ?
-                // n = 3   -> ?
-                const float weight = (n - 3.0f) / n;
-                make_new_dst_vertex_from_src_vertex(weight, vertex);
-            } else {
-                make_new_dst_vertex_from_src_vertex(1.0f, vertex);
+        const GEO::index_t src_vertex_count = source_mesh.vertices.nb();
+        const GEO::index_t first_dst_vertex = destination_mesh.vertices.create_vertices(src_vertex_count);
+        m_vertex_src_to_dst.resize(src_vertex_count);
+        reserve_sources();
+        parallel_for(
+            m_executor, src_vertex_count,
+            [this, first_dst_vertex](const std::size_t i) {
+                const GEO::index_t                  vertex         = static_cast<GEO::index_t>(i);
+                const GEO::index_t                  new_dst_vertex = first_dst_vertex + vertex;
+                const std::span<const GEO::index_t> corners        = source.get_vertex_corners(vertex);
+                m_vertex_src_to_dst[vertex] = new_dst_vertex;
+                if (corners.size() >= 3) {
+                    const float n = static_cast<float>(corners.size());
+                    // n = 0   -> centroid points, safe to skip
+                    // n = 1,2 -> ?
+                    // n = 3   -> ?
+                    const float weight = (n - 3.0f) / n;
+                    add_vertex_source(new_dst_vertex, weight, vertex);
+                } else {
+                    add_vertex_source(new_dst_vertex, 1.0f, vertex);
+                }
             }
-        }
+        );
     }
 
     // Make new edge midpoints
@@ -110,44 +123,60 @@ void Catmull_clark_subdivision::build()
             //  n
             const auto corner_weight = 1.0f / static_cast<float>(source_mesh.facets.nb_vertices(src_facet));
             for (GEO::index_t src_corner : source_mesh.facets.corners(src_facet)) {
-                const GEO::index_t               src_vertex         = source_mesh.facet_corners.vertex(src_corner);
-                const GEO::index_t               dst_vertex         = m_vertex_src_to_dst[src_vertex];
-                const std::vector<GEO::index_t>& src_vertex_corners = source.get_vertex_corners(src_vertex);
-                const float                      vertex_weight      = 1.0f / static_cast<float>(src_vertex_corners.size());
+                const GEO::index_t                  src_vertex         = source_mesh.facet_corners.vertex(src_corner);
+                const GEO::index_t                  dst_vertex         = m_vertex_src_to_dst[src_vertex];
+                const std::span<const GEO::index_t> src_vertex_corners = source.get_vertex_corners(src_vertex);
+                const float                         vertex_weight      = 1.0f / static_cast<float>(src_vertex_corners.size());
                 add_facet_centroid(dst_vertex, vertex_weight * vertex_weight * corner_weight, src_facet);
             }
         }
     }
 
     // Subdivide facets, clone (and corners);
+    // Quads are created first, in the same order as before, and filled in parallel
     {
+        std::vector<GEO::index_t> src_facet_first_dst_facet(source_mesh.facets.nb());
         for (GEO::index_t src_facet : source_mesh.facets) {
             for (GEO::index_t local_facet_corner = 0, corner_count = source_mesh.facets.nb_vertices(src_facet); local_facet_corner < corner_count; ++ local_facet_corner) {
-                const GEO::index_t prev_local_facet_corner = (local_facet_corner + corner_count - 1) % corner_count;
-                const GEO::index_t next_local_facet_corner = (local_facet_corner +                1) % corner_count;
-                const GEO::index_t prev_src_corner         = source_mesh.facets.corner(src_facet, prev_local_facet_corner);
-                const GEO::index_t src_corner              = source_mesh.facets.corner(src_facet, local_facet_corner);
-                const GEO::index_t next_corner             = source_mesh.facets.corner(src_facet, next_local_facet_corner);
-                const GEO::index_t prev_src_vertex         = source_mesh.facet_corners.vertex(prev_src_corner);
-                const GEO::index_t src_vertex              = source_mesh.facet_corners.vertex(src_corner);
-                const GEO::index_t next_src_vertex         = source_mesh.facet_corners.vertex(next_corner);
-                const GEO::index_t previous_edge_midpoint  = get_src_edge_new_vertex(prev_src_vertex, src_vertex, 0);
-                const GEO::index_t next_edge_midpoint      = get_src_edge_new_vertex(src_vertex, next_src_vertex, 0);
-                const GEO::index_t new_dst_facet           = make_new_dst_facet_from_src_facet(src_facet, 4);
-                make_new_dst_corner_from_src_facet_centroid(new_dst_facet, 0, src_facet);
-                make_new_dst_corner_from_dst_vertex        (new_dst_facet, 1, previous_edge_midpoint);
-                make_new_dst_corner_from_src_corner        (new_dst_facet, 2, src_corner);
-                make_new_dst_corner_from_dst_vertex        (new_dst_facet, 3, next_edge_midpoint);
+                const GEO::index_t new_dst_facet = make_new_dst_facet_from_src_facet(src_facet, 4);
+                if (local_facet_corner == 0) {
+                    src_facet_first_dst_facet[src_facet] = new_dst_facet;
+                }
             }
         }
+        reserve_sources();
+
+        parallel_for(
+            m_executor, src_facet_first_dst_facet.size(),
+            [this, &src_facet_first_dst_facet](const std::size_t i) {
+                const GEO::index_t src_facet = static_cast<GEO::index_t>(i);
+                for (GEO::index_t local_facet_corner = 0, corner_count = source_mesh.facets.nb_vertices(src_facet); local_facet_corner < corner_count; ++ local_facet_corner) {
+                    const GEO::index_t prev_local_facet_corner = (local_facet_corner + corner_count - 1) % corner_count;
+                    const GEO::index_t next_local_facet_corner = (local_facet_corner +                1) % corner_count;
+                    const GEO::index_t prev_src_corner         = source_mesh.facets.corner(src_facet, prev_local_facet_corner);
+                    const GEO::index_t src_corner              = source_mesh.facets.corner(src_facet, local_facet_corner);
+                    const GEO::index_t next_corner             = source_mesh.facets.corner(src_facet, next_local_facet_corner);
+                    const GEO::index_t prev_src_vertex         = source_mesh.facet_corners.vertex(prev_src_corner);
+                    const GEO::index_t src_vertex              = source_mesh.facet_corners.vertex(src_corner);
+                    const GEO::index_t next_src_vertex         = source_mesh.facet_corners.vertex(next_corner);
+                    const GEO::index_t previous_edge_midpoint  = get_src_edge_new_vertex(prev_src_vertex, src_vertex, 0);
+                    const GEO::index_t next_edge_midpoint      = get_src_edge_new_vertex(src_vertex, next_src_vertex, 0);
+                    const GEO::index_t new_dst_facet           = src_facet_first_dst_facet[src_facet] + local_facet_corner;
+                    make_new_dst_corner_from_src_facet_centroid(new_dst_facet, 0, src_facet);
+                    make_new_dst_corner_from_dst_vertex        (new_dst_facet, 1, previous_edge_midpoint);
+                    make_new_dst_corner_from_src_corner        (new_dst_facet, 2, src_corner);
+                    make_new_dst_corner_from_dst_vertex        (new_dst_facet, 3, next_edge_midpoint);
+                }
+            }
+        );
     }
 
     post_processing();
 }
 
-void catmull_clark_subdivision(const Geometry& source, Geometry& destination)
+void catmull_clark_subdivision(const Geometry& source, Geometry& destination, tf::Executor* executor)
 {
-    Catmull_clark_subdivision operation{source, destination};
+    Catmull_clark_subdivision operation{source, destination, executor};
     operation.build();
 }
 
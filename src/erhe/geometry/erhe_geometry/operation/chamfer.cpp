@@ -187,7 +187,7 @@ void Chamfer::build()
     std::fill(vertex_min_heights.begin(), vertex_min_heights.end(), std::numeric_limits<float>::max());
     float min_height = std::numeric_limits<float>::max();
     for (GEO::index_t src_edge : source_mesh.edges) {
-        const std::vector<GEO::index_t>& edge_facets = source.get_edge_facets(src_edge);
+        const std::span<const GEO::index_t> edge_facets = source.get_edge_facets(src_edge);
         GEO::vec3f normal_sum{0.0f, 0.0f, 0.0f};
         for (GEO::index_t facet : edge_facets) {
             normal_sum += mesh_facet_normalf(source_mesh, facet);
@@ -288,7 +288,7 @@ void Chamfer::build()
             ////     source.add_debug_line(GEO::NO_INDEX, src_facet, to_glm_vec3(mp12), to_glm_vec3(ep12), glm::vec4{1.0f, 2.0f, 0.0f, 1.0f}, 1.0f);
             //// }
 
-            const std::vector<GEO::index_t>& vertex_edges = source.get_vertex_edges(vertex);
+            const std::span<const GEO::index_t> vertex_edges = source.get_vertex_edges(vertex);
             for (GEO::index_t edge : vertex_edges) {
                 if ((edge == lhs_edge) || (edge == rhs_edge)) {
                     continue;
@@ -422,7 +422,7 @@ void Chamfer::build()
 
     // Create new dst hexagon facets matching source mesh edges
     for (GEO::index_t src_edge : source_mesh.edges) {
-        const std::vector<GEO::index_t>& edge_facets = source.get_edge_facets(src_edge);
+        const std::span<const GEO::index_t> edge_facets = source.get_edge_facets(src_edge);
         ERHE_VERIFY(edge_facets.size() == 2); // TODO
         const GEO::index_t lo_vertex              = source_mesh.edges.vertex(src_edge, 0);
         const GEO::index_t hi_vertex              = source_mesh.edges.vertex(src_edge, 1);
@@ -1,5 +1,8 @@
 #include "erhe_geometry/operation/dual.hpp"
 #include "erhe_geometry/operation/geometry_operation.hpp"
+#include "erhe_geometry/parallel_for.hpp"
+
+#include <vector>
 
 namespace erhe::geometry::operation {
 
@@ -7,13 +10,13 @@ namespace erhe::geometry::operation {
 class Dual : public Geometry_operation
 {
 public:
-    Dual(const Geometry& source, Geometry& destination);
+    Dual(const Geometry& source, Geometry& destination, tf::Executor* executor);
 
     void build();
 };
 
-Dual::Dual(const Geometry& source, Geometry& destination)
-    : Geometry_operation{source, destination}
+Dual::Dual(const Geometry& source, Geometry& destination, tf::Executor* executor)
+    : Geometry_operation{source, destination, executor}
 {
 }
 
@@ -24,24 +27,36 @@ void Dual::build()
     // build_src_corner_to_src_facet();
     make_facet_centroids();
 
-    // New facets from old verticess, new facet corner for each old vertex corner
+    // New facets from old verticess, new facet corner for each old vertex corner.
+    // Facets are created first, corners are filled in parallel.
+    std::vector<GEO::index_t> src_vertex_to_dst_facet(source_mesh.vertices.nb());
     for (GEO::index_t src_vertex : source_mesh.vertices) {
-        const std::vector<GEO::index_t>& src_corners = source.get_vertex_corners(src_vertex);
-        const GEO::index_t src_corner_count = static_cast<GEO::index_t>(src_corners.size());
-        const GEO::index_t new_dst_facet = destination_mesh.facets.create_polygon(src_corner_count);
-        for (GEO::index_t local_facet_corner = 0; local_facet_corner < src_corner_count; ++local_facet_corner) {
-            const GEO::index_t src_corner = src_corners[local_facet_corner];
-            const GEO::index_t src_facet = source.get_corner_facet(src_corner);
-            make_new_dst_corner_from_src_facet_centroid(new_dst_facet, local_facet_corner, src_facet);
-        }
+        const GEO::index_t src_corner_count = static_cast<GEO::index_t>(source.get_vertex_corners(src_vertex).size());
+        src_vertex_to_dst_facet[src_vertex] = destination_mesh.facets.create_polygon(src_corner_count);
     }
+    reserve_sources();
+
+    parallel_for(
+        m_executor, src_vertex_to_dst_facet.size(),
+        [this, &src_vertex_to_dst_facet](const std::size_t i) {
+            const GEO::index_t                  src_vertex       = static_cast<GEO::index_t>(i);
+            const std::span<const GEO::index_t> src_corners      = source.get_vertex_corners(src_vertex);
+            const GEO::index_t                  src_corner_count = static_cast<GEO::index_t>(src_corners.size());
+            const GEO::index_t                  new_dst_facet    = src_vertex_to_dst_facet[src_vertex];
+            for (GEO::index_t local_facet_corner = 0; local_facet_corner < src_corner_count; ++local_facet_corner) {
+                const GEO::index_t src_corner = src_corners[local_facet_corner];
+                const GEO::index_t src_facet = source.get_corner_facet(src_corner);
+                make_new_dst_corner_from_src_facet_centroid(new_dst_facet, local_facet_corner, src_facet);
+            }
+        }
+    );
 
     post_processing();
 }
 
-void dual(const Geometry& source, Geometry& destination)
+void dual(const Geometry& source, Geometry& destination, tf::Executor* executor)
 {
-    Dual operation{source, destination};
+    Dual operation{source, destination, executor};
     operation.build();
 }
 
@@ -1,10 +1,13 @@
 #include "erhe_geometry/operation/geometry_operation.hpp"
 #include "erhe_geometry/geometry.hpp"
 #include "erhe_geometry/geometry_log.hpp"
+#include "erhe_geometry/parallel_for.hpp"
 #include "erhe_verify/verify.hpp"
 
 #include <geogram/mesh/mesh.h>
 
+#include <algorithm>
+
 namespace erhe::geometry::operation {
 
 auto Geometry_operation::get_size_to_include(std::size_t size, std::size_t i) -> size_t
@@ -20,23 +23,57 @@ auto Geometry_operation::get_size_to_include(std::size_t size, std::size_t i) ->
     }
 }
 
-void Geometry_operation::make_dst_vertices_from_src_vertices()
+void Geometry_operation::reserve_sources()
 {
-    GEO::index_t src_vertex_count = source_mesh.vertices.nb();
-    m_vertex_src_to_dst.reserve(src_vertex_count);
+    const auto reserve = [](std::vector<std::vector<std::pair<float, GEO::index_t>>>& sources, const GEO::index_t count) {
+        if (sources.size() < count) {
+            sources.resize(count);
+        }
+    };
+    reserve(m_dst_vertex_sources,        destination_mesh.vertices.nb());
+    reserve(m_dst_vertex_corner_sources, destination_mesh.vertices.nb());
+    reserve(m_dst_corner_sources,        destination_mesh.facet_corners.nb());
+    reserve(m_dst_facet_sources,         destination_mesh.facets.nb());
+}
 
-    for (GEO::index_t src_vertex = 0; src_vertex < src_vertex_count; ++src_vertex) {
-        make_new_dst_vertex_from_src_vertex(src_vertex);
+void Geometry_operation::make_dst_vertices_from_src_vertices()
+{
+    const GEO::index_t src_vertex_count = source_mesh.vertices.nb();
+    const GEO::index_t first_dst_vertex = destination_mesh.vertices.create_vertices(src_vertex_count);
+    if (m_vertex_src_to_dst.size() < src_vertex_count) {
+        m_vertex_src_to_dst.resize(src_vertex_count);
     }
+    reserve_sources();
+
+    parallel_for(
+        m_executor, src_vertex_count,
+        [this, first_dst_vertex](const std::size_t i) {
+            const GEO::index_t src_vertex     = static_cast<GEO::index_t>(i);
+            const GEO::index_t new_dst_vertex = first_dst_vertex + src_vertex;
+            add_vertex_source(new_dst_vertex, 1.0f, src_vertex);
+            m_vertex_src_to_dst[src_vertex] = new_dst_vertex;
+        }
+    );
 }
 
 void Geometry_operation::make_facet_centroids()
 {
-    GEO::index_t src_facet_count = source_mesh.facets.nb();
-    m_src_facet_centroid_to_dst_vertex.reserve(src_facet_count);
-    for (GEO::index_t src_facet : source_mesh.facets) {
-        make_new_dst_vertex_from_src_facet_centroid(src_facet);
+    const GEO::index_t src_facet_count  = source_mesh.facets.nb();
+    const GEO::index_t first_dst_vertex = destination_mesh.vertices.create_vertices(src_facet_count);
+    if (m_src_facet_centroid_to_dst_vertex.size() < src_facet_count) {
+        m_src_facet_centroid_to_dst_vertex.resize(src_facet_count);
     }
+    reserve_sources();
+
+    parallel_for(
+        m_executor, src_facet_count,
+        [this, first_dst_vertex](const std::size_t i) {
+            const GEO::index_t src_facet      = static_cast<GEO::index_t>(i);
+            const GEO::index_t new_dst_vertex = first_dst_vertex + src_facet;
+            m_src_facet_centroid_to_dst_vertex[src_facet] = new_dst_vertex;
+            add_facet_centroid(new_dst_vertex, 1.0f, src_facet);
+        }
+    );
 }
 
 void Geometry_operation::build_edge_to_facets_map(
@@ -72,7 +109,7 @@ void Geometry_operation::make_edge_midpoints(const std::initializer_list<float>
     const GEO::index_t new_dst_vertex_end   = new_dst_vertex_start + new_dst_vertex_count;
     GEO::index_t new_dst_vertex = new_dst_vertex_start;
     for (GEO::index_t src_edge : source_mesh.edges) {
-        const std::vector<GEO::index_t>&            src_edge_facets = source.get_edge_facets(src_edge);
+        const std::span<const GEO::index_t>         src_edge_facets = source.get_edge_facets(src_edge);
         const GEO::index_t                          src_vertex_a    = source_mesh.edges.vertex(src_edge, 0);
         const GEO::index_t                          src_vertex_b    = source_mesh.edges.vertex(src_edge, 1);
         const std::pair<GEO::index_t, GEO::index_t> src_edge_key    = std::make_pair(src_vertex_a, src_vertex_b);
@@ -323,55 +360,87 @@ void Geometry_operation::interpolate_mesh_attributes()
     const Mesh_attributes& s = source.get_attributes();
     Mesh_attributes&       d = destination.get_attributes();
 
-    for (GEO::index_t vertex : destination_mesh.vertices) {
-        const std::vector<std::pair<float, GEO::index_t>>& src_keys = m_dst_vertex_sources[vertex];
-        float sum_weights{0.0f};
-        for (auto j : src_keys) {
-            //const GEO::index_t src_key = j.second;
-            sum_weights += j.first;
-        }
+    // Each chunk interpolates all attributes for its range of destination keys
+    static constexpr GEO::index_t chunk_size = 4096;
+    const auto for_each_chunk = [this](const GEO::index_t key_count, auto&& op) {
+        const GEO::index_t chunk_count = (key_count + chunk_size - 1) / chunk_size;
+        parallel_for(
+            (key_count >= c_parallel_for_min_count) ? m_executor : nullptr,
+            chunk_count,
+            [key_count, &op](const std::size_t chunk) {
+                const GEO::index_t begin = static_cast<GEO::index_t>(chunk) * chunk_size;
+                const GEO::index_t end   = std::min(begin + chunk_size, key_count);
+                op(begin, end);
+            }
+        );
+    };
+
+    for_each_chunk(
+        destination_mesh.vertices.nb(),
+        [this, &s, &d](const GEO::index_t begin, const GEO::index_t end) {
+            for (GEO::index_t vertex = begin; vertex < end; ++vertex) {
+                const std::vector<std::pair<float, GEO::index_t>>& src_keys = m_dst_vertex_sources[vertex];
+                float sum_weights{0.0f};
+                for (auto j : src_keys) {
+                    //const GEO::index_t src_key = j.second;
+                    sum_weights += j.first;
+                }
+
+                if (sum_weights == 0.0f) {
+                    continue;
+                }
+
+                GEO::vec3f dst_value{0.0f, 0.0f, 0.0f};
+                for (auto j : src_keys) {
+                    const GEO::index_t src_key = j.second;
+
+                    const float      weight    = j.first;
+                    const GEO::vec3f src_value = get_pointf(source_mesh.vertices, src_key);
+                    dst_value += static_cast<GEO::vec3f>((weight / sum_weights) * src_value);
+                }
+
+                set_pointf(destination_mesh.vertices, vertex, dst_value);
+            }
 
-        if (sum_weights == 0.0f) {
-            continue;
+            interpolate_attribute<GEO::vec3f>(s.vertex_normal,          d.vertex_normal,          m_dst_vertex_sources, begin, end);
+            interpolate_attribute<GEO::vec3f>(s.vertex_normal_smooth,   d.vertex_normal_smooth,   m_dst_vertex_sources, begin, end);
+            interpolate_attribute<GEO::vec2f>(s.vertex_texcoord_0,      d.vertex_texcoord_0,      m_dst_vertex_sources, begin, end);
+            interpolate_attribute<GEO::vec2f>(s.vertex_texcoord_1,      d.vertex_texcoord_1,      m_dst_vertex_sources, begin, end);
+            interpolate_attribute<GEO::vec4f>(s.vertex_tangent,         d.vertex_tangent,         m_dst_vertex_sources, begin, end);
+            interpolate_attribute<GEO::vec3f>(s.vertex_bitangent,       d.vertex_bitangent,       m_dst_vertex_sources, begin, end);
+            interpolate_attribute<GEO::vec4f>(s.vertex_color_0,         d.vertex_color_0,         m_dst_vertex_sources, begin, end);
+            interpolate_attribute<GEO::vec4f>(s.vertex_color_1,         d.vertex_color_1,         m_dst_vertex_sources, begin, end);
+            interpolate_attribute<GEO::vec4f>(s.vertex_joint_weights_0, d.vertex_joint_weights_0, m_dst_vertex_sources, begin, end);
+            interpolate_attribute<GEO::vec4f>(s.vertex_joint_weights_1, d.vertex_joint_weights_1, m_dst_vertex_sources, begin, end);
+            interpolate_attribute<GEO::vec4u>(s.vertex_joint_indices_0, d.vertex_joint_indices_0, m_dst_vertex_sources, begin, end);
+            interpolate_attribute<GEO::vec4u>(s.vertex_joint_indices_1, d.vertex_joint_indices_1, m_dst_vertex_sources, begin, end);
+            interpolate_attribute<GEO::vec2f>(s.vertex_aniso_control,   d.vertex_aniso_control,   m_dst_vertex_sources, begin, end);
         }
+    );
 
-        GEO::vec3f dst_value{0.0f, 0.0f, 0.0f};
-        for (auto j : src_keys) {
-            const GEO::index_t src_key = j.second;
-
-            const float      weight    = j.first;
-            const GEO::vec3f src_value = get_pointf(source_mesh.vertices, src_key);
-            dst_value += static_cast<GEO::vec3f>((weight / sum_weights) * src_value);
+    // Recompute facet_id, facet_centroid, facet_normal
+    for_each_chunk(
+        destination_mesh.facets.nb(),
+        [this, &s, &d](const GEO::index_t begin, const GEO::index_t end) {
+            interpolate_attribute<GEO::vec4f>(s.facet_color_0,       d.facet_color_0,       m_dst_facet_sources, begin, end);
+            interpolate_attribute<GEO::vec4f>(s.facet_color_1,       d.facet_color_1,       m_dst_facet_sources, begin, end);
+            interpolate_attribute<GEO::vec2f>(s.facet_aniso_control, d.facet_aniso_control, m_dst_facet_sources, begin, end);
         }
+    );
 
-        set_pointf(destination_mesh.vertices, vertex, dst_value);
-    }
-
-    // Recompute facet_id, facet_centroid, facet_normal
-    interpolate_attribute<GEO::vec4f>(s.facet_color_0,          d.facet_color_0,          m_dst_facet_sources);
-    interpolate_attribute<GEO::vec4f>(s.facet_color_1,          d.facet_color_1,          m_dst_facet_sources);
-    interpolate_attribute<GEO::vec2f>(s.facet_aniso_control,    d.facet_aniso_control,    m_dst_facet_sources);
-    interpolate_attribute<GEO::vec3f>(s.vertex_normal,          d.vertex_normal,          m_dst_vertex_sources);
-    interpolate_attribute<GEO::vec3f>(s.vertex_normal_smooth,   d.vertex_normal_smooth,   m_dst_vertex_sources);
-    interpolate_attribute<GEO::vec2f>(s.vertex_texcoord_0,      d.vertex_texcoord_0,      m_dst_vertex_sources);
-    interpolate_attribute<GEO::vec2f>(s.vertex_texcoord_1,      d.vertex_texcoord_1,      m_dst_vertex_sources);
-    interpolate_attribute<GEO::vec4f>(s.vertex_tangent,         d.vertex_tangent,         m_dst_vertex_sources);
-    interpolate_attribute<GEO::vec3f>(s.vertex_bitangent,       d.vertex_bitangent,       m_dst_vertex_sources);
-    interpolate_attribute<GEO::vec4f>(s.vertex_color_0,         d.vertex_color_0,         m_dst_vertex_sources);
-    interpolate_attribute<GEO::vec4f>(s.vertex_color_1,         d.vertex_color_1,         m_dst_vertex_sources);
-    interpolate_attribute<GEO::vec4f>(s.vertex_joint_weights_0, d.vertex_joint_weights_0, m_dst_vertex_sources);
-    interpolate_attribute<GEO::vec4f>(s.vertex_joint_weights_1, d.vertex_joint_weights_1, m_dst_vertex_sources);
-    interpolate_attribute<GEO::vec4u>(s.vertex_joint_indices_0, d.vertex_joint_indices_0, m_dst_vertex_sources);
-    interpolate_attribute<GEO::vec4u>(s.vertex_joint_indices_1, d.vertex_joint_indices_1, m_dst_vertex_sources);
-    interpolate_attribute<GEO::vec2f>(s.vertex_aniso_control,   d.vertex_aniso_control,   m_dst_vertex_sources);
-    interpolate_attribute<GEO::vec3f>(s.corner_normal,          d.corner_normal,          m_dst_corner_sources);
-    interpolate_attribute<GEO::vec2f>(s.corner_texcoord_0,      d.corner_texcoord_0,      m_dst_corner_sources);
-    interpolate_attribute<GEO::vec2f>(s.corner_texcoord_1,      d.corner_texcoord_1,      m_dst_corner_sources);
-    interpolate_attribute<GEO::vec4f>(s.corner_tangent,         d.corner_tangent,         m_dst_corner_sources);
-    interpolate_attribute<GEO::vec3f>(s.corner_bitangent,       d.corner_bitangent,       m_dst_corner_sources);
-    interpolate_attribute<GEO::vec4f>(s.corner_color_0,         d.corner_color_0,         m_dst_corner_sources);
-    interpolate_attribute<GEO::vec4f>(s.corner_color_1,         d.corner_color_1,         m_dst_corner_sources);
-    interpolate_attribute<GEO::vec2f>(s.corner_aniso_control,   d.corner_aniso_control,   m_dst_corner_sources);
+    for_each_chunk(
+        destination_mesh.facet_corners.nb(),
+        [this, &s, &d](const GEO::index_t begin, const GEO::index_t end) {
+            interpolate_attribute<GEO::vec3f>(s.corner_normal,        d.corner_normal,        m_dst_corner_sources, begin, end);
+            interpolate_attribute<GEO::vec2f>(s.corner_texcoord_0,    d.corner_texcoord_0,    m_dst_corner_sources, begin, end);
+            interpolate_attribute<GEO::vec2f>(s.corner_texcoord_1,    d.corner_texcoord_1,    m_dst_corner_sources, begin, end);
+            interpolate_attribute<GEO::vec4f>(s.corner_tangent,       d.corner_tangent,       m_dst_corner_sources, begin, end);
+            interpolate_attribute<GEO::vec3f>(s.corner_bitangent,     d.corner_bitangent,     m_dst_corner_sources, begin, end);
+            interpolate_attribute<GEO::vec4f>(s.corner_color_0,       d.corner_color_0,       m_dst_corner_sources, begin, end);
+            interpolate_attribute<GEO::vec4f>(s.corner_color_1,       d.corner_color_1,       m_dst_corner_sources, begin, end);
+            interpolate_attribute<GEO::vec2f>(s.corner_aniso_control, d.corner_aniso_control, m_dst_corner_sources, begin, end);
+        }
+    );
 
     // TODO edge attributes
 }
@@ -420,7 +489,7 @@ void Geometry_operation::post_processing()
         erhe::geometry::Geometry::process_flag_compute_facet_centroids |
         erhe::geometry::Geometry::process_flag_compute_smooth_vertex_normals |
         erhe::geometry::Geometry::process_flag_generate_facet_texture_coordinates;
-    destination.process(flags);
+    destination.process(flags, m_executor);
 }
 
 } // namespace erhe::geometry::operation
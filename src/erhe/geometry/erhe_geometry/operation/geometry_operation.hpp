@@ -8,6 +8,10 @@
 #include <vector>
 #include <unordered_map>
 
+namespace tf {
+    class Executor;
+}
+
 struct pair_hash {
     template <typename T1, typename T2>
     auto operator() (const std::pair<T1, T2>& p) const -> std::size_t {
@@ -22,7 +26,7 @@ namespace erhe::geometry::operation {
 class Geometry_operation
 {
 public:
-    Geometry_operation(const erhe::geometry::Geometry& source, erhe::geometry::Geometry& destination)
+    Geometry_operation(const erhe::geometry::Geometry& source, erhe::geometry::Geometry& destination, tf::Executor* executor = nullptr)
         : source          {source}
         , lhs             {source}
         , rhs             {nullptr}
@@ -31,6 +35,7 @@ public:
         , lhs_mesh        {source.get_mesh()}
         , rhs_mesh        {nullptr}
         , destination_mesh{destination.get_mesh()}
+        , m_executor      {executor}
     {
     }
 
@@ -58,6 +63,7 @@ protected:
     const GEO::Mesh&                                         lhs_mesh;
     const GEO::Mesh*                                         rhs_mesh;
     GEO::Mesh&                                               destination_mesh;
+    tf::Executor*                                            m_executor{nullptr};
 
     std::vector<GEO::index_t>                                m_vertex_src_to_dst;
     std::vector<GEO::index_t>                                m_facet_src_to_dst;
@@ -76,6 +82,11 @@ protected:
         pair_hash
     > m_src_edge_to_dst_vertex;
 
+    // Sizes source tables to cover all current destination elements, so
+    // add_*_source() for existing elements does not reallocate. Must be
+    // called before adding sources from parallel_for() with m_executor.
+    void reserve_sources();
+
     void make_dst_vertices_from_src_vertices();
     void make_facet_centroids               ();
     void build_edge_to_facets_map(
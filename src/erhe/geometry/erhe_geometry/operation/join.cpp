@@ -27,7 +27,7 @@ void Join::build()
     // build_src_edge_to_src_facets();
 
     for (GEO::index_t src_edge : source_mesh.edges) {
-        const std::vector<GEO::index_t>& src_facets = source.get_edge_facets(src_edge);
+        const std::span<const GEO::index_t> src_facets = source.get_edge_facets(src_edge);
         if (src_facets.size() != 2) {
             continue;
         }
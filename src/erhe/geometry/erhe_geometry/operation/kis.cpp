@@ -1,18 +1,21 @@
 #include "erhe_geometry/operation/kis.hpp"
 #include "erhe_geometry/operation/geometry_operation.hpp"
+#include "erhe_geometry/parallel_for.hpp"
+
+#include <vector>
 
 namespace erhe::geometry::operation {
 
 class Kis : public Geometry_operation
 {
 public:
-    Kis(const Geometry& source, Geometry& destination);
+    Kis(const Geometry& source, Geometry& destination, tf::Executor* executor);
 
     void build();
 };
 
-Kis::Kis(const Geometry& source, Geometry& destination)
-    : Geometry_operation{source, destination}
+Kis::Kis(const Geometry& source, Geometry& destination, tf::Executor* executor)
+    : Geometry_operation{source, destination, executor}
 {
 }
 
@@ -21,24 +24,40 @@ void Kis::build()
     make_dst_vertices_from_src_vertices();
     make_facet_centroids();
 
+    // One triangle for each src facet corner; create all triangles first,
+    // then fill them in parallel
+    const GEO::index_t src_facet_count = source_mesh.facets.nb();
+    std::vector<GEO::index_t> src_facet_first_dst_facet(src_facet_count);
+    GEO::index_t dst_facet_count = 0;
     for (GEO::index_t src_facet : source_mesh.facets) {
-        const GEO::index_t src_facet_corner_count = source_mesh.facets.nb_corners(src_facet);
-        for (GEO::index_t local_src_facet_corner = 0; local_src_facet_corner < src_facet_corner_count; ++local_src_facet_corner) {
-            const GEO::index_t src_corner      = source_mesh.facets.corner(src_facet, local_src_facet_corner);
-            const GEO::index_t next_src_corner = source_mesh.facets.corner(src_facet, (local_src_facet_corner + 1) % src_facet_corner_count);
-            const GEO::index_t new_dst_facet   = destination_mesh.facets.create_triangles(1);
-            make_new_dst_corner_from_src_facet_centroid(new_dst_facet, 0, src_facet);
-            make_new_dst_corner_from_src_corner        (new_dst_facet, 1, src_corner);
-            make_new_dst_corner_from_src_corner        (new_dst_facet, 2, next_src_corner);
-        }
+        src_facet_first_dst_facet[src_facet] = dst_facet_count;
+        dst_facet_count += source_mesh.facets.nb_corners(src_facet);
     }
+    const GEO::index_t first_dst_facet = (dst_facet_count > 0) ? destination_mesh.facets.create_triangles(dst_facet_count) : 0;
+    reserve_sources();
+
+    parallel_for(
+        m_executor, src_facet_count,
+        [this, &src_facet_first_dst_facet, first_dst_facet](const std::size_t i) {
+            const GEO::index_t src_facet              = static_cast<GEO::index_t>(i);
+            const GEO::index_t src_facet_corner_count = source_mesh.facets.nb_corners(src_facet);
+            for (GEO::index_t local_src_facet_corner = 0; local_src_facet_corner < src_facet_corner_count; ++local_src_facet_corner) {
+                const GEO::index_t src_corner      = source_mesh.facets.corner(src_facet, local_src_facet_corner);
+                const GEO::index_t next_src_corner = source_mesh.facets.corner(src_facet, (local_src_facet_corner + 1) % src_facet_corner_count);
+                const GEO::index_t new_dst_facet   = first_dst_facet + src_facet_first_dst_facet[src_facet] + local_src_facet_corner;
+                make_new_dst_corner_from_src_facet_centroid(new_dst_facet, 0, src_facet);
+                make_new_dst_corner_from_src_corner        (new_dst_facet, 1, src_corner);
+                make_new_dst_corner_from_src_corner        (new_dst_facet, 2, next_src_corner);
+            }
+        }
+    );
 
     post_processing();
 }
 
-void kis(const Geometry& source, Geometry& destination)
+void kis(const Geometry& source, Geometry& destination, tf::Executor* executor)
 {
-    Kis operation{source, destination};
+    Kis operation{source, destination, executor};
     operation.build();
 }
 
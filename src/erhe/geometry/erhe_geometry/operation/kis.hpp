@@ -1,9 +1,10 @@
 #pragma once
 
 namespace erhe::geometry { class Geometry; }
+namespace tf { class Executor; }
 
 namespace erhe::geometry::operation {
 
-void kis(const Geometry& source, Geometry& destination);
+void kis(const Geometry& source, Geometry& destination, tf::Executor* executor = nullptr);
 
 } // namespace erhe::geometry::operation
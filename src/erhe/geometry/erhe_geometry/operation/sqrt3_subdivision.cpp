@@ -1,18 +1,21 @@
 #include "erhe_geometry/operation/sqrt3_subdivision.hpp"
 #include "erhe_geometry/operation/geometry_operation.hpp"
+#include "erhe_geometry/parallel_for.hpp"
+
+#include <vector>
 
 namespace erhe::geometry::operation {
 
 class Sqrt3_subdivision : public Geometry_operation
 {
 public:
-    Sqrt3_subdivision(const Geometry& source, Geometry& destination);
+    Sqrt3_subdivision(const Geometry& source, Geometry& destination, tf::Executor* executor);
 
     void build();
 };
 
-Sqrt3_subdivision::Sqrt3_subdivision(const Geometry& source, Geometry& destination)
-    : Geometry_operation{source, destination}
+Sqrt3_subdivision::Sqrt3_subdivision(const Geometry& source, Geometry& destination, tf::Executor* executor)
+    : Geometry_operation{source, destination, executor}
 {
 }
 
@@ -36,18 +39,32 @@ void Sqrt3_subdivision::build()
     // TODO At least assert these are available
     // build_src_vertex_to_src_corners();
 
-    for (GEO::index_t src_vertex : source_mesh.vertices) {
-        const std::vector<GEO::index_t> src_corners      = source.get_vertex_corners(src_vertex);
-        const float                     n                = static_cast<float>(src_corners.size());
-        const float                     alpha            = (4.0f - 2.0f * std::cos(2.0f * pi / n)) / 9.0f;
-        const float                     alpha_per_n      = alpha / static_cast<float>(n);
-        const float                     alpha_complement = 1.0f - alpha;
-        const GEO::index_t              new_dst_vertex   = make_new_dst_vertex_from_src_vertex(alpha_complement, src_vertex);
-        add_vertex_ring(new_dst_vertex, alpha_per_n, src_vertex);
-    }
+    const GEO::index_t src_vertex_count = source_mesh.vertices.nb();
+    const GEO::index_t first_dst_vertex = destination_mesh.vertices.create_vertices(src_vertex_count);
+    m_vertex_src_to_dst.resize(src_vertex_count);
+    reserve_sources();
+    parallel_for(
+        m_executor, src_vertex_count,
+        [this, first_dst_vertex](const std::size_t i) {
+            const GEO::index_t                  src_vertex       = static_cast<GEO::index_t>(i);
+            const std::span<const GEO::index_t> src_corners      = source.get_vertex_corners(src_vertex);
+            const float                         n                = static_cast<float>(src_corners.size());
+            const float                         alpha            = (4.0f - 2.0f * std::cos(2.0f * pi / n)) / 9.0f;
+            const float                         alpha_per_n      = alpha / static_cast<float>(n);
+            const float                         alpha_complement = 1.0f - alpha;
+            const GEO::index_t                  new_dst_vertex   = first_dst_vertex + src_vertex;
+            m_vertex_src_to_dst[src_vertex] = new_dst_vertex;
+            add_vertex_source(new_dst_vertex, alpha_complement, src_vertex);
+            add_vertex_ring(new_dst_vertex, alpha_per_n, src_vertex);
+        }
+    );
 
     make_facet_centroids();
 
+    // One triangle for each src facet edge that has an opposite facet.
+    // Triangles are created first, in the same order as before, and
+    // filled in parallel.
+    std::vector<GEO::index_t> src_corner_to_dst_facet(source_mesh.facet_corners.nb(), GEO::NO_INDEX);
     for (const GEO::index_t src_facet : source_mesh.facets) {
         const GEO::index_t src_corner_count = source_mesh.facets.nb_corners(src_facet);
         for (GEO::index_t local_src_facet_corner = 0; local_src_facet_corner < src_corner_count; ++local_src_facet_corner) {
@@ -57,19 +74,36 @@ void Sqrt3_subdivision::build()
             if (opposite_src_facet == GEO::NO_INDEX) {
                 continue;
             }
-            const GEO::index_t new_dst_facet = make_new_dst_facet_from_src_facet(src_facet, 3);
-            make_new_dst_corner_from_src_facet_centroid(new_dst_facet, 0, src_facet);
-            make_new_dst_corner_from_src_corner        (new_dst_facet, 1, src_corner);
-            make_new_dst_corner_from_src_facet_centroid(new_dst_facet, 2, opposite_src_facet);
+            src_corner_to_dst_facet[src_corner] = make_new_dst_facet_from_src_facet(src_facet, 3);
         }
     }
+    reserve_sources();
+
+    parallel_for(
+        m_executor, source_mesh.facets.nb(),
+        [this, &src_corner_to_dst_facet](const std::size_t i) {
+            const GEO::index_t src_facet        = static_cast<GEO::index_t>(i);
+            const GEO::index_t src_corner_count = source_mesh.facets.nb_corners(src_facet);
+            for (GEO::index_t local_src_facet_corner = 0; local_src_facet_corner < src_corner_count; ++local_src_facet_corner) {
+                const GEO::index_t src_corner    = source_mesh.facets.corner(src_facet, local_src_facet_corner);
+                const GEO::index_t new_dst_facet = src_corner_to_dst_facet[src_corner];
+                if (new_dst_facet == GEO::NO_INDEX) {
+                    continue;
+                }
+                const GEO::index_t opposite_src_facet = source_mesh.facets.adjacent(src_facet, local_src_facet_corner);
+                make_new_dst_corner_from_src_facet_centroid(new_dst_facet, 0, src_facet);
+                make_new_dst_corner_from_src_corner        (new_dst_facet, 1, src_corner);
+                make_new_dst_corner_from_src_facet_centroid(new_dst_facet, 2, opposite_src_facet);
+            }
+        }
+    );
 
     post_processing();
 }
 
-void sqrt3_subdivision(const Geometry& source, Geometry& destination)
+void sqrt3_subdivision(const Geometry& source, Geometry& destination, tf::Executor* executor)
 {
-    Sqrt3_subdivision operation{source, destination};
+    Sqrt3_subdivision operation{source, destination, executor};
     operation.build();
 }
 
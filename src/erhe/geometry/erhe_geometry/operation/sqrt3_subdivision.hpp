@@ -1,9 +1,10 @@
 #pragma once
 
 namespace erhe::geometry { class Geometry; }
+namespace tf { class Executor; }
 
 namespace erhe::geometry::operation {
 
-void sqrt3_subdivision(const Geometry& source, Geometry& destination);
+void sqrt3_subdivision(const Geometry& source, Geometry& destination, tf::Executor* executor = nullptr);
 
 } // namespace erhe::geometry::operation
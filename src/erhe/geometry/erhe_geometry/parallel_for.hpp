@@ -0,0 +1,33 @@
+#pragma once
+
+#include <taskflow/taskflow.hpp>
+
+#include <cstddef>
+
+namespace erhe::geometry {
+
+// Below this element count the loop runs on the calling thread
+static constexpr std::size_t c_parallel_for_min_count = 1024;
+
+// Calls op(i) for each i in [0, count). With executor, indices are split
+// across workers; op must only write to elements owned by index i, so the
+// result does not depend on the schedule.
+template <typename Op>
+void parallel_for(tf::Executor* const executor, const std::size_t count, Op&& op)
+{
+    if ((executor == nullptr) || (count < c_parallel_for_min_count) || (executor->num_workers() < 2)) {
+        for (std::size_t i = 0; i < count; ++i) {
+            op(i);
+        }
+        return;
+    }
+    tf::Taskflow taskflow;
+    taskflow.for_each_index(std::size_t{0}, count, std::size_t{1}, op);
+    if (executor->this_worker_id() >= 0) {
+        executor->corun(taskflow);
+    } else {
+        executor->run(taskflow).wait();
+    }
+}
+
+} // namespace erhe::geometry
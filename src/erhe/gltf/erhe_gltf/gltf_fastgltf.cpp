@@ -5,6 +5,7 @@
 #include "image_transfer.hpp"
 
 #include "erhe_buffer/ibuffer.hpp"
+#include "erhe_dataformat/dataformat.hpp"
 #include "erhe_dataformat/vertex_format.hpp"
 #include "erhe_file/file.hpp"
 #include "erhe_gl/wrapper_functions.hpp"
@@ -36,13 +37,17 @@
 #include <fastgltf/core.hpp>
 #include <fastgltf/tools.hpp>
 #include <fastgltf/types.hpp>
+#include <taskflow/taskflow.hpp>
 
 #include <fmt/chrono.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
 #include <algorithm>
+#include <cstring>
+#include <functional>
 #include <limits>
+#include <map>
 #include <numeric>
 #include <string>
 #include <variant>
@@ -710,6 +715,66 @@ void copyComponentsFromAccessor(const fastgltf::Asset& asset, const fastgltf::Ac
     }
 }
 
+// Source format for batch conversion of accessor to floats;
+// format_undefined if accessor is not float or normalized 8/16 bit
+[[nodiscard]] auto get_accessor_float_source_format(const fastgltf::Accessor& accessor) -> erhe::dataformat::Format
+{
+    using Format = erhe::dataformat::Format;
+    static constexpr Format float_formats  [4] = { Format::format_32_scalar_float, Format::format_32_vec2_float, Format::format_32_vec3_float, Format::format_32_vec4_float };
+    static constexpr Format unorm8_formats [4] = { Format::format_8_scalar_unorm,  Format::format_8_vec2_unorm,  Format::format_8_vec3_unorm,  Format::format_8_vec4_unorm  };
+    static constexpr Format snorm8_formats [4] = { Format::format_8_scalar_snorm,  Format::format_8_vec2_snorm,  Format::format_8_vec3_snorm,  Format::format_8_vec4_snorm  };
+    static constexpr Format unorm16_formats[4] = { Format::format_16_scalar_unorm, Format::format_16_vec2_unorm, Format::format_16_vec3_unorm, Format::format_16_vec4_unorm };
+    static constexpr Format snorm16_formats[4] = { Format::format_16_scalar_snorm, Format::format_16_vec2_snorm, Format::format_16_vec3_snorm, Format::format_16_vec4_snorm };
+
+    const std::size_t component_count = fastgltf::getNumComponents(accessor.type);
+    if ((component_count < 1) || (component_count > 4)) {
+        return Format::format_undefined;
+    }
+    const std::size_t i = component_count - 1;
+    switch (accessor.componentType) {
+        case fastgltf::ComponentType::Float        : return float_formats[i];
+        case fastgltf::ComponentType::UnsignedByte : return accessor.normalized ? unorm8_formats [i] : Format::format_undefined;
+        case fastgltf::ComponentType::Byte         : return accessor.normalized ? snorm8_formats [i] : Format::format_undefined;
+        case fastgltf::ComponentType::UnsignedShort: return accessor.normalized ? unorm16_formats[i] : Format::format_undefined;
+        case fastgltf::ComponentType::Short        : return accessor.normalized ? snorm16_formats[i] : Format::format_undefined;
+        default:                                     return Format::format_undefined;
+    }
+}
+
+// Converts all elements of accessor to floats with erhe::dataformat batch
+// conversion. Returns false if the accessor must be read with fastgltf
+// instead (sparse, no buffer view, or not float / normalized).
+[[nodiscard]] auto convert_accessor_to_floats(
+    const fastgltf::Asset&         asset,
+    const fastgltf::Accessor&      accessor,
+    const erhe::dataformat::Format float_format,
+    float*                         out
+) -> bool
+{
+    ERHE_PROFILE_FUNCTION();
+
+    if ((bool(accessor.sparse) && (accessor.sparse->count > 0)) || !accessor.bufferViewIndex.has_value()) {
+        return false;
+    }
+    const erhe::dataformat::Format src_format = get_accessor_float_source_format(accessor);
+    if (src_format == erhe::dataformat::Format::format_undefined) {
+        return false;
+    }
+
+    const auto& view       = asset.bufferViews[*accessor.bufferViewIndex];
+    const auto  src_stride = view.byteStride.value_or(erhe::dataformat::get_format_size(src_format));
+
+    const fastgltf::DefaultBufferDataAdapter adapter{};
+    const auto src_bytes = adapter(asset, *accessor.bufferViewIndex).subspan(accessor.byteOffset);
+    erhe::dataformat::convert(
+        src_bytes.data(), src_format, src_stride,
+        out, float_format, erhe::dataformat::get_format_size(float_format),
+        accessor.count,
+        1.0f
+    );
+    return true;
+}
+
 class Gltf_parser
 {
 private:
@@ -751,10 +816,24 @@ public:
             return;
         }
 
+        // Images are decoded on the executor in batches, which bounds the
+        // amount of decoded pixel data held at once. Textures are created
+        // and uploaded on this thread, in image index order.
         log_gltf->trace("parsing images");
-        m_data_out.images.resize(m_asset->images.size());
-        for (std::size_t i = 0, end = m_asset->images.size(); i < end; ++i) {
-            parse_image(i);
+        const std::size_t image_count = m_asset->images.size();
+        m_data_out.images.resize(image_count);
+        for (std::size_t batch_begin = 0; batch_begin < image_count; batch_begin += c_image_batch_size) {
+            const std::size_t          batch_end = std::min(batch_begin + c_image_batch_size, image_count);
+            std::vector<Decoded_image> decoded_images(batch_end - batch_begin);
+            for_each_index(
+                decoded_images.size(),
+                [this, batch_begin, &decoded_images](const std::size_t i) {
+                    decode_image(batch_begin + i, decoded_images[i]);
+                }
+            );
+            for (std::size_t i = 0, end = decoded_images.size(); i < end; ++i) {
+                parse_image(batch_begin + i, decoded_images[i]);
+            }
         }
 
         log_gltf->trace("parsing samplers");
@@ -781,6 +860,19 @@ public:
             parse_light(i);
         }
 
+        // Unique primitive geometries are loaded on the executor. Mesh
+        // items are created afterwards on this thread, in mesh index order.
+        log_gltf->trace("loading primitive geometries");
+        collect_primitive_entries();
+        for_each_index(
+            m_primitive_entries.size(),
+            [this](const std::size_t i) {
+                Primitive_entry&           primitive_entry = m_primitive_entries[i];
+                const fastgltf::Primitive& primitive       = m_asset->meshes[primitive_entry.mesh_index].primitives[primitive_entry.primitive_index];
+                load_new_primitive_geometry(primitive, primitive_entry);
+            }
+        );
+
         log_gltf->trace("parsing meshes");
         m_data_out.meshes.resize(m_asset->meshes.size());
         for (std::size_t i = 0, end = m_asset->meshes.size(); i < end; ++i) {
@@ -828,6 +920,29 @@ public:
     }
 
 private:
+    static constexpr std::size_t c_image_batch_size = 16;
+
+    // Runs op for each index in [0, count), as executor tasks when an
+    // executor is available. Returns after all indices have been processed.
+    void for_each_index(const std::size_t count, const std::function<void(std::size_t)>& op)
+    {
+        tf::Executor* executor = m_arguments.executor;
+        if ((executor == nullptr) || (count < 2)) {
+            for (std::size_t i = 0; i < count; ++i) {
+                op(i);
+            }
+            return;
+        }
+
+        tf::Taskflow taskflow;
+        taskflow.for_each_index(std::size_t{0}, count, std::size_t{1}, [&op](const std::size_t i) { op(i); });
+        if (executor->this_worker_id() >= 0) {
+            executor->corun(taskflow);
+        } else {
+            executor->run(taskflow).wait();
+        }
+    }
+
     void trace_info() const
     {
         if (m_asset->assetInfo.has_value()) {
@@ -897,40 +1012,51 @@ private:
             std::vector<float> timestamps(inputAccessor.count);
             std::vector<float> values   (output_float_count);
             const fastgltf::Asset& asset = m_asset.get();
-            fastgltf::iterateAccessorWithIndex<float>(
-                asset, inputAccessor,
-                [&](float value, std::size_t idx) {
-                    timestamps[idx] = value;
-                }
-            );
+            if (!convert_accessor_to_floats(asset, inputAccessor, erhe::dataformat::Format::format_32_scalar_float, timestamps.data())) {
+                fastgltf::iterateAccessorWithIndex<float>(
+                    asset, inputAccessor,
+                    [&](float value, std::size_t idx) {
+                        timestamps[idx] = value;
+                    }
+                );
+            }
 
-            switch (outputAccessor.type) {
-                case fastgltf::AccessorType::Vec3: {
-                    fastgltf::iterateAccessorWithIndex<fastgltf::math::fvec3>(
-                        asset, outputAccessor,
-                        [&](fastgltf::math::fvec3 value, std::size_t idx) {
-                           values[idx * 3 + 0] = value.x();
-                           values[idx * 3 + 1] = value.y();
-                           values[idx * 3 + 2] = value.z();
-                        }
-                    );
-                    break;
-                }
-                case fastgltf::AccessorType::Vec4: {
-                    fastgltf::iterateAccessorWithIndex<fastgltf::math::fvec4>(
-                        asset, outputAccessor,
-                        [&](fastgltf::math::fvec4 value, std::size_t idx) {
-                           values[idx * 4 + 0] = value.x();
-                           values[idx * 4 + 1] = value.y();
-                           values[idx * 4 + 2] = value.z();
-                           values[idx * 4 + 3] = value.w();
-                        }
-                    );
-                    break;
-                }
-                default: {
-                    // TODO log warning
-                    break;
+            const erhe::dataformat::Format output_format = (outputAccessor.type == fastgltf::AccessorType::Vec3)
+                ? erhe::dataformat::Format::format_32_vec3_float
+                : erhe::dataformat::Format::format_32_vec4_float;
+            const bool output_converted =
+                ((outputAccessor.type == fastgltf::AccessorType::Vec3) || (outputAccessor.type == fastgltf::AccessorType::Vec4)) &&
+                convert_accessor_to_floats(asset, outputAccessor, output_format, values.data());
+
+            if (!output_converted) {
+                switch (outputAccessor.type) {
+                    case fastgltf::AccessorType::Vec3: {
+                        fastgltf::iterateAccessorWithIndex<fastgltf::math::fvec3>(
+                            asset, outputAccessor,
+                            [&](fastgltf::math::fvec3 value, std::size_t idx) {
+                               values[idx * 3 + 0] = value.x();
+                               values[idx * 3 + 1] = value.y();
+                               values[idx * 3 + 2] = value.z();
+                            }
+                        );
+                        break;
+                    }
+                    case fastgltf::AccessorType::Vec4: {
+                        fastgltf::iterateAccessorWithIndex<fastgltf::math::fvec4>(
+                            asset, outputAccessor,
+                            [&](fastgltf::math::fvec4 value, std::size_t idx) {
+                               values[idx * 4 + 0] = value.x();
+                               values[idx * 4 + 1] = value.y();
+                               values[idx * 4 + 2] = value.z();
+                               values[idx * 4 + 3] = value.w();
+                            }
+                        );
+                        break;
+                    }
+                    default: {
+                        // TODO log warning
+                        break;
+                    }
                 }
             }
 
@@ -987,91 +1113,52 @@ private:
         }
         m_data_out.animations[animation_index] = erhe_animation;
     }
-    auto load_image_file(
-        const std::filesystem::path& path,
-        std::string_view             image_name
-    ) -> std::shared_ptr<erhe::graphics::Texture>
+    class Decoded_image
     {
-        ERHE_PROFILE_FUNCTION();
-
-        const bool file_is_ok = erhe::file::check_is_existing_non_empty_regular_file("Gltf_parser::load_image_file", path);
-        if (!file_is_ok) {
-            return {};
-        }
-
+    public:
+        std::string                source_name;
+        std::filesystem::path      source_path;
         erhe::graphics::Image_info image_info;
-        erhe::graphics::Image_loader loader;
-
-        if (!loader.open(path, image_info)) {
-            return {};
-        }
-
-        auto& slot = m_arguments.image_transfer.get_slot();
+        std::vector<std::uint8_t>  data;
+        bool                       ok{false};
+    };
 
-        erhe::graphics::Texture_create_info texture_create_info{
-            .instance        = m_arguments.graphics_instance,
-            .internal_format = to_gl(image_info.format),
-            .use_mipmaps     = true, //(image_info.level_count > 1),
-            .width           = image_info.width,
-            .height          = image_info.height,
-            .depth           = image_info.depth,
-            .level_count     = image_info.level_count,
-            .row_stride      = image_info.row_stride,
-            .debug_label     = std::string{image_name} // path.filename().string()
-        };
-        const int  mipmap_count    = texture_create_info.calculate_level_count();
-        const bool generate_mipmap = mipmap_count != image_info.level_count;
-        if (generate_mipmap) {
-            texture_create_info.level_count = mipmap_count;
+    // Decode functions do not touch graphics state and may run on any thread
+    static void decode_image_data(erhe::graphics::Image_loader& loader, Decoded_image& decoded_image)
+    {
+        const erhe::graphics::Image_info& image_info = decoded_image.image_info;
+        if ((image_info.width < 1) || (image_info.height < 1)) {
+            loader.close();
+            return;
         }
-        std::span<std::uint8_t> span = slot.begin_span_for(image_info.width, image_info.height, texture_create_info.internal_format);
-
-        const bool ok = loader.load(span);
+        const std::size_t pixel_byte_count = erhe::graphics::get_upload_pixel_byte_count(to_gl(image_info.format));
+        decoded_image.data.resize(static_cast<std::size_t>(image_info.width) * static_cast<std::size_t>(image_info.height) * pixel_byte_count);
+        decoded_image.ok = loader.load(decoded_image.data);
         loader.close();
-        slot.end(ok);
-        if (!ok) {
-            return {};
-        }
-
-        auto texture = std::make_shared<erhe::graphics::Texture>(texture_create_info);
-        texture->set_source_path(path);
-        texture->set_debug_label(image_name.empty() ? erhe::file::to_string(path) : image_name);
+    }
+    void decode_image_file(const std::filesystem::path& path, Decoded_image& decoded_image) const
+    {
+        ERHE_PROFILE_FUNCTION();
 
-        gl::pixel_store_i(gl::Pixel_store_parameter::unpack_alignment, 1);
-        gl::bind_buffer(gl::Buffer_target::pixel_unpack_buffer, slot.gl_name());
-        texture->upload(texture_create_info.internal_format, texture_create_info.width, texture_create_info.height);
-        gl::bind_buffer(gl::Buffer_target::pixel_unpack_buffer, 0);
+        decoded_image.source_path = path;
+        const bool file_is_ok = erhe::file::check_is_existing_non_empty_regular_file("Gltf_parser::decode_image_file", path);
+        if (!file_is_ok) {
+            return;
+        }
 
-        if (generate_mipmap) {
-            gl::generate_texture_mipmap(texture->gl_name());
+        erhe::graphics::Image_loader loader;
+        if (!loader.open(path, decoded_image.image_info)) {
+            return;
         }
-        return texture;
+        decode_image_data(loader, decoded_image);
     }
-    auto load_image_buffer(
-        const std::size_t buffer_view_index,
-        const std::size_t image_index,
-        std::string_view  image_name
-    ) -> std::shared_ptr<erhe::graphics::Texture>
+    void decode_image_buffer(const std::size_t buffer_view_index, Decoded_image& decoded_image) const
     {
         ERHE_PROFILE_FUNCTION();
 
-        const fastgltf::BufferView&  buffer_view      = m_asset->bufferViews[buffer_view_index];
-        const fastgltf::Buffer&      buffer           = m_asset->buffers.at(buffer_view.bufferIndex);
-        const std::string            buffer_view_name = safe_resource_name(buffer_view.name, "buffer_view", buffer_view_index);
-        const std::string            name             = !image_name.empty() 
-            ? std::string{image_name}
-            : fmt::format("{} image {} {}", m_arguments.path.filename().string(), image_index, buffer_view_name);
-        erhe::graphics::Image_info   image_info;
-        erhe::graphics::Image_loader loader;
-
-        bool load_ok = false;
-        auto& slot = m_arguments.image_transfer.get_slot();
-        erhe::graphics::Texture_create_info texture_create_info{
-            .instance    = m_arguments.graphics_instance,
-            .debug_label = name
-        };
-        int  mipmap_count    = 0;
-        bool generate_mipmap = false;
+        const fastgltf::BufferView& buffer_view = m_asset->bufferViews[buffer_view_index];
+        const fastgltf::Buffer&     buffer      = m_asset->buffers.at(buffer_view.bufferIndex);
+        decoded_image.source_path = m_arguments.path;
 
         std::visit(
             fastgltf::visitor{
@@ -1084,50 +1171,88 @@ private:
                         reinterpret_cast<const std::uint8_t*>(data.bytes.data()) + buffer_view.byteOffset,
                         buffer_view.byteLength
                     };
-                    if (!loader.open(image_encoded_buffer_view, image_info)) {
-                        log_gltf->error("Failed to parse image from buffer view '{}'", name);
+                    erhe::graphics::Image_loader loader;
+                    if (!loader.open(image_encoded_buffer_view, decoded_image.image_info)) {
+                        log_gltf->error("Failed to parse image from buffer view '{}'", decoded_image.source_name);
                         return;
                     }
-
-                    texture_create_info.internal_format = to_gl(image_info.format);
-                    texture_create_info.use_mipmaps     = true; //(image_info.level_count > 1),
-                    texture_create_info.width           = image_info.width;
-                    texture_create_info.height          = image_info.height;
-                    texture_create_info.depth           = image_info.depth;
-                    texture_create_info.level_count     = image_info.level_count;
-                    texture_create_info.row_stride      = image_info.row_stride;
-                    texture_create_info.debug_label     = name;
-
-                    mipmap_count    = texture_create_info.calculate_level_count();
-                    generate_mipmap = mipmap_count != image_info.level_count;
-                    if (generate_mipmap) {
-                        texture_create_info.level_count = mipmap_count;
-                    }
-                    std::span<std::uint8_t> span = slot.begin_span_for(image_info.width, image_info.height, texture_create_info.internal_format);
-
-                    load_ok = loader.load(span);
-                    loader.close();
+                    decode_image_data(loader, decoded_image);
                 }
             },
             buffer.data
         );
-        slot.end(load_ok);
-        if (!load_ok) {
+    }
+    void decode_image(const std::size_t image_index, Decoded_image& decoded_image) const
+    {
+        ERHE_PROFILE_FUNCTION();
+
+        const fastgltf::Image& image = m_asset->images[image_index];
+        decoded_image.source_name = safe_resource_name(image.name, "image", image_index);
+        std::visit(
+            fastgltf::visitor {
+                [](auto& arg) {
+                    static_cast<void>(arg);
+                    ERHE_FATAL("TODO Unsupported image source");
+                },
+                [&](const fastgltf::sources::BufferView& buffer_view_source){
+                    decode_image_buffer(buffer_view_source.bufferViewIndex, decoded_image);
+                },
+                [&](const fastgltf::sources::URI& uri){
+                    std::filesystem::path path = m_arguments.path;
+                    path.replace_filename(uri.uri.fspath());
+                    decode_image_file(path, decoded_image);
+                }
+            },
+            image.data
+        );
+    }
+
+    // Upload must run on the thread which owns the graphics context
+    auto upload_image(const std::size_t image_index, const Decoded_image& decoded_image) -> std::shared_ptr<erhe::graphics::Texture>
+    {
+        ERHE_PROFILE_FUNCTION();
+
+        const erhe::graphics::Image_info& image_info = decoded_image.image_info;
+        if (!decoded_image.ok) {
             log_gltf->warn(
                 "Image '{}' load failed: image index = {}, width = {}, height = {}",
-                name, image_index, texture_create_info.width, texture_create_info.height
+                decoded_image.source_name, image_index, image_info.width, image_info.height
             );
             return {};
         }
 
+        erhe::graphics::Texture_create_info texture_create_info{
+            .instance        = m_arguments.graphics_instance,
+            .internal_format = to_gl(image_info.format),
+            .use_mipmaps     = true, //(image_info.level_count > 1),
+            .width           = image_info.width,
+            .height          = image_info.height,
+            .depth           = image_info.depth,
+            .level_count     = image_info.level_count,
+            .row_stride      = image_info.row_stride,
+            .debug_label     = decoded_image.source_name
+        };
+        const int  mipmap_count    = texture_create_info.calculate_level_count();
+        const bool generate_mipmap = mipmap_count != image_info.level_count;
+        if (generate_mipmap) {
+            texture_create_info.level_count = mipmap_count;
+        }
+
+        auto& slot = m_arguments.image_transfer.get_slot();
+        std::span<std::uint8_t> span = slot.begin_span_for(image_info.width, image_info.height, texture_create_info.internal_format);
+        ERHE_VERIFY(span.size_bytes() == decoded_image.data.size());
+        std::memcpy(span.data(), decoded_image.data.data(), span.size_bytes());
+        slot.end(true);
+
         log_gltf->info(
             "Loaded image '{}': image index = {}, width = {}, height = {}",
-            name, image_index, texture_create_info.width, texture_create_info.height
+            decoded_image.source_name, image_index, image_info.width, image_info.height
         );
 
         auto texture = std::make_shared<erhe::graphics::Texture>(texture_create_info);
-        texture->set_source_path(m_arguments.path);
-        texture->set_debug_label(name);
+        texture->set_source_path(decoded_image.source_path);
+        texture->set_debug_label(decoded_image.source_name);
+
         gl::pixel_store_i(gl::Pixel_store_parameter::unpack_alignment, 1);
         gl::bind_buffer(gl::Buffer_target::pixel_unpack_buffer, slot.gl_name());
         texture->upload(texture_create_info.internal_format, texture_create_info.width, texture_create_info.height);
@@ -1138,36 +1263,12 @@ private:
         }
         return texture;
     }
-    void parse_image(const std::size_t image_index)
+    void parse_image(const std::size_t image_index, const Decoded_image& decoded_image)
     {
         ERHE_PROFILE_FUNCTION();
 
-        const fastgltf::Image& image      = m_asset->images[image_index];
-        const std::string      image_name = safe_resource_name(image.name, "image", image_index);
-        log_gltf->trace("Image: image index = {}, name = {}", image_index, image_name);
-        std::shared_ptr<erhe::graphics::Texture> erhe_texture;
-        std::visit(
-            fastgltf::visitor {
-                [](auto& arg) {
-                    static_cast<void>(arg);
-                    ERHE_FATAL("TODO Unsupported image source");
-                },
-                [&](const fastgltf::sources::BufferView& buffer_view_source){
-                    erhe_texture = load_image_buffer(buffer_view_source.bufferViewIndex, image_index, image_name);
-                },
-                [&](const fastgltf::sources::URI& uri){
-                    std::filesystem::path relative_path = uri.uri.fspath();
-                    erhe_texture = load_image_file(m_arguments.path.replace_filename(relative_path), image_name);
-                }
-            },
-            image.data
-        );
-
-        if (erhe_texture) {
-            erhe_texture->set_debug_label(image_name);
-            m_data_out.images.push_back(erhe_texture);
-        }
-        m_data_out.images[image_index] = erhe_texture;
+        log_gltf->trace("Image: image index = {}, name = {}", image_index, decoded_image.source_name);
+        m_data_out.images[image_index] = upload_image(image_index, decoded_image);
     }
     void parse_sampler(const std::size_t sampler_index)
     {
@@ -1348,14 +1449,62 @@ private:
         erhe_light->enable_flag_bits(Item_flags::content | Item_flags::visible | Item_flags::show_in_ui);
     }
 
+    static constexpr std::size_t c_no_primitive_entry = std::numeric_limits<std::size_t>::max();
+
+    // Unique (index accessor, attribute accessors) combination. Primitives
+    // which share accessors share the triangle soup.
     class Primitive_entry
     {
     public:
+        std::size_t                                     mesh_index;      // first user
+        std::size_t                                     primitive_index; // first user
         std::size_t                                     index_accessor;
         std::vector<std::size_t>                        attribute_accessors;
         std::shared_ptr<erhe::primitive::Triangle_soup> triangle_soup;
     };
-    std::vector<Primitive_entry> m_primitive_entries;
+    std::vector<Primitive_entry>          m_primitive_entries;
+    std::vector<std::vector<std::size_t>> m_mesh_primitive_entries; // [mesh index][primitive index] -> m_primitive_entries index
+
+    void collect_primitive_entries()
+    {
+        ERHE_PROFILE_FUNCTION();
+
+        std::map<std::pair<std::size_t, std::vector<std::size_t>>, std::size_t> entry_indices;
+        m_primitive_entries.clear();
+        m_mesh_primitive_entries.resize(m_asset->meshes.size());
+        for (std::size_t mesh_index = 0, mesh_end = m_asset->meshes.size(); mesh_index < mesh_end; ++mesh_index) {
+            const fastgltf::Mesh&     mesh            = m_asset->meshes[mesh_index];
+            std::vector<std::size_t>& primitive_entry = m_mesh_primitive_entries[mesh_index];
+            primitive_entry.resize(mesh.primitives.size(), c_no_primitive_entry);
+            for (std::size_t primitive_index = 0, primitive_end = mesh.primitives.size(); primitive_index < primitive_end; ++primitive_index) {
+                const fastgltf::Primitive& primitive = mesh.primitives[primitive_index];
+                if (!primitive.indicesAccessor.has_value()) {
+                    continue; // TODO
+                }
+                std::vector<std::size_t> attribute_accessors;
+                attribute_accessors.reserve(primitive.attributes.size());
+                for (const fastgltf::Attribute& attribute : primitive.attributes) {
+                    attribute_accessors.push_back(attribute.accessorIndex);
+                }
+                const auto [i, inserted] = entry_indices.try_emplace(
+                    std::make_pair(primitive.indicesAccessor.value(), attribute_accessors),
+                    m_primitive_entries.size()
+                );
+                if (inserted) {
+                    m_primitive_entries.push_back(
+                        Primitive_entry{
+                            .mesh_index          = mesh_index,
+                            .primitive_index     = primitive_index,
+                            .index_accessor      = primitive.indicesAccessor.value(),
+                            .attribute_accessors = std::move(attribute_accessors)
+                        }
+                    );
+                }
+                primitive_entry[primitive_index] = i->second;
+            }
+        }
+        log_gltf->trace("{} unique primitive geometries", m_primitive_entries.size());
+    }
 
     void load_new_primitive_geometry(const fastgltf::Primitive& primitive, Primitive_entry& primitive_entry)
     {
@@ -1435,49 +1584,25 @@ private:
             );
         }
     }
-    auto get_primitive_geometry(const fastgltf::Primitive& primitive, Primitive_entry& primitive_entry)
-    {
-        ERHE_PROFILE_FUNCTION();
-
-        if (!primitive.indicesAccessor.has_value()) {
-            return; // TODO
-        }
-        primitive_entry.index_accessor = primitive.indicesAccessor.value();
-        primitive_entry.attribute_accessors.clear();
-        for (std::size_t i = 0, end = primitive.attributes.size(); i < end; ++i) {
-            const fastgltf::Attribute& attribute = primitive.attributes[i];
-            primitive_entry.attribute_accessors.push_back(attribute.accessorIndex);
-        }
-
-        for (const auto& old_entry : m_primitive_entries) {
-            if (old_entry.index_accessor != primitive_entry.index_accessor) continue;
-            if (old_entry.attribute_accessors != primitive_entry.attribute_accessors) continue;
-            // Found existing entry
-            primitive_entry = old_entry;
-            return;
-        }
-
-        load_new_primitive_geometry(primitive, primitive_entry);
-    }
-
     void parse_primitive(
         const std::shared_ptr<erhe::scene::Mesh>& erhe_mesh,
-        const fastgltf::Mesh&                     mesh,
+        const std::size_t                         mesh_index,
         const std::size_t                         primitive_index
     )
     {
         ERHE_PROFILE_FUNCTION();
 
-        const fastgltf::Primitive& primitive = mesh.primitives[primitive_index];
-        std::string name = fmt::format("{}[{}]", mesh.name.c_str(), primitive_index);
+        const fastgltf::Primitive& primitive = m_asset->meshes[mesh_index].primitives[primitive_index];
         std::shared_ptr<erhe::primitive::Material> erhe_material = primitive.materialIndex.has_value()
             ? m_data_out.materials.at(primitive.materialIndex.value())
             : std::shared_ptr<erhe::primitive::Material>{};
 
-        Primitive_entry primitive_entry;
-        get_primitive_geometry(primitive, primitive_entry);
+        const std::size_t entry_index = m_mesh_primitive_entries[mesh_index][primitive_index];
+        std::shared_ptr<erhe::primitive::Triangle_soup> triangle_soup = (entry_index != c_no_primitive_entry)
+            ? m_primitive_entries[entry_index].triangle_soup
+            : std::shared_ptr<erhe::primitive::Triangle_soup>{};
 
-        erhe::primitive::Primitive new_primitive{primitive_entry.triangle_soup};
+        erhe::primitive::Primitive new_primitive{triangle_soup};
         erhe_mesh->add_primitive(new_primitive, erhe_material);
     }
     void parse_skin(const std::size_t skin_index)
@@ -1544,7 +1669,7 @@ private:
             Item_flags::id
         );
         for (std::size_t i = 0, end = mesh.primitives.size(); i < end; ++i) {
-            parse_primitive(erhe_mesh, mesh, i);
+            parse_primitive(erhe_mesh, mesh_index, i);
         }
     }
 
@@ -1902,26 +2027,23 @@ private:
             fastgltf::AccessorBoundsArray min_value{dimension, fastgltf::AccessorBoundsArray::BoundsType::float64};
             fastgltf::AccessorBoundsArray max_value{dimension, fastgltf::AccessorBoundsArray::BoundsType::float64};
 
-            for (size_t c = 0; c < dimension; ++c) {
-                max_value.set<double>(c, static_cast<double>(std::numeric_limits<float>::lowest()));
-                min_value.set<double>(c, static_cast<double>(std::numeric_limits<float>::max()));
-            }
-
-            const std::byte* attribute_base_ = vertex_data_source.data() + erhe_attribute.attribute->offset;
-            const std::uint8_t* attribute_base = reinterpret_cast<const std::uint8_t*>(attribute_base_);
-            for (size_t i = 0; i < vertex_count; ++i) {
-                float v[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
-                const std::uint8_t* src = attribute_base + erhe_attribute.stream->stride * i;
-                std::uint8_t* dst = reinterpret_cast<std::uint8_t*>(&v[0]);
-                erhe::dataformat::convert(
-                    src, erhe_attribute.attribute->format,
-                    dst, erhe::dataformat::Format::format_32_vec4_float, 
-                    1.0f
-                );
-                for (std::size_t c = 0; c < dimension; ++c) {
-                    min_value.set<double>(c, std::min(min_value.get<double>(c), static_cast<double>(v[c])));
-                    max_value.set<double>(c, std::max(max_value.get<double>(c), static_cast<double>(v[c])));
+            const std::byte* attribute_base = vertex_data_source.data() + erhe_attribute.attribute->offset;
+            std::vector<float> values(4 * vertex_count);
+            erhe::dataformat::convert(
+                attribute_base, erhe_attribute.attribute->format, erhe_attribute.stream->stride,
+                values.data(), erhe::dataformat::Format::format_32_vec4_float, 4 * sizeof(float),
+                vertex_count,
+                1.0f
+            );
+            for (std::size_t c = 0; c < dimension; ++c) {
+                float min_c = std::numeric_limits<float>::max();
+                float max_c = std::numeric_limits<float>::lowest();
+                for (size_t i = 0; i < vertex_count; ++i) {
+                    min_c = std::min(min_c, values[4 * i + c]);
+                    max_c = std::max(max_c, values[4 * i + c]);
                 }
+                min_value.set<double>(c, static_cast<double>(min_c));
+                max_value.set<double>(c, static_cast<double>(max_c));
             }
             fastgltf::Accessor accessor{
                 .byteOffset      = erhe_attribute.attribute->offset,
@@ -28,6 +28,9 @@ namespace erhe::scene {
     class Skin;
     using Layer_id = uint64_t;
 }
+namespace tf {
+    class Executor;
+}
 
 namespace erhe::gltf {
 
@@ -69,6 +72,7 @@ struct Gltf_parse_arguments
     const std::shared_ptr<erhe::scene::Node>& root_node;
     erhe::scene::Layer_id                     mesh_layer_id{};
     std::filesystem::path                     path;
+    tf::Executor*                             executor{nullptr}; // optional, for image decode and geometry loading
 };
 
 [[nodiscard]] auto parse_gltf(const Gltf_parse_arguments& arguments) -> Gltf_data;
@@ -28,6 +28,9 @@ namespace erhe::scene {
     class Skin;
     using Layer_id = uint64_t;
 }
+namespace tf {
+    class Executor;
+}
 
 namespace erhe::gltf {
 
@@ -77,6 +80,7 @@ struct Gltf_parse_arguments
     erhe::scene::Layer_id                     mesh_layer_id;
     std::filesystem::path                     path;
     Coordinate_system                         coordinate_system{Coordinate_system::Y_up};
+    tf::Executor*                             executor{nullptr};
 };
 
 [[nodiscard]] auto parse_gltf(const Gltf_parse_arguments& arguments) -> Gltf_data;
@@ -4,8 +4,13 @@
 #include "erhe_graph/node.hpp"
 #include "erhe_graph/pin.hpp"
 
+#include "erhe_verify/verify.hpp"
+
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+#include <unordered_set>
+
 namespace erhe::graph {
 
 void Graph::clear()
@@ -41,18 +46,15 @@ void Graph::unregister_node(Node* node)
         return;
     }
 
-    std::vector<Pin>& input_pins = node->get_input_pins();
-    for (Pin& pin : input_pins) {
-        for (Link* link : pin.get_links()) {
-            disconnect(link);
-        }
+    // Collect first, disconnecting removes links from pins
+    std::vector<Link*> links;
+    for (const Pin& pin : node->get_input_pins()) {
+        links.insert(links.end(), pin.get_links().begin(), pin.get_links().end());
     }
-    std::vector<Pin>& output_pins = node->get_output_pins();
-    for (Pin& pin : output_pins) {
-        for (Link* link : pin.get_links()) {
-            disconnect(link);
-        }
+    for (const Pin& pin : node->get_output_pins()) {
+        links.insert(links.end(), pin.get_links().begin(), pin.get_links().end());
     }
+    disconnect(links);
 
     m_nodes.erase(i);
 
@@ -90,6 +92,40 @@ void Graph::disconnect(Link* link)
     m_links.erase(i);
 }
 
+void Graph::disconnect(const std::vector<Link*>& links)
+{
+    if (links.empty()) {
+        return;
+    }
+
+    std::unordered_set<const Link*> removed_links;
+    removed_links.reserve(links.size());
+    for (Link* link : links) {
+        ERHE_VERIFY(link != nullptr);
+        removed_links.insert(link);
+    }
+
+    std::size_t found_count = 0;
+    for (const std::unique_ptr<Link>& link : m_links) {
+        if (removed_links.contains(link.get())) {
+            link->disconnect();
+            ++found_count;
+        }
+    }
+    if (found_count != removed_links.size()) {
+        log_graph->error("{} links not found", removed_links.size() - found_count);
+    }
+
+    const auto i = std::remove_if(
+        m_links.begin(),
+        m_links.end(),
+        [&removed_links](const std::unique_ptr<Link>& link) {
+            return removed_links.contains(link.get());
+        }
+    );
+    m_links.erase(i, m_links.end());
+}
+
 auto Graph::get_host_name() const -> const char*
 {
     return "Graph";
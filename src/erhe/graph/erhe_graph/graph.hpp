@@ -32,6 +32,7 @@ public:
     void unregister_node(Node* node);
     auto connect        (Pin* source_pin, Pin* sink_pin) -> Link*;
     void disconnect     (Link* link);
+    void disconnect     (const std::vector<Link*>& links); // single pass over graph links
     void sort           ();
 
     [[nodiscard]] auto get_nodes() const -> const std::vector<Node*>&;
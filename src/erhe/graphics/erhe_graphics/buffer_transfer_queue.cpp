@@ -3,23 +3,156 @@
 #include "erhe_graphics/buffer_transfer_queue.hpp"
 #include "erhe_gl/enum_bit_mask_operators.hpp"
 #include "erhe_gl/enum_string_functions.hpp"
+#include "erhe_gl/wrapper_functions.hpp"
 #include "erhe_graphics/buffer.hpp"
 #include "erhe_graphics/graphics_log.hpp"
+#include "erhe_graphics/instance.hpp"
 #include "erhe_graphics/scoped_buffer_mapping.hpp"
 #include "erhe_profile/profile.hpp"
 #include "erhe_verify/verify.hpp"
 
 #include <fmt/format.h>
 
+#include <algorithm>
+
 namespace erhe::graphics {
 
+namespace {
+
+constexpr std::size_t staging_alignment = 16;
+
+auto align_up(const std::size_t value, const std::size_t alignment) -> std::size_t
+{
+    return ((value + alignment - 1) / alignment) * alignment;
+}
+
+}
+
 Buffer_transfer_queue::Buffer_transfer_queue()
 {
 }
 
+Buffer_transfer_queue::Buffer_transfer_queue(Instance& instance, const std::size_t staging_byte_count)
+{
+    if (!instance.info.use_persistent_buffers || (staging_byte_count == 0)) {
+        log_buffer->info("Buffer_transfer_queue: persistent buffers not in use, staging ring disabled");
+        return;
+    }
+
+    m_staging_buffer = std::make_unique<Buffer>(
+        instance,
+        Buffer_create_info{
+            .target              = gl::Buffer_target::copy_read_buffer,
+            .capacity_byte_count = align_up(staging_byte_count, staging_alignment),
+            .storage_mask        =
+                gl::Buffer_storage_mask::map_coherent_bit   |
+                gl::Buffer_storage_mask::map_persistent_bit |
+                gl::Buffer_storage_mask::map_write_bit,
+            .access_mask         =
+                gl::Map_buffer_access_mask::map_coherent_bit   |
+                gl::Map_buffer_access_mask::map_persistent_bit |
+                gl::Map_buffer_access_mask::map_write_bit,
+            .debug_label         = "Buffer_transfer_queue staging"
+        }
+    );
+    m_staging_map = m_staging_buffer->map();
+    ERHE_VERIFY(!m_staging_map.empty());
+}
+
 Buffer_transfer_queue::~Buffer_transfer_queue() noexcept
 {
     // flush(); TODO causes GL errors in shutdown, investigate
+    for (const Fence_entry& entry : m_fences) {
+        gl::delete_sync(static_cast<GLsync>(entry.fence_sync));
+    }
+}
+
+auto Buffer_transfer_queue::has_staging() const -> bool
+{
+    return !m_staging_map.empty();
+}
+
+auto Buffer_transfer_queue::get_last_flush_stats() const -> const Statistics&
+{
+    return m_last_flush_stats;
+}
+
+auto Buffer_transfer_queue::get_total_stats() const -> const Statistics&
+{
+    return m_total_stats;
+}
+
+auto Buffer_transfer_queue::reserve(const std::size_t byte_count) -> Transfer_reservation
+{
+    if (m_staging_map.empty() || (byte_count == 0)) {
+        return {};
+    }
+
+    const std::lock_guard<ERHE_PROFILE_LOCKABLE_BASE(std::mutex)> lock{m_mutex};
+
+    const std::size_t capacity      = m_staging_map.size();
+    const std::size_t aligned_count = align_up(byte_count, staging_alignment);
+    std::size_t       position      = m_ring_write_position;
+    std::size_t       offset        = position % capacity;
+    if (offset + aligned_count > capacity) {
+        // Does not fit before end of ring - skip to the start
+        position += capacity - offset;
+        offset = 0;
+    }
+    if (position + aligned_count - m_ring_free_position > capacity) {
+        ++m_pending_stats.reserve_failures;
+        return {};
+    }
+
+    m_ring_write_position = position + aligned_count;
+    m_outstanding.insert(position);
+    return Transfer_reservation{
+        .span           = std::span<std::uint8_t>{reinterpret_cast<std::uint8_t*>(m_staging_map.data() + offset), byte_count},
+        .staging_offset = offset,
+        .ring_position  = position
+    };
+}
+
+void Buffer_transfer_queue::commit(Buffer& buffer, const std::size_t offset, const Transfer_reservation& reservation)
+{
+    ERHE_VERIFY(!reservation.span.empty());
+
+    const std::lock_guard<ERHE_PROFILE_LOCKABLE_BASE(std::mutex)> lock{m_mutex};
+
+    SPDLOG_LOGGER_TRACE(
+        log_buffer,
+        "staged buffer {} transfer offset = {} size = {} staging offset = {}",
+        buffer.gl_name(),
+        offset,
+        reservation.span.size(),
+        reservation.staging_offset
+    );
+    const auto i = m_outstanding.find(reservation.ring_position);
+    ERHE_VERIFY(i != m_outstanding.end());
+    m_outstanding.erase(i);
+    m_staged.push_back(
+        Staged_entry{
+            .target         = &buffer,
+            .target_offset  = offset,
+            .staging_offset = reservation.staging_offset,
+            .byte_count     = reservation.span.size(),
+            .sequence       = m_next_sequence++
+        }
+    );
+    ++m_pending_stats.staged_entries;
+}
+
+void Buffer_transfer_queue::cancel(const Transfer_reservation& reservation)
+{
+    if (reservation.span.empty()) {
+        return;
+    }
+
+    const std::lock_guard<ERHE_PROFILE_LOCKABLE_BASE(std::mutex)> lock{m_mutex};
+
+    const auto i = m_outstanding.find(reservation.ring_position);
+    ERHE_VERIFY(i != m_outstanding.end());
+    m_outstanding.erase(i);
 }
 
 void Buffer_transfer_queue::enqueue(Buffer& buffer, const std::size_t offset, std::vector<uint8_t>&& data)
@@ -33,7 +166,103 @@ void Buffer_transfer_queue::enqueue(Buffer& buffer, const std::size_t offset, st
         offset,
         data.size()
     );
-    m_queued.emplace_back(buffer, offset, std::move(data));
+    ++m_pending_stats.heap_allocations;
+    m_queued.emplace_back(buffer, offset, std::move(data), m_next_sequence++);
+}
+
+void Buffer_transfer_queue::retire_completed_fences()
+{
+    while (!m_fences.empty()) {
+        Fence_entry& entry = m_fences.front();
+        const gl::Sync_status result = gl::client_wait_sync(
+            static_cast<GLsync>(entry.fence_sync),
+            gl::Sync_object_mask::sync_flush_commands_bit,
+            0
+        );
+        if (
+            (result != gl::Sync_status::already_signaled) &&
+            (result != gl::Sync_status::condition_satisfied)
+        ) {
+            break;
+        }
+        gl::delete_sync(static_cast<GLsync>(entry.fence_sync));
+        m_ring_free_position = entry.ring_position;
+        m_fences.pop_front();
+    }
+}
+
+void Buffer_transfer_queue::copy_staged(const std::span<Staged_entry> entries, Statistics& stats)
+{
+    // Coalesce ranges which are adjacent both in target and in staging buffer.
+    // Stable sort keeps submission order for overlapping ranges.
+    std::stable_sort(
+        entries.begin(),
+        entries.end(),
+        [](const Staged_entry& lhs, const Staged_entry& rhs) {
+            if (lhs.target != rhs.target) {
+                return lhs.target < rhs.target;
+            }
+            return lhs.target_offset < rhs.target_offset;
+        }
+    );
+    const unsigned int staging_name = m_staging_buffer->gl_name();
+    std::size_t i = 0;
+    while (i < entries.size()) {
+        Staged_entry run = entries[i++];
+        while (i < entries.size()) {
+            const Staged_entry& next = entries[i];
+            if (
+                (next.target         != run.target) ||
+                (next.target_offset  != run.target_offset  + run.byte_count) ||
+                (next.staging_offset != run.staging_offset + run.byte_count)
+            ) {
+                break;
+            }
+            run.byte_count += next.byte_count;
+            ++i;
+        }
+        SPDLOG_LOGGER_TRACE(
+            log_buffer,
+            "buffer copy {} {} transfer offset = {} size = {} staging offset = {}",
+            gl::c_str(run.target->target()),
+            run.target->gl_name(),
+            run.target_offset,
+            run.byte_count,
+            run.staging_offset
+        );
+        gl::copy_named_buffer_sub_data(
+            staging_name,
+            run.target->gl_name(),
+            static_cast<GLintptr>(run.staging_offset),
+            static_cast<GLintptr>(run.target_offset),
+            static_cast<GLsizeiptr>(run.byte_count)
+        );
+        stats.staged_bytes += run.byte_count;
+        ++stats.copy_commands;
+    }
+}
+
+void Buffer_transfer_queue::upload_queued(const Transfer_entry& entry, Statistics& stats)
+{
+    SPDLOG_LOGGER_TRACE(
+        log_buffer,
+        "buffer upload {} {} transfer offset = {} size = {}",
+        gl::c_str(entry.target.target()),
+        entry.target.gl_name(),
+        entry.target_offset,
+        entry.data.size()
+    );
+    Scoped_buffer_mapping<uint8_t> scoped_mapping{
+        entry.target,
+        entry.target_offset,
+        entry.data.size(),
+        gl::Map_buffer_access_mask::map_invalidate_range_bit |
+        gl::Map_buffer_access_mask::map_write_bit
+    };
+    auto& destination = scoped_mapping.span();
+    memcpy(destination.data(), entry.data.data(), entry.data.size());
+    stats.heap_bytes += entry.data.size();
+    ++stats.copy_commands;
 }
 
 void Buffer_transfer_queue::flush()
@@ -42,26 +271,64 @@ void Buffer_transfer_queue::flush()
 
     const std::lock_guard<ERHE_PROFILE_LOCKABLE_BASE(std::mutex)> lock{m_mutex};
 
-    for (const auto& entry : m_queued) {
-        SPDLOG_LOGGER_TRACE(
-            log_buffer,
-            "buffer upload {} {} transfer offset = {} size = {}",
-            gl::c_str(entry.target.target()),
-            entry.target.gl_name(),
-            entry.target_offset,
-            entry.data.size()
-        );
-        Scoped_buffer_mapping<uint8_t> scoped_mapping{
-            entry.target,
-            entry.target_offset,
-            entry.data.size(),
-            gl::Map_buffer_access_mask::map_invalidate_range_bit |
-            gl::Map_buffer_access_mask::map_write_bit
-        };
-        auto& destination = scoped_mapping.span();
-        memcpy(destination.data(), entry.data.data(), entry.data.size());
+    Statistics& stats = m_pending_stats;
+
+    if (has_staging()) {
+        retire_completed_fences();
+    }
+
+    // Transfers are applied in submission order. Both m_staged and m_queued
+    // are in sequence order; staged entries between two heap uploads form a
+    // segment which is coalesced on its own.
+    std::size_t staged_begin = 0;
+    for (const Transfer_entry& entry : m_queued) {
+        std::size_t staged_end = staged_begin;
+        while ((staged_end < m_staged.size()) && (m_staged[staged_end].sequence < entry.sequence)) {
+            ++staged_end;
+        }
+        if (staged_end > staged_begin) {
+            copy_staged(std::span<Staged_entry>{m_staged.data() + staged_begin, staged_end - staged_begin}, stats);
+        }
+        staged_begin = staged_end;
+        upload_queued(entry, stats);
+    }
+    if (staged_begin < m_staged.size()) {
+        copy_staged(std::span<Staged_entry>{m_staged.data() + staged_begin, m_staged.size() - staged_begin}, stats);
     }
     m_queued.clear();
+
+    if (has_staging()) {
+        // Staging space can be reused once the GPU has completed the copies,
+        // except for reservations which producers have not yet committed.
+        const std::size_t release_position = m_outstanding.empty()
+            ? m_ring_write_position
+            : *m_outstanding.begin();
+        if (!m_staged.empty()) {
+            m_fences.push_back(
+                Fence_entry{
+                    .fence_sync    = gl::fence_sync(gl::Sync_condition::sync_gpu_commands_complete, 0),
+                    .ring_position = release_position
+                }
+            );
+        } else if (m_fences.empty()) {
+            m_ring_free_position = release_position;
+        }
+        m_staged.clear();
+    }
+
+    m_total_stats.staged_bytes     += stats.staged_bytes;
+    m_total_stats.heap_bytes       += stats.heap_bytes;
+    m_total_stats.heap_allocations += stats.heap_allocations;
+    m_total_stats.staged_entries   += stats.staged_entries;
+    m_total_stats.copy_commands    += stats.copy_commands;
+    m_total_stats.reserve_failures += stats.reserve_failures;
+    m_last_flush_stats = stats;
+    m_pending_stats = Statistics{};
+
+    ERHE_PROFILE_PLOT("Transfer staged bytes",     static_cast<int64_t>(m_last_flush_stats.staged_bytes));
+    ERHE_PROFILE_PLOT("Transfer heap bytes",       static_cast<int64_t>(m_last_flush_stats.heap_bytes));
+    ERHE_PROFILE_PLOT("Transfer heap allocations", static_cast<int64_t>(m_last_flush_stats.heap_allocations));
+    ERHE_PROFILE_PLOT("Transfer copy commands",    static_cast<int64_t>(m_last_flush_stats.copy_commands));
 }
 
 } // namespace erhe::graphics
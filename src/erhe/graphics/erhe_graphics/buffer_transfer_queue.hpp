@@ -2,17 +2,39 @@
 
 #include "erhe_profile/profile.hpp"
 
+#include <cstdint>
+#include <deque>
+#include <memory>
 #include <mutex>
+#include <set>
+#include <span>
 #include <vector>
 
 namespace erhe::graphics {
 
 class Buffer;
+class Instance;
+
+// Space reserved from the staging ring. Producers write directly to span
+// and hand the reservation back with Buffer_transfer_queue::commit().
+// An empty span means staging space was not available; use enqueue() instead.
+class Transfer_reservation
+{
+public:
+    std::span<std::uint8_t> span;
+    std::size_t             staging_offset{0};
+    std::size_t             ring_position {0};
+};
 
 class Buffer_transfer_queue final
 {
 public:
+    // Without staging ring, every transfer goes through enqueue()
     Buffer_transfer_queue();
+
+    // With persistently mapped staging ring (if supported by instance)
+    Buffer_transfer_queue(Instance& instance, std::size_t staging_byte_count);
+
     ~Buffer_transfer_queue() noexcept;
     Buffer_transfer_queue(Buffer_transfer_queue&) = delete;
     auto operator=(Buffer_transfer_queue&) -> Buffer_transfer_queue& = delete;
@@ -20,10 +42,11 @@ public:
     class Transfer_entry
     {
     public:
-        Transfer_entry(Buffer& target, const std::size_t target_offset, std::vector<uint8_t>&& data)
+        Transfer_entry(Buffer& target, const std::size_t target_offset, std::vector<uint8_t>&& data, const uint64_t sequence)
             : target       {target}
             , target_offset{target_offset}
             , data         {data}
+            , sequence     {sequence}
         {
         }
 
@@ -34,6 +57,7 @@ public:
             : target       {other.target}
             , target_offset{other.target_offset}
             , data         {std::move(other.data)}
+            , sequence     {other.sequence}
         {
         }
 
@@ -42,16 +66,71 @@ public:
         Buffer&              target;
         std::size_t          target_offset{0};
         std::vector<uint8_t> data;
+        uint64_t             sequence     {0}; // submission order, shared with Staged_entry
     };
 
-    void flush();
+    class Staged_entry
+    {
+    public:
+        Buffer*     target        {nullptr};
+        std::size_t target_offset {0};
+        std::size_t staging_offset{0};
+        std::size_t byte_count    {0};
+        uint64_t    sequence      {0}; // submission order, shared with Transfer_entry
+    };
 
+    class Statistics
+    {
+    public:
+        std::size_t staged_bytes     {0}; // bytes copied from staging ring
+        std::size_t heap_bytes       {0}; // bytes uploaded from enqueue() vectors
+        std::size_t heap_allocations {0}; // enqueue() calls (one heap vector each)
+        std::size_t staged_entries   {0}; // commit() calls
+        std::size_t copy_commands    {0}; // buffer copies after coalescing
+        std::size_t reserve_failures {0}; // reserve() calls which had to fall back to heap
+    };
+
+    // Can be called from any thread
+    [[nodiscard]] auto reserve(std::size_t byte_count) -> Transfer_reservation;
+    void commit (Buffer& buffer, std::size_t offset, const Transfer_reservation& reservation);
+    void cancel (const Transfer_reservation& reservation);
     void enqueue(Buffer& buffer, std::size_t offset, std::vector<uint8_t>&& data);
 
+    // Must be called from the thread owning the OpenGL context, once per frame
+    void flush();
+
+    [[nodiscard]] auto has_staging         () const -> bool;
+    [[nodiscard]] auto get_last_flush_stats() const -> const Statistics&;
+    [[nodiscard]] auto get_total_stats     () const -> const Statistics&;
+
 private:
+    class Fence_entry
+    {
+    public:
+        void*       fence_sync   {nullptr};
+        std::size_t ring_position{0}; // ring space before this position is free once signaled
+    };
+
+    void retire_completed_fences();
+    void copy_staged            (std::span<Staged_entry> entries, Statistics& stats);
+    void upload_queued          (const Transfer_entry& entry, Statistics& stats);
+
     ERHE_PROFILE_MUTEX(std::mutex, m_mutex);
     std::vector<Transfer_entry>    m_queued;
-};
+    std::vector<Staged_entry>      m_staged;
+    uint64_t                       m_next_sequence{0};
+
+    // Staging ring. Positions are monotonic byte counters, modulo ring size gives offset.
+    std::unique_ptr<Buffer>        m_staging_buffer;
+    std::span<std::byte>           m_staging_map;
+    std::size_t                    m_ring_write_position{0};
+    std::size_t                    m_ring_free_position {0};
+    std::multiset<std::size_t>     m_outstanding;  // ring positions of uncommitted reservations
+    std::deque<Fence_entry>        m_fences;
 
+    Statistics                     m_pending_stats;
+    Statistics                     m_last_flush_stats;
+    Statistics                     m_total_stats;
+};
 
 } // namespace erhe::graphics
@@ -45,6 +45,38 @@ auto Graphics_buffer_sink::allocate_index_buffer(const std::size_t index_count,
     };
 }
 
+namespace {
+
+auto to_sink_write_span(const erhe::graphics::Transfer_reservation& reservation) -> erhe::primitive::Sink_write_span
+{
+    return erhe::primitive::Sink_write_span{
+        .span          = reservation.span,
+        .sink_offset   = reservation.staging_offset,
+        .sink_position = reservation.ring_position
+    };
+}
+
+auto to_transfer_reservation(const erhe::primitive::Sink_write_span& sink_write_span) -> erhe::graphics::Transfer_reservation
+{
+    return erhe::graphics::Transfer_reservation{
+        .span           = sink_write_span.span,
+        .staging_offset = sink_write_span.sink_offset,
+        .ring_position  = sink_write_span.sink_position
+    };
+}
+
+}
+
+auto Graphics_buffer_sink::begin_vertex_data(std::size_t, std::size_t, const std::size_t byte_count) const -> erhe::primitive::Sink_write_span
+{
+    return to_sink_write_span(m_buffer_transfer_queue.reserve(byte_count));
+}
+
+auto Graphics_buffer_sink::begin_index_data(std::size_t, const std::size_t byte_count) const -> erhe::primitive::Sink_write_span
+{
+    return to_sink_write_span(m_buffer_transfer_queue.reserve(byte_count));
+}
+
 void Graphics_buffer_sink::enqueue_index_data(const std::size_t offset, std::vector<uint8_t>&& data) const
 {
     m_buffer_transfer_queue.enqueue(m_index_buffer, offset, std::move(data));
@@ -57,11 +89,19 @@ void Graphics_buffer_sink::enqueue_vertex_data(const std::size_t stream, const s
 
 void Graphics_buffer_sink::buffer_ready(erhe::primitive::Vertex_buffer_writer& writer) const
 {
+    if (writer.vertex_data.empty() && !writer.sink_write_span.span.empty()) {
+        m_buffer_transfer_queue.commit(*m_vertex_buffers.at(writer.stream), writer.start_offset(), to_transfer_reservation(writer.sink_write_span));
+        return;
+    }
     m_buffer_transfer_queue.enqueue(*m_vertex_buffers.at(writer.stream), writer.start_offset(), std::move(writer.vertex_data));
 }
 
 void Graphics_buffer_sink::buffer_ready(erhe::primitive::Index_buffer_writer& writer) const
 {
+    if (writer.index_data.empty() && !writer.sink_write_span.span.empty()) {
+        m_buffer_transfer_queue.commit(m_index_buffer, writer.start_offset(), to_transfer_reservation(writer.sink_write_span));
+        return;
+    }
     m_buffer_transfer_queue.enqueue(m_index_buffer, writer.start_offset(), std::move(writer.index_data));
 }
 
@@ -20,6 +20,8 @@ public:
 
     [[nodiscard]] auto allocate_vertex_buffer(std::size_t stream, std::size_t vertex_count, std::size_t vertex_element_size) -> erhe::primitive::Buffer_range override;
     [[nodiscard]] auto allocate_index_buffer (std::size_t index_count, std::size_t index_element_size) -> erhe::primitive::Buffer_range override;
+    [[nodiscard]] auto begin_vertex_data     (std::size_t stream, std::size_t offset, std::size_t byte_count) const -> erhe::primitive::Sink_write_span override;
+    [[nodiscard]] auto begin_index_data      (std::size_t offset, std::size_t byte_count) const -> erhe::primitive::Sink_write_span override;
 
     void enqueue_vertex_data(std::size_t stream, std::size_t offset, std::vector<uint8_t>&& data) const override;
     void enqueue_index_data (std::size_t offset, std::vector<uint8_t>&& data) const override;
@@ -312,6 +312,10 @@ void Logs::tail_log_imgui()
         ImGui::SameLine();
         ImGui::SetNextItemWidth(100.0f);
         log_level_combo("##LogLevel", m_min_level_to_show);
+        if (erhe::log::is_log_async()) {
+            ImGui::SameLine();
+            ImGui::Text("Dropped: %zu", static_cast<std::size_t>(erhe::log::get_dropped_log_message_count()));
+        }
     }
 
     // Log content rows
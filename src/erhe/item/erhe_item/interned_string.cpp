@@ -0,0 +1,160 @@
+#include "erhe_item/interned_string.hpp"
+#include "erhe_profile/profile.hpp"
+#include "erhe_verify/verify.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+namespace erhe {
+
+class Interned_string_entry
+{
+public:
+    explicit Interned_string_entry(const std::string_view value)
+        : value{value}
+    {
+    }
+
+    const std::string     value;
+    std::atomic<uint32_t> reference_count{1};
+};
+
+namespace {
+
+class Interned_string_table
+{
+public:
+    auto acquire(const std::string_view value) -> Interned_string_entry*
+    {
+        std::lock_guard<ERHE_PROFILE_LOCKABLE_BASE(std::mutex)> lock{m_mutex};
+
+        const auto i = m_entries.find(value);
+        if (i != m_entries.end()) {
+            i->second->reference_count.fetch_add(1, std::memory_order_relaxed);
+            return i->second;
+        }
+        Interned_string_entry* entry = new Interned_string_entry{value};
+        m_entries.emplace(std::string_view{entry->value}, entry);
+        m_byte_count += sizeof(Interned_string_entry) + ((entry->value.capacity() > sso_capacity) ? entry->value.capacity() + 1 : 0);
+        return entry;
+    }
+
+    void release(Interned_string_entry* entry)
+    {
+        // Fast path - not the last reference. New references to an entry
+        // with count 1 can only be created by acquire(), under lock.
+        uint32_t count = entry->reference_count.load(std::memory_order_relaxed);
+        while (count > 1) {
+            if (entry->reference_count.compare_exchange_weak(count, count - 1, std::memory_order_acq_rel)) {
+                return;
+            }
+        }
+
+        std::lock_guard<ERHE_PROFILE_LOCKABLE_BASE(std::mutex)> lock{m_mutex};
+        if (entry->reference_count.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+            return; // acquire() picked the entry up before we got the lock
+        }
+        const std::size_t erase_count = m_entries.erase(std::string_view{entry->value});
+        ERHE_VERIFY(erase_count == 1);
+        m_byte_count -= sizeof(Interned_string_entry) + ((entry->value.capacity() > sso_capacity) ? entry->value.capacity() + 1 : 0);
+        delete entry;
+    }
+
+    auto get_statistics() -> Interned_string_statistics
+    {
+        std::lock_guard<ERHE_PROFILE_LOCKABLE_BASE(std::mutex)> lock{m_mutex};
+
+        Interned_string_statistics statistics{
+            .entry_count = m_entries.size(),
+            .byte_count  = m_byte_count + m_entries.bucket_count() * sizeof(void*) + m_entries.size() * node_overhead
+        };
+        for (const auto& [value, entry] : m_entries) {
+            statistics.reference_count += entry->reference_count.load(std::memory_order_relaxed);
+        }
+        return statistics;
+    }
+
+private:
+    static inline const std::size_t sso_capacity  = std::string{}.capacity();
+    static constexpr std::size_t    node_overhead = sizeof(void*) + sizeof(std::string_view) + sizeof(Interned_string_entry*) + sizeof(std::size_t);
+
+    ERHE_PROFILE_MUTEX(std::mutex,                               m_mutex);
+    std::unordered_map<std::string_view, Interned_string_entry*> m_entries;
+    std::size_t                                                  m_byte_count{0};
+};
+
+// Intentionally never destroyed: items may release their names during
+// static destruction, in any order.
+auto get_table() -> Interned_string_table&
+{
+    static Interned_string_table* table = new Interned_string_table{};
+    return *table;
+}
+
+const std::string empty_string{};
+
+} // anonymous namespace
+
+Interned_string::Interned_string(const std::string_view value)
+    : m_entry{value.empty() ? nullptr : get_table().acquire(value)}
+{
+}
+
+Interned_string::Interned_string(const Interned_string& other)
+    : m_entry{other.m_entry}
+{
+    if (m_entry != nullptr) {
+        m_entry->reference_count.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+Interned_string::Interned_string(Interned_string&& other) noexcept
+    : m_entry{other.m_entry}
+{
+    other.m_entry = nullptr;
+}
+
+auto Interned_string::operator=(const Interned_string& other) -> Interned_string&
+{
+    if (m_entry != other.m_entry) {
+        Interned_string copy{other};
+        std::swap(m_entry, copy.m_entry);
+    }
+    return *this;
+}
+
+auto Interned_string::operator=(Interned_string&& other) noexcept -> Interned_string&
+{
+    std::swap(m_entry, other.m_entry);
+    return *this;
+}
+
+Interned_string::~Interned_string() noexcept
+{
+    if (m_entry != nullptr) {
+        get_table().release(m_entry);
+    }
+}
+
+auto Interned_string::get() const -> const std::string&
+{
+    return (m_entry != nullptr) ? m_entry->value : empty_string;
+}
+
+auto Interned_string::empty() const -> bool
+{
+    return m_entry == nullptr;
+}
+
+auto Interned_string::operator==(const Interned_string& other) const -> bool
+{
+    return m_entry == other.m_entry;
+}
+
+auto get_interned_string_statistics() -> Interned_string_statistics
+{
+    return get_table().get_statistics();
+}
+
+} // namespace erhe
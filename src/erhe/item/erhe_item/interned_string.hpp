@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace erhe {
+
+class Interned_string_entry;
+
+// Reference to a shared, immutable string in a global string table. Equal
+// strings share one table entry, which is freed when the last reference
+// goes away. Empty string does not use the table.
+class Interned_string
+{
+public:
+    Interned_string() = default;
+    explicit Interned_string(std::string_view value);
+    Interned_string(const Interned_string& other);
+    Interned_string(Interned_string&& other) noexcept;
+    auto operator=(const Interned_string& other) -> Interned_string&;
+    auto operator=(Interned_string&& other) noexcept -> Interned_string&;
+    ~Interned_string() noexcept;
+
+    [[nodiscard]] auto get      () const -> const std::string&;
+    [[nodiscard]] auto empty    () const -> bool;
+    [[nodiscard]] auto operator==(const Interned_string& other) const -> bool;
+
+private:
+    Interned_string_entry* m_entry{nullptr};
+};
+
+class Interned_string_statistics
+{
+public:
+    std::size_t entry_count    {0};
+    std::size_t reference_count{0};
+    std::size_t byte_count     {0}; // table entries, including string heap allocations
+};
+
+[[nodiscard]] auto get_interned_string_statistics() -> Interned_string_statistics;
+
+} // namespace erhe
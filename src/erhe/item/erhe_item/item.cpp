@@ -88,26 +88,24 @@ auto Item_filter::describe() const -> std::string
 Item_base::Item_base() = default;
 
 Item_base::Item_base(const std::string_view name)
-    : m_name {name}
-    , m_label{fmt::format("{}##{}", name, get_id())}
+    : m_name{name}
 {
 }
 
 Item_base::Item_base(const Item_base& other)
     : enable_shared_from_this{other}
     , m_flag_bits  {other.m_flag_bits & ~Item_flags::selected}
-    , m_name       {fmt::format("{} Copy", other.m_name)}
+    , m_name       {fmt::format("{} Copy", other.m_name.get())}
     , m_source_path{other.m_source_path}
 {
-    m_label = fmt::format("{}##{}", m_name, get_id());
 }
 
 auto Item_base::operator=(const Item_base& other) -> Item_base&
 {
     m_flag_bits   = other.m_flag_bits & ~Item_flags::selected;
-    m_name        = fmt::format("{} Copy", other.m_name);
+    m_name        = Interned_string{fmt::format("{} Copy", other.m_name.get())};
     m_source_path = other.m_source_path;
-    m_label       = fmt::format("{}##{}", m_name, get_id());
+    m_label.clear();
     return *this;
 }
 
@@ -115,11 +113,16 @@ Item_base::~Item_base() noexcept = default;
 
 auto Item_base::get_name() const -> const std::string&
 {
-    return m_name;
+    return m_name.get();
 }
 
 auto Item_base::get_label() const -> const std::string&
 {
+    // Id is fixed for the lifetime of the item, so only set_name() and
+    // assignment need to invalidate the cached label
+    if (m_label.empty()) {
+        m_label = fmt::format("{}##{}", m_name.get(), get_id());
+    }
     return m_label;
 }
 
@@ -204,18 +207,29 @@ auto Item_base::is_hidden() const -> bool
 
 void Item_base::set_source_path(const std::filesystem::path& path)
 {
-    m_source_path = path;
+    if (path.empty()) {
+        m_source_path.reset();
+        return;
+    }
+
+    // Importers set the same path to all items they create
+    static thread_local std::shared_ptr<const std::filesystem::path> last_path;
+    if (!last_path || (*last_path.get() != path)) {
+        last_path = std::make_shared<const std::filesystem::path>(path);
+    }
+    m_source_path = last_path;
 }
 
 auto Item_base::get_source_path() const -> const std::filesystem::path&
 {
-    return m_source_path;
+    static const std::filesystem::path empty_path{};
+    return m_source_path ? *m_source_path.get() : empty_path;
 }
 
 void Item_base::set_name(const std::string_view name)
 {
-    m_name = name;
-    m_label = fmt::format("{}##{}", name, get_id());
+    m_name = Interned_string{name};
+    m_label.clear();
 }
 
 auto Item_base::describe(int level) const -> std::string
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "erhe_item/interned_string.hpp"
+#include "erhe_item/item_memory.hpp"
 #include "erhe_item/unique_id.hpp"
 #include "erhe_verify/verify.hpp"
 
@@ -9,6 +11,13 @@
 #include <filesystem>
 #include <memory>
 #include <string>
+#include <type_traits>
+
+#if defined(_MSC_VER)
+#   define ERHE_NO_UNIQUE_ADDRESS [[msvc::no_unique_address]]
+#else
+#   define ERHE_NO_UNIQUE_ADDRESS [[no_unique_address]]
+#endif
 
 namespace erhe {
 
@@ -229,6 +238,12 @@ public:
             return std::shared_ptr<Base>{};
         }
     }
+
+private:
+    // Intermediate is either Base, or another erhe::Item<> type
+    using Replaced_item_type = std::conditional_t<std::is_same_v<Intermediate, Base>, void, Intermediate>;
+
+    ERHE_NO_UNIQUE_ADDRESS Item_instance_counter<Self, Replaced_item_type> m_instance_counter;
 };
 
 class Item_base
@@ -262,7 +277,7 @@ public:
     [[nodiscard]] auto is_hidden                   () const -> bool;
     [[nodiscard]] auto get_source_path             () const -> const std::filesystem::path&;
     [[nodiscard]] auto get_name                    () const -> const std::string&;
-    [[nodiscard]] auto get_label                   () const -> const std::string&;
+    [[nodiscard]] auto get_label                   () const -> const std::string&; // name##id, for ImGui
     [[nodiscard]] auto describe                    (int level = 0) const -> std::string;
 
     void set_flag_bits    (uint64_t mask, bool value);
@@ -276,11 +291,13 @@ public:
     void set_source_path  (const std::filesystem::path& path);
 
 protected:
-    Unique_id<Item_base>  m_id         {};
-    uint64_t              m_flag_bits  {Item_flags::none};
-    std::string           m_name       {};
-    std::string           m_label      {};
-    std::filesystem::path m_source_path{};
+    Unique_id<Item_base>                         m_id         {};
+    uint64_t                                     m_flag_bits  {Item_flags::none};
+    Interned_string                              m_name       {};
+    std::shared_ptr<const std::filesystem::path> m_source_path{}; // shared by items loaded from same file
+
+private:
+    mutable std::string                          m_label      {}; // built on first get_label(), cleared when name changes
 };
 
 template <typename T>
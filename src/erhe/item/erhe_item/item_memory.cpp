@@ -0,0 +1,79 @@
+#include "erhe_item/item_memory.hpp"
+#include "erhe_profile/profile.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
+
+namespace erhe {
+
+namespace {
+
+class Item_type_registry
+{
+public:
+    auto add(const std::string_view type_name, const std::size_t item_size) -> Item_type_counter&
+    {
+        std::lock_guard<ERHE_PROFILE_LOCKABLE_BASE(std::mutex)> lock{m_mutex};
+        return m_counters.emplace_back(type_name, item_size);
+    }
+
+    auto get_memory() -> std::vector<Item_type_memory>
+    {
+        std::vector<Item_type_memory> result;
+        {
+            std::lock_guard<ERHE_PROFILE_LOCKABLE_BASE(std::mutex)> lock{m_mutex};
+            result.reserve(m_counters.size());
+            for (const Item_type_counter& counter : m_counters) {
+                const std::size_t live_count = counter.get_live_count();
+                result.push_back(
+                    Item_type_memory{
+                        .type_name  = counter.get_type_name(),
+                        .item_size  = counter.get_item_size(),
+                        .live_count = live_count,
+                        .byte_count = live_count * counter.get_item_size()
+                    }
+                );
+            }
+        }
+        std::sort(
+            result.begin(),
+            result.end(),
+            [](const Item_type_memory& lhs, const Item_type_memory& rhs) {
+                return lhs.byte_count > rhs.byte_count;
+            }
+        );
+        return result;
+    }
+
+private:
+    ERHE_PROFILE_MUTEX(std::mutex,     m_mutex);
+    std::deque<Item_type_counter>      m_counters; // deque keeps references stable
+};
+
+// Intentionally never destroyed, like the counters referenced by items
+auto get_registry() -> Item_type_registry&
+{
+    static Item_type_registry* registry = new Item_type_registry{};
+    return *registry;
+}
+
+} // anonymous namespace
+
+Item_type_counter::Item_type_counter(const std::string_view type_name, const std::size_t item_size)
+    : m_type_name{type_name}
+    , m_item_size{item_size}
+{
+}
+
+auto register_item_type(const std::string_view type_name, const std::size_t item_size) -> Item_type_counter&
+{
+    return get_registry().add(type_name, item_size);
+}
+
+auto get_item_type_memory() -> std::vector<Item_type_memory>
+{
+    return get_registry().get_memory();
+}
+
+} // namespace erhe
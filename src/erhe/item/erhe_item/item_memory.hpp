@@ -0,0 +1,106 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <string_view>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+
+namespace erhe {
+
+// Live instance count of one Item type (most derived type)
+class Item_type_counter
+{
+public:
+    Item_type_counter(std::string_view type_name, std::size_t item_size);
+
+    void add(const int delta)
+    {
+        m_live_count.fetch_add(delta, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] auto get_type_name () const -> std::string_view { return m_type_name; }
+    [[nodiscard]] auto get_item_size () const -> std::size_t      { return m_item_size; }
+    [[nodiscard]] auto get_live_count() const -> std::size_t
+    {
+        const long long count = m_live_count.load(std::memory_order_relaxed);
+        return (count > 0) ? static_cast<std::size_t>(count) : 0;
+    }
+
+private:
+    std::string_view       m_type_name;
+    std::size_t            m_item_size{0};
+    std::atomic<long long> m_live_count{0};
+};
+
+[[nodiscard]] auto register_item_type(std::string_view type_name, std::size_t item_size) -> Item_type_counter&;
+
+class Item_type_memory
+{
+public:
+    std::string_view type_name;
+    std::size_t      item_size {0};
+    std::size_t      live_count{0};
+    std::size_t      byte_count{0}; // live_count * item_size; heap allocations owned by items are not included
+};
+
+// Sorted by byte count, largest first
+[[nodiscard]] auto get_item_type_memory() -> std::vector<Item_type_memory>;
+
+template <typename T>
+[[nodiscard]] auto get_item_static_type_name() -> std::string_view
+{
+    if constexpr (requires { T::static_type_name; }) {
+        return T::static_type_name;
+    } else {
+        return typeid(T).name();
+    }
+}
+
+// Member of erhe::Item<>. Counts Self; when Self derives from another
+// erhe::Item<> type (Replaced), the count of that type is taken back so
+// that each item is counted once, as its most derived type.
+template <typename Self, typename Replaced>
+class Item_instance_counter
+{
+public:
+    Item_instance_counter() noexcept
+    {
+        update(1);
+    }
+
+    Item_instance_counter(const Item_instance_counter&) noexcept
+    {
+        update(1);
+    }
+
+    auto operator=(const Item_instance_counter&) noexcept -> Item_instance_counter&
+    {
+        return *this;
+    }
+
+    ~Item_instance_counter() noexcept
+    {
+        update(-1);
+    }
+
+private:
+    static auto get_counter() -> Item_type_counter&
+    {
+        static Item_type_counter& counter = register_item_type(get_item_static_type_name<Self>(), sizeof(Self));
+        return counter;
+    }
+
+    static void update(const int delta)
+    {
+        get_counter().add(delta);
+        if constexpr (!std::is_void_v<Replaced>) {
+            Item_instance_counter<Replaced, void>::get_counter().add(-delta);
+        }
+    }
+
+    template <typename, typename> friend class Item_instance_counter;
+};
+
+} // namespace erhe
@@ -0,0 +1,127 @@
+#include "erhe_item/item_pool.hpp"
+#include "erhe_profile/profile.hpp"
+#include "erhe_verify/verify.hpp"
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace erhe {
+
+namespace {
+
+constexpr std::size_t granularity      = 16;
+constexpr std::size_t max_block_size   = 1024;
+constexpr std::size_t size_class_count = max_block_size / granularity;
+constexpr std::size_t chunk_byte_count = 64 * 1024;
+
+class Free_block
+{
+public:
+    Free_block* next{nullptr};
+};
+
+class Size_class
+{
+public:
+    Free_block* free_list{nullptr};
+    std::byte*  chunk_next{nullptr};
+    std::byte*  chunk_end {nullptr};
+};
+
+class Item_pool
+{
+public:
+    static auto is_pooled(const std::size_t byte_count, const std::size_t alignment) -> bool
+    {
+        return (byte_count > 0) && (byte_count <= max_block_size) && (alignment <= granularity);
+    }
+
+    auto allocate(const std::size_t byte_count) -> void*
+    {
+        const std::size_t class_index = (byte_count - 1) / granularity;
+        const std::size_t block_size  = (class_index + 1) * granularity;
+
+        std::lock_guard<ERHE_PROFILE_LOCKABLE_BASE(std::mutex)> lock{m_mutex};
+
+        Size_class& size_class = m_size_classes[class_index];
+        ++m_statistics.allocation_count;
+        m_statistics.used_byte_count += block_size;
+        if (size_class.free_list != nullptr) {
+            Free_block* block = size_class.free_list;
+            size_class.free_list = block->next;
+            return block;
+        }
+        if (size_class.chunk_next + block_size > size_class.chunk_end) {
+            std::unique_ptr<std::byte[]>& chunk = m_chunks.emplace_back(new std::byte[chunk_byte_count]);
+            size_class.chunk_next = chunk.get();
+            size_class.chunk_end  = chunk.get() + chunk_byte_count;
+            m_statistics.reserved_byte_count += chunk_byte_count;
+        }
+        void* block = size_class.chunk_next;
+        size_class.chunk_next += block_size;
+        return block;
+    }
+
+    void deallocate(void* const pointer, const std::size_t byte_count)
+    {
+        const std::size_t class_index = (byte_count - 1) / granularity;
+        const std::size_t block_size  = (class_index + 1) * granularity;
+
+        std::lock_guard<ERHE_PROFILE_LOCKABLE_BASE(std::mutex)> lock{m_mutex};
+
+        ERHE_VERIFY(m_statistics.allocation_count > 0);
+        --m_statistics.allocation_count;
+        m_statistics.used_byte_count -= block_size;
+        Size_class& size_class = m_size_classes[class_index];
+        Free_block* block = new (pointer) Free_block{size_class.free_list};
+        size_class.free_list = block;
+    }
+
+    auto get_statistics() -> Item_pool_statistics
+    {
+        std::lock_guard<ERHE_PROFILE_LOCKABLE_BASE(std::mutex)> lock{m_mutex};
+        return m_statistics;
+    }
+
+private:
+    ERHE_PROFILE_MUTEX(std::mutex,                 m_mutex);
+    std::array<Size_class, size_class_count>       m_size_classes{};
+    std::vector<std::unique_ptr<std::byte[]>>      m_chunks;
+    Item_pool_statistics                           m_statistics;
+};
+
+// Intentionally never destroyed: pooled items may be released during
+// static destruction, in any order.
+auto get_pool() -> Item_pool&
+{
+    static Item_pool* pool = new Item_pool{};
+    return *pool;
+}
+
+} // anonymous namespace
+
+auto item_pool_allocate(const std::size_t byte_count, const std::size_t alignment) -> void*
+{
+    if (!Item_pool::is_pooled(byte_count, alignment)) {
+        return ::operator new(byte_count, std::align_val_t{alignment});
+    }
+    return get_pool().allocate(byte_count);
+}
+
+void item_pool_deallocate(void* const pointer, const std::size_t byte_count, const std::size_t alignment)
+{
+    if (!Item_pool::is_pooled(byte_count, alignment)) {
+        ::operator delete(pointer, std::align_val_t{alignment});
+        return;
+    }
+    get_pool().deallocate(pointer, byte_count);
+}
+
+auto get_item_pool_statistics() -> Item_pool_statistics
+{
+    return get_pool().get_statistics();
+}
+
+} // namespace erhe
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace erhe {
+
+class Item_pool_statistics
+{
+public:
+    std::size_t reserved_byte_count{0}; // arena chunks
+    std::size_t used_byte_count    {0}; // allocated blocks, rounded to size class
+    std::size_t allocation_count   {0};
+};
+
+// Size class pool for items which are created in large numbers. Blocks
+// are carved from 64 KB chunks, and freed blocks are reused for items of
+// the same size class. Chunks are not returned to the system.
+[[nodiscard]] auto item_pool_allocate  (std::size_t byte_count, std::size_t alignment) -> void*;
+void               item_pool_deallocate(void* pointer, std::size_t byte_count, std::size_t alignment);
+[[nodiscard]] auto get_item_pool_statistics() -> Item_pool_statistics;
+
+template <typename T>
+class Item_pool_allocator
+{
+public:
+    using value_type = T;
+
+    Item_pool_allocator() noexcept = default;
+
+    template <typename U>
+    Item_pool_allocator(const Item_pool_allocator<U>&) noexcept
+    {
+    }
+
+    [[nodiscard]] auto allocate(const std::size_t count) -> T*
+    {
+        return static_cast<T*>(item_pool_allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* const pointer, const std::size_t count) noexcept
+    {
+        item_pool_deallocate(pointer, count * sizeof(T), alignof(T));
+    }
+
+    template <typename U>
+    auto operator==(const Item_pool_allocator<U>&) const noexcept -> bool
+    {
+        return true;
+    }
+};
+
+// Like std::make_shared(), but item and its control block are allocated
+// from item pool
+template <typename T, typename... Args>
+[[nodiscard]] auto make_pooled_item(Args&&... args) -> std::shared_ptr<T>
+{
+    return std::allocate_shared<T>(Item_pool_allocator<T>{}, std::forward<Args>(args)...);
+}
+
+} // namespace erhe
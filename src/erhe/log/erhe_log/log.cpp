@@ -3,6 +3,8 @@
 #include "erhe_log/timestamp.hpp"
 #include "erhe_verify/verify.hpp"
 
+#include "blockingconcurrentqueue.h"
+
 #include <spdlog/sinks/base_sink.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/sinks/basic_file_sink.h>
@@ -17,6 +19,12 @@
 #   include <unistd.h>
 #endif
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+#include <thread>
 #include <vector>
 
 namespace erhe::log {
@@ -70,11 +78,10 @@ void Store_log_sink::trim(const std::size_t trim_size)
 
 void Store_log_sink::sink_it_(const spdlog::details::log_msg& msg)
 {
-    ++m_serial;
     m_entries.push_back(
         Entry{
-            .serial       = m_serial,
-            .timestamp    = erhe::log::timestamp_short(),
+            .serial       = ++m_serial,
+            .timestamp    = erhe::log::timestamp_short(msg.time),
             .message      = std::string{msg.payload.begin(), msg.payload.end()},
             .logger       = std::string{msg.logger_name.begin(), msg.logger_name.end()},
             .repeat_count = 0,
@@ -87,6 +94,230 @@ void Store_log_sink::flush_()
 {
 }
 
+class Async_log_sink;
+
+// Message as captured on the logging thread. Formatting of timestamps and
+// store entries is deferred to the worker thread. Short payloads are kept
+// inline so that enqueue does not allocate.
+class Async_log_message
+{
+public:
+    static constexpr std::size_t inline_payload_capacity = 200;
+
+    Async_log_sink*                           sink          {nullptr};
+    spdlog::log_clock::time_point             time          {};
+    std::size_t                               thread_id     {0};
+    spdlog::string_view_t                     logger_name   {}; // loggers are registered and live until exit
+    spdlog::level::level_enum                 level         {spdlog::level::info};
+    std::size_t                               payload_length{0};
+    std::array<char, inline_payload_capacity> inline_payload;
+    std::string                               long_payload;
+
+    [[nodiscard]] auto get_payload() const -> spdlog::string_view_t
+    {
+        return (payload_length <= inline_payload_capacity)
+            ? spdlog::string_view_t{inline_payload.data(), payload_length}
+            : spdlog::string_view_t{long_payload.data(), long_payload.size()};
+    }
+};
+
+// Single consumer for all asynchronous sinks. The queue is lock free, with
+// a separate sub-queue for each logging thread (moodycamel implicit
+// producers), and its blocks are preallocated for queue_size messages.
+class Async_log_worker
+{
+public:
+    Async_log_worker(std::size_t queue_size, std::chrono::milliseconds flush_interval)
+        : m_queue         {queue_size}
+        , m_flush_interval{flush_interval}
+    {
+    }
+
+    ~Async_log_worker() noexcept
+    {
+        stop();
+    }
+
+    void add_sink(const std::shared_ptr<Async_log_sink>& sink)
+    {
+        ERHE_VERIFY(!m_thread.joinable());
+        m_sinks.push_back(sink);
+    }
+
+    void start()
+    {
+        m_thread = std::thread{[this]() { run(); }};
+    }
+
+    void stop()
+    {
+        if (!m_thread.joinable()) {
+            return;
+        }
+        m_stop_requested.store(true, std::memory_order_release);
+        m_thread.join();
+    }
+
+    // Writes all queued messages and flushes target sinks, for fatal exits.
+    // The worker thread can not join itself; it only flushes target sinks.
+    void drain()
+    {
+        if (m_thread.joinable() && (std::this_thread::get_id() != m_thread.get_id())) {
+            stop();
+        }
+        flush_sinks();
+    }
+
+    [[nodiscard]] auto is_running() const -> bool
+    {
+        return m_thread.joinable() && !m_stop_requested.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] auto try_enqueue(Async_log_message&& message) -> bool
+    {
+        if (m_queue.try_enqueue(std::move(message))) {
+            return true;
+        }
+        m_dropped_count.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    [[nodiscard]] auto get_dropped_count() const -> uint64_t
+    {
+        return m_dropped_count.load(std::memory_order_relaxed);
+    }
+
+private:
+    void run();
+    void flush_sinks();
+
+    static constexpr std::size_t batch_size = 256;
+
+    moodycamel::BlockingConcurrentQueue<Async_log_message> m_queue;
+    std::chrono::milliseconds                              m_flush_interval;
+    std::vector<std::shared_ptr<Async_log_sink>>           m_sinks;
+    std::thread                                            m_thread;
+    std::atomic<bool>                                      m_stop_requested{false};
+    std::atomic<uint64_t>                                  m_dropped_count {0};
+};
+
+// Front end sink for a logger in asynchronous mode; forwards messages to
+// target sinks in worker thread.
+class Async_log_sink final : public spdlog::sinks::sink
+{
+public:
+    Async_log_sink(Async_log_worker& worker, std::vector<spdlog::sink_ptr>&& target_sinks)
+        : m_worker      {worker}
+        , m_target_sinks{std::move(target_sinks)}
+    {
+    }
+
+    void log(const spdlog::details::log_msg& msg) override
+    {
+        if (!m_worker.is_running()) {
+            // Before start or after shutdown
+            write(msg);
+            return;
+        }
+        Async_log_message message{
+            .sink           = this,
+            .time           = msg.time,
+            .thread_id      = msg.thread_id,
+            .logger_name    = msg.logger_name,
+            .level          = msg.level,
+            .payload_length = msg.payload.size()
+        };
+        if (message.payload_length <= Async_log_message::inline_payload_capacity) {
+            std::copy(msg.payload.begin(), msg.payload.end(), message.inline_payload.begin());
+        } else {
+            message.long_payload.assign(msg.payload.begin(), msg.payload.end());
+        }
+        static_cast<void>(m_worker.try_enqueue(std::move(message)));
+    }
+
+    void flush() override
+    {
+        // Worker thread flushes target sinks
+    }
+
+    void set_pattern(const std::string&) override
+    {
+    }
+
+    void set_formatter(std::unique_ptr<spdlog::formatter>) override
+    {
+    }
+
+    void write(const Async_log_message& message)
+    {
+        spdlog::details::log_msg msg{message.time, spdlog::source_loc{}, message.logger_name, message.level, message.get_payload()};
+        msg.thread_id = message.thread_id;
+        write(msg);
+    }
+
+    void write(const spdlog::details::log_msg& msg)
+    {
+        for (const spdlog::sink_ptr& sink : m_target_sinks) {
+            if (sink->should_log(msg.level)) {
+                sink->log(msg);
+            }
+        }
+    }
+
+    void flush_targets()
+    {
+        for (const spdlog::sink_ptr& sink : m_target_sinks) {
+            sink->flush();
+        }
+    }
+
+private:
+    Async_log_worker&             m_worker;
+    std::vector<spdlog::sink_ptr> m_target_sinks;
+};
+
+void Async_log_worker::run()
+{
+    std::vector<Async_log_message> batch(batch_size);
+    auto last_flush_time = std::chrono::steady_clock::now();
+    bool unflushed       = false;
+    for (;;) {
+        const bool        stop_requested = m_stop_requested.load(std::memory_order_acquire);
+        const std::size_t count          = m_queue.wait_dequeue_bulk_timed(
+            batch.begin(),
+            batch_size,
+            std::chrono::duration_cast<std::chrono::microseconds>(m_flush_interval).count()
+        );
+        bool flush_now = false;
+        for (std::size_t i = 0; i < count; ++i) {
+            Async_log_message& message = batch[i];
+            message.sink->write(message);
+            flush_now = flush_now || (message.level >= spdlog::level::err);
+            message.long_payload.clear();
+        }
+        unflushed = unflushed || (count > 0);
+
+        const auto now = std::chrono::steady_clock::now();
+        if (unflushed && (flush_now || (count == 0) || (now - last_flush_time >= m_flush_interval))) {
+            flush_sinks();
+            last_flush_time = now;
+            unflushed       = false;
+        }
+
+        // Queue is drained before exit
+        if (stop_requested && (count == 0)) {
+            break;
+        }
+    }
+}
+
+void Async_log_worker::flush_sinks()
+{
+    for (const std::shared_ptr<Async_log_sink>& sink : m_sinks) {
+        sink->flush_targets();
+    }
+}
+
 class Log_sinks
 {
 public:
@@ -117,24 +348,14 @@ public:
         ini.get(basename.c_str(), levelname);
         const spdlog::level::level_enum level_parsed = spdlog::level::from_str(levelname);
 
-        std::shared_ptr<spdlog::logger> logger = std::make_shared<spdlog::logger>(
-            name,
-            spdlog::sinks_init_list{
-#if defined _WIN32
-                m_sink_msvc,
-#endif
-                //sink_console,
-                m_sink_log_file,
-                tail ? m_tail_store_log : m_frame_store_log
-            }
-        );
-        if (m_log_to_console) {
-            logger->sinks().push_back(m_sink_console);
-        }
+        const std::vector<spdlog::sink_ptr> sinks = m_async_worker
+            ? std::vector<spdlog::sink_ptr>{tail ? m_async_tail_sink : m_async_frame_sink}
+            : make_target_sinks(tail);
+        std::shared_ptr<spdlog::logger> logger = std::make_shared<spdlog::logger>(name, sinks.begin(), sinks.end());
         std::shared_ptr<spdlog::logger> logger_copy = logger;
         spdlog::register_logger(logger_copy);
         logger->set_level(level_parsed);
-        logger->flush_on(spdlog::level::trace);
+        logger->flush_on(m_async_worker ? spdlog::level::off : spdlog::level::trace);
         return logger;
     }
 
@@ -154,13 +375,93 @@ public:
         m_sink_console = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
         m_tail_store_log = std::make_shared<Store_log_sink>();
         m_frame_store_log = std::make_shared<Store_log_sink>();
+
+        bool async                   {false};
+        int  async_queue_size        {32768};
+        int  async_flush_interval_ms {200};
+        {
+            const auto& ini = erhe::configuration::get_ini_file_section("erhe.ini", "log");
+            ini.get("async",                   async);
+            ini.get("async_queue_size",        async_queue_size);
+            ini.get("async_flush_interval_ms", async_flush_interval_ms);
+        }
+        if (async) {
+            m_async_worker = std::make_unique<Async_log_worker>(
+                static_cast<std::size_t>(std::max(async_queue_size, 1024)),
+                std::chrono::milliseconds{std::max(async_flush_interval_ms, 1)}
+            );
+            m_async_tail_sink  = std::make_shared<Async_log_sink>(*m_async_worker.get(), make_target_sinks(true));
+            m_async_frame_sink = std::make_shared<Async_log_sink>(*m_async_worker.get(), make_target_sinks(false));
+            m_async_worker->add_sink(m_async_tail_sink);
+            m_async_worker->add_sink(m_async_frame_sink);
+            m_async_worker->start();
+
+            // Do not lose queued messages, which likely explain the error
+            erhe::verify::set_fatal_handler(&drain_async_log);
+            s_previous_terminate_handler = std::set_terminate(&terminate_handler);
+        }
+    }
+
+    void drain_async()
+    {
+        if (m_async_worker) {
+            m_async_worker->drain();
+        }
+    }
+
+    auto is_async() const -> bool
+    {
+        return static_cast<bool>(m_async_worker);
+    }
+
+    auto get_dropped_count() const -> uint64_t
+    {
+        return m_async_worker ? m_async_worker->get_dropped_count() : 0;
     }
 
 private:
     Log_sinks()
     {
     }
-    ~Log_sinks() {}
+
+    static void drain_async_log()
+    {
+        get_instance().drain_async();
+    }
+
+    [[noreturn]] static void terminate_handler()
+    {
+        drain_async_log();
+        if (s_previous_terminate_handler != nullptr) {
+            s_previous_terminate_handler();
+        }
+        std::abort();
+    }
+
+    static inline std::terminate_handler s_previous_terminate_handler{nullptr};
+
+    ~Log_sinks()
+    {
+        if (m_async_worker) {
+            m_async_worker->stop();
+        }
+    }
+
+    auto make_target_sinks(const bool tail) -> std::vector<spdlog::sink_ptr>
+    {
+        std::vector<spdlog::sink_ptr> sinks{
+#if defined _WIN32
+            m_sink_msvc,
+#endif
+            //sink_console,
+            m_sink_log_file,
+            tail ? m_tail_store_log : m_frame_store_log
+        };
+        if (m_log_to_console) {
+            sinks.push_back(m_sink_console);
+        }
+        return sinks;
+    }
 
 #if defined _WIN32
     std::shared_ptr<spdlog::sinks::msvc_sink_mt>         m_sink_msvc      {};
@@ -170,6 +471,9 @@ private:
     std::shared_ptr<Store_log_sink>                      m_tail_store_log {};
     std::shared_ptr<Store_log_sink>                      m_frame_store_log{};
     bool                                                 m_log_to_console {false};
+    std::unique_ptr<Async_log_worker>                    m_async_worker    {};
+    std::shared_ptr<Async_log_sink>                      m_async_tail_sink {};
+    std::shared_ptr<Async_log_sink>                      m_async_frame_sink{};
 };
 
 auto get_tail_store_log() -> Store_log_sink&
@@ -182,6 +486,16 @@ auto get_frame_store_log() -> Store_log_sink&
     return Log_sinks::get_instance().get_frame_store_sink();
 }
 
+auto is_log_async() -> bool
+{
+    return Log_sinks::get_instance().is_async();
+}
+
+auto get_dropped_log_message_count() -> uint64_t
+{
+    return Log_sinks::get_instance().get_dropped_count();
+}
+
 void log_to_console()
 {
     Log_sinks::get_instance().set_log_to_console(true);
@@ -4,6 +4,7 @@
 #include <spdlog/spdlog.h>
 #include <spdlog/sinks/base_sink.h>
 
+#include <atomic>
 #include <deque>
 #include <memory>
 #include <mutex>
@@ -31,7 +32,8 @@ public:
     spdlog::level::level_enum level       {2/*spdlog::level::level_enum::SPDLOG_LEVEL_INFO*/};
 };
 
-// Sink that keeps log entries in deqeue
+// Sink that keeps log entries in deqeue. In asynchronous mode only the log
+// worker thread writes here, so readers never block threads that log.
 class Store_log_sink final : public spdlog::sinks::base_sink<std::mutex>
 {
 public:
@@ -46,10 +48,18 @@ protected:
     void flush_  ()                                    override;
 
 private:
-    uint64_t           m_serial{0};
-    std::deque<Entry>  m_entries;
+    std::atomic<uint64_t> m_serial{0};
+    std::deque<Entry>     m_entries;
 };
 
+// Asynchronous mode is enabled with erhe.ini [log] async = true. Log calls
+// then only enqueue messages to a preallocated queue; a background thread
+// writes them to file, console and store sinks. When the queue is full,
+// messages are dropped and counted. ERHE_FATAL and std::terminate drain the
+// queue before the process exits.
+[[nodiscard]] auto is_log_async                 () -> bool;
+[[nodiscard]] auto get_dropped_log_message_count() -> uint64_t;
+
 [[nodiscard]] auto get_tail_store_log () -> Store_log_sink&;
 [[nodiscard]] auto get_frame_store_log() -> Store_log_sink&;
 [[nodiscard]] auto get_groupname      (const std::string& s) -> std::string;
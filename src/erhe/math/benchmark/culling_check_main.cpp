@@ -0,0 +1,294 @@
+// Headless CPU culling check, does not need a GPU. Compares cull_aabbs()
+// (SIMD where available) against scalar Frustum::intersects(), and
+// transform_aabb() against transforming all eight box corners. Frustum
+// planes are checked with known points for regular and reverse depth,
+// with finite and infinite far plane. Returns 0 when all checks pass.
+//
+//   culling-check --count 100000 --seed 1
+
+#include "erhe_math/frustum.hpp"
+#include "erhe_math/math_util.hpp"
+
+#include <cxxopts.hpp>
+#include <fmt/format.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/constants.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+class Options
+{
+public:
+    Options(int argc, char** argv)
+    {
+        cxxopts::Options options{"culling-check", "Checks CPU frustum culling without GPU"};
+
+        options.add_options()
+            ("count", "Number of random boxes for each projection", cxxopts::value<int>()->default_value("100000"), "<count>")
+            ("seed",  "Random seed",                                cxxopts::value<int>()->default_value("1"), "<seed>")
+            ("help",  "Print help");
+
+        try {
+            auto arguments = options.parse(argc, argv);
+            if (arguments.count("help")) {
+                fmt::print("{}\n", options.help());
+                return;
+            }
+            count = std::max(1, arguments["count"].as<int>());
+            seed  = arguments["seed"].as<int>();
+            valid = true;
+        } catch (const std::exception& e) {
+            fmt::print("Error parsing command line arguments: {}\n", e.what());
+        }
+    }
+
+    bool valid{false};
+    int  count{0};
+    int  seed {0};
+};
+
+namespace {
+
+constexpr float c_z_near = 0.1f;
+constexpr float c_z_far  = 100.0f;
+
+class Projection_case
+{
+public:
+    const char* name;
+    glm::mat4   clip_from_view;
+    bool        infinite_far;
+};
+
+// Reverse depth with infinite far plane; z = near / -z_view
+auto create_reverse_infinite_far(const float fov_y, const float aspect_ratio, const float z_near) -> glm::mat4
+{
+    const float y = 1.0f / std::tan(0.5f * fov_y);
+    const float x = y / aspect_ratio;
+    return glm::mat4{
+        x, 0, 0,      0,
+        0, y, 0,      0,
+        0, 0, 0,     -1.0f,
+        0, 0, z_near, 0
+    };
+}
+
+auto make_projection_cases() -> std::vector<Projection_case>
+{
+    const float fov_y        = glm::radians(60.0f);
+    const float aspect_ratio = 16.0f / 9.0f;
+    const float half_height  = c_z_near * std::tan(0.5f * fov_y);
+    const float half_width   = half_height * aspect_ratio;
+    return {
+        // Reverse depth swaps near and far, as erhe::scene::Projection does
+        { "regular depth",                erhe::math::create_perspective_vertical(fov_y, aspect_ratio, c_z_near, c_z_far), false },
+        { "reverse depth",                erhe::math::create_perspective_vertical(fov_y, aspect_ratio, c_z_far, c_z_near), false },
+        { "regular depth, infinite far",  erhe::math::create_frustum_infinite_far(-half_width, half_width, -half_height, half_height, c_z_near), true },
+        { "reverse depth, infinite far",  create_reverse_infinite_far(fov_y, aspect_ratio, c_z_near), true }
+    };
+}
+
+// Smallest signed plane distance of box support point; negative when the
+// box is fully outside some plane
+auto get_margin(const erhe::math::Frustum& frustum, const glm::vec3& center, const glm::vec3& extent) -> float
+{
+    float margin = std::numeric_limits<float>::max();
+    for (const glm::vec4& plane : frustum.planes) {
+        const glm::vec3 normal{plane};
+        margin = std::min(margin, glm::dot(normal, center) + plane.w + glm::dot(glm::abs(normal), extent));
+    }
+    return margin;
+}
+
+class Check_result
+{
+public:
+    void expect(const bool condition, const std::string& message)
+    {
+        if (!condition) {
+            ++failure_count;
+            fmt::print("FAIL: {}\n", message);
+        }
+    }
+
+    int failure_count{0};
+};
+
+void check_known_points(const Projection_case& projection, const glm::mat4& view_from_world, Check_result& result)
+{
+    // Camera at (0, 1, 5) looking towards -z; points are tested as tiny boxes
+    const glm::mat4           world_from_view = glm::inverse(view_from_world);
+    const erhe::math::Frustum frustum{projection.clip_from_view * view_from_world};
+    const glm::vec3           tiny{1.0e-4f};
+    const auto at_view_depth = [&world_from_view](const float x, const float y, const float depth) {
+        return glm::vec3{world_from_view * glm::vec4{x, y, -depth, 1.0f}};
+    };
+    const auto expect_visible = [&](const glm::vec3& point, const bool expected, const char* what) {
+        const bool visible = frustum.intersects(point, tiny);
+        result.expect(visible == expected, fmt::format("{}: {} expected {}", projection.name, what, expected ? "visible" : "culled"));
+    };
+
+    expect_visible(at_view_depth(0.0f,  0.0f, 10.0f),                  true,  "point in front");
+    expect_visible(at_view_depth(0.0f,  0.0f, -1.0f),                  false, "point behind camera");
+    expect_visible(at_view_depth(0.0f,  0.0f, 0.5f * c_z_near),        false, "point closer than near plane");
+    expect_visible(at_view_depth(100.0f, 0.0f, 10.0f),                 false, "point right of frustum");
+    expect_visible(at_view_depth(0.0f, -100.0f, 10.0f),                false, "point below frustum");
+    expect_visible(at_view_depth(0.0f,  0.0f, 2.0f * c_z_far),         projection.infinite_far, "point beyond far plane");
+    expect_visible(at_view_depth(0.0f,  0.0f, 1.0e6f),                 projection.infinite_far, "very distant point");
+
+    // Infinite far plane degenerates and must never reject
+    int degenerate_plane_count = 0;
+    for (const glm::vec4& plane : frustum.planes) {
+        if (glm::vec3{plane} == glm::vec3{0.0f}) {
+            ++degenerate_plane_count;
+            result.expect(plane.w > 0.0f, fmt::format("{}: degenerate plane rejects everything", projection.name));
+        }
+    }
+    result.expect(
+        degenerate_plane_count == (projection.infinite_far ? 1 : 0),
+        fmt::format("{}: {} degenerate planes", projection.name, degenerate_plane_count)
+    );
+}
+
+void check_cull_aabbs(
+    const Projection_case& projection,
+    const glm::mat4&       view_from_world,
+    const int              count,
+    std::mt19937&          random,
+    Check_result&          result
+)
+{
+    const erhe::math::Frustum frustum{projection.clip_from_view * view_from_world};
+    std::uniform_real_distribution<float> position_distribution{-150.0f, 150.0f};
+    std::uniform_real_distribution<float> extent_distribution  {0.0f, 5.0f};
+
+    erhe::math::Aabb_soa boxes;
+    boxes.resize(static_cast<std::size_t>(count));
+    for (std::size_t i = 0; i < boxes.size(); ++i) {
+        boxes.set(
+            i,
+            glm::vec3{position_distribution(random), position_distribution(random), position_distribution(random)},
+            glm::vec3{extent_distribution(random), extent_distribution(random), extent_distribution(random)}
+        );
+    }
+
+    // Unaligned begin; the vector body and, for most counts, the scalar
+    // tail are both used
+    const std::size_t begin = std::min<std::size_t>(1, boxes.size() - 1);
+    const std::size_t end   = boxes.size();
+    std::vector<uint8_t> visible(end - begin);
+    erhe::math::cull_aabbs(frustum, boxes, begin, end, visible.data());
+
+    std::size_t visible_count  = 0;
+    std::size_t boundary_count = 0;
+    int         mismatch_count = 0;
+    for (std::size_t i = begin; i < end; ++i) {
+        const glm::vec3 center{boxes.center_x[i], boxes.center_y[i], boxes.center_z[i]};
+        const glm::vec3 extent{boxes.extent_x[i], boxes.extent_y[i], boxes.extent_z[i]};
+        const bool      scalar = frustum.intersects(center, extent);
+        visible_count += scalar ? 1 : 0;
+        if ((visible[i - begin] != 0) == scalar) {
+            continue;
+        }
+        // Different summation order may only flip boxes touching a plane
+        const float margin    = get_margin(frustum, center, extent);
+        const float tolerance = 1.0e-5f * (1.0f + glm::length(center) + glm::length(extent));
+        if (std::abs(margin) <= tolerance) {
+            ++boundary_count;
+            continue;
+        }
+        if (++mismatch_count <= 10) {
+            fmt::print(
+                "FAIL: {}: box {} ({}, {}, {}) cull_aabbs {} intersects {}\n",
+                projection.name, i, center.x, center.y, center.z, visible[i - begin], scalar
+            );
+        }
+    }
+    result.failure_count += mismatch_count;
+    fmt::print(
+        "{:28} {:7} boxes, {:7} visible, {} boundary differences, {} mismatches\n",
+        projection.name, end - begin, visible_count, boundary_count, mismatch_count
+    );
+}
+
+void check_transform_aabb(const int count, std::mt19937& random, Check_result& result)
+{
+    std::uniform_real_distribution<float> unit_distribution {-1.0f, 1.0f};
+    std::uniform_real_distribution<float> scale_distribution{0.1f, 10.0f};
+    std::uniform_real_distribution<float> angle_distribution{0.0f, glm::two_pi<float>()};
+
+    int mismatch_count = 0;
+    for (int i = 0; i < count; ++i) {
+        glm::vec3 axis{unit_distribution(random), unit_distribution(random), unit_distribution(random)};
+        if (glm::length(axis) < 1.0e-3f) {
+            axis = glm::vec3{0.0f, 1.0f, 0.0f};
+        }
+        const glm::mat4 world_from_local =
+            glm::translate(glm::mat4{1.0f}, 100.0f * glm::vec3{unit_distribution(random), unit_distribution(random), unit_distribution(random)}) *
+            glm::rotate   (glm::mat4{1.0f}, angle_distribution(random), glm::normalize(axis)) *
+            glm::scale    (glm::mat4{1.0f}, glm::vec3{scale_distribution(random), scale_distribution(random), scale_distribution(random)});
+        const glm::vec3 a{unit_distribution(random), unit_distribution(random), unit_distribution(random)};
+        const glm::vec3 b{unit_distribution(random), unit_distribution(random), unit_distribution(random)};
+        const glm::vec3 local_min = glm::min(a, b);
+        const glm::vec3 local_max = glm::max(a, b);
+
+        glm::vec3 center;
+        glm::vec3 extent;
+        erhe::math::transform_aabb(world_from_local, local_min, local_max, center, extent);
+
+        glm::vec3 reference_min{std::numeric_limits<float>::max()};
+        glm::vec3 reference_max{std::numeric_limits<float>::lowest()};
+        for (int corner = 0; corner < 8; ++corner) {
+            const glm::vec3 local{
+                ((corner & 1) != 0) ? local_max.x : local_min.x,
+                ((corner & 2) != 0) ? local_max.y : local_min.y,
+                ((corner & 4) != 0) ? local_max.z : local_min.z
+            };
+            const glm::vec3 world{world_from_local * glm::vec4{local, 1.0f}};
+            reference_min = glm::min(reference_min, world);
+            reference_max = glm::max(reference_max, world);
+        }
+        const glm::vec3 reference_center = 0.5f * (reference_max + reference_min);
+        const glm::vec3 reference_extent = 0.5f * (reference_max - reference_min);
+        const float     tolerance        = 1.0e-4f * (1.0f + glm::length(reference_center) + glm::length(reference_extent));
+        const float     error            = std::max(
+            glm::length(center - reference_center),
+            glm::length(extent - reference_extent)
+        );
+        if ((error > tolerance) && (++mismatch_count <= 10)) {
+            fmt::print("FAIL: transform_aabb box {} error {}\n", i, error);
+        }
+    }
+    result.failure_count += mismatch_count;
+    fmt::print("{:28} {:7} boxes, {} mismatches\n", "transform_aabb", count, mismatch_count);
+}
+
+} // anonymous namespace
+
+auto main(int argc, char** argv) -> int
+{
+    Options options{argc, argv};
+    if (!options.valid) {
+        return 1;
+    }
+
+    std::mt19937 random{static_cast<std::mt19937::result_type>(options.seed)};
+    Check_result result;
+
+    const glm::mat4 view_from_world = glm::lookAt(glm::vec3{0.0f, 1.0f, 5.0f}, glm::vec3{0.0f, 1.0f, 0.0f}, glm::vec3{0.0f, 1.0f, 0.0f});
+    for (const Projection_case& projection : make_projection_cases()) {
+        check_known_points(projection, view_from_world, result);
+        check_cull_aabbs  (projection, view_from_world, options.count, random, result);
+    }
+    check_transform_aabb(options.count, random, result);
+
+    fmt::print("{}\n", (result.failure_count == 0) ? "All checks passed" : fmt::format("{} checks failed", result.failure_count));
+    return (result.failure_count == 0) ? 0 : 1;
+}
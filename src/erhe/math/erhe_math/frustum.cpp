@@ -0,0 +1,166 @@
+#include "erhe_math/frustum.hpp"
+
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#   define ERHE_MATH_SSE2 1
+#   include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#   define ERHE_MATH_NEON 1
+#   include <arm_neon.h>
+#endif
+
+namespace erhe::math {
+
+void Aabb_soa::resize(const std::size_t count)
+{
+    center_x.resize(count);
+    center_y.resize(count);
+    center_z.resize(count);
+    extent_x.resize(count);
+    extent_y.resize(count);
+    extent_z.resize(count);
+}
+
+void Aabb_soa::set(const std::size_t index, const glm::vec3& center, const glm::vec3& extent)
+{
+    center_x[index] = center.x;
+    center_y[index] = center.y;
+    center_z[index] = center.z;
+    extent_x[index] = extent.x;
+    extent_y[index] = extent.y;
+    extent_z[index] = extent.z;
+}
+
+auto Aabb_soa::size() const -> std::size_t
+{
+    return center_x.size();
+}
+
+Frustum::Frustum(const glm::mat4& m)
+{
+    // Gribb & Hartmann; glm matrices are column major, m[column][row]
+    const glm::vec4 row0{m[0][0], m[1][0], m[2][0], m[3][0]};
+    const glm::vec4 row1{m[0][1], m[1][1], m[2][1], m[3][1]};
+    const glm::vec4 row2{m[0][2], m[1][2], m[2][2], m[3][2]};
+    const glm::vec4 row3{m[0][3], m[1][3], m[2][3], m[3][3]};
+    planes[0] = row3 + row0; // left
+    planes[1] = row3 - row0; // right
+    planes[2] = row3 + row1; // bottom
+    planes[3] = row3 - row1; // top
+    planes[4] = row2;        // z = 0 (near, or far with reverse depth)
+    planes[5] = row3 - row2; // z = w (far, or near with reverse depth)
+    for (glm::vec4& plane : planes) {
+        const float length = glm::length(glm::vec3{plane});
+        if (length > 0.0f) {
+            plane /= length;
+        } else {
+            // Degenerate plane (infinite far plane); never rejects
+            plane = glm::vec4{0.0f, 0.0f, 0.0f, 1.0f};
+        }
+    }
+}
+
+auto Frustum::intersects(const glm::vec3& center, const glm::vec3& extent) const -> bool
+{
+    for (const glm::vec4& plane : planes) {
+        const glm::vec3 normal{plane};
+        const float distance = glm::dot(normal, center) + plane.w;
+        const float radius   = glm::dot(glm::abs(normal), extent);
+        if (distance + radius < 0.0f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void cull_aabbs(
+    const Frustum&    frustum,
+    const Aabb_soa&   boxes,
+    const std::size_t begin,
+    const std::size_t end,
+    uint8_t* const    visible
+)
+{
+    std::size_t i = begin;
+
+#if defined(ERHE_MATH_SSE2) || defined(ERHE_MATH_NEON)
+    for (; i + 4 <= end; i += 4) {
+#   if defined(ERHE_MATH_SSE2)
+        const __m128 cx = _mm_loadu_ps(&boxes.center_x[i]);
+        const __m128 cy = _mm_loadu_ps(&boxes.center_y[i]);
+        const __m128 cz = _mm_loadu_ps(&boxes.center_z[i]);
+        const __m128 ex = _mm_loadu_ps(&boxes.extent_x[i]);
+        const __m128 ey = _mm_loadu_ps(&boxes.extent_y[i]);
+        const __m128 ez = _mm_loadu_ps(&boxes.extent_z[i]);
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (const glm::vec4& plane : frustum.planes) {
+            __m128 d = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(cx, _mm_set1_ps(plane.x)), _mm_mul_ps(cy, _mm_set1_ps(plane.y))),
+                _mm_add_ps(_mm_mul_ps(cz, _mm_set1_ps(plane.z)), _mm_set1_ps(plane.w))
+            );
+            d = _mm_add_ps(
+                d,
+                _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(ex, _mm_set1_ps(std::abs(plane.x))), _mm_mul_ps(ey, _mm_set1_ps(std::abs(plane.y)))),
+                    _mm_mul_ps(ez, _mm_set1_ps(std::abs(plane.z)))
+                )
+            );
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(d, _mm_setzero_ps()));
+        }
+        const int mask = _mm_movemask_ps(inside);
+#   else
+        const float32x4_t cx = vld1q_f32(&boxes.center_x[i]);
+        const float32x4_t cy = vld1q_f32(&boxes.center_y[i]);
+        const float32x4_t cz = vld1q_f32(&boxes.center_z[i]);
+        const float32x4_t ex = vld1q_f32(&boxes.extent_x[i]);
+        const float32x4_t ey = vld1q_f32(&boxes.extent_y[i]);
+        const float32x4_t ez = vld1q_f32(&boxes.extent_z[i]);
+        uint32x4_t inside = vdupq_n_u32(0xffffffffu);
+        for (const glm::vec4& plane : frustum.planes) {
+            float32x4_t d = vdupq_n_f32(plane.w);
+            d = vmlaq_n_f32(d, cx, plane.x);
+            d = vmlaq_n_f32(d, cy, plane.y);
+            d = vmlaq_n_f32(d, cz, plane.z);
+            d = vmlaq_n_f32(d, ex, std::abs(plane.x));
+            d = vmlaq_n_f32(d, ey, std::abs(plane.y));
+            d = vmlaq_n_f32(d, ez, std::abs(plane.z));
+            inside = vandq_u32(inside, vcgeq_f32(d, vdupq_n_f32(0.0f)));
+        }
+        const int mask =
+            ((vgetq_lane_u32(inside, 0) != 0) ? 1 : 0) |
+            ((vgetq_lane_u32(inside, 1) != 0) ? 2 : 0) |
+            ((vgetq_lane_u32(inside, 2) != 0) ? 4 : 0) |
+            ((vgetq_lane_u32(inside, 3) != 0) ? 8 : 0);
+#   endif
+        visible[i - begin + 0] = static_cast<uint8_t>((mask >> 0) & 1);
+        visible[i - begin + 1] = static_cast<uint8_t>((mask >> 1) & 1);
+        visible[i - begin + 2] = static_cast<uint8_t>((mask >> 2) & 1);
+        visible[i - begin + 3] = static_cast<uint8_t>((mask >> 3) & 1);
+    }
+#endif
+
+    for (; i < end; ++i) {
+        const glm::vec3 center{boxes.center_x[i], boxes.center_y[i], boxes.center_z[i]};
+        const glm::vec3 extent{boxes.extent_x[i], boxes.extent_y[i], boxes.extent_z[i]};
+        visible[i - begin] = frustum.intersects(center, extent) ? 1 : 0;
+    }
+}
+
+void transform_aabb(
+    const glm::mat4& world_from_local,
+    const glm::vec3& local_min,
+    const glm::vec3& local_max,
+    glm::vec3&       out_center,
+    glm::vec3&       out_extent
+)
+{
+    const glm::vec3 local_center = 0.5f * (local_max + local_min);
+    const glm::vec3 local_extent = 0.5f * (local_max - local_min);
+    const glm::mat3 linear{world_from_local};
+    const glm::mat3 abs_linear{glm::abs(linear[0]), glm::abs(linear[1]), glm::abs(linear[2])};
+    out_center = glm::vec3{world_from_local * glm::vec4{local_center, 1.0f}};
+    out_extent = abs_linear * local_extent;
+}
+
+} // namespace erhe::math
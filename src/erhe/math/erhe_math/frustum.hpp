@@ -0,0 +1,61 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace erhe::math {
+
+// World space axis aligned boxes as center and half extent, stored as
+// structure of arrays so that several boxes can be tested at once.
+class Aabb_soa
+{
+public:
+    void resize(std::size_t count);
+    void set   (std::size_t index, const glm::vec3& center, const glm::vec3& extent);
+
+    [[nodiscard]] auto size() const -> std::size_t;
+
+    std::vector<float> center_x;
+    std::vector<float> center_y;
+    std::vector<float> center_z;
+    std::vector<float> extent_x;
+    std::vector<float> extent_y;
+    std::vector<float> extent_z;
+};
+
+class Frustum
+{
+public:
+    // Planes are extracted from clip_from_world; works for both
+    // regular and reverse depth, and for infinite far plane.
+    explicit Frustum(const glm::mat4& clip_from_world);
+
+    [[nodiscard]] auto intersects(const glm::vec3& center, const glm::vec3& extent) const -> bool;
+
+    std::array<glm::vec4, 6> planes; // xyz = normal pointing inside, w = distance
+};
+
+// Writes 1 to visible[i - begin] for boxes in [begin, end) which are at
+// least partially inside frustum, and 0 for boxes which are fully outside.
+void cull_aabbs(
+    const Frustum&  frustum,
+    const Aabb_soa& boxes,
+    std::size_t     begin,
+    std::size_t     end,
+    uint8_t*        visible
+);
+
+// Transforms local space box to world space center and half extent
+void transform_aabb(
+    const glm::mat4& world_from_local,
+    const glm::vec3& local_min,
+    const glm::vec3& local_max,
+    glm::vec3&       out_center,
+    glm::vec3&       out_extent
+);
+
+} // namespace erhe::math
@@ -347,6 +347,7 @@ template <typename T>
 }
 
 [[nodiscard]] auto create_frustum(float left, float right, float bottom, float top, float z_near, float z_far) -> glm::mat4;
+[[nodiscard]] auto create_frustum_infinite_far(float left, float right, float bottom, float top, float z_near) -> glm::mat4;
 [[nodiscard]] auto create_frustum_simple(float width, float height, float z_near, float z_far) -> glm::mat4;
 [[nodiscard]] auto create_perspective(float fov_x, float fov_y, float z_near, float z_far) -> glm::mat4;
 [[nodiscard]] auto create_perspective_xr(float fov_left, float fov_right, float fov_up, float fov_down, float z_near, float z_far) -> glm::mat4;
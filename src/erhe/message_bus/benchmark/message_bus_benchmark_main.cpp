@@ -0,0 +1,288 @@
+// Headless message bus benchmark. Compares erhe::message_bus::Message_bus
+// against the previous implementation, where one mutex was held during
+// dispatch, receivers filtered update_flags themselves and queued messages
+// were kept in std::queue. Uses a message with the same layout as explorer
+// messages and a receiver mix where some receivers take all messages and
+// most subscribe to one or two flags.
+//
+//   message-bus-benchmark --messages 1000000 --receivers 24 --producers 4
+
+#include "erhe_message_bus/message_bus.hpp"
+
+#include <cxxopts.hpp>
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <random>
+#include <thread>
+#include <vector>
+
+class Options
+{
+public:
+    Options(int argc, char** argv)
+    {
+        cxxopts::Options options{"message-bus-benchmark", "Times message bus dispatch against the previous implementation"};
+
+        options.add_options()
+            ("messages",   "Number of messages for each scenario",   cxxopts::value<int>()->default_value("1000000"), "<count>")
+            ("receivers",  "Number of receivers",                    cxxopts::value<int>()->default_value("24"), "<count>")
+            ("batch",      "Messages queued between update() calls", cxxopts::value<int>()->default_value("64"), "<count>")
+            ("producers",  "Threads queueing messages concurrently", cxxopts::value<int>()->default_value("4"), "<count>")
+            ("iterations", "Number of timed runs for each scenario", cxxopts::value<int>()->default_value("5"), "<count>")
+            ("help",       "Print help");
+
+        try {
+            auto arguments = options.parse(argc, argv);
+            if (arguments.count("help")) {
+                fmt::print("{}\n", options.help());
+                return;
+            }
+            message_count  = std::max(1, arguments["messages"  ].as<int>());
+            receiver_count = std::max(1, arguments["receivers" ].as<int>());
+            batch          = std::max(1, arguments["batch"     ].as<int>());
+            producers      = std::max(1, arguments["producers" ].as<int>());
+            iterations     = std::max(1, arguments["iterations"].as<int>());
+            valid          = true;
+        } catch (const std::exception& e) {
+            fmt::print("Error parsing command line arguments: {}\n", e.what());
+        }
+    }
+
+    bool valid         {false};
+    int  message_count {0};
+    int  receiver_count{0};
+    int  batch         {0};
+    int  producers     {0};
+    int  iterations    {0};
+};
+
+namespace {
+
+// Same layout as explorer::Explorer_message, so copies cost the same
+class Benchmark_message
+{
+public:
+    uint64_t                           update_flags      {0};
+    void*                              scene_view        {nullptr};
+    void*                              scene_root        {nullptr};
+    void*                              node              {nullptr};
+    std::vector<std::shared_ptr<void>> no_longer_selected{};
+    std::vector<std::shared_ptr<void>> newly_selected    {};
+    void*                              graphics_preset   {nullptr};
+};
+
+constexpr int c_flag_bit_count = 12;
+
+// Message bus as it was before per flag receivers and the MPSC ring
+template <typename Message_type>
+class Baseline_message_bus
+{
+public:
+    void add_receiver(std::function<void(Message_type&)> message_receiver)
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_receivers.push_back(message_receiver);
+    }
+
+    void send_message(Message_type message)
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        for (auto iter = m_receivers.begin(); iter != m_receivers.end(); iter++) {
+            (*iter)(message);
+        }
+    }
+
+    void queue_message(Message_type message)
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_messages.push(message);
+    }
+
+    void update()
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        while (!m_messages.empty()) {
+            for (auto iter = m_receivers.begin(); iter != m_receivers.end(); iter++) {
+                (*iter)(m_messages.front());
+            }
+            m_messages.pop();
+        }
+    }
+
+private:
+    std::mutex                                       m_mutex;
+    std::vector<std::function<void (Message_type&)>> m_receivers;
+    std::queue<Message_type>                         m_messages;
+};
+
+using Baseline_bus = Baseline_message_bus<Benchmark_message>;
+using Current_bus  = erhe::message_bus::Message_bus<Benchmark_message>;
+
+// Every fourth receiver takes all messages, others one or two flags
+auto make_receiver_masks(const int receiver_count) -> std::vector<uint64_t>
+{
+    std::vector<uint64_t> masks;
+    for (int i = 0; i < receiver_count; ++i) {
+        if ((i % 4) == 0) {
+            masks.push_back(erhe::message_bus::c_all_flags);
+        } else if ((i % 4) == 1) {
+            masks.push_back((uint64_t{1} << (i % c_flag_bit_count)) | (uint64_t{1} << ((i + 5) % c_flag_bit_count)));
+        } else {
+            masks.push_back(uint64_t{1} << (i % c_flag_bit_count));
+        }
+    }
+    return masks;
+}
+
+// Receivers count deliveries; the last counter counts messages. Only the
+// dispatching thread writes counters.
+void add_receivers(Baseline_bus& bus, const std::vector<uint64_t>& masks, std::vector<uint64_t>& counts)
+{
+    for (std::size_t i = 0; i < masks.size(); ++i) {
+        bus.add_receiver(
+            [&count = counts[i], mask = masks[i]](Benchmark_message& message) {
+                if ((message.update_flags & mask) != 0) {
+                    ++count;
+                }
+            }
+        );
+    }
+    bus.add_receiver([&count = counts.back()](Benchmark_message&) { ++count; });
+}
+
+void add_receivers(Current_bus& bus, const std::vector<uint64_t>& masks, std::vector<uint64_t>& counts)
+{
+    for (std::size_t i = 0; i < masks.size(); ++i) {
+        bus.add_receiver(masks[i], [&count = counts[i]](Benchmark_message&) { ++count; });
+    }
+    bus.add_receiver([&count = counts.back()](Benchmark_message&) { ++count; });
+}
+
+enum class Scenario : unsigned int
+{
+    send = 0,
+    queue_update,
+    producers
+};
+
+class Run_result
+{
+public:
+    double                best_ms{0.0};
+    std::vector<uint64_t> counts;
+};
+
+template <typename Bus>
+auto run_scenario(
+    const Scenario               scenario,
+    const Options&               options,
+    const std::vector<uint64_t>& masks,
+    const std::vector<uint64_t>& message_flags
+) -> Run_result
+{
+    Run_result result;
+    for (int iteration = 0; iteration < options.iterations; ++iteration) {
+        std::vector<uint64_t> counts(masks.size() + 1, 0);
+        Bus bus;
+        add_receivers(bus, masks, counts);
+
+        const auto start = std::chrono::steady_clock::now();
+        switch (scenario) {
+            case Scenario::send: {
+                for (const uint64_t flags : message_flags) {
+                    bus.send_message(Benchmark_message{.update_flags = flags});
+                }
+                break;
+            }
+            case Scenario::queue_update: {
+                std::size_t queued = 0;
+                for (const uint64_t flags : message_flags) {
+                    bus.queue_message(Benchmark_message{.update_flags = flags});
+                    if (++queued == static_cast<std::size_t>(options.batch)) {
+                        bus.update();
+                        queued = 0;
+                    }
+                }
+                bus.update();
+                break;
+            }
+            case Scenario::producers: {
+                const std::size_t        message_count  = message_flags.size();
+                const std::size_t        producer_count = static_cast<std::size_t>(options.producers);
+                std::vector<std::thread> threads;
+                for (std::size_t p = 0; p < producer_count; ++p) {
+                    threads.emplace_back(
+                        [&bus, &message_flags, p, producer_count, message_count]() {
+                            for (std::size_t i = p; i < message_count; i += producer_count) {
+                                bus.queue_message(Benchmark_message{.update_flags = message_flags[i]});
+                            }
+                        }
+                    );
+                }
+                // Main thread is the consumer, as in the explorer
+                while (counts.back() < message_count) {
+                    bus.update();
+                }
+                for (std::thread& thread : threads) {
+                    thread.join();
+                }
+                break;
+            }
+        }
+        const auto   end = std::chrono::steady_clock::now();
+        const double ms  = std::chrono::duration<double, std::milli>(end - start).count();
+        result.best_ms = (iteration == 0) ? ms : std::min(result.best_ms, ms);
+        result.counts  = std::move(counts);
+    }
+    return result;
+}
+
+} // anonymous namespace
+
+auto main(int argc, char** argv) -> int
+{
+    Options options{argc, argv};
+    if (!options.valid) {
+        return 1;
+    }
+
+    const std::vector<uint64_t> masks = make_receiver_masks(options.receiver_count);
+    std::vector<uint64_t> message_flags(static_cast<std::size_t>(options.message_count));
+    {
+        std::mt19937 random{1};
+        std::uniform_int_distribution<int> bit_distribution{0, c_flag_bit_count - 1};
+        for (uint64_t& flags : message_flags) {
+            flags = uint64_t{1} << bit_distribution(random);
+        }
+    }
+
+    fmt::print(
+        "{} messages, {} receivers, batch {}, {} producers, best of {}\n",
+        options.message_count, options.receiver_count, options.batch, options.producers, options.iterations
+    );
+    bool counts_match = true;
+    const std::pair<Scenario, const char*> scenarios[] = {
+        { Scenario::send,         "send_message"           },
+        { Scenario::queue_update, "queue_message + update" },
+        { Scenario::producers,    "producer threads"       }
+    };
+    for (const auto& [scenario, name] : scenarios) {
+        const Run_result baseline = run_scenario<Baseline_bus>(scenario, options, masks, message_flags);
+        const Run_result current  = run_scenario<Current_bus >(scenario, options, masks, message_flags);
+        const bool       match    = (baseline.counts == current.counts);
+        counts_match = counts_match && match;
+        fmt::print(
+            "{:24} baseline {:9.2f} ms  current {:9.2f} ms  speedup {:5.2f}x{}\n",
+            name, baseline.best_ms, current.best_ms, baseline.best_ms / current.best_ms,
+            match ? "" : "  DELIVERY MISMATCH"
+        );
+    }
+    return counts_match ? 0 : 1;
+}
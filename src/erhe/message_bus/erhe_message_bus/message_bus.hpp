@@ -2,54 +2,223 @@
 
 #include "erhe_profile/profile.hpp"
 
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <mutex>
-#include <queue>
+#include <utility>
 #include <vector>
 
 namespace erhe::message_bus {
 
-//// TODO use something like https://github.com/TheWisp/signals instead
+// Messages which carry an update_flags bitmask can be routed only to
+// receivers that subscribed to at least one of the set bits.
+template <typename Message_type>
+concept Flagged_message = requires(const Message_type& message) {
+    { message.update_flags } -> std::convertible_to<uint64_t>;
+};
+
+static constexpr uint64_t c_all_flags = ~uint64_t{0};
+
+// Bounded multi-producer single-consumer ring. Slots are allocated once,
+// push() and pop() do not allocate (other than what Message_type move does).
+template <typename Message_type>
+class Mpsc_ring
+{
+public:
+    explicit Mpsc_ring(std::size_t capacity)
+    {
+        std::size_t size = 2;
+        while (size < capacity) {
+            size = size << 1;
+        }
+        m_mask  = size - 1;
+        m_slots = std::make_unique<Slot[]>(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            m_slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    [[nodiscard]] auto try_push(Message_type&& message) -> bool
+    {
+        std::size_t position = m_head.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot&               slot     = m_slots[position & m_mask];
+            const std::size_t   sequence = slot.sequence.load(std::memory_order_acquire);
+            const std::ptrdiff_t diff    = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+            if (diff == 0) {
+                if (m_head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    slot.message = std::move(message);
+                    slot.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false; // full
+            } else {
+                position = m_head.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Single consumer only
+    [[nodiscard]] auto try_pop(Message_type& out) -> bool
+    {
+        Slot&             slot     = m_slots[m_tail & m_mask];
+        const std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence != m_tail + 1) {
+            return false; // empty, or producer has not finished writing
+        }
+        out = std::move(slot.message);
+        slot.message = Message_type{};
+        slot.sequence.store(m_tail + m_mask + 1, std::memory_order_release);
+        ++m_tail;
+        return true;
+    }
+
+private:
+    class Slot
+    {
+    public:
+        std::atomic<std::size_t> sequence{0};
+        Message_type             message {};
+    };
+
+    std::unique_ptr<Slot[]>               m_slots;
+    std::size_t                           m_mask{0};
+    alignas(64) std::atomic<std::size_t>  m_head{0};
+    alignas(64) std::size_t               m_tail{0};
+};
+
 template <typename Message_type>
 class Message_bus
 {
 public:
-    void add_receiver(std::function<void(Message_type&)> message_receiver)
+    using Receiver = std::function<void(Message_type&)>;
+
+    explicit Message_bus(std::size_t queue_capacity = 1024)
+        : m_receivers{std::make_shared<const Receiver_list>()}
+        , m_ring     {queue_capacity}
+    {
+    }
+
+    // Receives all messages
+    void add_receiver(Receiver message_receiver)
     {
-        std::lock_guard<ERHE_PROFILE_LOCKABLE_BASE(std::mutex)> lock{m_mutex};
-        m_receivers.push_back(message_receiver);
+        add_receiver(c_all_flags, std::move(message_receiver));
     }
 
+    // Receives only messages where (update_flags & flag_mask) != 0.
+    // For message types without update_flags the mask is ignored.
+    void add_receiver(const uint64_t flag_mask, Receiver message_receiver)
+    {
+        std::lock_guard<ERHE_PROFILE_LOCKABLE_BASE(std::mutex)> lock{m_receivers_mutex};
+        auto receivers = std::make_shared<Receiver_list>(*m_receivers);
+        receivers->flag_masks.push_back(flag_mask);
+        receivers->receivers .push_back(std::move(message_receiver));
+        m_receivers = std::move(receivers);
+    }
+
+    // Dispatches immediately on the calling thread. Receivers are invoked
+    // without holding any bus lock, so they may send or queue further messages.
     void send_message(Message_type message)
     {
-        std::lock_guard<ERHE_PROFILE_LOCKABLE_BASE(std::mutex)> lock{m_mutex};
-        for (auto iter = m_receivers.begin(); iter != m_receivers.end(); iter++) {
-            (*iter)(message);
-        }
+        ERHE_PROFILE_FUNCTION();
+
+        m_message_serial.fetch_add(1, std::memory_order_relaxed);
+        const std::shared_ptr<const Receiver_list> receivers = get_receivers();
+        dispatch(*receivers, message);
     }
 
+    // Safe to call from any thread; dispatched on the next update().
     void queue_message(Message_type message)
     {
-        std::lock_guard<ERHE_PROFILE_LOCKABLE_BASE(std::mutex)> lock{m_mutex};
-        m_messages.push(message);
+        m_message_serial.fetch_add(1, std::memory_order_relaxed);
+        if (!m_overflow_pending.load(std::memory_order_acquire) && m_ring.try_push(std::move(message))) {
+            return;
+        }
+        // Ring is full; spill to the overflow list to keep the message.
+        std::lock_guard<ERHE_PROFILE_LOCKABLE_BASE(std::mutex)> lock{m_overflow_mutex};
+        m_overflow.push_back(std::move(message));
+        m_overflow_pending.store(true, std::memory_order_release);
     }
 
+    // Must only be called from one thread at a time (the consumer).
     void update()
     {
-        std::lock_guard<ERHE_PROFILE_LOCKABLE_BASE(std::mutex)> lock{m_mutex};
-        while (!m_messages.empty()) {
-            for (auto iter = m_receivers.begin(); iter != m_receivers.end(); iter++) {
-                (*iter)(m_messages.front());
+        ERHE_PROFILE_FUNCTION();
+
+        const std::shared_ptr<const Receiver_list> receivers = get_receivers();
+
+        Message_type message{};
+        while (m_ring.try_pop(message)) {
+            dispatch(*receivers, message);
+        }
+
+        if (m_overflow_pending.load(std::memory_order_acquire)) {
+            {
+                std::lock_guard<ERHE_PROFILE_LOCKABLE_BASE(std::mutex)> lock{m_overflow_mutex};
+                std::swap(m_overflow, m_overflow_dispatch);
+                m_overflow_pending.store(false, std::memory_order_release);
+            }
+            // Messages which reached the ring while the overflow list was being
+            // swapped out are newer than the overflow messages; they stay queued.
+            for (Message_type& overflow_message : m_overflow_dispatch) {
+                dispatch(*receivers, overflow_message);
             }
-            m_messages.pop();
+            m_overflow_dispatch.clear(); // keeps capacity
         }
     }
 
+    // Incremented for each sent or queued message. Comparing against a
+    // previously read value tells if there has been any bus activity.
+    [[nodiscard]] auto get_message_serial() const -> uint64_t
+    {
+        return m_message_serial.load(std::memory_order_relaxed);
+    }
+
 private:
-    ERHE_PROFILE_MUTEX(std::mutex,                   m_mutex);
-    std::vector<std::function<void (Message_type&)>> m_receivers;
-    std::queue<Message_type>                         m_messages;
+    class Receiver_list
+    {
+    public:
+        std::vector<uint64_t> flag_masks;
+        std::vector<Receiver> receivers;
+    };
+
+    [[nodiscard]] auto get_receivers() const -> std::shared_ptr<const Receiver_list>
+    {
+        std::lock_guard<ERHE_PROFILE_LOCKABLE_BASE(std::mutex)> lock{m_receivers_mutex};
+        return m_receivers;
+    }
+
+    static void dispatch(const Receiver_list& receivers, Message_type& message)
+    {
+        const std::size_t count = receivers.receivers.size();
+        if constexpr (Flagged_message<Message_type>) {
+            const uint64_t flags = static_cast<uint64_t>(message.update_flags);
+            for (std::size_t i = 0; i < count; ++i) {
+                if ((receivers.flag_masks[i] & flags) != 0) {
+                    receivers.receivers[i](message);
+                }
+            }
+        } else {
+            for (std::size_t i = 0; i < count; ++i) {
+                receivers.receivers[i](message);
+            }
+        }
+    }
+
+    mutable ERHE_PROFILE_MUTEX(std::mutex, m_receivers_mutex);
+    std::shared_ptr<const Receiver_list>   m_receivers;
+
+    Mpsc_ring<Message_type>                m_ring;
+    ERHE_PROFILE_MUTEX(std::mutex,         m_overflow_mutex);
+    std::atomic<bool>                      m_overflow_pending{false};
+    std::vector<Message_type>              m_overflow;
+    std::vector<Message_type>              m_overflow_dispatch;
+    std::atomic<uint64_t>                  m_message_serial{0};
 };
 
 } // namespace erhe::message_bus
@@ -80,6 +80,11 @@ auto Client::send(const std::string& message) -> bool
     );
 }
 
+auto Client::send_packet(const Shared_packet& packet) -> bool
+{
+    return m_socket.send_packet(packet);
+}
+
 void Client::set_receive_handler(Receive_handler receive_handler)
 {
     m_socket.set_receive_handler(receive_handler);
@@ -17,6 +17,7 @@ public:
     auto connect            (const char* address, int port) -> bool;
     void disconnect         ();
     auto send               (const std::string& message) -> bool;
+    auto send_packet        (const Shared_packet& packet) -> bool;
     void set_receive_handler(Receive_handler receive_handler);
     auto poll               (int timeout_ms) -> bool;
     auto get_state          () -> Socket::State;
@@ -213,7 +213,7 @@ auto set_socket_option(
             if (flags == -1) {
                 return false;
             }
-            flags = (value != 0) ? (flags & ~O_NONBLOCK) : (flags | O_NONBLOCK);
+            flags = (value != 0) ? (flags | O_NONBLOCK) : (flags & ~O_NONBLOCK);
             result = fcntl(socket, F_SETFL, flags);
             break;
         }
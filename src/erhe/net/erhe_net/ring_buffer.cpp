@@ -1,5 +1,6 @@
 #include "erhe_net/ring_buffer.hpp"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstring>
 
@@ -66,7 +67,11 @@ auto Ring_buffer::size() const -> std::size_t
 
 void Ring_buffer::rotate()
 {
-    rotate(m_read_offset);
+    // Moves readable data to the start of the buffer; offsets must follow
+    const std::size_t byte_count = size();
+    std::rotate(m_buffer.begin(), m_buffer.begin() + m_read_offset, m_buffer.end());
+    m_read_offset  = 0;
+    m_write_offset = byte_count % m_max_size;
 }
 
 void Ring_buffer::rotate(std::size_t rotate_amount)
@@ -124,6 +129,10 @@ auto Ring_buffer::begin_produce(
 
 void Ring_buffer::end_produce(const std::size_t write_byte_count)
 {
+    // Nothing produced (for example recv() would block) - an empty buffer must not become full
+    if (write_byte_count == 0) {
+        return;
+    }
     m_write_offset = (m_write_offset + write_byte_count) % m_max_size;
     m_full = (m_write_offset == m_read_offset);
 }
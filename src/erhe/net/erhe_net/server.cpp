@@ -6,6 +6,12 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
+
+#if defined(ERHE_OS_LINUX)
+#   include <sys/epoll.h>
+#endif
+
 namespace erhe::net {
 
 Server::Server() = default;
@@ -13,30 +19,178 @@ Server::Server() = default;
 Server::~Server()
 {
     log_server->trace("Server destructor");
+    disconnect();
 }
 
 Server::Server(Server&& other) noexcept
-    : m_listen_socket  {std::move(other.m_listen_socket)}
-    , m_receive_handler{std::move(other.m_receive_handler)}
-    , m_clients        {std::move(other.m_clients)}
+    : m_listen_socket            {std::move(other.m_listen_socket)}
+    , m_receive_handler          {std::move(other.m_receive_handler)}
+    , m_client_receive_handler   {std::move(other.m_client_receive_handler)}
+    , m_client_disconnect_handler{std::move(other.m_client_disconnect_handler)}
+    , m_clients                  {std::move(other.m_clients)}
+#if defined(ERHE_OS_LINUX)
+    , m_epoll_fd                 {other.m_epoll_fd}
+#endif
 {
     log_server->trace("Server move constructor");
+#if defined(ERHE_OS_LINUX)
+    other.m_epoll_fd = -1;
+#endif
 }
 
 auto Server::operator=(Server&& other) noexcept -> Server&
 {
     log_server->trace("Server move assignment");
-    m_listen_socket   = std::move(other.m_listen_socket);
-    m_receive_handler = std::move(other.m_receive_handler);
-    m_clients         = std::move(other.m_clients);
+    disconnect();
+    m_listen_socket          = std::move(other.m_listen_socket);
+    m_receive_handler        = std::move(other.m_receive_handler);
+    m_client_receive_handler    = std::move(other.m_client_receive_handler);
+    m_client_disconnect_handler = std::move(other.m_client_disconnect_handler);
+    m_clients                   = std::move(other.m_clients);
+#if defined(ERHE_OS_LINUX)
+    m_epoll_fd               = other.m_epoll_fd;
+    other.m_epoll_fd         = -1;
+#endif
     return *this;
 }
 
 auto Server::listen(const char* address, const int port) -> bool
 {
-    return m_listen_socket.bind(address, port);
+    if (!m_listen_socket.bind(address, port)) {
+        return false;
+    }
+
+#if defined(ERHE_OS_LINUX)
+    m_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (m_epoll_fd < 0) {
+        log_server->error("epoll_create1() failed with error {}", get_net_last_error_message());
+        m_listen_socket.close();
+        return false;
+    }
+
+    // Listen socket is identified by nullptr, clients by their Socket address
+    epoll_event event{};
+    event.events   = EPOLLIN | EPOLLET;
+    event.data.ptr = nullptr;
+    if (epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, m_listen_socket.get_socket(), &event) != 0) {
+        log_server->error("epoll_ctl(ADD listen socket) failed with error {}", get_net_last_error_message());
+        disconnect();
+        return false;
+    }
+#endif
+    return true;
+}
+
+void Server::add_client(Socket&& socket)
+{
+    log_net->info("new client is connecting to server");
+    auto client = std::make_unique<Socket>(std::move(socket));
+    if (m_client_receive_handler) {
+        Socket* client_socket = client.get();
+        client->set_receive_handler(
+            [client_receive_handler = m_client_receive_handler, client_socket](const uint8_t* data, const std::size_t length) {
+                client_receive_handler(*client_socket, data, length);
+            }
+        );
+    } else {
+        client->set_receive_handler(m_receive_handler);
+    }
+
+#if defined(ERHE_OS_LINUX)
+    // Edge triggered; EPOLLOUT is reported each time the socket becomes writable
+    // again, so there is no need to modify interest when send queue changes.
+    epoll_event event{};
+    event.events   = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+    event.data.ptr = client.get();
+    if (epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, client->get_socket(), &event) != 0) {
+        log_server->error("epoll_ctl(ADD client socket) failed with error {}", get_net_last_error_message());
+        return;
+    }
+#endif
+
+    m_clients.push_back(std::move(client));
+}
+
+void Server::remove_closed_clients()
+{
+    if (m_client_disconnect_handler) {
+        for (const std::unique_ptr<Socket>& client : m_clients) {
+            if (client->get_state() == Socket::State::CLOSED) {
+                m_client_disconnect_handler(*client.get());
+            }
+        }
+    }
+
+    // Closing the socket also removes it from epoll set
+    m_clients.erase(
+        std::remove_if(
+            m_clients.begin(),
+            m_clients.end(),
+            [](const std::unique_ptr<Socket>& client) {
+                return client->get_state() == Socket::State::CLOSED;
+            }
+        ),
+        m_clients.end()
+    );
 }
 
+#if defined(ERHE_OS_LINUX)
+auto Server::poll(const int timeout_ms) -> bool
+{
+    if ((m_listen_socket.get_state() == Socket::State::CLOSED) || (m_epoll_fd < 0)) {
+        return true; // NOP
+    }
+
+    static constexpr int max_event_count = 256;
+    epoll_event events[max_event_count];
+    const int event_count = epoll_wait(m_epoll_fd, events, max_event_count, timeout_ms);
+    if (event_count < 0) {
+        const int error_code = get_net_last_error();
+        if (error_code == EINTR) {
+            return true;
+        }
+        log_server->error("epoll_wait() failed with error {}", get_net_error_message(error_code));
+        return false;
+    }
+
+    for (int i = 0; i < event_count; ++i) {
+        const epoll_event& event = events[i];
+        if (event.data.ptr == nullptr) {
+            // Edge triggered - accept all pending connections
+            for (;;) {
+                std::optional<Socket> new_socket = m_listen_socket.accept();
+                if (!new_socket.has_value()) {
+                    break;
+                }
+                add_client(std::move(new_socket.value()));
+            }
+            continue;
+        }
+
+        Socket& client = *static_cast<Socket*>(event.data.ptr);
+        if (client.get_state() != Socket::State::CONNECTED) {
+            continue;
+        }
+        if ((event.events & EPOLLERR) != 0) {
+            log_net->info("client socket error, closing");
+            client.close();
+            continue;
+        }
+        if ((event.events & EPOLLOUT) != 0) {
+            if (!client.send_pending()) {
+                continue;
+            }
+        }
+        if ((event.events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP)) != 0) {
+            // Edge triggered - read until recv() would block or peer closes
+            static_cast<void>(client.recv(true));
+        }
+    }
+
+    remove_closed_clients();
+    return true;
+}
+#else
 auto Server::poll(const int timeout_ms) -> bool
 {
     if (m_listen_socket.get_state() == Socket::State::CLOSED) {
@@ -48,49 +202,50 @@ auto Server::poll(const int timeout_ms) -> bool
     // Collect fds for select
     m_listen_socket.pre_select(select_sockets);
     for (auto& client : m_clients) {
-        client.pre_select(select_sockets);
+        client->pre_select(select_sockets);
     }
 
     // Call select() to find out if there is work to do
     const int select_res = select_sockets.select(timeout_ms);
     if (select_res == SOCKET_ERROR) {
-        log_net->trace("server select() returned error {}", get_net_last_error_message());
-        return false; // TODO
+        log_server->error("select() failed with error {}", get_net_last_error_message());
+        return false;
     }
 
     // Perform send and receive for client sockets, collect closed sockets
     for (auto& client : m_clients) {
-        client.post_select_send_recv(select_sockets);
+        client->post_select_send_recv(select_sockets);
     }
 
     // Remove closed sockets
-    m_clients.erase(
-        std::remove_if(
-            m_clients.begin(),
-            m_clients.end(),
-            [](Socket& client) {
-                return client.get_state() == Socket::State::CLOSED;
-            }
-        ),
-        m_clients.end()
-    );
+    remove_closed_clients();
 
     // Check for new clients
     auto new_socket = m_listen_socket.post_select_listen(select_sockets);
     if (new_socket.has_value()) {
-        log_net->info("new client is connecting to server");
-        new_socket.value().set_receive_handler(m_receive_handler);
-        m_clients.push_back(std::move(new_socket.value()));
+        add_client(std::move(new_socket.value()));
     }
 
     return true;
 }
+#endif
 
 auto Server::broadcast(const std::string& message) -> bool
+{
+    if (m_clients.empty()) {
+        return true;
+    }
+    return broadcast(Socket::make_packet(message.data(), message.length()));
+}
+
+auto Server::broadcast(const Shared_packet& packet) -> bool
 {
     std::size_t error_count = 0;
     for (auto& client : m_clients) {
-        if (!client.send(message.data(), static_cast<int>(message.length()))) {
+        if (client->get_state() != Socket::State::CONNECTED) {
+            continue;
+        }
+        if (!client->send_packet(packet)) {
             ++error_count;
         }
     }
@@ -102,10 +257,31 @@ void Server::set_receive_handler(Receive_handler receive_handler)
     m_receive_handler = receive_handler;
 }
 
+void Server::set_client_receive_handler(Client_receive_handler client_receive_handler)
+{
+    m_client_receive_handler = client_receive_handler;
+}
+
+void Server::set_client_disconnect_handler(Client_disconnect_handler client_disconnect_handler)
+{
+    m_client_disconnect_handler = client_disconnect_handler;
+}
+
 void Server::disconnect()
 {
     m_listen_socket.close();
+    if (m_client_disconnect_handler) {
+        for (const std::unique_ptr<Socket>& client : m_clients) {
+            m_client_disconnect_handler(*client.get());
+        }
+    }
     m_clients.clear();
+#if defined(ERHE_OS_LINUX)
+    if (m_epoll_fd >= 0) {
+        ::close(m_epoll_fd);
+        m_epoll_fd = -1;
+    }
+#endif
 }
 
 auto Server::get_state() const -> Socket::State
@@ -118,4 +294,9 @@ auto Server::get_client_count() const -> std::size_t
     return m_clients.size();
 }
 
+auto Server::get_clients() const -> const std::vector<std::unique_ptr<Socket>>&
+{
+    return m_clients;
+}
+
 } // namespace erhe::net
@@ -5,6 +5,12 @@
 namespace erhe::net
 {
 
+// Like Receive_handler, but also identifies the client socket which received the message
+using Client_receive_handler = std::function<void(Socket& client, const uint8_t* data, std::size_t length)>;
+
+// Called before a client socket is removed and destroyed
+using Client_disconnect_handler = std::function<void(Socket& client)>;
+
 class Server
 {
 public:
@@ -15,18 +21,31 @@ public:
     Server(Server&& other) noexcept;
     auto operator=(Server&& other) noexcept -> Server&;
 
+    // The message is framed once and shared by all clients
     auto broadcast          (const std::string& message) -> bool;
+    auto broadcast          (const Shared_packet& packet) -> bool;
     void set_receive_handler(Receive_handler receive_handler);
+    void set_client_receive_handler(Client_receive_handler client_receive_handler);
+    void set_client_disconnect_handler(Client_disconnect_handler client_disconnect_handler);
     void disconnect         ();
     auto listen             (const char* address, int port) -> bool;
     auto poll               (int timeout_ms) -> bool;
     auto get_state          () const -> Socket::State;
     auto get_client_count   () const -> std::size_t;
+    auto get_clients        () const -> const std::vector<std::unique_ptr<Socket>>&;
 
 private:
-    Socket              m_listen_socket;
-    Receive_handler     m_receive_handler;
-    std::vector<Socket> m_clients;
+    void remove_closed_clients();
+    void add_client           (Socket&& socket);
+
+    Socket                               m_listen_socket;
+    Receive_handler                      m_receive_handler;
+    Client_receive_handler               m_client_receive_handler;
+    Client_disconnect_handler            m_client_disconnect_handler;
+    std::vector<std::unique_ptr<Socket>> m_clients; // stable addresses for epoll
+#if defined(ERHE_OS_LINUX)
+    int                                  m_epoll_fd{-1};
+#endif
 };
 
 }
@@ -6,6 +6,14 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#if defined(ERHE_OS_LINUX)
+#   include <sys/uio.h>
+#endif
+
 namespace erhe::net {
 
 //                                            E  r  h  e
@@ -13,6 +21,10 @@ constexpr uint32_t erhe_header_magic_u32 = 0x45'72'68'65u;
 constexpr int      u32_byte_count        = sizeof(uint32_t);
 constexpr int      header_byte_count     = 2 * u32_byte_count;
 
+// Same limit as send ring buffer; a client which does not keep up is not
+// allowed to grow the queue without bound
+constexpr std::size_t max_send_queue_byte_count = 4 * 1024 * 1024;
+
 class Packet_header
 {
 public:
@@ -22,6 +34,7 @@ public:
     uint32_t magic {0};
     uint32_t length{0};
 };
+static_assert(sizeof(Packet_header) == Socket::packet_header_byte_count);
 
 auto c_str(const Socket::State state) -> const char*
 {
@@ -75,35 +88,41 @@ Socket::~Socket()
 }
 
 Socket::Socket(Socket&& other) noexcept
-    : m_socket         {other.m_socket}
-    , m_address_in     {other.m_address_in}
-    , m_addr_info      {other.m_addr_info}
-    , m_address        {std::move(other.m_address)}
-    , m_state          {other.m_state}
-    , m_send_buffer    {std::move(other.m_send_buffer)}
-    , m_receive_buffer {std::move(other.m_receive_buffer)}
-    , m_receive_handler{std::move(other.m_receive_handler)}
+    : m_socket               {other.m_socket}
+    , m_address_in           {other.m_address_in}
+    , m_addr_info            {other.m_addr_info}
+    , m_address              {std::move(other.m_address)}
+    , m_state                {other.m_state}
+    , m_send_buffer          {std::move(other.m_send_buffer)}
+    , m_receive_buffer       {std::move(other.m_receive_buffer)}
+    , m_receive_handler      {std::move(other.m_receive_handler)}
+    , m_send_queue           {std::move(other.m_send_queue)}
+    , m_send_queue_byte_count{other.m_send_queue_byte_count}
 {
     log_socket->trace("Socket move constructor");
-    other.m_socket    = INVALID_SOCKET;
-    other.m_state     = State::CLOSED;
-    other.m_addr_info = nullptr;
+    other.m_socket                = INVALID_SOCKET;
+    other.m_state                 = State::CLOSED;
+    other.m_addr_info             = nullptr;
+    other.m_send_queue_byte_count = 0;
 }
 
 auto Socket::operator=(Socket&& other) noexcept -> Socket&
 {
     log_socket->trace("Socket move assignment");
-    m_socket          = other.m_socket;
-    m_address_in      = other.m_address_in;
-    m_addr_info       = other.m_addr_info;
-    m_address         = std::move(other.m_address);
-    m_state           = other.m_state;
-    m_send_buffer     = std::move(other.m_send_buffer);
-    m_receive_buffer  = std::move(other.m_receive_buffer);
-    m_receive_handler = std::move(other.m_receive_handler);
-    other.m_socket    = INVALID_SOCKET;
-    other.m_state     = State::CLOSED;
-    other.m_addr_info = nullptr;
+    m_socket                      = other.m_socket;
+    m_address_in                  = other.m_address_in;
+    m_addr_info                   = other.m_addr_info;
+    m_address                     = std::move(other.m_address);
+    m_state                       = other.m_state;
+    m_send_buffer                 = std::move(other.m_send_buffer);
+    m_receive_buffer              = std::move(other.m_receive_buffer);
+    m_receive_handler             = std::move(other.m_receive_handler);
+    m_send_queue                  = std::move(other.m_send_queue);
+    m_send_queue_byte_count       = other.m_send_queue_byte_count;
+    other.m_socket                = INVALID_SOCKET;
+    other.m_state                 = State::CLOSED;
+    other.m_addr_info             = nullptr;
+    other.m_send_queue_byte_count = 0;
     return *this;
 }
 
@@ -116,6 +135,8 @@ void Socket::close()
     }
     m_send_buffer.reset();
     m_receive_buffer.reset();
+    m_send_queue.clear();
+    m_send_queue_byte_count = 0;
     if (is_socket_good(m_socket)) {
         log_socket->info("Closing socket");
         shutdown   (m_socket, SD_BOTH);
@@ -221,7 +242,7 @@ auto Socket::bind(const char* const address, const int port) -> bool
         return false;
     }
 
-    const int backlog = 8;
+    const int backlog = SOMAXCONN; // many clients may connect at once
     const int listen_res = listen(m_socket, backlog);
     if (listen_res == SOCKET_ERROR) {
         log_socket->error("listen() failed with error {}", get_net_last_error_message());
@@ -241,13 +262,14 @@ auto Socket::bind(const char* const address, const int port) -> bool
 auto Socket::send_pending() -> bool
 {
     ERHE_VERIFY(m_state == State::CONNECTED);
-    ERHE_VERIFY(m_send_buffer);
 
     // Loop (at most) twice, for the case where the ring buffer
     // wraps around, in which case two send() calls are needed.
+    // Ring buffer content is always older than queued packets, so
+    // queued packets are sent once the ring buffer has been drained.
     for (;;) {
-        if (m_send_buffer->empty()) {
-            return true;
+        if (!m_send_buffer || m_send_buffer->empty()) {
+            return send_queued_packets();
         }
 
         std::size_t          can_send_byte_count_before_wrap{0};
@@ -274,21 +296,125 @@ auto Socket::send_pending() -> bool
             return true;
         }
         m_send_buffer->end_consume(sent_byte_count);
-        if (
-            (sent_byte_count < can_send_byte_count_before_wrap) ||
-            (can_send_byte_count_after_wrap == 0)
-        ) {
-            break;
+        if (sent_byte_count < can_send_byte_count_before_wrap) {
+            return true; // socket send buffer is full, try again later
+        }
+    }
+}
+
+auto Socket::make_packet(const char* const data, const std::size_t length) -> Shared_packet
+{
+    auto packet = std::make_shared<std::vector<uint8_t>>(sizeof(Packet_header) + length);
+    const Packet_header header{static_cast<uint32_t>(length)};
+    std::memcpy(packet->data(), &header, sizeof(Packet_header));
+    if (length > 0) {
+        std::memcpy(packet->data() + sizeof(Packet_header), data, length);
+    }
+    return packet;
+}
+
+// Sends queued shared packets, gathering as many as possible into one call.
+// Returns true if no error, returns false in case of error.
+auto Socket::send_queued_packets() -> bool
+{
+    while (!m_send_queue.empty()) {
+        static constexpr std::size_t max_gather_count = 64;
+        std::size_t gather_count = 0;
+        std::size_t gather_bytes = 0;
+
+#if defined(ERHE_OS_LINUX)
+        std::array<iovec, max_gather_count> iov;
+        for (const Queued_packet& entry : m_send_queue) {
+            if (gather_count == max_gather_count) {
+                break;
+            }
+            iov[gather_count].iov_base = const_cast<uint8_t*>(entry.packet->data() + entry.offset);
+            iov[gather_count].iov_len  = entry.packet->size() - entry.offset;
+            gather_bytes += iov[gather_count].iov_len;
+            ++gather_count;
+        }
+        msghdr message{};
+        message.msg_iov    = iov.data();
+        message.msg_iovlen = gather_count;
+        const ssize_t send_result = ::sendmsg(m_socket, &message, MSG_NOSIGNAL);
+#else
+        const Queued_packet& front = m_send_queue.front();
+        gather_count = 1;
+        gather_bytes = front.packet->size() - front.offset;
+        const int send_result = ::send(
+            m_socket,
+            reinterpret_cast<const char*>(front.packet->data() + front.offset),
+            static_cast<int>(gather_bytes),
+            0
+        );
+#endif
+        if (send_result < 0) {
+            const int error_code = get_net_last_error();
+            if (is_error_fatal(error_code)) {
+                log_socket->error("send({} bytes) failed with error {}", gather_bytes, get_net_error_message(error_code));
+                close();
+                return false;
+            }
+            return true; // would block
+        }
+
+        // Retire fully sent packets
+        std::size_t sent_byte_count = static_cast<std::size_t>(send_result);
+        m_send_queue_byte_count -= sent_byte_count;
+        while (sent_byte_count > 0) {
+            Queued_packet&    front     = m_send_queue.front();
+            const std::size_t remaining = front.packet->size() - front.offset;
+            if (sent_byte_count < remaining) {
+                front.offset += sent_byte_count;
+                break;
+            }
+            sent_byte_count -= remaining;
+            m_send_queue.pop_front();
+        }
+        if (static_cast<std::size_t>(send_result) < gather_bytes) {
+            break; // socket send buffer is full
         }
     }
     return true;
 }
 
+// Queues a shared packet. The packet payload is not copied.
+// Returns true if there was no error, false if there was an error.
+auto Socket::send_packet(const Shared_packet& packet) -> bool
+{
+    ERHE_VERIFY(m_state == State::CONNECTED);
+    ERHE_VERIFY(packet);
+
+    if (m_send_queue_byte_count + packet->size() > max_send_queue_byte_count) {
+        const auto send_pending_result = send_pending();
+        if (!send_pending_result) {
+            return false;
+        }
+        if (m_send_queue_byte_count + packet->size() > max_send_queue_byte_count) {
+            log_socket->warn("packet ({} bytes) does not fit to send queue ({} bytes queued)", packet->size(), m_send_queue_byte_count);
+            return false;
+        }
+    }
+    m_send_queue.push_back(Queued_packet{.packet = packet, .offset = 0});
+    m_send_queue_byte_count += packet->size();
+    return send_pending();
+}
+
 // Sends a packet. Returns true if there was no error, false if there was an error.
 auto Socket::send(const char* const data, const int length) -> bool
 {
     ERHE_VERIFY(m_state == State::CONNECTED);
 
+    // Keep packet order when shared packets are already queued
+    if (!m_send_queue.empty()) {
+        return send_packet(make_packet(data, static_cast<std::size_t>(length)));
+    }
+
+    // Allocated on first use; server side sockets usually only send shared packets
+    if (!m_send_buffer) {
+        m_send_buffer = std::make_unique<Ring_buffer>(4 * 1024 * 1024);
+    }
+
     // Check if new message fits to send buffer
     std::size_t can_write_count = m_send_buffer->size_available_for_write();
     if (can_write_count < sizeof(Packet_header) + length) {
@@ -336,7 +462,7 @@ auto Socket::receive_packet_length() -> uint32_t
 }
 
 // returns false in case of error, true if ok
-auto Socket::recv() -> bool
+auto Socket::recv(const bool drain) -> bool
 {
     ERHE_VERIFY(m_state == State::CONNECTED);
     ERHE_VERIFY(m_receive_buffer);
@@ -400,6 +526,10 @@ auto Socket::recv() -> bool
             if (m_receive_handler) {
                 log_socket->info("calling receive handler");
                 m_receive_handler(read_pointer + header_byte_count, next_packet_length);
+                // Handler may have closed the socket, which also releases receive buffer
+                if (m_state == State::CLOSED) {
+                    return true;
+                }
             } else {
                 log_socket->warn("no receive handler set, message discarded");
             }
@@ -407,8 +537,11 @@ auto Socket::recv() -> bool
         }
 
         if (
-            (received_byte_count < can_receive_byte_count_before_wrap) ||
-            (can_receive_byte_count_after_wrap == 0)
+            !drain &&
+            (
+                (received_byte_count < can_receive_byte_count_before_wrap) ||
+                (can_receive_byte_count_after_wrap == 0)
+            )
         ) {
             break;
         }
@@ -478,7 +611,6 @@ void Socket::on_state_changed(const State old_state, const State new_state)
 {
     log_socket->info("Socket state changed {} -> {}", c_str(old_state), c_str(new_state));
     if (new_state == State::CONNECTED) {
-        m_send_buffer    = std::make_unique<Ring_buffer>(4 * 1024 * 1024);
         m_receive_buffer = std::make_unique<Ring_buffer>(4 * 1024 * 1024);
     }
 }
@@ -564,24 +696,35 @@ auto Socket::post_select_listen(Select_sockets& select_sockets) -> std::optional
 {
     if (select_sockets.has_read(m_socket)) {
         log_socket->info("Server post_select_listen() has readable socket");
+        return accept();
+    }
+    return {};
+}
 
-        sockaddr_in  address{};
-        socklen_t    len        = sizeof(address);
-        const SOCKET accept_res = ::accept(m_socket, reinterpret_cast<sockaddr*>(&address), &len);
-        if (!is_socket_good(accept_res)) {
-            const int error_code = get_net_last_error();
-            if (!is_error_busy(error_code)) {
-                log_socket->warn("Server accept() failed with error {}", get_net_error_message(error_code));
-                return {};
-            }
-        } else {
-            // TODO check if already added
-            // TODO set buffer sizes
-            log_socket->info("Server accept(): new connection");
-            return Socket{accept_res, address};
+// Returns new connection, or empty if there are no pending connections
+auto Socket::accept() -> std::optional<Socket>
+{
+    ERHE_VERIFY(m_state == State::SERVER_LISTENING);
+
+    sockaddr_in  address{};
+    socklen_t    len        = sizeof(address);
+    const SOCKET accept_res = ::accept(m_socket, reinterpret_cast<sockaddr*>(&address), &len);
+    if (!is_socket_good(accept_res)) {
+        const int error_code = get_net_last_error();
+        if (!is_error_busy(error_code)) {
+            log_socket->warn("Server accept() failed with error {}", get_net_error_message(error_code));
         }
+        return {};
     }
-    return {};
+
+    // TODO set buffer sizes
+    const bool non_block_ok = set_socket_option(accept_res, Socket_option::NonBlocking, true);
+    if (!non_block_ok) {
+        closesocket(accept_res);
+        return {};
+    }
+    log_socket->info("Server accept(): new connection");
+    return Socket{accept_res, address};
 }
 
 } // namespace erhe::net
@@ -3,6 +3,7 @@
 #include "erhe_net/ring_buffer.hpp"
 #include "erhe_net/net_os.hpp"
 
+#include <deque>
 #include <functional>
 #include <memory>
 #include <optional>
@@ -13,6 +14,9 @@ namespace erhe::net {
 
 using Receive_handler = std::function<void(const uint8_t* data, std::size_t length)>;
 
+// Complete packet (header and payload), shared by all sockets it is sent to
+using Shared_packet = std::shared_ptr<const std::vector<uint8_t>>;
+
 class Select_sockets;
 
 class Socket
@@ -25,6 +29,9 @@ public:
         CONNECTED         = 3
     };
 
+    // Framing added to each packet (magic, length)
+    static constexpr std::size_t packet_header_byte_count = 2 * sizeof(uint32_t);
+
     Socket();
     Socket(const SOCKET& socket, const sockaddr_in& address_in);
     ~Socket();
@@ -38,13 +45,17 @@ public:
     auto get_socket          () const -> SOCKET                { return m_socket; }
     auto get_sockaddr_in     () const -> const sockaddr_in&    { return m_address_in; }
     auto get_address_string  () const -> const std::string&    { return m_address; }
-    auto get_send_buffer_size() const -> size_t                { return m_send_buffer ? m_send_buffer->size() : 0; }
+    auto get_send_buffer_size() const -> size_t                { return (m_send_buffer ? m_send_buffer->size() : 0) + m_send_queue_byte_count; }
     auto send                (const char* data, int length) -> bool;
+    auto send_packet         (const Shared_packet& packet) -> bool;
     auto send_pending        () -> bool;
-    auto recv                () -> bool;
+    auto recv                (bool drain = false) -> bool; // drain: read until recv() would block (edge triggered)
+    auto accept              () -> std::optional<Socket>;
     auto get_receive_buffer  () -> Ring_buffer* { return m_receive_buffer.get(); }
     void close               ();
-    auto has_pending_writes  () -> bool         { return m_send_buffer ? !m_send_buffer->empty() : false; }
+    auto has_pending_writes  () -> bool         { return (m_send_buffer ? !m_send_buffer->empty() : false) || !m_send_queue.empty(); }
+
+    [[nodiscard]] static auto make_packet(const char* data, std::size_t length) -> Shared_packet;
 
     void pre_select           (Select_sockets& select_sockets);
     auto post_select_send_recv(Select_sockets& select_sockets) -> bool;
@@ -59,6 +70,14 @@ private:
     void set_state            (State state);
     void on_state_changed     (State old_state, State new_state);
     auto receive_packet_length() -> uint32_t;
+    auto send_queued_packets  () -> bool;
+
+    class Queued_packet
+    {
+    public:
+        Shared_packet packet;
+        std::size_t   offset{0}; // bytes already sent
+    };
 
     SOCKET                       m_socket    {INVALID_SOCKET};
     sockaddr_in                  m_address_in{};
@@ -68,6 +87,8 @@ private:
     std::unique_ptr<Ring_buffer> m_send_buffer;
     std::unique_ptr<Ring_buffer> m_receive_buffer;
     Receive_handler              m_receive_handler;
+    std::deque<Queued_packet>    m_send_queue;
+    std::size_t                  m_send_queue_byte_count{0};
 };
 
 [[nodiscard]] auto c_str(const Socket::State state) -> const char*;
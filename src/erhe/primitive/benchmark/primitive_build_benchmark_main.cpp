@@ -0,0 +1,217 @@
+// Headless primitive build benchmark. Builds fill triangles, edge lines,
+// corner points and centroid points for a generated torus into CPU buffers,
+// without executor and with an executor, and checks that both builds write
+// identical vertex and index data. Uses the explorer vertex format.
+//
+//   primitive-build-benchmark --steps 1000 --iterations 3
+
+#include "erhe_buffer/ibuffer.hpp"
+#include "erhe_dataformat/dataformat_log.hpp"
+#include "erhe_dataformat/vertex_format.hpp"
+#include "erhe_geometry/geometry.hpp"
+#include "erhe_geometry/geometry_log.hpp"
+#include "erhe_geometry/shapes/torus.hpp"
+#include "erhe_log/log.hpp"
+#include "erhe_primitive/buffer_mesh.hpp"
+#include "erhe_primitive/buffer_sink.hpp"
+#include "erhe_primitive/build_info.hpp"
+#include "erhe_primitive/primitive_builder.hpp"
+#include "erhe_primitive/primitive_log.hpp"
+
+#include <cxxopts.hpp>
+#include <fmt/format.h>
+#include <geogram/basic/common.h>
+#include <taskflow/taskflow.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <span>
+#include <thread>
+#include <vector>
+
+class Options
+{
+public:
+    Options(int argc, char** argv)
+    {
+        cxxopts::Options options{"primitive-build-benchmark", "Times serial and parallel primitive builds"};
+
+        options.add_options()
+            ("steps",      "Torus has steps x steps quads", cxxopts::value<int>()->default_value("1000"), "<count>")
+            ("iterations", "Number of timed builds for each mode", cxxopts::value<int>()->default_value("3"), "<count>")
+            ("threads",    "Executor worker count, 0 for hardware concurrency", cxxopts::value<int>()->default_value("0"), "<count>")
+            ("help",       "Print help");
+
+        try {
+            auto arguments = options.parse(argc, argv);
+            if (arguments.count("help")) {
+                fmt::print("{}\n", options.help());
+                return;
+            }
+            steps      = std::max(3, arguments["steps"     ].as<int>());
+            iterations = std::max(1, arguments["iterations"].as<int>());
+            threads    = std::max(0, arguments["threads"   ].as<int>());
+            valid      = true;
+        } catch (const std::exception& e) {
+            fmt::print("Error parsing command line arguments: {}\n", e.what());
+        }
+    }
+
+    bool valid     {false};
+    int  steps     {0};
+    int  iterations{0};
+    int  threads   {0};
+};
+
+namespace {
+
+// Same as explorer
+auto make_vertex_format() -> erhe::dataformat::Vertex_format
+{
+    return erhe::dataformat::Vertex_format{
+        {
+            0,
+            {
+                { erhe::dataformat::Format::format_32_vec3_float, erhe::dataformat::Vertex_attribute_usage::position,      0},
+                { erhe::dataformat::Format::format_32_vec4_uint,  erhe::dataformat::Vertex_attribute_usage::joint_indices, 0},
+                { erhe::dataformat::Format::format_32_vec4_float, erhe::dataformat::Vertex_attribute_usage::joint_weights, 0}
+            }
+        },
+        {
+            1,
+            {
+                { erhe::dataformat::Format::format_32_vec3_float, erhe::dataformat::Vertex_attribute_usage::normal,    0},
+                { erhe::dataformat::Format::format_32_vec3_float, erhe::dataformat::Vertex_attribute_usage::normal,    1},
+                { erhe::dataformat::Format::format_32_vec4_float, erhe::dataformat::Vertex_attribute_usage::tangent,   0},
+                { erhe::dataformat::Format::format_32_vec2_float, erhe::dataformat::Vertex_attribute_usage::tex_coord, 0},
+                { erhe::dataformat::Format::format_32_vec4_float, erhe::dataformat::Vertex_attribute_usage::color,     0},
+                { erhe::dataformat::Format::format_8_vec2_unorm,  erhe::dataformat::Vertex_attribute_usage::custom,    erhe::dataformat::custom_attribute_aniso_control},
+                { erhe::dataformat::Format::format_16_vec2_uint,  erhe::dataformat::Vertex_attribute_usage::custom,    erhe::dataformat::custom_attribute_valency_edge_count}
+            }
+        }
+    };
+}
+
+class Build_output
+{
+public:
+    std::vector<std::vector<std::byte>> vertex_streams;
+    std::vector<std::byte>              indices;
+};
+
+auto time_build(
+    const erhe::geometry::Geometry&        geometry,
+    const erhe::dataformat::Vertex_format& vertex_format,
+    tf::Executor*                          executor,
+    const int                              iterations,
+    Build_output&                          out_output
+) -> double
+{
+    const Mesh_info   mesh_info    = get_mesh_info(geometry.get_mesh());
+    const std::size_t vertex_count = mesh_info.vertex_count_corners + mesh_info.vertex_count_centroids;
+    const std::size_t index_count  =
+        mesh_info.index_count_fill_triangles +
+        mesh_info.index_count_edge_lines +
+        mesh_info.index_count_corner_points +
+        mesh_info.index_count_centroid_points;
+
+    double best_ms = 0.0;
+    for (int i = 0; i < iterations; ++i) {
+        // Allocations are aligned, leave room for padding
+        erhe::buffer::Cpu_buffer vertex_buffer_0{"vertex stream 0", vertex_count * vertex_format.streams[0].stride + 256};
+        erhe::buffer::Cpu_buffer vertex_buffer_1{"vertex stream 1", vertex_count * vertex_format.streams[1].stride + 256};
+        erhe::buffer::Cpu_buffer index_buffer   {"index buffer",    index_count * sizeof(uint32_t) + 256};
+        erhe::primitive::Cpu_buffer_sink  buffer_sink{{&vertex_buffer_0, &vertex_buffer_1}, index_buffer};
+        const erhe::primitive::Build_info build_info{
+            .primitive_types = {
+                .fill_triangles  = true,
+                .edge_lines      = true,
+                .corner_points   = true,
+                .centroid_points = true
+            },
+            .buffer_info = {
+                .normal_style  = erhe::primitive::Normal_style::corner_normals,
+                .index_type    = erhe::dataformat::Format::format_32_scalar_uint,
+                .vertex_format = vertex_format,
+                .buffer_sink   = buffer_sink,
+                .executor      = executor
+            }
+        };
+        erhe::primitive::Buffer_mesh      buffer_mesh;
+        erhe::primitive::Element_mappings element_mappings;
+
+        const auto start = std::chrono::steady_clock::now();
+        const bool ok    = erhe::primitive::build_buffer_mesh(buffer_mesh, geometry.get_mesh(), build_info, element_mappings);
+        const auto end   = std::chrono::steady_clock::now();
+        if (!ok) {
+            fmt::print("build_buffer_mesh() failed\n");
+            return 0.0;
+        }
+        const double ms = std::chrono::duration<double, std::milli>(end - start).count();
+        best_ms = (i == 0) ? ms : std::min(best_ms, ms);
+
+        const auto copy = [](erhe::buffer::Cpu_buffer& buffer) {
+            const std::span<std::byte> span = buffer.span();
+            return std::vector<std::byte>{span.begin(), span.end()};
+        };
+        out_output.vertex_streams = {copy(vertex_buffer_0), copy(vertex_buffer_1)};
+        out_output.indices        = copy(index_buffer);
+    }
+    return best_ms;
+}
+
+} // anonymous namespace
+
+auto main(int argc, char** argv) -> int
+{
+    Options options{argc, argv};
+    if (!options.valid) {
+        return 1;
+    }
+
+    erhe::log::console_init();
+    erhe::log::log_to_console();
+    erhe::log::initialize_log_sinks();
+    erhe::dataformat::initialize_logging();
+    erhe::geometry::initialize_logging();
+    erhe::primitive::initialize_logging();
+    GEO::initialize(GEO::GEOGRAM_INSTALL_NONE);
+
+    const uint64_t process_flags =
+        erhe::geometry::Geometry::process_flag_connect |
+        erhe::geometry::Geometry::process_flag_build_edges |
+        erhe::geometry::Geometry::process_flag_compute_facet_centroids |
+        erhe::geometry::Geometry::process_flag_compute_smooth_vertex_normals |
+        erhe::geometry::Geometry::process_flag_generate_facet_texture_coordinates;
+
+    tf::Executor executor{(options.threads > 0) ? static_cast<std::size_t>(options.threads) : std::max(1u, std::thread::hardware_concurrency())};
+
+    erhe::geometry::Geometry geometry{"torus"};
+    {
+        const auto start = std::chrono::steady_clock::now();
+        erhe::geometry::shapes::make_torus(geometry.get_mesh(), 1.0f, 0.25f, options.steps, options.steps);
+        geometry.process(process_flags, &executor);
+        const auto end = std::chrono::steady_clock::now();
+        fmt::print(
+            "torus: {} facets, {} vertices, generated in {:.1f} ms\n",
+            geometry.get_mesh().facets.nb(), geometry.get_mesh().vertices.nb(),
+            std::chrono::duration<double, std::milli>(end - start).count()
+        );
+    }
+
+    const erhe::dataformat::Vertex_format vertex_format = make_vertex_format();
+
+    Build_output serial_output;
+    Build_output parallel_output;
+    const double serial_ms   = time_build(geometry, vertex_format, nullptr,   options.iterations, serial_output);
+    const double parallel_ms = time_build(geometry, vertex_format, &executor, options.iterations, parallel_output);
+    const bool   match       =
+        (serial_output.vertex_streams == parallel_output.vertex_streams) &&
+        (serial_output.indices        == parallel_output.indices);
+
+    const double facet_count = static_cast<double>(geometry.get_mesh().facets.nb());
+    fmt::print("serial:   {:9.2f} ms  {:8.1f} kfacets/s\n", serial_ms, facet_count / serial_ms);
+    fmt::print("parallel: {:9.2f} ms  {:8.1f} kfacets/s, {} workers\n", parallel_ms, facet_count / parallel_ms, executor.num_workers());
+    fmt::print("speedup:  {:9.2f}x, output {}\n", serial_ms / parallel_ms, match ? "identical" : "DIFFERS");
+    return match ? 0 : 1;
+}
@@ -3,6 +3,10 @@
 #include "erhe_dataformat/vertex_format.hpp"
 #include "erhe_primitive/enums.hpp"
 
+namespace tf {
+    class Executor;
+}
+
 namespace erhe::primitive {
 
 class Buffer_sink;
@@ -14,6 +18,7 @@ public:
     erhe::dataformat::Format               index_type   {erhe::dataformat::Format::format_16_scalar_uint};
     const erhe::dataformat::Vertex_format& vertex_format;
     Buffer_sink&                           buffer_sink;
+    tf::Executor*                          executor     {nullptr}; // if set, large meshes are built in parallel chunks
 };
 
 } // namesapce erhe::primitive
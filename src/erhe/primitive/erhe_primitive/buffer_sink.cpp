@@ -10,6 +10,16 @@ Buffer_sink::~Buffer_sink() noexcept
 {
 }
 
+auto Buffer_sink::begin_vertex_data(std::size_t, std::size_t, std::size_t) const -> Sink_write_span
+{
+    return {};
+}
+
+auto Buffer_sink::begin_index_data(std::size_t, std::size_t) const -> Sink_write_span
+{
+    return {};
+}
+
 Cpu_buffer_sink::Cpu_buffer_sink(std::initializer_list<erhe::buffer::Cpu_buffer*> vertex_buffers, erhe::buffer::Cpu_buffer& index_buffer)
     : m_vertex_buffers{vertex_buffers}
     , m_index_buffer{index_buffer}
@@ -44,6 +54,22 @@ auto Cpu_buffer_sink::allocate_index_buffer(const std::size_t index_count, const
     };
 }
 
+auto Cpu_buffer_sink::begin_vertex_data(const std::size_t stream, const std::size_t offset, const std::size_t byte_count) const -> Sink_write_span
+{
+    auto buffer_span = m_vertex_buffers.at(stream)->span();
+    return Sink_write_span{
+        .span = std::span<std::uint8_t>{reinterpret_cast<std::uint8_t*>(buffer_span.data()) + offset, byte_count}
+    };
+}
+
+auto Cpu_buffer_sink::begin_index_data(const std::size_t offset, const std::size_t byte_count) const -> Sink_write_span
+{
+    auto buffer_span = m_index_buffer.span();
+    return Sink_write_span{
+        .span = std::span<std::uint8_t>{reinterpret_cast<std::uint8_t*>(buffer_span.data()) + offset, byte_count}
+    };
+}
+
 void Cpu_buffer_sink::enqueue_index_data(const std::size_t offset, std::vector<uint8_t>&& data) const
 {
     auto buffer_span = m_index_buffer.span();
@@ -60,6 +86,9 @@ void Cpu_buffer_sink::enqueue_vertex_data(const std::size_t stream, const std::s
 
 void Cpu_buffer_sink::buffer_ready(Vertex_buffer_writer& writer) const
 {
+    if (writer.vertex_data.empty()) {
+        return; // written directly to buffer
+    }
     auto        buffer_span = m_vertex_buffers.at(writer.stream)->span();
     const auto& data        = writer.vertex_data;
     auto        offset_span = buffer_span.subspan(writer.start_offset(), data.size());
@@ -68,6 +97,9 @@ void Cpu_buffer_sink::buffer_ready(Vertex_buffer_writer& writer) const
 
 void Cpu_buffer_sink::buffer_ready(Index_buffer_writer& writer) const
 {
+    if (writer.index_data.empty()) {
+        return; // written directly to buffer
+    }
     auto        buffer_span = m_index_buffer.span();
     const auto& data        = writer.index_data;
     auto        offset_span = buffer_span.subspan(writer.start_offset(), data.size());
@@ -2,8 +2,9 @@
 
 #include "erhe_primitive/buffer_range.hpp"
 
-#include <vector>
 #include <cstdint>
+#include <span>
+#include <vector>
 
 namespace erhe::graphics {
     class Buffer;
@@ -20,11 +21,25 @@ class Build_context;
 class Index_buffer_writer;
 class Vertex_buffer_writer;
 
+/// Memory provided by Buffer_sink for writers to write to directly,
+/// instead of writing to their own std::vector which is then copied.
+/// Empty span means direct writes are not available.
+class Sink_write_span
+{
+public:
+    std::span<std::uint8_t> span;
+    std::size_t             sink_offset  {0}; // opaque to writers
+    std::size_t             sink_position{0}; // opaque to writers
+};
+
 class Buffer_sink
 {
 public:
     virtual ~Buffer_sink() noexcept;
 
+    [[nodiscard]] virtual auto begin_vertex_data(std::size_t stream, std::size_t offset, std::size_t byte_count) const -> Sink_write_span;
+    [[nodiscard]] virtual auto begin_index_data (std::size_t offset, std::size_t byte_count) const -> Sink_write_span;
+
     [[nodiscard]] virtual auto allocate_vertex_buffer(std::size_t stream, std::size_t vertex_count, std::size_t vertex_element_size) -> Buffer_range = 0;
     [[nodiscard]] virtual auto allocate_index_buffer (std::size_t index_count, std::size_t index_element_size) -> Buffer_range = 0;
 
@@ -41,6 +56,8 @@ public:
 
     auto allocate_vertex_buffer(std::size_t stream, std::size_t vertex_count, std::size_t vertex_element_size) -> Buffer_range override;
     auto allocate_index_buffer (std::size_t index_count, std::size_t index_element_size) -> Buffer_range override;
+    auto begin_vertex_data     (std::size_t stream, std::size_t offset, std::size_t byte_count) const -> Sink_write_span override;
+    auto begin_index_data      (std::size_t offset, std::size_t byte_count) const -> Sink_write_span override;
 
     void enqueue_vertex_data(std::size_t stream, std::size_t offset, std::vector<uint8_t>&& data) const override;
     void enqueue_index_data (std::size_t offset, std::vector<uint8_t>&& data) const override;
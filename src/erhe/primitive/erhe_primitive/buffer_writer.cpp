@@ -8,6 +8,7 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/packing.hpp>
 
+#include <algorithm>
 #include <span>
 
 namespace erhe::primitive {
@@ -48,91 +49,6 @@ inline void write_low(const std::span<std::uint8_t> destination, const erhe::dat
     write_low(destination, format, static_cast<std::size_t>(value));
 }
 
-inline void write_low2(const std::span<std::uint8_t> destination, const erhe::dataformat::Format format, const float* value)
-{
-    switch (format) {
-        case erhe::dataformat::Format::format_32_vec2_float: {
-            auto* const ptr = reinterpret_cast<float*>(destination.data());
-            ptr[0] = value[0];
-            ptr[1] = value[1];
-            break;
-        }
-        case erhe::dataformat::Format::format_8_vec2_unorm: {
-            auto* const ptr = reinterpret_cast<uint8_t*>(destination.data());
-            ptr[0] = erhe::dataformat::float_to_unorm8(value[0]);
-            ptr[1] = erhe::dataformat::float_to_unorm8(value[1]);
-            break;
-        }
-        case erhe::dataformat::Format::format_8_vec2_snorm: {
-            auto* const ptr = reinterpret_cast<uint8_t*>(destination.data());
-            ptr[0] = erhe::dataformat::float_to_snorm8(value[0]);
-            ptr[1] = erhe::dataformat::float_to_snorm8(value[1]);
-            break;
-        }
-        case erhe::dataformat::Format::format_16_vec2_unorm: {
-            auto* const ptr = reinterpret_cast<uint16_t*>(destination.data());
-            ptr[0] = erhe::dataformat::float_to_unorm16(value[0]);
-            ptr[1] = erhe::dataformat::float_to_unorm16(value[1]);
-            break;
-        }
-        case erhe::dataformat::Format::format_16_vec2_snorm: {
-            auto* const ptr = reinterpret_cast<int16_t*>(destination.data());
-            ptr[0] = erhe::dataformat::float_to_snorm16(value[0]);
-            ptr[1] = erhe::dataformat::float_to_snorm16(value[1]);
-            break;
-        }
-        default: {
-            ERHE_FATAL("unsupported attribute type");
-            break;
-        }
-    }
-}
-
-inline void write_low3(const std::span<std::uint8_t> destination, const erhe::dataformat::Format format, const float* value)
-{
-    switch (format) {
-        case erhe::dataformat::Format::format_32_vec3_float: {
-            auto* const ptr = reinterpret_cast<float*>(destination.data());
-            ptr[0] = value[0];
-            ptr[1] = value[1];
-            ptr[2] = value[2];
-            break;
-        }
-        case erhe::dataformat::Format::format_8_vec3_unorm: {
-            auto* const ptr = reinterpret_cast<uint8_t*>(destination.data());
-            ptr[0] = erhe::dataformat::float_to_unorm8(value[0]);
-            ptr[1] = erhe::dataformat::float_to_unorm8(value[1]);
-            ptr[2] = erhe::dataformat::float_to_unorm8(value[2]);
-            break;
-        }
-        case erhe::dataformat::Format::format_8_vec3_snorm: {
-            auto* const ptr = reinterpret_cast<uint8_t*>(destination.data());
-            ptr[0] = erhe::dataformat::float_to_snorm8(value[0]);
-            ptr[1] = erhe::dataformat::float_to_snorm8(value[1]);
-            ptr[2] = erhe::dataformat::float_to_snorm8(value[2]);
-            break;
-        }
-        case erhe::dataformat::Format::format_16_vec3_unorm: {
-            auto* const ptr = reinterpret_cast<uint16_t*>(destination.data());
-            ptr[0] = erhe::dataformat::float_to_unorm16(value[0]);
-            ptr[1] = erhe::dataformat::float_to_unorm16(value[1]);
-            ptr[2] = erhe::dataformat::float_to_unorm16(value[2]);
-            break;
-        }
-        case erhe::dataformat::Format::format_16_vec3_snorm: {
-            auto* const ptr = reinterpret_cast<int16_t*>(destination.data());
-            ptr[0] = erhe::dataformat::float_to_snorm16(value[0]);
-            ptr[1] = erhe::dataformat::float_to_snorm16(value[1]);
-            ptr[2] = erhe::dataformat::float_to_snorm16(value[2]);
-            break;
-        }
-        default: {
-            ERHE_FATAL("unsupported attribute type");
-            break;
-        }
-    }
-}
-
 inline void write_low2(const std::span<std::uint8_t> destination, const erhe::dataformat::Format format, const uint32_t* value)
 {
     switch (format) {
@@ -371,56 +287,6 @@ inline void write_low4(const std::span<std::uint8_t> destination, const erhe::da
     }
 }
 
-inline void write_low4(const std::span<std::uint8_t> destination, const erhe::dataformat::Format format, const float* value)
-{
-    switch (format) {
-        case erhe::dataformat::Format::format_32_vec4_float: {
-            auto* const ptr = reinterpret_cast<float*>(destination.data());
-            ptr[0] = value[0];
-            ptr[1] = value[1];
-            ptr[2] = value[2];
-            ptr[3] = value[3];
-            break;
-        }
-        case erhe::dataformat::Format::format_8_vec4_unorm: {
-            auto* const ptr = reinterpret_cast<uint8_t*>(destination.data());
-            ptr[0] = erhe::dataformat::float_to_unorm8(value[0]);
-            ptr[1] = erhe::dataformat::float_to_unorm8(value[1]);
-            ptr[2] = erhe::dataformat::float_to_unorm8(value[2]);
-            ptr[3] = erhe::dataformat::float_to_unorm8(value[3]);
-            break;
-        }
-        case erhe::dataformat::Format::format_8_vec4_snorm: {
-            auto* const ptr = reinterpret_cast<uint8_t*>(destination.data());
-            ptr[0] = erhe::dataformat::float_to_snorm8(value[0]);
-            ptr[1] = erhe::dataformat::float_to_snorm8(value[1]);
-            ptr[2] = erhe::dataformat::float_to_snorm8(value[2]);
-            ptr[3] = erhe::dataformat::float_to_snorm8(value[3]);
-            break;
-        }
-        case erhe::dataformat::Format::format_16_vec4_unorm: {
-            auto* const ptr = reinterpret_cast<uint16_t*>(destination.data());
-            ptr[0] = erhe::dataformat::float_to_unorm16(value[0]);
-            ptr[1] = erhe::dataformat::float_to_unorm16(value[1]);
-            ptr[2] = erhe::dataformat::float_to_unorm16(value[2]);
-            ptr[3] = erhe::dataformat::float_to_unorm16(value[3]);
-            break;
-        }
-        case erhe::dataformat::Format::format_16_vec4_snorm: {
-            auto* const ptr = reinterpret_cast<int16_t*>(destination.data());
-            ptr[0] = erhe::dataformat::float_to_snorm16(value[0]);
-            ptr[1] = erhe::dataformat::float_to_snorm16(value[1]);
-            ptr[2] = erhe::dataformat::float_to_snorm16(value[2]);
-            ptr[3] = erhe::dataformat::float_to_snorm16(value[3]);
-            break;
-        }
-        default: {
-            ERHE_FATAL("unsupported attribute type");
-            break;
-        }
-    }
-}
-
 inline void write_low(const std::span<std::uint8_t> destination, const erhe::dataformat::Format format, const glm::uvec2 value)
 {
     switch (format) {
@@ -504,14 +370,35 @@ Vertex_buffer_writer::Vertex_buffer_writer(Build_context& build_context, Buffer_
     , stride       {stride}
 {
     const auto& vertex_buffer_range = build_context.root.buffer_mesh.vertex_buffer_ranges[stream];
-    vertex_data.resize(vertex_buffer_range.count * vertex_buffer_range.element_size);
-    vertex_data_span = vertex_data;
+    const std::size_t byte_count = vertex_buffer_range.count * vertex_buffer_range.element_size;
+    sink_write_span = buffer_sink.begin_vertex_data(stream, vertex_buffer_range.byte_offset, byte_count);
+    if ((byte_count > 0) && (sink_write_span.span.size() == byte_count)) {
+        vertex_data_span = sink_write_span.span;
+        std::fill(vertex_data_span.begin(), vertex_data_span.end(), std::uint8_t{0});
+    } else {
+        vertex_data.resize(byte_count);
+        vertex_data_span = vertex_data;
+    }
     ERHE_VERIFY(vertex_buffer_range.element_size == stride);
 }
 
+Vertex_buffer_writer::Vertex_buffer_writer(Build_context& build_context, const Vertex_buffer_writer& parent, const std::size_t first_vertex)
+    : build_context      {build_context}
+    , buffer_sink        {parent.buffer_sink}
+    , stream             {parent.stream}
+    , stride             {parent.stride}
+    , buffer_range       {parent.buffer_range}
+    , vertex_data_span   {parent.vertex_data_span}
+    , vertex_write_offset{first_vertex * parent.stride}
+    , shares_parent_data {true}
+{
+}
+
 Vertex_buffer_writer::~Vertex_buffer_writer() noexcept
 {
-    buffer_sink.buffer_ready(*this);
+    if (!shares_parent_data) {
+        buffer_sink.buffer_ready(*this);
+    }
 }
 
 auto Vertex_buffer_writer::start_offset() -> std::size_t
@@ -528,8 +415,15 @@ Index_buffer_writer::Index_buffer_writer(Build_context& build_context, Buffer_si
     const auto& buffer_mesh        = build_context.root.buffer_mesh;
     const auto& index_buffer_range = buffer_mesh.index_buffer_range;
     const auto& mesh_info          = build_context.root.mesh_info;
-    index_data.resize(index_buffer_range.count * index_type_size);
-    index_data_span = index_data;
+    const std::size_t byte_count = index_buffer_range.count * index_type_size;
+    sink_write_span = buffer_sink.begin_index_data(index_buffer_range.byte_offset, byte_count);
+    if ((byte_count > 0) && (sink_write_span.span.size() == byte_count)) {
+        index_data_span = sink_write_span.span;
+        std::fill(index_data_span.begin(), index_data_span.end(), std::uint8_t{0});
+    } else {
+        index_data.resize(byte_count);
+        index_data_span = index_data;
+    }
 
     const auto& primitive_types = build_context.root.build_info.primitive_types;
 
@@ -559,9 +453,26 @@ Index_buffer_writer::Index_buffer_writer(Build_context& build_context, Buffer_si
     }
 }
 
+Index_buffer_writer::Index_buffer_writer(Build_context& build_context, const Index_buffer_writer& parent)
+    : build_context                   {build_context}
+    , buffer_sink                     {parent.buffer_sink}
+    , buffer_range                    {parent.buffer_range}
+    , index_type                      {parent.index_type}
+    , index_type_size                 {parent.index_type_size}
+    , index_data_span                 {parent.index_data_span}
+    , corner_point_index_data_span    {parent.corner_point_index_data_span}
+    , triangle_fill_index_data_span   {parent.triangle_fill_index_data_span}
+    , edge_line_index_data_span       {parent.edge_line_index_data_span}
+    , polygon_centroid_index_data_span{parent.polygon_centroid_index_data_span}
+    , shares_parent_data              {true}
+{
+}
+
 Index_buffer_writer::~Index_buffer_writer() noexcept
 {
-    buffer_sink.buffer_ready(*this);
+    if (!shares_parent_data) {
+        buffer_sink.buffer_ready(*this);
+    }
 }
 
 auto Index_buffer_writer::start_offset() -> std::size_t
@@ -577,29 +488,17 @@ void Vertex_buffer_writer::write(const Vertex_attribute_info& attribute, const G
 
 void Vertex_buffer_writer::write(const Vertex_attribute_info& attribute, const GEO::vec2f value)
 {
-    write_low2(
-        vertex_data_span.subspan(vertex_write_offset + attribute.offset, attribute.size),
-        attribute.format,
-        value.data()
-    );
+    write_float(attribute, value.data(), 2);
 }
 
 void Vertex_buffer_writer::write(const Vertex_attribute_info& attribute, const GEO::vec3f value)
 {
-    write_low3(
-        vertex_data_span.subspan(vertex_write_offset + attribute.offset, attribute.size),
-        attribute.format,
-        value.data()
-    );
+    write_float(attribute, value.data(), 3);
 }
 
 void Vertex_buffer_writer::write(const Vertex_attribute_info& attribute, const GEO::vec4f value)
 {
-    write_low4(
-        vertex_data_span.subspan(vertex_write_offset + attribute.offset, attribute.size),
-        attribute.format,
-        value.data()
-    );
+    write_float(attribute, value.data(), 4);
 }
 
 void Vertex_buffer_writer::write(const Vertex_attribute_info& attribute, const GEO::vec2u value)
@@ -658,29 +557,17 @@ void Vertex_buffer_writer::write(const Vertex_attribute_info& attribute, const G
 
 void Vertex_buffer_writer::write(const Vertex_attribute_info& attribute, const glm::vec2 value)
 {
-    write_low2(
-        vertex_data_span.subspan(vertex_write_offset + attribute.offset, attribute.size),
-        attribute.format,
-        &value.x
-    );
+    write_float(attribute, &value.x, 2);
 }
 
 void Vertex_buffer_writer::write(const Vertex_attribute_info& attribute, const glm::vec3 value)
 {
-    write_low3(
-        vertex_data_span.subspan(vertex_write_offset + attribute.offset, attribute.size),
-        attribute.format,
-        &value.x
-    );
+    write_float(attribute, &value.x, 3);
 }
 
 void Vertex_buffer_writer::write(const Vertex_attribute_info& attribute, const glm::vec4 value)
 {
-    write_low4(
-        vertex_data_span.subspan(vertex_write_offset + attribute.offset, attribute.size),
-        attribute.format,
-        &value.x
-    );
+    write_float(attribute, &value.x, 4);
 }
 
 void Vertex_buffer_writer::write(const Vertex_attribute_info& attribute, const uint32_t value)
@@ -710,6 +597,14 @@ void Vertex_buffer_writer::write(const Vertex_attribute_info& attribute, const g
     );
 }
 
+void Vertex_buffer_writer::write_float(const Vertex_attribute_info& attribute, const float* value, const std::size_t component_count)
+{
+    if ((attribute.pack_float == nullptr) || (attribute.component_count != component_count)) {
+        ERHE_FATAL("unsupported attribute type");
+    }
+    attribute.pack_float(value, vertex_data_span.data() + vertex_write_offset + attribute.offset);
+}
+
 void Vertex_buffer_writer::move(const std::size_t relative_offset)
 {
     vertex_write_offset += relative_offset;
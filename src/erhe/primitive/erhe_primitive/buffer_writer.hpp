@@ -1,6 +1,7 @@
 #pragma once
 
 #include "erhe_primitive/buffer_range.hpp"
+#include "erhe_primitive/buffer_sink.hpp"
 #include "erhe_primitive/vertex_attribute_info.hpp"
 #include "erhe_dataformat/dataformat.hpp"
 
@@ -8,6 +9,7 @@
 
 #include <glm/glm.hpp>
 
+#include <cstring>
 #include <span>
 #include <vector>
 
@@ -30,6 +32,10 @@ class Vertex_buffer_writer
 {
 public:
     Vertex_buffer_writer(Build_context& build_context, Buffer_sink& buffer_sink, std::size_t stream, std::size_t stride);
+
+    // Writes to the same destination as parent, starting at first_vertex. Used to
+    // fill disjoint vertex ranges from worker threads; parent remains the owner.
+    Vertex_buffer_writer(Build_context& build_context, const Vertex_buffer_writer& parent, std::size_t first_vertex);
     Vertex_buffer_writer(const Vertex_buffer_writer&) = delete;
     Vertex_buffer_writer& operator=(const Vertex_buffer_writer&) = delete;
     Vertex_buffer_writer(Vertex_buffer_writer&&) = delete;
@@ -54,6 +60,17 @@ public:
     void write(const Vertex_attribute_info& attribute, const uint32_t value);
     void write(const Vertex_attribute_info& attribute, const glm::uvec2 value);
     void write(const Vertex_attribute_info& attribute, const glm::uvec4 value);
+
+    // Packs component_count floats with the format specific function resolved in attribute
+    void write_float(const Vertex_attribute_info& attribute, const float* value, std::size_t component_count);
+
+    // Plain store, only for format_32_vecN_float attributes (checked by caller, once per build)
+    template <std::size_t N>
+    void write_float32(const Vertex_attribute_info& attribute, const float* value)
+    {
+        std::memcpy(vertex_data_span.data() + vertex_write_offset + attribute.offset, value, N * sizeof(float));
+    }
+
     void move (const std::size_t relative_offset);
     void next_vertex();
 
@@ -64,9 +81,11 @@ public:
     std::size_t               stream;
     std::size_t               stride;
     Buffer_range              buffer_range;
-    std::vector<std::uint8_t> vertex_data;
+    Sink_write_span           sink_write_span;
+    std::vector<std::uint8_t> vertex_data; // only used when buffer_sink does not provide sink_write_span
     std::span<std::uint8_t>   vertex_data_span;
     std::size_t               vertex_write_offset{0};
+    bool                      shares_parent_data {false};
 };
 
 /// Writes 8/16/32 -bit indices to byte buffer/memory
@@ -76,6 +95,9 @@ class Index_buffer_writer
 {
 public:
     Index_buffer_writer(Build_context& build_context, Buffer_sink& buffer_sink);
+
+    // Writes to the same destination as parent; caller positions the *_indices_written counters
+    Index_buffer_writer(Build_context& build_context, const Index_buffer_writer& parent);
     virtual ~Index_buffer_writer() noexcept;
 
     void write_corner  (const uint32_t v0);
@@ -91,7 +113,8 @@ public:
     Buffer_range                   buffer_range;
     const erhe::dataformat::Format index_type;
     const std::size_t              index_type_size{0};
-    std::vector<std::uint8_t>      index_data;
+    Sink_write_span                sink_write_span;
+    std::vector<std::uint8_t>      index_data; // only used when buffer_sink does not provide sink_write_span
     std::span<std::uint8_t>        index_data_span;
     std::span<std::uint8_t>        corner_point_index_data_span;
     std::span<std::uint8_t>        triangle_fill_index_data_span;
@@ -102,6 +125,7 @@ public:
     std::size_t triangle_indices_written        {0};
     std::size_t edge_line_indices_written       {0};
     std::size_t polygon_centroid_indices_written{0};
+    bool        shares_parent_data              {false};
 };
 
 } // namespace erhe::primitive
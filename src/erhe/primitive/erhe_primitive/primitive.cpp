@@ -109,6 +109,18 @@ auto Primitive_raytrace::has_raytrace_triangles() const -> bool
         m_rt_mesh.index_range(Primitive_mode::polygon_fill).index_count > 0;
 }
 
+auto Primitive_raytrace::get_memory_usage() const -> std::size_t
+{
+    std::size_t byte_count = 0;
+    if (m_rt_vertex_buffer) {
+        byte_count += m_rt_vertex_buffer->capacity_byte_count();
+    }
+    if (m_rt_index_buffer) {
+        byte_count += m_rt_index_buffer->capacity_byte_count();
+    }
+    return byte_count;
+}
+
 void Primitive_raytrace::make_raytrace_geometry()
 {
     m_rt_geometry = erhe::raytrace::IGeometry::create_unique("rt_geometry", erhe::raytrace::Geometry_type::GEOMETRY_TYPE_TRIANGLE);
@@ -312,6 +324,17 @@ auto Primitive_shape::make_raytrace(const GEO::Mesh& mesh) -> bool
     return m_raytrace.has_raytrace_triangles();
 }
 
+auto Primitive_shape::make_raytrace(Triangle_soup& triangle_soup) -> bool
+{
+    m_raytrace = Primitive_raytrace{triangle_soup};
+    return m_raytrace.has_raytrace_triangles();
+}
+
+void Primitive_shape::release_raytrace()
+{
+    m_raytrace = Primitive_raytrace{};
+}
+
 auto Primitive_shape::make_raytrace() -> bool
 {
     // Ensure geometry and element mappings exists
@@ -456,17 +479,20 @@ auto build_buffer_mesh_from_triangle_soup(const Triangle_soup& triangle_soup, co
             uint8_t* sink_attribute_base = sink_vertex_data_base + sink_attribute.offset;
             if (src.attribute != nullptr) {
                 const uint8_t* src_attribute_base = src_vertex_data_base + src.attribute->offset;
-                for (std::size_t vertex_index = 0; vertex_index < vertex_count; ++vertex_index) {
-                    uint8_t* sink = sink_attribute_base + vertex_index * sink_stream.stride;
-                    const uint8_t* src_data = src_attribute_base + vertex_index * source_vertex_stride;
-                    erhe::dataformat::convert(src_data, src.attribute->format, sink, sink_attribute.format, 1.0f);
-                }
+                erhe::dataformat::convert(
+                    src_attribute_base, src.attribute->format,  source_vertex_stride,
+                    sink_attribute_base, sink_attribute.format, sink_stream.stride,
+                    vertex_count,
+                    1.0f
+                );
             } else {
-                const float src_data[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
-                for (std::size_t vertex_index = 0; vertex_index < vertex_count; ++vertex_index) {
-                    uint8_t* sink = sink_attribute_base + vertex_index * sink_stream.stride;
-                    erhe::dataformat::convert(src_data, erhe::dataformat::Format::format_32_vec4_float, sink, sink_attribute.format, 1.0f);
-                }
+                // Attributes missing from source are zero filled
+                erhe::dataformat::convert(
+                    nullptr,             erhe::dataformat::Format::format_32_vec4_float, 0,
+                    sink_attribute_base, sink_attribute.format,                          sink_stream.stride,
+                    vertex_count,
+                    1.0f
+                );
             }
         }
         buffer_info.buffer_sink.enqueue_vertex_data(stream_index, buffer_mesh.vertex_buffer_ranges[stream_index].byte_offset, std::move(sink_vertex_data));
@@ -475,12 +501,15 @@ auto build_buffer_mesh_from_triangle_soup(const Triangle_soup& triangle_soup, co
     const erhe::dataformat::Attribute_stream position = triangle_soup.vertex_format.find_attribute(erhe::dataformat::Vertex_attribute_usage::position);
     erhe::math::Point_vector_bounding_volume_source positions{vertex_count};
     if (position.attribute != nullptr) {
+        std::vector<float> pos(vertex_count * 3);
+        erhe::dataformat::convert(
+            triangle_soup.vertex_data.data() + position.attribute->offset, position.attribute->format, position.stream->stride,
+            pos.data(), erhe::dataformat::Format::format_32_vec3_float, 3 * sizeof(float),
+            vertex_count,
+            1.0f
+        );
         for (std::size_t vertex_index = 0; vertex_index < vertex_count; ++vertex_index) {
-            const uint8_t* src_vertex_data_base = triangle_soup.vertex_data.data();
-            const uint8_t* src = src_vertex_data_base + position.attribute->offset + vertex_index * position.stream->stride;
-            float pos[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
-            erhe::dataformat::convert(src, position.attribute->format, &pos[0], erhe::dataformat::Format::format_32_vec4_float, 1.0f);
-            positions.add(pos[0], pos[1], pos[2]);
+            positions.add(pos[3 * vertex_index + 0], pos[3 * vertex_index + 1], pos[3 * vertex_index + 2]);
         }
     }
     erhe::math::calculate_bounding_volume(positions, buffer_mesh.bounding_box, buffer_mesh.bounding_sphere);
@@ -501,6 +530,15 @@ auto Primitive_shape::get_element_mappings() const -> const Element_mappings&
     return m_element_mappings;
 }
 
+auto Primitive_shape::get_memory_usage() const -> std::size_t
+{
+    return
+        m_element_mappings.triangle_to_mesh_facet            .capacity() * sizeof(uint32_t) +
+        m_element_mappings.mesh_corner_to_vertex_buffer_index.capacity() * sizeof(uint32_t) +
+        m_element_mappings.mesh_vertex_to_vertex_buffer_index.capacity() * sizeof(uint32_t) +
+        m_raytrace.get_memory_usage();
+}
+
 /////////////////////////
 
 
@@ -42,6 +42,9 @@ public:
     auto has_raytrace_triangles() const -> bool;
     void make_raytrace_geometry();
 
+    // CPU side vertex and index buffer bytes (excludes raytrace acceleration structures)
+    [[nodiscard]] auto get_memory_usage     () const -> std::size_t;
+
     [[nodiscard]] auto get_raytrace_mesh    () const -> const Buffer_mesh&;
     [[nodiscard]] auto get_raytrace_geometry() const -> const std::shared_ptr<erhe::raytrace::IGeometry>&;
 
@@ -67,6 +70,15 @@ public:
     auto make_geometry() -> bool;
     auto make_raytrace() -> bool;
     auto make_raytrace(const GEO::Mesh& mesh) -> bool;
+
+    // Builds raytrace buffers directly from indexed triangles, without going
+    // through a GEO::Mesh. Triangles must be in the same order as the fill
+    // triangles of the renderable mesh for triangle to facet mapping to work.
+    auto make_raytrace(Triangle_soup& triangle_soup) -> bool;
+
+    // Drops raytrace data; it can be rebuilt from geometry with make_raytrace()
+    void release_raytrace();
+
     [[nodiscard]] auto has_raytrace_triangles      () const -> bool;
     [[nodiscard]] auto get_geometry                () -> const std::shared_ptr<erhe::geometry::Geometry>&;
     [[nodiscard]] auto get_geometry_const          () const -> const std::shared_ptr<erhe::geometry::Geometry>&;
@@ -76,6 +88,9 @@ public:
     [[nodiscard]] auto get_element_mappings        () const -> const erhe::primitive::Element_mappings&;
     [[nodiscard]] auto get_mesh_facet_from_triangle(const uint32_t triangle) const -> GEO::index_t;
 
+    // CPU side bytes held by element mappings and raytrace buffers. Geometry is not included.
+    [[nodiscard]] auto get_memory_usage            () const -> std::size_t;
+
 protected:
     // Keep this before members - at least m_renderable_mesh - which initialization
     // in constructors uses m_element_mappings.
@@ -13,8 +13,20 @@
 #include "erhe_profile/profile.hpp"
 #include "erhe_verify/verify.hpp"
 
+#include <taskflow/taskflow.hpp>
+
+#include <algorithm>
+#include <functional>
+
 namespace erhe::primitive {
 
+namespace {
+
+// Packed (non float32) attribute values are converted in batches of this many vertices
+constexpr std::size_t c_max_staged_vertex_count = 4096;
+
+} // anonymous namespace
+
 Build_context_root::Build_context_root(
     Buffer_mesh&      buffer_mesh,
     const GEO::Mesh&  mesh,
@@ -227,6 +239,28 @@ Build_context::Build_context(
         );
     }
 
+    init_attribute_writers();
+
+    root.calculate_bounding_volume();
+}
+
+Build_context::Build_context(Build_context& parent, const std::size_t first_vertex)
+    : root           {parent.root}
+    , normal_style   {parent.normal_style}
+    , index_writer   {*this, parent.index_writer}
+    , mesh_attributes{parent.root.mesh}
+    , is_worker      {true}
+{
+    for (const std::unique_ptr<Vertex_buffer_writer>& parent_writer : parent.vertex_writers) {
+        vertex_writers.push_back(std::make_unique<Vertex_buffer_writer>(*this, *parent_writer.get(), first_vertex));
+    }
+    vertex_buffer_index = static_cast<uint32_t>(first_vertex);
+
+    init_attribute_writers();
+}
+
+void Build_context::init_attribute_writers()
+{
     using namespace erhe::dataformat;
     attribute_writers.position           = get_attribute_writer(Vertex_attribute_usage::position);
     attribute_writers.normal             = get_attribute_writer(Vertex_attribute_usage::normal);
@@ -239,13 +273,13 @@ Build_context::Build_context(
     attribute_writers.id                 = get_attribute_writer(Vertex_attribute_usage::custom, custom_attribute_id);
     attribute_writers.aniso_control      = get_attribute_writer(Vertex_attribute_usage::custom, custom_attribute_aniso_control);
     attribute_writers.valency_edge_count = get_attribute_writer(Vertex_attribute_usage::custom, custom_attribute_valency_edge_count);
-
-    root.calculate_bounding_volume();
 }
 
 Build_context::~Build_context() noexcept
 {
-    ERHE_VERIFY(vertex_buffer_index == root.total_vertex_count);
+    if (!is_worker) {
+        ERHE_VERIFY(vertex_buffer_index == root.total_vertex_count);
+    }
 }
 
 void Build_context::build_polygon_id()
@@ -260,6 +294,72 @@ void Build_context::build_polygon_id()
     attribute_writers.id->write(root.vertex_attributes.id_vec3, id_vec3);
 }
 
+template <bool Float32, std::size_t N>
+void Build_context::write_vertex_float(Vertex_buffer_writer* writer, const Vertex_attribute_info& attribute, const float* value)
+{
+    if constexpr (Float32) {
+        writer->write_float32<N>(attribute, value);
+    } else {
+        stage_vertex_float(writer, attribute, value, N);
+    }
+}
+
+void Build_context::stage_vertex_float(
+    Vertex_buffer_writer*        writer,
+    const Vertex_attribute_info& attribute,
+    const float*                 value,
+    const std::size_t            component_count
+)
+{
+    // Only a handful of attributes are staged at a time
+    Staged_attribute* staged = nullptr;
+    for (Staged_attribute& entry : staged_attributes) {
+        if (entry.attribute == &attribute) {
+            staged = &entry;
+            break;
+        }
+    }
+    if (staged == nullptr) {
+        if ((attribute.pack_float == nullptr) || (attribute.component_count != component_count)) {
+            ERHE_FATAL("unsupported attribute type");
+        }
+        staged = &staged_attributes.emplace_back();
+        staged->writer          = writer;
+        staged->attribute       = &attribute;
+        staged->component_count = component_count;
+        staged->first_offset    = writer->vertex_write_offset;
+        staged->values.reserve(c_max_staged_vertex_count * component_count);
+    }
+    staged->values.insert(staged->values.end(), value, value + component_count);
+}
+
+void Build_context::flush_staged_attributes()
+{
+    using erhe::dataformat::Format;
+    for (Staged_attribute& staged : staged_attributes) {
+        const std::size_t count = staged.values.size() / staged.component_count;
+        ERHE_VERIFY(count == staged_vertex_count);
+        const Format source_format =
+            (staged.component_count == 1) ? Format::format_32_scalar_float :
+            (staged.component_count == 2) ? Format::format_32_vec2_float   :
+            (staged.component_count == 3) ? Format::format_32_vec3_float   :
+                                            Format::format_32_vec4_float;
+        erhe::dataformat::convert(
+            staged.values.data(),
+            source_format,
+            staged.component_count * sizeof(float),
+            staged.writer->vertex_data_span.data() + staged.first_offset + staged.attribute->offset,
+            staged.attribute->format,
+            staged.writer->stride,
+            count,
+            1.0f
+        );
+    }
+    staged_attributes.clear();
+    staged_vertex_count = 0;
+}
+
+template <bool Float32>
 void Build_context::build_vertex_position()
 {
     ERHE_PROFILE_FUNCTION();
@@ -267,7 +367,7 @@ void Build_context::build_vertex_position()
     v_position = get_pointf(root.mesh.vertices, mesh_vertex);
 
     ERHE_VERIFY(std::isfinite(v_position.x) && std::isfinite(v_position.y) && std::isfinite(v_position.z));
-    attribute_writers.position->write(root.vertex_attributes.position, v_position);
+    write_vertex_float<Float32, 3>(attribute_writers.position, root.vertex_attributes.position, v_position.data());
 
     SPDLOG_LOGGER_TRACE(
         log_primitive_builder,
@@ -373,6 +473,7 @@ void Build_context::build_tangent_frame()
 
 /////////////////////////////
 
+template <bool Float32>
 void Build_context::build_vertex_normal(bool do_normal, bool do_normal_smooth)
 {
     ERHE_PROFILE_FUNCTION();
@@ -382,7 +483,7 @@ void Build_context::build_vertex_normal(bool do_normal, bool do_normal_smooth)
     /// }
 
     if (do_normal) {
-        attribute_writers.normal->write(root.vertex_attributes.normal, to_glm_vec3(v_normal));
+        write_vertex_float<Float32, 3>(attribute_writers.normal, root.vertex_attributes.normal, v_normal.data());
     }
 
     // if (features.normal_flat && root.attributes.normal_flat.is_valid()) {
@@ -395,7 +496,7 @@ void Build_context::build_vertex_normal(bool do_normal, bool do_normal_smooth)
     
         std::optional<GEO::vec3f> smooth_vertex_normal = mesh_attributes.vertex_normal_smooth.try_get(mesh_vertex);
         if (smooth_vertex_normal.has_value()) {
-            attribute_writers.normal->write(root.vertex_attributes.normal_smooth, to_glm_vec3(smooth_vertex_normal.value()));
+            write_vertex_float<Float32, 3>(attribute_writers.normal, root.vertex_attributes.normal_smooth, smooth_vertex_normal.value().data());
         } else {
             // Smooth normals are currently used only for wide line depth bias.
             // If edge lines are not used, do not generate warning about missing smooth normals.
@@ -404,21 +505,24 @@ void Build_context::build_vertex_normal(bool do_normal, bool do_normal_smooth)
                 used_fallback_smooth_normal = true;
             }
             const GEO::vec3f fallback_vertex_normal_smooth{0.0f, 1.0f, 0.0f};
-            attribute_writers.normal->write(root.vertex_attributes.normal_smooth, fallback_vertex_normal_smooth);
+            write_vertex_float<Float32, 3>(attribute_writers.normal, root.vertex_attributes.normal_smooth, fallback_vertex_normal_smooth.data());
         }
     }
 }
 
+template <bool Float32>
 void Build_context::build_vertex_tangent()
 {
-    attribute_writers.tangent->write(root.vertex_attributes.tangent, to_glm_vec4(v_tangent));
+    write_vertex_float<Float32, 4>(attribute_writers.tangent, root.vertex_attributes.tangent, v_tangent.data());
 }
 
+template <bool Float32>
 void Build_context::build_vertex_bitangent()
 {
-    attribute_writers.bitangent->write(root.vertex_attributes.bitangent, to_glm_vec3(v_bitangent));
+    write_vertex_float<Float32, 3>(attribute_writers.bitangent, root.vertex_attributes.bitangent, v_bitangent.data());
 }
 
+template <bool Float32>
 void Build_context::build_vertex_texcoord(size_t usage_index)
 {
     std::optional<GEO::vec2f> corner_texcoord = mesh_attributes.corner_texcoord(usage_index).try_get(mesh_corner);
@@ -428,7 +532,7 @@ void Build_context::build_vertex_texcoord(size_t usage_index)
         corner_texcoord.has_value() ? corner_texcoord.value() :
         vertex_texcoord.has_value() ? vertex_texcoord.value() : GEO::vec2f{0.0f, 0.0f};
 
-    attribute_writers.texcoord_0->write(root.vertex_attributes.texcoord[usage_index], texcoord);
+    write_vertex_float<Float32, 2>(attribute_writers.texcoord_0, root.vertex_attributes.texcoord[usage_index], texcoord.data());
 }
 
 void Build_context::build_vertex_joint_indices(size_t usage_index)
@@ -445,6 +549,7 @@ void Build_context::build_vertex_joint_weights(size_t usage_index)
     attribute_writers.joint_weights_0->write(root.vertex_attributes.joint_weights[usage_index], joint_weights);
 }
 
+template <bool Float32>
 void Build_context::build_vertex_color(size_t usage_index)
 {
     const std::optional<GEO::vec4f> corner_color = mesh_attributes.corner_color(usage_index).try_get(mesh_corner);
@@ -456,7 +561,7 @@ void Build_context::build_vertex_color(size_t usage_index)
         facet_color .has_value() ? facet_color .value() :
         vertex_color.has_value() ? vertex_color.value() : root.build_info.constant_color;
 
-    attribute_writers.color_0->write(root.vertex_attributes.color[usage_index], color);
+    write_vertex_float<Float32, 4>(attribute_writers.color_0, root.vertex_attributes.color[usage_index], color.data());
 }
 
 void Build_context::build_vertex_aniso_control()
@@ -548,49 +653,127 @@ auto Build_context::is_ready() const -> bool
     return false;
 }
 
-void Build_context::build_polygon_fill()
+namespace {
+
+class Fill_feature
 {
-    ERHE_PROFILE_FUNCTION();
+public:
+    // Part of the build_polygon_fill_corners() template key
+    static constexpr uint32_t c_polygon_id       = (1u << 0);
+    static constexpr uint32_t c_tangent_frame    = (1u << 1);
+    static constexpr uint32_t c_position         = (1u << 2);
+    static constexpr uint32_t c_normal           = (1u << 3);
+    static constexpr uint32_t c_normal_smooth    = (1u << 4);
+    static constexpr uint32_t c_tangent          = (1u << 5);
+    static constexpr uint32_t c_bitangent        = (1u << 6);
+    static constexpr uint32_t c_texcoord_0       = (1u << 7);
+    static constexpr uint32_t c_color_0          = (1u << 8);
+    static constexpr uint32_t c_float32          = (1u << 9); // all of the above attributes are format_32_vecN_float
+    static constexpr uint32_t c_static_mask      = (1u << 10) - 1u;
+
+    // Rarely used, always tested per corner
+    static constexpr uint32_t c_texcoord_1       = (1u << 10);
+    static constexpr uint32_t c_color_1          = (1u << 11);
+    static constexpr uint32_t c_aniso_control    = (1u << 12);
+    static constexpr uint32_t c_joint_indices_0  = (1u << 13);
+    static constexpr uint32_t c_joint_indices_1  = (1u << 14);
+    static constexpr uint32_t c_joint_weights_0  = (1u << 15);
+    static constexpr uint32_t c_joint_weights_1  = (1u << 16);
+    static constexpr uint32_t c_valency          = (1u << 17);
+    static constexpr uint32_t c_corner_points    = (1u << 18);
+    static constexpr uint32_t c_runtime_mask     = ~c_static_mask;
+
+    // Fallback instantiation which tests every feature per corner
+    static constexpr uint32_t c_dynamic          = (1u << 31);
+
+    // Vertex format used by explorer and editor
+    static constexpr uint32_t c_profile_explorer =
+        c_tangent_frame | c_position | c_normal | c_normal_smooth | c_tangent | c_texcoord_0 | c_color_0 | c_float32;
+    static constexpr uint32_t c_profile_position = c_position | c_float32;
+    static constexpr uint32_t c_profile_normal   = c_tangent_frame | c_position | c_normal | c_float32;
+    static constexpr uint32_t c_profile_texcoord = c_tangent_frame | c_position | c_normal | c_texcoord_0 | c_float32;
+    static constexpr uint32_t c_profile_tangent  = c_tangent_frame | c_position | c_normal | c_tangent | c_texcoord_0 | c_float32;
+};
 
-    if (!is_ready()) {
-        return;
+[[nodiscard]] auto is_float32(const Vertex_attribute_info& attribute, const std::size_t component_count) -> bool
+{
+    using erhe::dataformat::Format;
+    switch (component_count) {
+        case 2: return attribute.format == Format::format_32_vec2_float;
+        case 3: return attribute.format == Format::format_32_vec3_float;
+        case 4: return attribute.format == Format::format_32_vec4_float;
+        default: return false;
     }
+}
 
-    // TODO mesh_attributes.corner_indices needs to be setup
-    //      also if edge lines are wanted.
+} // anonymous namespace
 
-    vertex_buffer_index = 0;
+auto Build_context::get_polygon_fill_features() -> uint32_t
+{
+    const Vertex_attributes& attributes = root.vertex_attributes;
 
-    //const bool any_normal_feature = root.build_info.format.features.normal =
-    //    root.build_info.format.features.normal      ||
-    //    root.build_info.format.features.normal_flat ||
-    //    root.build_info.format.features.normal_smooth;
+    uint32_t features = 0;
+    const auto add = [&features](const bool enable, const uint32_t bit) {
+        if (enable) {
+            features = features | bit;
+        }
+    };
+    add(attributes.id_vec3           .is_valid(), Fill_feature::c_polygon_id);
+    add(attributes.position          .is_valid(), Fill_feature::c_position);
+    add(attributes.normal            .is_valid(), Fill_feature::c_normal);
+    add(attributes.normal_smooth     .is_valid(), Fill_feature::c_normal_smooth);
+    add(attributes.tangent           .is_valid(), Fill_feature::c_tangent);
+    add(attributes.bitangent         .is_valid(), Fill_feature::c_bitangent);
+    add(attributes.texcoord[0]       .is_valid(), Fill_feature::c_texcoord_0);
+    add(attributes.color[0]          .is_valid(), Fill_feature::c_color_0);
+    add(attributes.texcoord[1]       .is_valid(), Fill_feature::c_texcoord_1);
+    add(attributes.color[1]          .is_valid(), Fill_feature::c_color_1);
+    add(attributes.aniso_control     .is_valid(), Fill_feature::c_aniso_control);
+    add(attributes.joint_indices[0]  .is_valid(), Fill_feature::c_joint_indices_0);
+    add(attributes.joint_indices[1]  .is_valid(), Fill_feature::c_joint_indices_1);
+    add(attributes.joint_weights[0]  .is_valid(), Fill_feature::c_joint_weights_0);
+    add(attributes.joint_weights[1]  .is_valid(), Fill_feature::c_joint_weights_1);
+    add(attributes.valency_edge_count.is_valid(), Fill_feature::c_valency);
+    add(root.build_info.primitive_types.corner_points, Fill_feature::c_corner_points);
+    add(
+        (features & (Fill_feature::c_normal | Fill_feature::c_normal_smooth | Fill_feature::c_tangent | Fill_feature::c_bitangent)) != 0,
+        Fill_feature::c_tangent_frame
+    );
 
-    //const Polygon_id polygon_id_end = root.geometry.get_polygon_count();
-    root.element_mappings.mesh_corner_to_vertex_buffer_index.resize(root.mesh.facet_corners.nb());
-    root.element_mappings.mesh_vertex_to_vertex_buffer_index.resize(root.mesh.vertices.nb());
+    const bool float32 =
+        (((features & Fill_feature::c_position     ) == 0) || is_float32(attributes.position,      3)) &&
+        (((features & Fill_feature::c_normal       ) == 0) || is_float32(attributes.normal,        3)) &&
+        (((features & Fill_feature::c_normal_smooth) == 0) || is_float32(attributes.normal_smooth, 3)) &&
+        (((features & Fill_feature::c_tangent      ) == 0) || is_float32(attributes.tangent,       4)) &&
+        (((features & Fill_feature::c_bitangent    ) == 0) || is_float32(attributes.bitangent,     3)) &&
+        (((features & Fill_feature::c_texcoord_0   ) == 0) || is_float32(attributes.texcoord[0],   2)) &&
+        (((features & Fill_feature::c_color_0      ) == 0) || is_float32(attributes.color[0],      4));
+    add(float32, Fill_feature::c_float32);
+    return features;
+}
+
+// Per corner kernel. Features is either a static feature set, for which all
+// static feature tests and attribute format choices are resolved at compile
+// time, or Fill_feature::c_dynamic, which tests everything at runtime.
+template <uint32_t Features>
+void Build_context::build_polygon_fill_corners(
+    const uint32_t     dynamic_features,
+    const GEO::index_t facet_begin,
+    const GEO::index_t facet_end
+)
+{
+    constexpr bool is_dynamic = (Features == Fill_feature::c_dynamic);
+    constexpr bool float32    = !is_dynamic && ((Features & Fill_feature::c_float32) != 0);
+
+    // For static instantiations the static bits are compile time constants
+    const uint32_t features = is_dynamic
+        ? dynamic_features
+        : (Features | (dynamic_features & Fill_feature::c_runtime_mask));
 
-    const bool do_polygon_id           = root.vertex_attributes.id_vec3           .is_valid();
-    const bool do_vertex_position      = root.vertex_attributes.position          .is_valid();
-    const bool do_vertex_normal        = root.vertex_attributes.normal            .is_valid();
-    const bool do_vertex_normal_smooth = root.vertex_attributes.normal_smooth     .is_valid();
-    const bool do_vertex_normal_either = do_vertex_normal || do_vertex_normal_smooth;
-    const bool do_vertex_tangent       = root.vertex_attributes.tangent           .is_valid();
-    const bool do_vertex_bitangent     = root.vertex_attributes.bitangent         .is_valid();
-    const bool do_vertex_texcoord_0    = root.vertex_attributes.texcoord[0]       .is_valid();
-    const bool do_vertex_texcoord_1    = root.vertex_attributes.texcoord[1]       .is_valid();
-    const bool do_vertex_color_0       = root.vertex_attributes.color[0]          .is_valid();
-    const bool do_vertex_color_1       = root.vertex_attributes.color[1]          .is_valid();
-    const bool do_aniso_control        = root.vertex_attributes.aniso_control     .is_valid();
-    const bool do_joint_indices_0      = root.vertex_attributes.joint_indices[0]  .is_valid();
-    const bool do_joint_indices_1      = root.vertex_attributes.joint_indices[1]  .is_valid();
-    const bool do_joint_weights_0      = root.vertex_attributes.joint_weights[0]  .is_valid();
-    const bool do_joint_weights_1      = root.vertex_attributes.joint_weights[1]  .is_valid();
-    const bool do_vertex_valency       = root.vertex_attributes.valency_edge_count.is_valid();
-    const bool do_corner_points        = root.build_info.primitive_types.corner_points;
-    const bool do_tangent_frame = do_vertex_normal_either || do_vertex_tangent || do_vertex_bitangent;
-
-    for (GEO::index_t facet : root.mesh.facets) {
+    const bool do_normal        = (features & Fill_feature::c_normal       ) != 0;
+    const bool do_normal_smooth = (features & Fill_feature::c_normal_smooth) != 0;
+
+    for (GEO::index_t facet = facet_begin; facet < facet_end; ++facet) {
         mesh_facet = facet;
         ERHE_PROFILE_SCOPE("polygon");
         first_index    = vertex_buffer_index;
@@ -598,44 +781,249 @@ void Build_context::build_polygon_fill()
 
         mesh_attributes.facet_id.set(mesh_facet, vec3_from_index(mesh_facet));
 
-        //const Polygon_corner_id polyon_corner_id_end = polygon.first_polygon_corner_id + polygon.corner_count;
         for (GEO::index_t corner : root.mesh.facets.corners(mesh_facet)) {
             mesh_corner = corner;
-            ERHE_PROFILE_SCOPE("corner");
             mesh_vertex = root.mesh.facet_corners.vertex(mesh_corner);
             ERHE_VERIFY(mesh_vertex != GEO::NO_INDEX);
 
             root.element_mappings.mesh_corner_to_vertex_buffer_index[mesh_corner] = vertex_buffer_index;
-            root.element_mappings.mesh_vertex_to_vertex_buffer_index[mesh_vertex] = vertex_buffer_index;
-
-            if (do_polygon_id          ) build_polygon_id          ();
-
-            if (do_tangent_frame       ) build_tangent_frame       ();
-            if (do_vertex_position     ) build_vertex_position     ();
-            if (do_vertex_normal_either) build_vertex_normal       (do_vertex_normal, do_vertex_normal_smooth);
-            if (do_vertex_tangent      ) build_vertex_tangent      ();
-            if (do_vertex_bitangent    ) build_vertex_bitangent    ();
-            if (do_vertex_texcoord_0   ) build_vertex_texcoord     (0);
-            if (do_vertex_texcoord_1   ) build_vertex_texcoord     (1);
-            if (do_vertex_color_0      ) build_vertex_color        (0);
-            if (do_vertex_color_1      ) build_vertex_color        (1);
-            if (do_aniso_control       ) build_vertex_aniso_control();
-            if (do_joint_indices_0     ) build_vertex_joint_indices(0);
-            if (do_joint_indices_1     ) build_vertex_joint_indices(1);
-            if (do_joint_weights_0     ) build_vertex_joint_weights(0);
-            if (do_joint_weights_1     ) build_vertex_joint_weights(1);
-            if (do_vertex_valency      ) build_valency_edge_count  ();
-
-            // Indices
-            if (do_corner_points) build_corner_point_index();
+            if (write_vertex_mappings) {
+                root.element_mappings.mesh_vertex_to_vertex_buffer_index[mesh_vertex] = vertex_buffer_index;
+            }
+
+            if ((features & Fill_feature::c_polygon_id   ) != 0) build_polygon_id                ();
+            if ((features & Fill_feature::c_tangent_frame) != 0) build_tangent_frame             ();
+            if ((features & Fill_feature::c_position     ) != 0) build_vertex_position <float32>();
+            if (do_normal || do_normal_smooth                  ) build_vertex_normal   <float32>(do_normal, do_normal_smooth);
+            if ((features & Fill_feature::c_tangent      ) != 0) build_vertex_tangent  <float32>();
+            if ((features & Fill_feature::c_bitangent    ) != 0) build_vertex_bitangent<float32>();
+            if ((features & Fill_feature::c_texcoord_0   ) != 0) build_vertex_texcoord <float32>(0);
+            if ((features & Fill_feature::c_color_0      ) != 0) build_vertex_color    <float32>(0);
+
+            if ((features & Fill_feature::c_runtime_mask) != 0) {
+                if ((features & Fill_feature::c_texcoord_1     ) != 0) build_vertex_texcoord<false>(1);
+                if ((features & Fill_feature::c_color_1        ) != 0) build_vertex_color   <false>(1);
+                if ((features & Fill_feature::c_aniso_control  ) != 0) build_vertex_aniso_control  ();
+                if ((features & Fill_feature::c_joint_indices_0) != 0) build_vertex_joint_indices  (0);
+                if ((features & Fill_feature::c_joint_indices_1) != 0) build_vertex_joint_indices  (1);
+                if ((features & Fill_feature::c_joint_weights_0) != 0) build_vertex_joint_weights  (0);
+                if ((features & Fill_feature::c_joint_weights_1) != 0) build_vertex_joint_weights  (1);
+                if ((features & Fill_feature::c_valency        ) != 0) build_valency_edge_count    ();
+
+                // Indices
+                if ((features & Fill_feature::c_corner_points  ) != 0) build_corner_point_index    ();
+            }
             build_triangle_fill_index();
 
             for (const std::unique_ptr<Vertex_buffer_writer>& vertex_writer : vertex_writers) {
                 vertex_writer->next_vertex();
             }
             ++vertex_buffer_index;
+
+            if (!staged_attributes.empty() && (++staged_vertex_count == c_max_staged_vertex_count)) {
+                flush_staged_attributes();
+            }
         }
     }
+    if (!staged_attributes.empty()) {
+        flush_staged_attributes();
+    }
+}
+
+template <uint32_t... Profiles>
+auto Build_context::dispatch_polygon_fill(
+    const uint32_t     features,
+    const GEO::index_t facet_begin,
+    const GEO::index_t facet_end
+) -> bool
+{
+    const uint32_t key = features & Fill_feature::c_static_mask;
+    return (
+        (
+            (key == Profiles)
+                ? (build_polygon_fill_corners<Profiles>(features, facet_begin, facet_end), true)
+                : false
+        ) || ...
+    );
+}
+
+void Build_context::build_polygon_fill_facets(const uint32_t features, const GEO::index_t facet_begin, const GEO::index_t facet_end)
+{
+    const bool specialized = dispatch_polygon_fill<
+        Fill_feature::c_profile_explorer,
+        Fill_feature::c_profile_position,
+        Fill_feature::c_profile_normal,
+        Fill_feature::c_profile_texcoord,
+        Fill_feature::c_profile_tangent
+    >(features, facet_begin, facet_end);
+    if (!specialized) {
+        build_polygon_fill_corners<Fill_feature::c_dynamic>(features, facet_begin, facet_end);
+    }
+}
+
+namespace {
+
+// Smaller meshes are not worth splitting
+constexpr std::size_t c_min_parallel_chunk_size = 16384;
+
+class Facet_range
+{
+public:
+    GEO::index_t facet_begin   {0};
+    GEO::index_t facet_end     {0};
+    std::size_t  first_vertex  {0}; // fill vertex (and corner point index) at facet_begin
+    std::size_t  first_triangle{0}; // fill triangle at facet_begin
+};
+
+// Prefix sum over facet corner counts; each range gets roughly corner_count / chunk_count corners
+[[nodiscard]] auto get_fill_facet_ranges(const GEO::Mesh& mesh, const std::size_t corner_count, const std::size_t chunk_count) -> std::vector<Facet_range>
+{
+    const GEO::index_t facet_count       = mesh.facets.nb();
+    const std::size_t  corners_per_chunk = (corner_count + chunk_count - 1) / chunk_count;
+
+    std::vector<Facet_range> ranges;
+    ranges.reserve(chunk_count);
+    Facet_range range{};
+    std::size_t vertex   = 0;
+    std::size_t triangle = 0;
+    for (GEO::index_t facet = 0; facet < facet_count; ++facet) {
+        const std::size_t facet_corner_count = mesh.facets.nb_vertices(facet);
+        vertex   += facet_corner_count;
+        triangle += (facet_corner_count >= 2) ? facet_corner_count - 2 : 0;
+        if (vertex - range.first_vertex >= corners_per_chunk) {
+            range.facet_end = facet + 1;
+            ranges.push_back(range);
+            range = Facet_range{
+                .facet_begin    = facet + 1,
+                .facet_end      = facet + 1,
+                .first_vertex   = vertex,
+                .first_triangle = triangle
+            };
+        }
+    }
+    if (range.facet_begin < facet_count) {
+        range.facet_end = facet_count;
+        ranges.push_back(range);
+    }
+    return ranges;
+}
+
+// Splits [0, count) to chunk_count nearly equal ranges; returns range begin, range i is [begin[i], begin[i + 1])
+[[nodiscard]] auto get_even_ranges(const std::size_t count, const std::size_t chunk_count) -> std::vector<std::size_t>
+{
+    std::vector<std::size_t> begin(chunk_count + 1);
+    for (std::size_t i = 0; i <= chunk_count; ++i) {
+        begin[i] = (count * i) / chunk_count;
+    }
+    return begin;
+}
+
+} // anonymous namespace
+
+auto Build_context::get_parallel_chunk_count(const std::size_t work_count) const -> std::size_t
+{
+    tf::Executor* executor = root.build_info.buffer_info.executor;
+    if (executor == nullptr) {
+        return 1;
+    }
+    const std::size_t max_chunk_count = 4 * executor->num_workers();
+    return std::clamp<std::size_t>(work_count / c_min_parallel_chunk_size, 1, std::max<std::size_t>(max_chunk_count, 1));
+}
+
+void Build_context::run_workers(
+    const std::vector<std::unique_ptr<Build_context>>&        workers,
+    const std::function<void(Build_context&, std::size_t)>& op
+)
+{
+    ERHE_PROFILE_FUNCTION();
+
+    tf::Executor& executor = *root.build_info.buffer_info.executor;
+    tf::Taskflow  taskflow;
+    for (std::size_t i = 0, end = workers.size(); i < end; ++i) {
+        Build_context* worker = workers[i].get();
+        taskflow.emplace([worker, i, &op]() { op(*worker, i); });
+    }
+
+    // Mesh builds may themselves run as executor tasks
+    if (executor.this_worker_id() >= 0) {
+        executor.corun(taskflow);
+    } else {
+        executor.run(taskflow).wait();
+    }
+}
+
+void Build_context::build_polygon_fill()
+{
+    ERHE_PROFILE_FUNCTION();
+
+    if (!is_ready()) {
+        return;
+    }
+
+    // TODO mesh_attributes.corner_indices needs to be setup
+    //      also if edge lines are wanted.
+
+    vertex_buffer_index = 0;
+
+    root.element_mappings.mesh_corner_to_vertex_buffer_index.resize(root.mesh.facet_corners.nb());
+    root.element_mappings.mesh_vertex_to_vertex_buffer_index.resize(root.mesh.vertices.nb());
+
+    // Select the corner kernel once per build
+    const uint32_t    features    = get_polygon_fill_features();
+    const std::size_t chunk_count = get_parallel_chunk_count(root.mesh_info.corner_count);
+    if (chunk_count <= 1) {
+        build_polygon_fill_facets(features, 0, root.mesh.facets.nb());
+    } else {
+        const std::vector<Facet_range> ranges = get_fill_facet_ranges(root.mesh, root.mesh_info.corner_count, chunk_count);
+
+        // Workers bind mesh attributes, which is not thread safe; create and destroy them here
+        std::vector<std::unique_ptr<Build_context>> workers;
+        for (const Facet_range& range : ranges) {
+            auto worker = std::make_unique<Build_context>(*this, range.first_vertex);
+            worker->primitive_index                           = static_cast<uint32_t>(range.first_triangle);
+            worker->index_writer.triangle_indices_written     = 3 * range.first_triangle;
+            worker->index_writer.corner_point_indices_written = range.first_vertex;
+            worker->write_vertex_mappings                     = false;
+            workers.push_back(std::move(worker));
+        }
+
+        run_workers(
+            workers,
+            [&ranges, features](Build_context& worker, const std::size_t i) {
+                worker.build_polygon_fill_facets(features, ranges[i].facet_begin, ranges[i].facet_end);
+            }
+        );
+
+        for (const std::unique_ptr<Build_context>& worker : workers) {
+            used_fallback_smooth_normal = used_fallback_smooth_normal || worker->used_fallback_smooth_normal;
+            used_fallback_tangent       = used_fallback_tangent       || worker->used_fallback_tangent;
+            used_fallback_bitangent     = used_fallback_bitangent     || worker->used_fallback_bitangent;
+            used_fallback_texcoord      = used_fallback_texcoord      || worker->used_fallback_texcoord;
+        }
+        const Build_context& last = *workers.back().get();
+        vertex_buffer_index                           = last.vertex_buffer_index;
+        primitive_index                               = last.primitive_index;
+        index_writer.triangle_indices_written         = last.index_writer.triangle_indices_written;
+        index_writer.corner_point_indices_written     = last.index_writer.corner_point_indices_written;
+        for (const std::unique_ptr<Vertex_buffer_writer>& vertex_writer : vertex_writers) {
+            vertex_writer->vertex_write_offset = vertex_buffer_index * vertex_writer->stride;
+        }
+
+        // Same result as the sequential build: the last corner in facet order wins
+        std::vector<uint32_t>&       vertex_to_vertex_buffer_index = root.element_mappings.mesh_vertex_to_vertex_buffer_index;
+        const std::vector<uint32_t>& corner_to_vertex_buffer_index = root.element_mappings.mesh_corner_to_vertex_buffer_index;
+        for (GEO::index_t facet : root.mesh.facets) {
+            for (GEO::index_t corner : root.mesh.facets.corners(facet)) {
+                vertex_to_vertex_buffer_index[root.mesh.facet_corners.vertex(corner)] = corner_to_vertex_buffer_index[corner];
+            }
+        }
+
+        SPDLOG_LOGGER_DEBUG(
+            log_primitive_builder,
+            "build_polygon_fill(): {} facets in {} chunks",
+            root.mesh.facets.nb(), ranges.size()
+        );
+    }
 
     if (used_fallback_smooth_normal) {
         log_primitive_builder->warn("Warning: Used fallback smooth normal");
@@ -651,17 +1039,9 @@ void Build_context::build_polygon_fill()
     }
 }
 
-void Build_context::build_edge_lines()
+void Build_context::build_edge_lines_range(const GEO::index_t edge_begin, const GEO::index_t edge_end)
 {
-    if (!is_ready()) {
-        return;
-    }
-
-    if (!root.build_info.primitive_types.edge_lines) {
-        return;
-    }
-
-    for (GEO::index_t mesh_edge : root.mesh.edges) {
+    for (GEO::index_t mesh_edge = edge_begin; mesh_edge < edge_end; ++mesh_edge) {
         const GEO::index_t mesh_vertex_a  = root.mesh.edges.vertex(mesh_edge, 0);
         const GEO::index_t mesh_vertex_b  = root.mesh.edges.vertex(mesh_edge, 1);
         const uint32_t     vertex_index_a = root.element_mappings.mesh_vertex_to_vertex_buffer_index[mesh_vertex_a];
@@ -670,17 +1050,44 @@ void Build_context::build_edge_lines()
     }
 }
 
-void Build_context::build_centroid_points()
+void Build_context::build_edge_lines()
 {
+    ERHE_PROFILE_FUNCTION();
+
     if (!is_ready()) {
         return;
     }
 
-    if (!root.build_info.primitive_types.centroid_points) {
+    if (!root.build_info.primitive_types.edge_lines) {
+        return;
+    }
+
+    const GEO::index_t edge_count  = root.mesh.edges.nb();
+    const std::size_t  chunk_count = get_parallel_chunk_count(edge_count);
+    if (chunk_count <= 1) {
+        build_edge_lines_range(0, edge_count);
         return;
     }
 
-    for (GEO::index_t facet : root.mesh.facets) {
+    const std::vector<std::size_t> begin = get_even_ranges(edge_count, chunk_count);
+    std::vector<std::unique_ptr<Build_context>> workers;
+    for (std::size_t i = 0; i < chunk_count; ++i) {
+        auto worker = std::make_unique<Build_context>(*this, vertex_buffer_index);
+        worker->index_writer.edge_line_indices_written = 2 * begin[i];
+        workers.push_back(std::move(worker));
+    }
+    run_workers(
+        workers,
+        [&begin](Build_context& worker, const std::size_t i) {
+            worker.build_edge_lines_range(static_cast<GEO::index_t>(begin[i]), static_cast<GEO::index_t>(begin[i + 1]));
+        }
+    );
+    index_writer.edge_line_indices_written = 2 * static_cast<std::size_t>(edge_count);
+}
+
+void Build_context::build_centroid_points_range(const GEO::index_t facet_begin, const GEO::index_t facet_end)
+{
+    for (GEO::index_t facet = facet_begin; facet < facet_end; ++facet) {
         mesh_facet = facet;
         build_centroid_position();
         build_centroid_normal();
@@ -693,6 +1100,46 @@ void Build_context::build_centroid_points()
     }
 }
 
+void Build_context::build_centroid_points()
+{
+    ERHE_PROFILE_FUNCTION();
+
+    if (!is_ready()) {
+        return;
+    }
+
+    if (!root.build_info.primitive_types.centroid_points) {
+        return;
+    }
+
+    const GEO::index_t facet_count = root.mesh.facets.nb();
+    const std::size_t  chunk_count = get_parallel_chunk_count(facet_count);
+    if (chunk_count <= 1) {
+        build_centroid_points_range(0, facet_count);
+        return;
+    }
+
+    // One centroid vertex and index per facet
+    const std::vector<std::size_t> begin = get_even_ranges(facet_count, chunk_count);
+    std::vector<std::unique_ptr<Build_context>> workers;
+    for (std::size_t i = 0; i < chunk_count; ++i) {
+        auto worker = std::make_unique<Build_context>(*this, vertex_buffer_index + begin[i]);
+        worker->index_writer.polygon_centroid_indices_written = begin[i];
+        workers.push_back(std::move(worker));
+    }
+    run_workers(
+        workers,
+        [&begin](Build_context& worker, const std::size_t i) {
+            worker.build_centroid_points_range(static_cast<GEO::index_t>(begin[i]), static_cast<GEO::index_t>(begin[i + 1]));
+        }
+    );
+    vertex_buffer_index += facet_count;
+    index_writer.polygon_centroid_indices_written = facet_count;
+    for (const std::unique_ptr<Vertex_buffer_writer>& vertex_writer : vertex_writers) {
+        vertex_writer->vertex_write_offset = vertex_buffer_index * vertex_writer->stride;
+    }
+}
+
 void Build_context_root::allocate_index_range(const Primitive_type primitive_type, const std::size_t index_count, Index_range& out_range)
 {
     out_range.primitive_type = primitive_type;
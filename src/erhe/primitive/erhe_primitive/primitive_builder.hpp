@@ -9,6 +9,10 @@
 #include "erhe_primitive/vertex_attribute_info.hpp"
 
 #include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
 
 namespace erhe::primitive {
 
@@ -73,6 +77,11 @@ public:
         Element_mappings&  element_mappings,
         const Normal_style normal_style
     );
+
+    // Worker context for parallel builds. Shares destination buffers and element
+    // mappings with parent, writes vertices starting from first_vertex.
+    Build_context(Build_context& parent, std::size_t first_vertex);
+
     ~Build_context() noexcept;
 
     auto is_ready() const -> bool;
@@ -90,12 +99,20 @@ private:
 
     void build_tangent_frame();
 
-    void build_vertex_position     ();
-    void build_vertex_normal       (bool normal, bool smooth_normal);
-    void build_vertex_tangent      ();
-    void build_vertex_bitangent    ();
-    void build_vertex_texcoord     (size_t usage_index);
-    void build_vertex_color        (size_t usage_index);
+    // Float32: attribute format is known to be format_32_vecN_float, write without conversion.
+    // Otherwise the value is staged, and converted with other staged values of the same
+    // attribute by flush_staged_attributes().
+    template <bool Float32, std::size_t N>
+    void write_vertex_float(Vertex_buffer_writer* writer, const Vertex_attribute_info& attribute, const float* value);
+    void stage_vertex_float     (Vertex_buffer_writer* writer, const Vertex_attribute_info& attribute, const float* value, std::size_t component_count);
+    void flush_staged_attributes();
+
+    template <bool Float32> void build_vertex_position ();
+    template <bool Float32> void build_vertex_normal   (bool normal, bool smooth_normal);
+    template <bool Float32> void build_vertex_tangent  ();
+    template <bool Float32> void build_vertex_bitangent();
+    template <bool Float32> void build_vertex_texcoord (size_t usage_index);
+    template <bool Float32> void build_vertex_color    (size_t usage_index);
     void build_vertex_aniso_control();
     void build_vertex_joint_indices(size_t usage_index);
     void build_vertex_joint_weights(size_t usage_index);
@@ -107,6 +124,25 @@ private:
     void build_corner_point_index  ();
     void build_triangle_fill_index ();
 
+    [[nodiscard]] auto get_polygon_fill_features() -> uint32_t;
+
+    template <uint32_t Features>
+    void build_polygon_fill_corners(uint32_t dynamic_features, GEO::index_t facet_begin, GEO::index_t facet_end);
+
+    template <uint32_t... Profiles>
+    [[nodiscard]] auto dispatch_polygon_fill(uint32_t features, GEO::index_t facet_begin, GEO::index_t facet_end) -> bool;
+
+    void build_polygon_fill_facets  (uint32_t features, GEO::index_t facet_begin, GEO::index_t facet_end);
+    void build_edge_lines_range     (GEO::index_t edge_begin, GEO::index_t edge_end);
+    void build_centroid_points_range(GEO::index_t facet_begin, GEO::index_t facet_end);
+
+    void init_attribute_writers();
+    [[nodiscard]] auto get_parallel_chunk_count(std::size_t work_count) const -> std::size_t;
+    void run_workers(
+        const std::vector<std::unique_ptr<Build_context>>&        workers,
+        const std::function<void(Build_context&, std::size_t)>& op
+    );
+
     GEO::vec3f v_position {};
     GEO::vec3f v_normal   {};
     GEO::vec4f v_tangent  {};
@@ -130,6 +166,8 @@ private:
     bool used_fallback_tangent      {false};
     bool used_fallback_bitangent    {false};
     bool used_fallback_texcoord     {false};
+    bool is_worker                  {false};
+    bool write_vertex_mappings      {true}; // parallel fill resolves mesh_vertex_to_vertex_buffer_index afterwards
 
     [[nodiscard]] auto get_attribute_writer(erhe::dataformat::Vertex_attribute_usage usage, std::size_t index = 0) -> Vertex_buffer_writer*;
 
@@ -150,6 +188,19 @@ private:
 
     };
     Vertex_writers attribute_writers;
+
+    // Float attribute values of consecutive vertices, waiting for batch conversion
+    class Staged_attribute
+    {
+    public:
+        Vertex_buffer_writer*        writer         {nullptr};
+        const Vertex_attribute_info* attribute      {nullptr};
+        std::size_t                  component_count{0};
+        std::size_t                  first_offset   {0}; // writer vertex_write_offset of first staged value
+        std::vector<float>           values;
+    };
+    std::vector<Staged_attribute> staged_attributes;
+    std::size_t                   staged_vertex_count{0};
 };
 
 class Primitive_builder final
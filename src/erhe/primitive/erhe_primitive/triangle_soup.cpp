@@ -124,17 +124,17 @@ private:
         m_vertex_positions.resize(vertex_count);
         const std::size_t   vertex_stride = vertex_stream.stride;
         const std::uint8_t* position_base = m_triangle_soup.vertex_data.data() + position_attribute->offset;
+        std::vector<float> v(vertex_count * 3);
+        erhe::dataformat::convert(
+            position_base + vertex_stride * m_min_index, position_attribute->format, vertex_stride,
+            v.data(), erhe::dataformat::Format::format_32_vec3_float, 3 * sizeof(float),
+            vertex_count,
+            1.0f
+        );
         for (std::size_t index : m_used_indices) {
-            float v[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
-            const std::uint8_t* src = position_base + vertex_stride * index;
-            std::uint8_t* dst = reinterpret_cast<std::uint8_t*>(&v[0]);
-            erhe::dataformat::convert(
-                src, position_attribute->format,
-                dst, erhe::dataformat::Format::format_32_vec3_float, 
-                1.0f
-            );
-            const GEO::vec3 position{v[0], v[1], v[2]};
-            m_vertex_positions.at(index - m_min_index) = position;
+            const std::size_t i = index - m_min_index;
+            const GEO::vec3 position{v[3 * i + 0], v[3 * i + 1], v[3 * i + 2]};
+            m_vertex_positions.at(i) = position;
         }
 
         // Sort vertices
@@ -295,9 +295,37 @@ private:
             const Vertex_attribute& attribute = attributes[attribute_index];
             const std::uint8_t* attribute_data_base = vertex_data_base + attribute.offset;
 
+            // Convert all values of the attribute at once
+            std::vector<uint32_t> uint_values;
+            std::vector<float>    float_values;
+            switch (erhe::dataformat::get_format_kind(attribute.format)) {
+                case erhe::dataformat::Format_kind::format_kind_unsigned_integer: {
+                    uint_values.resize(4 * vertex_count);
+                    erhe::dataformat::convert(
+                        attribute_data_base, attribute.format, vertex_stream.stride,
+                        uint_values.data(), erhe::dataformat::Format::format_32_vec4_uint, 4 * sizeof(uint32_t),
+                        vertex_count,
+                        1.0f
+                    );
+                    break;
+                }
+                case erhe::dataformat::Format_kind::format_kind_float: {
+                    float_values.resize(4 * vertex_count);
+                    erhe::dataformat::convert(
+                        attribute_data_base, attribute.format, vertex_stream.stride,
+                        float_values.data(), erhe::dataformat::Format::format_32_vec4_float, 4 * sizeof(float),
+                        vertex_count,
+                        1.0f
+                    );
+                    break;
+                }
+                default: {
+                    break;
+                }
+            }
+
             if (is_per_point(attribute.usage_type)) {
                 for (std::size_t vertex_index = 0; vertex_index < vertex_count; ++vertex_index) {
-                    const std::uint8_t* src = attribute_data_base + vertex_stream.stride * vertex_index;
                     const GEO::index_t vertex = m_vertex_from_index.at(vertex_index - m_min_index);
                     ERHE_VERIFY(vertex != GEO::NO_INDEX); // TODO Is this better or worse than using if condition below?
                     if (vertex == GEO::NO_INDEX) {
@@ -305,10 +333,7 @@ private:
                     }
                     switch (erhe::dataformat::get_format_kind(attribute.format)) {
                         case erhe::dataformat::Format_kind::format_kind_unsigned_integer: {
-                            uint32_t value[4] = { 0u, 0u, 0u, 0u };
-                            std::uint8_t* dst = reinterpret_cast<std::uint8_t*>(&value[0]);
-                            erhe::dataformat::convert(src, attribute.format, dst, erhe::dataformat::Format::format_32_vec4_uint, 1.0f);
-                            put_vertex_attribute<uint32_t>(attribute, vertex, value);
+                            put_vertex_attribute<uint32_t>(attribute, vertex, &uint_values[4 * vertex_index]);
                             break;
                         }
                         case erhe::dataformat::Format_kind::format_kind_signed_integer: {
@@ -320,10 +345,7 @@ private:
                             // put_vertex_attribute<int32_t>(attribute, vertex, value);
                         }
                         case erhe::dataformat::Format_kind::format_kind_float: {
-                            float value[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
-                            std::uint8_t* dst = reinterpret_cast<std::uint8_t*>(&value[0]);
-                            erhe::dataformat::convert(src, attribute.format, dst, erhe::dataformat::Format::format_32_vec4_float, 1.0f);
-                            put_vertex_attribute<float>(attribute, vertex, value);
+                            put_vertex_attribute<float>(attribute, vertex, &float_values[4 * vertex_index]);
                             break;
                         }
                         default: {
@@ -335,7 +357,6 @@ private:
             } else {
                 for (GEO::index_t corner : m_mesh.facet_corners) {
                     const std::size_t vertex_index = m_index_from_corner.at(corner);
-                    const std::uint8_t* src = attribute_data_base + vertex_stream.stride * vertex_index;
                     switch (erhe::dataformat::get_format_kind(attribute.format)) {
                         case erhe::dataformat::Format_kind::format_kind_unsigned_integer: {
                             geo_assert(false); // TOOD
@@ -354,10 +375,7 @@ private:
                             //put_corner_attribute<int32_t>(attribute, corner, value);
                         }
                         case erhe::dataformat::Format_kind::format_kind_float: {
-                            float value[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
-                            std::uint8_t* dst = reinterpret_cast<std::uint8_t*>(&value[0]);
-                            erhe::dataformat::convert(src, attribute.format, dst, erhe::dataformat::Format::format_32_vec4_float, 1.0f);
-                            put_corner_attribute<float>(attribute, corner, value);
+                            put_corner_attribute<float>(attribute, corner, &float_values[4 * vertex_index]);
                             break;
                         }
                         default: {
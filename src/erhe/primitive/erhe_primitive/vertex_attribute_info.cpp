@@ -12,11 +12,13 @@ Vertex_attribute_info::Vertex_attribute_info(
 {
     erhe::dataformat::Attribute_stream info = vertex_format.find_attribute(usage, usage_index);
     if (info.attribute != nullptr) {
-        attribute = info.attribute;
-        format    = info.attribute->format;
-        binding   = info.stream->binding;
-        offset    = info.attribute->offset;
-        size      = erhe::dataformat::get_format_size(info.attribute->format);
+        attribute       = info.attribute;
+        format          = info.attribute->format;
+        binding         = info.stream->binding;
+        offset          = info.attribute->offset;
+        size            = erhe::dataformat::get_format_size(info.attribute->format);
+        component_count = erhe::dataformat::get_component_count(info.attribute->format);
+        pack_float      = erhe::dataformat::get_float_pack_function(info.attribute->format);
     }
 }
 
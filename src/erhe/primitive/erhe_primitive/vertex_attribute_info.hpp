@@ -1,5 +1,6 @@
 #pragma once
 
+#include "erhe_dataformat/dataformat.hpp"
 #include "erhe_dataformat/vertex_format.hpp"
 
 #include <cstddef>
@@ -19,11 +20,13 @@ public:
 
     [[nodiscard]] auto is_valid() -> bool;
 
-    const erhe::dataformat::Vertex_attribute* attribute{nullptr};
-    erhe::dataformat::Format                  format   {erhe::dataformat::Format::format_undefined};
-    std::size_t                               binding  {std::numeric_limits<std::size_t>::max()};
-    std::size_t                               offset   {std::numeric_limits<std::size_t>::max()};
-    std::size_t                               size     {0};
+    const erhe::dataformat::Vertex_attribute* attribute      {nullptr};
+    erhe::dataformat::Format                  format         {erhe::dataformat::Format::format_undefined};
+    std::size_t                               binding        {std::numeric_limits<std::size_t>::max()};
+    std::size_t                               offset         {std::numeric_limits<std::size_t>::max()};
+    std::size_t                               size           {0};
+    std::size_t                               component_count{0};
+    erhe::dataformat::Float_pack_function     pack_float     {nullptr}; // resolved once from format; nullptr if not float/unorm/snorm
 };
 
 } // namespace erhe::primitive
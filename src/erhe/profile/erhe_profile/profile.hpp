@@ -43,6 +43,7 @@
 #   define ERHE_PROFILE_GPU_SCOPE(erhe_profile_id) TracyGpuZone(erhe_profile_id.data())
 #   define ERHE_PROFILE_GPU_CONTEXT TracyGpuContext
 #   define ERHE_PROFILE_FRAME_END FrameMark; TracyGpuCollect
+#   define ERHE_PROFILE_PLOT(erhe_profile_plot_name, erhe_profile_plot_value) TracyPlot(erhe_profile_plot_name, erhe_profile_plot_value)
 #   define ERHE_PROFILE_MUTEX_DECLARATION(Type, mutex_variable) tracy::Lockable<Type> mutex_variable
 #   define ERHE_PROFILE_MUTEX(Type, mutex_variable) TracyLockable(Type, mutex_variable)
 #   define ERHE_PROFILE_LOCKABLE_BASE(Type) LockableBase(Type)
@@ -67,6 +68,7 @@
 #   define ERHE_PROFILE_GPU_SCOPE(erhe_profile_id)
 #   define ERHE_PROFILE_GPU_CONTEXT
 #   define ERHE_PROFILE_FRAME_END
+#   define ERHE_PROFILE_PLOT(erhe_profile_plot_name, erhe_profile_plot_value) static_cast<void>(erhe_profile_plot_value);
 #   define ERHE_PROFILE_MUTEX_DECLARATION(Type, mutex_variable) Type mutex_variable
 #   define ERHE_PROFILE_MUTEX(Type, mutex_variable) Type mutex_variable
 #   define ERHE_PROFILE_LOCKABLE_BASE(Type) Type
@@ -90,6 +92,7 @@
 #   define ERHE_PROFILE_GPU_SCOPE(erhe_profile_id) static_cast<void>(erhe_profile_id);
 #   define ERHE_PROFILE_GPU_CONTEXT
 #   define ERHE_PROFILE_FRAME_END
+#   define ERHE_PROFILE_PLOT(erhe_profile_plot_name, erhe_profile_plot_value) static_cast<void>(erhe_profile_plot_value);
 #   define ERHE_PROFILE_MUTEX_DECLARATION(Type, mutex_variable) Type mutex_variable
 #   define ERHE_PROFILE_MUTEX(Type, mutex_variable) Type mutex_variable
 #   define ERHE_PROFILE_LOCKABLE_BASE(Type) Type
@@ -104,6 +107,7 @@
 #   define ERHE_PROFILE_GPU_SCOPE(erhe_profile_id) static_cast<void>(erhe_profile_id);
 #   define ERHE_PROFILE_GPU_CONTEXT
 #   define ERHE_PROFILE_FRAME_END
+#   define ERHE_PROFILE_PLOT(erhe_profile_plot_name, erhe_profile_plot_value) static_cast<void>(erhe_profile_plot_value);
 #   define ERHE_PROFILE_MUTEX_DECLARATION(Type, mutex_variable) Type mutex_variable
 #   define ERHE_PROFILE_MUTEX(Type, mutex_variable) Type mutex_variable
 #   define ERHE_PROFILE_LOCKABLE_BASE(Type) Type
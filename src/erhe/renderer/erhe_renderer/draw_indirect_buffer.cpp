@@ -3,6 +3,7 @@
 #include "erhe_renderer/draw_indirect_buffer.hpp"
 
 #include "erhe_configuration/configuration.hpp"
+#include "erhe_renderer/mesh_instance_batches.hpp"
 #include "erhe_renderer/renderer_log.hpp"
 
 #include "erhe_gl/draw_indirect.hpp"
@@ -35,7 +36,8 @@ Draw_indirect_buffer::Draw_indirect_buffer(erhe::graphics::Instance& graphics_in
 auto Draw_indirect_buffer::update(
     const std::span<const std::shared_ptr<erhe::scene::Mesh>>& meshes,
     erhe::primitive::Primitive_mode                            primitive_mode,
-    const erhe::Item_filter&                                   filter
+    const erhe::Item_filter&                                   filter,
+    const std::span<const uint32_t>                            base_instances
 ) -> Draw_indirect_buffer_range
 {
     ERHE_PROFILE_FUNCTION();
@@ -62,9 +64,8 @@ auto Draw_indirect_buffer::update(
     const auto        gpu_data       = buffer_range.get_span();
     size_t            write_offset   = 0;
     uint32_t          instance_count     {1};
-    uint32_t          base_instance      {0};
     std::size_t       draw_indirect_count{0};
-    
+
     for (const auto& mesh : meshes) {
         const auto* node = mesh->get_node();
 
@@ -92,6 +93,12 @@ auto Draw_indirect_buffer::update(
             const uint32_t first_index = static_cast<uint32_t>(index_range.first_index + base_index);
             const uint32_t base_vertex = buffer_mesh.base_vertex();
 
+            // Shaders locate primitive record using base instance
+            ERHE_VERIFY(base_instances.empty() || (draw_indirect_count < base_instances.size()));
+            const uint32_t base_instance = base_instances.empty()
+                ? static_cast<uint32_t>(draw_indirect_count)
+                : base_instances[draw_indirect_count];
+
             const gl::Draw_elements_indirect_command draw_command{
                 index_count,
                 instance_count,
@@ -111,8 +118,73 @@ auto Draw_indirect_buffer::update(
 
     SPDLOG_LOGGER_TRACE(log_draw, "wrote {} entries to draw indirect buffer", draw_indirect_count);
     return Draw_indirect_buffer_range{
-        std::move(buffer_range),
-        draw_indirect_count
+        .range               = std::move(buffer_range),
+        .draw_indirect_count = draw_indirect_count,
+        .instance_count      = draw_indirect_count
+    };
+}
+
+auto Draw_indirect_buffer::update(
+    const Mesh_instance_batches&    batches,
+    erhe::primitive::Primitive_mode primitive_mode
+) -> Draw_indirect_buffer_range
+{
+    ERHE_PROFILE_FUNCTION();
+
+    using Batch = Mesh_instance_batches::Batch;
+    const std::vector<const erhe::scene::Mesh*>& meshes = batches.get_meshes();
+
+    // Conservative upper limit
+    std::size_t primitive_count = 0;
+    for (const Batch& batch : batches.get_batches()) {
+        primitive_count += meshes[batch.first_mesh]->get_primitives().size();
+    }
+
+    const std::size_t entry_size     = sizeof(gl::Draw_elements_indirect_command);
+    const std::size_t max_byte_count = primitive_count * entry_size;
+    Buffer_range      buffer_range   = open(Ring_buffer_usage::CPU_write, max_byte_count);
+    const auto        gpu_data       = buffer_range.get_span();
+    size_t            write_offset   = 0;
+    std::size_t       draw_indirect_count{0};
+    std::size_t       instance_count     {0};
+
+    for (const Batch& batch : batches.get_batches()) {
+        // All meshes in a batch share render shapes, use the first one
+        for (auto& primitive : meshes[batch.first_mesh]->get_primitives()) {
+            const erhe::primitive::Buffer_mesh& buffer_mesh = primitive.render_shape->get_renderable_mesh();
+            const erhe::primitive::Index_range  index_range = buffer_mesh.index_range(primitive_mode);
+            if (index_range.index_count == 0) {
+                continue;
+            }
+
+            uint32_t index_count = static_cast<uint32_t>(index_range.index_count);
+            if (m_max_index_count_enable) {
+                index_count = std::min(index_count, static_cast<uint32_t>(m_max_index_count));
+            }
+
+            const gl::Draw_elements_indirect_command draw_command{
+                index_count,
+                static_cast<uint32_t>(batch.mesh_count),
+                static_cast<uint32_t>(index_range.first_index + buffer_mesh.base_index()),
+                buffer_mesh.base_vertex(),
+                static_cast<uint32_t>(instance_count)
+            };
+
+            erhe::graphics::write(gpu_data, write_offset, erhe::graphics::as_span(draw_command));
+
+            write_offset   += entry_size;
+            instance_count += batch.mesh_count;
+            ++draw_indirect_count;
+        }
+    }
+
+    buffer_range.close(write_offset);
+
+    SPDLOG_LOGGER_TRACE(log_draw, "wrote {} instanced entries ({} instances) to draw indirect buffer", draw_indirect_count, instance_count);
+    return Draw_indirect_buffer_range{
+        .range               = std::move(buffer_range),
+        .draw_indirect_count = draw_indirect_count,
+        .instance_count      = instance_count
     };
 }
 
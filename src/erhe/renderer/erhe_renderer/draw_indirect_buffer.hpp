@@ -3,6 +3,7 @@
 #include "erhe_renderer/gpu_ring_buffer.hpp"
 #include "erhe_primitive/enums.hpp"
 
+#include <cstdint>
 #include <memory>
 #include <span>
 
@@ -15,11 +16,14 @@ namespace erhe::scene {
 
 namespace erhe::renderer {
 
+class Mesh_instance_batches;
+
 class Draw_indirect_buffer_range
 {
 public:
     Buffer_range range;
     std::size_t  draw_indirect_count{0};
+    std::size_t  instance_count     {0}; // sum of draw command instance counts
 };
 
 class Draw_indirect_buffer : public GPU_ring_buffer
@@ -27,11 +31,22 @@ class Draw_indirect_buffer : public GPU_ring_buffer
 public:
     explicit Draw_indirect_buffer(erhe::graphics::Instance& graphics_instance);
 
-    // Can discard return value
+    // Can discard return value. Base instance of each draw command is the
+    // draw command index, or the matching entry of base_instances when given
+    // (see Primitive_buffer::update_records()).
     auto update(
         const std::span<const std::shared_ptr<erhe::scene::Mesh>>& meshes,
         erhe::primitive::Primitive_mode                            primitive_mode,
-        const erhe::Item_filter&                                   filter
+        const erhe::Item_filter&                                   filter,
+        std::span<const uint32_t>                                  base_instances = {}
+    ) -> Draw_indirect_buffer_range;
+
+    // One instanced draw command per batch primitive. Base instance of each
+    // command is the index of the first primitive record written for it by
+    // Primitive_buffer::update() with the same batches.
+    auto update(
+        const Mesh_instance_batches&    batches,
+        erhe::primitive::Primitive_mode primitive_mode
     ) -> Draw_indirect_buffer_range;
 
     //// void debug_properties_window();
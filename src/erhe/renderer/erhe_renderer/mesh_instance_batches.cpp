@@ -0,0 +1,104 @@
+#include "erhe_renderer/mesh_instance_batches.hpp"
+
+#include "erhe_item/item.hpp"
+#include "erhe_primitive/primitive.hpp"
+#include "erhe_scene/mesh.hpp"
+#include "erhe_profile/profile.hpp"
+
+namespace erhe::renderer {
+
+auto Mesh_instance_batches::get_geometry_key(const erhe::scene::Mesh& mesh) -> uint64_t
+{
+    // FNV-1a over render shape addresses; primitive copies share render shapes
+    uint64_t key = 0xcbf29ce484222325ull;
+    for (const erhe::primitive::Primitive& primitive : mesh.get_primitives()) {
+        key ^= static_cast<uint64_t>(reinterpret_cast<uintptr_t>(primitive.render_shape.get()));
+        key *= 0x100000001b3ull;
+    }
+    return key;
+}
+
+auto Mesh_instance_batches::has_same_geometry(const erhe::scene::Mesh& lhs, const erhe::scene::Mesh& rhs) -> bool
+{
+    const std::vector<erhe::primitive::Primitive>& lhs_primitives = lhs.get_primitives();
+    const std::vector<erhe::primitive::Primitive>& rhs_primitives = rhs.get_primitives();
+    if (lhs_primitives.size() != rhs_primitives.size()) {
+        return false;
+    }
+    for (std::size_t i = 0, end = lhs_primitives.size(); i < end; ++i) {
+        if (lhs_primitives[i].render_shape != rhs_primitives[i].render_shape) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void Mesh_instance_batches::build(const std::span<const std::shared_ptr<erhe::scene::Mesh>>& meshes, const erhe::Item_filter& filter)
+{
+    ERHE_PROFILE_FUNCTION();
+
+    m_meshes               .clear();
+    m_batches              .clear();
+    m_filtered_meshes      .clear();
+    m_filtered_mesh_batches.clear();
+    m_batch_from_key       .clear();
+
+    for (const std::shared_ptr<erhe::scene::Mesh>& mesh : meshes) {
+        if (mesh->get_node() == nullptr) {
+            continue;
+        }
+        if (!filter(mesh->get_flag_bits())) {
+            continue;
+        }
+
+        const uint64_t key = get_geometry_key(*mesh);
+        std::size_t batch_index = m_batches.size();
+        const auto i = m_batch_from_key.find(key);
+        if (i != m_batch_from_key.end()) {
+            const Batch&             batch          = m_batches[i->second];
+            const erhe::scene::Mesh* representative = m_filtered_meshes[batch.first_mesh];
+            if (has_same_geometry(*representative, *mesh)) {
+                batch_index = i->second;
+            }
+        }
+        if (batch_index == m_batches.size()) {
+            // Key collisions with different geometry get a batch of their own,
+            // which is not findable by key. This only costs draw calls.
+            if (i == m_batch_from_key.end()) {
+                m_batch_from_key.emplace(key, batch_index);
+            }
+            m_batches.push_back(Batch{.first_mesh = m_filtered_meshes.size(), .mesh_count = 0});
+        }
+        ++m_batches[batch_index].mesh_count;
+        m_filtered_meshes      .push_back(mesh.get());
+        m_filtered_mesh_batches.push_back(batch_index);
+    }
+
+    // Exclusive prefix sum of batch sizes gives each batch its range in
+    // m_meshes; scatter keeps meshes within a batch in input order.
+    std::size_t first_mesh = 0;
+    for (Batch& batch : m_batches) {
+        batch.first_mesh = first_mesh;
+        first_mesh += batch.mesh_count;
+    }
+    m_meshes.resize(m_filtered_meshes.size());
+    for (std::size_t i = 0, end = m_filtered_meshes.size(); i < end; ++i) {
+        Batch& batch = m_batches[m_filtered_mesh_batches[i]];
+        m_meshes[batch.first_mesh++] = m_filtered_meshes[i];
+    }
+    for (Batch& batch : m_batches) {
+        batch.first_mesh -= batch.mesh_count;
+    }
+}
+
+auto Mesh_instance_batches::get_meshes() const -> const std::vector<const erhe::scene::Mesh*>&
+{
+    return m_meshes;
+}
+
+auto Mesh_instance_batches::get_batches() const -> const std::vector<Batch>&
+{
+    return m_batches;
+}
+
+} // namespace erhe::renderer
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace erhe {
+    class Item_filter;
+}
+namespace erhe::scene {
+    class Mesh;
+}
+
+namespace erhe::renderer {
+
+// Groups meshes which use the same buffer meshes (shared primitive render
+// shapes), so that each primitive of a batch can be drawn with a single
+// instanced draw command.
+//
+// Primitive records and draw commands for a batch are laid out primitive
+// major: records for all instances of the first primitive, then for all
+// instances of the second primitive, and so on. Shaders find the primitive
+// record of an instance from gl_BaseInstance + gl_InstanceID.
+class Mesh_instance_batches
+{
+public:
+    class Batch
+    {
+    public:
+        std::size_t first_mesh{0}; // index to get_meshes()
+        std::size_t mesh_count{0};
+    };
+
+    // Meshes without node, or not passing the filter, are skipped.
+    // Batches are in order of first appearance of their geometry.
+    void build(const std::span<const std::shared_ptr<erhe::scene::Mesh>>& meshes, const erhe::Item_filter& filter);
+
+    [[nodiscard]] auto get_meshes () const -> const std::vector<const erhe::scene::Mesh*>&;
+    [[nodiscard]] auto get_batches() const -> const std::vector<Batch>&;
+
+private:
+    [[nodiscard]] static auto get_geometry_key (const erhe::scene::Mesh& mesh) -> uint64_t;
+    [[nodiscard]] static auto has_same_geometry(const erhe::scene::Mesh& lhs, const erhe::scene::Mesh& rhs) -> bool;
+
+    std::vector<const erhe::scene::Mesh*>     m_meshes;
+    std::vector<Batch>                        m_batches;
+    std::vector<const erhe::scene::Mesh*>     m_filtered_meshes;
+    std::vector<std::size_t>                  m_filtered_mesh_batches;
+    std::unordered_map<uint64_t, std::size_t> m_batch_from_key;
+};
+
+} // namespace erhe::renderer
@@ -2,12 +2,10 @@
 
 #include "erhe_rendergraph/rendergraph.hpp"
 #include "erhe_rendergraph/rendergraph_log.hpp"
-#include "erhe_gl/command_info.hpp"
 #include "erhe_gl/enum_string_functions.hpp"
 #include "erhe_gl/wrapper_enums.hpp"
 #include "erhe_gl/wrapper_functions.hpp"
 #include "erhe_graphics/framebuffer.hpp"
-#include "erhe_graphics/renderbuffer.hpp"
 #include "erhe_graphics/texture.hpp"
 #include "erhe_profile/profile.hpp"
 #include "erhe_verify/verify.hpp"
@@ -40,9 +38,10 @@ void Multisample_resolve_node::reconfigure(const int sample_count)
         return;
     }
 
+    // New textures are requested on the next Rendergraph::execute()
     m_sample_count = sample_count;
     m_color_texture.reset();
-    m_depth_stencil_renderbuffer.reset();
+    m_depth_stencil_texture.reset();
     m_framebuffer.reset();
 }
 
@@ -93,123 +92,101 @@ auto Multisample_resolve_node::get_consumer_input_viewport(
     return get_producer_output_viewport(resource_routing, key, depth + 1);
 }
 
-void Multisample_resolve_node::execute_rendergraph_node()
+void Multisample_resolve_node::request_transient_textures(Transient_texture_pool& pool)
 {
-    ERHE_PROFILE_FUNCTION();
-
-    using erhe::graphics::Framebuffer;
-    using erhe::graphics::Texture;
+    m_color_request         = Transient_texture_pool::c_no_request;
+    m_depth_stencil_request = Transient_texture_pool::c_no_request;
 
     const auto& output_viewport = get_producer_output_viewport(Routing::Resource_provided_by_consumer, m_key);
-
-    if (
-        (output_viewport.width  < 1) ||
-        (output_viewport.height < 1)
-    ) {
+    if ((output_viewport.width < 1) || (output_viewport.height < 1)) {
         return;
     }
 
-    // Resize framebuffer if necessary
-    if (
-        !m_color_texture ||
-        (m_color_texture->width () != output_viewport.width ) ||
-        (m_color_texture->height() != output_viewport.height)
-    ) {
-        log_tail->trace(
-            "Resizing Multisample_resolve_node '{}' to {} x {}",
-            get_name(),
-            output_viewport.width,
-            output_viewport.height
-        );
-
-        //// TODO Mirror framebuffer from output rendergraph node:
-        ////      Get attachments and their formats from output rendergraph node
-        erhe::graphics::Instance& graphics_instance = m_rendergraph.get_graphics_instance();
-
-        m_color_texture = std::make_shared<Texture>(
-            Texture::Create_info{
-                .instance        = graphics_instance,
-                .target          = gl::Texture_target::texture_2d_multisample,
-                .internal_format = gl::Internal_format::rgba16f, // TODO other formats
-                .sample_count    = m_sample_count,
-                .width           = output_viewport.width,
-                .height          = output_viewport.height,
-                .debug_label     = fmt::format("{} Multisample_resolve_node color texture", get_name())
-            }
-        );
-        const float clear_value[4] = { 1.0f, 0.0f, 1.0f, 1.0f };
-        if (gl::is_command_supported(gl::Command::Command_glClearTexImage)) {
-            gl::clear_tex_image(
-                m_color_texture->gl_name(),
-                0,
-                gl::Pixel_format::rgba,
-                gl::Pixel_type::float_,
-                &clear_value[0]
-            );
-        } else {
-            // TODO
-        }
-
-        m_depth_stencil_renderbuffer = std::make_unique<erhe::graphics::Renderbuffer>(
-            graphics_instance,
-            gl::Internal_format::depth24_stencil8,
-            m_sample_count,
-            output_viewport.width,
-            output_viewport.height
-        );
+    // Producers render to the multisampled framebuffer, this node resolves it
+    const int first_use = get_first_use_execution_index(m_key);
+    const int last_use  = get_execution_index();
+
+    //// TODO Mirror framebuffer from output rendergraph node:
+    ////      Get attachments and their formats from output rendergraph node
+    m_color_request = pool.request(
+        Transient_texture_desc{
+            .target          = gl::Texture_target::texture_2d_multisample,
+            .internal_format = gl::Internal_format::rgba16f, // TODO other formats
+            .sample_count    = m_sample_count,
+            .width           = output_viewport.width,
+            .height          = output_viewport.height
+        },
+        first_use,
+        last_use
+    );
+    m_depth_stencil_request = pool.request(
+        Transient_texture_desc{
+            .target          = gl::Texture_target::texture_2d_multisample,
+            .internal_format = gl::Internal_format::depth24_stencil8,
+            .sample_count    = m_sample_count,
+            .width           = output_viewport.width,
+            .height          = output_viewport.height
+        },
+        first_use,
+        last_use
+    );
+}
 
-        m_depth_stencil_renderbuffer->set_debug_label(
-            fmt::format("'{}' Multisample_resolve_node depth-stencil renderbuffer", get_name())
-        );
+void Multisample_resolve_node::bind_transient_textures(const Transient_texture_pool& pool)
+{
+    using erhe::graphics::Framebuffer;
 
-        {
-            Framebuffer::Create_info create_info;
-            create_info.attach(gl::Framebuffer_attachment::color_attachment0,  m_color_texture.get());
-            create_info.attach(gl::Framebuffer_attachment::depth_attachment,   m_depth_stencil_renderbuffer.get());
-            create_info.attach(gl::Framebuffer_attachment::stencil_attachment, m_depth_stencil_renderbuffer.get());
-            m_framebuffer = std::make_unique<Framebuffer>(create_info);
-            m_framebuffer->set_debug_label(
-                fmt::format("{} Multisample_resolve_node framebuffer", get_name())
-            );
+    std::shared_ptr<erhe::graphics::Texture> color_texture         = pool.get(m_color_request);
+    std::shared_ptr<erhe::graphics::Texture> depth_stencil_texture = pool.get(m_depth_stencil_request);
+    if (!color_texture || !depth_stencil_texture) {
+        m_color_texture.reset();
+        m_depth_stencil_texture.reset();
+        m_framebuffer.reset();
+        return;
+    }
+    if (m_framebuffer && (color_texture == m_color_texture) && (depth_stencil_texture == m_depth_stencil_texture)) {
+        return;
+    }
 
-            gl::Color_buffer draw_buffers[] = { gl::Color_buffer::color_attachment0 };
-            gl::named_framebuffer_draw_buffers(m_framebuffer->gl_name(), 1, &draw_buffers[0]);
-            gl::named_framebuffer_read_buffer (m_framebuffer->gl_name(), gl::Color_buffer::color_attachment0);
+    log_tail->trace(
+        "Binding Multisample_resolve_node '{}' to {} x {} textures",
+        get_name(),
+        color_texture->width(),
+        color_texture->height()
+    );
+
+    m_color_texture         = std::move(color_texture);
+    m_depth_stencil_texture = std::move(depth_stencil_texture);
+
+    Framebuffer::Create_info create_info;
+    create_info.attach(gl::Framebuffer_attachment::color_attachment0,  m_color_texture.get());
+    create_info.attach(gl::Framebuffer_attachment::depth_attachment,   m_depth_stencil_texture.get());
+    create_info.attach(gl::Framebuffer_attachment::stencil_attachment, m_depth_stencil_texture.get());
+    m_framebuffer = std::make_shared<Framebuffer>(create_info);
+    m_framebuffer->set_debug_label(fmt::format("{} Multisample_resolve_node framebuffer", get_name()));
+
+    gl::Color_buffer draw_buffers[] = { gl::Color_buffer::color_attachment0 };
+    gl::named_framebuffer_draw_buffers(m_framebuffer->gl_name(), 1, &draw_buffers[0]);
+    gl::named_framebuffer_read_buffer (m_framebuffer->gl_name(), gl::Color_buffer::color_attachment0);
+
+    if (!m_framebuffer->check_status()) {
+        log_frame->error("{} Multisample_resolve_node framebuffer not complete", get_name());
+        m_framebuffer.reset();
+    }
+}
 
-            if (!m_framebuffer->check_status()) {
-                log_frame->error("'{} Multisample_resolve_node framebuffer not complete", get_name());
-                m_framebuffer.reset();
-                return;
-            }
-        }
+void Multisample_resolve_node::execute_rendergraph_node()
+{
+    ERHE_PROFILE_FUNCTION();
 
+    const auto& output_viewport = get_producer_output_viewport(Routing::Resource_provided_by_consumer, m_key);
 
-        // TODO initial clear?
-        //const float clear_value[4] = { 1.0f, 0.0f, 1.0f, 1.0f };
-        //gl::clear_tex_image(
-        //    texture->gl_name(),
-        //    0,
-        //    gl::Pixel_format::rgba,
-        //    gl::Pixel_type::float_,
-        //    &clear_value[0]
-        //);
-
-        erhe::graphics::Framebuffer::Create_info create_info;
-        create_info.attach(gl::Framebuffer_attachment::color_attachment0,  m_color_texture.get());
-        create_info.attach(gl::Framebuffer_attachment::depth_attachment,   m_depth_stencil_renderbuffer.get());
-        create_info.attach(gl::Framebuffer_attachment::stencil_attachment, m_depth_stencil_renderbuffer.get());
-        m_framebuffer = std::make_shared<Framebuffer>(create_info);
-        m_framebuffer->set_debug_label(get_name());
-
-        gl::Color_buffer draw_buffers[] = { gl::Color_buffer::color_attachment0 };
-        gl::named_framebuffer_draw_buffers(m_framebuffer->gl_name(), 1, &draw_buffers[0]);
-        gl::named_framebuffer_read_buffer (m_framebuffer->gl_name(), gl::Color_buffer::color_attachment0);
-
-        if (!m_framebuffer->check_status()) {
-            log_frame->error("{} Multisample_resolve_node framebuffer not complete", get_name());
-            m_framebuffer.reset();
-            return;
-        }
+    if (
+        (output_viewport.width  < 1) ||
+        (output_viewport.height < 1) ||
+        !m_framebuffer
+    ) {
+        return;
     }
 
     {
@@ -1,8 +1,10 @@
 #pragma once
 
 #include "erhe_rendergraph/rendergraph_node.hpp"
+#include "erhe_rendergraph/transient_texture_pool.hpp"
 #include "erhe_graphics/framebuffer.hpp"
 
+#include <cstddef>
 #include <string>
 
 namespace erhe::graphics {
@@ -15,7 +17,8 @@ namespace erhe::rendergraph {
 /// Rendergraph processer node for adding multisampling to output rendergraph node
 /// </summary>
 /// Creates multisampled variant of output rendergraph node and resolves it to
-/// the target rendergraph node.
+/// the target rendergraph node. Multisampled color and depth-stencil textures
+/// are transient, and may be shared with other nodes.
 class Multisample_resolve_node : public Rendergraph_node
 {
 public:
@@ -41,15 +44,19 @@ public:
     // Override so that size is always sources from output
     auto get_consumer_input_viewport(Routing resource_routing, int key, int depth = 0) const -> erhe::math::Viewport override;
 
-    void execute_rendergraph_node() override;
+    void request_transient_textures(Transient_texture_pool& pool) override;
+    void bind_transient_textures   (const Transient_texture_pool& pool) override;
+    void execute_rendergraph_node  () override;
 
 private:
-    std::shared_ptr<erhe::graphics::Texture>      m_color_texture;
-    std::unique_ptr<erhe::graphics::Renderbuffer> m_depth_stencil_renderbuffer;
-    std::shared_ptr<erhe::graphics::Framebuffer>  m_framebuffer;
-    int                                           m_sample_count{0};
-    std::string                                   m_label;
-    int                                           m_key;
+    std::shared_ptr<erhe::graphics::Texture>     m_color_texture;
+    std::shared_ptr<erhe::graphics::Texture>     m_depth_stencil_texture;
+    std::shared_ptr<erhe::graphics::Framebuffer> m_framebuffer;
+    std::size_t                                  m_color_request        {Transient_texture_pool::c_no_request};
+    std::size_t                                  m_depth_stencil_request{Transient_texture_pool::c_no_request};
+    int                                          m_sample_count{0};
+    std::string                                  m_label;
+    int                                          m_key;
 };
 
 } // namespace erhe::rendergraph
@@ -10,7 +10,8 @@
 namespace erhe::rendergraph {
 
 Rendergraph::Rendergraph(erhe::graphics::Instance& graphics_instance)
-    : m_graphics_instance{graphics_instance}
+    : m_graphics_instance     {graphics_instance}
+    , m_transient_texture_pool{graphics_instance}
 {
     log_tail->info("Rendergraph::Rendergraph()");
 }
@@ -132,6 +133,8 @@ void Rendergraph::execute()
     static constexpr std::string_view c_render_graph{"Render graph"};
     erhe::graphics::Scoped_debug_group render_graph_scope{c_render_graph};
 
+    allocate_transient_textures();
+
     for (const auto& node : m_nodes) {
         if (node->is_enabled()) {
             SPDLOG_LOGGER_TRACE(log_frame, "Execute render graph node '{}'", node->get_name());
@@ -141,6 +144,30 @@ void Rendergraph::execute()
     }
 }
 
+void Rendergraph::allocate_transient_textures()
+{
+    ERHE_PROFILE_FUNCTION();
+
+    // Execution indices must be known before any node requests textures,
+    // as lifetimes extend to producers and consumers of each node.
+    for (int i = 0, end = static_cast<int>(m_nodes.size()); i < end; ++i) {
+        m_nodes[i]->set_execution_index(i);
+    }
+
+    m_transient_texture_pool.begin_frame();
+    for (const auto& node : m_nodes) {
+        if (node->is_enabled()) {
+            node->request_transient_textures(m_transient_texture_pool);
+        }
+    }
+    m_transient_texture_pool.allocate();
+    for (const auto& node : m_nodes) {
+        if (node->is_enabled()) {
+            node->bind_transient_textures(m_transient_texture_pool);
+        }
+    }
+}
+
 void Rendergraph::register_node(Rendergraph_node* node)
 {
     std::lock_guard<ERHE_PROFILE_LOCKABLE_BASE(std::mutex)> lock{m_mutex};
@@ -211,6 +238,11 @@ auto Rendergraph::get_graphics_instance() -> erhe::graphics::Instance&
     return m_graphics_instance;
 }
 
+auto Rendergraph::get_transient_texture_pool() -> Transient_texture_pool&
+{
+    return m_transient_texture_pool;
+}
+
 void Rendergraph::automatic_layout(const float image_size)
 {
     if (m_nodes.empty()) {
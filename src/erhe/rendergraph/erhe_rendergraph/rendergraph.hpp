@@ -1,5 +1,6 @@
 #pragma once
 
+#include "erhe_rendergraph/transient_texture_pool.hpp"
 #include "erhe_profile/profile.hpp"
 
 #include <mutex>
@@ -28,7 +29,8 @@ public:
     auto connect        (int key, Rendergraph_node* source_node, Rendergraph_node* sink_node) -> bool;
     auto disconnect     (int key, Rendergraph_node* source_node, Rendergraph_node* sink_node) -> bool;
 
-    [[nodiscard]] auto get_graphics_instance() -> erhe::graphics::Instance&;
+    [[nodiscard]] auto get_graphics_instance     () -> erhe::graphics::Instance&;
+    [[nodiscard]] auto get_transient_texture_pool() -> Transient_texture_pool&;
 
     void automatic_layout(float image_size);
 
@@ -36,9 +38,12 @@ public:
     float y_gap{100.0f};
 
 private:
+    void allocate_transient_textures();
+
     erhe::graphics::Instance&      m_graphics_instance;
     ERHE_PROFILE_MUTEX(std::mutex, m_mutex);
     std::vector<Rendergraph_node*> m_nodes;
+    Transient_texture_pool         m_transient_texture_pool;
 };
 
 } // namespace erhe::rendergraph
@@ -7,6 +7,8 @@
 #include "erhe_graphics/texture.hpp"
 #include "erhe_verify/verify.hpp"
 
+#include <algorithm>
+
 namespace erhe::rendergraph {
 
 Rendergraph_node::Rendergraph_node(Rendergraph& rendergraph, const std::string_view name)
@@ -492,6 +494,64 @@ auto Rendergraph_node::outputs_allowed() const -> bool
     return true;
 }
 
+auto Rendergraph_node::get_execution_index() const -> int
+{
+    return m_execution_index;
+}
+
+auto Rendergraph_node::get_first_use_execution_index(const int key, const int depth) const -> int
+{
+    ERHE_VERIFY(depth < rendergraph_max_depth);
+
+    int first_use = m_execution_index;
+    for (const Rendergraph_consumer_connector& input : m_inputs) {
+        if (input.key != key) {
+            continue;
+        }
+        for (const Rendergraph_node* producer_node : input.producer_nodes) {
+            // Disabled nodes pass resources through from their own producers
+            const int producer_first_use = producer_node->is_enabled()
+                ? producer_node->get_execution_index()
+                : producer_node->get_first_use_execution_index(key, depth + 1);
+            first_use = std::min(first_use, producer_first_use);
+        }
+    }
+    return first_use;
+}
+
+auto Rendergraph_node::get_last_use_execution_index(const int key, const int depth) const -> int
+{
+    ERHE_VERIFY(depth < rendergraph_max_depth);
+
+    int last_use = m_execution_index;
+    for (const Rendergraph_producer_connector& output : m_outputs) {
+        if (output.key != key) {
+            continue;
+        }
+        for (const Rendergraph_node* consumer_node : output.consumer_nodes) {
+            // Disabled nodes pass resources through to their own consumers
+            const int consumer_last_use = consumer_node->is_enabled()
+                ? consumer_node->get_execution_index()
+                : consumer_node->get_last_use_execution_index(key, depth + 1);
+            last_use = std::max(last_use, consumer_last_use);
+        }
+    }
+    return last_use;
+}
+
+void Rendergraph_node::set_execution_index(const int index)
+{
+    m_execution_index = index;
+}
+
+void Rendergraph_node::request_transient_textures(Transient_texture_pool&)
+{
+}
+
+void Rendergraph_node::bind_transient_textures(const Transient_texture_pool&)
+{
+}
+
 void Rendergraph_node::set_depth(int depth)
 {
     m_depth = depth;
@@ -22,6 +22,7 @@ namespace erhe::rendergraph {
 
 class Rendergraph;
 class Rendergraph_node;
+class Transient_texture_pool;
 
 class Rendergraph_id
 {
@@ -99,6 +100,15 @@ public:
     [[nodiscard]] auto get_position() const -> glm::vec2;
     [[nodiscard]] auto get_selected() const -> bool;
 
+    // Index in sorted execution order, valid during Rendergraph::execute()
+    [[nodiscard]] auto get_execution_index          () const -> int;
+    // Earliest execution index of this node and producers of input key
+    [[nodiscard]] auto get_first_use_execution_index(int key, int depth = 0) const -> int;
+    // Latest execution index of this node and consumers of output key
+    [[nodiscard]] auto get_last_use_execution_index (int key, int depth = 0) const -> int;
+
+    void set_execution_index(int index);
+
     void set_depth        (int depth);
     void set_position     (glm::vec2 position);
     void set_selected     (bool selected);
@@ -113,6 +123,11 @@ public:
 
     virtual void execute_rendergraph_node() = 0;
 
+    // Called for enabled nodes in execution order, before any node is executed.
+    // Textures requested from the pool are available in bind_transient_textures().
+    virtual void request_transient_textures(Transient_texture_pool& pool);
+    virtual void bind_transient_textures   (const Transient_texture_pool& pool);
+
     [[nodiscard]] virtual auto get_consumer_input_node        (Routing resource_routing, int key, int depth = 0) const -> Rendergraph_node*;
     [[nodiscard]] virtual auto get_consumer_input_texture     (Routing resource_routing, int key, int depth = 0) const -> std::shared_ptr<erhe::graphics::Texture>;
     [[nodiscard]] virtual auto get_consumer_input_framebuffer (Routing resource_routing, int key, int depth = 0) const -> std::shared_ptr<erhe::graphics::Framebuffer>;
@@ -133,6 +148,7 @@ protected:
     std::vector<Rendergraph_consumer_connector> m_inputs;
     std::vector<Rendergraph_producer_connector> m_outputs;
     int                                         m_depth   {0};
+    int                                         m_execution_index{-1};
 
     // For GUI
     glm::vec2                                   m_position{};
@@ -7,7 +7,6 @@
 #include "erhe_gl/wrapper_enums.hpp"
 #include "erhe_gl/wrapper_functions.hpp"
 #include "erhe_graphics/framebuffer.hpp"
-#include "erhe_graphics/renderbuffer.hpp"
 #include "erhe_graphics/texture.hpp"
 #include "erhe_verify/verify.hpp"
 
@@ -87,7 +86,34 @@ auto Texture_rendergraph_node::get_producer_output_framebuffer(Routing, int, int
     return m_framebuffer;
 }
 
-void Texture_rendergraph_node::execute_rendergraph_node()
+void Texture_rendergraph_node::request_transient_textures(Transient_texture_pool& pool)
+{
+    m_depth_stencil_request = Transient_texture_pool::c_no_request;
+    if (m_depth_stencil_format == gl::Internal_format{0}) {
+        return;
+    }
+
+    const auto& output_viewport = get_producer_output_viewport(Routing::Resource_provided_by_consumer, m_output_key);
+    if ((output_viewport.width < 1) || (output_viewport.height < 1)) {
+        return;
+    }
+
+    // Depth-stencil is used by producers rendering to this node, by derived
+    // node itself, and by consumers which render to or sample the framebuffer
+    m_depth_stencil_request = pool.request(
+        Transient_texture_desc{
+            .target          = gl::Texture_target::texture_2d,
+            .internal_format = m_depth_stencil_format,
+            .sample_count    = 0,
+            .width           = output_viewport.width,
+            .height          = output_viewport.height
+        },
+        get_first_use_execution_index(m_input_key),
+        get_last_use_execution_index(m_output_key)
+    );
+}
+
+void Texture_rendergraph_node::bind_transient_textures(const Transient_texture_pool& pool)
 {
     using erhe::graphics::Framebuffer;
     using erhe::graphics::Texture;
@@ -99,7 +125,9 @@ void Texture_rendergraph_node::execute_rendergraph_node()
         return;
     }
 
-    // Resize framebuffer if necessary
+    bool framebuffer_dirty = !m_framebuffer;
+
+    // Resize color texture if necessary
     if (
         !m_color_texture ||
         (m_color_texture->width () != output_viewport.width ) ||
@@ -134,65 +162,45 @@ void Texture_rendergraph_node::execute_rendergraph_node()
         } else {
             // TODO
         }
+        framebuffer_dirty = true;
+    }
 
-        if (m_depth_stencil_format == gl::Internal_format{0}) {
-            m_depth_stencil_renderbuffer.reset();
-        } else {
-            m_depth_stencil_renderbuffer = std::make_unique<erhe::graphics::Renderbuffer>(
-                graphics_instance,
-                m_depth_stencil_format,
-                output_viewport.width,
-                output_viewport.height
-            );
-
-            m_depth_stencil_renderbuffer->set_debug_label(
-                fmt::format("{} Texture_rendergraph_node depth-stencil renderbuffer", get_name())
-            );
-        }
+    std::shared_ptr<Texture> depth_stencil_texture = pool.get(m_depth_stencil_request);
+    if (depth_stencil_texture != m_depth_stencil_texture) {
+        m_depth_stencil_texture = std::move(depth_stencil_texture);
+        framebuffer_dirty = true;
+    }
 
-        {
-            Framebuffer::Create_info create_info;
-            create_info.attach(gl::Framebuffer_attachment::color_attachment0, m_color_texture.get());
-
-            if (m_depth_stencil_renderbuffer) {
-                if (gl_helpers::has_depth(m_depth_stencil_format)) {
-                    create_info.attach(
-                        gl::Framebuffer_attachment::depth_attachment,
-                        m_depth_stencil_renderbuffer.get()
-                    );
-                }
-                if (gl_helpers::has_stencil(m_depth_stencil_format)) {
-                    create_info.attach(
-                        gl::Framebuffer_attachment::stencil_attachment,
-                        m_depth_stencil_renderbuffer.get()
-                    );
-                }
-            }
-            m_framebuffer = std::make_unique<Framebuffer>(create_info);
-            m_framebuffer->set_debug_label(
-                fmt::format("{} Texture_rendergraph_node framebuffer", get_name())
-            );
-
-            gl::Color_buffer draw_buffers[] = { gl::Color_buffer::color_attachment0 };
-            gl::named_framebuffer_draw_buffers(m_framebuffer->gl_name(), 1, &draw_buffers[0]);
-            gl::named_framebuffer_read_buffer(m_framebuffer->gl_name(), gl::Color_buffer::color_attachment0);
-
-            if (!m_framebuffer->check_status()) {
-                log_tail->error("{} Texture_rendergraph_node framebuffer not complete", get_name());
-                m_framebuffer.reset();
-            }
+    if (!framebuffer_dirty) {
+        return;
+    }
+
+    Framebuffer::Create_info create_info;
+    create_info.attach(gl::Framebuffer_attachment::color_attachment0, m_color_texture.get());
+    if (m_depth_stencil_texture) {
+        if (gl_helpers::has_depth(m_depth_stencil_format)) {
+            create_info.attach(gl::Framebuffer_attachment::depth_attachment, m_depth_stencil_texture.get());
         }
+        if (gl_helpers::has_stencil(m_depth_stencil_format)) {
+            create_info.attach(gl::Framebuffer_attachment::stencil_attachment, m_depth_stencil_texture.get());
+        }
+    }
+    m_framebuffer = std::make_shared<Framebuffer>(create_info);
+    m_framebuffer->set_debug_label(fmt::format("{} Texture_rendergraph_node framebuffer", get_name()));
 
-        // TODO initial clear?
-        //const float clear_value[4] = { 1.0f, 0.0f, 1.0f, 1.0f };
-        //gl::clear_tex_image(
-        //    texture->gl_name(),
-        //    0,
-        //    gl::Pixel_format::rgba,
-        //    gl::Pixel_type::float_,
-        //    &clear_value[0]
-        //);
+    gl::Color_buffer draw_buffers[] = { gl::Color_buffer::color_attachment0 };
+    gl::named_framebuffer_draw_buffers(m_framebuffer->gl_name(), 1, &draw_buffers[0]);
+    gl::named_framebuffer_read_buffer(m_framebuffer->gl_name(), gl::Color_buffer::color_attachment0);
+
+    if (!m_framebuffer->check_status()) {
+        log_tail->error("{} Texture_rendergraph_node framebuffer not complete", get_name());
+        m_framebuffer.reset();
     }
 }
 
+void Texture_rendergraph_node::execute_rendergraph_node()
+{
+    // Texture and framebuffer are updated in bind_transient_textures()
+}
+
 } // namespace erhe::rendergraph
@@ -1,7 +1,9 @@
 #pragma once
 
 #include "erhe_rendergraph/rendergraph_node.hpp"
+#include "erhe_rendergraph/transient_texture_pool.hpp"
 #include "erhe_gl/wrapper_enums.hpp"
+#include <cstddef>
 #include <memory>
 #include <mutex>
 #include <string_view>
@@ -9,7 +11,6 @@
 namespace erhe::graphics {
     class Framebuffer;
     class Instance;
-    class Renderbuffer;
     class Texture;
 }
 
@@ -31,6 +32,9 @@ public:
 /// The texture is not multisampled (at least for now). In order to
 /// add multisampling, use a separate Multisample_resolve node in
 /// front of Texture_rendergraph_node.
+/// The color texture is kept between frames, as it is typically shown by
+/// ImGui. Depth-stencil is transient, and kept until consumers of the
+/// output have executed.
 /// </summary>
 class Texture_rendergraph_node : public Rendergraph_node
 {
@@ -50,16 +54,19 @@ public:
     auto get_consumer_input_framebuffer (Routing resource_routing, int key, int depth = 0) const -> std::shared_ptr<erhe::graphics::Framebuffer> override;
     auto get_producer_output_texture    (Routing resource_routing, int key, int depth = 0) const -> std::shared_ptr<erhe::graphics::Texture> override;
     auto get_producer_output_framebuffer(Routing resource_routing, int key, int depth = 0) const -> std::shared_ptr<erhe::graphics::Framebuffer> override;
+    void request_transient_textures     (Transient_texture_pool& pool) override;
+    void bind_transient_textures        (const Transient_texture_pool& pool) override;
     void execute_rendergraph_node       () override;
 
 protected:
-    int                                           m_input_key;
-    int                                           m_output_key;
-    gl::Internal_format                           m_color_format;
-    gl::Internal_format                           m_depth_stencil_format;
-    std::shared_ptr<erhe::graphics::Texture>      m_color_texture;
-    std::unique_ptr<erhe::graphics::Renderbuffer> m_depth_stencil_renderbuffer;
-    std::shared_ptr<erhe::graphics::Framebuffer>  m_framebuffer;
+    int                                          m_input_key;
+    int                                          m_output_key;
+    gl::Internal_format                          m_color_format;
+    gl::Internal_format                          m_depth_stencil_format;
+    std::shared_ptr<erhe::graphics::Texture>     m_color_texture;
+    std::shared_ptr<erhe::graphics::Texture>     m_depth_stencil_texture;
+    std::shared_ptr<erhe::graphics::Framebuffer> m_framebuffer;
+    std::size_t                                  m_depth_stencil_request{Transient_texture_pool::c_no_request};
 };
 
 } // namespace erhe::rendergraph
@@ -0,0 +1,212 @@
+#include "erhe_rendergraph/transient_texture_pool.hpp"
+
+#include "erhe_rendergraph/rendergraph_log.hpp"
+#include "erhe_gl/enum_string_functions.hpp"
+#include "erhe_gl/gl_helpers.hpp"
+#include "erhe_graphics/texture.hpp"
+#include "erhe_profile/profile.hpp"
+#include "erhe_verify/verify.hpp"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+
+namespace erhe::rendergraph {
+
+namespace {
+
+[[nodiscard]] auto get_pixel_byte_count(const gl::Internal_format internal_format) -> std::size_t
+{
+    switch (internal_format) {
+        case gl::Internal_format::depth_component16:  return 2;
+        case gl::Internal_format::depth_component24:  return 4;
+        case gl::Internal_format::depth_component32f: return 4;
+        case gl::Internal_format::depth24_stencil8:   return 4;
+        case gl::Internal_format::depth32f_stencil8:  return 8;
+        case gl::Internal_format::stencil_index8:     return 1;
+        default: {
+            if (gl_helpers::has_depth(internal_format) || gl_helpers::has_stencil(internal_format)) {
+                return 4;
+            }
+            return erhe::graphics::get_upload_pixel_byte_count(internal_format);
+        }
+    }
+}
+
+[[nodiscard]] auto get_byte_count(const Transient_texture_desc& desc) -> std::size_t
+{
+    const std::size_t level0_byte_count =
+        static_cast<std::size_t>(desc.width) *
+        static_cast<std::size_t>(desc.height) *
+        static_cast<std::size_t>(std::max(desc.sample_count, 1)) *
+        get_pixel_byte_count(desc.internal_format);
+
+    // Full mipmap chain adds about one third
+    return desc.use_mipmaps ? level0_byte_count + level0_byte_count / 3 : level0_byte_count;
+}
+
+} // anonymous namespace
+
+Transient_texture_pool::Transient_texture_pool(erhe::graphics::Instance& graphics_instance)
+    : m_graphics_instance{graphics_instance}
+{
+}
+
+Transient_texture_pool::~Transient_texture_pool() noexcept = default;
+
+void Transient_texture_pool::begin_frame()
+{
+    ++m_frame;
+    m_requests.clear();
+}
+
+auto Transient_texture_pool::request(const Transient_texture_desc& desc, const int first_use, const int last_use) -> std::size_t
+{
+    ERHE_VERIFY(first_use <= last_use);
+    ERHE_VERIFY((desc.width >= 1) && (desc.height >= 1));
+
+    const std::size_t index = m_requests.size();
+    m_requests.push_back(
+        Request{
+            .desc      = desc,
+            .first_use = first_use,
+            .last_use  = last_use,
+            .entry     = c_no_request
+        }
+    );
+    return index;
+}
+
+auto Transient_texture_pool::find_entry(const Request& request) const -> std::size_t
+{
+    // First fit keeps assignments stable from frame to frame while the
+    // requests stay the same.
+    for (std::size_t i = 0, end = m_entries.size(); i < end; ++i) {
+        const Entry& entry = m_entries[i];
+        if (entry.desc != request.desc) {
+            continue;
+        }
+        const bool unused_this_frame = entry.frame != m_frame;
+        if (unused_this_frame || (entry.last_use < request.first_use)) {
+            return i;
+        }
+    }
+    return c_no_request;
+}
+
+auto Transient_texture_pool::create_entry(const Transient_texture_desc& desc) -> std::size_t
+{
+    using erhe::graphics::Texture;
+
+    const std::size_t index = m_entries.size();
+    Entry& entry = m_entries.emplace_back();
+    entry.desc       = desc;
+    entry.byte_count = get_byte_count(desc);
+    entry.texture    = std::make_shared<Texture>(
+        Texture::Create_info{
+            .instance        = m_graphics_instance,
+            .target          = desc.target,
+            .internal_format = desc.internal_format,
+            .use_mipmaps     = desc.use_mipmaps,
+            .sample_count    = desc.sample_count,
+            .width           = desc.width,
+            .height          = desc.height,
+            .debug_label     = fmt::format(
+                "Transient {} {}x{} samples = {}",
+                gl::c_str(desc.internal_format),
+                desc.width,
+                desc.height,
+                desc.sample_count
+            )
+        }
+    );
+    ++m_statistics.created_count;
+    log_tail->trace("Created transient texture '{}'", entry.texture->debug_label());
+    return index;
+}
+
+void Transient_texture_pool::allocate()
+{
+    ERHE_PROFILE_FUNCTION();
+
+    // Greedy assignment in order of first use is optimal for interval
+    // overlap; ties keep request order so results are deterministic.
+    m_request_order.resize(m_requests.size());
+    for (std::size_t i = 0, end = m_requests.size(); i < end; ++i) {
+        m_request_order[i] = i;
+    }
+    std::stable_sort(
+        m_request_order.begin(),
+        m_request_order.end(),
+        [this](const std::size_t lhs, const std::size_t rhs) {
+            return m_requests[lhs].first_use < m_requests[rhs].first_use;
+        }
+    );
+
+    std::size_t requested_byte_count = 0;
+    for (const std::size_t request_index : m_request_order) {
+        Request&    request     = m_requests[request_index];
+        std::size_t entry_index = find_entry(request);
+        if (entry_index == c_no_request) {
+            entry_index = create_entry(request.desc);
+        }
+        Entry& entry = m_entries[entry_index];
+        entry.last_use = request.last_use;
+        entry.frame    = m_frame;
+        request.entry  = entry_index;
+        requested_byte_count += entry.byte_count;
+    }
+
+    // Release textures not used this frame. Nodes which still hold a
+    // reference to a released texture keep it alive until they rebind.
+    std::size_t write_index = 0;
+    for (std::size_t read_index = 0, end = m_entries.size(); read_index < end; ++read_index) {
+        if (m_entries[read_index].frame != m_frame) {
+            log_tail->trace("Released transient texture '{}'", m_entries[read_index].texture->debug_label());
+            ++m_statistics.released_count;
+            continue;
+        }
+        if (write_index != read_index) {
+            m_entries[write_index] = std::move(m_entries[read_index]);
+            for (Request& request : m_requests) {
+                if (request.entry == read_index) {
+                    request.entry = write_index;
+                }
+            }
+        }
+        ++write_index;
+    }
+    m_entries.resize(write_index);
+
+    std::size_t allocated_byte_count = 0;
+    for (const Entry& entry : m_entries) {
+        allocated_byte_count += entry.byte_count;
+    }
+    m_statistics.request_count        = m_requests.size();
+    m_statistics.texture_count        = m_entries.size();
+    m_statistics.requested_byte_count = requested_byte_count;
+    m_statistics.allocated_byte_count = allocated_byte_count;
+    m_statistics.peak_byte_count      = std::max(m_statistics.peak_byte_count, allocated_byte_count);
+
+    ERHE_PROFILE_PLOT("Transient texture bytes",  static_cast<int64_t>(allocated_byte_count));
+    ERHE_PROFILE_PLOT("Transient requested bytes", static_cast<int64_t>(requested_byte_count));
+}
+
+auto Transient_texture_pool::get(const std::size_t request) const -> std::shared_ptr<erhe::graphics::Texture>
+{
+    if (request >= m_requests.size()) {
+        return {};
+    }
+    const std::size_t entry_index = m_requests[request].entry;
+    if (entry_index >= m_entries.size()) {
+        return {};
+    }
+    return m_entries[entry_index].texture;
+}
+
+auto Transient_texture_pool::get_statistics() const -> const Statistics&
+{
+    return m_statistics;
+}
+
+} // namespace erhe::rendergraph
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "erhe_gl/wrapper_enums.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace erhe::graphics {
+    class Instance;
+    class Texture;
+}
+
+namespace erhe::rendergraph {
+
+class Transient_texture_desc
+{
+public:
+    [[nodiscard]] auto operator==(const Transient_texture_desc& other) const -> bool = default;
+
+    gl::Texture_target  target         {gl::Texture_target::texture_2d};
+    gl::Internal_format internal_format{gl::Internal_format::rgba16f};
+    int                 sample_count   {0};
+    int                 width          {0};
+    int                 height         {0};
+    bool                use_mipmaps    {false};
+};
+
+/// <summary>
+/// Pool of render targets which are only needed during rendergraph execution.
+/// </summary>
+/// Rendergraph nodes request textures before nodes are executed. Lifetime of
+/// each request is given as a range of node execution indices. Requests with
+/// equal descriptions and non-overlapping lifetimes share the same texture.
+/// Textures which were not used in the last frame are released.
+class Transient_texture_pool
+{
+public:
+    static constexpr std::size_t c_no_request   = ~std::size_t{0};
+    static constexpr int         c_end_of_frame = std::numeric_limits<int>::max(); // last_use for textures read after rendergraph execution, such as by ImGui
+
+    class Statistics
+    {
+    public:
+        std::size_t request_count       {0};
+        std::size_t texture_count       {0};
+        std::size_t requested_byte_count{0}; // what requests would use without aliasing
+        std::size_t allocated_byte_count{0};
+        std::size_t peak_byte_count     {0};
+        std::size_t created_count       {0}; // total since start
+        std::size_t released_count      {0}; // total since start
+    };
+
+    explicit Transient_texture_pool(erhe::graphics::Instance& graphics_instance);
+    ~Transient_texture_pool() noexcept;
+
+    void begin_frame();
+
+    // first_use and last_use are execution indices of nodes accessing the texture
+    [[nodiscard]] auto request(const Transient_texture_desc& desc, int first_use, int last_use) -> std::size_t;
+
+    // Assigns textures to requests, creating and releasing textures as needed
+    void allocate();
+
+    // Valid after allocate(), until next begin_frame()
+    [[nodiscard]] auto get(std::size_t request) const -> std::shared_ptr<erhe::graphics::Texture>;
+
+    [[nodiscard]] auto get_statistics() const -> const Statistics&;
+
+private:
+    class Entry
+    {
+    public:
+        Transient_texture_desc                   desc;
+        std::shared_ptr<erhe::graphics::Texture> texture;
+        std::size_t                              byte_count{0};
+        int                                      last_use  {-1};
+        uint64_t                                 frame     {0};
+    };
+
+    class Request
+    {
+    public:
+        Transient_texture_desc desc;
+        int                    first_use{0};
+        int                    last_use {0};
+        std::size_t            entry    {c_no_request};
+    };
+
+    [[nodiscard]] auto find_entry  (const Request& request) const -> std::size_t;
+    [[nodiscard]] auto create_entry(const Transient_texture_desc& desc) -> std::size_t;
+
+    erhe::graphics::Instance& m_graphics_instance;
+    std::vector<Entry>        m_entries;
+    std::vector<Request>      m_requests;
+    std::vector<std::size_t>  m_request_order;
+    uint64_t                  m_frame{0};
+    Statistics                m_statistics;
+};
+
+} // namespace erhe::rendergraph
@@ -277,6 +277,9 @@ void Animation_sampler::apply(Animation_channel& channel, const float time_curre
             break;
         }
     }
+
+    // Picked up by next Scene::update_node_transforms()
+    channel.target->mark_transform_dirty();
 }
 
 //
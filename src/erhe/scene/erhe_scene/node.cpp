@@ -257,8 +257,18 @@ void Node::handle_parent_update(erhe::Hierarchy* const old_parent_item, erhe::Hi
     Node* const new_parent = static_cast<Node* const>(new_parent_item);
     erhe::Item_host* const old_item_host = (old_parent != nullptr) ? old_parent->get_item_host() : nullptr;
     erhe::Item_host* const new_item_host = (new_parent != nullptr) ? new_parent->get_item_host() : nullptr;
+
+    // World transform is relative to the old parent; serial comparison in
+    // update_world_from_parent() alone cannot tell that the parent changed
+    mark_transform_dirty();
+
     if (old_item_host != new_item_host) {
         handle_item_host_update(old_item_host, new_item_host);
+    } else {
+        Scene* scene = get_scene();
+        if (scene != nullptr) {
+            scene->invalidate_node_order(); // Depth of this subtree may have changed
+        }
     }
 
     hierarchy_sanity_check();
@@ -343,11 +353,6 @@ void Node::update_transform(uint64_t serial)
             return;
         }
 
-        serial = std::max(serial, current_parent->node_data.transforms.parent_from_node_serial);
-
-        // if (node_data.transforms.update_serial >= serial) {
-        //     return;
-        // }
         if (is_shown_in_ui()) {
             log_frame->trace("{} TX update parent {}", get_name(), current_parent->get_name());
         }
@@ -360,6 +365,30 @@ void Node::update_transform(uint64_t serial)
     }
 }
 
+// Used by Scene::update_node_transforms(), which may call this from worker
+// threads for nodes of the same depth. Attachments are not notified here.
+auto Node::update_world_from_parent(const Node& parent, const uint64_t serial) -> bool
+{
+    Node_transforms& transforms = node_data.transforms;
+    if (
+        (transforms.world_from_node_serial != 0) &&
+        (transforms.world_from_node_serial >= parent.node_data.transforms.world_from_node_serial)
+    ) {
+        return false;
+    }
+    transforms.world_from_node.set(
+        parent.world_from_node() * parent_from_node(),
+        node_from_parent() * parent.node_from_world()
+    );
+    transforms.world_from_node_serial = serial;
+    return true;
+}
+
+void Node::mark_transform_dirty()
+{
+    node_data.transforms.world_from_node_serial = 0;
+}
+
 void Node::update_world_from_node()
 {
     const auto& current_parent = get_parent_node();
@@ -24,7 +24,7 @@ class Node_transforms
 {
 public:
     mutable std::uint64_t parent_from_node_serial{0}; // update needed if 0
-    mutable std::uint64_t world_from_node_serial {0}; // update needed if 0
+    mutable std::uint64_t world_from_node_serial {0}; // update needed if 0, or if older than parent world_from_node_serial
 
     // One of these is normative, and the other is calculated by update_transform()
     Trs_transform         parent_from_node;
@@ -130,6 +130,10 @@ public:
     void set_node_from_world   (const glm::mat4 node_from_world);
     void set_node_from_world   (const Transform& node_from_world);
 
+    // Dirty tracking for Scene::update_node_transforms()
+    auto update_world_from_parent(const Node& parent, uint64_t serial) -> bool;
+    void mark_transform_dirty    ();
+
     Node_data node_data;
 };
 
@@ -11,6 +11,8 @@
 #include "erhe_profile/profile.hpp"
 #include "erhe_verify/verify.hpp"
 
+#include <taskflow/taskflow.hpp>
+
 #include <algorithm>
 
 namespace erhe::scene {
@@ -251,10 +253,32 @@ void Scene::sort_transform_nodes()
             return lhs->get_depth() < rhs->get_depth();
         }
     );
+
+    const std::size_t node_count = m_flat_node_vector.size();
+    m_flat_node_parents.resize(node_count);
+    m_depth_level_offsets.clear();
+    for (std::size_t i = 0; i < node_count; ++i) {
+        const Node* node = m_flat_node_vector[i].get();
+        m_flat_node_parents[i] = static_cast<Node*>(node->get_parent().lock().get());
+        if ((i == 0) || (node->get_depth() != m_flat_node_vector[i - 1]->get_depth())) {
+            m_depth_level_offsets.push_back(i);
+        }
+    }
+    m_depth_level_offsets.push_back(node_count);
     m_nodes_sorted = true;
 }
 
-void Scene::update_node_transforms()
+void Scene::invalidate_node_order()
+{
+    m_nodes_sorted = false;
+}
+
+auto Scene::get_transform_update_count() const -> std::size_t
+{
+    return m_transform_update_count;
+}
+
+void Scene::update_node_transforms(tf::Executor* const executor)
 {
     ERHE_PROFILE_FUNCTION();
 
@@ -262,12 +286,72 @@ void Scene::update_node_transforms()
         sort_transform_nodes();
     }
 
-    for (auto& node : m_flat_node_vector) {
-        if (node->is_no_transform_update()) {
+    // Nodes at the same depth only read transforms from the previous depth
+    // level, so each level can be processed in parallel.
+    static constexpr std::size_t parallel_level_min_node_count = 2048;
+    static constexpr std::size_t parallel_chunk_node_count     = 512;
+
+    // The global serial is only advanced when some node was updated, so an
+    // unchanged scene does not look changed to serial observers
+    const std::size_t node_count = m_flat_node_vector.size();
+    const uint64_t    serial     = Node_transforms::get_current_serial() + 1;
+    m_transform_updated.resize(node_count);
+
+    const auto update_range = [this, serial](const std::size_t begin, const std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            Node*       node   = m_flat_node_vector[i].get();
+            const Node* parent = m_flat_node_parents[i];
+            const bool  updated =
+                (parent != nullptr) &&
+                !node->is_no_transform_update() &&
+                node->update_world_from_parent(*parent, serial);
+            m_transform_updated[i] = updated ? 1 : 0;
+        }
+    };
+
+    for (std::size_t level = 0; level + 1 < m_depth_level_offsets.size(); ++level) {
+        const std::size_t begin = m_depth_level_offsets[level];
+        const std::size_t end   = m_depth_level_offsets[level + 1];
+        if ((executor == nullptr) || (end - begin < parallel_level_min_node_count)) {
+            update_range(begin, end);
             continue;
         }
-        node->update_transform(0);
+
+        ERHE_PROFILE_SCOPE("parallel level");
+        tf::Taskflow taskflow;
+        taskflow.for_each_index(
+            begin, end, parallel_chunk_node_count,
+            [&update_range, end](const std::size_t chunk_begin) {
+                update_range(chunk_begin, std::min(chunk_begin + parallel_chunk_node_count, end));
+            }
+        );
+        if (executor->this_worker_id() >= 0) {
+            executor->corun(taskflow);
+        } else {
+            executor->run(taskflow).wait();
+        }
     }
+
+    const bool any_updated = std::any_of(
+        m_transform_updated.begin(),
+        m_transform_updated.begin() + node_count,
+        [](const uint8_t updated) { return updated != 0; }
+    );
+    m_transform_update_count = 0;
+    if (!any_updated) {
+        return;
+    }
+    static_cast<void>(Node_transforms::get_next_serial()); // commits serial used above
+
+    // Attachments are notified on this thread, parents before children
+    std::size_t update_count = 0;
+    for (std::size_t i = 0; i < node_count; ++i) {
+        if (m_transform_updated[i] != 0) {
+            m_flat_node_vector[i]->handle_transform_update(serial);
+            ++update_count;
+        }
+    }
+    m_transform_update_count = update_count;
 }
 
 Scene::Scene(const Scene& src)
@@ -368,6 +452,7 @@ void Scene::unregister_node(const std::shared_ptr<erhe::scene::Node>& node)
     } else {
         node->node_data.host = nullptr;
         m_flat_node_vector.erase(i, m_flat_node_vector.end());
+        m_nodes_sorted = false;
     }
 
 #if !defined(NDEBUG)
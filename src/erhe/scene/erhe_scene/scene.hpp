@@ -11,6 +11,10 @@
 #include <string_view>
 #include <vector>
 
+namespace tf {
+    class Executor;
+}
+
 namespace erhe::scene {
 
 class Camera;
@@ -78,7 +82,13 @@ public:
     // Public API
     void sanity_check          () const;
     void sort_transform_nodes  ();
-    void update_node_transforms();
+    void invalidate_node_order ();
+
+    // Recomputes world transforms of nodes under changed nodes only. Depth
+    // levels are processed in order, large levels in parallel using executor.
+    void update_node_transforms(tf::Executor* executor = nullptr);
+
+    [[nodiscard]] auto get_transform_update_count() const -> std::size_t; // from last update_node_transforms()
 
     [[nodiscard]] auto get_mesh_by_id       (erhe::Unique_id<Node>::id_type id) const -> std::shared_ptr<Mesh>;
     [[nodiscard]] auto get_light_by_id      (erhe::Unique_id<Node>::id_type id) const -> std::shared_ptr<Light>;
@@ -115,7 +125,11 @@ private:
     Scene_message_bus&                        m_message_bus;
     Scene_host*                               m_host       {nullptr};
     std::shared_ptr<erhe::scene::Node>        m_root_node;
-    std::vector<std::shared_ptr<Node>>        m_flat_node_vector;
+    std::vector<std::shared_ptr<Node>>        m_flat_node_vector;    // sorted by depth when m_nodes_sorted
+    std::vector<Node*>                        m_flat_node_parents;   // parallel to m_flat_node_vector
+    std::vector<std::size_t>                  m_depth_level_offsets; // first index of each depth level, and end
+    std::vector<uint8_t>                      m_transform_updated;   // parallel to m_flat_node_vector
+    std::size_t                               m_transform_update_count{0};
     std::vector<std::shared_ptr<Mesh_layer>>  m_mesh_layers;
     std::vector<std::shared_ptr<Skin>>        m_skins;
     std::vector<std::shared_ptr<Light_layer>> m_light_layers;
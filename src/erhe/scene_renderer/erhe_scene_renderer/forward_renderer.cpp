@@ -2,6 +2,7 @@
 
 #include "erhe_scene_renderer/forward_renderer.hpp"
 
+#include "erhe_configuration/configuration.hpp"
 #include "erhe_gl/draw_indirect.hpp"
 #include "erhe_gl/wrapper_functions.hpp"
 #include "erhe_graphics/buffer.hpp"
@@ -50,6 +51,32 @@ Forward_renderer::Forward_renderer(erhe::graphics::Instance& graphics_instance,
     erhe::graphics::Scoped_debug_group forward_renderer_initialization{c_forward_renderer_initialize_component};
 
     m_dummy_texture = graphics_instance.create_dummy_texture();
+
+    const auto& ini = erhe::configuration::get_ini_file_section("erhe.ini", "renderer");
+    ini.get("instancing", m_use_instancing);
+}
+
+void Forward_renderer::set_instancing_enabled(const bool enabled)
+{
+    m_use_instancing = enabled;
+}
+
+auto Forward_renderer::is_instancing_enabled() const -> bool
+{
+    return m_use_instancing;
+}
+
+void Forward_renderer::end_frame()
+{
+    m_statistics       = m_frame_statistics;
+    m_frame_statistics = Statistics{};
+    ERHE_PROFILE_PLOT("Forward renderer draw commands", static_cast<int64_t>(m_statistics.draw_command_count));
+    ERHE_PROFILE_PLOT("Forward renderer instances",     static_cast<int64_t>(m_statistics.instance_count));
+}
+
+auto Forward_renderer::get_statistics() const -> const Statistics&
+{
+    return m_statistics;
 }
 
 static constexpr std::string_view c_forward_renderer_render{"Forward_renderer::render()"};
@@ -97,6 +124,35 @@ void Forward_renderer::render(const Render_parameters& parameters)
 
     gl::viewport(viewport.x, viewport.y, viewport.width, viewport.height);
 
+    // Cull once for all passes; culled meshes skip primitive and draw indirect writes
+    m_visible_mesh_spans.clear();
+    if ((camera != nullptr) && parameters.culling.enabled) {
+        ERHE_PROFILE_SCOPE("cull");
+        const glm::mat4 clip_from_world = camera->projection_transforms(viewport).clip_from_world.get_matrix();
+        const glm::vec3 view_position   = glm::vec3{camera->get_node()->position_in_world()};
+        if (m_mesh_cullings.size() < mesh_spans.size()) {
+            m_mesh_cullings.resize(mesh_spans.size());
+        }
+        for (std::size_t i = 0, end = mesh_spans.size(); i < end; ++i) {
+            m_visible_mesh_spans.push_back(
+                m_mesh_cullings[i].cull(mesh_spans[i], clip_from_world, view_position, parameters.culling, parameters.executor)
+            );
+        }
+    } else {
+        m_visible_mesh_spans.insert(m_visible_mesh_spans.end(), mesh_spans.begin(), mesh_spans.end());
+    }
+
+    // Group meshes once for all passes
+    if (m_use_instancing) {
+        ERHE_PROFILE_SCOPE("instance batches");
+        if (m_instance_batches.size() < m_visible_mesh_spans.size()) {
+            m_instance_batches.resize(m_visible_mesh_spans.size());
+        }
+        for (std::size_t i = 0, end = m_visible_mesh_spans.size(); i < end; ++i) {
+            m_instance_batches[i].build(m_visible_mesh_spans[i], filter);
+        }
+    }
+
     using Buffer_range = erhe::renderer::Buffer_range;
     std::optional<Buffer_range> camera_buffer_range{};
     if (camera != nullptr) {
@@ -174,23 +230,48 @@ void Forward_renderer::render(const Render_parameters& parameters)
         m_graphics_instance.opengl_state_tracker.vertex_input.set_vertex_buffer(0, parameters.vertex_buffer0, 0);
         m_graphics_instance.opengl_state_tracker.vertex_input.set_vertex_buffer(1, parameters.vertex_buffer1, 0);
 
-        for (const auto& meshes : mesh_spans) {
+        for (std::size_t span_index = 0, end = m_visible_mesh_spans.size(); span_index < end; ++span_index) {
             ERHE_PROFILE_SCOPE("mesh span");
             //ERHE_PROFILE_GPU_SCOPE(c_forward_renderer_render);
+            const auto& meshes = m_visible_mesh_spans[span_index];
             if (meshes.empty()) {
                 continue;
             }
 
             std::size_t primitive_count{0};
-            Buffer_range primitive_range = m_primitive_buffer.update(meshes, primitive_mode, filter, parameters.primitive_settings, primitive_count);
-            erhe::renderer::Draw_indirect_buffer_range draw_indirect_buffer_range = m_draw_indirect_buffer.update(meshes, primitive_mode, filter);
+            Buffer_range                               primitive_range;
+            erhe::renderer::Draw_indirect_buffer_range draw_indirect_buffer_range;
+            // Persistent primitive records are used when possible; primitive_range stays unused then
+            bool use_records{false};
+            if (m_use_instancing) {
+                const erhe::renderer::Mesh_instance_batches& batches = m_instance_batches[span_index];
+                primitive_range            = m_primitive_buffer.update(batches, primitive_mode, parameters.primitive_settings, primitive_count);
+                draw_indirect_buffer_range = m_draw_indirect_buffer.update(batches, primitive_mode);
+            } else if (m_primitive_buffer.update_records(meshes, primitive_mode, filter, parameters.primitive_settings)) {
+                use_records                = true;
+                const std::span<const uint32_t> record_indices = m_primitive_buffer.get_record_indices();
+                primitive_count            = record_indices.size();
+                draw_indirect_buffer_range = m_draw_indirect_buffer.update(meshes, primitive_mode, filter, record_indices);
+            } else {
+                primitive_range            = m_primitive_buffer.update(meshes, primitive_mode, filter, parameters.primitive_settings, primitive_count);
+                draw_indirect_buffer_range = m_draw_indirect_buffer.update(meshes, primitive_mode, filter);
+            }
             if (draw_indirect_buffer_range.draw_indirect_count == 0) {
-                primitive_range.cancel();
+                if (!use_records) {
+                    primitive_range.cancel();
+                }
                 draw_indirect_buffer_range.range.cancel();
                 continue;
             }
-            ERHE_VERIFY(primitive_count == draw_indirect_buffer_range.draw_indirect_count);
-            primitive_range.bind();
+            ERHE_VERIFY(primitive_count == draw_indirect_buffer_range.instance_count);
+            ++m_frame_statistics.draw_call_count;
+            m_frame_statistics.draw_command_count += draw_indirect_buffer_range.draw_indirect_count;
+            m_frame_statistics.instance_count     += draw_indirect_buffer_range.instance_count;
+            if (use_records) {
+                m_primitive_buffer.bind_records();
+            } else {
+                primitive_range.bind();
+            }
             draw_indirect_buffer_range.range.bind(); // Draw indirect buffer is not indexed, this binds the whole buffer
 
             gl::multi_draw_elements_indirect(
@@ -201,7 +282,9 @@ void Forward_renderer::render(const Render_parameters& parameters)
                 static_cast<GLsizei>(sizeof(gl::Draw_elements_indirect_command))
             );
 
-            primitive_range.submit();
+            if (!use_records) {
+                primitive_range.submit();
+            }
             draw_indirect_buffer_range.range.submit();
         }
 
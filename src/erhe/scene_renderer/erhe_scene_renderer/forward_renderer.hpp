@@ -4,11 +4,13 @@
 #include "erhe_graphics/sampler.hpp"
 #include "erhe_primitive/primitive.hpp"
 #include "erhe_renderer/draw_indirect_buffer.hpp"
+#include "erhe_renderer/mesh_instance_batches.hpp"
 #include "erhe_renderer/pipeline_renderpass.hpp"
 #include "erhe_scene_renderer/camera_buffer.hpp"
 #include "erhe_scene_renderer/joint_buffer.hpp"
 #include "erhe_scene_renderer/light_buffer.hpp"
 #include "erhe_scene_renderer/material_buffer.hpp"
+#include "erhe_scene_renderer/mesh_culling.hpp"
 #include "erhe_scene_renderer/primitive_buffer.hpp"
 
 #include <glm/glm.hpp>
@@ -75,11 +77,30 @@ public:
         const glm::vec4                                                    grid_size      {10.0f,  1.0f,  0.1f,  0.01f};
         const glm::vec4                                                    grid_line_width{ 0.006, 0.02f, 0.02f, 0.02f};
 
+        Culling_settings                                                   culling {};  // requires camera
+        tf::Executor*                                                      executor{nullptr};
     };
 
     void render(const Render_parameters& parameters);
     void draw_primitives(const Render_parameters& parameters, const erhe::scene::Light* light);
 
+    // When enabled, meshes sharing render shapes within a mesh span are drawn
+    // with instanced draw commands. This changes draw order within the span.
+    void set_instancing_enabled(bool enabled);
+    [[nodiscard]] auto is_instancing_enabled() const -> bool;
+
+    class Statistics
+    {
+    public:
+        std::size_t draw_call_count   {0}; // multi draw calls
+        std::size_t draw_command_count{0}; // draw indirect commands
+        std::size_t instance_count    {0}; // primitives drawn
+    };
+
+    // Latches statistics counted since previous call; call once per frame
+    void end_frame();
+    [[nodiscard]] auto get_statistics() const -> const Statistics&;
+
 private:
     erhe::graphics::Instance&                m_graphics_instance;
     Program_interface&                       m_program_interface;
@@ -90,6 +111,16 @@ private:
     Light_buffer                             m_light_buffer;
     Material_buffer                          m_material_buffer;
     Primitive_buffer                         m_primitive_buffer;
+    std::vector<Mesh_culling>                m_mesh_cullings; // one per mesh span
+    std::vector<
+        std::span<const std::shared_ptr<erhe::scene::Mesh>>
+    >                                        m_visible_mesh_spans;
+    std::vector<
+        erhe::renderer::Mesh_instance_batches
+    >                                        m_instance_batches; // one per visible mesh span
+    bool                                     m_use_instancing{false};
+    Statistics                               m_frame_statistics;
+    Statistics                               m_statistics;
     erhe::graphics::Sampler                  m_nearest_sampler;
     std::shared_ptr<erhe::graphics::Texture> m_dummy_texture;
 };
@@ -0,0 +1,138 @@
+#include "erhe_scene_renderer/mesh_culling.hpp"
+
+#include "erhe_primitive/buffer_mesh.hpp"
+#include "erhe_primitive/primitive.hpp"
+#include "erhe_scene/mesh.hpp"
+#include "erhe_scene/node.hpp"
+#include "erhe_profile/profile.hpp"
+
+#include <taskflow/taskflow.hpp>
+
+#include <algorithm>
+
+namespace erhe::scene_renderer {
+
+namespace {
+
+// Meshes with unknown bounds are never culled
+constexpr float c_unbounded_extent = 1.0e30f;
+
+// Below these counts, task dispatch costs more than the work saved
+constexpr std::size_t c_parallel_mesh_count = 4096;
+constexpr std::size_t c_chunk_mesh_count    = 1024;
+
+}
+
+void Mesh_culling::gather_bounds(
+    const std::span<const std::shared_ptr<erhe::scene::Mesh>> meshes,
+    const std::size_t                                         begin,
+    const std::size_t                                         end
+)
+{
+    for (std::size_t i = begin; i < end; ++i) {
+        const erhe::scene::Mesh* mesh = meshes[i].get();
+        const erhe::scene::Node* node = (mesh != nullptr) ? mesh->get_node() : nullptr;
+        if ((node == nullptr) || mesh->skin) {
+            // Skinned vertices are not bounded by bind pose box
+            m_bounds.set(i, glm::vec3{0.0f}, glm::vec3{c_unbounded_extent});
+            continue;
+        }
+
+        erhe::math::Bounding_box local_box;
+        for (const erhe::primitive::Primitive& primitive : mesh->get_primitives()) {
+            const erhe::primitive::Buffer_mesh* buffer_mesh = primitive.get_renderable_mesh();
+            if ((buffer_mesh == nullptr) || !buffer_mesh->bounding_box.is_valid()) {
+                continue;
+            }
+            local_box.include(buffer_mesh->bounding_box);
+        }
+        if (!local_box.is_valid()) {
+            m_bounds.set(i, glm::vec3{0.0f}, glm::vec3{c_unbounded_extent});
+            continue;
+        }
+
+        glm::vec3 center;
+        glm::vec3 extent;
+        erhe::math::transform_aabb(node->world_from_node(), local_box.min, local_box.max, center, extent);
+        m_bounds.set(i, center, extent);
+    }
+}
+
+auto Mesh_culling::cull(
+    const std::span<const std::shared_ptr<erhe::scene::Mesh>> meshes,
+    const glm::mat4&                                          clip_from_world,
+    const std::optional<glm::vec3>&                           view_position,
+    const Culling_settings&                                   settings,
+    tf::Executor* const                                       executor
+) -> std::span<const std::shared_ptr<erhe::scene::Mesh>>
+{
+    ERHE_PROFILE_FUNCTION();
+
+    const std::size_t count = meshes.size();
+    m_last_stats = Culling_stats{};
+    m_last_stats.input_count = count;
+    if (!settings.enabled || (count == 0)) {
+        m_last_stats.visible_count = count;
+        return meshes;
+    }
+
+    m_bounds.resize(count);
+    m_visible.resize(count);
+
+    const erhe::math::Frustum frustum{clip_from_world};
+    const auto cull_range = [this, &meshes, &frustum](const std::size_t begin, const std::size_t end) {
+        gather_bounds(meshes, begin, end);
+        erhe::math::cull_aabbs(frustum, m_bounds, begin, end, m_visible.data() + begin);
+    };
+
+    if ((executor != nullptr) && (count >= c_parallel_mesh_count)) {
+        ERHE_PROFILE_SCOPE("parallel cull");
+        tf::Taskflow taskflow;
+        for (std::size_t begin = 0; begin < count; begin += c_chunk_mesh_count) {
+            const std::size_t end = std::min(begin + c_chunk_mesh_count, count);
+            taskflow.emplace([&cull_range, begin, end]() { cull_range(begin, end); });
+        }
+        if (executor->this_worker_id() >= 0) {
+            executor->corun(taskflow);
+        } else {
+            executor->run(taskflow).wait();
+        }
+    } else {
+        cull_range(0, count);
+    }
+
+    m_visible_meshes.clear();
+    const float min_ratio = settings.min_screen_ratio;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (m_visible[i] == 0) {
+            ++m_last_stats.frustum_culled_count;
+            continue;
+        }
+        if (view_position.has_value() && (min_ratio > 0.0f)) {
+            const glm::vec3 center{m_bounds.center_x[i], m_bounds.center_y[i], m_bounds.center_z[i]};
+            const glm::vec3 extent{m_bounds.extent_x[i], m_bounds.extent_y[i], m_bounds.extent_z[i]};
+            const float     radius   = glm::length(extent);
+            const float     distance = glm::distance(center, view_position.value());
+            if ((distance > radius) && (radius < min_ratio * distance)) {
+                ++m_last_stats.small_culled_count;
+                continue;
+            }
+        }
+        m_visible_meshes.push_back(meshes[i]);
+    }
+    m_last_stats.visible_count = m_visible_meshes.size();
+
+    ERHE_PROFILE_PLOT("Culling input meshes",   static_cast<int64_t>(m_last_stats.input_count));
+    ERHE_PROFILE_PLOT("Culling frustum culled", static_cast<int64_t>(m_last_stats.frustum_culled_count));
+    ERHE_PROFILE_PLOT("Culling small culled",   static_cast<int64_t>(m_last_stats.small_culled_count));
+    ERHE_PROFILE_PLOT("Culling visible meshes", static_cast<int64_t>(m_last_stats.visible_count));
+
+    return std::span<const std::shared_ptr<erhe::scene::Mesh>>{m_visible_meshes};
+}
+
+auto Mesh_culling::get_last_stats() const -> const Culling_stats&
+{
+    return m_last_stats;
+}
+
+} // namespace erhe::scene_renderer
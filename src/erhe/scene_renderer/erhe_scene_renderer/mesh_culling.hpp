@@ -0,0 +1,64 @@
+#pragma once
+
+#include "erhe_math/frustum.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace erhe::scene {
+    class Mesh;
+}
+namespace tf {
+    class Executor;
+}
+
+namespace erhe::scene_renderer {
+
+class Culling_settings
+{
+public:
+    bool  enabled         {true};
+    float min_screen_ratio{0.0f}; // bounding sphere radius / distance; 0 disables small feature culling
+};
+
+class Culling_stats
+{
+public:
+    std::size_t input_count         {0};
+    std::size_t frustum_culled_count{0};
+    std::size_t small_culled_count  {0};
+    std::size_t visible_count       {0};
+};
+
+// Produces visible mesh lists for Primitive_buffer::update() and
+// Draw_indirect_buffer::update(). Does not touch GPU resources.
+class Mesh_culling
+{
+public:
+    // Returned span is valid until the next cull() call
+    [[nodiscard]] auto cull(
+        std::span<const std::shared_ptr<erhe::scene::Mesh>> meshes,
+        const glm::mat4&                                    clip_from_world,
+        const std::optional<glm::vec3>&                     view_position,
+        const Culling_settings&                             settings,
+        tf::Executor*                                       executor = nullptr
+    ) -> std::span<const std::shared_ptr<erhe::scene::Mesh>>;
+
+    [[nodiscard]] auto get_last_stats() const -> const Culling_stats&;
+
+private:
+    void gather_bounds(std::span<const std::shared_ptr<erhe::scene::Mesh>> meshes, std::size_t begin, std::size_t end);
+
+    erhe::math::Aabb_soa                            m_bounds;
+    std::vector<uint8_t>                            m_visible;
+    std::vector<std::shared_ptr<erhe::scene::Mesh>> m_visible_meshes;
+    Culling_stats                                   m_last_stats;
+};
+
+} // namespace erhe::scene_renderer
@@ -4,6 +4,10 @@
 #include "erhe_renderer/renderer_config.hpp"
 
 #include "erhe_configuration/configuration.hpp"
+#include "erhe_gl/wrapper_functions.hpp"
+#include "erhe_graphics/buffer.hpp"
+#include "erhe_item/item.hpp"
+#include "erhe_renderer/mesh_instance_batches.hpp"
 #include "erhe_primitive/primitive.hpp"
 #include "erhe_primitive/material.hpp"
 #include "erhe_scene/mesh.hpp"
@@ -47,10 +51,13 @@ Primitive_buffer::Primitive_buffer(erhe::graphics::Instance& graphics_instance,
             .debug_label   = "primitive"
         }
     }
+    , m_graphics_instance  {graphics_instance}
     , m_primitive_interface{primitive_interface}
 {
 }
 
+Primitive_buffer::~Primitive_buffer() noexcept = default;
+
 void Primitive_buffer::reset_id_ranges()
 {
     m_id_offset = 0;
@@ -67,6 +74,63 @@ auto Primitive_buffer::id_ranges() const -> const std::vector<Id_range>&
     return m_id_ranges;
 }
 
+std::atomic<std::size_t> Primitive_buffer::s_frame_written_bytes{0};
+std::atomic<std::size_t> Primitive_buffer::s_frame_record_writes{0};
+std::atomic<std::size_t> Primitive_buffer::s_frame_record_reuses{0};
+
+auto Primitive_buffer::end_frame() -> Statistics
+{
+    const Statistics statistics{
+        .written_bytes = s_frame_written_bytes.exchange(0),
+        .record_writes = s_frame_record_writes.exchange(0),
+        .record_reuses = s_frame_record_reuses.exchange(0)
+    };
+    ERHE_PROFILE_PLOT("Primitive buffer bytes",         static_cast<int64_t>(statistics.written_bytes));
+    ERHE_PROFILE_PLOT("Primitive buffer record writes", static_cast<int64_t>(statistics.record_writes));
+    ERHE_PROFILE_PLOT("Primitive buffer record reuses", static_cast<int64_t>(statistics.record_reuses));
+    return statistics;
+}
+
+void Primitive_buffer::write_record(
+    const std::span<std::byte>          primitive_gpu_data,
+    const std::size_t                   write_offset,
+    const erhe::scene::Mesh&            mesh,
+    const erhe::primitive::Primitive&   primitive,
+    const glm::mat4&                    world_from_node,
+    const glm::mat4&                    normal_transform,
+    const Primitive_interface_settings& settings,
+    const uint32_t                      id_offset
+) const
+{
+    const auto&                      offsets          = m_primitive_interface.offsets;
+    const erhe::primitive::Material* material         = primitive.material.get();
+    const glm::vec4                  wireframe_color  = glm::vec4{1.0f, 1.0f, 1.0f, 1.0f}; //// mesh.get_wireframe_color();
+    const glm::vec3                  id_offset_vec3   = erhe::math::vec3_from_uint(id_offset);
+    const glm::vec4                  id_offset_vec4   = glm::vec4{id_offset_vec3, 0.0f};
+    const uint32_t                   material_index   = (material != nullptr) ? material->material_buffer_index : 0u;
+    const auto&                      skin             = mesh.skin;
+    const float                      skinning_factor  = skin ? 1.0f : 0.0f;
+    const uint32_t                   base_joint_index = skin ? skin->skin_data.joint_buffer_index : 0;
+
+    using erhe::graphics::as_span;
+    const auto color_span =
+        (settings.color_source == Primitive_color_source::id_offset           ) ? as_span(id_offset_vec4         ) :
+        (settings.color_source == Primitive_color_source::mesh_wireframe_color) ? as_span(wireframe_color        ) :
+                                                                                  as_span(settings.constant_color);
+    const auto size_span =
+        (settings.size_source == Primitive_size_source::mesh_point_size) ? as_span(mesh.point_size       ) :
+        (settings.size_source == Primitive_size_source::mesh_line_width) ? as_span(mesh.line_width       ) :
+                                                                           as_span(settings.constant_size);
+    using erhe::graphics::write;
+    write(primitive_gpu_data, write_offset + offsets.world_from_node,  as_span(world_from_node ));
+    write(primitive_gpu_data, write_offset + offsets.normal_transform, as_span(normal_transform));
+    write(primitive_gpu_data, write_offset + offsets.color,            color_span               );
+    write(primitive_gpu_data, write_offset + offsets.material_index,   as_span(material_index  ));
+    write(primitive_gpu_data, write_offset + offsets.size,             size_span                );
+    write(primitive_gpu_data, write_offset + offsets.skinning_factor,  as_span(skinning_factor ));
+    write(primitive_gpu_data, write_offset + offsets.base_joint_index, as_span(base_joint_index));
+}
+
 auto Primitive_buffer::update(
     const std::span<const std::shared_ptr<erhe::scene::Mesh>>& meshes,
     erhe::primitive::Primitive_mode                            primitive_mode,
@@ -111,7 +175,6 @@ auto Primitive_buffer::update(
     }
 
     const auto        entry_size     = m_primitive_interface.primitive_struct.size_bytes();
-    const auto&       offsets        = m_primitive_interface.offsets;
     const std::size_t max_byte_count = primitive_count * entry_size;
 
     erhe::renderer::Buffer_range buffer_range       = open(erhe::renderer::Ring_buffer_usage::CPU_write, max_byte_count);
@@ -133,9 +196,7 @@ auto Primitive_buffer::update(
             continue;
         }
 
-        const glm::mat4 world_from_node = node->world_from_node();
-
-        // TODO Use compute shader ?
+        const glm::mat4 world_from_node  = node->world_from_node();
         const glm::mat4 normal_transform = glm::transpose(glm::adjugate(world_from_node));
 
         std::size_t mesh_primitive_index{0};
@@ -155,48 +216,17 @@ auto Primitive_buffer::update(
                 m_id_offset += add;
             }
 
-            erhe::primitive::Material* material = primitive.material.get();
-            const glm::vec4 wireframe_color  = glm::vec4{1.0f, 1.0f, 1.0f, 1.0f}; //// mesh->get_wireframe_color();
-            const glm::vec3 id_offset_vec3   = erhe::math::vec3_from_uint(m_id_offset);
-            const glm::vec4 id_offset_vec4   = glm::vec4{id_offset_vec3, 0.0f};
-            const uint32_t  material_index   = (material != nullptr) ? material->material_buffer_index : 0u;
-            const auto&     skin             = mesh->skin;
-            const float     skinning_factor  = skin ? 1.0f : 0.0f;
-            const uint32_t  base_joint_index = skin ? skin->skin_data.joint_buffer_index : 0;
-
             SPDLOG_LOGGER_TRACE(
-                log_primitive_buffer, 
-                "[{}] node {}, mesh {}, material {}, mat. idx = {}, offset = {}",
+                log_primitive_buffer,
+                "[{}] node {}, mesh {}, material {}, offset = {}",
                 primitive_index,
                 node->describe(),
                 mesh_index - 1,
-                (material != nullptr) ? material->get_name() : std::string{},
-                material_index,
-                writer.write_offset
+                primitive.material ? primitive.material->get_name() : std::string{},
+                write_offset
             );
 
-            using erhe::graphics::as_span;
-            const auto color_span =
-                (settings.color_source == Primitive_color_source::id_offset           ) ? as_span(id_offset_vec4         ) :
-                (settings.color_source == Primitive_color_source::mesh_wireframe_color) ? as_span(wireframe_color        ) :
-                                                                                          as_span(settings.constant_color);
-            const auto size_span =
-                (settings.size_source == Primitive_size_source::mesh_point_size) ? as_span(mesh->point_size      ) :
-                (settings.size_source == Primitive_size_source::mesh_line_width) ? as_span(mesh->line_width      ) :
-                                                                                   as_span(settings.constant_size);
-            //memset(reinterpret_cast<uint8_t*>(model_gpu_data.data()) + offset, 0, entry_size);
-            {
-                //ZoneScopedN("write");
-                using erhe::graphics::write;
-                write(primitive_gpu_data, write_offset + offsets.world_from_node,  as_span(world_from_node ));
-                write(primitive_gpu_data, write_offset + offsets.normal_transform, as_span(normal_transform));
-                write(primitive_gpu_data, write_offset + offsets.color,            color_span               );
-                write(primitive_gpu_data, write_offset + offsets.material_index,   as_span(material_index  ));
-                write(primitive_gpu_data, write_offset + offsets.size,             size_span                );
-                write(primitive_gpu_data, write_offset + offsets.skinning_factor,  as_span(skinning_factor ));
-                write(primitive_gpu_data, write_offset + offsets.base_joint_index, as_span(base_joint_index));
-
-            }
+            write_record(primitive_gpu_data, write_offset, *mesh, primitive, world_from_node, normal_transform, settings, m_id_offset);
             write_offset += entry_size;
 
             if (use_id_ranges) {
@@ -217,11 +247,72 @@ auto Primitive_buffer::update(
     }
 
     buffer_range.close(write_offset);
+    s_frame_written_bytes.fetch_add(write_offset, std::memory_order_relaxed);
 
     // SPDLOG_LOGGER_TRACE(log_primitive_buffer, "wrote {} entries to primitive buffer", primitive_index);
     return buffer_range;
 }
 
+auto Primitive_buffer::update(
+    const erhe::renderer::Mesh_instance_batches& batches,
+    erhe::primitive::Primitive_mode              primitive_mode,
+    const Primitive_interface_settings&          settings,
+    std::size_t&                                 out_primitive_count
+) -> erhe::renderer::Buffer_range
+{
+    ERHE_PROFILE_FUNCTION();
+
+    out_primitive_count = 0;
+
+    using Batch = erhe::renderer::Mesh_instance_batches::Batch;
+    const std::vector<const erhe::scene::Mesh*>& meshes = batches.get_meshes();
+
+    std::size_t primitive_count = 0;
+    for (const erhe::scene::Mesh* mesh : meshes) {
+        primitive_count += mesh->get_primitives().size();
+    }
+
+    const auto        entry_size     = m_primitive_interface.primitive_struct.size_bytes();
+    const std::size_t max_byte_count = primitive_count * entry_size;
+
+    erhe::renderer::Buffer_range buffer_range       = open(erhe::renderer::Ring_buffer_usage::CPU_write, max_byte_count);
+    std::span<std::byte>         primitive_gpu_data = buffer_range.get_span();
+    std::size_t                  write_offset       = 0;
+
+    // Same order as Draw_indirect_buffer::update() with batches: for each
+    // batch primitive, one record for each instance.
+    for (const Batch& batch : batches.get_batches()) {
+        const std::span<const erhe::scene::Mesh* const> batch_meshes{meshes.data() + batch.first_mesh, batch.mesh_count};
+        const std::vector<erhe::primitive::Primitive>&  primitives = batch_meshes.front()->get_primitives();
+        for (std::size_t primitive_index = 0, end = primitives.size(); primitive_index < end; ++primitive_index) {
+            const erhe::primitive::Buffer_mesh& buffer_mesh = primitives[primitive_index].render_shape->get_renderable_mesh();
+            if (buffer_mesh.index_range(primitive_mode).index_count == 0) {
+                continue;
+            }
+            for (const erhe::scene::Mesh* mesh : batch_meshes) {
+                const glm::mat4 world_from_node  = mesh->get_node()->world_from_node();
+                const glm::mat4 normal_transform = glm::transpose(glm::adjugate(world_from_node));
+                write_record(
+                    primitive_gpu_data,
+                    write_offset,
+                    *mesh,
+                    mesh->get_primitives()[primitive_index], // material may differ between instances
+                    world_from_node,
+                    normal_transform,
+                    settings,
+                    m_id_offset
+                );
+                write_offset += entry_size;
+                ++out_primitive_count;
+            }
+        }
+    }
+
+    buffer_range.close(write_offset);
+    s_frame_written_bytes.fetch_add(write_offset, std::memory_order_relaxed);
+    return buffer_range;
+}
+
 auto Primitive_buffer::update(
     const std::span<const std::shared_ptr<erhe::scene::Node>>& nodes,
     const Primitive_interface_settings&                        primitive_settings
@@ -232,6 +323,7 @@ auto Primitive_buffer::update(
     const auto&       offsets         = m_primitive_interface.offsets;
     const std::size_t max_byte_count  = primitive_count * entry_size;
 
+
     erhe::renderer::Buffer_range buffer_range       = open(erhe::renderer::Ring_buffer_usage::CPU_write, max_byte_count);
     std::span<std::byte>         primitive_gpu_data = buffer_range.get_span();
     std::size_t                  write_offset       = 0;
@@ -257,7 +349,244 @@ auto Primitive_buffer::update(
         write_offset += entry_size;
     }
     buffer_range.close(write_offset);
+    s_frame_written_bytes.fetch_add(write_offset, std::memory_order_relaxed);
     return buffer_range;
 }
 
+auto Primitive_buffer::Record_key_hash::operator()(const Record_key& key) const noexcept -> std::size_t
+{
+    std::size_t hash = std::hash<std::size_t>{}(key.mesh_id);
+    hash ^= std::hash<std::size_t>{}(key.primitive_index) + 0x9e3779b9u + (hash << 6) + (hash >> 2);
+    hash ^= std::hash<std::size_t>{}(key.settings_index ) + 0x9e3779b9u + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+namespace {
+
+// Records unused for this many update_records() calls are released
+constexpr uint64_t c_record_max_unused_updates = 256;
+
+// Distinct settings are few (one for each pass type); beyond this records
+// are not used
+constexpr std::size_t c_max_record_settings = 16;
+
+[[nodiscard]] auto same_settings(const Primitive_interface_settings& lhs, const Primitive_interface_settings& rhs) -> bool
+{
+    return
+        (lhs.color_source   == rhs.color_source  ) &&
+        (lhs.constant_color == rhs.constant_color) &&
+        (lhs.size_source    == rhs.size_source   ) &&
+        (lhs.constant_size  == rhs.constant_size );
+}
+
+} // anonymous namespace
+
+auto Primitive_buffer::get_record_settings_index(const Primitive_interface_settings& settings) -> std::optional<std::size_t>
+{
+    for (std::size_t i = 0, end = m_record_settings.size(); i < end; ++i) {
+        if (same_settings(m_record_settings[i], settings)) {
+            return i;
+        }
+    }
+    if (m_record_settings.size() >= c_max_record_settings) {
+        return {};
+    }
+    m_record_settings.push_back(settings);
+    return m_record_settings.size() - 1;
+}
+
+auto Primitive_buffer::allocate_record_slot() -> std::optional<uint32_t>
+{
+    if (!m_free_record_slots.empty()) {
+        const uint32_t slot = m_free_record_slots.back();
+        m_free_record_slots.pop_back();
+        return slot;
+    }
+    if (m_record_slot_count >= m_max_record_slot_count) {
+        return {};
+    }
+    return m_record_slot_count++;
+}
+
+void Primitive_buffer::prune_records()
+{
+    ERHE_PROFILE_FUNCTION();
+
+    for (auto i = m_records.begin(); i != m_records.end();) {
+        if (m_record_update_count - i->second.last_used_update > c_record_max_unused_updates) {
+            m_free_record_slots.push_back(i->second.slot);
+            i = m_records.erase(i);
+        } else {
+            ++i;
+        }
+    }
+}
+
+void Primitive_buffer::upload_record_run()
+{
+    if (m_record_run.empty()) {
+        return;
+    }
+    const std::size_t entry_size = m_primitive_interface.primitive_struct.size_bytes();
+    gl::named_buffer_sub_data(
+        m_record_buffer->gl_name(),
+        static_cast<GLintptr>  (m_record_run_first_slot * entry_size),
+        static_cast<GLsizeiptr>(m_record_run.size()),
+        m_record_run.data()
+    );
+    s_frame_written_bytes.fetch_add(m_record_run.size(), std::memory_order_relaxed);
+    m_record_run.clear();
+}
+
+auto Primitive_buffer::update_records(
+    const std::span<const std::shared_ptr<erhe::scene::Mesh>>& meshes,
+    erhe::primitive::Primitive_mode                            primitive_mode,
+    const erhe::Item_filter&                                   filter,
+    const Primitive_interface_settings&                        settings
+) -> bool
+{
+    ERHE_PROFILE_FUNCTION();
+
+    m_record_indices.clear();
+
+    // Id offset colors differ for every pass
+    if (settings.color_source == Primitive_color_source::id_offset) {
+        return false;
+    }
+    const std::optional<std::size_t> settings_index = get_record_settings_index(settings);
+    if (!settings_index.has_value()) {
+        return false;
+    }
+
+    const std::size_t entry_size = m_primitive_interface.primitive_struct.size_bytes();
+    if (!m_record_buffer) {
+        m_max_record_slot_count = static_cast<uint32_t>(m_primitive_interface.max_primitive_count);
+        m_record_buffer = std::make_unique<erhe::graphics::Buffer>(
+            m_graphics_instance,
+            erhe::graphics::Buffer_create_info{
+                .target              = gl::Buffer_target::shader_storage_buffer,
+                .capacity_byte_count = entry_size * m_max_record_slot_count,
+                .storage_mask        = gl::Buffer_storage_mask::dynamic_storage_bit,
+                .debug_label         = "primitive records"
+            }
+        );
+    }
+
+    ++m_record_update_count;
+    if ((m_record_update_count % c_record_max_unused_updates) == 0) {
+        prune_records();
+    }
+
+    // Dirty records with consecutive slots are gathered to m_record_run and
+    // uploaded together
+
+    std::size_t record_writes = 0;
+    std::size_t record_reuses = 0;
+    for (const auto& mesh : meshes) {
+        ERHE_VERIFY(mesh);
+        const erhe::scene::Node* node = mesh->get_node();
+        if (node == nullptr) {
+            continue;
+        }
+        if (!filter(mesh->get_flag_bits())) {
+            continue;
+        }
+
+        const glm::mat4 world_from_node = node->world_from_node();
+        const uint64_t  serial          = node->node_data.transforms.world_from_node_serial;
+        const auto&     skin            = mesh->skin;
+        const float     size =
+            (settings.size_source == Primitive_size_source::mesh_point_size) ? mesh->point_size :
+            (settings.size_source == Primitive_size_source::mesh_line_width) ? mesh->line_width :
+                                                                               settings.constant_size;
+
+        std::optional<glm::mat4> normal_transform;
+        const std::vector<erhe::primitive::Primitive>& primitives = mesh->get_primitives();
+        for (std::size_t primitive_index = 0, end = primitives.size(); primitive_index < end; ++primitive_index) {
+            const erhe::primitive::Primitive&   primitive   = primitives[primitive_index];
+            const erhe::primitive::Buffer_mesh* buffer_mesh = primitive.get_renderable_mesh();
+            ERHE_VERIFY(buffer_mesh != nullptr);
+            if (buffer_mesh->index_range(primitive_mode).index_count == 0) {
+                continue; // Draw_indirect_buffer::update() skips these too
+            }
+
+            const Record_key key{
+                .mesh_id         = mesh->get_id(),
+                .primitive_index = primitive_index,
+                .settings_index  = settings_index.value()
+            };
+            auto i = m_records.find(key);
+            if (i == m_records.end()) {
+                const std::optional<uint32_t> slot = allocate_record_slot();
+                if (!slot.has_value()) {
+                    upload_record_run();
+                    m_record_indices.clear();
+                    return false;
+                }
+                i = m_records.emplace(key, Record{.slot = slot.value()}).first;
+            }
+            Record& record = i->second;
+            record.last_used_update = m_record_update_count;
+            m_record_indices.push_back(record.slot);
+
+            const erhe::primitive::Material* material = primitive.material.get();
+            const uint32_t material_index   = (material != nullptr) ? material->material_buffer_index : 0u;
+            const float    skinning_factor  = skin ? 1.0f : 0.0f;
+            const uint32_t base_joint_index = skin ? skin->skin_data.joint_buffer_index : 0;
+            if (
+                (serial != 0) &&
+                (record.world_from_node_serial == serial          ) &&
+                (record.material_index         == material_index  ) &&
+                (record.base_joint_index       == base_joint_index) &&
+                (record.skinning_factor        == skinning_factor ) &&
+                (record.size                   == size            )
+            ) {
+                ++record_reuses;
+                continue;
+            }
+            record.world_from_node_serial = serial;
+            record.material_index         = material_index;
+            record.base_joint_index       = base_joint_index;
+            record.skinning_factor        = skinning_factor;
+            record.size                   = size;
+
+            if (!m_record_run.empty() && (record.slot != m_record_run_first_slot + m_record_run.size() / entry_size)) {
+                upload_record_run();
+            }
+            if (m_record_run.empty()) {
+                m_record_run_first_slot = record.slot;
+            }
+            if (!normal_transform.has_value()) {
+                normal_transform = glm::transpose(glm::adjugate(world_from_node));
+            }
+            const std::size_t write_offset = m_record_run.size();
+            m_record_run.resize(write_offset + entry_size);
+            write_record(m_record_run, write_offset, *mesh, primitive, world_from_node, normal_transform.value(), settings, 0);
+            ++record_writes;
+        }
+    }
+    upload_record_run();
+
+    s_frame_record_writes.fetch_add(record_writes, std::memory_order_relaxed);
+    s_frame_record_reuses.fetch_add(record_reuses, std::memory_order_relaxed);
+    return true;
+}
+
+auto Primitive_buffer::get_record_indices() const -> std::span<const uint32_t>
+{
+    return m_record_indices;
+}
+
+void Primitive_buffer::bind_records()
+{
+    ERHE_VERIFY(m_record_buffer);
+    gl::bind_buffer_range(
+        gl::Buffer_target::shader_storage_buffer,
+        static_cast<GLuint>    (m_primitive_interface.primitive_block.binding_point()),
+        static_cast<GLuint>    (m_record_buffer->gl_name()),
+        static_cast<GLintptr>  (0),
+        static_cast<GLsizeiptr>(m_record_buffer->capacity_byte_count())
+    );
+}
+
 } // namespace erhe::scene_renderer
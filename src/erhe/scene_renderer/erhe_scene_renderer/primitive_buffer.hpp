@@ -4,12 +4,27 @@
 #include "erhe_renderer/gpu_ring_buffer.hpp"
 #include "erhe_primitive/enums.hpp"
 
+#include <glm/glm.hpp>
+
 #include <array>
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <unordered_map>
 #include <vector>
 
 namespace erhe {
     class Item_filter;
 }
+namespace erhe::graphics {
+    class Buffer;
+}
+namespace erhe::primitive {
+    class Primitive;
+}
+namespace erhe::renderer {
+    class Mesh_instance_batches;
+}
 namespace erhe::scene {
     class Mesh;
     class Mesh_layer;
@@ -101,6 +116,7 @@ class Primitive_buffer : public erhe::renderer::GPU_ring_buffer
 {
 public:
     Primitive_buffer(erhe::graphics::Instance& graphics_instance, Primitive_interface& primitive_interface);
+    ~Primitive_buffer() noexcept;
 
     using Mesh_layer_collection = std::vector<const erhe::scene::Mesh_layer*>;
 
@@ -113,11 +129,35 @@ public:
         bool                                                       use_id_ranges = false
     ) -> erhe::renderer::Buffer_range;
 
+    // Writes records in the order expected by instanced draw commands from
+    // Draw_indirect_buffer::update() with the same batches
+    auto update(
+        const erhe::renderer::Mesh_instance_batches& batches,
+        erhe::primitive::Primitive_mode              primitive_mode,
+        const Primitive_interface_settings&          settings,
+        std::size_t&                                 out_primitive_count
+    ) -> erhe::renderer::Buffer_range;
+
     auto update(
         const std::span<const std::shared_ptr<erhe::scene::Node>>& nodes,
         const Primitive_interface_settings&                        primitive_settings
     ) -> erhe::renderer::Buffer_range;
 
+    // Persistent records, one for each mesh primitive and settings. A record
+    // is rewritten only when node transform serial, material, skin or size
+    // changes, so static scenes upload nothing. get_record_indices() returns
+    // record index for each draw, in Draw_indirect_buffer::update() order,
+    // to be used as base instance. Returns false when records cannot be used
+    // (id offset colors, record buffer full); use update() instead.
+    [[nodiscard]] auto update_records(
+        const std::span<const std::shared_ptr<erhe::scene::Mesh>>& meshes,
+        erhe::primitive::Primitive_mode                            primitive_mode,
+        const erhe::Item_filter&                                   filter,
+        const Primitive_interface_settings&                        settings
+    ) -> bool;
+    [[nodiscard]] auto get_record_indices() const -> std::span<const uint32_t>;
+    void bind_records();
+
     class Id_range
     {
     public:
@@ -131,10 +171,81 @@ public:
     [[nodiscard]] auto id_offset() const -> uint32_t;
     [[nodiscard]] auto id_ranges() const -> const std::vector<Id_range>&;
 
+    class Statistics
+    {
+    public:
+        std::size_t written_bytes {0}; // primitive records written to ring buffers and uploaded to record buffers
+        std::size_t record_writes {0}; // persistent records uploaded
+        std::size_t record_reuses {0}; // persistent records used without upload
+    };
+
+    // Sums over all Primitive_buffer instances since the previous call;
+    // call once per frame
+    static auto end_frame() -> Statistics;
+
 private:
-    Primitive_interface&  m_primitive_interface;
-    uint32_t              m_id_offset{0};
-    std::vector<Id_range> m_id_ranges;
+    void write_record(
+        std::span<std::byte>                primitive_gpu_data,
+        std::size_t                         write_offset,
+        const erhe::scene::Mesh&            mesh,
+        const erhe::primitive::Primitive&   primitive,
+        const glm::mat4&                    world_from_node,
+        const glm::mat4&                    normal_transform,
+        const Primitive_interface_settings& settings,
+        uint32_t                            id_offset
+    ) const;
+
+    class Record_key
+    {
+    public:
+        std::size_t mesh_id        {0}; // item ids are never reused
+        std::size_t primitive_index{0};
+        std::size_t settings_index {0};
+
+        [[nodiscard]] auto operator==(const Record_key& other) const -> bool = default;
+    };
+    class Record_key_hash
+    {
+    public:
+        [[nodiscard]] auto operator()(const Record_key& key) const noexcept -> std::size_t;
+    };
+    class Record
+    {
+    public:
+        uint32_t slot                  {0};
+        uint64_t last_used_update      {0};
+        uint64_t world_from_node_serial{0}; // 0 forces rewrite
+        uint32_t material_index        {0};
+        uint32_t base_joint_index      {0};
+        float    skinning_factor       {0.0f};
+        float    size                  {0.0f};
+    };
+
+    [[nodiscard]] auto get_record_settings_index(const Primitive_interface_settings& settings) -> std::optional<std::size_t>;
+    [[nodiscard]] auto allocate_record_slot     () -> std::optional<uint32_t>;
+    void prune_records       ();
+    void upload_record_run   ();
+
+    erhe::graphics::Instance& m_graphics_instance;
+    Primitive_interface&      m_primitive_interface;
+    uint32_t                  m_id_offset{0};
+    std::vector<Id_range>     m_id_ranges;
+
+    // Created on first update_records()
+    std::unique_ptr<erhe::graphics::Buffer>                    m_record_buffer;
+    std::unordered_map<Record_key, Record, Record_key_hash>    m_records;
+    std::vector<Primitive_interface_settings>                  m_record_settings;
+    std::vector<uint32_t>                                      m_free_record_slots;
+    uint32_t                                                   m_record_slot_count    {0}; // slots ever allocated
+    uint32_t                                                   m_max_record_slot_count{0};
+    std::vector<uint32_t>                                      m_record_indices;
+    std::vector<std::byte>                                     m_record_run;           // consecutive dirty records
+    uint32_t                                                   m_record_run_first_slot{0};
+    uint64_t                                                   m_record_update_count  {0};
+
+    static std::atomic<std::size_t> s_frame_written_bytes;
+    static std::atomic<std::size_t> s_frame_record_writes;
+    static std::atomic<std::size_t> s_frame_record_reuses;
 };
 
 } // namespace erhe::scene_renderer
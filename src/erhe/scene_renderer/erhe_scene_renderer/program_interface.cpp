@@ -94,7 +94,16 @@ auto Program_interface::make_prototype(
         ERHE_VERIFY(gl::is_extension_supported(gl::Extension::Extension_GL_ARB_shader_draw_parameters));
         create_info.extensions.push_back({gl::Shader_type::vertex_shader,   "GL_ARB_shader_draw_parameters"});
         create_info.extensions.push_back({gl::Shader_type::geometry_shader, "GL_ARB_shader_draw_parameters"});
-        create_info.defines.push_back({"gl_DrawID", "gl_DrawIDARB"});
+    }
+
+    // Shaders index primitive records with gl_DrawID. Draw commands set base
+    // instance to the index of their first primitive record, so that
+    // instanced draws (see erhe::renderer::Mesh_instance_batches) get one
+    // record per instance. For non-instanced draws this equals gl_DrawID.
+    if (graphics_instance.info.gl_version < 460) {
+        create_info.defines.push_back({"gl_DrawID", "(gl_BaseInstanceARB + gl_InstanceID)"});
+    } else {
+        create_info.defines.push_back({"gl_DrawID", "(gl_BaseInstance + gl_InstanceID)"});
     }
 
     create_info.defines.emplace_back("ERHE_SHADOW_MAPS", "1");
@@ -166,40 +166,65 @@ auto Shadow_renderer::render(const Render_parameters& parameters) -> bool
     log_shadow_renderer->trace("Rendering shadow map to '{}'", parameters.texture->debug_label());
 
     const erhe::primitive::Primitive_mode primitive_mode{erhe::primitive::Primitive_mode::polygon_fill};
-    for (const auto& meshes : mesh_spans) {
-        std::size_t primitive_count{0};
-        Buffer_range primitive_range = m_primitive_buffers.update(meshes, primitive_mode, shadow_filter, Primitive_interface_settings{}, primitive_count);
-        Draw_indirect_buffer_range draw_indirect_buffer_range = m_draw_indirect_buffers.update(meshes, primitive_mode, shadow_filter);
-        ERHE_VERIFY(primitive_count == draw_indirect_buffer_range.draw_indirect_count);
-        if (primitive_count == 0) {
-            primitive_range.cancel();
-            draw_indirect_buffer_range.range.cancel();
+    for (const auto& light : lights) {
+        if (!light->cast_shadow) {
             continue;
         }
 
-        primitive_range.bind();
-        draw_indirect_buffer_range.range.bind();
+        auto* light_projection_transform = parameters.light_projections.get_light_projection_transforms_for_light(light.get());
+        if (light_projection_transform == nullptr) {
+            //// log_render->warn("Light {} has no light projection transforms", light->name());
+            continue;
+        }
+        const std::size_t light_index = light_projection_transform->index;
+        if (light_index >= parameters.framebuffers.size()) {
+            continue;
+        }
+
+        gl::bind_framebuffer(gl::Framebuffer_target::draw_framebuffer, parameters.framebuffers[light_index]->gl_name());
+        gl::clear_buffer_fv(gl::Buffer::depth, 0, m_graphics_instance.depth_clear_value_pointer());
+
+        Buffer_range control_range = m_light_buffers.update_control(light_index);
+        control_range.bind();
 
-        for (const auto& light : lights) {
-            if (!light->cast_shadow) {
+        // Each light gets its own visible mesh list; no small feature culling for shadow casters
+        const glm::mat4 clip_from_world = light_projection_transform->clip_from_world.get_matrix();
+        for (const auto& meshes : mesh_spans) {
+            const std::span<const std::shared_ptr<erhe::scene::Mesh>> visible_meshes = m_mesh_culling.cull(
+                meshes, clip_from_world, std::nullopt, parameters.culling, parameters.executor
+            );
+            if (visible_meshes.empty()) {
                 continue;
             }
 
-            auto* light_projection_transform = parameters.light_projections.get_light_projection_transforms_for_light(light.get());
-            if (light_projection_transform == nullptr) {
-                //// log_render->warn("Light {} has no light projection transforms", light->name());
-                continue;
+            // Shadow casters mostly share records between lights and frames
+            std::size_t                primitive_count{0};
+            Buffer_range               primitive_range;
+            Draw_indirect_buffer_range draw_indirect_buffer_range;
+            const bool use_records = m_primitive_buffers.update_records(visible_meshes, primitive_mode, shadow_filter, Primitive_interface_settings{});
+            if (use_records) {
+                const std::span<const uint32_t> record_indices = m_primitive_buffers.get_record_indices();
+                primitive_count            = record_indices.size();
+                draw_indirect_buffer_range = m_draw_indirect_buffers.update(visible_meshes, primitive_mode, shadow_filter, record_indices);
+            } else {
+                primitive_range            = m_primitive_buffers.update(visible_meshes, primitive_mode, shadow_filter, Primitive_interface_settings{}, primitive_count);
+                draw_indirect_buffer_range = m_draw_indirect_buffers.update(visible_meshes, primitive_mode, shadow_filter);
             }
-            const std::size_t light_index = light_projection_transform->index;
-            if (light_index >= parameters.framebuffers.size()) {
+            ERHE_VERIFY(primitive_count == draw_indirect_buffer_range.draw_indirect_count);
+            if (primitive_count == 0) {
+                if (!use_records) {
+                    primitive_range.cancel();
+                }
+                draw_indirect_buffer_range.range.cancel();
                 continue;
             }
 
-            gl::bind_framebuffer(gl::Framebuffer_target::draw_framebuffer, parameters.framebuffers[light_index]->gl_name());
-            gl::clear_buffer_fv(gl::Buffer::depth, 0, m_graphics_instance.depth_clear_value_pointer());
-
-            Buffer_range control_range = m_light_buffers.update_control(light_index);
-            control_range.bind();
+            if (use_records) {
+                m_primitive_buffers.bind_records();
+            } else {
+                primitive_range.bind();
+            }
+            draw_indirect_buffer_range.range.bind();
 
             {
                 static constexpr std::string_view c_id_mdi{"mdi"};
@@ -214,11 +239,14 @@ auto Shadow_renderer::render(const Render_parameters& parameters) -> bool
                     static_cast<GLsizei>(sizeof(gl::Draw_elements_indirect_command))
                 );
             }
-            control_range.submit();
+
+            if (!use_records) {
+                primitive_range.submit();
+            }
+            draw_indirect_buffer_range.range.submit();
         }
 
-        primitive_range.submit();
-        draw_indirect_buffer_range.range.submit();
+        control_range.submit();
     }
 
     joint_range.submit();
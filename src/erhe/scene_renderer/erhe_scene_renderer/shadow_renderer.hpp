@@ -10,6 +10,7 @@
 #include "erhe_math/viewport.hpp"
 #include "erhe_scene_renderer/joint_buffer.hpp"
 #include "erhe_scene_renderer/light_buffer.hpp"
+#include "erhe_scene_renderer/mesh_culling.hpp"
 #include "erhe_scene_renderer/primitive_buffer.hpp"
 
 #include <initializer_list>
@@ -67,6 +68,8 @@ public:
         const std::span<const std::shared_ptr<erhe::scene::Light>> lights;
         const std::span<const std::shared_ptr<erhe::scene::Skin>>& skins{};
         Light_projections&                                         light_projections;
+        Culling_settings                                           culling {};
+        tf::Executor*                                              executor{nullptr};
     };
 
     auto render(const Render_parameters& parameters) -> bool;
@@ -91,6 +94,7 @@ private:
     Joint_buffer                             m_joint_buffers;
     Light_buffer                             m_light_buffers;
     Primitive_buffer                         m_primitive_buffers;
+    Mesh_culling                             m_mesh_culling;
     erhe::graphics::Gpu_timer                m_gpu_timer;
 };
 
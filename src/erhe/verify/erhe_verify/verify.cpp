@@ -0,0 +1,27 @@
+#include "erhe_verify/verify.hpp"
+
+#include <atomic>
+
+namespace erhe::verify {
+
+namespace {
+
+std::atomic<Fatal_handler> s_fatal_handler{nullptr};
+
+} // anonymous namespace
+
+void set_fatal_handler(const Fatal_handler handler)
+{
+    s_fatal_handler.store(handler);
+}
+
+void call_fatal_handler()
+{
+    // Exchange so that a fatal error inside the handler does not recurse
+    const Fatal_handler handler = s_fatal_handler.exchange(nullptr);
+    if (handler != nullptr) {
+        handler();
+    }
+}
+
+} // namespace erhe::verify
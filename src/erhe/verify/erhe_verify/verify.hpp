@@ -1,5 +1,15 @@
 #pragma once
 
+namespace erhe::verify {
+
+// Called by ERHE_FATAL before the process is terminated, for example to
+// flush asynchronous logs. The handler is called at most once.
+using Fatal_handler = void (*)();
+void set_fatal_handler (Fatal_handler handler);
+void call_fatal_handler();
+
+} // namespace erhe::verify
+
 #if _MSC_VER && !defined(__clang__)
 
 #if defined(_WIN32)
@@ -23,7 +33,7 @@
 #include <cstdlib>
 #include <source_location>
 
-#define ERHE_FATAL(format, ...) do { printf("%s:%u " format "\n", std::source_location::current().file_name(), std::source_location::current().line(), ##__VA_ARGS__); DebugBreak(); abort(); } while (1)
+#define ERHE_FATAL(format, ...) do { printf("%s:%u " format "\n", std::source_location::current().file_name(), std::source_location::current().line(), ##__VA_ARGS__); erhe::verify::call_fatal_handler(); DebugBreak(); abort(); } while (1)
 #define ERHE_VERIFY(expression) do { if (!(expression)) { ERHE_FATAL("assert %s failed in %s", #expression, __func__); } } while (0)
 
 #else
@@ -31,7 +41,7 @@
 #include <cstdio>
 #include <cstdlib>
 
-#define ERHE_FATAL(format, ...) do { printf("%s:%d " format "\n", __FILE__, __LINE__, ##__VA_ARGS__); __builtin_trap(); __builtin_unreachable(); abort(); } while (1)
+#define ERHE_FATAL(format, ...) do { printf("%s:%d " format "\n", __FILE__, __LINE__, ##__VA_ARGS__); erhe::verify::call_fatal_handler(); __builtin_trap(); __builtin_unreachable(); abort(); } while (1)
 #define ERHE_VERIFY(expression) do { if (!(expression)) { ERHE_FATAL("assert %s failed in %s", #expression, __func__); } } while (0)
 
 #endif
@@ -16,6 +16,7 @@
 #   include <GL/wglext.h>
 #endif
 
+#include <algorithm>
 #include <cstdlib>
 #include <ctime>
 #include <stdexcept>
@@ -403,13 +404,14 @@ void Context_window::poll_events(float wait_time)
     if (m_is_mouse_relative_hold_enabled) {
         SDL_WarpMouseInWindow(window, m_mouse_relative_hold_xpos, m_mouse_relative_hold_ypos);
     }
-    static_cast<void>(wait_time);
 
-    //if (wait_time > 0.0f) {
-    // ERHE_PROFILE_SCOPE("wait");
-    // TODO SDL_WaitEventTimeoutNS()
-    //double  wait_time_ns_ = static_cast<double>(wait_time) * 1'000'000'000;
-    //int64_t wait_time_ns  = static_cast<int64_t>(wait_time_ns_);
+    if (wait_time > 0.0f) {
+        ERHE_PROFILE_SCOPE("wait");
+        // With nullptr, the event is left in the queue for SDL_PollEvent() below
+        const Sint32 wait_time_ms = std::max(1, static_cast<Sint32>(wait_time * 1000.0f));
+        SDL_WaitEventTimeout(nullptr, wait_time_ms);
+    }
+
     SDL_Event poll_event{};
     while (SDL_PollEvent(&poll_event)) {
         const int64_t timestamp = static_cast<int64_t>(poll_event.common.timestamp);
@@ -9,8 +9,10 @@
 #include "explorer_windows.hpp"
 #include "scene/material_library.hpp"
 #include "input_state.hpp"
+#include "redraw_tracker.hpp"
 #include "time.hpp"
 
+#include "graph/graph_session.hpp"
 #include "graph/graph_window.hpp"
 #include "graph/node_properties.hpp"
 #include "graph/node_convex_hull_visualization.hpp"
@@ -41,6 +43,7 @@
 #include "windows/composer_window.hpp"
 #include "windows/debug_view_window.hpp"
 #include "windows/layers_window.hpp"
+#include "windows/memory_window.hpp"
 #include "windows/network_window.hpp"
 #include "windows/operations.hpp"
 #include "windows/physics_window.hpp"
@@ -236,7 +239,8 @@ public:
         m_commands     ->tick(host_system_time_ns, input_events);
 
         // Once per frame updates
-        m_network_window->update_network();
+        const bool network_changed = m_network_window->update_network();
+        m_graph_session->update();
 
         // - Update all ImGui hosts. glfw window host processes input events, converting them to ImGui inputs events
         //   This may consume some input events, so that they will not get processed by m_commands.tick() below
@@ -271,6 +275,16 @@ public:
         m_graphics_instance->shader_monitor.update_once_per_frame();
         m_mesh_memory->gl_buffer_transfer_queue.flush();
 
+        // Headset views are rendered every frame
+        const bool render_frame = m_redraw_tracker->update(
+            !input_events.empty(),
+            m_explorer_context.OpenXR || network_changed || m_timeline_window->is_playing()
+        );
+        if (!render_frame) {
+            m_frame_log_window->on_frame_end();
+            return;
+        }
+
         m_explorer_rendering->begin_frame(); // tests renderdoc capture start
 
         // Execute rendergraph
@@ -278,6 +292,7 @@ public:
 
         m_imgui_renderer->next_frame();
         m_explorer_rendering->end_frame();
+        m_redraw_tracker->end_frame();
         if (!m_explorer_context.OpenXR) {
             gl::bind_framebuffer(gl::Framebuffer_target::framebuffer, 0);
             if (m_explorer_context.use_sleep) {
@@ -383,6 +398,7 @@ public:
             m_explorer_settings    = std::make_unique<Explorer_settings             >();
             m_input_state          = std::make_unique<Input_state                   >();
             m_time                 = std::make_unique<Time                          >();
+            m_redraw_tracker       = std::make_unique<Redraw_tracker                >(*m_scene_message_bus.get(), *m_explorer_message_bus.get());
             auto& commands             = *m_commands            .get();
             auto& explorer_message_bus = *m_explorer_message_bus.get();
 
@@ -530,7 +546,7 @@ public:
             auto mesh_memory_task = taskflow.emplace([this]()
             {
                 erhe::graphics::Scoped_gl_context ctx{m_graphics_instance->context_provider};
-                m_mesh_memory = std::make_unique<Mesh_memory>(*m_graphics_instance.get(), m_vertex_format);
+                m_mesh_memory = std::make_unique<Mesh_memory>(*m_graphics_instance.get(), m_vertex_format, m_executor.get());
             })  .name("Mesh_memory");
 
             auto imgui_windows_task = taskflow.emplace([this]()
@@ -595,12 +611,14 @@ public:
                 m_clipboard_window       = std::make_unique<Clipboard_window                >(*m_imgui_renderer.get(), *m_imgui_windows.get(),  m_explorer_context);
                 m_commands_window        = std::make_unique<Commands_window                 >(*m_imgui_renderer.get(), *m_imgui_windows.get(),  m_explorer_context);
                 m_layers_window          = std::make_unique<Layers_window                   >(*m_imgui_renderer.get(), *m_imgui_windows.get(),  m_explorer_context);
+                m_memory_window          = std::make_unique<Memory_window                   >(*m_imgui_renderer.get(), *m_imgui_windows.get());
                 m_network_window         = std::make_unique<Network_window                  >(*m_imgui_renderer.get(), *m_imgui_windows.get(),  m_explorer_context);
                 m_operations             = std::make_unique<Operations                      >(*m_commands.get(),       *m_imgui_renderer.get(), *m_imgui_windows.get(), m_explorer_context, *m_explorer_message_bus.get());
                 m_physics_window         = std::make_unique<Physics_window                  >(*m_imgui_renderer.get(), *m_imgui_windows.get(),  m_explorer_context);
                 m_post_processing_window = std::make_unique<Post_processing_window          >(*m_imgui_renderer.get(), *m_imgui_windows.get(),  m_explorer_context);
                 m_properties             = std::make_unique<Properties                      >(*m_imgui_renderer.get(), *m_imgui_windows.get(),  m_explorer_context);
                 m_graph_window           = std::make_unique<Graph_window                    >(*m_commands.get(),       *m_imgui_renderer.get(), *m_imgui_windows.get(),  m_explorer_context, *m_explorer_message_bus.get());
+                m_graph_session          = std::make_unique<Graph_session                   >(*m_executor.get(),       *m_commands.get(),       *m_imgui_renderer.get(), *m_imgui_windows.get(), m_explorer_context);
                 m_node_properties_window = std::make_unique<Node_properties_window          >(*m_imgui_renderer.get(), *m_imgui_windows.get(),  m_explorer_context);
                 m_tool_properties_window = std::make_unique<Tool_properties_window          >(*m_imgui_renderer.get(), *m_imgui_windows.get(),  m_explorer_context);
                 m_viewport_config_window = std::make_unique<Viewport_config_window          >(*m_imgui_renderer.get(), *m_imgui_windows.get(),  m_explorer_context);
@@ -946,6 +964,7 @@ public:
             ////m_theremin.set_developer();
 #endif
             m_layers_window         ->set_developer();
+            m_memory_window         ->set_developer();
             m_network_window        ->set_developer();
             m_post_processing_window->set_developer();
             m_graph_window          ->set_developer();
@@ -1022,6 +1041,7 @@ public:
         m_explorer_context.explorer_settings      = m_explorer_settings     .get();
         m_explorer_context.explorer_windows       = m_explorer_windows      .get();
         m_explorer_context.fly_camera_tool        = m_fly_camera_tool       .get();
+        m_explorer_context.graph_session          = m_graph_session         .get();
         m_explorer_context.graph_window           = m_graph_window          .get();
         m_explorer_context.grid_tool              = m_grid_tool             .get();
 #if defined(ERHE_XR_LIBRARY_OPENXR)
@@ -1046,6 +1066,7 @@ public:
         m_explorer_context.physics_tool                   = m_physics_tool          .get();
         m_explorer_context.post_processing                = m_post_processing       .get();
         m_explorer_context.programs                       = m_programs              .get();
+        m_explorer_context.redraw_tracker                 = m_redraw_tracker        .get();
         m_explorer_context.rotate_tool                    = m_rotate_tool           .get();
         m_explorer_context.scale_tool                     = m_scale_tool            .get();
         m_explorer_context.scene_builder                  = m_scene_builder         .get();
@@ -1084,14 +1105,15 @@ public:
         ERHE_PROFILE_FUNCTION();
 
         m_run_started = true;
-        float wait_time = m_explorer_context.use_sleep ? m_explorer_context.sleep_margin : 0.0f;
+        const float wait_time = m_explorer_context.use_sleep ? m_explorer_context.sleep_margin : 0.0f;
         // TODO: https://registry.khronos.org/OpenGL/extensions/NV/GLX_NV_delay_before_swap.txt
         // Also:
         //  - Measure time since first swapbuffers
         //  - Count number of swapbuffers
         //  - Wait to avoid presenting frames faster than display refreshrate
         while (!m_close_requested) {
-            m_context_window->poll_events(wait_time);
+            // Idle on demand rendering blocks here until the next input event
+            m_context_window->poll_events(m_redraw_tracker->get_wait_time(wait_time));
             {
                 ERHE_PROFILE_SCOPE("dispatch events");
                 auto& input_events = m_context_window->get_input_events();
@@ -1124,6 +1146,7 @@ public:
     std::unique_ptr<Explorer_message_bus          > m_explorer_message_bus;
     std::unique_ptr<Input_state                   > m_input_state;
     std::unique_ptr<Time                          > m_time;
+    std::unique_ptr<Redraw_tracker                > m_redraw_tracker;
 
     std::unique_ptr<Clipboard                              > m_clipboard;
     std::unique_ptr<erhe::window::Context_window           > m_context_window;
@@ -1163,11 +1186,13 @@ public:
     std::unique_ptr<Clipboard_window                >        m_clipboard_window;
     std::unique_ptr<Commands_window                 >        m_commands_window;
     std::unique_ptr<Layers_window                   >        m_layers_window;
+    std::unique_ptr<Memory_window                   >        m_memory_window;
     std::unique_ptr<Network_window                  >        m_network_window;
     std::unique_ptr<Operations                      >        m_operations;
     std::unique_ptr<Physics_window                  >        m_physics_window;
     std::unique_ptr<Post_processing_window          >        m_post_processing_window;
     std::unique_ptr<Properties                      >        m_properties;
+    std::unique_ptr<Graph_session                   >        m_graph_session;
     std::unique_ptr<Graph_window                    >        m_graph_window;
     std::unique_ptr<Node_convex_hull_visualization  >        m_node_convex_hull_visualization;
     std::unique_ptr<Node_properties_window          >        m_node_properties_window;
@@ -51,6 +51,7 @@ class Hand_tracker;
 class Headset_view;
 class Hotbar;
 class Hud;
+class Graph_session;
 class Graph_window;
 class Icon_browser;
 class Icon_set;
@@ -68,6 +69,7 @@ class Paint_tool;
 class Physics_tool;
 class Post_processing;
 class Programs;
+class Redraw_tracker;
 class Rotate_tool;
 class Scale_tool;
 class Scene_builder;
@@ -119,6 +121,7 @@ public:
     Explorer_settings*                      explorer_settings     {nullptr};
     Explorer_windows*                       explorer_windows      {nullptr};
     Fly_camera_tool*                        fly_camera_tool       {nullptr};
+    Graph_session*                          graph_session         {nullptr};
     Graph_window*                           graph_window          {nullptr};
     Grid_tool*                              grid_tool             {nullptr};
 #if defined(ERHE_XR_LIBRARY_OPENXR)
@@ -143,6 +146,7 @@ public:
     Physics_tool*                           physics_tool                  {nullptr};
     Post_processing*                        post_processing               {nullptr};
     Programs*                               programs                      {nullptr};
+    Redraw_tracker*                         redraw_tracker                {nullptr};
     Rotate_tool*                            rotate_tool                   {nullptr};
     Scale_tool*                             scale_tool                    {nullptr};
     Scene_builder*                          scene_builder                 {nullptr};
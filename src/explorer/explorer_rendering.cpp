@@ -4,6 +4,8 @@
 #include "explorer_log.hpp"
 #include "explorer_message_bus.hpp"
 #include "explorer_settings.hpp"
+#include "graph/node_convex_hull_visualization.hpp"
+#include "redraw_tracker.hpp"
 #include "renderable.hpp"
 #include "renderers/composer.hpp"
 #include "renderers/id_renderer.hpp"
@@ -33,8 +35,10 @@
 #include "erhe_renderer/pipeline_renderpass.hpp"
 #include "erhe_renderer/text_renderer.hpp"
 #include "erhe_rendergraph/rendergraph.hpp"
+#include "erhe_rendergraph/transient_texture_pool.hpp"
 #include "erhe_scene/scene.hpp"
 #include "erhe_scene_renderer/forward_renderer.hpp"
+#include "erhe_scene_renderer/primitive_buffer.hpp"
 #include "erhe_scene_renderer/shadow_renderer.hpp"
 #include "erhe_bit/bit_helpers.hpp"
 #include "erhe_profile/profile.hpp"
@@ -226,6 +230,7 @@ Explorer_rendering::Explorer_rendering(
     rendertarget->allow_shader_stages_override = false;
     //rendertarget->allow_shader_stages_override = true;
     explorer_message_bus.add_receiver(
+        Message_flag_bit::c_flag_bit_graphics_settings,
         [&](Explorer_message& message) {
             using namespace erhe::bit;
             if (test_all_rhs_bits_set(message.update_flags, Message_flag_bit::c_flag_bit_graphics_settings)) {
@@ -689,6 +694,56 @@ void Explorer_rendering::imgui()
         ImGui::TreePop();
     }
 
+    if (ImGui::TreeNodeEx("ID Picking", flags)) {
+        m_context.id_renderer->imgui();
+        ImGui::TreePop();
+    }
+
+    if (ImGui::TreeNodeEx("On Demand Rendering", flags)) {
+        m_context.redraw_tracker->imgui();
+        ImGui::TreePop();
+    }
+
+    if (ImGui::TreeNodeEx("Transient Textures", flags)) {
+        const auto& statistics = m_context.rendergraph->get_transient_texture_pool().get_statistics();
+        const auto mib = [](const std::size_t byte_count) -> double {
+            return static_cast<double>(byte_count) / (1024.0 * 1024.0);
+        };
+        ImGui::Text("Requests:  %zu", statistics.request_count);
+        ImGui::Text("Textures:  %zu", statistics.texture_count);
+        ImGui::Text("Requested: %.2f MiB", mib(statistics.requested_byte_count));
+        ImGui::Text("Allocated: %.2f MiB", mib(statistics.allocated_byte_count));
+        ImGui::Text("Peak:      %.2f MiB", mib(statistics.peak_byte_count));
+        ImGui::Text("Created:   %zu", statistics.created_count);
+        ImGui::Text("Released:  %zu", statistics.released_count);
+        ImGui::TreePop();
+    }
+
+    if (ImGui::TreeNodeEx("Instancing", flags)) {
+        erhe::scene_renderer::Forward_renderer& forward_renderer = *m_context.forward_renderer;
+        bool instancing = forward_renderer.is_instancing_enabled();
+        if (ImGui::Checkbox("Instanced Draws", &instancing)) {
+            forward_renderer.set_instancing_enabled(instancing);
+        }
+        const auto& draw_statistics = forward_renderer.get_statistics();
+        ImGui::Text("Draw Calls:    %zu", draw_statistics.draw_call_count);
+        ImGui::Text("Draw Commands: %zu", draw_statistics.draw_command_count);
+        ImGui::Text("Instances:     %zu", draw_statistics.instance_count);
+
+        if (m_context.node_convex_hull_visualization != nullptr) {
+            const auto& hull_statistics = m_context.node_convex_hull_visualization->get_statistics();
+            const auto kib = [](const std::size_t byte_count) -> double {
+                return static_cast<double>(byte_count) / 1024.0;
+            };
+            ImGui::Separator();
+            ImGui::Text("Hulls:         %zu", hull_statistics.hull_count);
+            ImGui::Text("Hull Shapes:   %zu", hull_statistics.geometry_count);
+            ImGui::Text("Shape Memory:  %.1f KiB", kib(hull_statistics.byte_count));
+            ImGui::Text("Saved Memory:  %.1f KiB", kib(hull_statistics.saved_byte_count));
+        }
+        ImGui::TreePop();
+    }
+
     m_composer.imgui();
 }
 
@@ -718,6 +773,10 @@ void Explorer_rendering::end_frame()
 
     m_context.id_renderer->next_frame();
 
+    // Reports primitive buffer upload bytes to the profiler
+    static_cast<void>(erhe::scene_renderer::Primitive_buffer::end_frame());
+    m_context.forward_renderer->end_frame();
+
     if (m_trigger_capture) {
         erhe::window::end_frame_capture(*m_context.context_window);
         m_trigger_capture = false;
@@ -832,6 +891,7 @@ void Explorer_rendering::render_id(const Render_context& context)
     // TODO listen to viewport changes in msg bus?
     m_context.id_renderer->render(
         Id_renderer::Render_parameters{
+            .scene_view         = &context.scene_view,
             .viewport           = context.viewport,
             .camera             = *context.camera,
             .content_mesh_spans = { layers.content()->meshes, layers.rendertarget()->meshes },
@@ -3,6 +3,7 @@
 #include "explorer_context.hpp"
 #include "explorer_log.hpp"
 #include "explorer_settings.hpp"
+#include "operations/operation_stack.hpp"
 #include "tools/tools.hpp"
 #include "scene/scene_root.hpp"
 
@@ -83,15 +84,16 @@ void Explorer_scenes::update_node_transforms()
 {
     ERHE_PROFILE_FUNCTION();
 
+    tf::Executor& executor = m_context.operation_stack->get_executor();
     for (const auto& scene_root : m_scene_roots) {
         // TODO ? std::lock_guard<std::mutex> scene_lock{scene_root->item_host_mutex};
-        scene_root->get_scene().update_node_transforms();
+        scene_root->get_scene().update_node_transforms(&executor);
     }
 
     // Not in m_scene_roots
     Scene_root& scene_root = *m_context.tools->get_tool_scene_root().get();
     // TODO ? std::lock_guard<std::mutex> scene_lock{scene_root.item_host_mutex};
-    scene_root.get_hosted_scene()->update_node_transforms();
+    scene_root.get_hosted_scene()->update_node_transforms(&executor);
 }
 
 void Explorer_scenes::after_physics_simulation_steps()
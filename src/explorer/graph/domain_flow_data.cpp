@@ -0,0 +1,120 @@
+#include "graph/domain_flow_data.hpp"
+
+#include "erhe_scene_renderer/cube_instance_buffer.hpp"
+
+#include <dfa/dfa.hpp>
+
+#include <algorithm>
+#include <limits>
+
+namespace explorer {
+
+namespace {
+
+[[nodiscard]] auto get_xyz(const std::vector<int>& p) -> glm::ivec3
+{
+    return glm::ivec3{
+        (p.size() >= 1) ? p[0] : 0,
+        (p.size() >= 2) ? p[1] : 0,
+        (p.size() >= 3) ? p[2] : 0
+    };
+}
+
+}
+
+auto has_valid_faces(const Convex_hull_data& convex_hull) -> bool
+{
+    std::size_t face_vertex_count = 0;
+    for (const uint32_t corner_count : convex_hull.face_corner_counts) {
+        face_vertex_count += corner_count;
+    }
+    if (face_vertex_count != convex_hull.face_vertices.size()) {
+        return false;
+    }
+    const std::size_t vertex_count = convex_hull.vertices.size();
+    return std::all_of(
+        convex_hull.face_vertices.begin(),
+        convex_hull.face_vertices.end(),
+        [vertex_count](const uint32_t vertex) { return vertex < vertex_count; }
+    );
+}
+
+auto get_convex_hull_data(const sw::dfa::DomainFlowNode& node) -> Convex_hull_data
+{
+    const sw::dfa::ConvexHull<int>          convex_hull = node.getConvexHull();
+    const std::vector<sw::dfa::Point<int>>& vertices    = convex_hull.vertices();
+    const std::vector<sw::dfa::Face>&       faces       = convex_hull.faces();
+
+    Convex_hull_data result;
+    result.vertices.reserve(vertices.size());
+    for (const sw::dfa::Point<int>& p : vertices) {
+        const int x = (p.dimension() >= 1) ? p.coords[0] : 0;
+        const int y = (p.dimension() >= 2) ? p.coords[1] : 0;
+        const int z = (p.dimension() >= 3) ? p.coords[2] : 0;
+        result.vertices.emplace_back(x, y, z);
+    }
+    result.face_corner_counts.reserve(faces.size());
+    for (const sw::dfa::Face& face : faces) {
+        const std::vector<size_t>& corner_vertices = face.vertices();
+        result.face_corner_counts.push_back(static_cast<uint32_t>(corner_vertices.size()));
+        for (const std::size_t vertex : corner_vertices) {
+            result.face_vertices.push_back(static_cast<uint32_t>(vertex));
+        }
+    }
+    return result;
+}
+
+auto get_schedule_data(const sw::dfa::DomainFlowNode& node) -> Schedule_data
+{
+    Schedule_data result;
+    if (!node.isOperator()) {
+        return result;
+    }
+
+    const sw::dfa::Schedule<sw::dfa::DomainFlowNode::ConstraintCoefficientType>& schedule = node.getSchedule();
+
+    glm::ivec3 max_xyz{0, 0, 0};
+    for (const auto& [time, wavefront] : schedule) {
+        for (const sw::dfa::IndexPoint& index_point : wavefront) {
+            max_xyz = glm::max(max_xyz, get_xyz(index_point.coordinates));
+        }
+    }
+
+    glm::ivec3 earliest_max_times{std::numeric_limits<int>::max()};
+    glm::ivec3 min{std::numeric_limits<int>::max()};
+    glm::ivec3 max{std::numeric_limits<int>::lowest()};
+    result.wavefronts.reserve(schedule.size());
+    for (const auto& [time_, wavefront] : schedule) {
+        const int time = static_cast<int>(time_);
+        Wavefront_data& wavefront_data = result.wavefronts.emplace_back();
+        wavefront_data.time = time;
+        wavefront_data.packed_cubes.reserve(wavefront.size());
+        for (const sw::dfa::IndexPoint& index_point : wavefront) {
+            const glm::ivec3 p = get_xyz(index_point.coordinates);
+            for (int axis = 0; axis < 3; ++axis) {
+                if (p[axis] == max_xyz[axis]) {
+                    earliest_max_times[axis] = std::min(earliest_max_times[axis], time);
+                }
+            }
+            min = glm::min(min, p);
+            max = glm::max(max, p);
+            wavefront_data.packed_cubes.push_back(erhe::scene_renderer::pack_x11y11z10(p.x, p.y, p.z));
+        }
+    }
+    std::sort(
+        result.wavefronts.begin(),
+        result.wavefronts.end(),
+        [](const Wavefront_data& lhs, const Wavefront_data& rhs)
+        {
+            return lhs.time < rhs.time;
+        }
+    );
+    if (min.x <= max.x) {
+        result.min = min;
+        result.max = max;
+    }
+    result.earliest_max_times = earliest_max_times;
+    return result;
+}
+
+} // namespace explorer
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace sw::dfa { struct DomainFlowNode; }
+
+namespace explorer {
+
+// Plain copies of the domain flow node data needed for visualization. These
+// can be built either from sw::dfa::DomainFlowNode or received from network.
+
+class Convex_hull_data
+{
+public:
+    std::vector<glm::ivec3> vertices;
+    std::vector<uint32_t>   face_corner_counts;
+    std::vector<uint32_t>   face_vertices;      // face_corner_counts[i] entries for each face
+};
+
+class Wavefront_data
+{
+public:
+    int                   time{0};
+    std::vector<uint32_t> packed_cubes;         // pack_x11y11z10()
+};
+
+class Schedule_data
+{
+public:
+    std::vector<Wavefront_data> wavefronts;     // sorted by time
+    glm::ivec3                  min               {0, 0, 0};
+    glm::ivec3                  max               {0, 0, 0};
+    glm::ivec3                  earliest_max_times{0, 0, 0};
+};
+
+// True if face corner counts add up to face vertex count, and all face
+// vertices are valid vertex indices. Hull data received from network or
+// read from session files must be checked before use.
+[[nodiscard]] auto has_valid_faces(const Convex_hull_data& convex_hull) -> bool;
+
+[[nodiscard]] auto get_convex_hull_data(const sw::dfa::DomainFlowNode& node) -> Convex_hull_data;
+[[nodiscard]] auto get_schedule_data   (const sw::dfa::DomainFlowNode& node) -> Schedule_data;
+
+} // namespace explorer
@@ -7,6 +7,7 @@
 #include "erhe_defer/defer.hpp"
 #include "erhe_graph/link.hpp"
 #include "erhe_graph/pin.hpp"
+#include "erhe_item/item_pool.hpp"
 #include "erhe_math/math_util.hpp"
 #include "erhe_scene/node.hpp"
 
@@ -37,6 +38,16 @@ auto Graph_node::get_payload() const -> size_t
     return m_payload;
 }
 
+auto Graph_node::get_depth() const -> int
+{
+    return m_depth;
+}
+
+void Graph_node::set_depth(const int depth)
+{
+    m_depth = depth;
+}
+
 auto Graph_node::get_convex_hull_visualization() -> std::shared_ptr<erhe::scene::Node>
 {
     return m_convex_hull_visualization;
@@ -56,7 +67,7 @@ void Graph_node::set_convex_hull_visualization(const std::shared_ptr<erhe::scene
         m_index_space_node->recursive_remove();
         m_index_space_node.reset();
     }
-    m_index_space_node = std::make_shared<erhe::scene::Node>("offset");
+    m_index_space_node = erhe::make_pooled_item<erhe::scene::Node>("offset");
     m_index_space_node->set_parent          (node);
     m_index_space_node->set_parent_from_node(erhe::math::create_translation<float>(index_space_offset));
 }
@@ -97,6 +108,11 @@ void Graph_node::set_wavefront_time_offset(int offset)
     m_wavefront_time_offset = offset;
 }
 
+void Graph_node::set_show_wavefront(bool show)
+{
+    m_show_wavefront = show;
+}
+
 auto Graph_node::wavefront_frames() -> std::vector<Wavefront_frame>&
 {
     return m_wavefront_frames;
@@ -155,7 +171,7 @@ void Graph_node::node_editor(Explorer_context& explorer_context, ax::NodeEditor:
     {
         ImGui::TableNextRow();
         ImGui::TableSetColumnIndex(1);
-        ImGui::TextUnformatted(m_name.c_str());
+        ImGui::TextUnformatted(get_name().c_str());
     }
 
     ImGui::TableNextRow();
@@ -212,11 +228,7 @@ void Graph_node::node_editor(Explorer_context& explorer_context, ax::NodeEditor:
     const bool item_selection   = is_selected();
     const bool editor_selection = node_editor.IsNodeSelected(get_id());
     if (item_selection != editor_selection) {
-        if (editor_selection) {
-            graph_window.get_selection().add_to_selection(shared_from_this());
-        } else {
-            graph_window.get_selection().remove_from_selection(shared_from_this());
-        }
+        graph_window.queue_selection_change(shared_from_this(), editor_selection);
     }
 }
 
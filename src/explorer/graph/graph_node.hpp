@@ -49,6 +49,8 @@ public:
     void node_editor(Explorer_context& context, ax::NodeEditor::EditorContext& node_editor, Graph_window& graph_window);
 
     [[nodiscard]] auto get_payload() const -> size_t;
+    [[nodiscard]] auto get_depth  () const -> int;
+    void set_depth(int depth);
     [[nodiscard]] auto get_convex_hull_visualization() -> std::shared_ptr<erhe::scene::Node>;
     [[nodiscard]] auto get_index_space_node() -> std::shared_ptr<erhe::scene::Node>;
     [[nodiscard]] auto wavefront_frames() -> std::vector<Wavefront_frame>&;
@@ -57,6 +59,7 @@ public:
     [[nodiscard]] auto get_wavefront_time_offset() const -> int;
     [[nodiscard]] auto show_wavefront() const -> bool;
     void set_wavefront_time_offset(int offset);
+    void set_show_wavefront       (bool show);
     void get_time_range(int& first, int& last) const;
     void set_earliest_max_times(glm::ivec3 earliest_times);
     [[nodiscard]] auto get_earliest_max_times() const -> glm::ivec3;
@@ -88,6 +91,7 @@ protected:
     static constexpr std::size_t pin_key_todo = 1;
 
     std::size_t                        m_payload;
+    int                                m_depth{0};
     int                                m_input_pin_edge {Node_edge::left};
     int                                m_output_pin_edge{Node_edge::right};
     std::shared_ptr<erhe::scene::Node> m_convex_hull_visualization;
@@ -0,0 +1,775 @@
+#include "graph/graph_session.hpp"
+
+#include "explorer_context.hpp"
+#include "explorer_log.hpp"
+#include "graph/graph_node.hpp"
+#include "graph/graph_window.hpp"
+#include "graph/timeline_window.hpp"
+#include "graph/wavefront_visualization.hpp"
+#include "net/graph_stream.hpp"
+#include "net/graph_stream_producer.hpp"
+#include "redraw_tracker.hpp"
+#include "tools/fly_camera_tool.hpp"
+
+#include "erhe_commands/commands.hpp"
+#include "erhe_configuration/configuration.hpp"
+#include "erhe_file/file.hpp"
+#include "erhe_file/mapped_file.hpp"
+#include "erhe_imgui/imgui_node_editor.h"
+#include "erhe_profile/profile.hpp"
+#include "erhe_scene/camera.hpp"
+#include "erhe_scene/node.hpp"
+#include "erhe_scene/trs_transform.hpp"
+
+#include <imgui/imgui.h>
+#include <imgui/misc/cpp/imgui_stdlib.h>
+#include <taskflow/taskflow.hpp>
+
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <span>
+
+namespace explorer {
+
+namespace {
+
+constexpr char        c_session_magic[8]  = {'E', 'R', 'H', 'E', 'S', 'E', 'S', 'S'};
+constexpr uint32_t    c_session_version   = 1;
+constexpr std::size_t c_section_alignment = 16;
+
+enum class Session_section_type : uint32_t {
+    info           = 1, // u32 length + name, u32 length + source path
+    graph_stream   = 2, // records: u32 length + graph stream message, padded to 4 bytes
+    node_layout    = 3, // Session_node_layout[]
+    node_state     = 4, // Session_node_state[]
+    node_transform = 5, // Session_node_transform[]
+    camera         = 6, // Session_camera
+    timeline       = 7  // Session_timeline
+};
+
+class Session_file_header
+{
+public:
+    char     magic[8];
+    uint32_t version;
+    uint32_t section_count;
+    uint64_t table_offset;
+    uint64_t reserved;
+};
+
+class Session_section_entry
+{
+public:
+    uint32_t type;
+    uint32_t record_count;
+    uint64_t offset;
+    uint64_t byte_count;
+    uint64_t reserved;
+};
+
+// Node ids in per node records are graph stream / domain flow graph node ids
+class Session_node_layout
+{
+public:
+    uint64_t node_id;
+    float    x;
+    float    y;
+};
+
+class Session_node_state
+{
+public:
+    static constexpr uint32_t c_flag_show_wavefront = (1u << 0);
+
+    uint64_t node_id;
+    int32_t  wavefront_time_offset;
+    uint32_t flags;
+};
+
+class Session_node_transform
+{
+public:
+    uint64_t node_id;
+    float    translation[3];
+    float    rotation[4]; // x, y, z, w
+    float    scale[3];
+};
+
+class Session_camera
+{
+public:
+    float    translation[3];
+    float    rotation[4];
+    uint32_t valid;
+};
+
+class Session_timeline
+{
+public:
+    float    play_position;
+    float    play_speed;
+    uint32_t reserved[2];
+};
+
+static_assert(sizeof(Session_file_header   ) == 32);
+static_assert(sizeof(Session_section_entry ) == 32);
+static_assert(sizeof(Session_node_layout   ) == 16);
+static_assert(sizeof(Session_node_state    ) == 16);
+static_assert(sizeof(Session_node_transform) == 48);
+static_assert(sizeof(Session_camera        ) == 32);
+static_assert(sizeof(Session_timeline      ) == 16);
+
+// Everything needed to write a session file, captured on the main thread
+class Session_snapshot
+{
+public:
+    std::filesystem::path                       path;
+    std::string                                 name;
+    std::shared_ptr<sw::dfa::DomainFlowGraph>   dfg;
+    std::shared_ptr<const std::vector<uint8_t>> stream;
+    uint32_t                                    stream_message_count{0};
+    std::vector<Session_node_layout>            node_layout;
+    std::vector<Session_node_state>             node_state;
+    std::vector<Session_node_transform>         node_transform;
+    Session_camera                              camera{};
+    Session_timeline                            timeline{};
+};
+
+class Session_file_writer
+{
+public:
+    explicit Session_file_writer(const std::filesystem::path& path)
+        : m_stream{path, std::ios::binary | std::ios::trunc}
+    {
+        // Header is written again by finish(), once the section table is known
+        const Session_file_header header{};
+        write(&header, sizeof(header));
+    }
+
+    [[nodiscard]] auto is_good() const -> bool
+    {
+        return m_stream.good();
+    }
+
+    [[nodiscard]] auto get_offset() const -> uint64_t
+    {
+        return m_offset;
+    }
+
+    void write(const void* const data, const std::size_t byte_count)
+    {
+        m_stream.write(static_cast<const char*>(data), static_cast<std::streamsize>(byte_count));
+        m_offset += byte_count;
+    }
+
+    void pad(const std::size_t alignment)
+    {
+        static constexpr uint8_t zeros[c_section_alignment]{};
+        write(zeros, (alignment - (m_offset % alignment)) % alignment);
+    }
+
+    void begin_section(const Session_section_type type)
+    {
+        pad(c_section_alignment);
+        m_sections.push_back(
+            Session_section_entry{
+                .type         = static_cast<uint32_t>(type),
+                .record_count = 0,
+                .offset       = m_offset,
+                .byte_count   = 0,
+                .reserved     = 0
+            }
+        );
+    }
+
+    void end_section(const uint32_t record_count)
+    {
+        Session_section_entry& section = m_sections.back();
+        section.record_count = record_count;
+        section.byte_count   = m_offset - section.offset;
+    }
+
+    template <typename T>
+    void write_records(const Session_section_type type, const T* const records, const std::size_t count)
+    {
+        begin_section(type);
+        write(records, count * sizeof(T));
+        end_section(static_cast<uint32_t>(count));
+    }
+
+    void write_string(const std::string_view text)
+    {
+        const uint32_t length = static_cast<uint32_t>(text.size());
+        write(&length, sizeof(length));
+        write(text.data(), text.size());
+        pad(4);
+    }
+
+    auto finish() -> bool
+    {
+        pad(c_section_alignment);
+        Session_file_header header{};
+        std::memcpy(header.magic, c_session_magic, sizeof(header.magic));
+        header.version       = c_session_version;
+        header.section_count = static_cast<uint32_t>(m_sections.size());
+        header.table_offset  = m_offset;
+        write(m_sections.data(), m_sections.size() * sizeof(Session_section_entry));
+        m_stream.seekp(0);
+        m_stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        m_stream.flush();
+        return m_stream.good();
+    }
+
+private:
+    std::ofstream                      m_stream;
+    uint64_t                           m_offset{0};
+    std::vector<Session_section_entry> m_sections;
+};
+
+[[nodiscard]] auto write_session(const Session_snapshot& snapshot) -> std::size_t
+{
+    ERHE_PROFILE_FUNCTION();
+
+    // Write to temporary file and rename, so that an interrupted save does
+    // not destroy the previous session.
+    std::filesystem::path temp_path = snapshot.path;
+    temp_path += ".tmp";
+    std::size_t byte_count = 0;
+    {
+        Session_file_writer writer{temp_path};
+        if (!writer.is_good()) {
+            log_graph->error("Failed to open '{}' for writing", erhe::file::to_string(temp_path));
+            return 0;
+        }
+
+        writer.begin_section(Session_section_type::info);
+        writer.write_string(snapshot.name);
+        writer.write_string(erhe::file::to_string(snapshot.path));
+        writer.end_section(1);
+
+        writer.begin_section(Session_section_type::graph_stream);
+        if (snapshot.dfg) {
+            uint32_t message_count = 0;
+            encode_graph_stream(
+                *snapshot.dfg.get(),
+                snapshot.name,
+                Graph_stream_producer::default_chunk_cube_count,
+                [&writer, &message_count](erhe::net::Shared_packet&& packet) {
+                    const uint8_t* const payload = packet->data() + graph_stream_packet_overhead;
+                    const uint32_t       length  = static_cast<uint32_t>(packet->size() - graph_stream_packet_overhead);
+                    writer.write(&length, sizeof(length));
+                    writer.write(payload, length);
+                    writer.pad(4);
+                    ++message_count;
+                }
+            );
+            writer.end_section(message_count);
+        } else {
+            writer.write(snapshot.stream->data(), snapshot.stream->size());
+            writer.end_section(snapshot.stream_message_count);
+        }
+
+        writer.write_records(Session_section_type::node_layout,    snapshot.node_layout.data(),    snapshot.node_layout.size());
+        writer.write_records(Session_section_type::node_state,     snapshot.node_state.data(),     snapshot.node_state.size());
+        writer.write_records(Session_section_type::node_transform, snapshot.node_transform.data(), snapshot.node_transform.size());
+        writer.write_records(Session_section_type::camera,         &snapshot.camera,               1);
+        writer.write_records(Session_section_type::timeline,       &snapshot.timeline,             1);
+        if (!writer.finish()) {
+            log_graph->error("Failed to write '{}'", erhe::file::to_string(temp_path));
+            return 0;
+        }
+        byte_count = writer.get_offset();
+    }
+
+    std::error_code error_code;
+    std::filesystem::rename(temp_path, snapshot.path, error_code);
+    if (error_code) {
+        log_graph->error("Failed to rename '{}': {}", erhe::file::to_string(temp_path), error_code.message());
+        return 0;
+    }
+    return byte_count;
+}
+
+[[nodiscard]] auto find_ui_nodes(Graph_window& graph_window) -> std::map<uint64_t, Graph_node*>
+{
+    std::map<uint64_t, Graph_node*> ui_nodes;
+    for (erhe::graph::Node* node : graph_window.get_ui_graph().get_nodes()) {
+        Graph_node* ui_node = dynamic_cast<Graph_node*>(node);
+        if (ui_node != nullptr) {
+            ui_nodes[ui_node->get_payload()] = ui_node;
+        }
+    }
+    return ui_nodes;
+}
+
+// Validated view to a mapped session file
+class Session_file_view
+{
+public:
+    [[nodiscard]] auto parse(const std::span<const uint8_t> data) -> bool
+    {
+        m_data = data;
+        if (data.size() < sizeof(Session_file_header)) {
+            return false;
+        }
+        Session_file_header header;
+        std::memcpy(&header, data.data(), sizeof(header));
+        if (std::memcmp(header.magic, c_session_magic, sizeof(header.magic)) != 0) {
+            log_graph->error("Not a session file");
+            return false;
+        }
+        if (header.version != c_session_version) {
+            log_graph->error("Unsupported session file version {}", header.version);
+            return false;
+        }
+        const uint64_t table_byte_count = uint64_t{header.section_count} * sizeof(Session_section_entry);
+        if ((header.table_offset > data.size()) || (table_byte_count > data.size() - header.table_offset)) {
+            log_graph->error("Session file section table out of range");
+            return false;
+        }
+        m_sections.resize(header.section_count);
+        std::memcpy(m_sections.data(), data.data() + header.table_offset, table_byte_count);
+        for (const Session_section_entry& section : m_sections) {
+            if (
+                (section.offset % c_section_alignment != 0) ||
+                (section.offset > data.size()) ||
+                (section.byte_count > data.size() - section.offset)
+            ) {
+                log_graph->error("Session file section {} out of range", section.type);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    [[nodiscard]] auto find(const Session_section_type type) const -> const Session_section_entry*
+    {
+        for (const Session_section_entry& section : m_sections) {
+            if (section.type == static_cast<uint32_t>(type)) {
+                return &section;
+            }
+        }
+        return nullptr;
+    }
+
+    [[nodiscard]] auto get_bytes(const Session_section_entry& section) const -> std::span<const uint8_t>
+    {
+        return m_data.subspan(static_cast<std::size_t>(section.offset), static_cast<std::size_t>(section.byte_count));
+    }
+
+    // Records are used in place; sections are aligned and records have no padding
+    template <typename T>
+    [[nodiscard]] auto get_records(const Session_section_type type) const -> std::span<const T>
+    {
+        const Session_section_entry* section = find(type);
+        if ((section == nullptr) || (section->byte_count != uint64_t{section->record_count} * sizeof(T))) {
+            return {};
+        }
+        return std::span<const T>{reinterpret_cast<const T*>(m_data.data() + section->offset), section->record_count};
+    }
+
+private:
+    std::span<const uint8_t>           m_data;
+    std::vector<Session_section_entry> m_sections;
+};
+
+// Per node, camera and timeline records as bytes, for detecting unchanged
+// sessions. Record counts are included so that sections can not alias.
+[[nodiscard]] auto get_state_bytes(const Session_snapshot& snapshot) -> std::vector<uint8_t>
+{
+    std::vector<uint8_t> bytes;
+    const auto append = [&bytes](const void* data, const std::size_t byte_count) {
+        const uint8_t* begin = static_cast<const uint8_t*>(data);
+        bytes.insert(bytes.end(), begin, begin + byte_count);
+    };
+    const uint64_t counts[3] = {
+        snapshot.node_layout.size(),
+        snapshot.node_state.size(),
+        snapshot.node_transform.size()
+    };
+    bytes.reserve(
+        sizeof(counts) +
+        snapshot.node_layout   .size() * sizeof(Session_node_layout) +
+        snapshot.node_state    .size() * sizeof(Session_node_state) +
+        snapshot.node_transform.size() * sizeof(Session_node_transform) +
+        sizeof(Session_camera) + sizeof(Session_timeline)
+    );
+    append(counts,                          sizeof(counts));
+    append(snapshot.node_layout   .data(),  snapshot.node_layout   .size() * sizeof(Session_node_layout));
+    append(snapshot.node_state    .data(),  snapshot.node_state    .size() * sizeof(Session_node_state));
+    append(snapshot.node_transform.data(),  snapshot.node_transform.size() * sizeof(Session_node_transform));
+    append(&snapshot.camera,                sizeof(Session_camera));
+    append(&snapshot.timeline,              sizeof(Session_timeline));
+    return bytes;
+}
+
+} // anonymous namespace
+
+Graph_session::Graph_session(
+    tf::Executor&                executor,
+    erhe::commands::Commands&    commands,
+    erhe::imgui::Imgui_renderer& imgui_renderer,
+    erhe::imgui::Imgui_windows&  imgui_windows,
+    Explorer_context&            explorer_context
+)
+    : Imgui_window   {imgui_renderer, imgui_windows, "Session", "session"}
+    , m_executor     {executor}
+    , m_context      {explorer_context}
+    , m_save_command {commands, "File.Save Session", [this]() -> bool {
+        const std::optional<std::filesystem::path> path = erhe::file::select_file_for_write();
+        return save(path.has_value() ? path.value() : erhe::file::from_string(m_path));
+    }}
+    , m_open_command {commands, "File.Open Session", [this]() -> bool {
+        const std::optional<std::filesystem::path> path = erhe::file::select_file_for_read();
+        return load(path.has_value() ? path.value() : erhe::file::from_string(m_path));
+    }}
+    , m_replay_client{explorer_context}
+{
+    const auto& ini = erhe::configuration::get_ini_file_section("erhe.ini", "session");
+    ini.get("path",              m_path);
+    ini.get("autosave_interval", m_autosave_interval_s);
+    ini.get("load_on_startup",   m_load_on_startup);
+
+    commands.register_command(&m_save_command);
+    commands.register_command(&m_open_command);
+    commands.bind_command_to_menu(&m_save_command, "File.Save Session");
+    commands.bind_command_to_menu(&m_open_command, "File.Open Session");
+
+    m_last_save_time = std::chrono::steady_clock::now();
+}
+
+Graph_session::~Graph_session() noexcept
+{
+    complete_save(true);
+}
+
+auto Graph_session::is_saving() const -> bool
+{
+    return m_save_future.valid();
+}
+
+void Graph_session::complete_save(const bool wait)
+{
+    if (!m_save_future.valid()) {
+        return;
+    }
+    if (!wait && (m_save_future.wait_for(std::chrono::seconds{0}) != std::future_status::ready)) {
+        return;
+    }
+    Save_result result = m_save_future.get();
+    if (!result.ok) {
+        log_graph->error("Saving session '{}' failed", erhe::file::to_string(result.path));
+        return;
+    }
+    m_last_byte_count    = result.byte_count;
+    m_last_save_ms       = result.duration_ms;
+    m_saved_path         = result.path;
+    m_saved_graph        = result.graph;
+    m_saved_graph_serial = result.graph_serial;
+    m_saved_state        = std::move(result.state);
+    log_graph->info(
+        "Saved session '{}', {} bytes in {:.1f} ms",
+        erhe::file::to_string(result.path), result.byte_count, result.duration_ms
+    );
+}
+
+auto Graph_session::save(const std::filesystem::path& path) -> bool
+{
+    return start_save(path, false);
+}
+
+auto Graph_session::start_save(const std::filesystem::path& path, const bool only_if_changed) -> bool
+{
+    ERHE_PROFILE_FUNCTION();
+
+    if constexpr (std::endian::native != std::endian::little) {
+        log_graph->error("Session files are not supported on big endian hosts");
+        return false;
+    }
+    if (is_saving()) {
+        log_graph->warn("Session save already in progress");
+        return false;
+    }
+    Graph_window* graph_window = m_context.graph_window;
+    if (graph_window == nullptr) {
+        return false;
+    }
+
+    Session_snapshot snapshot;
+    snapshot.path = path;
+    snapshot.name = erhe::file::to_string(path.stem());
+    snapshot.dfg  = graph_window->get_shared_domain_flow_graph();
+    if (!snapshot.dfg) {
+        if (!m_loaded_stream || (m_loaded_stream_graph_serial != graph_window->get_graph_serial())) {
+            log_graph->warn("Nothing to save - session can be saved for graphs loaded from file or from a session");
+            return false;
+        }
+        snapshot.stream               = m_loaded_stream;
+        snapshot.stream_message_count = m_loaded_stream_message_count;
+    }
+
+    ax::NodeEditor::EditorContext* node_editor = graph_window->get_node_editor();
+    for (const auto& [node_id, ui_node] : find_ui_nodes(*graph_window)) {
+        const ImVec2 position = node_editor->GetNodePosition(ui_node->get_id());
+        snapshot.node_layout.push_back(Session_node_layout{node_id, position.x, position.y});
+        snapshot.node_state.push_back(
+            Session_node_state{
+                .node_id               = node_id,
+                .wavefront_time_offset = ui_node->get_wavefront_time_offset(),
+                .flags                 = ui_node->show_wavefront() ? Session_node_state::c_flag_show_wavefront : 0u
+            }
+        );
+        const std::shared_ptr<erhe::scene::Node> hull_node = ui_node->get_convex_hull_visualization();
+        if (hull_node) {
+            const erhe::scene::Trs_transform& transform   = hull_node->parent_from_node_transform();
+            const glm::vec3                   translation = transform.get_translation();
+            const glm::quat                   rotation    = transform.get_rotation();
+            const glm::vec3                   scale       = transform.get_scale();
+            snapshot.node_transform.push_back(
+                Session_node_transform{
+                    .node_id     = node_id,
+                    .translation = {translation.x, translation.y, translation.z},
+                    .rotation    = {rotation.x, rotation.y, rotation.z, rotation.w},
+                    .scale       = {scale.x, scale.y, scale.z}
+                }
+            );
+        }
+    }
+
+    const erhe::scene::Camera* camera      = (m_context.fly_camera_tool != nullptr) ? m_context.fly_camera_tool->get_camera() : nullptr;
+    const erhe::scene::Node*   camera_node = (camera != nullptr) ? camera->get_node() : nullptr;
+    if (camera_node != nullptr) {
+        const erhe::scene::Trs_transform& world_from_node = camera_node->world_from_node_transform();
+        const glm::vec3                   translation     = world_from_node.get_translation();
+        const glm::quat                   rotation        = world_from_node.get_rotation();
+        snapshot.camera = Session_camera{
+            .translation = {translation.x, translation.y, translation.z},
+            .rotation    = {rotation.x, rotation.y, rotation.z, rotation.w},
+            .valid       = 1
+        };
+    }
+    if (m_context.timeline_window != nullptr) {
+        snapshot.timeline.play_position = m_context.timeline_window->get_play_position();
+        snapshot.timeline.play_speed    = m_context.timeline_window->get_play_speed();
+    }
+
+    const void*          graph        = snapshot.dfg ? static_cast<const void*>(snapshot.dfg.get()) : static_cast<const void*>(snapshot.stream.get());
+    const uint64_t       graph_serial = graph_window->get_graph_serial();
+    std::vector<uint8_t> state        = get_state_bytes(snapshot);
+    if (
+        only_if_changed &&
+        (path         == m_saved_path) &&
+        (graph        == m_saved_graph) &&
+        (graph_serial == m_saved_graph_serial) &&
+        (state        == m_saved_state)
+    ) {
+        return false;
+    }
+
+    m_last_save_time = std::chrono::steady_clock::now();
+    m_save_future = m_executor.async(
+        [snapshot = std::move(snapshot), graph, graph_serial, state = std::move(state)]() mutable -> Save_result {
+            const auto        start_time = std::chrono::steady_clock::now();
+            const std::size_t byte_count = write_session(snapshot);
+            const std::chrono::duration<float, std::milli> duration = std::chrono::steady_clock::now() - start_time;
+            return Save_result{
+                .path         = snapshot.path,
+                .ok           = byte_count > 0,
+                .byte_count   = byte_count,
+                .duration_ms  = duration.count(),
+                .graph        = graph,
+                .graph_serial = graph_serial,
+                .state        = std::move(state)
+            };
+        }
+    );
+    return true;
+}
+
+auto Graph_session::load(const std::filesystem::path& path) -> bool
+{
+    ERHE_PROFILE_FUNCTION();
+
+    if constexpr (std::endian::native != std::endian::little) {
+        log_graph->error("Session files are not supported on big endian hosts");
+        return false;
+    }
+    Graph_window* graph_window = m_context.graph_window;
+    if (graph_window == nullptr) {
+        return false;
+    }
+
+    // Make sure a pending save of the same file is complete
+    complete_save(true);
+
+    const auto start_time = std::chrono::steady_clock::now();
+
+    erhe::file::Mapped_file file;
+    if (!file.open("Session", path)) {
+        return false;
+    }
+    const std::string_view text = file.get_text();
+    Session_file_view view;
+    if (!view.parse(std::span<const uint8_t>{reinterpret_cast<const uint8_t*>(text.data()), text.size()})) {
+        log_graph->error("Invalid session file '{}'", erhe::file::to_string(path));
+        return false;
+    }
+
+    // Graph, hulls and wavefronts
+    const Session_section_entry* stream_section = view.find(Session_section_type::graph_stream);
+    if (stream_section == nullptr) {
+        log_graph->error("Session file '{}' has no graph", erhe::file::to_string(path));
+        return false;
+    }
+    const std::span<const uint8_t> stream_bytes = view.get_bytes(*stream_section);
+    std::vector<std::span<const uint8_t>> messages;
+    messages.reserve(stream_section->record_count);
+    for (std::size_t offset = 0; offset + sizeof(uint32_t) <= stream_bytes.size();) {
+        uint32_t length = 0;
+        std::memcpy(&length, stream_bytes.data() + offset, sizeof(length));
+        offset += sizeof(length);
+        if (length > stream_bytes.size() - offset) {
+            log_graph->error("Session file '{}' graph stream message out of range", erhe::file::to_string(path));
+            return false;
+        }
+        messages.push_back(stream_bytes.subspan(offset, length));
+        offset += (length + 3u) & ~std::size_t{3u};
+    }
+    graph_window->clear();
+    if (!m_replay_client.replay(messages)) {
+        log_graph->warn("Session file '{}' graph stream was incomplete or had errors", erhe::file::to_string(path));
+    }
+    m_loaded_stream = std::make_shared<const std::vector<uint8_t>>(stream_bytes.begin(), stream_bytes.end());
+    m_loaded_stream_message_count = static_cast<uint32_t>(messages.size());
+    m_loaded_stream_graph_serial  = graph_window->get_graph_serial();
+    m_saved_graph = nullptr;
+    m_saved_state.clear();
+
+    // Layout and visualization state
+    const std::map<uint64_t, Graph_node*> ui_nodes = find_ui_nodes(*graph_window);
+    const auto get_ui_node = [&ui_nodes](const uint64_t node_id) -> Graph_node* {
+        const auto i = ui_nodes.find(node_id);
+        return (i != ui_nodes.end()) ? i->second : nullptr;
+    };
+    ax::NodeEditor::EditorContext* node_editor = graph_window->get_node_editor();
+    for (const Session_node_layout& record : view.get_records<Session_node_layout>(Session_section_type::node_layout)) {
+        Graph_node* ui_node = get_ui_node(record.node_id);
+        if (ui_node != nullptr) {
+            node_editor->SetNodePosition(ui_node->get_id(), ImVec2{record.x, record.y});
+        }
+    }
+    for (const Session_node_state& record : view.get_records<Session_node_state>(Session_section_type::node_state)) {
+        Graph_node* ui_node = get_ui_node(record.node_id);
+        if (ui_node != nullptr) {
+            ui_node->set_wavefront_time_offset(record.wavefront_time_offset);
+            ui_node->set_show_wavefront((record.flags & Session_node_state::c_flag_show_wavefront) != 0);
+        }
+    }
+    for (const Session_node_transform& record : view.get_records<Session_node_transform>(Session_section_type::node_transform)) {
+        Graph_node* ui_node = get_ui_node(record.node_id);
+        const std::shared_ptr<erhe::scene::Node> hull_node = (ui_node != nullptr) ? ui_node->get_convex_hull_visualization() : std::shared_ptr<erhe::scene::Node>{};
+        if (hull_node) {
+            hull_node->set_parent_from_node(
+                erhe::scene::Trs_transform{
+                    glm::vec3{record.translation[0], record.translation[1], record.translation[2]},
+                    glm::quat{record.rotation[3], record.rotation[0], record.rotation[1], record.rotation[2]},
+                    glm::vec3{record.scale[0], record.scale[1], record.scale[2]}
+                }
+            );
+        }
+    }
+    if (m_context.wavefront_visualization != nullptr) {
+        m_context.wavefront_visualization->apply_baseline();
+    }
+
+    // Camera and timeline
+    const std::span<const Session_camera> camera_records = view.get_records<Session_camera>(Session_section_type::camera);
+    erhe::scene::Camera* camera      = (m_context.fly_camera_tool != nullptr) ? m_context.fly_camera_tool->get_camera() : nullptr;
+    erhe::scene::Node*   camera_node = (camera != nullptr) ? camera->get_node() : nullptr;
+    if ((camera_records.size() == 1) && (camera_records[0].valid != 0) && (camera_node != nullptr)) {
+        const Session_camera& record = camera_records[0];
+        camera_node->set_world_from_node(
+            erhe::scene::Trs_transform{
+                glm::vec3{record.translation[0], record.translation[1], record.translation[2]},
+                glm::quat{record.rotation[3], record.rotation[0], record.rotation[1], record.rotation[2]}
+            }
+        );
+        // Resynchronize camera controller with the new node transform
+        m_context.fly_camera_tool->set_camera(camera);
+    }
+    const std::span<const Session_timeline> timeline_records = view.get_records<Session_timeline>(Session_section_type::timeline);
+    if ((timeline_records.size() == 1) && (m_context.timeline_window != nullptr)) {
+        m_context.timeline_window->set_play_speed   (timeline_records[0].play_speed);
+        m_context.timeline_window->set_play_position(timeline_records[0].play_position);
+    }
+
+    if (m_context.redraw_tracker != nullptr) {
+        m_context.redraw_tracker->request_redraw();
+    }
+
+    const std::chrono::duration<float, std::milli> duration = std::chrono::steady_clock::now() - start_time;
+    m_last_load_ms = duration.count();
+    log_graph->info(
+        "Opened session '{}', {} nodes, {} messages in {:.1f} ms",
+        erhe::file::to_string(path), ui_nodes.size(), messages.size(), m_last_load_ms
+    );
+    return true;
+}
+
+void Graph_session::update()
+{
+    ERHE_PROFILE_FUNCTION();
+
+    complete_save(false);
+
+    if (!m_startup_done) {
+        m_startup_done = true;
+        if (m_load_on_startup) {
+            static_cast<void>(load(erhe::file::from_string(m_path)));
+        }
+        return;
+    }
+
+    if ((m_autosave_interval_s <= 0.0f) || is_saving() || (m_context.graph_window == nullptr)) {
+        return;
+    }
+    const std::chrono::duration<float> since_last_save = std::chrono::steady_clock::now() - m_last_save_time;
+    if (since_last_save.count() < m_autosave_interval_s) {
+        return;
+    }
+    m_last_save_time = std::chrono::steady_clock::now();
+
+    // Graphs which can not be saved are skipped quietly, as are sessions
+    // which have not changed since the last save
+    const Graph_window* graph_window = m_context.graph_window;
+    const bool has_stream = m_loaded_stream && (m_loaded_stream_graph_serial == graph_window->get_graph_serial());
+    if ((graph_window->get_domain_flow_graph() != nullptr) || has_stream) {
+        static_cast<void>(start_save(erhe::file::from_string(m_path), true));
+    }
+}
+
+void Graph_session::imgui()
+{
+    ImGui::InputText("Path", &m_path);
+    ImGui::BeginDisabled(is_saving());
+    if (ImGui::Button("Save")) {
+        static_cast<void>(save(erhe::file::from_string(m_path)));
+    }
+    ImGui::EndDisabled();
+    ImGui::SameLine();
+    if (ImGui::Button("Open")) {
+        static_cast<void>(load(erhe::file::from_string(m_path)));
+    }
+    ImGui::DragFloat("Autosave Interval", &m_autosave_interval_s, 1.0f, 0.0f, 3600.0f, "%.0f s");
+    ImGui::Checkbox ("Load on Startup",   &m_load_on_startup);
+
+    ImGui::Text("Last save: %zu bytes, %.1f ms", m_last_byte_count, m_last_save_ms);
+    ImGui::Text("Last open: %.1f ms", m_last_load_ms);
+    if (is_saving()) {
+        ImGui::TextUnformatted("Saving...");
+    }
+}
+
+} // namespace explorer
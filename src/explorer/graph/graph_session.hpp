@@ -0,0 +1,121 @@
+#pragma once
+
+#include "net/graph_stream_client.hpp"
+
+#include "erhe_commands/command.hpp"
+#include "erhe_imgui/imgui_window.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace erhe::commands {
+    class Commands;
+}
+namespace erhe::imgui {
+    class Imgui_windows;
+}
+namespace tf {
+    class Executor;
+}
+
+namespace explorer {
+
+class Explorer_context;
+
+// Saves and opens graph sessions: graph with hulls and wavefronts (as graph
+// stream messages, see net/graph_stream.hpp), node editor layout, per node
+// visualization state, hull scene node transforms, camera and timeline.
+//
+// The file is a header, 16 byte aligned sections and a section table at the
+// end. Per node sections are arrays of fixed size little endian records, so
+// they can be used directly from a memory mapped file. Saving snapshots
+// state on the main thread and writes the file from a worker thread; graph
+// stream messages are encoded and written one at a time.
+//
+// Autosave is skipped when graph, layout, visualization state, camera and
+// timeline are unchanged since the last successful save to the same path.
+// Any change rewrites the whole file: the graph stream section dominates
+// the file size and sections are packed back to back, so rewriting only
+// dirty sections in place would save little over writing to a temporary
+// file and renaming it, which keeps an interrupted save from destroying
+// the previous session.
+class Graph_session : public erhe::imgui::Imgui_window
+{
+public:
+    Graph_session(
+        tf::Executor&                executor,
+        erhe::commands::Commands&    commands,
+        erhe::imgui::Imgui_renderer& imgui_renderer,
+        erhe::imgui::Imgui_windows&  imgui_windows,
+        Explorer_context&            explorer_context
+    );
+    ~Graph_session() noexcept override;
+
+    // Implements Imgui_window
+    void imgui() override;
+
+    // Once per frame: completes background saves, autosave, load on startup
+    void update();
+
+    auto save(const std::filesystem::path& path) -> bool; // false if save could not be started
+    auto load(const std::filesystem::path& path) -> bool;
+
+    [[nodiscard]] auto is_saving() const -> bool;
+
+private:
+    class Save_result
+    {
+    public:
+        std::filesystem::path path;
+        bool                  ok          {false};
+        std::size_t           byte_count  {0};
+        float                 duration_ms {0.0f};
+        const void*           graph       {nullptr};
+        uint64_t              graph_serial{0};
+        std::vector<uint8_t>  state;
+    };
+
+    auto start_save   (const std::filesystem::path& path, bool only_if_changed) -> bool;
+    void complete_save(bool wait);
+
+    tf::Executor&                               m_executor;
+    Explorer_context&                           m_context;
+    erhe::commands::Lambda_command              m_save_command;
+    erhe::commands::Lambda_command              m_open_command;
+    Graph_stream_client                         m_replay_client;
+
+    std::string                                 m_path                {"explorer.session"};
+    float                                       m_autosave_interval_s {0.0f};
+    bool                                        m_load_on_startup     {false};
+    bool                                        m_startup_done        {false};
+    std::chrono::steady_clock::time_point       m_last_save_time;
+    std::future<Save_result>                    m_save_future;
+
+    // Graph stream section of the last opened session. Saving without a
+    // domain flow graph (graph was not loaded from a file) writes it back,
+    // as long as the graph has not been replaced since.
+    std::shared_ptr<const std::vector<uint8_t>> m_loaded_stream;
+    uint32_t                                    m_loaded_stream_message_count{0};
+    uint64_t                                    m_loaded_stream_graph_serial {0};
+
+    // Content of the last successful save, see Save_result. The graph is
+    // identified by domain flow graph or graph stream and graph serial,
+    // everything else by the bytes of the per node, camera and timeline
+    // records.
+    std::filesystem::path                       m_saved_path;
+    const void*                                 m_saved_graph       {nullptr};
+    uint64_t                                    m_saved_graph_serial{0};
+    std::vector<uint8_t>                        m_saved_state;
+
+    // Statistics
+    std::size_t                                 m_last_byte_count     {0};
+    float                                       m_last_save_ms        {0.0f};
+    float                                       m_last_load_ms        {0.0f};
+};
+
+} // namespace explorer
@@ -82,6 +82,7 @@ Graph_window::Graph_window(
     static_cast<void>(commands); // TODO Keeping in case we need to add commands here
 
     explorer_message_bus.add_receiver(
+        Message_flag_bit::c_flag_bit_selection,
         [&](Explorer_message& message) {
             on_message(message);
         }
@@ -113,6 +114,7 @@ auto Graph_window::flags() -> ImGuiWindowFlags
 
 void Graph_window::clear()
 {
+    ++m_graph_serial;
     clear_constructor_subset();
     m_selection->clear_selection();
 }
@@ -148,6 +150,16 @@ auto Graph_window::get_domain_flow_graph() const -> sw::dfa::DomainFlowGraph*
     return m_dfg.get();
 }
 
+auto Graph_window::get_shared_domain_flow_graph() const -> std::shared_ptr<sw::dfa::DomainFlowGraph>
+{
+    return m_dfg;
+}
+
+auto Graph_window::get_graph_serial() const -> uint64_t
+{
+    return m_graph_serial;
+}
+
 auto Graph_window::get_ui_graph() -> Graph&
 {
     return m_graph;
@@ -174,6 +186,15 @@ void Graph_window::fit()
     m_pending_navigate_to_content = true;
 }
 
+void Graph_window::queue_selection_change(const std::shared_ptr<erhe::Item_base>& item, const bool selected)
+{
+    if (selected) {
+        m_queued_select.push_back(item);
+    } else {
+        m_queued_deselect.push_back(item);
+    }
+}
+
 void Graph_window::imgui()
 {
     m_node_editor->Begin("Graph", ImVec2{0.0f, 0.0f});
@@ -183,6 +204,15 @@ void Graph_window::imgui()
         graph_node->node_editor(m_context, *m_node_editor.get(), *this);
     }
 
+    // Box selecting many nodes produces one selection change message
+    if (!m_queued_select.empty() || !m_queued_deselect.empty()) {
+        Scoped_selection_change selection_change{*m_selection.get()};
+        m_selection->remove_from_selection(m_queued_deselect);
+        m_selection->add_to_selection(m_queued_select);
+        m_queued_select.clear();
+        m_queued_deselect.clear();
+    }
+
     // Links
     for (const std::unique_ptr<erhe::graph::Link>& link : m_graph.get_links()) {
         m_node_editor->Link(
@@ -246,19 +276,15 @@ void Graph_window::imgui()
         }
 #endif
 
+        // Link ids are link pointers, deleted links are removed in one pass
+        std::vector<erhe::graph::Link*> deleted_links;
         ax::NodeEditor::LinkId link_handle;
         while (m_node_editor->QueryDeletedLink(&link_handle)) {
             if (m_node_editor->AcceptDeletedItem()) {
-                std::vector<std::unique_ptr<erhe::graph::Link>>& links = m_graph.get_links();
-                auto i = std::find_if(links.begin(), links.end(), [link_handle](const std::unique_ptr<erhe::graph::Link>& entry){
-                    ax::NodeEditor::LinkId entry_link_id = ax::NodeEditor::LinkId{entry.get()};
-                    return entry_link_id == link_handle;
-                });
-                if (i != links.end()) {
-                    m_graph.disconnect(i->get());
-                }
+                deleted_links.push_back(link_handle.AsPointer<erhe::graph::Link>());
             }
         }
+        m_graph.disconnect(deleted_links);
     }
     m_node_editor->EndDelete();
 
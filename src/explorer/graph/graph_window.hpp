@@ -4,7 +4,9 @@
 
 #include "erhe_imgui/imgui_window.hpp"
 
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 namespace erhe::commands {
     class Commands;
@@ -51,8 +53,10 @@ public:
     void imgui() override;
     auto flags() -> ImGuiWindowFlags override;
 
-    [[nodiscard]] auto get_selection        () -> Selection&;
-    [[nodiscard]] auto get_domain_flow_graph() const -> sw::dfa::DomainFlowGraph*;
+    [[nodiscard]] auto get_selection               () -> Selection&;
+    [[nodiscard]] auto get_domain_flow_graph       () const -> sw::dfa::DomainFlowGraph*;
+    [[nodiscard]] auto get_shared_domain_flow_graph() const -> std::shared_ptr<sw::dfa::DomainFlowGraph>;
+    [[nodiscard]] auto get_graph_serial            () const -> uint64_t; // incremented by clear()
     void set_domain_flow_graph(const std::shared_ptr<sw::dfa::DomainFlowGraph>& dfg);
     auto get_ui_graph         () -> Graph&;
     auto get_node_editor      () -> ax::NodeEditor::EditorContext*;
@@ -61,6 +65,10 @@ public:
     void fit         ();
     void graph_loaded();
 
+    // Node editor selection changes are collected while drawing nodes and
+    // applied as a single selection change at the end of the frame.
+    void queue_selection_change(const std::shared_ptr<erhe::Item_base>& item, bool selected);
+
 private:
     void clear_constructor_subset();
     void on_message(Explorer_message& message);
@@ -71,7 +79,10 @@ private:
     std::unique_ptr<ax::NodeEditor::EditorContext> m_node_editor;
     std::unique_ptr<Node_style_editor_window>      m_style_editor_window;
     bool                                           m_pending_navigate_to_content{false};
+    std::vector<std::shared_ptr<erhe::Item_base>>  m_queued_select;
+    std::vector<std::shared_ptr<erhe::Item_base>>  m_queued_deselect;
     std::shared_ptr<sw::dfa::DomainFlowGraph>      m_dfg;
+    uint64_t                                       m_graph_serial{0};
 };
 
 } // namespace explorer
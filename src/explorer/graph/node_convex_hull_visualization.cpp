@@ -1,4 +1,5 @@
 #include "graph/node_convex_hull_visualization.hpp"
+#include "graph/domain_flow_data.hpp"
 #include "graph/graph_node.hpp"
 #include "graph/graph_window.hpp"
 #include "explorer_log.hpp"
@@ -19,12 +20,15 @@
 #include "tools/transform/transform_tool.hpp"
 
 #include "erhe_bit/bit_helpers.hpp"
+#include "erhe_geometry/geometry.hpp"
 #include "erhe_geometry/shapes/convex_hull.hpp"
 #include "erhe_imgui/imgui_windows.hpp"
 #include "erhe_imgui/imgui_renderer.hpp"
+#include "erhe_item/item_pool.hpp"
 #include "erhe_primitive/primitive.hpp"
 #include "erhe_primitive/primitive_builder.hpp"
 #include "erhe_primitive/buffer_mesh.hpp"
+#include "erhe_primitive/triangle_soup.hpp"
 #include "erhe_profile/profile.hpp"
 #include "erhe_renderer/line_renderer.hpp"
 #include "erhe_renderer/scoped_line_renderer.hpp"
@@ -34,10 +38,168 @@
 
 #include <dfa/dfa.hpp>
 
-#include <geogram/mesh/mesh_repair.h>
+#include <algorithm>
+#include <cstring>
 
 namespace explorer {
 
+namespace {
+
+// Convex hull faces are planar and convex, so the mesh can be built directly
+// without the general geometry processing: each face is oriented outwards by
+// comparing its normal against the direction from the hull center, and facet
+// normals, facet centroids and smooth vertex normals are written as faces are
+// added. Raytrace triangles use shared hull vertices and are fanned in the
+// same order as build_buffer_mesh() fans fill triangles, so raytrace triangle
+// ids map to the same facets. Returns false if no face has three corners.
+auto build_convex_hull_mesh(
+    const Convex_hull_data&         convex_hull,
+    const glm::vec3                 offset,
+    erhe::geometry::Geometry&       geometry,
+    erhe::primitive::Triangle_soup& raytrace_triangles
+) -> bool
+{
+    ERHE_PROFILE_FUNCTION();
+
+    GEO::Mesh&                       geo_mesh   = geometry.get_mesh();
+    erhe::geometry::Mesh_attributes& attributes = geometry.get_attributes();
+
+    const std::size_t vertex_count = convex_hull.vertices.size();
+    std::vector<GEO::vec3f> positions(vertex_count);
+    GEO::vec3f center{0.0f, 0.0f, 0.0f};
+    geo_mesh.vertices.create_vertices(static_cast<GEO::index_t>(vertex_count));
+    for (std::size_t vertex = 0; vertex < vertex_count; ++vertex) {
+        const glm::vec3 p = glm::vec3{convex_hull.vertices[vertex]} + offset;
+        positions[vertex] = GEO::vec3f{p.x, p.y, p.z};
+        center += positions[vertex];
+        set_pointf(geo_mesh.vertices, static_cast<GEO::index_t>(vertex), positions[vertex]);
+    }
+    center = (1.0f / static_cast<float>(vertex_count)) * center;
+
+    raytrace_triangles.vertex_format = erhe::dataformat::Vertex_format{
+        {
+            0,
+            {{erhe::dataformat::Format::format_32_vec3_float, erhe::dataformat::Vertex_attribute_usage::position}}
+        }
+    };
+    raytrace_triangles.vertex_data.resize(vertex_count * sizeof(GEO::vec3f));
+    std::memcpy(raytrace_triangles.vertex_data.data(), positions.data(), raytrace_triangles.vertex_data.size());
+    raytrace_triangles.index_data.reserve(3 * convex_hull.face_vertices.size());
+
+    std::vector<GEO::vec3f> vertex_normal_sums(vertex_count, GEO::vec3f{0.0f, 0.0f, 0.0f});
+    std::vector<uint32_t>   face_vertices;
+    std::size_t face_vertex_begin = 0;
+    for (const uint32_t corner_count : convex_hull.face_corner_counts) {
+        const std::size_t face_vertex_end = face_vertex_begin + corner_count;
+        face_vertices.assign(
+            convex_hull.face_vertices.begin() + face_vertex_begin,
+            convex_hull.face_vertices.begin() + face_vertex_end
+        );
+        face_vertex_begin = face_vertex_end;
+        if (corner_count < 3) {
+            continue;
+        }
+
+        // Newell's method
+        GEO::vec3f normal  {0.0f, 0.0f, 0.0f};
+        GEO::vec3f centroid{0.0f, 0.0f, 0.0f};
+        for (uint32_t i = 0; i < corner_count; ++i) {
+            const GEO::vec3f& a = positions[face_vertices[i]];
+            const GEO::vec3f& b = positions[face_vertices[(i + 1) % corner_count]];
+            normal.x += (a.y - b.y) * (a.z + b.z);
+            normal.y += (a.z - b.z) * (a.x + b.x);
+            normal.z += (a.x - b.x) * (a.y + b.y);
+            centroid += a;
+        }
+        centroid = (1.0f / static_cast<float>(corner_count)) * centroid;
+        if (GEO::dot(normal, centroid - center) < 0.0f) {
+            std::reverse(face_vertices.begin(), face_vertices.end());
+            normal = -normal;
+        }
+
+        const GEO::index_t facet = geo_mesh.facets.create_polygon(static_cast<GEO::index_t>(corner_count));
+        for (uint32_t i = 0; i < corner_count; ++i) {
+            geo_mesh.facets.set_vertex(facet, static_cast<GEO::index_t>(i), static_cast<GEO::index_t>(face_vertices[i]));
+        }
+        for (uint32_t i = 2; i < corner_count; ++i) {
+            raytrace_triangles.index_data.push_back(face_vertices[0]);
+            raytrace_triangles.index_data.push_back(face_vertices[i - 1]);
+            raytrace_triangles.index_data.push_back(face_vertices[i]);
+        }
+        attributes.facet_centroid.set(facet, centroid);
+        if (GEO::length2(normal) > 0.0f) {
+            const GEO::vec3f unit_normal = GEO::normalize(normal);
+            attributes.facet_normal.set(facet, unit_normal);
+            for (const uint32_t vertex : face_vertices) {
+                vertex_normal_sums[vertex] += unit_normal;
+            }
+        }
+    }
+    if (geo_mesh.facets.nb() == 0) {
+        return false;
+    }
+    for (std::size_t vertex = 0; vertex < vertex_count; ++vertex) {
+        if (GEO::length2(vertex_normal_sums[vertex]) > 0.0f) {
+            attributes.vertex_normal_smooth.set(static_cast<GEO::index_t>(vertex), GEO::normalize(vertex_normal_sums[vertex]));
+        }
+    }
+
+    // Connectivity and edges are needed for edge lines, and for geometry
+    // operations applied to hulls later
+    geometry.process(
+        erhe::geometry::Geometry::process_flag_connect |
+        erhe::geometry::Geometry::process_flag_build_edges
+    );
+    return true;
+}
+
+// Integer description of centered hull: vertex count, vertices doubled so
+// that the center is integral, face corner counts and face vertices. Hulls
+// with equal content build equal meshes.
+void get_hull_content(const Convex_hull_data& convex_hull, const erhe::math::Bounding_box& input_aabb, std::vector<int32_t>& content)
+{
+    const glm::ivec3 double_center = glm::ivec3{input_aabb.min} + glm::ivec3{input_aabb.max};
+    content.clear();
+    content.reserve(2 + 3 * convex_hull.vertices.size() + convex_hull.face_corner_counts.size() + convex_hull.face_vertices.size());
+    content.push_back(static_cast<int32_t>(convex_hull.vertices.size()));
+    for (const glm::ivec3& p : convex_hull.vertices) {
+        const glm::ivec3 centered = 2 * p - double_center;
+        content.push_back(centered.x);
+        content.push_back(centered.y);
+        content.push_back(centered.z);
+    }
+    content.push_back(static_cast<int32_t>(convex_hull.face_corner_counts.size()));
+    for (const uint32_t corner_count : convex_hull.face_corner_counts) {
+        content.push_back(static_cast<int32_t>(corner_count));
+    }
+    for (const uint32_t vertex : convex_hull.face_vertices) {
+        content.push_back(static_cast<int32_t>(vertex));
+    }
+}
+
+[[nodiscard]] auto hash_hull_content(const std::vector<int32_t>& content) -> uint64_t
+{
+    // FNV-1a
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (const int32_t value : content) {
+        hash ^= static_cast<uint32_t>(value);
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+[[nodiscard]] auto get_primitive_byte_count(const erhe::primitive::Primitive& primitive) -> std::size_t
+{
+    const erhe::primitive::Buffer_mesh& buffer_mesh = primitive.render_shape->get_renderable_mesh();
+    std::size_t byte_count = buffer_mesh.index_buffer_range.get_byte_size();
+    for (const erhe::primitive::Buffer_range& vertex_buffer_range : buffer_mesh.vertex_buffer_ranges) {
+        byte_count += vertex_buffer_range.get_byte_size();
+    }
+    return byte_count + primitive.render_shape->get_memory_usage();
+}
+
+} // anonymous namespace
+
 Node_convex_hull_visualization::Node_convex_hull_visualization(
     Explorer_context&     explorer_context,
     Explorer_message_bus& explorer_message_bus,
@@ -48,6 +210,7 @@ Node_convex_hull_visualization::Node_convex_hull_visualization(
     explorer_rendering.add(this);
 
     explorer_message_bus.add_receiver(
+        Message_flag_bit::c_flag_bit_graph_loaded,
         [&](Explorer_message& message) {
             on_message(message);
         }
@@ -75,17 +238,31 @@ void Node_convex_hull_visualization::recreate_visualization_scene_graph()
     std::sort(
         ui_nodes.begin(),
         ui_nodes.end(),
-        [dfg](const Graph_node* lhs, const Graph_node* rhs)
+        [](const Graph_node* lhs, const Graph_node* rhs)
         {
-            const std::size_t lhs_node_id = lhs->get_payload();
-            const std::size_t rhs_node_id = rhs->get_payload();
-            const sw::dfa::DomainFlowNode& lhs_node = dfg->graph.node(lhs_node_id);
-            const sw::dfa::DomainFlowNode& rhs_node = dfg->graph.node(rhs_node_id);
-            return lhs_node.getDepth() < rhs_node.getDepth();
+            return lhs->get_depth() < rhs->get_depth();
         }
     );
 
+    clear();
+    for (Graph_node* ui_node : ui_nodes) {
+        const std::size_t node_id = ui_node->get_payload();
+        const sw::dfa::DomainFlowNode& node = dfg->graph.node(node_id);
+        glm::vec3 index_space_offset{0.0f, 0.0f, 0.0f};
+        std::shared_ptr<erhe::scene::Node> scene_graph_node = add_convex_hull(get_convex_hull_data(node), index_space_offset);
+        if (scene_graph_node) {
+            ui_node->set_convex_hull_visualization(scene_graph_node, index_space_offset);
+        }
+    }
+
+    frame_visualization();
+}
+
+void Node_convex_hull_visualization::clear()
+{
     m_last_scene_bbox = {};
+    m_shared_geometries.clear();
+    m_statistics = {};
 
     if (!m_root) {
         std::shared_ptr<Scene_root> scene_root = m_context.scene_builder->get_scene_root();
@@ -97,14 +274,12 @@ void Node_convex_hull_visualization::recreate_visualization_scene_graph()
     } else {
         m_root->remove_all_children_recursively();
     }
-    for (Graph_node* ui_node : ui_nodes) {
-        const std::size_t node_id = ui_node->get_payload();
-        const sw::dfa::DomainFlowNode& node = dfg->graph.node(node_id);
-        glm::vec3 index_space_offset{0.0f, 0.0f, 0.0f};
-        std::shared_ptr<erhe::scene::Node> scene_graph_node = add_node_convex_hull(node, index_space_offset);
-        if (scene_graph_node) {
-            ui_node->set_convex_hull_visualization(scene_graph_node, index_space_offset);
-        }
+}
+
+void Node_convex_hull_visualization::frame_visualization()
+{
+    if (!m_root) {
+        return;
     }
 
     update_bounding_box();
@@ -150,16 +325,18 @@ void Node_convex_hull_visualization::update_bounding_box()
     );
 }
 
-auto Node_convex_hull_visualization::add_node_convex_hull(
-    const sw::dfa::DomainFlowNode& node,
-    glm::vec3&                     index_space_offset
+auto Node_convex_hull_visualization::add_convex_hull(
+    const Convex_hull_data& convex_hull,
+    glm::vec3&              index_space_offset
 ) -> std::shared_ptr<erhe::scene::Node>
 {
+    if (!m_root) {
+        clear();
+    }
+
     std::shared_ptr<Scene_root> scene_root = m_context.scene_builder->get_scene_root();
     std::lock_guard<ERHE_PROFILE_LOCKABLE_BASE(std::mutex)> scene_lock{scene_root->item_host_mutex};
 
-    update_bounding_box();
-
     // Create material
     if (!m_material) {
         auto& material_library = scene_root->content_library()->materials;
@@ -169,87 +346,78 @@ auto Node_convex_hull_visualization::add_node_convex_hull(
         m_material->opacity = 0.25f;
     }
 
-    // Build convex hull mesh
-    std::shared_ptr<erhe::geometry::Geometry> geometry = std::make_shared<erhe::geometry::Geometry>("geometry_convex_hull");
-
-    GEO::Mesh& geo_mesh = geometry->get_mesh();
-
-    const sw::dfa::ConvexHull<int>          convex_hull  = node.getConvexHull();
-    const std::vector<sw::dfa::Point<int>>& vertices     = convex_hull.vertices();
-    const std::vector<sw::dfa::Face>&       faces        = convex_hull.faces();
-    const std::size_t                       vertex_count = vertices.size();
-    const std::size_t                       face_count   = faces.size();
+    const std::size_t vertex_count = convex_hull.vertices.size();
+    const std::size_t face_count   = convex_hull.face_corner_counts.size();
     if ((vertex_count < 3) || (face_count < 1)) {
         log_graph->warn("Not enough vertices / faces for node convex hull mesh");
         index_space_offset = glm::vec3{0.0f, 0.0f, 0.0f};
         return {};
     }
-    geo_mesh.vertices.set_double_precision();
-    geo_mesh.vertices.create_vertices(static_cast<GEO::index_t>(vertex_count));
+    if (!has_valid_faces(convex_hull)) {
+        log_graph->warn("Invalid face vertex indices for node convex hull mesh");
+        index_space_offset = glm::vec3{0.0f, 0.0f, 0.0f};
+        return {};
+    }
 
-    // First pass to comput aabb
+    // Translate vertices so that (0, 0, 0) is center
     erhe::math::Bounding_box input_aabb{};
-    for (std::size_t vertex_index = 0; vertex_index < vertex_count; ++vertex_index) {
-        const sw::dfa::Point<int>& p = vertices[vertex_index];
-        const int x = (p.dimension() >= 1) ? p.coords[0] : 0;
-        const int y = (p.dimension() >= 2) ? p.coords[1] : 0;
-        const int z = (p.dimension() >= 3) ? p.coords[2] : 0;
-        input_aabb.include(glm::vec3{x, y, z});
+    for (const glm::ivec3& p : convex_hull.vertices) {
+        input_aabb.include(glm::vec3{p});
     }
-
-    // Second pass - translate vertices so that (0, 0, 0) is center
-    erhe::math::Bounding_box aabb{};
     index_space_offset = - input_aabb.center();
-    for (std::size_t vertex_index = 0; vertex_index < vertex_count; ++vertex_index) {
-        const sw::dfa::Point<int>& p = vertices[vertex_index];
-        const double x = static_cast<double>((p.dimension() >= 1) ? p.coords[0] : 0) + index_space_offset.x;
-        const double y = static_cast<double>((p.dimension() >= 2) ? p.coords[1] : 0) + index_space_offset.y;
-        const double z = static_cast<double>((p.dimension() >= 3) ? p.coords[2] : 0) + index_space_offset.z;
-        geo_mesh.vertices.point(static_cast<GEO::index_t>(vertex_index)) = GEO::vec3{static_cast<double>(x), static_cast<double>(y), static_cast<double>(z)};
-        aabb.include(glm::vec3{x, y, z});
-    }
-    geo_mesh.vertices.set_single_precision();
-    for (std::size_t face_index = 0; face_index < face_count; ++face_index) {
-        const sw::dfa::Face& face = faces[face_index];
-        const std::size_t corner_count = face.num_vertices();
-        GEO::index_t facet = geo_mesh.facets.create_polygon(static_cast<GEO::index_t>(corner_count));
-        const std::vector<size_t>& corner_vertices = face.vertices();
-        for (std::size_t local_corner_index = 0; local_corner_index < corner_count; ++local_corner_index) {
-            const std::size_t vertex = corner_vertices[local_corner_index];
-            geo_mesh.facets.set_vertex(facet, static_cast<GEO::index_t>(local_corner_index), static_cast<GEO::index_t>(vertex));
-        }
-    }
+    erhe::math::Bounding_box aabb{};
+    aabb.include(input_aabb.min + index_space_offset);
+    aabb.include(input_aabb.max + index_space_offset);
+
+    // Reuse primitive of an earlier hull with the same shape
+    std::vector<int32_t> content;
+    get_hull_content(convex_hull, input_aabb, content);
+    std::vector<Shared_geometry>& bucket = m_shared_geometries[hash_hull_content(content)];
+    const auto shared_geometry = std::find_if(
+        bucket.begin(),
+        bucket.end(),
+        [&content](const Shared_geometry& entry) { return entry.content == content; }
+    );
 
-    const uint64_t geometry_process_flags =
-        erhe::geometry::Geometry::process_flag_connect |
-        erhe::geometry::Geometry::process_flag_build_edges |
-        erhe::geometry::Geometry::process_flag_compute_facet_centroids |
-        erhe::geometry::Geometry::process_flag_compute_smooth_vertex_normals |
-        erhe::geometry::Geometry::process_flag_generate_facet_texture_coordinates;
-
-    for (GEO::index_t facet : geo_mesh.facets) {
-        const GEO::vec3f facet_normal = GEO::normalize(mesh_facet_normalf(geo_mesh, facet));
-        const GEO::vec3f centroid = GEO::normalize(mesh_facet_centerf(geo_mesh, facet));
-        const float dot_product = GEO::dot(facet_normal, centroid);
-        if (dot_product < 0.0f) {
-            geo_mesh.facets.flip(facet);
+    erhe::primitive::Primitive primitive;
+    if (shared_geometry != bucket.end()) {
+        primitive = shared_geometry->primitive;
+        m_statistics.saved_byte_count += shared_geometry->byte_count;
+    } else {
+        std::shared_ptr<erhe::geometry::Geometry> geometry = std::make_shared<erhe::geometry::Geometry>("geometry_convex_hull");
+        erhe::primitive::Triangle_soup raytrace_triangles;
+        if (!build_convex_hull_mesh(convex_hull, index_space_offset, *geometry.get(), raytrace_triangles)) {
+            log_graph->warn("No valid faces for node convex hull mesh");
+            index_space_offset = glm::vec3{0.0f, 0.0f, 0.0f};
+            return {};
         }
+
+        // Build buffer mesh
+        Mesh_memory& mesh_memory = *m_context.mesh_memory;
+        const erhe::primitive::Build_info build_info{
+            .primitive_types = {
+                .fill_triangles  = true,
+                .edge_lines      = true,
+                .corner_points   = true,
+                .centroid_points = true
+            },
+            .buffer_info = mesh_memory.buffer_info
+        };
+        primitive = erhe::primitive::Primitive{geometry, m_material, build_info, erhe::primitive::Normal_style::polygon_normals};
+        ERHE_VERIFY(primitive.render_shape->make_raytrace(raytrace_triangles));
+
+        const std::size_t byte_count = get_primitive_byte_count(primitive);
+        bucket.push_back(
+            Shared_geometry{
+                .content    = std::move(content),
+                .primitive  = primitive,
+                .byte_count = byte_count
+            }
+        );
+        ++m_statistics.geometry_count;
+        m_statistics.byte_count += byte_count;
     }
-    GEO::mesh_reorient(geo_mesh, nullptr);
-    geometry->process(geometry_process_flags);
-
-    // Build buffer mesh
-    Mesh_memory& mesh_memory = *m_context.mesh_memory;
-    const erhe::primitive::Build_info build_info{
-        .primitive_types = {
-            .fill_triangles  = true,
-            .edge_lines      = true,
-            .corner_points   = true,
-            .centroid_points = true
-        },
-        .buffer_info = mesh_memory.buffer_info
-    };
-    erhe::primitive::Primitive primitive{geometry, m_material, build_info, erhe::primitive::Normal_style::polygon_normals};
+    ++m_statistics.hull_count;
 
     using namespace erhe;
     const uint64_t node_flags = Item_flags::visible | Item_flags::content | Item_flags::show_in_ui;
@@ -260,9 +428,8 @@ auto Node_convex_hull_visualization::add_node_convex_hull(
         ? m_last_scene_bbox.max.x + m_gap + half_size.x
         : -aabb.center().x;
 
-    ERHE_VERIFY(primitive.render_shape->make_raytrace(geo_mesh));
-    std::shared_ptr<erhe::scene::Node> scene_graph_node = std::make_shared<erhe::scene::Node>("node_convex_hull");
-    auto scene_mesh = std::make_shared<erhe::scene::Mesh>("", primitive);
+    std::shared_ptr<erhe::scene::Node> scene_graph_node = erhe::make_pooled_item<erhe::scene::Node>("node_convex_hull");
+    auto scene_mesh = erhe::make_pooled_item<erhe::scene::Mesh>("", primitive);
     scene_mesh->layer_id = scene_root->layers().content()->id;
     scene_mesh->enable_flag_bits(mesh_flags);
     scene_graph_node->attach              (scene_mesh);
@@ -270,7 +437,10 @@ auto Node_convex_hull_visualization::add_node_convex_hull(
     scene_graph_node->set_parent_from_node(erhe::math::create_translation<float>(x, 0.0f, 0.0f));
     scene_graph_node->enable_flag_bits    (node_flags);
 
-    update_bounding_box();
+    // Hulls are only appended between clear() and frame_visualization(), so
+    // the scene bounding box can be grown without visiting earlier hulls
+    const erhe::primitive::Buffer_mesh& buffer_mesh = primitive.render_shape->get_renderable_mesh();
+    m_last_scene_bbox.include(buffer_mesh.bounding_box.transformed_by(scene_graph_node->world_from_node()));
     return scene_graph_node;
 }
 
@@ -279,6 +449,11 @@ auto Node_convex_hull_visualization::get_material() -> erhe::primitive::Material
     return m_material.get();
 }
 
+auto Node_convex_hull_visualization::get_statistics() const -> const Statistics&
+{
+    return m_statistics;
+}
+
 void Node_convex_hull_visualization::render(const Render_context& context)
 {
     ERHE_PROFILE_FUNCTION();
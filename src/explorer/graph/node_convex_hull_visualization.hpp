@@ -4,7 +4,10 @@
 
 #include "erhe_imgui/imgui_window.hpp"
 #include "erhe_math/math_util.hpp"
+#include "erhe_primitive/primitive.hpp"
 
+#include <cstdint>
+#include <unordered_map>
 #include <vector>
 
 namespace sw::dfa { 
@@ -14,11 +17,11 @@ namespace sw::dfa {
 
 namespace erhe::geometry  { class Geometry; }
 namespace erhe::graph     { class Node; }
-namespace erhe::primitive { class Material; }
 namespace erhe::scene     { class Node; }
 
 namespace explorer {
 
+class Convex_hull_data;
 class Explorer_context;
 class Explorer_message;
 class Explorer_message_bus;
@@ -39,22 +42,50 @@ public:
 
     [[nodiscard]] auto get_material() -> erhe::primitive::Material*;
 
+    // Hulls are placed next to each other in the order they are added
+    void clear              ();
+    void frame_visualization();
+    [[nodiscard]] auto add_convex_hull(
+        const Convex_hull_data& convex_hull,
+        glm::vec3&              index_space_offset
+    ) -> std::shared_ptr<erhe::scene::Node>;
+
+    // Hulls with identical (centered) vertices and faces share one primitive,
+    // so they also share vertex and index buffers and raytrace data, and can
+    // be drawn with instanced draw commands.
+    class Statistics
+    {
+    public:
+        std::size_t hull_count      {0};
+        std::size_t geometry_count  {0}; // unique hull geometries
+        std::size_t byte_count      {0}; // estimated buffer and raytrace bytes of unique geometries
+        std::size_t saved_byte_count{0}; // estimated bytes not allocated thanks to sharing
+    };
+    [[nodiscard]] auto get_statistics() const -> const Statistics&;
+
 private:
+    class Shared_geometry
+    {
+    public:
+        std::vector<int32_t>       content;   // see get_hull_content()
+        erhe::primitive::Primitive primitive;
+        std::size_t                byte_count{0};
+    };
+
     void on_message                        (Explorer_message& message);
     void recreate_visualization_scene_graph();
     void update_bounding_box               ();
 
-    [[nodiscard]] auto add_node_convex_hull(
-        const sw::dfa::DomainFlowNode& node,
-        glm::vec3&                     index_space_offset
-    ) -> std::shared_ptr<erhe::scene::Node>;
-
     Explorer_context&                               m_context;
     std::vector<std::shared_ptr<erhe::graph::Node>> m_visualized_nodes;
     std::shared_ptr<erhe::primitive::Material>      m_material;
     std::shared_ptr<erhe::scene::Node>              m_root;
     float                                           m_gap{4.0f};
     erhe::math::Bounding_box                        m_last_scene_bbox{};
+
+    // Keyed by hash of content, collisions share the bucket vector
+    std::unordered_map<uint64_t, std::vector<Shared_geometry>> m_shared_geometries;
+    Statistics                                                 m_statistics;
 };
 
 } // namespace explorer
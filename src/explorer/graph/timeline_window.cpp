@@ -105,6 +105,11 @@ auto Timeline_window::get_play_speed() const -> float
     return m_play_speed;
 }
 
+auto Timeline_window::is_playing() const -> bool
+{
+    return m_playing;
+}
+
 void Timeline_window::imgui()
 {
     update();
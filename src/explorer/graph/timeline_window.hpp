@@ -31,6 +31,7 @@ public:
     [[nodiscard]] auto get_timeline_length() const -> float;
     [[nodiscard]] auto get_play_position  () const -> float;
     [[nodiscard]] auto get_play_speed     () const -> float;
+    [[nodiscard]] auto is_playing         () const -> bool;
 
 private:
     Explorer_context& m_context;
@@ -1,4 +1,5 @@
 #include "graph/wavefront_visualization.hpp"
+#include "graph/domain_flow_data.hpp"
 #include "graph/timeline_window.hpp"
 #include "graph/node_convex_hull_visualization.hpp"
 #include "explorer_log.hpp"
@@ -42,6 +43,7 @@ Wavefront_visualization::Wavefront_visualization(
 
 {
     explorer_message_bus.add_receiver(
+        Message_flag_bit::c_flag_bit_graph_loaded,
         [&](Explorer_message& message) {
             on_message(message);
         }
@@ -74,84 +76,33 @@ void Wavefront_visualization::fetch_wavefront(Graph_node& graph_ui_node)
         return;
     }
 
-    static const float size = 0.4f;
-    const sw::dfa::Schedule<sw::dfa::DomainFlowNode::ConstraintCoefficientType>& schedule = node.getSchedule();
+    const Schedule_data schedule_data = get_schedule_data(node);
 
     std::vector<Wavefront_frame>& frames = graph_ui_node.wavefront_frames();
     frames.clear();
-
-    erhe::math::Bounding_box aabb{};
-    int earliest_max_x_time = std::numeric_limits<int>::max();
-    int earliest_max_y_time = std::numeric_limits<int>::max();
-    int earliest_max_z_time = std::numeric_limits<int>::max();
-
-    int max_x = 0;
-    int max_y = 0;
-    int max_z = 0;
-    for (
-        std::map<std::size_t, sw::dfa::Wavefront>::const_iterator i = schedule.begin(), end = schedule.end();
-        i != end;
-        ++i
-    ) {
-        const sw::dfa::Wavefront& wavefront = i->second;
-        for (const sw::dfa::IndexPoint& index_point : wavefront) {
-            const std::vector<int>& p = index_point.coordinates;
-            const int x = (p.size() >= 1) ? p[0] : 0;
-            const int y = (p.size() >= 2) ? p[1] : 0;
-            const int z = (p.size() >= 3) ? p[2] : 0;
-            max_x = std::max(max_x, x);
-            max_y = std::max(max_y, y);
-            max_z = std::max(max_z, z);
-        }
-    }
-
-    for (
-        std::map<std::size_t, sw::dfa::Wavefront>::const_iterator i = schedule.begin(), end = schedule.end();
-        i != end;
-        ++i
-    ) {
-        const int time = static_cast<int>(i->first);
-        const sw::dfa::Wavefront& wavefront = i->second;
-
-        std::vector<uint32_t> cubes(wavefront.size());
-        std::size_t cube_index = 0;
-
-        for (const sw::dfa::IndexPoint& index_point : wavefront) {
-            const std::vector<int>& p = index_point.coordinates;
-            const int x = (p.size() >= 1) ? p[0] : 0;
-            const int y = (p.size() >= 2) ? p[1] : 0;
-            const int z = (p.size() >= 3) ? p[2] : 0;
-            if (x == max_x) {
-                earliest_max_x_time = std::min(earliest_max_x_time, time);
-            }
-            if (y == max_y) {
-                earliest_max_y_time = std::min(earliest_max_y_time, time);
-            }
-            if (z == max_z) {
-                earliest_max_z_time = std::min(earliest_max_z_time, time);
-            }
-            aabb.include(glm::vec3{x, y, z});
-            cubes[cube_index++] = erhe::scene_renderer::pack_x11y11z10(x, y, z);
-        }
+    frames.reserve(schedule_data.wavefronts.size());
+    for (const Wavefront_data& wavefront : schedule_data.wavefronts) {
         frames.push_back(
-            Wavefront_frame{{}, {}, m_cube_renderer.make_buffer(cubes), time}
+            Wavefront_frame{{}, {}, make_cube_instance_buffer(wavefront.packed_cubes), wavefront.time}
         );
     }
-    glm::vec3 color_bias = -aabb.min;
-    glm::vec3 color_scale = glm::vec3{1.0f} / aabb.diagonal();
+    set_color_range(frames, schedule_data.min, schedule_data.max);
+    graph_ui_node.set_earliest_max_times(schedule_data.earliest_max_times);
+}
+
+auto Wavefront_visualization::make_cube_instance_buffer(const std::vector<uint32_t>& cubes) -> std::shared_ptr<erhe::scene_renderer::Cube_instance_buffer>
+{
+    return m_cube_renderer.make_buffer(cubes);
+}
+
+void Wavefront_visualization::set_color_range(std::vector<Wavefront_frame>& frames, const glm::ivec3 min, const glm::ivec3 max)
+{
+    const glm::vec3 color_bias  = -glm::vec3{min};
+    const glm::vec3 color_scale = glm::vec3{1.0f} / glm::vec3{max - min};
     for (Wavefront_frame& frame : frames) {
         frame.color_bias  = glm::vec4{color_bias, 0.0f};
         frame.color_scale = glm::vec4{color_scale, 1.0f};
     }
-    std::sort(
-        frames.begin(),
-        frames.end(),
-        [](const Wavefront_frame& lhs, const Wavefront_frame& rhs)
-        {
-            return lhs.time < rhs.time;
-        }
-    );
-    graph_ui_node.set_earliest_max_times(glm::ivec3{earliest_max_x_time, earliest_max_y_time, earliest_max_z_time});
 }
 
 void Wavefront_visualization::update_wavefront_visualization()
@@ -186,11 +137,6 @@ void Wavefront_visualization::on_message(Explorer_message& message)
 
 void Wavefront_visualization::apply_baseline()
 {
-    sw::dfa::DomainFlowGraph* dfg = m_context.graph_window->get_domain_flow_graph();
-    if (dfg == nullptr) {
-        return;
-    }
-
     std::vector<Graph_node*> ui_nodes;
     Graph& ui_graph = m_context.graph_window->get_ui_graph();
     const std::vector<erhe::graph::Node*>& nodes = ui_graph.get_nodes();
@@ -205,13 +151,9 @@ void Wavefront_visualization::apply_baseline()
     std::sort(
         ui_nodes.begin(),
         ui_nodes.end(),
-        [dfg](const Graph_node* lhs, const Graph_node* rhs)
+        [](const Graph_node* lhs, const Graph_node* rhs)
         {
-            const std::size_t lhs_node_id = lhs->get_payload();
-            const std::size_t rhs_node_id = rhs->get_payload();
-            const sw::dfa::DomainFlowNode& lhs_node = dfg->graph.node(lhs_node_id);
-            const sw::dfa::DomainFlowNode& rhs_node = dfg->graph.node(rhs_node_id);
-            return lhs_node.getDepth() < rhs_node.getDepth();
+            return lhs->get_depth() < rhs->get_depth();
         }
     );
 
@@ -231,11 +173,6 @@ void Wavefront_visualization::apply_baseline()
 
 void Wavefront_visualization::apply_optimized()
 {
-    sw::dfa::DomainFlowGraph* dfg = m_context.graph_window->get_domain_flow_graph();
-    if (dfg == nullptr) {
-        return;
-    }
-
     std::vector<Graph_node*> ui_nodes;
     Graph& ui_graph = m_context.graph_window->get_ui_graph();
     const std::vector<erhe::graph::Node*>& nodes = ui_graph.get_nodes();
@@ -250,13 +187,9 @@ void Wavefront_visualization::apply_optimized()
     std::sort(
         ui_nodes.begin(),
         ui_nodes.end(),
-        [dfg](const Graph_node* lhs, const Graph_node* rhs)
+        [](const Graph_node* lhs, const Graph_node* rhs)
         {
-            const std::size_t lhs_node_id = lhs->get_payload();
-            const std::size_t rhs_node_id = rhs->get_payload();
-            const sw::dfa::DomainFlowNode& lhs_node = dfg->graph.node(lhs_node_id);
-            const sw::dfa::DomainFlowNode& rhs_node = dfg->graph.node(rhs_node_id);
-            return lhs_node.getDepth() < rhs_node.getDepth();
+            return lhs->get_depth() < rhs->get_depth();
         }
     );
 
@@ -19,6 +19,7 @@ class Explorer_message_bus;
 class Explorer_rendering;
 class Graph_node;
 class Programs;
+class Wavefront_frame;
 
 class Wavefront_visualization
     : public erhe::imgui::Imgui_window
@@ -42,15 +43,19 @@ public:
     // Implements Imgui_window
     void imgui() override;
 
+    // Used when wavefronts are received incrementally from network
+    [[nodiscard]] auto make_cube_instance_buffer(const std::vector<uint32_t>& cubes) -> std::shared_ptr<erhe::scene_renderer::Cube_instance_buffer>;
+    static void set_color_range(std::vector<Wavefront_frame>& frames, glm::ivec3 min, glm::ivec3 max);
+
+    void apply_baseline ();
+    void apply_optimized();
+
 private:
     void on_message(Explorer_message& message);
 
     void update_wavefront_visualization();
     void fetch_wavefront               (Graph_node& graph_ui_node);
 
-    void apply_baseline ();
-    void apply_optimized();
-
     Explorer_context&                         m_context;
     erhe::scene_renderer::Cube_renderer       m_cube_renderer;
     erhe::graphics::Vertex_input_state        m_empty_vertex_input;
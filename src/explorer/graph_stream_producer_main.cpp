@@ -0,0 +1,108 @@
+// Headless graph stream producer. Loads a domain flow graph, computes its
+// schedule and streams it to explorer instances connecting to it
+// (Network window, Graph Stream section).
+//
+//   graph-stream-producer --dfg ../../data/workloads/nla/matmul_32x32_chained.dfg
+
+#include "explorer_log.hpp"
+#include "net/graph_stream_producer.hpp"
+
+#include "erhe_log/log.hpp"
+#include "erhe_net/net_log.hpp"
+#include "erhe_net/net_os.hpp"
+#include "erhe_net/server.hpp"
+
+#include <dfa/dfa.hpp>
+
+#include <cxxopts.hpp>
+#include <fmt/format.h>
+
+#include <filesystem>
+#include <memory>
+
+class Options
+{
+public:
+    Options(int argc, char** argv)
+    {
+        cxxopts::Options options{"graph-stream-producer", "Streams domain flow graph schedules to graph explorer viewers"};
+
+        options.add_options()
+            ("dfg",            "Domain flow graph file to stream", cxxopts::value<std::string>(), "<path>")
+            ("listen-address", "Address where producer listens for viewer connections", cxxopts::value<std::string>()->default_value("127.0.0.1"), "<address>")
+            ("listen-port",    "Port where producer listens for viewer connections", cxxopts::value<int>()->default_value("34568"), "<port>")
+            ("chunk-cubes",    "Maximum number of index points per wavefront chunk", cxxopts::value<int>()->default_value("16384"), "<count>")
+            ("exit-when-done", "Exit after the first viewer has applied the complete stream", cxxopts::value<bool>()->default_value("false"))
+            ("help",           "Print help");
+
+        try {
+            auto arguments = options.parse(argc, argv);
+            if (arguments.count("help") || !arguments.count("dfg")) {
+                fmt::print("{}\n", options.help());
+                return;
+            }
+            dfg_path       = arguments["dfg"           ].as<std::string>();
+            listen_address = arguments["listen-address"].as<std::string>();
+            listen_port    = arguments["listen-port"   ].as<int>();
+            chunk_cubes    = arguments["chunk-cubes"   ].as<int>();
+            exit_when_done = arguments["exit-when-done"].as<bool>();
+            valid          = true;
+        } catch (const std::exception& e) {
+            fmt::print("Error parsing command line arguments: {}\n", e.what());
+        }
+    }
+
+    bool        valid         {false};
+    std::string dfg_path;
+    std::string listen_address;
+    int         listen_port   {0};
+    int         chunk_cubes   {0};
+    bool        exit_when_done{false};
+};
+
+auto main(int argc, char** argv) -> int
+{
+    Options options{argc, argv};
+    if (!options.valid) {
+        return 1;
+    }
+
+    erhe::log::console_init();
+    erhe::log::log_to_console();
+    erhe::log::initialize_log_sinks();
+    erhe::net::initialize_logging();
+    explorer::initialize_logging();
+    erhe::net::initialize_net();
+
+    // Same processing as Domain_flow_graph_file::load()
+    auto dfg = std::make_shared<sw::dfa::DomainFlowGraph>(options.dfg_path);
+    try {
+        dfg->load(options.dfg_path);
+        dfg->graph.distributeConstants();
+        dfg->instantiateDomains();
+        dfg->instantiateIndexSpaces();
+        dfg->applyLinearSchedule({ 1, 1, 1 });
+    } catch (...) {
+        explorer::log_net->error("Loading '{}' failed", options.dfg_path);
+        return 1;
+    }
+
+    erhe::net::Server server;
+    if (!server.listen(options.listen_address.c_str(), options.listen_port)) {
+        explorer::log_net->error("Listen on {}:{} failed", options.listen_address, options.listen_port);
+        return 1;
+    }
+
+    explorer::Graph_stream_producer producer{server, static_cast<std::size_t>(options.chunk_cubes)};
+    producer.set_graph(*dfg.get(), std::filesystem::path{options.dfg_path}.filename().string());
+    explorer::log_net->info("Streaming on {}:{}", options.listen_address, options.listen_port);
+
+    for (;;) {
+        server.poll(10);
+        producer.update();
+        if (options.exit_when_done && (producer.get_complete_count() > 0)) {
+            break;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,361 @@
+#include "net/graph_stream.hpp"
+
+#include <bit>
+#include <cstring>
+
+namespace explorer {
+
+auto c_str(const Graph_stream_message_type type) -> const char*
+{
+    switch (type) {
+        case Graph_stream_message_type::stream_begin:    return "stream_begin";
+        case Graph_stream_message_type::node:            return "node";
+        case Graph_stream_message_type::edge:            return "edge";
+        case Graph_stream_message_type::graph_end:       return "graph_end";
+        case Graph_stream_message_type::hull:            return "hull";
+        case Graph_stream_message_type::wavefront_begin: return "wavefront_begin";
+        case Graph_stream_message_type::wavefront_chunk: return "wavefront_chunk";
+        case Graph_stream_message_type::stream_end:      return "stream_end";
+        case Graph_stream_message_type::hello:           return "hello";
+        case Graph_stream_message_type::credit:          return "credit";
+        default:                                         return "?";
+    }
+}
+
+Graph_stream_writer::Graph_stream_writer(const Graph_stream_message_type type)
+{
+    m_data.push_back(static_cast<uint8_t>(type));
+}
+
+void Graph_stream_writer::write_u8(const uint8_t value)
+{
+    m_data.push_back(value);
+}
+
+void Graph_stream_writer::write_u32(const uint32_t value)
+{
+    m_data.push_back(static_cast<uint8_t>( value        & 0xffu));
+    m_data.push_back(static_cast<uint8_t>((value >>  8) & 0xffu));
+    m_data.push_back(static_cast<uint8_t>((value >> 16) & 0xffu));
+    m_data.push_back(static_cast<uint8_t>((value >> 24) & 0xffu));
+}
+
+void Graph_stream_writer::write_u64(const uint64_t value)
+{
+    write_u32(static_cast<uint32_t>(value & 0xffffffffu));
+    write_u32(static_cast<uint32_t>(value >> 32));
+}
+
+void Graph_stream_writer::write_i32(const int32_t value)
+{
+    write_u32(static_cast<uint32_t>(value));
+}
+
+void Graph_stream_writer::write_ivec3(const glm::ivec3 value)
+{
+    write_i32(value.x);
+    write_i32(value.y);
+    write_i32(value.z);
+}
+
+void Graph_stream_writer::write_string(const std::string_view value)
+{
+    write_u32(static_cast<uint32_t>(value.size()));
+    m_data.insert(m_data.end(), value.begin(), value.end());
+}
+
+void Graph_stream_writer::write_u32s(const uint32_t* const values, const std::size_t count)
+{
+    write_u32(static_cast<uint32_t>(count));
+    if constexpr (std::endian::native == std::endian::little) {
+        const std::size_t offset = m_data.size();
+        m_data.resize(offset + count * sizeof(uint32_t));
+        if (count > 0) {
+            std::memcpy(m_data.data() + offset, values, count * sizeof(uint32_t));
+        }
+    } else {
+        for (std::size_t i = 0; i < count; ++i) {
+            write_u32(values[i]);
+        }
+    }
+}
+
+auto Graph_stream_writer::make_packet() const -> erhe::net::Shared_packet
+{
+    return erhe::net::Socket::make_packet(reinterpret_cast<const char*>(m_data.data()), m_data.size());
+}
+
+Graph_stream_reader::Graph_stream_reader(const uint8_t* const data, const std::size_t length)
+    : m_data  {data}
+    , m_length{length}
+{
+    m_type = static_cast<Graph_stream_message_type>(read_u8());
+}
+
+auto Graph_stream_reader::get_type() const -> Graph_stream_message_type
+{
+    return m_type;
+}
+
+auto Graph_stream_reader::is_valid() const -> bool
+{
+    return m_valid;
+}
+
+auto Graph_stream_reader::is_complete() const -> bool
+{
+    return m_valid && (m_offset == m_length);
+}
+
+auto Graph_stream_reader::take(const std::size_t byte_count) -> const uint8_t*
+{
+    if (!m_valid || (byte_count > m_length - m_offset)) {
+        m_valid = false;
+        return nullptr;
+    }
+    const uint8_t* result = m_data + m_offset;
+    m_offset += byte_count;
+    return result;
+}
+
+auto Graph_stream_reader::read_u8() -> uint8_t
+{
+    const uint8_t* p = take(1);
+    return (p != nullptr) ? p[0] : 0;
+}
+
+auto Graph_stream_reader::read_u32() -> uint32_t
+{
+    const uint8_t* p = take(4);
+    if (p == nullptr) {
+        return 0;
+    }
+    return
+        (static_cast<uint32_t>(p[0])      ) |
+        (static_cast<uint32_t>(p[1]) <<  8) |
+        (static_cast<uint32_t>(p[2]) << 16) |
+        (static_cast<uint32_t>(p[3]) << 24);
+}
+
+auto Graph_stream_reader::read_u64() -> uint64_t
+{
+    const uint64_t low  = read_u32();
+    const uint64_t high = read_u32();
+    return low | (high << 32);
+}
+
+auto Graph_stream_reader::read_i32() -> int32_t
+{
+    return static_cast<int32_t>(read_u32());
+}
+
+auto Graph_stream_reader::read_ivec3() -> glm::ivec3
+{
+    const int32_t x = read_i32();
+    const int32_t y = read_i32();
+    const int32_t z = read_i32();
+    return glm::ivec3{x, y, z};
+}
+
+auto Graph_stream_reader::read_string() -> std::string
+{
+    const uint32_t length = read_u32();
+    const uint8_t* p      = take(length);
+    if (p == nullptr) {
+        return {};
+    }
+    return std::string{reinterpret_cast<const char*>(p), length};
+}
+
+void Graph_stream_reader::read_u32s(std::vector<uint32_t>& values)
+{
+    values.clear();
+    const uint32_t count = read_u32();
+    if (!m_valid || (count > (m_length - m_offset) / sizeof(uint32_t))) {
+        m_valid = false;
+        return;
+    }
+    const uint8_t* p = take(count * sizeof(uint32_t));
+    values.resize(count);
+    if constexpr (std::endian::native == std::endian::little) {
+        if (count > 0) {
+            std::memcpy(values.data(), p, count * sizeof(uint32_t));
+        }
+    } else {
+        for (uint32_t i = 0; i < count; ++i, p += 4) {
+            values[i] =
+                (static_cast<uint32_t>(p[0])      ) |
+                (static_cast<uint32_t>(p[1]) <<  8) |
+                (static_cast<uint32_t>(p[2]) << 16) |
+                (static_cast<uint32_t>(p[3]) << 24);
+        }
+    }
+}
+
+auto encode_stream_begin(const std::string_view name, const uint32_t node_count, const uint32_t edge_count) -> erhe::net::Shared_packet
+{
+    Graph_stream_writer writer{Graph_stream_message_type::stream_begin};
+    writer.write_u32   (graph_stream_protocol_version);
+    writer.write_string(name);
+    writer.write_u32   (node_count);
+    writer.write_u32   (edge_count);
+    return writer.make_packet();
+}
+
+auto encode_node(const Graph_stream_node& node) -> erhe::net::Shared_packet
+{
+    Graph_stream_writer writer{Graph_stream_message_type::node};
+    writer.write_u64   (node.id);
+    writer.write_i32   (node.depth);
+    writer.write_u8    (node.is_operator ? 1 : 0);
+    writer.write_string(node.name);
+    writer.write_u32   (static_cast<uint32_t>(node.input_names.size()));
+    for (const std::string& name : node.input_names) {
+        writer.write_string(name);
+    }
+    writer.write_u32   (static_cast<uint32_t>(node.output_names.size()));
+    for (const std::string& name : node.output_names) {
+        writer.write_string(name);
+    }
+    return writer.make_packet();
+}
+
+auto encode_edge(const Graph_stream_edge& edge) -> erhe::net::Shared_packet
+{
+    Graph_stream_writer writer{Graph_stream_message_type::edge};
+    writer.write_u64(edge.source_id);
+    writer.write_u32(edge.source_slot);
+    writer.write_u64(edge.destination_id);
+    writer.write_u32(edge.destination_slot);
+    return writer.make_packet();
+}
+
+auto encode_hull(const uint64_t node_id, const Convex_hull_data& convex_hull) -> erhe::net::Shared_packet
+{
+    Graph_stream_writer writer{Graph_stream_message_type::hull};
+    writer.write_u64(node_id);
+    writer.write_u32(static_cast<uint32_t>(convex_hull.vertices.size()));
+    for (const glm::ivec3& vertex : convex_hull.vertices) {
+        writer.write_ivec3(vertex);
+    }
+    writer.write_u32s(convex_hull.face_corner_counts.data(), convex_hull.face_corner_counts.size());
+    writer.write_u32s(convex_hull.face_vertices.data(),      convex_hull.face_vertices.size());
+    return writer.make_packet();
+}
+
+auto encode_wavefront_begin(const Graph_stream_wavefront_begin& wavefront_begin) -> erhe::net::Shared_packet
+{
+    Graph_stream_writer writer{Graph_stream_message_type::wavefront_begin};
+    writer.write_u64  (wavefront_begin.node_id);
+    writer.write_u32  (wavefront_begin.frame_count);
+    writer.write_ivec3(wavefront_begin.min);
+    writer.write_ivec3(wavefront_begin.max);
+    writer.write_ivec3(wavefront_begin.earliest_max_times);
+    return writer.make_packet();
+}
+
+auto encode_wavefront_chunk(
+    const uint64_t        node_id,
+    const int32_t         time,
+    const uint32_t        first_cube,
+    const uint32_t        total_cube_count,
+    const uint32_t* const packed_cubes,
+    const std::size_t     count
+) -> erhe::net::Shared_packet
+{
+    Graph_stream_writer writer{Graph_stream_message_type::wavefront_chunk};
+    writer.write_u64 (node_id);
+    writer.write_i32 (time);
+    writer.write_u32 (first_cube);
+    writer.write_u32 (total_cube_count);
+    writer.write_u32s(packed_cubes, count);
+    return writer.make_packet();
+}
+
+auto encode_hello(const uint32_t window_byte_count) -> erhe::net::Shared_packet
+{
+    Graph_stream_writer writer{Graph_stream_message_type::hello};
+    writer.write_u32(graph_stream_protocol_version);
+    writer.write_u32(window_byte_count);
+    return writer.make_packet();
+}
+
+auto encode_credit(const uint32_t byte_count) -> erhe::net::Shared_packet
+{
+    Graph_stream_writer writer{Graph_stream_message_type::credit};
+    writer.write_u32(byte_count);
+    return writer.make_packet();
+}
+
+auto encode_empty(const Graph_stream_message_type type) -> erhe::net::Shared_packet
+{
+    Graph_stream_writer writer{type};
+    return writer.make_packet();
+}
+
+auto decode(Graph_stream_reader& reader, Graph_stream_node& node) -> bool
+{
+    node.id          = reader.read_u64();
+    node.depth       = reader.read_i32();
+    node.is_operator = reader.read_u8() != 0;
+    node.name        = reader.read_string();
+    const uint32_t input_count = reader.read_u32();
+    node.input_names.clear();
+    for (uint32_t i = 0; (i < input_count) && reader.is_valid(); ++i) {
+        node.input_names.push_back(reader.read_string());
+    }
+    const uint32_t output_count = reader.read_u32();
+    node.output_names.clear();
+    for (uint32_t i = 0; (i < output_count) && reader.is_valid(); ++i) {
+        node.output_names.push_back(reader.read_string());
+    }
+    return reader.is_complete();
+}
+
+auto decode(Graph_stream_reader& reader, Graph_stream_edge& edge) -> bool
+{
+    edge.source_id        = reader.read_u64();
+    edge.source_slot      = reader.read_u32();
+    edge.destination_id   = reader.read_u64();
+    edge.destination_slot = reader.read_u32();
+    return reader.is_complete();
+}
+
+auto decode(Graph_stream_reader& reader, Graph_stream_hull& hull) -> bool
+{
+    hull.node_id = reader.read_u64();
+    const uint32_t vertex_count = reader.read_u32();
+    hull.convex_hull.vertices.clear();
+    for (uint32_t i = 0; (i < vertex_count) && reader.is_valid(); ++i) {
+        hull.convex_hull.vertices.push_back(reader.read_ivec3());
+    }
+    reader.read_u32s(hull.convex_hull.face_corner_counts);
+    reader.read_u32s(hull.convex_hull.face_vertices);
+    return reader.is_complete() && has_valid_faces(hull.convex_hull);
+}
+
+auto decode(Graph_stream_reader& reader, Graph_stream_wavefront_begin& wavefront_begin) -> bool
+{
+    wavefront_begin.node_id            = reader.read_u64();
+    wavefront_begin.frame_count        = reader.read_u32();
+    wavefront_begin.min                = reader.read_ivec3();
+    wavefront_begin.max                = reader.read_ivec3();
+    wavefront_begin.earliest_max_times = reader.read_ivec3();
+    return reader.is_complete() && (wavefront_begin.frame_count <= graph_stream_max_wavefront_frame_count);
+}
+
+auto decode(Graph_stream_reader& reader, Graph_stream_wavefront_chunk& wavefront_chunk) -> bool
+{
+    wavefront_chunk.node_id          = reader.read_u64();
+    wavefront_chunk.time             = reader.read_i32();
+    wavefront_chunk.first_cube       = reader.read_u32();
+    wavefront_chunk.total_cube_count = reader.read_u32();
+    reader.read_u32s(wavefront_chunk.packed_cubes);
+    return
+        reader.is_complete() &&
+        (wavefront_chunk.total_cube_count <= graph_stream_max_wavefront_cube_count) &&
+        (wavefront_chunk.first_cube <= wavefront_chunk.total_cube_count) &&
+        (wavefront_chunk.packed_cubes.size() <= wavefront_chunk.total_cube_count - wavefront_chunk.first_cube);
+}
+
+} // namespace explorer
@@ -0,0 +1,167 @@
+#pragma once
+
+#include "graph/domain_flow_data.hpp"
+
+#include "erhe_net/socket.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace explorer {
+
+// Binary protocol for streaming domain flow graphs and their schedules from
+// a producer (analysis server) to viewers. Each message is one erhe::net
+// packet: one Graph_stream_message_type byte followed by little endian payload.
+//
+// Producer sends stream_begin, node and edge messages, graph_end, and then
+// per node (in depth order) hull, wavefront_begin and wavefront_chunk messages,
+// and finally stream_end. Large wavefronts are split to several chunks.
+//
+// Flow control is credit based: viewer sends hello with the number of bytes
+// it allows to be in flight, and returns credit for bytes it has applied.
+// Byte counts include the erhe::net header of each packet.
+static constexpr uint32_t    graph_stream_protocol_version = 1;
+static constexpr std::size_t graph_stream_packet_overhead  = erhe::net::Socket::packet_header_byte_count;
+
+// Limits for sizes which receivers allocate for before the data arrives
+static constexpr uint32_t    graph_stream_max_wavefront_frame_count = 1u << 16;
+static constexpr uint32_t    graph_stream_max_wavefront_cube_count  = 1u << 24; // 64 MiB of packed cubes
+
+enum class Graph_stream_message_type : uint8_t
+{
+    // producer -> viewer
+    stream_begin    =  1, // u32 version, string name, u32 node count, u32 edge count
+    node            =  2, // u64 id, i32 depth, u8 is operator, string name, u32 count + input strings, u32 count + output strings
+    edge            =  3, // u64 source id, u32 source slot, u64 destination id, u32 destination slot
+    graph_end       =  4, //
+    hull            =  5, // u64 node id, u32 count + ivec3 vertices, u32 count + face corner counts, u32 count + face vertices
+    wavefront_begin =  6, // u64 node id, u32 frame count, ivec3 min, ivec3 max, ivec3 earliest max times
+    wavefront_chunk =  7, // u64 node id, i32 time, u32 first cube, u32 total cube count, u32 count + packed cubes
+    stream_end      =  8, //
+
+    // viewer -> producer
+    hello           = 64, // u32 version, u32 window byte count
+    credit          = 65  // u32 byte count
+};
+
+[[nodiscard]] auto c_str(Graph_stream_message_type type) -> const char*;
+
+class Graph_stream_node
+{
+public:
+    uint64_t                 id         {0};
+    int32_t                  depth      {0};
+    bool                     is_operator{false};
+    std::string              name;
+    std::vector<std::string> input_names;
+    std::vector<std::string> output_names;
+};
+
+class Graph_stream_edge
+{
+public:
+    uint64_t source_id       {0};
+    uint32_t source_slot     {0};
+    uint64_t destination_id  {0};
+    uint32_t destination_slot{0};
+};
+
+class Graph_stream_hull
+{
+public:
+    uint64_t         node_id{0};
+    Convex_hull_data convex_hull;
+};
+
+class Graph_stream_wavefront_begin
+{
+public:
+    uint64_t   node_id           {0};
+    uint32_t   frame_count       {0};
+    glm::ivec3 min               {0, 0, 0};
+    glm::ivec3 max               {0, 0, 0};
+    glm::ivec3 earliest_max_times{0, 0, 0};
+};
+
+class Graph_stream_wavefront_chunk
+{
+public:
+    uint64_t              node_id         {0};
+    int32_t               time            {0};
+    uint32_t              first_cube      {0};
+    uint32_t              total_cube_count{0};
+    std::vector<uint32_t> packed_cubes;
+};
+
+class Graph_stream_writer
+{
+public:
+    explicit Graph_stream_writer(Graph_stream_message_type type);
+
+    void write_u8    (uint8_t value);
+    void write_u32   (uint32_t value);
+    void write_u64   (uint64_t value);
+    void write_i32   (int32_t value);
+    void write_ivec3 (glm::ivec3 value);
+    void write_string(std::string_view value);
+    void write_u32s  (const uint32_t* values, std::size_t count);
+
+    [[nodiscard]] auto make_packet() const -> erhe::net::Shared_packet;
+
+private:
+    std::vector<uint8_t> m_data;
+};
+
+// Reads are bounds checked; once a read fails, all further reads
+// return zero / empty and is_valid() returns false.
+class Graph_stream_reader
+{
+public:
+    Graph_stream_reader(const uint8_t* data, std::size_t length);
+
+    [[nodiscard]] auto get_type   () const -> Graph_stream_message_type;
+    [[nodiscard]] auto is_valid   () const -> bool;
+    [[nodiscard]] auto is_complete() const -> bool; // valid and all bytes consumed
+
+    [[nodiscard]] auto read_u8    () -> uint8_t;
+    [[nodiscard]] auto read_u32   () -> uint32_t;
+    [[nodiscard]] auto read_u64   () -> uint64_t;
+    [[nodiscard]] auto read_i32   () -> int32_t;
+    [[nodiscard]] auto read_ivec3 () -> glm::ivec3;
+    [[nodiscard]] auto read_string() -> std::string;
+    void read_u32s(std::vector<uint32_t>& values);
+
+private:
+    [[nodiscard]] auto take(std::size_t byte_count) -> const uint8_t*;
+
+    const uint8_t*            m_data  {nullptr};
+    std::size_t               m_length{0};
+    std::size_t               m_offset{0};
+    bool                      m_valid {true};
+    Graph_stream_message_type m_type  {0};
+};
+
+[[nodiscard]] auto encode_stream_begin   (std::string_view name, uint32_t node_count, uint32_t edge_count) -> erhe::net::Shared_packet;
+[[nodiscard]] auto encode_node           (const Graph_stream_node& node) -> erhe::net::Shared_packet;
+[[nodiscard]] auto encode_edge           (const Graph_stream_edge& edge) -> erhe::net::Shared_packet;
+[[nodiscard]] auto encode_hull           (uint64_t node_id, const Convex_hull_data& convex_hull) -> erhe::net::Shared_packet;
+[[nodiscard]] auto encode_wavefront_begin(const Graph_stream_wavefront_begin& wavefront_begin) -> erhe::net::Shared_packet;
+[[nodiscard]] auto encode_wavefront_chunk(uint64_t node_id, int32_t time, uint32_t first_cube, uint32_t total_cube_count, const uint32_t* packed_cubes, std::size_t count) -> erhe::net::Shared_packet;
+[[nodiscard]] auto encode_hello          (uint32_t window_byte_count) -> erhe::net::Shared_packet;
+[[nodiscard]] auto encode_credit         (uint32_t byte_count) -> erhe::net::Shared_packet;
+[[nodiscard]] auto encode_empty          (Graph_stream_message_type type) -> erhe::net::Shared_packet;
+
+// Payload decoders, called after reader type has been checked.
+// Return false if message is truncated, has trailing bytes, or has
+// inconsistent contents (invalid hull faces, sizes over the limits above).
+[[nodiscard]] auto decode(Graph_stream_reader& reader, Graph_stream_node&            node           ) -> bool;
+[[nodiscard]] auto decode(Graph_stream_reader& reader, Graph_stream_edge&            edge           ) -> bool;
+[[nodiscard]] auto decode(Graph_stream_reader& reader, Graph_stream_hull&            hull           ) -> bool;
+[[nodiscard]] auto decode(Graph_stream_reader& reader, Graph_stream_wavefront_begin& wavefront_begin) -> bool;
+[[nodiscard]] auto decode(Graph_stream_reader& reader, Graph_stream_wavefront_chunk& wavefront_chunk) -> bool;
+
+} // namespace explorer
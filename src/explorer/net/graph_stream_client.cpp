@@ -0,0 +1,399 @@
+#include "net/graph_stream_client.hpp"
+#include "net/graph_stream.hpp"
+
+#include "explorer_context.hpp"
+#include "explorer_log.hpp"
+#include "graph/graph_node.hpp"
+#include "graph/graph_window.hpp"
+#include "graph/node_convex_hull_visualization.hpp"
+#include "graph/wavefront_visualization.hpp"
+
+#include "erhe_configuration/configuration.hpp"
+#include "erhe_graph/pin.hpp"
+#include "erhe_imgui/imgui_node_editor.h"
+#include "erhe_item/item_pool.hpp"
+#include "erhe_profile/profile.hpp"
+
+#include <imgui/imgui.h>
+
+#include <algorithm>
+#include <chrono>
+
+namespace explorer {
+
+Graph_stream_client::Graph_stream_client(Explorer_context& explorer_context)
+    : m_context{explorer_context}
+{
+    int window_kb = static_cast<int>(m_window_byte_count / 1024);
+    const auto& ini = erhe::configuration::get_ini_file_section("erhe.ini", "network");
+    ini.get("graph_stream_window_kb",       window_kb);
+    ini.get("graph_stream_apply_budget_ms", m_apply_budget_ms);
+    m_window_byte_count = static_cast<std::size_t>(std::max(window_kb, 64)) * 1024;
+
+    m_client.set_receive_handler(
+        [this](const uint8_t* data, const std::size_t length) {
+            on_receive(data, length);
+        }
+    );
+}
+
+void Graph_stream_client::connect(const char* address, const int port)
+{
+    m_hello_sent = false;
+    m_pending_messages.clear();
+    m_pending_byte_count = 0;
+    m_credit_byte_count  = 0;
+    m_client.connect(address, port);
+}
+
+void Graph_stream_client::disconnect()
+{
+    m_client.disconnect();
+    m_hello_sent = false;
+    m_pending_messages.clear();
+    m_pending_byte_count = 0;
+    m_credit_byte_count  = 0;
+}
+
+auto Graph_stream_client::get_state() -> erhe::net::Socket::State
+{
+    return m_client.get_state();
+}
+
+void Graph_stream_client::on_receive(const uint8_t* const data, const std::size_t length)
+{
+    // Applied later from update(), within frame time budget
+    m_pending_messages.emplace_back(data, data + length);
+    m_pending_byte_count  += length + graph_stream_packet_overhead;
+    m_received_byte_count += length + graph_stream_packet_overhead;
+}
+
+auto Graph_stream_client::update() -> bool
+{
+    ERHE_PROFILE_FUNCTION();
+
+    using Clock = std::chrono::steady_clock;
+
+    const erhe::net::Socket::State state_before = m_client.get_state();
+    if (state_before == erhe::net::Socket::State::CLOSED) {
+        m_hello_sent = false;
+        return false;
+    }
+    m_client.poll(0);
+    if (m_client.get_state() != erhe::net::Socket::State::CONNECTED) {
+        return m_client.get_state() != state_before;
+    }
+    if (!m_hello_sent) {
+        m_hello_sent = m_client.send_packet(encode_hello(static_cast<uint32_t>(m_window_byte_count)));
+    }
+
+    // Always apply at least one message so that stream makes progress
+    const Clock::time_point deadline = Clock::now() + std::chrono::microseconds{static_cast<int64_t>(m_apply_budget_ms * 1000.0f)};
+    std::size_t applied_count = 0;
+    while (!m_pending_messages.empty()) {
+        const std::vector<uint8_t> message = std::move(m_pending_messages.front());
+        m_pending_messages.pop_front();
+        const std::size_t byte_count = message.size() + graph_stream_packet_overhead;
+        m_pending_byte_count -= std::min(m_pending_byte_count, byte_count);
+        apply(message.data(), message.size());
+        m_credit_byte_count += byte_count;
+        ++applied_count;
+        if (Clock::now() >= deadline) {
+            break;
+        }
+    }
+
+    if (m_layout_dirty && (m_context.wavefront_visualization != nullptr)) {
+        m_context.wavefront_visualization->apply_baseline();
+        m_layout_dirty = false;
+    }
+
+    return_credit(m_pending_messages.empty());
+
+    ERHE_PROFILE_PLOT("Graph stream pending bytes", static_cast<int64_t>(m_pending_byte_count));
+    return (applied_count > 0) || (m_client.get_state() != state_before);
+}
+
+void Graph_stream_client::return_credit(const bool force)
+{
+    // Batch credit to avoid one tiny packet per message
+    if ((m_credit_byte_count == 0) || (!force && (m_credit_byte_count < m_window_byte_count / 4))) {
+        return;
+    }
+    if (m_client.send_packet(encode_credit(static_cast<uint32_t>(m_credit_byte_count)))) {
+        m_credit_byte_count = 0;
+    }
+}
+
+auto Graph_stream_client::get_node(const uint64_t node_id) -> Graph_node*
+{
+    const auto i = m_ui_nodes.find(node_id);
+    if (i == m_ui_nodes.end()) {
+        log_net->warn("graph stream: unknown node {}", node_id);
+        ++m_error_count;
+        return nullptr;
+    }
+    return i->second.get();
+}
+
+auto Graph_stream_client::replay(const std::vector<std::span<const uint8_t>>& messages) -> bool
+{
+    ERHE_PROFILE_FUNCTION();
+
+    m_active   = false;
+    m_complete = false;
+    for (const std::span<const uint8_t> message : messages) {
+        apply(message.data(), message.size());
+    }
+    if (m_layout_dirty && (m_context.wavefront_visualization != nullptr)) {
+        m_context.wavefront_visualization->apply_baseline();
+        m_layout_dirty = false;
+    }
+    return m_complete && (m_error_count == 0);
+}
+
+void Graph_stream_client::apply(const uint8_t* const data, const std::size_t length)
+{
+    Graph_stream_reader reader{data, length};
+    const Graph_stream_message_type type = reader.get_type();
+    if (!m_active && (type != Graph_stream_message_type::stream_begin)) {
+        return; // Joined in the middle of a stream restart
+    }
+    switch (type) {
+        case Graph_stream_message_type::stream_begin:    apply_stream_begin   (reader); break;
+        case Graph_stream_message_type::node:            apply_node           (reader); break;
+        case Graph_stream_message_type::edge:            apply_edge           (reader); break;
+        case Graph_stream_message_type::hull:            apply_hull           (reader); break;
+        case Graph_stream_message_type::wavefront_begin: apply_wavefront_begin(reader); break;
+        case Graph_stream_message_type::wavefront_chunk: apply_wavefront_chunk(reader); break;
+        case Graph_stream_message_type::graph_end: {
+            m_context.graph_window->fit();
+            break;
+        }
+        case Graph_stream_message_type::stream_end: {
+            m_complete = true;
+            m_context.node_convex_hull_visualization->frame_visualization();
+            log_net->info("graph stream '{}' complete, {} bytes received", m_name, m_received_byte_count);
+            break;
+        }
+        default: {
+            log_net->warn("graph stream: unexpected message {}", c_str(type));
+            ++m_error_count;
+            break;
+        }
+    }
+}
+
+void Graph_stream_client::apply_stream_begin(Graph_stream_reader& reader)
+{
+    const uint32_t    version    = reader.read_u32();
+    const std::string name       = reader.read_string();
+    const uint32_t    node_count = reader.read_u32();
+    const uint32_t    edge_count = reader.read_u32();
+    if (!reader.is_complete() || (version != graph_stream_protocol_version)) {
+        log_net->error("graph stream: unsupported stream (version {})", version);
+        ++m_error_count;
+        m_active = false;
+        return;
+    }
+
+    m_context.graph_window->clear();
+    m_context.node_convex_hull_visualization->clear();
+    m_ui_nodes.clear();
+    m_column_row_count.clear();
+    m_wavefronts.clear();
+    m_name                = name;
+    m_expected_node_count = node_count;
+    m_hull_count          = 0;
+    m_frame_count         = 0;
+    m_error_count         = 0;
+    m_complete            = false;
+    m_active              = true;
+    log_net->info("graph stream '{}' begin, {} nodes, {} edges", name, node_count, edge_count);
+}
+
+void Graph_stream_client::apply_node(Graph_stream_reader& reader)
+{
+    Graph_stream_node node;
+    if (!decode(reader, node)) {
+        log_net->warn("graph stream: invalid node message");
+        ++m_error_count;
+        return;
+    }
+
+    // Same layout as Domain_flow_graph_file::show_in_graph_window()
+    constexpr float column_width = 650.0f;
+    constexpr float row_height   = 250.0f;
+
+    std::shared_ptr<Graph_node> ui_node = erhe::make_pooled_item<Graph_node>(node.name, static_cast<std::size_t>(node.id));
+    constexpr uint64_t flags = erhe::Item_flags::visible | erhe::Item_flags::content | erhe::Item_flags::show_in_ui;
+    ui_node->enable_flag_bits(flags);
+    ui_node->set_depth(node.depth);
+
+    const auto column = m_column_row_count.find(node.depth);
+    const int  row    = (column == m_column_row_count.end()) ? 0 : column->second + 1;
+    m_column_row_count[node.depth] = row;
+    m_context.graph_window->get_node_editor()->SetNodePosition(
+        ui_node->get_id(),
+        ImVec2{node.depth * column_width, row * row_height}
+    );
+
+    for (const std::string& name : node.input_names) {
+        ui_node->make_input_pin(0, name);
+    }
+    for (const std::string& name : node.output_names) {
+        ui_node->make_output_pin(0, name);
+    }
+    m_context.graph_window->get_ui_graph().register_node(ui_node.get());
+    m_ui_nodes[node.id] = ui_node;
+}
+
+void Graph_stream_client::apply_edge(Graph_stream_reader& reader)
+{
+    Graph_stream_edge edge;
+    if (!decode(reader, edge)) {
+        log_net->warn("graph stream: invalid edge message");
+        ++m_error_count;
+        return;
+    }
+    Graph_node* src_node = get_node(edge.source_id);
+    Graph_node* dst_node = get_node(edge.destination_id);
+    if ((src_node == nullptr) || (dst_node == nullptr)) {
+        return;
+    }
+    if (
+        (src_node->get_output_pins().size() <= edge.source_slot) ||
+        (dst_node->get_input_pins ().size() <= edge.destination_slot)
+    ) {
+        log_net->warn(
+            "graph stream: edge {}:{} -> {}:{} pin out of range",
+            edge.source_id, edge.source_slot, edge.destination_id, edge.destination_slot
+        );
+        ++m_error_count;
+        return;
+    }
+    erhe::graph::Pin& src_pin = src_node->get_output_pins().at(edge.source_slot);
+    erhe::graph::Pin& dst_pin = dst_node->get_input_pins ().at(edge.destination_slot);
+    m_context.graph_window->get_ui_graph().connect(&src_pin, &dst_pin);
+}
+
+void Graph_stream_client::apply_hull(Graph_stream_reader& reader)
+{
+    Graph_stream_hull hull;
+    if (!decode(reader, hull)) {
+        log_net->warn("graph stream: invalid hull message");
+        ++m_error_count;
+        return;
+    }
+    Graph_node* ui_node = get_node(hull.node_id);
+    if (ui_node == nullptr) {
+        return;
+    }
+    glm::vec3 index_space_offset{0.0f, 0.0f, 0.0f};
+    std::shared_ptr<erhe::scene::Node> scene_graph_node = m_context.node_convex_hull_visualization->add_convex_hull(
+        hull.convex_hull,
+        index_space_offset
+    );
+    if (!scene_graph_node) {
+        return;
+    }
+    ui_node->set_convex_hull_visualization(scene_graph_node, index_space_offset);
+    if (m_hull_count++ == 0) {
+        m_context.node_convex_hull_visualization->frame_visualization();
+    }
+}
+
+void Graph_stream_client::apply_wavefront_begin(Graph_stream_reader& reader)
+{
+    Graph_stream_wavefront_begin wavefront_begin;
+    if (!decode(reader, wavefront_begin)) {
+        log_net->warn("graph stream: invalid wavefront begin message");
+        ++m_error_count;
+        return;
+    }
+    Graph_node* ui_node = get_node(wavefront_begin.node_id);
+    if (ui_node == nullptr) {
+        return;
+    }
+    ui_node->wavefront_frames().clear();
+    ui_node->wavefront_frames().reserve(wavefront_begin.frame_count);
+    ui_node->set_earliest_max_times(wavefront_begin.earliest_max_times);
+    m_wavefronts[wavefront_begin.node_id] = Wavefront_assembly{
+        .node        = ui_node,
+        .frame_count = wavefront_begin.frame_count,
+        .min         = wavefront_begin.min,
+        .max         = wavefront_begin.max
+    };
+}
+
+void Graph_stream_client::apply_wavefront_chunk(Graph_stream_reader& reader)
+{
+    Graph_stream_wavefront_chunk chunk;
+    if (!decode(reader, chunk)) {
+        log_net->warn("graph stream: invalid wavefront chunk message");
+        ++m_error_count;
+        return;
+    }
+    const auto i = m_wavefronts.find(chunk.node_id);
+    if (i == m_wavefronts.end()) {
+        log_net->warn("graph stream: wavefront chunk for node {} without begin", chunk.node_id);
+        ++m_error_count;
+        return;
+    }
+    Wavefront_assembly& assembly = i->second;
+    if (chunk.first_cube == 0) {
+        assembly.time                = chunk.time;
+        assembly.received_cube_count = 0;
+        assembly.packed_cubes.resize(chunk.total_cube_count);
+    }
+    if (
+        (chunk.time != assembly.time) ||
+        (chunk.total_cube_count != assembly.packed_cubes.size()) ||
+        (chunk.first_cube != assembly.received_cube_count) ||
+        (chunk.packed_cubes.size() > assembly.packed_cubes.size() - chunk.first_cube)
+    ) {
+        log_net->warn("graph stream: wavefront chunk for node {} time {} out of sequence", chunk.node_id, chunk.time);
+        ++m_error_count;
+        return;
+    }
+    std::copy(chunk.packed_cubes.begin(), chunk.packed_cubes.end(), assembly.packed_cubes.begin() + chunk.first_cube);
+    assembly.received_cube_count += chunk.packed_cubes.size();
+    if (assembly.received_cube_count < assembly.packed_cubes.size()) {
+        return;
+    }
+
+    // Frame complete - it becomes visible right away
+    std::vector<Wavefront_frame>& frames = assembly.node->wavefront_frames();
+    frames.push_back(
+        Wavefront_frame{
+            {},
+            {},
+            m_context.wavefront_visualization->make_cube_instance_buffer(assembly.packed_cubes),
+            assembly.time
+        }
+    );
+    Wavefront_visualization::set_color_range(frames, assembly.min, assembly.max);
+    ++m_frame_count;
+    m_layout_dirty = true;
+    if (frames.size() >= assembly.frame_count) {
+        m_wavefronts.erase(i);
+    }
+}
+
+void Graph_stream_client::imgui()
+{
+    ImGui::Text("Stream: %s", m_name.c_str());
+    ImGui::Text("Nodes: %d / %d", static_cast<int>(m_ui_nodes.size()), static_cast<int>(m_expected_node_count));
+    ImGui::Text("Hulls: %d", static_cast<int>(m_hull_count));
+    ImGui::Text("Wavefront frames: %d", static_cast<int>(m_frame_count));
+    ImGui::Text("Received: %.2f MB", static_cast<double>(m_received_byte_count) / (1024.0 * 1024.0));
+    ImGui::Text("Pending: %d messages, %d KB", static_cast<int>(m_pending_messages.size()), static_cast<int>(m_pending_byte_count / 1024));
+    if (m_error_count > 0) {
+        ImGui::Text("Errors: %d", static_cast<int>(m_error_count));
+    }
+    if (m_complete) {
+        ImGui::TextUnformatted("Complete");
+    }
+}
+
+} // namespace explorer
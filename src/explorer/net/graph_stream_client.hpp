@@ -0,0 +1,91 @@
+#pragma once
+
+#include "erhe_net/client.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace explorer {
+
+class Explorer_context;
+class Graph_node;
+class Graph_stream_reader;
+
+// Viewer side of graph streaming (see net/graph_stream.hpp). Received
+// messages are applied incrementally, within a time budget per frame, so
+// hulls and wavefronts become visible as they arrive. Credit is returned to
+// producer only for applied messages, which limits the amount of data
+// buffered here to the window size.
+class Graph_stream_client
+{
+public:
+    explicit Graph_stream_client(Explorer_context& explorer_context);
+
+    void connect   (const char* address, int port);
+    void disconnect();
+    auto update    () -> bool; // once per frame, returns true if stream was applied or state changed
+    void imgui     ();
+
+    // Applies a recorded stream (messages without packet header) at once,
+    // without time budget. Used when opening graph session files. Returns
+    // true if the stream was complete and applied without errors.
+    auto replay(const std::vector<std::span<const uint8_t>>& messages) -> bool;
+
+    [[nodiscard]] auto get_state() -> erhe::net::Socket::State;
+
+private:
+    class Wavefront_assembly
+    {
+    public:
+        Graph_node*           node               {nullptr};
+        uint32_t              frame_count        {0};
+        glm::ivec3            min                {0, 0, 0};
+        glm::ivec3            max                {0, 0, 0};
+        int                   time               {0};
+        std::vector<uint32_t> packed_cubes;
+        std::size_t           received_cube_count{0};
+    };
+
+    void on_receive           (const uint8_t* data, std::size_t length);
+    void apply                (const uint8_t* data, std::size_t length);
+    void apply_stream_begin   (Graph_stream_reader& reader);
+    void apply_node           (Graph_stream_reader& reader);
+    void apply_edge           (Graph_stream_reader& reader);
+    void apply_hull           (Graph_stream_reader& reader);
+    void apply_wavefront_begin(Graph_stream_reader& reader);
+    void apply_wavefront_chunk(Graph_stream_reader& reader);
+    void return_credit        (bool force);
+    [[nodiscard]] auto get_node(uint64_t node_id) -> Graph_node*;
+
+    Explorer_context&                               m_context;
+    erhe::net::Client                               m_client;
+    std::size_t                                     m_window_byte_count  {1024 * 1024};
+    float                                           m_apply_budget_ms    {2.0f};
+    bool                                            m_hello_sent         {false};
+    std::deque<std::vector<uint8_t>>                m_pending_messages;
+    std::size_t                                     m_pending_byte_count {0};
+    std::size_t                                     m_credit_byte_count  {0}; // applied but not yet returned to producer
+
+    // Stream state
+    bool                                            m_active             {false};
+    bool                                            m_complete           {false};
+    bool                                            m_layout_dirty       {false};
+    std::string                                     m_name;
+    uint32_t                                        m_expected_node_count{0};
+    std::map<uint64_t, std::shared_ptr<Graph_node>> m_ui_nodes;
+    std::map<int, int>                              m_column_row_count;
+    std::map<uint64_t, Wavefront_assembly>          m_wavefronts;
+    std::size_t                                     m_hull_count         {0};
+    std::size_t                                     m_frame_count        {0};
+    std::size_t                                     m_received_byte_count{0};
+    std::size_t                                     m_error_count        {0};
+};
+
+} // namespace explorer
@@ -0,0 +1,286 @@
+#include "net/graph_stream_producer.hpp"
+#include "net/graph_stream.hpp"
+#include "graph/domain_flow_data.hpp"
+#include "explorer_log.hpp"
+
+#include "erhe_net/server.hpp"
+#include "erhe_profile/profile.hpp"
+
+#include <dfa/dfa.hpp>
+
+#include <algorithm>
+
+namespace explorer {
+
+namespace {
+
+// Keeps producer well below erhe::net::Socket send queue limit
+constexpr std::size_t min_window_byte_count =       64 * 1024;
+constexpr std::size_t max_window_byte_count = 2 * 1024 * 1024;
+
+}
+
+Graph_stream_producer::Graph_stream_producer(erhe::net::Server& server, const std::size_t chunk_cube_count)
+    : m_server          {server}
+    , m_chunk_cube_count{std::max(chunk_cube_count, std::size_t{1})}
+{
+    m_server.set_client_receive_handler(
+        [this](erhe::net::Socket& client, const uint8_t* data, const std::size_t length) {
+            on_receive(client, data, length);
+        }
+    );
+    // Sessions are erased before the socket is destroyed, so a later client
+    // socket at the same address never inherits a stale session
+    m_server.set_client_disconnect_handler(
+        [this](erhe::net::Socket& client) {
+            m_sessions.erase(&client);
+        }
+    );
+}
+
+Graph_stream_producer::~Graph_stream_producer() noexcept
+{
+    m_server.set_client_receive_handler({});
+    m_server.set_client_disconnect_handler({});
+}
+
+void Graph_stream_producer::add_packet(erhe::net::Shared_packet&& packet)
+{
+    m_byte_count += packet->size();
+    m_packets.push_back(std::move(packet));
+}
+
+void encode_graph_stream(
+    const sw::dfa::DomainFlowGraph&                         dfg,
+    const std::string_view                                  name,
+    const std::size_t                                       chunk_cube_count,
+    const std::function<void(erhe::net::Shared_packet&&)>& output
+)
+{
+    ERHE_PROFILE_FUNCTION();
+
+    using namespace sw::dfa;
+
+    // Nodes are streamed in depth order, so that hulls and wavefronts
+    // appear in the same order as when the graph is loaded locally.
+    std::vector<std::pair<std::size_t, const DomainFlowNode*>> nodes;
+    for (const auto& [node_id, node] : dfg.graph.nodes()) {
+        nodes.emplace_back(node_id, &node);
+    }
+    std::stable_sort(
+        nodes.begin(),
+        nodes.end(),
+        [](const auto& lhs, const auto& rhs)
+        {
+            return lhs.second->getDepth() < rhs.second->getDepth();
+        }
+    );
+
+    std::size_t edge_count = 0;
+    for (const auto& edge : dfg.graph.edges()) {
+        static_cast<void>(edge);
+        ++edge_count;
+    }
+
+    output(encode_stream_begin(name, static_cast<uint32_t>(nodes.size()), static_cast<uint32_t>(edge_count)));
+
+    // Graph structure first - it is small and lets viewers show the graph right away
+    for (const auto& [node_id, node] : nodes) {
+        Graph_stream_node stream_node{
+            .id          = node_id,
+            .depth       = node->getDepth(),
+            .is_operator = node->isOperator(),
+            .name        = node->getName()
+        };
+        for (std::size_t j = 0, end = node->getNrInputs(); j < end; ++j) {
+            stream_node.input_names.push_back(node->operandType.at(j));
+        }
+        for (std::size_t j = 0, end = node->getNrOutputs(); j < end; ++j) {
+            stream_node.output_names.push_back(node->resultType.at(j));
+        }
+        output(encode_node(stream_node));
+    }
+    for (const auto& [edge_id, edge] : dfg.graph.edges()) {
+        output(
+            encode_edge(
+                Graph_stream_edge{
+                    .source_id        = edge_id.first,
+                    .source_slot      = static_cast<uint32_t>(edge.srcSlot),
+                    .destination_id   = edge_id.second,
+                    .destination_slot = static_cast<uint32_t>(edge.dstSlot)
+                }
+            )
+        );
+    }
+    output(encode_empty(Graph_stream_message_type::graph_end));
+
+    // Per node hull and schedule
+    for (const auto& [node_id, node] : nodes) {
+        output(encode_hull(node_id, get_convex_hull_data(*node)));
+
+        const Schedule_data schedule_data = get_schedule_data(*node);
+        if (schedule_data.wavefronts.empty()) {
+            continue;
+        }
+        output(
+            encode_wavefront_begin(
+                Graph_stream_wavefront_begin{
+                    .node_id            = node_id,
+                    .frame_count        = static_cast<uint32_t>(schedule_data.wavefronts.size()),
+                    .min                = schedule_data.min,
+                    .max                = schedule_data.max,
+                    .earliest_max_times = schedule_data.earliest_max_times
+                }
+            )
+        );
+        for (const Wavefront_data& wavefront : schedule_data.wavefronts) {
+            const std::size_t cube_count = wavefront.packed_cubes.size();
+            std::size_t       first_cube = 0;
+            do {
+                const std::size_t count = std::min(chunk_cube_count, cube_count - first_cube);
+                output(
+                    encode_wavefront_chunk(
+                        node_id,
+                        wavefront.time,
+                        static_cast<uint32_t>(first_cube),
+                        static_cast<uint32_t>(cube_count),
+                        wavefront.packed_cubes.data() + first_cube,
+                        count
+                    )
+                );
+                first_cube += count;
+            } while (first_cube < cube_count);
+        }
+    }
+    output(encode_empty(Graph_stream_message_type::stream_end));
+}
+
+void Graph_stream_producer::set_graph(const sw::dfa::DomainFlowGraph& dfg, const std::string_view name)
+{
+    ERHE_PROFILE_FUNCTION();
+
+    m_packets.clear();
+    m_byte_count = 0;
+
+    encode_graph_stream(
+        dfg,
+        name,
+        m_chunk_cube_count,
+        [this](erhe::net::Shared_packet&& packet) {
+            add_packet(std::move(packet));
+        }
+    );
+
+    log_net->info("graph stream '{}': {} packets, {} bytes", name, m_packets.size(), m_byte_count);
+
+    // Restart stream for viewers which are already connected
+    for (auto& [client, session] : m_sessions) {
+        session.next_packet          = 0;
+        session.in_flight_byte_count = 0;
+    }
+}
+
+void Graph_stream_producer::on_receive(erhe::net::Socket& client, const uint8_t* const data, const std::size_t length)
+{
+    Graph_stream_reader reader{data, length};
+    switch (reader.get_type()) {
+        case Graph_stream_message_type::hello: {
+            const uint32_t version           = reader.read_u32();
+            const uint32_t window_byte_count = reader.read_u32();
+            if (!reader.is_complete() || (version != graph_stream_protocol_version)) {
+                log_net->warn("graph stream client {} hello rejected (version {})", client.get_address_string(), version);
+                return;
+            }
+            m_sessions[&client] = Session{
+                .next_packet          = 0,
+                .window_byte_count    = std::clamp(static_cast<std::size_t>(window_byte_count), min_window_byte_count, max_window_byte_count),
+                .in_flight_byte_count = 0
+            };
+            log_net->info("graph stream client {} started, window {} bytes", client.get_address_string(), window_byte_count);
+            break;
+        }
+        case Graph_stream_message_type::credit: {
+            const uint32_t byte_count = reader.read_u32();
+            const auto i = m_sessions.find(&client);
+            if (!reader.is_complete() || (i == m_sessions.end())) {
+                log_net->warn("graph stream client {} sent unexpected credit", client.get_address_string());
+                return;
+            }
+            Session& session = i->second;
+            session.in_flight_byte_count -= std::min(session.in_flight_byte_count, static_cast<std::size_t>(byte_count));
+            break;
+        }
+        default: {
+            log_net->warn("graph stream client {} sent unexpected message {}", client.get_address_string(), c_str(reader.get_type()));
+            break;
+        }
+    }
+}
+
+void Graph_stream_producer::update()
+{
+    ERHE_PROFILE_FUNCTION();
+
+    const std::vector<std::unique_ptr<erhe::net::Socket>>& clients = m_server.get_clients();
+
+    for (const std::unique_ptr<erhe::net::Socket>& client : clients) {
+        if (client->get_state() != erhe::net::Socket::State::CONNECTED) {
+            continue;
+        }
+        const auto i = m_sessions.find(client.get());
+        if (i == m_sessions.end()) {
+            continue; // waiting for hello
+        }
+        Session& session = i->second;
+        while (session.next_packet < m_packets.size()) {
+            const erhe::net::Shared_packet& packet      = m_packets[session.next_packet];
+            const std::size_t               packet_size = packet->size();
+
+            // A packet larger than window is sent alone
+            if (
+                (session.in_flight_byte_count > 0) &&
+                (session.in_flight_byte_count + packet_size > session.window_byte_count)
+            ) {
+                break;
+            }
+            if (!client->send_packet(packet)) {
+                log_net->warn("graph stream client {} send failed", client->get_address_string());
+                break;
+            }
+            session.in_flight_byte_count += packet_size;
+            ++session.next_packet;
+        }
+    }
+}
+
+auto Graph_stream_producer::get_packet_count() const -> std::size_t
+{
+    return m_packets.size();
+}
+
+auto Graph_stream_producer::get_byte_count() const -> std::size_t
+{
+    return m_byte_count;
+}
+
+auto Graph_stream_producer::get_session_count() const -> std::size_t
+{
+    return m_sessions.size();
+}
+
+auto Graph_stream_producer::get_complete_count() const -> std::size_t
+{
+    return static_cast<std::size_t>(
+        std::count_if(
+            m_sessions.begin(),
+            m_sessions.end(),
+            [this](const auto& entry) {
+                return
+                    (entry.second.next_packet == m_packets.size()) &&
+                    (entry.second.in_flight_byte_count == 0);
+            }
+        )
+    );
+}
+
+} // namespace explorer
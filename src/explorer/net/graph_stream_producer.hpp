@@ -0,0 +1,65 @@
+#pragma once
+
+#include "erhe_net/socket.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace erhe::net { class Server; }
+namespace sw::dfa   { struct DomainFlowGraph; }
+
+namespace explorer {
+
+// Encodes the whole stream for a graph, passing messages to output in stream
+// order. Used by Graph_stream_producer and for saving graph sessions.
+void encode_graph_stream(
+    const sw::dfa::DomainFlowGraph&                         dfg,
+    std::string_view                                        name,
+    std::size_t                                             chunk_cube_count,
+    const std::function<void(erhe::net::Shared_packet&&)>& output
+);
+
+// Streams a domain flow graph and its schedule to all clients of a server.
+// The stream is encoded once; every client has its own position in it, so
+// viewers can connect at any time and slow viewers do not hold back others.
+class Graph_stream_producer
+{
+public:
+    static constexpr std::size_t default_chunk_cube_count = 16384;
+
+    Graph_stream_producer(erhe::net::Server& server, std::size_t chunk_cube_count = default_chunk_cube_count);
+    ~Graph_stream_producer() noexcept;
+
+    void set_graph(const sw::dfa::DomainFlowGraph& dfg, std::string_view name);
+
+    // Call after Server::poll()
+    void update();
+
+    [[nodiscard]] auto get_packet_count  () const -> std::size_t;
+    [[nodiscard]] auto get_byte_count    () const -> std::size_t;
+    [[nodiscard]] auto get_session_count () const -> std::size_t;
+    [[nodiscard]] auto get_complete_count() const -> std::size_t; // sessions which have applied the whole stream
+
+private:
+    class Session
+    {
+    public:
+        std::size_t next_packet         {0};
+        std::size_t window_byte_count   {0};
+        std::size_t in_flight_byte_count{0};
+    };
+
+    void on_receive(erhe::net::Socket& client, const uint8_t* data, std::size_t length);
+    void add_packet(erhe::net::Shared_packet&& packet);
+
+    erhe::net::Server&                                    m_server;
+    std::size_t                                           m_chunk_cube_count;
+    std::vector<erhe::net::Shared_packet>                 m_packets;
+    std::size_t                                           m_byte_count{0};
+    std::unordered_map<const erhe::net::Socket*, Session> m_sessions;
+};
+
+} // namespace explorer
@@ -17,7 +17,9 @@
 
 #include <cstdio>
 #include <algorithm>
+#include <chrono>
 #include <memory>
+#include <vector>
 
 class Peer
 {
@@ -413,6 +415,11 @@ public:
         options.add_options("Terminal configuration")
             ("terminal",        "Enable terminal", cxxopts::value<bool>()->default_value(str(terminal)));
 
+        options.add_options("Load test")
+            ("load-clients",    "Run local load test with this many clients (0 disables)", cxxopts::value<int>()->default_value("0"), "<count>")
+            ("load-messages",   "Number of messages server broadcasts in load test", cxxopts::value<int>()->default_value("1000"), "<count>")
+            ("load-size",       "Load test message size in bytes", cxxopts::value<int>()->default_value("1024"), "<bytes>");
+
         try {
             auto arguments = options.parse(argc, argv);
 
@@ -423,6 +430,9 @@ public:
             run_server      = arguments["server"         ].as<bool>();
             listen_address  = arguments["listen-address" ].as<std::string>();
             listen_port     = arguments["listen-port"    ].as<int>();
+            load_clients    = arguments["load-clients"   ].as<int>();
+            load_messages   = arguments["load-messages"  ].as<int>();
+            load_size       = arguments["load-size"      ].as<int>();
         } catch (const std::exception& e) {
             fmt::print(
                 "Error parsing command line argumenst: {}",
@@ -438,8 +448,97 @@ public:
     bool        run_server{false};
     std::string listen_address;
     int         listen_port;
+    int         load_clients {0};
+    int         load_messages{0};
+    int         load_size    {0};
 };
 
+// Connects load_clients local clients to an in-process server, broadcasts
+// load_messages messages and waits until every client has received them.
+auto run_load_test(const Options& options) -> int
+{
+    const std::size_t client_count  = static_cast<std::size_t>(options.load_clients);
+    const std::size_t message_count = static_cast<std::size_t>(options.load_messages);
+    const std::size_t message_size  = static_cast<std::size_t>((std::max)(1, options.load_size));
+
+    erhe::net::Server server;
+    if (!server.listen(options.listen_address.c_str(), options.listen_port)) {
+        fmt::print("load test: listen failed\n");
+        return EXIT_FAILURE;
+    }
+
+    std::vector<std::unique_ptr<erhe::net::Client>> clients;
+    std::vector<std::size_t>                        received_counts(client_count, 0);
+    for (std::size_t i = 0; i < client_count; ++i) {
+        auto client = std::make_unique<erhe::net::Client>();
+        client->set_receive_handler(
+            [&received_counts, i](const uint8_t*, const std::size_t) {
+                ++received_counts[i];
+            }
+        );
+        client->connect(options.connect_address.c_str(), options.connect_port);
+        clients.push_back(std::move(client));
+    }
+
+    using Clock = std::chrono::steady_clock;
+    const auto timeout = std::chrono::seconds{30};
+    const auto poll_all = [&]() {
+        server.poll(0);
+        for (auto& client : clients) {
+            client->poll(0);
+        }
+    };
+
+    const auto connect_start = Clock::now();
+    while (server.get_client_count() < client_count) {
+        poll_all();
+        if (Clock::now() - connect_start > timeout) {
+            fmt::print("load test: only {} / {} clients connected\n", server.get_client_count(), client_count);
+            return EXIT_FAILURE;
+        }
+    }
+    const auto connect_end = Clock::now();
+
+    const std::string message(message_size, 'x');
+    std::size_t sent_count = 0;
+    std::size_t complete_count = 0;
+    const auto broadcast_start = Clock::now();
+    while (complete_count < client_count) {
+        // Keep a bounded number of messages in flight so send queues do not overflow
+        if (sent_count < message_count) {
+            const std::size_t slowest = *std::min_element(received_counts.begin(), received_counts.end());
+            if (sent_count - slowest < 64) {
+                server.broadcast(message);
+                ++sent_count;
+            }
+        }
+        poll_all();
+        complete_count = static_cast<std::size_t>(
+            std::count(received_counts.begin(), received_counts.end(), message_count)
+        );
+        if (Clock::now() - broadcast_start > timeout) {
+            fmt::print("load test: timeout, {} / {} clients received all messages\n", complete_count, client_count);
+            return EXIT_FAILURE;
+        }
+    }
+    const auto broadcast_end = Clock::now();
+
+    using Seconds = std::chrono::duration<double>;
+    const double connect_seconds   = std::chrono::duration_cast<Seconds>(connect_end - connect_start).count();
+    const double broadcast_seconds = std::chrono::duration_cast<Seconds>(broadcast_end - broadcast_start).count();
+    const double delivered_bytes   = static_cast<double>(client_count * message_count * message_size);
+    fmt::print(
+        "load test: {} clients connected in {:.3f} s, {} x {} byte broadcasts delivered in {:.3f} s ({:.1f} MB/s)\n",
+        client_count,
+        connect_seconds,
+        message_count,
+        message_size,
+        broadcast_seconds,
+        delivered_bytes / (1024.0 * 1024.0) / (std::max)(broadcast_seconds, 1e-9)
+    );
+    return EXIT_SUCCESS;
+}
+
 auto main(int argc, char** argv) -> int
 {
     std::unique_ptr<Server_peer>    server_peer;
@@ -472,6 +571,10 @@ auto main(int argc, char** argv) -> int
     erhe::net::initialize_logging();
     erhe::net::initialize_net();
 
+    if (options.load_clients > 0) {
+        return run_load_test(options);
+    }
+
     erhe::net::Client client;
     erhe::net::Server server;
 
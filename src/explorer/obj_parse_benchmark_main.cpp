@@ -0,0 +1,159 @@
+// Headless Wavefront OBJ parse benchmark. Writes a generated OBJ file with
+// positions, texture coordinates, normals and quad faces, then times
+// parse_obj_geometry() without executor and with an executor.
+//
+//   obj-parse-benchmark --grid 1024 --iterations 5
+
+#include "explorer_log.hpp"
+#include "parsers/wavefront_obj.hpp"
+
+#include "erhe_file/file.hpp"
+#include "erhe_file/file_log.hpp"
+#include "erhe_geometry/geometry.hpp"
+#include "erhe_geometry/geometry_log.hpp"
+#include "erhe_log/log.hpp"
+
+#include <cxxopts.hpp>
+#include <fmt/format.h>
+#include <geogram/basic/common.h>
+#include <taskflow/taskflow.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iterator>
+#include <string>
+#include <thread>
+
+class Options
+{
+public:
+    Options(int argc, char** argv)
+    {
+        cxxopts::Options options{"obj-parse-benchmark", "Times Wavefront OBJ parsing on a generated file"};
+
+        options.add_options()
+            ("grid",       "Generated grid has grid x grid quads", cxxopts::value<int>()->default_value("1024"), "<count>")
+            ("iterations", "Number of timed parses for each mode", cxxopts::value<int>()->default_value("5"), "<count>")
+            ("threads",    "Executor worker count, 0 for hardware concurrency", cxxopts::value<int>()->default_value("0"), "<count>")
+            ("keep",       "Keep the generated file", cxxopts::value<bool>()->default_value("false"))
+            ("help",       "Print help");
+
+        try {
+            auto arguments = options.parse(argc, argv);
+            if (arguments.count("help")) {
+                fmt::print("{}\n", options.help());
+                return;
+            }
+            grid       = std::max(1, arguments["grid"      ].as<int>());
+            iterations = std::max(1, arguments["iterations"].as<int>());
+            threads    = std::max(0, arguments["threads"   ].as<int>());
+            keep       = arguments["keep"].as<bool>();
+            valid      = true;
+        } catch (const std::exception& e) {
+            fmt::print("Error parsing command line arguments: {}\n", e.what());
+        }
+    }
+
+    bool valid     {false};
+    int  grid      {0};
+    int  iterations{0};
+    int  threads   {0};
+    bool keep      {false};
+};
+
+namespace {
+
+auto make_obj_text(const int grid) -> std::string
+{
+    const int   vertex_row = grid + 1;
+    const float scale      = 1.0f / static_cast<float>(grid);
+    std::string text;
+    text.reserve(static_cast<std::size_t>(vertex_row) * vertex_row * 96 + static_cast<std::size_t>(grid) * grid * 64);
+    auto out = std::back_inserter(text);
+    fmt::format_to(out, "# generated by obj-parse-benchmark\no grid\n");
+    for (int y = 0; y < vertex_row; ++y) {
+        for (int x = 0; x < vertex_row; ++x) {
+            const float u = static_cast<float>(x) * scale;
+            const float v = static_cast<float>(y) * scale;
+            fmt::format_to(out, "v {:.6f} {:.6f} {:.6f}\nvt {:.6f} {:.6f}\nvn 0 1 0\n", u - 0.5f, 0.05f * (u * v), v - 0.5f, u, v);
+        }
+    }
+    for (int y = 0; y < grid; ++y) {
+        for (int x = 0; x < grid; ++x) {
+            const int a = 1 + y * vertex_row + x;
+            const int b = a + 1;
+            const int c = b + vertex_row;
+            const int d = a + vertex_row;
+            fmt::format_to(out, "f {0}/{0}/{0} {1}/{1}/{1} {2}/{2}/{2} {3}/{3}/{3}\n", a, b, c, d);
+        }
+    }
+    return text;
+}
+
+auto count_facets(const std::vector<std::shared_ptr<erhe::geometry::Geometry>>& geometries) -> std::size_t
+{
+    std::size_t count = 0;
+    for (const std::shared_ptr<erhe::geometry::Geometry>& geometry : geometries) {
+        count += geometry->get_mesh().facets.nb();
+    }
+    return count;
+}
+
+auto time_parse(const std::filesystem::path& path, tf::Executor* executor, const int iterations, std::size_t& out_facet_count) -> double
+{
+    double best_ms = 0.0;
+    for (int i = 0; i < iterations; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        const std::vector<std::shared_ptr<erhe::geometry::Geometry>> geometries = explorer::parse_obj_geometry(path, executor);
+        const auto end = std::chrono::steady_clock::now();
+        const double ms = std::chrono::duration<double, std::milli>(end - start).count();
+        best_ms = (i == 0) ? ms : std::min(best_ms, ms);
+        out_facet_count = count_facets(geometries);
+    }
+    return best_ms;
+}
+
+} // anonymous namespace
+
+auto main(int argc, char** argv) -> int
+{
+    Options options{argc, argv};
+    if (!options.valid) {
+        return 1;
+    }
+
+    erhe::log::console_init();
+    erhe::log::log_to_console();
+    erhe::log::initialize_log_sinks();
+    erhe::file::initialize_logging();
+    erhe::geometry::initialize_logging();
+    explorer::initialize_logging();
+    GEO::initialize(GEO::GEOGRAM_INSTALL_NONE);
+
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / fmt::format("obj_parse_benchmark_{}.obj", options.grid);
+    {
+        const std::string text = make_obj_text(options.grid);
+        if (!erhe::file::write_file(path, text)) {
+            return 1;
+        }
+        fmt::print("{}: {} quads, {:.1f} MB\n", erhe::file::to_string(path), options.grid * options.grid, static_cast<double>(text.size()) / (1024.0 * 1024.0));
+    }
+    const double mega_bytes = static_cast<double>(std::filesystem::file_size(path)) / (1024.0 * 1024.0);
+
+    std::size_t serial_facet_count   = 0;
+    std::size_t parallel_facet_count = 0;
+    const double serial_ms = time_parse(path, nullptr, options.iterations, serial_facet_count);
+
+    tf::Executor executor{(options.threads > 0) ? static_cast<std::size_t>(options.threads) : std::max(1u, std::thread::hardware_concurrency())};
+    const double parallel_ms = time_parse(path, &executor, options.iterations, parallel_facet_count);
+
+    fmt::print("serial:   {:9.2f} ms  {:8.1f} MB/s  {} facets\n", serial_ms, mega_bytes * 1000.0 / serial_ms, serial_facet_count);
+    fmt::print("parallel: {:9.2f} ms  {:8.1f} MB/s  {} facets, {} workers\n", parallel_ms, mega_bytes * 1000.0 / parallel_ms, parallel_facet_count, executor.num_workers());
+
+    if (!options.keep) {
+        std::error_code error_code;
+        std::filesystem::remove(path, error_code);
+    }
+    return (serial_facet_count == parallel_facet_count) ? 0 : 1;
+}
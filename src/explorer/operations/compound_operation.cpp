@@ -38,6 +38,20 @@ void Compound_operation::undo(Explorer_context& context)
     log_operations->trace("Op Undo End {}", describe());
 }
 
+void Compound_operation::get_blocks(std::vector<Operation_block>& blocks) const
+{
+    for (const auto& operation : m_parameters.operations) {
+        operation->get_blocks(blocks);
+    }
+}
+
+void Compound_operation::compact(const std::unordered_map<const void*, long>& history_references)
+{
+    for (const auto& operation : m_parameters.operations) {
+        operation->compact(history_references);
+    }
+}
+
 auto Compound_operation::describe() const -> std::string
 {
     std::stringstream ss;
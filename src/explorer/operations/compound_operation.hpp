@@ -24,6 +24,8 @@ public:
     auto describe() const -> std::string override;
     void execute (Explorer_context& context) override;
     void undo    (Explorer_context& context) override;
+    void get_blocks            (std::vector<Operation_block>& blocks) const override;
+    void compact               (const std::unordered_map<const void*, long>& history_references) override;
 
 private:
     Parameters m_parameters;
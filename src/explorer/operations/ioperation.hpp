@@ -2,12 +2,26 @@
 
 #include "erhe_item/unique_id.hpp"
 
+#include <cstddef>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace explorer {
 
 class Explorer_context;
 
+// Data block (render shape) referenced by an operation
+class Operation_block
+{
+public:
+    const void* block              {nullptr};
+    long        use_count          {0};
+    std::size_t byte_count         {0};
+    const void* geometry           {nullptr}; // may be shared by several blocks
+    std::size_t geometry_byte_count{0};
+};
+
 class Operation
 {
 public:
@@ -17,6 +31,16 @@ public:
     virtual void undo    (Explorer_context& context) = 0;
     virtual auto describe() const -> std::string = 0;
 
+    // Undo history memory accounting. Operations share data blocks with each
+    // other and with the scene (copy-on-write). get_blocks() appends one entry
+    // for each block reference held by the operation. Blocks which are
+    // referenced only by operation history (use count matches history
+    // references) are counted, each block once.
+    virtual void get_blocks(std::vector<Operation_block>& blocks) const;
+
+    // Releases regenerable data from blocks which are referenced only by the operation history
+    virtual void compact(const std::unordered_map<const void*, long>& history_references);
+
     [[nodiscard]] inline auto get_serial() const -> std::size_t { return m_id.get_id(); }
 
 private:
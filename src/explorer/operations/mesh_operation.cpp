@@ -65,6 +65,7 @@ void Mesh_operation::execute(Explorer_context&)
         if (old_node_physics) {
             node->detach(old_node_physics.get());
         }
+        restore(entry.after);
         entry.scene_mesh->set_primitives(entry.after.primitives);
         if (entry.after.node_physics) {
             node->attach(entry.after.node_physics);
@@ -103,6 +104,7 @@ void Mesh_operation::undo(Explorer_context&)
         if (old_node_physics) {
             node->detach(old_node_physics.get());
         }
+        restore(entry.before);
         entry.scene_mesh->set_primitives(entry.before.primitives);
         if (entry.before.node_physics) {
             node->attach(entry.before.node_physics);
@@ -112,6 +114,78 @@ void Mesh_operation::undo(Explorer_context&)
     }
 }
 
+void Mesh_operation::restore(const Entry::Version& version)
+{
+    for (const erhe::primitive::Primitive& primitive : version.primitives) {
+        const std::shared_ptr<erhe::primitive::Primitive_render_shape>& render_shape = primitive.render_shape;
+        if (!render_shape || !render_shape->get_geometry_const()) {
+            continue;
+        }
+        if (!render_shape->get_raytrace().get_raytrace_geometry()) {
+            render_shape->make_raytrace();
+        }
+    }
+}
+
+namespace {
+
+[[nodiscard]] auto is_history_only(
+    const std::shared_ptr<erhe::primitive::Primitive_render_shape>& render_shape,
+    const std::unordered_map<const void*, long>&                    history_references
+) -> bool
+{
+    const auto i = history_references.find(render_shape.get());
+    return (i != history_references.end()) && (render_shape.use_count() == i->second);
+}
+
+}
+
+void Mesh_operation::get_blocks(std::vector<Operation_block>& blocks) const
+{
+    for (const Entry& entry : m_entries) {
+        for (const Entry::Version* version : { &entry.before, &entry.after }) {
+            for (const erhe::primitive::Primitive& primitive : version->primitives) {
+                const std::shared_ptr<erhe::primitive::Primitive_render_shape>& render_shape = primitive.render_shape;
+                if (!render_shape) {
+                    continue;
+                }
+                const erhe::geometry::Geometry* geometry = render_shape->get_geometry_const().get();
+                blocks.push_back(
+                    Operation_block{
+                        .block               = render_shape.get(),
+                        .use_count           = render_shape.use_count(),
+                        .byte_count          = render_shape->get_memory_usage(),
+                        .geometry            = geometry,
+                        .geometry_byte_count = (geometry != nullptr) ? geometry->get_memory_usage() : 0
+                    }
+                );
+            }
+        }
+    }
+}
+
+void Mesh_operation::compact(const std::unordered_map<const void*, long>& history_references)
+{
+    // Raytrace buffers and acceleration structures are only needed while
+    // the version is in scene; restore() rebuilds them from geometry.
+    for (const Entry& entry : m_entries) {
+        for (const Entry::Version* version : { &entry.before, &entry.after }) {
+            for (const erhe::primitive::Primitive& primitive : version->primitives) {
+                const std::shared_ptr<erhe::primitive::Primitive_render_shape>& render_shape = primitive.render_shape;
+                if (!render_shape || !render_shape->get_geometry_const()) {
+                    continue;
+                }
+                if (!is_history_only(render_shape, history_references)) {
+                    continue;
+                }
+                if (render_shape->get_raytrace().get_raytrace_geometry()) {
+                    render_shape->release_raytrace();
+                }
+            }
+        }
+    }
+}
+
 void Mesh_operation::make_entries(const std::function<void(const erhe::geometry::Geometry& before_geometry, erhe::geometry::Geometry& after_geometry)> operation)
 {
     make_entries(
@@ -121,6 +195,16 @@ void Mesh_operation::make_entries(const std::function<void(const erhe::geometry:
     );
 }
 
+void Mesh_operation::make_entries(const std::function<void(const erhe::geometry::Geometry& before_geometry, erhe::geometry::Geometry& after_geometry, tf::Executor* executor)> operation)
+{
+    tf::Executor* executor = m_parameters.build_info.buffer_info.executor;
+    make_entries(
+        [&operation, executor](const erhe::geometry::Geometry& before_geometry, erhe::geometry::Geometry& after_geometry, erhe::scene::Node*) -> void {
+            operation(before_geometry, after_geometry, executor);
+        }
+    );
+}
+
 void Mesh_operation::make_entries(const std::function<void(const erhe::geometry::Geometry&, erhe::geometry::Geometry&, erhe::scene::Node*)> operation)
 {
     Selection& selection = *m_parameters.context.selection;
@@ -216,7 +300,7 @@ void Mesh_operation::make_entries(const std::function<void(const erhe::geometry:
                 erhe::geometry::Geometry::process_flag_compute_smooth_vertex_normals |
                 erhe::geometry::Geometry::process_flag_generate_facet_texture_coordinates;
 
-            after_geometry->process(flags);
+            after_geometry->process(flags, m_parameters.build_info.buffer_info.executor);
 
             erhe::primitive::Primitive after_primitive{after_geometry, primitive.material};
             const bool renderable_ok = after_primitive.make_renderable_mesh(m_parameters.build_info, render_shape->get_normal_style());
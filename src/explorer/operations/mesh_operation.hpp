@@ -16,6 +16,10 @@ namespace erhe::scene {
     class Node;
 }
 
+namespace tf {
+    class Executor;
+}
+
 namespace explorer {
 
 class Explorer_context;
@@ -54,6 +58,8 @@ protected:
     auto describe() const -> std::string   override;
     void execute (Explorer_context& context) override;
     void undo    (Explorer_context& context) override;
+    void get_blocks            (std::vector<Operation_block>& blocks) const override;
+    void compact               (const std::unordered_map<const void*, long>& history_references) override;
 
     // Public API
     void add_entry   (Entry&& entry);
@@ -74,8 +80,21 @@ protected:
             )
         > operation
     );
+    // Operation gets executor from build_info for parallel work
+    void make_entries(
+        const std::function<
+            void(
+                const erhe::geometry::Geometry& before_geo_mesh,
+                erhe::geometry::Geometry&       after_geo_mesh,
+                tf::Executor*                   executor
+            )
+        > operation
+    );
 
 protected:
+    // Rebuilds data released by compact() before version is put back to scene
+    static void restore(const Entry::Version& version);
+
     Mesh_operation_parameters m_parameters;
     std::vector<Entry>        m_entries;
 };
@@ -1,25 +1,39 @@
 #include "operations/operation_stack.hpp"
 
 #include "explorer_context.hpp"
+#include "explorer_log.hpp"
 #include "operations/ioperation.hpp"
 #include "tools/tool.hpp"
 
+#include "erhe_configuration/configuration.hpp"
 #include "erhe_imgui/imgui_windows.hpp"
 #include "erhe_commands/commands.hpp"
 #include "erhe_profile/profile.hpp"
+#include "erhe_verify/verify.hpp"
 
 #if defined(ERHE_GUI_LIBRARY_IMGUI)
 #   include <imgui/imgui.h>
 #endif
 
+#include <fmt/format.h>
 #include <taskflow/taskflow.hpp>
 
+#include <algorithm>
+
 namespace explorer {
 
 Operation::~Operation() noexcept
 {
 }
 
+void Operation::get_blocks(std::vector<Operation_block>&) const
+{
+}
+
+void Operation::compact(const std::unordered_map<const void*, long>&)
+{
+}
+
 #pragma region Commands
 Undo_command::Undo_command(erhe::commands::Commands& commands, Explorer_context& context)
     : Command  {commands, "undo"}
@@ -76,6 +90,13 @@ Operation_stack::Operation_stack(
 
     m_undo_command.set_host(this);
     m_redo_command.set_host(this);
+
+    int undo_memory_budget = 512;
+    const auto& ini = erhe::configuration::get_ini_file_section("erhe.ini", "operation_stack");
+    ini.get("undo_memory_budget", undo_memory_budget);
+    std::size_t kilo = 1024;
+    std::size_t mega = 1024 * kilo;
+    m_memory_budget = static_cast<std::size_t>(std::max(undo_memory_budget, 0)) * mega;
 }
 
 Operation_stack::~Operation_stack() = default;
@@ -85,6 +106,134 @@ auto Operation_stack::get_executor() -> tf::Executor&
     return m_executor;
 }
 
+auto Operation_stack::get_memory_usage() const -> std::size_t
+{
+    return m_memory_usage;
+}
+
+void Operation_stack::remove_history(const Operation& operation)
+{
+    m_blocks.clear();
+    operation.get_blocks(m_blocks);
+    for (const Operation_block& block : m_blocks) {
+        const auto i = m_history_references.find(block.block);
+        ERHE_VERIFY(i != m_history_references.end());
+        if (--i->second == 0) {
+            m_history_references.erase(i);
+            set_history_only(block, false);
+        }
+    }
+}
+
+void Operation_stack::reclassify_history()
+{
+    ERHE_PROFILE_FUNCTION();
+
+    // Rebuilt from scratch whenever history changes, so blocks acquired or
+    // released outside operations, and copies that were alive during an
+    // earlier pass, do not leave a stale classification behind.
+    m_history_references.clear();
+    m_history_only_blocks.clear();
+    m_history_only_geometries.clear();
+    m_memory_usage = 0;
+
+    m_blocks.clear();
+    for (const auto& operation : m_executed) {
+        operation->get_blocks(m_blocks);
+    }
+    for (const auto& operation : m_undone) {
+        operation->get_blocks(m_blocks);
+    }
+    for (const Operation_block& block : m_blocks) {
+        ++m_history_references[block.block];
+    }
+
+    // Compaction changes block byte counts, so blocks are gathered again
+    for (const auto& operation : m_executed) {
+        operation->compact(m_history_references);
+    }
+    for (const auto& operation : m_undone) {
+        operation->compact(m_history_references);
+    }
+    m_blocks.clear();
+    for (const auto& operation : m_executed) {
+        operation->get_blocks(m_blocks);
+    }
+    for (const auto& operation : m_undone) {
+        operation->get_blocks(m_blocks);
+    }
+    for (const Operation_block& block : m_blocks) {
+        if (m_history_only_blocks.contains(block.block)) {
+            continue;
+        }
+        const auto i = m_history_references.find(block.block);
+        ERHE_VERIFY(i != m_history_references.end());
+        if (block.use_count == i->second) {
+            set_history_only(block, true);
+        }
+    }
+}
+
+void Operation_stack::set_history_only(const Operation_block& block, const bool history_only)
+{
+    const auto i = m_history_only_blocks.find(block.block);
+    if (i != m_history_only_blocks.end()) {
+        m_memory_usage -= i->second.byte_count;
+        if (i->second.geometry != nullptr) {
+            const auto j = m_history_only_geometries.find(i->second.geometry);
+            ERHE_VERIFY(j != m_history_only_geometries.end());
+            if (--j->second.block_count == 0) {
+                m_memory_usage -= j->second.byte_count;
+                m_history_only_geometries.erase(j);
+            }
+        }
+        m_history_only_blocks.erase(i);
+    }
+    if (!history_only) {
+        return;
+    }
+    m_history_only_blocks.emplace(block.block, block);
+    m_memory_usage += block.byte_count;
+    if (block.geometry != nullptr) {
+        Geometry_use& geometry_use = m_history_only_geometries[block.geometry];
+        if (geometry_use.block_count++ == 0) {
+            geometry_use.byte_count = block.geometry_byte_count;
+            m_memory_usage += geometry_use.byte_count;
+        }
+    }
+}
+
+void Operation_stack::evict_over_budget()
+{
+    ERHE_PROFILE_FUNCTION();
+
+    if (m_memory_budget == 0) {
+        return;
+    }
+
+    // Evict oldest undo steps first, then the furthest redo steps. The most
+    // recently executed operation is always kept.
+    std::size_t executed_count = 0;
+    std::size_t undone_count   = 0;
+    while (m_memory_usage > m_memory_budget) {
+        if (executed_count + 1 < m_executed.size()) {
+            remove_history(*m_executed[executed_count++].get());
+        } else if (undone_count < m_undone.size()) {
+            remove_history(*m_undone[undone_count++].get());
+        } else {
+            break;
+        }
+    }
+    if ((executed_count == 0) && (undone_count == 0)) {
+        return;
+    }
+    m_executed.erase(m_executed.begin(), m_executed.begin() + executed_count);
+    m_undone  .erase(m_undone  .begin(), m_undone  .begin() + undone_count);
+    m_evicted_operations += executed_count + undone_count;
+    reclassify_history();
+    log_operations->info("Undo history over memory budget, {} operations evicted in total", m_evicted_operations);
+}
+
 void Operation_stack::queue(const std::shared_ptr<Operation>& operation)
 {
     m_queued.push_back(operation);
@@ -102,8 +251,10 @@ void Operation_stack::update()
         operation->execute(m_context);
         m_executed.push_back(operation);
     }
-    m_queued.clear();
     m_undone.clear();
+    m_queued.clear();
+    reclassify_history();
+    evict_over_budget();
 }
 
 void Operation_stack::undo()
@@ -115,6 +266,8 @@ void Operation_stack::undo()
     m_executed.pop_back();
     operation->undo(m_context);
     m_undone.push_back(operation);
+    reclassify_history();
+    evict_over_budget();
 }
 
 void Operation_stack::redo()
@@ -126,6 +279,8 @@ void Operation_stack::redo()
     m_undone.pop_back();
     operation->execute(m_context);
     m_executed.push_back(operation);
+    reclassify_history();
+    evict_over_budget();
 }
 
 auto Operation_stack::can_undo() const -> bool
@@ -166,6 +321,18 @@ void Operation_stack::imgui()
     ERHE_PROFILE_FUNCTION();
 
 #if defined(ERHE_GUI_LIBRARY_IMGUI)
+    const float usage_mb  = static_cast<float>(m_memory_usage)  / (1024.0f * 1024.0f);
+    const float budget_mb = static_cast<float>(m_memory_budget) / (1024.0f * 1024.0f);
+    if (m_memory_budget > 0) {
+        const float fraction = std::min(usage_mb / budget_mb, 1.0f);
+        const std::string label = fmt::format("{:.1f} / {:.0f} MB", usage_mb, budget_mb);
+        ImGui::ProgressBar(fraction, ImVec2{-FLT_MIN, 0.0f}, label.c_str());
+    } else {
+        ImGui::Text("Memory: %.1f MB (no budget)", usage_mb);
+    }
+    if (m_evicted_operations > 0) {
+        ImGui::Text("Evicted: %zu", m_evicted_operations);
+    }
     imgui("Executed", m_executed);
     imgui("Undone", m_undone);
 #endif
@@ -1,9 +1,12 @@
 #pragma once
 
+#include "operations/ioperation.hpp"
+
 #include "erhe_commands/command.hpp"
 #include "erhe_imgui/imgui_window.hpp"
 
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 namespace erhe::commands {
@@ -70,10 +73,22 @@ public:
     // Implements Window
     void imgui() override;
 
-    [[nodiscard]] auto get_executor() -> tf::Executor&;
+    [[nodiscard]] auto get_executor    () -> tf::Executor&;
+    [[nodiscard]] auto get_memory_usage() const -> std::size_t;
 
 private:
-    void imgui(const char* stack_label, const std::vector<std::shared_ptr<Operation>>& operations);
+    void imgui            (const char* stack_label, const std::vector<std::shared_ptr<Operation>>& operations);
+    void remove_history   (const Operation& operation);
+    void reclassify_history();
+    void set_history_only (const Operation_block& block, bool history_only);
+    void evict_over_budget();
+
+    class Geometry_use
+    {
+    public:
+        long        block_count{0}; // history only blocks using the geometry
+        std::size_t byte_count {0};
+    };
 
     Explorer_context& m_context;
     tf::Executor&   m_executor;
@@ -84,6 +99,17 @@ private:
     std::vector<std::shared_ptr<Operation>> m_executed;
     std::vector<std::shared_ptr<Operation>> m_undone;
     std::vector<std::shared_ptr<Operation>> m_queued;
+
+    // Rebuilt by reclassify_history() after every change to m_executed and m_undone;
+    // remove_history() only keeps m_memory_usage current while evicting
+    std::unordered_map<const void*, long>            m_history_references;      // block -> references from m_executed and m_undone
+    std::unordered_map<const void*, Operation_block> m_history_only_blocks;
+    std::unordered_map<const void*, Geometry_use>    m_history_only_geometries;
+    std::vector<Operation_block>                     m_blocks;                  // scratch
+
+    std::size_t m_memory_budget     {0}; // 0 disables eviction
+    std::size_t m_memory_usage      {0}; // history only blocks and their geometries
+    std::size_t m_evicted_operations{0};
 };
 
 } // namespace explorer
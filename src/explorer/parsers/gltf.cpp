@@ -11,6 +11,7 @@
 #include "erhe_gltf/image_transfer.hpp"
 #include "erhe_primitive/build_info.hpp"
 #include "erhe_primitive/primitive.hpp"
+#include "erhe_profile/profile.hpp"
 #include "erhe_scene/animation.hpp"
 #include "erhe_scene/camera.hpp"
 #include "erhe_scene/light.hpp"
@@ -20,6 +21,7 @@
 #include "erhe_scene/skin.hpp"
 
 #include <fmt/format.h>
+#include <taskflow/taskflow.hpp>
 
 #include <unordered_map>
 #include <unordered_set>
@@ -89,6 +91,7 @@ void import_gltf(
         .root_node         = root_node,
         .mesh_layer_id     = scene_root.layers().content()->id,
         .path              = path,
+        .executor          = build_info.buffer_info.executor
     };
     erhe::gltf::Gltf_data gltf_data = erhe::gltf::parse_gltf(parse_arguments);
 
@@ -142,8 +145,12 @@ void import_gltf(
     bool add_default_light = false;
     log_parsers->info("Processing {} nodes", gltf_data.nodes.size());
 
+    // Mesh clones made for glTF nodes share primitive shapes. Each unique
+    // shape is built once, as an executor task when executor is available.
     size_t mesh_count = 0;
     size_t primitive_count = 0;
+    std::vector<erhe::primitive::Primitive*>                           unique_primitives;
+    std::unordered_set<const erhe::primitive::Primitive_render_shape*> visited_shapes;
     for (const auto& node : gltf_data.nodes) {
         if (!node) {
             continue;
@@ -153,9 +160,53 @@ void import_gltf(
             ++mesh_count;
             std::vector<erhe::primitive::Primitive>& primitives = mesh->get_mutable_primitives();
             primitive_count += primitives.size();
+            for (erhe::primitive::Primitive& primitive : primitives) {
+                if (visited_shapes.insert(primitive.render_shape.get()).second) {
+                    unique_primitives.push_back(&primitive);
+                }
+            }
+        }
+    }
+    log_parsers->info(
+        "Processing {} nodes, {} meshes, {} primitives, {} unique primitives",
+        gltf_data.nodes.size(), mesh_count, primitive_count, unique_primitives.size()
+    );
+
+    {
+        ERHE_PROFILE_SCOPE("build primitives");
+
+        const auto build_primitive = [&build_info](erhe::primitive::Primitive& primitive) {
+            // Ensure geometry exists
+            const bool geometry_ok = primitive.make_geometry();
+            if (!geometry_ok) {
+                return;
+            }
+
+            // Ensure raytrace exists
+            ERHE_VERIFY(primitive.make_raytrace());
+
+            // Ensure renderable mesh exists
+            ERHE_VERIFY(primitive.make_renderable_mesh(build_info, erhe::primitive::Normal_style::corner_normals));
+        };
+
+        tf::Executor* executor = build_info.buffer_info.executor;
+        if ((executor == nullptr) || (unique_primitives.size() < 2)) {
+            for (erhe::primitive::Primitive* primitive : unique_primitives) {
+                build_primitive(*primitive);
+            }
+        } else {
+            tf::Taskflow taskflow;
+            taskflow.for_each(
+                unique_primitives.begin(), unique_primitives.end(),
+                [&build_primitive](erhe::primitive::Primitive* primitive) { build_primitive(*primitive); }
+            );
+            if (executor->this_worker_id() >= 0) {
+                executor->corun(taskflow);
+            } else {
+                executor->run(taskflow).wait();
+            }
         }
     }
-    log_parsers->info("Processing {} nodes, {} meshes, {} primitives", gltf_data.nodes.size(), mesh_count, primitive_count);
 
     for (const auto& node : gltf_data.nodes) {
         if (!node) {
@@ -176,22 +227,6 @@ void import_gltf(
 
         auto mesh = erhe::scene::get_mesh(node.get());
         if (mesh) {
-            // TODO Defer geometry / raytrace / renderable mesh generation
-            std::vector<erhe::primitive::Primitive>& primitives = mesh->get_mutable_primitives();
-            for (erhe::primitive::Primitive& primitive : primitives) {
-                // Ensure geometry exists
-                const bool geometry_ok = primitive.make_geometry();
-                if (!geometry_ok) {
-                    continue;
-                }
-
-                // Ensure raytrace exists
-                ERHE_VERIFY(primitive.make_raytrace());
-
-                // Ensure renderable mesh exists
-                ERHE_VERIFY(primitive.make_renderable_mesh(build_info, erhe::primitive::Normal_style::corner_normals));
-            }
-
             mesh->update_rt_primitives();
         }
 
@@ -3,11 +3,18 @@
 
 #include "erhe_geometry/geometry.hpp"
 #include "erhe_file/file.hpp"
+#include "erhe_file/mapped_file.hpp"
+#include "erhe_file/text_tokenizer.hpp"
 #include "erhe_profile/profile.hpp"
 #include "erhe_verify/verify.hpp"
 
+#include <taskflow/taskflow.hpp>
+
+#include <algorithm>
+#include <cstdint>
 #include <limits>
 #include <string>
+#include <string_view>
 
 namespace explorer {
 
@@ -54,7 +61,7 @@ enum class Command : unsigned int {
     Vertex_normal,
 };
 
-Command tokenize(const std::string& text)
+auto tokenize(const std::string_view text) -> Command
 {
     // Vertex data
     if (text == "v")          return Command::Vertex_position;
@@ -111,323 +118,350 @@ Command tokenize(const std::string& text)
 // vn -1.64188e-16 -0.284002 0.958824
 // f 1/1/1 2/2/2 3/3/3 4/4/4
 
-auto parse_obj_geometry(const std::filesystem::path& path) -> std::vector<std::shared_ptr<erhe::geometry::Geometry>>
-{
-    ERHE_PROFILE_FUNCTION();
+namespace {
 
-    log_parsers->trace("path = {}", path.generic_string());
+// OBJ indices are 1 based, negative values are relative to the end of the
+// current list. Zero is used for components which are not present.
+class Obj_face_corner
+{
+public:
+    int position{0};
+    int texcoord{0};
+    int normal  {0};
+};
 
-    const auto opt_text = erhe::file::read("parse_obj_geometry", path);
-
-    std::vector<std::shared_ptr<erhe::geometry::Geometry>> result;
-
-    std::shared_ptr<erhe::geometry::Geometry> geometry{};
-    GEO::Mesh* geo_mesh{nullptr};
-    std::unique_ptr<Mesh_attributes> attributes{};
-
-    // I dislike this big scope, I'd prefer just to
-    // return {} but unfortunately having more than
-    // one return kills named return value optimization.
-    if (opt_text.has_value()) {
-        const std::string& text = opt_text.value();
-
-        const std::string delimiters  = " \t\v";
-        const std::string end_of_line = "\n";
-        const std::string slash       = "/\r";
-        const std::string comment     = "#";
-
-        std::string::size_type line_last_pos = text.find_first_not_of(end_of_line, 0);
-        std::string::size_type line_pos      = text.find_first_of(end_of_line, line_last_pos);
-        std::vector<GEO::vec3f> positions;
-        std::vector<GEO::vec4f> colors;
-        std::vector<GEO::vec3f> normals;
-        std::vector<GEO::vec2f> texcoords;
-
-        // Mapping from OBJ point id to geogram vertex
-        std::vector<GEO::index_t> obj_point_to_mesh_vertex;
-
-        bool has_vertex_colors = false;
-
-        while (
-            (line_pos != std::string::npos) ||
-            (line_last_pos != std::string::npos)
-        ) {
-            auto line = text.substr(line_last_pos, line_pos - line_last_pos);
-            line.erase(
-                std::remove(line.begin(), line.end(), '\r'),
-                line.end()
-            );
-
-            // Drop comments
-            const auto coment_pos = line.find_first_of(comment);
-            if (coment_pos != std::string::npos) {
-                line.erase(line.begin() + coment_pos, line.end());
-            }
+class Obj_statement
+{
+public:
+    Command          command{Command::Unknown};
+    uint32_t         first  {0}; // Obj_chunk::floats or Obj_chunk::corners index
+    uint32_t         count  {0};
+    std::string_view name;       // Group_name and Object_name only, view to mapped file
+};
 
-            //log_parsers->trace("line: {}", line);
-            if (line.length() == 0) {
-                line_last_pos = text.find_first_not_of(end_of_line, line_pos);
-                line_pos      = text.find_first_of(end_of_line, line_last_pos);
-                continue;
-            }
+// Parse results for a range of whole lines. Text is tokenized and numbers
+// parsed independently for each chunk. Chunks are then applied in file
+// order, which resolves relative indices and geometry boundaries.
+class Obj_chunk
+{
+public:
+    std::vector<Obj_statement>   statements;
+    std::vector<float>           floats;
+    std::vector<Obj_face_corner> corners;
+};
 
-            //const erhe::log::Indenter scope_indent;
+auto parse_face_corner(const std::string_view token, Obj_face_corner& corner) -> bool
+{
+    // v, v/vt, v//vn, v/vt/vn
+    const std::size_t first_slash = token.find('/');
+    if (!erhe::file::parse_integer(token.substr(0, first_slash), corner.position)) {
+        return false;
+    }
+    if (first_slash == std::string_view::npos) {
+        return true;
+    }
+    const std::string_view rest         = token.substr(first_slash + 1);
+    const std::size_t      second_slash = rest.find('/');
+    const std::string_view texcoord     = rest.substr(0, second_slash);
+    if (!texcoord.empty() && !erhe::file::parse_integer(texcoord, corner.texcoord)) {
+        return false;
+    }
+    if (second_slash == std::string_view::npos) {
+        return true;
+    }
+    const std::string_view normal = rest.substr(second_slash + 1);
+    return normal.empty() || erhe::file::parse_integer(normal, corner.normal);
+}
 
-            // process line
-            std::string::size_type token_last_pos = line.find_first_not_of(delimiters, 0);
-            std::string::size_type token_pos      = line.find_first_of    (delimiters, token_last_pos);
-            if (token_last_pos == std::string::npos || token_pos == std::string::npos) {
-                line_last_pos = text.find_first_not_of(end_of_line, line_pos);
-                line_pos      = text.find_first_of(end_of_line, line_last_pos);
-                continue;
-            }
+void parse_obj_chunk(const std::string_view text, Obj_chunk& chunk)
+{
+    ERHE_PROFILE_FUNCTION();
 
-            const auto command_text = line.substr(token_last_pos, token_pos - token_last_pos);
-            const auto command      = tokenize(command_text);
-
-            //log_parsers->trace("command: {}", command_text);
-            std::vector<float> float_args;
-            std::vector<int>   int_args;
-            std::vector<int>   face_vertex_position_indices;
-            std::vector<int>   face_vertex_texcoord_indices;
-            std::vector<int>   face_vertex_normal_indices;
-            while ((token_pos != std::string::npos) || (token_last_pos != std::string::npos)) {
-                switch (command) {
-                    //using enum Command;
-                    case Command::Object_name: {
-                        // TODO Choose Geometry splitting based on o / g / s / mg
-                        //      Currently fixed to use g
-                        token_last_pos = line.find_first_not_of(end_of_line, token_pos);
-                        token_pos      = line.find_first_of    (end_of_line, token_last_pos);
-                        if (token_last_pos != std::string::npos || token_pos != std::string::npos) {
-                            const auto arg_text = line.substr(token_last_pos, token_pos - token_last_pos);
-                            geometry = std::make_shared<erhe::geometry::Geometry>(arg_text);
-                            geo_mesh = &geometry->get_mesh();
-                            attributes = std::make_unique<Mesh_attributes>(*geo_mesh);
-                            result.push_back(geometry);
-                            obj_point_to_mesh_vertex.clear();
-                            log_parsers->trace("arg: {}", arg_text);
-                        }
-                        break;
-                    }
+    erhe::file::Line_reader line_reader{text};
+    std::string_view line;
+    while (line_reader.next(line)) {
+        // Drop comments
+        const std::size_t comment_pos = line.find('#');
+        if (comment_pos != std::string_view::npos) {
+            line = line.substr(0, comment_pos);
+        }
 
-                    case Command::Group_name: {
-                        token_last_pos = line.find_first_not_of(delimiters, token_pos);
-                        token_pos      = line.find_first_of(end_of_line, token_last_pos);
-                        if (token_last_pos != std::string::npos || token_pos != std::string::npos) {
-                            const auto arg_text = line.substr(token_last_pos, token_pos - token_last_pos);
-                            geometry = std::make_shared<erhe::geometry::Geometry>(arg_text);
-                            geo_mesh = &geometry->get_mesh();
-                            attributes = std::make_unique<Mesh_attributes>(*geo_mesh);
-                            result.push_back(geometry);
-                            obj_point_to_mesh_vertex.clear();
-                            //log_parsers->trace("arg: {}", arg_text);
-                        }
-                        //token_pos = text.find_first_of(end_of_line, token_last_pos);
-                        break;
-                    }
+        erhe::file::Token_reader token_reader{line};
+        std::string_view command_text;
+        if (!token_reader.next(command_text)) {
+            continue;
+        }
 
-                    case Command::Use_material:
-                    case Command::Unknown:
-                    case Command::Material_library: {
-                        // consume rest of the line for now
-                        token_last_pos = line.find_first_not_of(end_of_line, token_pos);
-                        token_pos      = line.find_first_of    (end_of_line, token_last_pos);
-                        if (token_last_pos != std::string::npos || token_pos != std::string::npos) {
-                            const auto arg_text = line.substr(token_last_pos, token_pos - token_last_pos);
-                            //log_parsers->trace("arg: {}", arg_text);
-                        }
-                        //token_last_pos = line.find_first_not_of(end_of_line, token_pos);
-                        //token_pos = text.find_first_of(end_of_line, token_last_pos);
-                        break;
-                    }
+        const Command command = tokenize(command_text);
+        switch (command) {
+            //using enum Command;
+            case Command::Object_name:
+            case Command::Group_name: {
+                // TODO Choose Geometry splitting based on o / g / s / mg
+                const std::string_view name = token_reader.rest();
+                if (!name.empty()) {
+                    chunk.statements.push_back(Obj_statement{.command = command, .name = name});
+                }
+                break;
+            }
 
-                    case Command::Vertex_position:
-                    // Three required variables: x, y, and z
-                    // One optional variable: w
-                    // Some applications support colors; if they are available, add RBG values after the variables.
-                    // The default is 1.
-
-                    case Command::Vertex_normal:
-                    // If a UV (vt) or vertex normal (vn) are defined for one vertex in a shape, they must be defined for all.
-                    // Three required variables: x, y, and z
-
-                    case Command::Vertex_texture_coordinate:
-                    // If a UV (vt) or vertex normal (vn) are defined for one vertex in a shape, they must be defined for all.
-                    // One required variable: u
-                    // Two optional variables: v and w
-                    // The default is 0.
-
-                    case Command::Vertex_parameter_space:
-                    // Use u for curve points
-                    // Use u and v for surface points and non-rational trimming curve control points
-                    // Use u, v, and w for rational trimming curve control points
-
-                    {
-                        token_last_pos = line.find_first_not_of(delimiters, token_pos);
-                        token_pos      = line.find_first_of    (delimiters, token_last_pos);
-                        if (token_last_pos != std::string::npos || token_pos != std::string::npos) {
-                            const auto  arg_text = line.substr(token_last_pos, token_pos - token_last_pos);
-                            const float value    = std::stof(arg_text);
-                            //log_parsers->trace("arg: {}", arg_text);
-                            float_args.push_back(value);
-                        }
-                        //token_last_pos = line.find_first_not_of(delimiters, token_pos);
-                        break;
+            case Command::Vertex_position:
+            // Three required variables: x, y, and z
+            // One optional variable: w
+            // Some applications support colors; if they are available, add RBG values after the variables.
+            // The default is 1.
+
+            case Command::Vertex_normal:
+            // If a UV (vt) or vertex normal (vn) are defined for one vertex in a shape, they must be defined for all.
+            // Three required variables: x, y, and z
+
+            case Command::Vertex_texture_coordinate: {
+            // If a UV (vt) or vertex normal (vn) are defined for one vertex in a shape, they must be defined for all.
+            // One required variable: u
+            // Two optional variables: v and w
+            // The default is 0.
+                Obj_statement statement{
+                    .command = command,
+                    .first   = static_cast<uint32_t>(chunk.floats.size())
+                };
+                std::string_view arg_text;
+                float            value{0.0f};
+                while (token_reader.next(arg_text)) {
+                    if (erhe::file::parse_float(arg_text, value)) {
+                        chunk.floats.push_back(value);
+                        ++statement.count;
                     }
+                }
+                chunk.statements.push_back(statement);
+                break;
+            }
 
-                    case Command::Face: {
-                        token_last_pos = line.find_first_not_of(delimiters, token_pos);
-                        token_pos      = line.find_first_of    (delimiters, token_last_pos);
-                        if (token_last_pos != std::string::npos || token_pos != std::string::npos) {
-                            const auto arg_text = line.substr(token_last_pos, token_pos - token_last_pos);
-                            //log_parsers->trace("arg: {}", arg_text);
-                            std::string::size_type subtoken_last_pos = arg_text.find_first_not_of(slash, 0);
-                            std::string::size_type subtoken_pos      = arg_text.find_first_of(slash, subtoken_last_pos);
-                            int subtoken_slot = 0;
-                            while ((subtoken_pos != std::string::npos) || (subtoken_last_pos != std::string::npos)) {
-                                const auto subtoken_text = arg_text.substr(subtoken_last_pos, subtoken_pos - subtoken_last_pos);
-                                //log_parsers->trace("subtoken: {}", subtoken_text);
-                                if (arg_text.length() > 0) {
-                                    const int value = std::stoi(subtoken_text);
-                                    switch (subtoken_slot) {
-                                        case 0: face_vertex_position_indices.push_back(value); break;
-                                        case 1: face_vertex_texcoord_indices.push_back(value); break;
-                                        case 2: face_vertex_normal_indices  .push_back(value); break;
-                                        default: {
-                                            //ERHE_FATAL("bad subtoken slot for wavefront obj parser face command");
-                                            break;
-                                        }
-                                    }
-                                }
-                                subtoken_last_pos = arg_text.find_first_not_of(slash, subtoken_pos);
-                                subtoken_pos      = arg_text.find_first_of    (slash, subtoken_last_pos);
-                                subtoken_slot++;
-                            }
-                        }
-                        //token_last_pos = line.find_first_not_of(delimiters, token_pos);
-                        break;
+            case Command::Face: {
+                Obj_statement statement{
+                    .command = command,
+                    .first   = static_cast<uint32_t>(chunk.corners.size())
+                };
+                std::string_view arg_text;
+                Obj_face_corner  corner;
+                while (token_reader.next(arg_text)) {
+                    corner = Obj_face_corner{};
+                    if (parse_face_corner(arg_text, corner)) {
+                        chunk.corners.push_back(corner);
+                        ++statement.count;
                     }
                 }
+                chunk.statements.push_back(statement);
+                break;
+            }
+
+            case Command::Vertex_parameter_space:
+            // Use u for curve points
+            // Use u and v for surface points and non-rational trimming curve control points
+            // Use u, v, and w for rational trimming curve control points
+            case Command::Use_material:
+            case Command::Unknown:
+            case Command::Material_library:
+            default: {
+                break;
             }
+        }
+    }
+}
 
-            switch (command) {
+class Obj_geometry_builder
+{
+public:
+    explicit Obj_geometry_builder(const std::filesystem::path& path)
+        : m_default_name{erhe::file::to_string(path.stem())}
+    {
+    }
+
+    void apply(const Obj_chunk& chunk)
+    {
+        ERHE_PROFILE_FUNCTION();
+
+        for (const Obj_statement& statement : chunk.statements) {
+            switch (statement.command) {
                 //using enum Command;
-                case Command::Group_name:
-                case Command::Use_material:
-                case Command::Unknown:
-                case Command::Material_library:
-                default:
+                case Command::Object_name:
+                case Command::Group_name: {
+                    begin_geometry(statement.name);
                     break;
+                }
                 case Command::Vertex_position: {
-                    //ZoneScopedN("position");
-                    if (float_args.size() >= 3) {
-                        ERHE_VERIFY(geo_mesh != nullptr);
-                        if (float_args.size() >= 6) {
-                            while (colors.size() < positions.size()) {
-                                colors.emplace_back(1.0f, 1.0f, 1.0f, 1.0f);
+                    const float* args = chunk.floats.data() + statement.first;
+                    if (statement.count >= 3) {
+                        if (statement.count >= 6) {
+                            while (m_colors.size() < m_positions.size()) {
+                                m_colors.emplace_back(1.0f, 1.0f, 1.0f, 1.0f);
                             }
-                            colors.emplace_back(float_args[3], float_args[4], float_args[5], 1.0f);
-                            has_vertex_colors = true;
-                            //point_colors->put(point_id, glm::vec3{float_args[3], float_args[4], float_args[5]});
+                            m_colors.emplace_back(args[3], args[4], args[5], 1.0f);
+                            m_has_vertex_colors = true;
                         }
-
-                        positions.emplace_back(float_args[0], float_args[1], float_args[2]);
+                        m_positions.emplace_back(args[0], args[1], args[2]);
                     }
-                    //else
-                    //{
-                    //    ERHE_FATAL("unsupported vertex dimension");
-                    //}
                     break;
                 }
-
                 case Command::Vertex_normal: {
-                    //ZoneScopedN("normal");
-                    if (float_args.size() == 3) {
-                        normals.emplace_back(float_args[0], float_args[1], float_args[2]);
+                    const float* args = chunk.floats.data() + statement.first;
+                    if (statement.count == 3) {
+                        m_normals.emplace_back(args[0], args[1], args[2]);
                     }
-                    //else
-                    //{
-                    //    ERHE_FATAL("unsupported normal dimension");
-                    //}
                     break;
                 }
                 case Command::Vertex_texture_coordinate: {
-                    //ZoneScopedN("texcoord");
                     // TODO support 1 / 3
-                    if (float_args.size() == 2) {
-                        texcoords.emplace_back(float_args[0], float_args[1]);
+                    const float* args = chunk.floats.data() + statement.first;
+                    if (statement.count == 2) {
+                        m_texcoords.emplace_back(args[0], args[1]);
                     }
-                    //else
-                    //{
-                    //    ERHE_FATAL("unsupported texcoord dimension");
-                    //}
                     break;
                 }
                 case Command::Face: {
-                    //ZoneScopedN("face");
-                    ERHE_VERIFY(geo_mesh != nullptr);
-
-                    const int          corner_count = static_cast<int>(face_vertex_position_indices.size());
-                    const GEO::index_t mesh_facet   = geo_mesh->facets.create_polygon(corner_count);
-                    for (int local_facet_corner = 0; local_facet_corner < corner_count; ++local_facet_corner) {
-                        const int obj_vertex_index = face_vertex_position_indices[local_facet_corner];
-                        const int position_index =
-                            (obj_vertex_index > 0)
-                                ? obj_vertex_index - 1
-                                : obj_vertex_index + static_cast<int>(positions.size());
-
-                        // Vertex indices in OBJ file are global.
-                        // Each erhe::geometry Geometry has it's own namespace for Point_id.
-                        // This maps OBJ vertex indices to geometry Point_id.
-                        while (static_cast<int>(obj_point_to_mesh_vertex.size()) <= position_index) {
-                            obj_point_to_mesh_vertex.push_back(GEO::NO_INDEX);
-                        }
-                        if (obj_point_to_mesh_vertex[position_index] == GEO::NO_INDEX) {
-                            obj_point_to_mesh_vertex[position_index] = geo_mesh->vertices.create_vertices(1);
-                        }
+                    add_face(&chunk.corners[statement.first], statement.count);
+                    break;
+                }
+                default: {
+                    break;
+                }
+            }
+        }
+    }
 
-                        const GEO::index_t mesh_vertex = obj_point_to_mesh_vertex[position_index];
-                        const GEO::index_t mesh_corner = geo_mesh->facets.corner(mesh_facet, local_facet_corner);
-                        geo_mesh->facets.set_vertex(mesh_facet, local_facet_corner, mesh_vertex);
-                        ERHE_VERIFY(position_index >= 0);
-                        ERHE_VERIFY(position_index < static_cast<int>(positions.size()));
+    [[nodiscard]] auto get_result() -> std::vector<std::shared_ptr<erhe::geometry::Geometry>>&
+    {
+        return m_result;
+    }
 
-                        set_pointf(geo_mesh->vertices, mesh_vertex, positions[position_index]);
+private:
+    void begin_geometry(const std::string_view name)
+    {
+        m_geometry   = std::make_shared<erhe::geometry::Geometry>(name);
+        m_geo_mesh   = &m_geometry->get_mesh();
+        m_attributes = std::make_unique<Mesh_attributes>(*m_geo_mesh);
+        m_result.push_back(m_geometry);
+        m_obj_point_to_mesh_vertex.clear();
+    }
 
-                        if (has_vertex_colors) {
-                            attributes->vertex_color_0.set(mesh_vertex, colors[position_index]);
-                        }
+    [[nodiscard]] static auto resolve_index(const int obj_index, const std::size_t count) -> int
+    {
+        return (obj_index > 0) ? obj_index - 1 : obj_index + static_cast<int>(count);
+    }
 
-                        if (local_facet_corner < static_cast<int>(face_vertex_texcoord_indices.size())) {
-                            const int obj_texcoord_index = face_vertex_texcoord_indices[local_facet_corner];
-                            const int texcoord_index =
-                                (obj_texcoord_index > 0)
-                                    ? obj_texcoord_index - 1
-                                    : obj_texcoord_index + static_cast<int>(texcoords.size());
-                            ERHE_VERIFY(texcoord_index < static_cast<int>(texcoords.size()));
-                            attributes->corner_texcoord_0.set(mesh_corner, texcoords[texcoord_index]);
-                        }
+    void add_face(const Obj_face_corner* corners, const uint32_t corner_count)
+    {
+        if (corner_count == 0) {
+            return;
+        }
+        if (m_geo_mesh == nullptr) {
+            // Faces before any o or g statement
+            begin_geometry(m_default_name);
+        }
 
-                        if (local_facet_corner < static_cast<int>(face_vertex_normal_indices.size())) {
-                            const int obj_normal_index = face_vertex_normal_indices[local_facet_corner];
-                            const int normal_index =
-                                (obj_normal_index > 0)
-                                    ? obj_normal_index - 1
-                                    : obj_normal_index + static_cast<int>(normals.size());
-                            ERHE_VERIFY(normal_index < static_cast<int>(normals.size()));
-                            attributes->corner_normal.set(mesh_corner, normals[normal_index]);
-                        }
-                    }
-                }
+        const GEO::index_t mesh_facet = m_geo_mesh->facets.create_polygon(corner_count);
+        for (uint32_t local_facet_corner = 0; local_facet_corner < corner_count; ++local_facet_corner) {
+            const Obj_face_corner& corner         = corners[local_facet_corner];
+            const int              position_index = resolve_index(corner.position, m_positions.size());
+            ERHE_VERIFY(position_index >= 0);
+            ERHE_VERIFY(position_index < static_cast<int>(m_positions.size()));
+
+            // Vertex indices in OBJ file are global.
+            // Each erhe::geometry Geometry has it's own namespace for Point_id.
+            // This maps OBJ vertex indices to geometry Point_id.
+            if (static_cast<int>(m_obj_point_to_mesh_vertex.size()) <= position_index) {
+                m_obj_point_to_mesh_vertex.resize(position_index + 1, GEO::NO_INDEX);
             }
+            if (m_obj_point_to_mesh_vertex[position_index] == GEO::NO_INDEX) {
+                m_obj_point_to_mesh_vertex[position_index] = m_geo_mesh->vertices.create_vertices(1);
+            }
+
+            const GEO::index_t mesh_vertex = m_obj_point_to_mesh_vertex[position_index];
+            const GEO::index_t mesh_corner = m_geo_mesh->facets.corner(mesh_facet, local_facet_corner);
+            m_geo_mesh->facets.set_vertex(mesh_facet, local_facet_corner, mesh_vertex);
 
-            line_last_pos = text.find_first_not_of(end_of_line, line_pos);
-            line_pos = text.find_first_of(end_of_line, line_last_pos);
+            set_pointf(m_geo_mesh->vertices, mesh_vertex, m_positions[position_index]);
+
+            if (m_has_vertex_colors) {
+                const GEO::vec4f color = (position_index < static_cast<int>(m_colors.size()))
+                    ? m_colors[position_index]
+                    : GEO::vec4f{1.0f, 1.0f, 1.0f, 1.0f};
+                m_attributes->vertex_color_0.set(mesh_vertex, color);
+            }
+
+            if (corner.texcoord != 0) {
+                const int texcoord_index = resolve_index(corner.texcoord, m_texcoords.size());
+                ERHE_VERIFY(texcoord_index >= 0);
+                ERHE_VERIFY(texcoord_index < static_cast<int>(m_texcoords.size()));
+                m_attributes->corner_texcoord_0.set(mesh_corner, m_texcoords[texcoord_index]);
+            }
+
+            if (corner.normal != 0) {
+                const int normal_index = resolve_index(corner.normal, m_normals.size());
+                ERHE_VERIFY(normal_index >= 0);
+                ERHE_VERIFY(normal_index < static_cast<int>(m_normals.size()));
+                m_attributes->corner_normal.set(mesh_corner, m_normals[normal_index]);
+            }
+        }
+    }
+
+    std::string                                            m_default_name;
+    std::vector<GEO::vec3f>                                m_positions;
+    std::vector<GEO::vec4f>                                m_colors;
+    std::vector<GEO::vec3f>                                m_normals;
+    std::vector<GEO::vec2f>                                m_texcoords;
+    std::vector<GEO::index_t>                              m_obj_point_to_mesh_vertex; // OBJ point id to geogram vertex
+    bool                                                   m_has_vertex_colors{false};
+    std::shared_ptr<erhe::geometry::Geometry>              m_geometry;
+    GEO::Mesh*                                             m_geo_mesh{nullptr};
+    std::unique_ptr<Mesh_attributes>                       m_attributes;
+    std::vector<std::shared_ptr<erhe::geometry::Geometry>> m_result;
+};
+
+constexpr std::size_t c_min_chunk_byte_count = 256 * 1024;
+
+} // anonymous namespace
+
+auto parse_obj_geometry(const std::filesystem::path& path, tf::Executor* executor) -> std::vector<std::shared_ptr<erhe::geometry::Geometry>>
+{
+    ERHE_PROFILE_FUNCTION();
+
+    log_parsers->trace("path = {}", path.generic_string());
+
+    erhe::file::Mapped_file file;
+    if (!file.open("parse_obj_geometry", path)) {
+        return {};
+    }
+    const std::string_view text = file.get_text();
+
+    // Tokenizing and number parsing runs in parallel for large files
+    const std::size_t max_chunk_count = (executor != nullptr) ? 4 * executor->num_workers() : 1;
+    const std::size_t chunk_count     = std::clamp<std::size_t>(text.size() / c_min_chunk_byte_count, 1, std::max<std::size_t>(max_chunk_count, 1));
+    const std::vector<std::string_view> chunk_texts = erhe::file::split_line_chunks(text, chunk_count);
+    std::vector<Obj_chunk> chunks(chunk_texts.size());
+    if ((executor == nullptr) || (chunks.size() < 2)) {
+        for (std::size_t i = 0, end = chunks.size(); i < end; ++i) {
+            parse_obj_chunk(chunk_texts[i], chunks[i]);
+        }
+    } else {
+        tf::Taskflow taskflow;
+        taskflow.for_each_index(
+            std::size_t{0}, chunks.size(), std::size_t{1},
+            [&chunk_texts, &chunks](const std::size_t i) {
+                parse_obj_chunk(chunk_texts[i], chunks[i]);
+            }
+        );
+        if (executor->this_worker_id() >= 0) {
+            executor->corun(taskflow);
+        } else {
+            executor->run(taskflow).wait();
         }
     }
 
-    return result;
+    Obj_geometry_builder builder{path};
+    for (const Obj_chunk& chunk : chunks) {
+        builder.apply(chunk);
+    }
+    return std::move(builder.get_result());
 }
 
 } // namespace explorer
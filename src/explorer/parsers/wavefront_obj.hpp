@@ -1,6 +1,7 @@
 #pragma once
 
 namespace erhe::geometry { class Geometry; }
+namespace tf { class Executor; }
 
 #include <filesystem>
 #include <memory>
@@ -8,6 +9,7 @@ namespace erhe::geometry { class Geometry; }
 
 namespace explorer {
 
-[[nodiscard]] auto parse_obj_geometry(const std::filesystem::path& path) -> std::vector<std::shared_ptr<erhe::geometry::Geometry>>;
+// When executor is given, large files are tokenized and parsed in parallel
+[[nodiscard]] auto parse_obj_geometry(const std::filesystem::path& path, tf::Executor* executor = nullptr) -> std::vector<std::shared_ptr<erhe::geometry::Geometry>>;
 
 }
@@ -0,0 +1,146 @@
+#include "redraw_tracker.hpp"
+#include "explorer_message_bus.hpp"
+
+#include "erhe_configuration/configuration.hpp"
+#include "erhe_profile/profile.hpp"
+#include "erhe_scene/node.hpp"
+#include "erhe_scene/scene_message_bus.hpp"
+
+#if defined(ERHE_GUI_LIBRARY_IMGUI)
+#   include <imgui/imgui.h>
+#endif
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <string>
+
+namespace explorer {
+
+Redraw_tracker::Redraw_tracker(
+    erhe::scene::Scene_message_bus& scene_message_bus,
+    Explorer_message_bus&           explorer_message_bus
+)
+    : m_scene_message_bus   {scene_message_bus}
+    , m_explorer_message_bus{explorer_message_bus}
+{
+    const auto& ini = erhe::configuration::get_ini_file_section("erhe.ini", "window");
+    ini.get("on_demand_rendering", m_enabled);
+    ini.get("idle_wait_time",      m_idle_wait_time);
+    ini.get("settle_frame_count",  m_settle_frame_count);
+    ini.get("show_frame_counter",  m_show_hud_counter);
+    m_settle_frame_count = std::max(m_settle_frame_count, 1);
+    request_redraw();
+}
+
+void Redraw_tracker::request_redraw()
+{
+    m_frames_to_render = m_settle_frame_count;
+}
+
+auto Redraw_tracker::update(const bool has_input_events, const bool is_animating) -> bool
+{
+    ERHE_PROFILE_FUNCTION();
+
+    const uint64_t transform_serial        = erhe::scene::Node_transforms::get_current_serial();
+    const uint64_t scene_message_serial    = m_scene_message_bus.get_message_serial();
+    const uint64_t explorer_message_serial = m_explorer_message_bus.get_message_serial();
+    const bool changed =
+        has_input_events ||
+        is_animating ||
+        (transform_serial        != m_transform_serial) ||
+        (scene_message_serial    != m_scene_message_serial) ||
+        (explorer_message_serial != m_explorer_message_serial);
+    sample_serials();
+
+    if (changed) {
+        request_redraw();
+    }
+
+    const bool render = !m_enabled || (m_frames_to_render > 0);
+    if (render) {
+        m_frames_to_render = std::max(m_frames_to_render - 1, 0);
+        ++m_rendered_frame_count;
+    } else {
+        ++m_skipped_frame_count;
+    }
+    m_idle = !render;
+
+    ERHE_PROFILE_PLOT("Rendered frames", static_cast<int64_t>(m_rendered_frame_count));
+    ERHE_PROFILE_PLOT("Skipped frames",  static_cast<int64_t>(m_skipped_frame_count));
+    return render;
+}
+
+void Redraw_tracker::end_frame()
+{
+    sample_serials();
+}
+
+void Redraw_tracker::sample_serials()
+{
+    m_transform_serial        = erhe::scene::Node_transforms::get_current_serial();
+    m_scene_message_serial    = m_scene_message_bus.get_message_serial();
+    m_explorer_message_serial = m_explorer_message_bus.get_message_serial();
+}
+
+auto Redraw_tracker::get_wait_time(const float busy_wait_time) const -> float
+{
+    // When idle, block until the next input event. The timeout keeps
+    // polling network and other sources which do not generate events.
+    return (m_enabled && m_idle) ? m_idle_wait_time : busy_wait_time;
+}
+
+auto Redraw_tracker::is_enabled() const -> bool
+{
+    return m_enabled;
+}
+
+auto Redraw_tracker::get_rendered_frame_count() const -> uint64_t
+{
+    return m_rendered_frame_count;
+}
+
+auto Redraw_tracker::get_skipped_frame_count() const -> uint64_t
+{
+    return m_skipped_frame_count;
+}
+
+void Redraw_tracker::set_enabled(const bool value)
+{
+    m_enabled = value;
+    request_redraw();
+}
+
+void Redraw_tracker::imgui()
+{
+#if defined(ERHE_GUI_LIBRARY_IMGUI)
+    bool enabled = m_enabled;
+    if (ImGui::Checkbox("On Demand Rendering", &enabled)) {
+        set_enabled(enabled);
+    }
+    ImGui::Checkbox ("Show Frame Counter", &m_show_hud_counter);
+    ImGui::DragFloat("Idle Wait Time",     &m_idle_wait_time, 0.01f, 0.01f, 1.0f, "%.2f s");
+    ImGui::DragInt  ("Settle Frames",      &m_settle_frame_count, 0.1f, 1, 30);
+
+    ImGui::Text("Rendered frames: %llu", static_cast<unsigned long long>(m_rendered_frame_count));
+    ImGui::Text("Skipped frames:  %llu", static_cast<unsigned long long>(m_skipped_frame_count));
+#endif
+}
+
+void Redraw_tracker::hud_imgui(const float x, const float y) const
+{
+#if defined(ERHE_GUI_LIBRARY_IMGUI)
+    if (!m_enabled || !m_show_hud_counter) {
+        return;
+    }
+    const std::string text = fmt::format("rendered {} / skipped {}", m_rendered_frame_count, m_skipped_frame_count);
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+    draw_list->AddText(ImVec2{x + 1.0f, y + 1.0f}, IM_COL32(  0,   0,   0, 192), text.c_str());
+    draw_list->AddText(ImVec2{x,        y       }, IM_COL32(255, 255, 255, 224), text.c_str());
+#else
+    static_cast<void>(x);
+    static_cast<void>(y);
+#endif
+}
+
+} // namespace explorer
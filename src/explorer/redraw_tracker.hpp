@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+
+namespace erhe::scene {
+    class Scene_message_bus;
+}
+
+namespace explorer {
+
+class Explorer_message_bus;
+
+// Decides which frames need to be rendered. With on demand rendering enabled,
+// a frame is rendered only when something may have changed what is shown:
+// input events, timeline playback, network activity, message bus activity or
+// node transform updates. A few more frames are rendered after each change,
+// because ImGui and id picking readback settle over multiple frames.
+class Redraw_tracker
+{
+public:
+    Redraw_tracker(
+        erhe::scene::Scene_message_bus& scene_message_bus,
+        Explorer_message_bus&           explorer_message_bus
+    );
+
+    // Forces next frames to be rendered
+    void request_redraw();
+
+    // Called once per frame after updates, before rendering.
+    // Returns true if the frame should be rendered.
+    [[nodiscard]] auto update(bool has_input_events, bool is_animating) -> bool;
+
+    // Called after a rendered frame. Rendering itself sends messages and
+    // updates node transforms; those are not changes to redraw for.
+    void end_frame();
+
+    // Time to wait for input events before the next frame
+    [[nodiscard]] auto get_wait_time(float busy_wait_time) const -> float;
+
+    [[nodiscard]] auto is_enabled              () const -> bool;
+    [[nodiscard]] auto get_rendered_frame_count() const -> uint64_t;
+    [[nodiscard]] auto get_skipped_frame_count () const -> uint64_t;
+    void set_enabled(bool value);
+    void imgui      ();
+    void hud_imgui  (float x, float y) const; // counter text drawn to current window
+
+private:
+    void sample_serials();
+
+    erhe::scene::Scene_message_bus& m_scene_message_bus;
+    Explorer_message_bus&           m_explorer_message_bus;
+
+    bool     m_enabled                {false};
+    bool     m_show_hud_counter       {true};
+    float    m_idle_wait_time         {0.25f};
+    int      m_settle_frame_count     {4};
+    int      m_frames_to_render       {0};
+    bool     m_idle                   {false};
+    uint64_t m_transform_serial       {0};
+    uint64_t m_scene_message_serial   {0};
+    uint64_t m_explorer_message_serial{0};
+    uint64_t m_rendered_frame_count   {0};
+    uint64_t m_skipped_frame_count    {0};
+};
+
+} // namespace explorer
@@ -18,10 +18,15 @@
 #include "erhe_graphics/shader_stages.hpp"
 #include "erhe_graphics/renderbuffer.hpp"
 #include "erhe_scene/camera.hpp"
+#include "erhe_scene/mesh.hpp"
 #include "erhe_scene_renderer/program_interface.hpp"
 #include "erhe_profile/profile.hpp"
 #include "erhe_verify/verify.hpp"
 
+#include <imgui/imgui.h>
+
+#include <algorithm>
+
 namespace explorer {
 
 using erhe::graphics::Framebuffer;
@@ -55,7 +60,7 @@ Id_renderer::Id_frame_resources::Id_frame_resources(erhe::graphics::Instance& gr
         graphics_instance,
         erhe::graphics::Buffer_create_info{
             .target              = gl::Buffer_target::pixel_pack_buffer,
-            .capacity_byte_count = s_id_buffer_size,
+            .capacity_byte_count = s_max_regions_per_slot * s_id_buffer_size,
             .storage_mask        = storage_mask,
             .access_mask         = access_mask,
             .debug_label         = "ID"
@@ -68,6 +73,14 @@ Id_renderer::Id_frame_resources::Id_frame_resources(Id_frame_resources&& other)
 
 auto Id_renderer::Id_frame_resources::operator=(Id_frame_resources&& other) noexcept -> Id_frame_resources& = default;
 
+void Id_renderer::Id_frame_resources::release_sync()
+{
+    if (sync != 0) {
+        gl::delete_sync(sync);
+        sync = 0;
+    }
+}
+
 static constexpr std::string_view c_id_renderer_initialize_component{"Id_renderer::initialize_component()"};
 
 [[nodiscard]] auto get_max_draw_count() -> std::size_t
@@ -123,17 +136,25 @@ Id_renderer::Id_renderer(
 
 #undef REVERSE_DEPTH
 {
-    create_id_frame_resources();
-
     const auto& ini = erhe::configuration::get_ini_file_section("erhe.ini", "id_renderer");
-    ini.get("enabled", enabled);
+    ini.get("enabled",           enabled);
+    ini.get("raytrace_fallback", raytrace_fallback);
+    int slot_count     = static_cast<int>(m_slot_count);
+    int max_result_age = static_cast<int>(m_max_result_age);
+    ini.get("slot_count",     slot_count);
+    ini.get("max_result_age", max_result_age);
+    m_slot_count     = static_cast<std::size_t>(std::clamp(slot_count, 2, 16));
+    m_max_result_age = static_cast<uint64_t>(std::max(max_result_age, 1));
+
+    create_id_frame_resources();
 }
 
 void Id_renderer::create_id_frame_resources()
 {
     ERHE_PROFILE_FUNCTION();
 
-    for (size_t slot = 0; slot < s_frame_resources_count; ++slot) {
+    m_id_frame_resources.reserve(m_slot_count);
+    for (size_t slot = 0; slot < m_slot_count; ++slot) {
         m_id_frame_resources.emplace_back(m_graphics_instance, slot);
     }
 }
@@ -149,7 +170,42 @@ void Id_renderer::next_frame()
         return;
     }
 
-    m_current_id_frame_resource_slot = (m_current_id_frame_resource_slot + 1) % s_frame_resources_count;
+    m_current_id_frame_resource_slot = (m_current_id_frame_resource_slot + 1) % m_slot_count;
+    ++m_frame_number;
+
+    // Counts restart every frame, latencies are kept until the next hit
+    m_last_frame_statistics = m_statistics;
+    m_statistics.queries   = 0;
+    m_statistics.hits      = 0;
+    m_statistics.misses    = 0;
+    m_statistics.coalesced = 0;
+    m_statistics.dropped   = 0;
+    m_statistics.stale     = 0;
+    ERHE_PROFILE_PLOT("Id renderer hits",           static_cast<int64_t>(m_last_frame_statistics.hits));
+    ERHE_PROFILE_PLOT("Id renderer misses",         static_cast<int64_t>(m_last_frame_statistics.misses));
+    ERHE_PROFILE_PLOT("Id renderer dropped",        static_cast<int64_t>(m_last_frame_statistics.dropped));
+    ERHE_PROFILE_PLOT("Id renderer stale",          static_cast<int64_t>(m_last_frame_statistics.stale));
+    ERHE_PROFILE_PLOT("Id renderer latency frames", static_cast<int64_t>(m_last_frame_statistics.latency_frames));
+}
+
+auto Id_renderer::get_statistics() const -> const Statistics&
+{
+    return m_last_frame_statistics;
+}
+
+void Id_renderer::imgui()
+{
+    const Statistics& statistics = m_last_frame_statistics;
+    ImGui::Checkbox("Raytrace Fallback", &raytrace_fallback);
+    ImGui::Text("Slots: %zu, max result age: %u frames", m_slot_count, static_cast<unsigned int>(m_max_result_age));
+    ImGui::Text("Queries: %zu, hits: %zu, misses: %zu", statistics.queries, statistics.hits, statistics.misses);
+    ImGui::Text("Coalesced: %zu, dropped: %zu, stale: %zu", statistics.coalesced, statistics.dropped, statistics.stale);
+    ImGui::Text(
+        "Latency: %u frames, %.2f ms (max %u frames)",
+        static_cast<unsigned int>(statistics.latency_frames),
+        statistics.latency_ms,
+        static_cast<unsigned int>(statistics.max_latency_frames)
+    );
 }
 
 void Id_renderer::update_framebuffer(const erhe::math::Viewport viewport)
@@ -163,22 +219,25 @@ void Id_renderer::update_framebuffer(const erhe::math::Viewport viewport)
     ERHE_VERIFY(m_use_renderbuffers != m_use_textures);
 
     if (m_use_renderbuffers) {
+        // Only grow, so that scene views of different sizes can share the framebuffer
         if (
             !m_color_renderbuffer ||
-            (m_color_renderbuffer->width()  != static_cast<unsigned int>(viewport.width)) ||
-            (m_color_renderbuffer->height() != static_cast<unsigned int>(viewport.height))
+            (m_color_renderbuffer->width()  < static_cast<unsigned int>(viewport.width)) ||
+            (m_color_renderbuffer->height() < static_cast<unsigned int>(viewport.height))
         ) {
+            const unsigned int width  = std::max(m_color_renderbuffer ? m_color_renderbuffer->width () : 0u, static_cast<unsigned int>(viewport.width));
+            const unsigned int height = std::max(m_color_renderbuffer ? m_color_renderbuffer->height() : 0u, static_cast<unsigned int>(viewport.height));
             m_color_renderbuffer = std::make_unique<Renderbuffer>(
                 m_graphics_instance,
                 gl::Internal_format::rgba8,
-                viewport.width,
-                viewport.height
+                width,
+                height
             );
             m_depth_renderbuffer = std::make_unique<Renderbuffer>(
                 m_graphics_instance,
                 gl::Internal_format::depth_component32f,
-                viewport.width,
-                viewport.height
+                width,
+                height
             );
             m_color_renderbuffer->set_debug_label("ID Color");
             m_depth_renderbuffer->set_debug_label("ID Depth");
@@ -313,18 +372,52 @@ void Id_renderer::render(const Render_parameters& parameters)
         return;
     }
 
+    auto& idr = current_id_frame_resources();
+    if (idr.frame_number != m_frame_number) {
+        // First region in this slot for this frame. The ring has wrapped, so
+        // a readback still in flight here is too old to be used.
+        if (idr.state == Id_frame_resources::State::Waiting_for_read) {
+            ++m_statistics.dropped;
+        }
+        idr.release_sync();
+        idr.regions.clear();
+        idr.frame_number = m_frame_number;
+        idr.state        = Id_frame_resources::State::Unused;
+    }
+
+    const int x_offset = std::max(x - (static_cast<int>(s_extent / 2)), 0);
+    const int y_offset = std::max(y - (static_cast<int>(s_extent / 2)), 0);
+
+    // A scene view rendered more than once in a frame reuses its region
+    // while the position stays inside it
+    for (const Id_region& region : idr.regions) {
+        if (
+            (region.scene_view == parameters.scene_view) &&
+            (region.viewport.width  == viewport.width) &&
+            (region.viewport.height == viewport.height) &&
+            (x >= region.x_offset) && (x < region.x_offset + static_cast<int>(s_extent)) &&
+            (y >= region.y_offset) && (y < region.y_offset + static_cast<int>(s_extent))
+        ) {
+            ++m_statistics.coalesced;
+            return;
+        }
+    }
+    if (idr.regions.size() >= s_max_regions_per_slot) {
+        ++m_statistics.dropped;
+        return;
+    }
+
     erhe::graphics::Scoped_debug_group debug_group{c_id_renderer_render_content};
     erhe::graphics::Scoped_gpu_timer   timer      {m_gpu_timer};
 
     update_framebuffer(viewport);
 
-    const auto projection_transforms = camera.projection_transforms(viewport);
-    const mat4 clip_from_world       = projection_transforms.clip_from_world.get_matrix();
-
-    auto& idr = current_id_frame_resources();
-    idr.x_offset        = std::max(x - (static_cast<int>(s_extent / 2)), 0);
-    idr.y_offset        = std::max(y - (static_cast<int>(s_extent / 2)), 0);
-    idr.clip_from_world = clip_from_world;
+    Id_region& region = idr.regions.emplace_back();
+    region.scene_view  = parameters.scene_view;
+    region.viewport    = viewport;
+    region.x_offset    = x_offset;
+    region.y_offset    = y_offset;
+    region.byte_offset = (idr.regions.size() - 1) * s_id_buffer_size;
 
     const auto camera_range = m_camera_buffers.update(
         *camera.projection(),
@@ -367,7 +460,7 @@ void Id_renderer::render(const Render_parameters& parameters)
         gl::disable    (gl::Enable_cap::framebuffer_srgb);
         gl::viewport   (viewport.x, viewport.y, viewport.width, viewport.height);
         if (m_use_scissor) {
-            gl::scissor(idr.x_offset, idr.y_offset, s_extent, s_extent);
+            gl::scissor(region.x_offset, region.y_offset, s_extent, s_extent);
             gl::enable (gl::Enable_cap::scissor_test);
         }
         gl::clear_color(1.0f, 1.0f, 1.0f, 0.1f);
@@ -416,12 +509,24 @@ void Id_renderer::render(const Render_parameters& parameters)
         if (m_use_scissor) {
             gl::disable(gl::Enable_cap::scissor_test);
         }
+        region.id_ranges.clear();
+        for (const erhe::scene_renderer::Primitive_buffer::Id_range& range : m_primitive_buffers.id_ranges()) {
+            region.id_ranges.push_back(
+                Id_region::Id_range{
+                    .offset          = range.offset,
+                    .length          = range.length,
+                    .mesh            = std::shared_ptr<erhe::scene::Mesh>{range.mesh->shared_from_this(), range.mesh},
+                    .primitive_index = range.primitive_index
+                }
+            );
+        }
+
         gl::bind_buffer(gl::Buffer_target::pixel_pack_buffer, idr.pixel_pack_buffer.gl_name());
-        void* const color_offset = nullptr;
-        void* const depth_offset = reinterpret_cast<void*>(s_extent * s_extent * 4);
+        void* const color_offset = reinterpret_cast<void*>(region.byte_offset);
+        void* const depth_offset = reinterpret_cast<void*>(region.byte_offset + s_extent * s_extent * 4);
         gl::read_pixels(
-            idr.x_offset,
-            idr.y_offset,
+            region.x_offset,
+            region.y_offset,
             s_extent,
             s_extent,
             gl::Pixel_format::rgba,
@@ -429,8 +534,8 @@ void Id_renderer::render(const Render_parameters& parameters)
             color_offset
         );
         gl::read_pixels(
-            idr.x_offset,
-            idr.y_offset,
+            region.x_offset,
+            region.y_offset,
             s_extent,
             s_extent,
             gl::Pixel_format::depth_component,
@@ -438,8 +543,12 @@ void Id_renderer::render(const Render_parameters& parameters)
             depth_offset
         );
         gl::bind_buffer(gl::Buffer_target::pixel_pack_buffer, 0);
-        idr.sync = gl::fence_sync(gl::Sync_condition::sync_gpu_commands_complete, 0);
-        idr.state = Id_frame_resources::State::Waiting_for_read;
+
+        // One fence per slot; it completes after reads of all regions in the slot
+        idr.release_sync();
+        idr.sync        = gl::fence_sync(gl::Sync_condition::sync_gpu_commands_complete, 0);
+        idr.submit_time = std::chrono::steady_clock::now();
+        idr.state       = Id_frame_resources::State::Waiting_for_read;
     }
 
     gl::enable(gl::Enable_cap::framebuffer_srgb);
@@ -454,76 +563,114 @@ inline T read_as(uint8_t const* raw_memory)
     return result;
 }
 
-auto Id_renderer::get(const int x, const int y, uint32_t& id, float& depth) -> bool
+void Id_renderer::poll(Id_frame_resources& idr)
 {
-    if (m_id_frame_resources.empty()) {
-        return false;
+    if (idr.state != Id_frame_resources::State::Waiting_for_read) {
+        return;
     }
-    int slot = static_cast<int>(m_current_id_frame_resource_slot);
-
-    for (size_t i = 0; i < s_frame_resources_count; ++i) {
-        --slot;
-        if (slot < 0) {
-            slot = s_frame_resources_count - 1;
-        }
-
-        auto& idr = m_id_frame_resources[slot];
-
-        if (idr.state == Id_frame_resources::State::Waiting_for_read) {
-            GLint sync_status = GL_UNSIGNALED;
-            gl::get_sync_iv(idr.sync, gl::Sync_parameter_name::sync_status, 4, nullptr, &sync_status);
-
-            if (sync_status == GL_SIGNALED) {
-                gl::bind_buffer(gl::Buffer_target::pixel_pack_buffer, idr.pixel_pack_buffer.gl_name());
-
-                auto gpu_data = idr.pixel_pack_buffer.map();
-
-                memcpy(&idr.data[0], gpu_data.data(), gpu_data.size_bytes());
-                idr.state = Id_frame_resources::State::Read_complete;
-            }
-        }
+    const gl::Sync_status result = gl::client_wait_sync(idr.sync, gl::Sync_object_mask::sync_flush_commands_bit, 0);
+    if (
+        (result == gl::Sync_status::already_signaled) ||
+        (result == gl::Sync_status::condition_satisfied)
+    ) {
+        idr.release_sync();
+        idr.state = Id_frame_resources::State::Read_complete;
+    }
+}
 
-        if (idr.state == Id_frame_resources::State::Read_complete) {
-            if ((x >= idr.x_offset) && (y >= idr.y_offset)) {
-                const int x_ = x - idr.x_offset;
-                const int y_ = y - idr.y_offset;
-                if ((static_cast<size_t>(x_) < s_extent) && (static_cast<size_t>(y_) < s_extent)) {
-                    const uint32_t       stride    = s_extent * 4;
-                    const uint8_t        r         = idr.data[x_ * 4 + y_ * stride + 0];
-                    const uint8_t        g         = idr.data[x_ * 4 + y_ * stride + 1];
-                    const uint8_t        b         = idr.data[x_ * 4 + y_ * stride + 2];
-                    const uint8_t* const depth_ptr = &idr.data[s_extent * s_extent * 4 + x_ * 4 + y_ * stride];
-                    id                             = (r << 16) | (g << 8) | b;
-                    depth                          = read_as<float>(depth_ptr);
-                    return true;
-                }
-            }
-        }
+auto Id_renderer::get(const Scene_view* scene_view, const int x, const int y, uint32_t& id, float& depth) -> bool
+{
+    const Id_query_result result = get(scene_view, x, y);
+    if (!result.valid) {
+        return false;
     }
-    return false;
+    id    = result.id;
+    depth = result.depth;
+    return true;
 }
 
-auto Id_renderer::get(const int x, const int y) -> Id_query_result
+auto Id_renderer::get(const Scene_view* scene_view, const int x, const int y) -> Id_query_result
 {
     Id_query_result result;
-    const bool ok = get(x, y, result.id, result.depth);
-    if (!ok) {
+    if (m_id_frame_resources.empty()) {
         return result;
     }
-    result.valid = true;
+    ++m_statistics.queries;
+
+    // Newest first; the current slot may already hold a readback from this frame
+    std::size_t slot = m_current_id_frame_resource_slot;
+    for (std::size_t i = 0; i < m_slot_count; ++i, slot = (slot + m_slot_count - 1) % m_slot_count) {
+        Id_frame_resources& idr = m_id_frame_resources[slot];
+        if (idr.state == Id_frame_resources::State::Unused) {
+            continue;
+        }
+        const uint64_t age = m_frame_number - idr.frame_number;
+        if (age > m_max_result_age) {
+            ++m_statistics.stale;
+            idr.release_sync();
+            idr.regions.clear();
+            idr.state = Id_frame_resources::State::Unused;
+            continue;
+        }
 
-    for (auto& r : m_primitive_buffers.id_ranges()) {
-        if (
-            (result.id >= r.offset) &&
-            (result.id < (r.offset + r.length))
-        ) {
-            result.mesh            = r.mesh;
-            result.primitive_index = r.primitive_index;
-            result.triangle_id     = result.id - r.offset;
+        poll(idr);
+        if (idr.state != Id_frame_resources::State::Read_complete) {
+            continue;
+        }
+
+        for (const Id_region& region : idr.regions) {
+            if ((region.scene_view != scene_view) || (x < region.x_offset) || (y < region.y_offset)) {
+                continue;
+            }
+            const std::size_t x_ = static_cast<std::size_t>(x - region.x_offset);
+            const std::size_t y_ = static_cast<std::size_t>(y - region.y_offset);
+            if ((x_ >= s_extent) || (y_ >= s_extent)) {
+                continue;
+            }
+
+            // Pixel pack buffers are persistently mapped and coherent, so
+            // pixels are read in place once the fence has completed
+            const std::span<std::byte> gpu_data = idr.pixel_pack_buffer.map();
+            const uint8_t* const data      = reinterpret_cast<const uint8_t*>(gpu_data.data()) + region.byte_offset;
+            const std::size_t    stride    = s_extent * 4;
+            const uint8_t        r         = data[x_ * 4 + y_ * stride + 0];
+            const uint8_t        g         = data[x_ * 4 + y_ * stride + 1];
+            const uint8_t        b         = data[x_ * 4 + y_ * stride + 2];
+            const uint8_t* const depth_ptr = &data[s_extent * s_extent * 4 + x_ * 4 + y_ * stride];
+            result.id    = (r << 16) | (g << 8) | b;
+            result.depth = read_as<float>(depth_ptr);
+            result.valid = true;
+
+            ++m_statistics.hits;
+            m_statistics.latency_frames     = age;
+            m_statistics.max_latency_frames = std::max(m_statistics.max_latency_frames, age);
+            m_statistics.latency_ms         = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - idr.submit_time).count();
+
+            for (const Id_region::Id_range& range : region.id_ranges) {
+                if (
+                    (result.id >= range.offset) &&
+                    (result.id < (range.offset + range.length))
+                ) {
+                    // Removed meshes and meshes with changed primitives are not reported
+                    std::shared_ptr<erhe::scene::Mesh> mesh = range.mesh.lock();
+                    if (
+                        !mesh ||
+                        (mesh->get_node() == nullptr) ||
+                        (range.primitive_index >= mesh->get_primitives().size())
+                    ) {
+                        return result;
+                    }
+                    result.mesh            = std::move(mesh);
+                    result.primitive_index = range.primitive_index;
+                    result.triangle_id     = result.id - range.offset;
+                    return result;
+                }
+            }
             return result;
         }
     }
 
+    ++m_statistics.misses;
     return result;
 }
 
@@ -10,6 +10,7 @@
 
 #include <glm/glm.hpp>
 
+#include <chrono>
 #include <memory>
 #include <vector>
 
@@ -34,21 +35,28 @@ namespace explorer {
 
 class Programs;
 class Mesh_memory;
+class Scene_view;
 
+// Renders ids into a small region around the cursor and reads it back
+// through a ring of pixel pack buffers. Reads never wait for the GPU: get()
+// uses the newest completed readback that covers the position, and readbacks
+// older than max_result_age frames are discarded. Several scene views can
+// request regions in the same frame; they share one ring slot and one fence.
 class Id_renderer
 {
 public:
-    bool enabled{true};
+    bool enabled          {true};
+    bool raytrace_fallback{false}; // Scene views use raytrace hover when no id result is ready
 
     class Id_query_result
     {
     public:
-        uint32_t           id             {0};
-        float              depth          {0.0f};
-        erhe::scene::Mesh* mesh           {nullptr};
-        std::size_t        primitive_index{0};
-        std::size_t        triangle_id    {std::numeric_limits<std::size_t>::max()};
-        bool               valid          {false};
+        uint32_t                           id             {0};
+        float                              depth          {0.0f};
+        std::shared_ptr<erhe::scene::Mesh> mesh;
+        std::size_t                        primitive_index{0};
+        std::size_t                        triangle_id    {std::numeric_limits<std::size_t>::max()};
+        bool                               valid          {false};
     };
 
     Id_renderer(
@@ -62,6 +70,7 @@ public:
     class Render_parameters
     {
     public:
+        const Scene_view*            scene_view          {nullptr};
         erhe::graphics::Buffer*      index_buffer        {nullptr};
         erhe::graphics::Buffer*      vertex_buffer       {nullptr};
         std::size_t                  vertex_buffer_offset{0};
@@ -74,15 +83,55 @@ public:
     };
     void render(const Render_parameters& parameters);
     void next_frame();
+    void imgui();
 
-    [[nodiscard]] auto get(const int x, const int y, uint32_t& id, float& depth) -> bool;
-    [[nodiscard]] auto get(const int x, const int y) -> Id_query_result;
+    [[nodiscard]] auto get(const Scene_view* scene_view, const int x, const int y, uint32_t& id, float& depth) -> bool;
+    [[nodiscard]] auto get(const Scene_view* scene_view, const int x, const int y) -> Id_query_result;
 
+    class Statistics
+    {
+    public:
+        std::size_t queries           {0};    // get() calls
+        std::size_t hits              {0};    // get() calls answered from a completed readback
+        std::size_t misses            {0};    // get() calls with no completed readback covering the position
+        std::size_t coalesced         {0};    // render() calls served by a region already read in the same frame
+        std::size_t dropped           {0};    // readbacks reused or refused before they completed
+        std::size_t stale             {0};    // readbacks discarded for being older than max_result_age
+        uint64_t    latency_frames    {0};    // frames from render() to the newest hit
+        uint64_t    max_latency_frames{0};    // largest latency_frames seen
+        float       latency_ms        {0.0f}; // time from render() to the newest hit
+    };
+
+    // Counts for the previous frame
+    [[nodiscard]] auto get_statistics() const -> const Statistics&;
 
 private:
-    static constexpr std::size_t s_frame_resources_count = 4;
-    static constexpr std::size_t s_extent                = 256;
-    static constexpr std::size_t s_id_buffer_size        = s_extent * s_extent * 8; // RGBA + depth
+    static constexpr std::size_t s_default_slot_count   = 6;
+    static constexpr std::size_t s_max_regions_per_slot = 2;
+    static constexpr std::size_t s_extent               = 256;
+    static constexpr std::size_t s_id_buffer_size       = s_extent * s_extent * 8; // RGBA + depth
+
+    class Id_region
+    {
+    public:
+        // Results are read up to m_max_result_age frames after render;
+        // meshes may have been removed by then
+        class Id_range
+        {
+        public:
+            uint32_t                         offset         {0};
+            uint32_t                         length         {0};
+            std::weak_ptr<erhe::scene::Mesh> mesh;
+            std::size_t                      primitive_index{0};
+        };
+
+        const Scene_view*     scene_view {nullptr};
+        erhe::math::Viewport  viewport   {0, 0, 0, 0, true};
+        int                   x_offset   {0};
+        int                   y_offset   {0};
+        std::size_t           byte_offset{0}; // color, followed by depth
+        std::vector<Id_range> id_ranges;      // copied at render, ids of later frames may differ
+    };
 
     class Id_frame_resources
     {
@@ -101,18 +150,20 @@ private:
         Id_frame_resources(Id_frame_resources&& other) noexcept;
         auto operator=(Id_frame_resources&& other) noexcept -> Id_frame_resources&;
 
+        void release_sync();
+
         erhe::graphics::Buffer                pixel_pack_buffer;
-        std::array<uint8_t, s_id_buffer_size> data;
-        GLsync                                sync           {0};
-        glm::mat4                             clip_from_world{1.0f};
-        int                                   x_offset       {0};
-        int                                   y_offset       {0};
-        State                                 state          {State::Unused};
+        std::vector<Id_region>                regions;
+        GLsync                                sync        {0};
+        uint64_t                              frame_number{0};
+        std::chrono::steady_clock::time_point submit_time;
+        State                                 state       {State::Unused};
     };
 
     [[nodiscard]] auto current_id_frame_resources() -> Id_frame_resources&;
     void create_id_frame_resources();
     void update_framebuffer       (const erhe::math::Viewport viewport);
+    void poll                     (Id_frame_resources& idr);
 
     bool                                          m_enabled{true};
     erhe::math::Viewport                          m_viewport{0, 0, 0, 0, true};
@@ -134,6 +185,11 @@ private:
     std::unique_ptr<erhe::graphics::Framebuffer>  m_framebuffer;
     std::vector<Id_frame_resources>               m_id_frame_resources;
     std::size_t                                   m_current_id_frame_resource_slot{0};
+    std::size_t                                   m_slot_count    {s_default_slot_count};
+    uint64_t                                      m_max_result_age{3};
+    uint64_t                                      m_frame_number  {1};
+    Statistics                                    m_statistics;
+    Statistics                                    m_last_frame_statistics;
     erhe::graphics::Gpu_timer                     m_gpu_timer;
 
     class Range
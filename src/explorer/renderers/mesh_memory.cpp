@@ -27,6 +27,16 @@ auto Mesh_memory::get_index_buffer_size() const -> std::size_t
     return static_cast<std::size_t>(index_buffer_size) * mega;
 }
 
+auto Mesh_memory::get_staging_buffer_size() const -> std::size_t
+{
+    int staging_buffer_size{16}; // in megabytes
+    const auto& ini = erhe::configuration::get_ini_file_section("erhe.ini", "mesh_memory");
+    ini.get("staging_buffer_size", staging_buffer_size);
+    std::size_t kilo = 1024;
+    std::size_t mega = 1024 * kilo;
+    return static_cast<std::size_t>(staging_buffer_size) * mega;
+}
+
 [[nodiscard]] auto Mesh_memory::get_vertex_buffer(std::size_t stream_index) -> erhe::graphics::Buffer*
 {
     switch (stream_index) {
@@ -36,8 +46,9 @@ auto Mesh_memory::get_index_buffer_size() const -> std::size_t
     }
 }
 
-Mesh_memory::Mesh_memory(erhe::graphics::Instance& graphics_instance, erhe::dataformat::Vertex_format& vertex_format)
+Mesh_memory::Mesh_memory(erhe::graphics::Instance& graphics_instance, erhe::dataformat::Vertex_format& vertex_format, tf::Executor* executor)
     : graphics_instance         {graphics_instance}
+    , gl_buffer_transfer_queue  {graphics_instance, get_staging_buffer_size()}
     , vertex_format             {vertex_format}
     , position_vertex_buffer{
         graphics_instance,
@@ -70,7 +81,8 @@ Mesh_memory::Mesh_memory(erhe::graphics::Instance& graphics_instance, erhe::data
     , buffer_info{
         .index_type    = erhe::dataformat::Format::format_32_scalar_uint,
         .vertex_format = vertex_format,
-        .buffer_sink   = graphics_buffer_sink
+        .buffer_sink   = graphics_buffer_sink,
+        .executor      = executor
     }
     //, build_info{
     //    .primitive_types{
@@ -19,13 +19,16 @@ namespace erhe::graphics {
 namespace erhe::scene_renderer {
     class Program_interface;
 }
+namespace tf {
+    class Executor;
+}
 
 namespace explorer {
 
 class Mesh_memory
 {
 public:
-    Mesh_memory(erhe::graphics::Instance& graphics_instance, erhe::dataformat::Vertex_format& vertex_format);
+    Mesh_memory(erhe::graphics::Instance& graphics_instance, erhe::dataformat::Vertex_format& vertex_format, tf::Executor* executor = nullptr);
 
     // TODO
     static constexpr std::size_t s_vertex_binding_position     = 0;
@@ -48,6 +51,7 @@ public:
 private:
     [[nodiscard]] auto get_vertex_buffer_size(std::size_t stream) const -> std::size_t;
     [[nodiscard]] auto get_index_buffer_size() const -> std::size_t;
+    [[nodiscard]] auto get_staging_buffer_size() const -> std::size_t;
 };
 
 } // namespace explorer
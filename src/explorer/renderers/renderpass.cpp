@@ -4,6 +4,7 @@
 #include "explorer_log.hpp"
 #include "explorer_rendering.hpp"
 #include "time.hpp"
+#include "operations/operation_stack.hpp"
 #include "renderers/mesh_memory.hpp"
 #include "renderers/render_context.hpp"
 #include "renderers/render_style.hpp"
@@ -197,7 +198,8 @@ void Renderpass::render(const Render_context& context) const
                 .error_shader_stages    = &context.explorer_context.programs->error.shader_stages,
                 .debug_joint_indices    = context.explorer_context.explorer_rendering->debug_joint_indices,
                 .debug_joint_colors     = context.explorer_context.explorer_rendering->debug_joint_colors,
-                .debug_label            = get_name()
+                .debug_label            = get_name(),
+                .executor               = &context.explorer_context.operation_stack->get_executor()
             }
         );
     }
@@ -11,6 +11,7 @@
 #include "erhe_graphics/shader_stages.hpp"
 #include "erhe_graphics/texture.hpp"
 #include "erhe_profile/profile.hpp"
+#include "erhe_rendergraph/transient_texture_pool.hpp"
 
 namespace explorer {
 
@@ -56,59 +57,54 @@ Post_processing_node::Post_processing_node(
     register_output(erhe::rendergraph::Routing::Resource_provided_by_consumer, "viewport", erhe::rendergraph::Rendergraph_node_key::viewport);
 }
 
-auto Post_processing_node::update_size() -> bool
+void Post_processing_node::request_transient_textures(erhe::rendergraph::Transient_texture_pool& pool)
 {
-    constexpr bool downsample_nodes_unchanged = true;
-    constexpr bool downsample_nodes_changed   = false;
+    using erhe::rendergraph::Transient_texture_pool;
+
+    downsample_request = Transient_texture_pool::c_no_request;
+    upsample_request   = Transient_texture_pool::c_no_request;
 
     // Output determines the size of intermediate nodes and size of the input node for the post processing render graph node.
     // Output *should* be multisample resolved
     const auto viewport = get_producer_output_viewport(erhe::rendergraph::Routing::Resource_provided_by_consumer, erhe::rendergraph::Rendergraph_node_key::viewport);
+    if ((viewport.width < 1) || (viewport.height < 1)) {
+        return;
+    }
+
+    const erhe::rendergraph::Transient_texture_desc desc{
+        .target          = gl::Texture_target::texture_2d,
+        .internal_format = gl::Internal_format::rgba16f, // TODO other formats
+        .sample_count    = 0,
+        .width           = viewport.width,
+        .height          = viewport.height,
+        .use_mipmaps     = true
+    };
 
-    if ((level0_width == viewport.width) && (level0_height == viewport.height)) {
-        return downsample_nodes_unchanged;
+    // Level 0 of downsample texture is the input, written by producer.
+    // Post_processing_window samples all levels when ImGui is rendered.
+    const int execution_index = get_execution_index();
+    const int last_use        = debug_view_visible ? Transient_texture_pool::c_end_of_frame : execution_index;
+    debug_view_visible = false;
+    downsample_request = pool.request(desc, get_first_use_execution_index(erhe::rendergraph::Rendergraph_node_key::viewport), last_use);
+    upsample_request   = pool.request(desc, execution_index, last_use);
+}
+
+void Post_processing_node::bind_transient_textures(const erhe::rendergraph::Transient_texture_pool& pool)
+{
+    std::shared_ptr<erhe::graphics::Texture> new_downsample_texture = pool.get(downsample_request);
+    std::shared_ptr<erhe::graphics::Texture> new_upsample_texture   = pool.get(upsample_request);
+    if ((new_downsample_texture == downsample_texture) && (new_upsample_texture == upsample_texture)) {
+        return;
     }
+    downsample_texture = std::move(new_downsample_texture);
+    upsample_texture   = std::move(new_upsample_texture);
+    update_levels();
+}
 
-    downsample_texture.reset();
-    upsample_texture.reset();
+void Post_processing_node::update_levels()
+{
     downsample_framebuffers.clear();
     upsample_framebuffers.clear();
-    level0_width  = viewport.width;
-    level0_height = viewport.height;
-    if (level0_width < 1 || level0_height < 1) {
-        return downsample_nodes_changed;
-    }
-
-    // Create textures
-    downsample_texture = std::make_shared<erhe::graphics::Texture>(
-        erhe::graphics::Texture::Create_info{
-            .instance        = graphics_instance,
-            .target          = gl::Texture_target::texture_2d,
-            .internal_format = gl::Internal_format::rgba16f, // TODO other formats
-            .use_mipmaps     = true,
-            .sample_count    = 0,
-            .width           = level0_width,
-            .height          = level0_height,
-            .debug_label     = fmt::format("{} downsample", get_name())
-        }
-    );
-    upsample_texture = std::make_shared<erhe::graphics::Texture>(
-        erhe::graphics::Texture::Create_info{
-            .instance        = graphics_instance,
-            .target          = gl::Texture_target::texture_2d,
-            .internal_format = gl::Internal_format::rgba16f, // TODO other formats
-            .use_mipmaps     = true,
-            .sample_count    = 0,
-            .width           = level0_width,
-            .height          = level0_height,
-            .debug_label     = fmt::format("{} upsample", get_name())
-        }
-    );
-
-    // Create framebuffers
-    int level_width  = level0_width;
-    int level_height = level0_height;
-    int level = 0;
     level_widths.clear();
     level_heights.clear();
     downsample_source_levels.clear();
@@ -116,6 +112,18 @@ auto Post_processing_node::update_size() -> bool
     downsample_texture_views.clear();
     upsample_texture_views.clear();
     weights.clear();
+    if (!downsample_texture || !upsample_texture) {
+        level0_width  = 0;
+        level0_height = 0;
+        return;
+    }
+    level0_width  = downsample_texture->width();
+    level0_height = downsample_texture->height();
+
+    // Create framebuffers
+    int level_width  = level0_width;
+    int level_height = level0_height;
+    int level = 0;
     while ((level_width >= 1) && (level_height >= 1)) {
         level_widths.push_back(level_width);
         level_heights.push_back(level_height);
@@ -187,7 +195,6 @@ auto Post_processing_node::update_size() -> bool
     }
 
     update_parameters();
-    return downsample_nodes_changed;
 }
 
 void Post_processing_node::update_parameters()
@@ -273,11 +280,7 @@ void Post_processing_node::execute_rendergraph_node()
     ERHE_PROFILE_FUNCTION();
     //ERHE_PROFILE_GPU_SCOPE(c_post_processing)
 
-    const bool downsample_nodes_unchanged = update_size();
-    if (!downsample_nodes_unchanged) {
-        return;
-    }
-
+    // Textures were updated in bind_transient_textures()
     if (!downsample_texture || !upsample_texture) {
         return;
     }
@@ -11,6 +11,7 @@
 #include "erhe_graphics/state/vertex_input_state.hpp"
 #include "erhe_renderer/gpu_ring_buffer.hpp"
 #include "erhe_rendergraph/rendergraph_node.hpp"
+#include "erhe_rendergraph/transient_texture_pool.hpp"
 
 #include <string_view>
 
@@ -51,11 +52,14 @@ public:
     // Override so that size is always sources from output
     auto get_consumer_input_viewport(erhe::rendergraph::Routing resource_routing, int key, int depth = 0) const -> erhe::math::Viewport override;
 
+    // Intermediate textures are transient, shared with other nodes when lifetimes do not overlap
+    void request_transient_textures(erhe::rendergraph::Transient_texture_pool& pool) override;
+    void bind_transient_textures   (const erhe::rendergraph::Transient_texture_pool& pool) override;
+
     // Public API
     void viewport_toolbar();
 
-    auto update_size() -> bool;
-
+    void update_levels    ();
     void update_parameters();
 
     erhe::graphics::Instance& graphics_instance;
@@ -75,6 +79,9 @@ public:
     std::vector<float>                                        weights;
     int                                                       level0_width  {0};
     int                                                       level0_height {0};
+    std::size_t                                               downsample_request{erhe::rendergraph::Transient_texture_pool::c_no_request};
+    std::size_t                                               upsample_request  {erhe::rendergraph::Transient_texture_pool::c_no_request};
+    bool                                                      debug_view_visible{false}; // set by Post_processing_window, textures are then kept until end of frame
     erhe::graphics::Buffer                                    parameter_buffer;
     float                                                     tonemap_luminance_max{1.5f};
     float                                                     tonemap_alpha{1.0f / 1.5f};
@@ -2,6 +2,7 @@
 
 #include "explorer_context.hpp"
 #include "explorer_log.hpp"
+#include "operations/operation_stack.hpp"
 #include "renderers/mesh_memory.hpp"
 
 #include "scene/scene_root.hpp"
@@ -139,7 +140,8 @@ void Shadow_render_node::execute_rendergraph_node()
             .mesh_spans            = { layers.content()->meshes },
             .lights                = layers.light()->lights,
             .skins                 = scene_root->get_scene().get_skins(),
-            .light_projections     = m_light_projections
+            .light_projections     = m_light_projections,
+            .executor              = &m_context.operation_stack->get_executor()
         }
     );
 }
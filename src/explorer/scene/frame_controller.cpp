@@ -221,6 +221,8 @@ void Frame_controller::update_fixed_step()
 {
     // TODO Only do once until next update()
     get_transform_from_node(get_node());
+    const glm::vec3 old_position    = m_position;
+    const glm::mat4 old_orientation = m_orientation;
 
     translate_x   .update();
     translate_y   .update();
@@ -265,7 +267,11 @@ void Frame_controller::update_fixed_step()
         apply_tumble(tumble_pivot.value(), rx, ry, rz);
     }
 
-    update();
+    // Node transform is not touched when controls are idle, so that idle
+    // frames do not look like transform changes (see Redraw_tracker)
+    if ((m_position != old_position) || (m_orientation != old_orientation)) {
+        update();
+    }
 }
 
 void Frame_controller::apply_rotation(float rx, float ry, float rz)
@@ -284,12 +290,17 @@ void Frame_controller::apply_rotation(float rx, float ry, float rz)
         glm::mat4 rotate = erhe::math::create_rotation<float>(rz, get_axis_z());
         new_orientation = rotate * new_orientation;
     }
-    m_orientation = new_orientation;
-    update();
+    if (new_orientation != m_orientation) {
+        m_orientation = new_orientation;
+        update();
+    }
 }
 
 void Frame_controller::apply_tumble(glm::vec3 pivot, float rx, float ry, float rz)
 {
+    if ((rx == 0.0f) && (ry == 0.0f) && (rz == 0.0f)) {
+        return;
+    }
     glm::mat4 new_orientation = m_orientation;
     if (rx != 0.0f) {
         glm::mat4 rotate = erhe::math::create_rotation<float>(rx, get_axis_x());
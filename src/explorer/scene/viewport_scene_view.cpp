@@ -7,6 +7,7 @@
 #include "explorer_message_bus.hpp"
 #include "explorer_rendering.hpp"
 #include "explorer_scenes.hpp"
+#include "operations/operation_stack.hpp"
 #include "renderers/id_renderer.hpp"
 #include "renderers/programs.hpp"
 #include "renderers/render_context.hpp"
@@ -150,9 +151,10 @@ void Viewport_scene_view::execute_rendergraph_node()
         return;
     }
 
-    scene_root->get_scene().update_node_transforms();
+    tf::Executor& executor = m_context.operation_stack->get_executor();
+    scene_root->get_scene().update_node_transforms(&executor);
 
-    m_context.tools->get_tool_scene_root()->get_hosted_scene()->update_node_transforms();
+    m_context.tools->get_tool_scene_root()->get_hosted_scene()->update_node_transforms(&executor);
 
     m_context.explorer_message_bus->send_message(
         Explorer_message{
@@ -326,7 +328,10 @@ void Viewport_scene_view::update_hover(bool ray_only)
     }
 
     if (m_context.id_renderer->enabled) {
-        update_hover_with_id_render();
+        const bool id_hover_ready = update_hover_with_id_render();
+        if (!id_hover_ready && m_context.id_renderer->raytrace_fallback) {
+            update_hover_with_raytrace();
+        }
     } else {
         update_hover_with_raytrace();
     }
@@ -335,25 +340,26 @@ void Viewport_scene_view::update_hover(bool ray_only)
 
 }
 
-void Viewport_scene_view::update_hover_with_id_render()
+auto Viewport_scene_view::update_hover_with_id_render() -> bool
 {
     if (!m_position_in_viewport.has_value()) {
         reset_hover_slots();
-        return;
+        return true;
     }
     const auto position_in_viewport = m_position_in_viewport.value();
     const auto id_query = m_context.id_renderer->get(
+        this,
         static_cast<int>(position_in_viewport.x),
         static_cast<int>(position_in_viewport.y)
     );
     if (!id_query.valid) {
         SPDLOG_LOGGER_TRACE(log_scene_view, "pointer context hover not valid");
-        return;
+        return false;
     }
 
     Hover_entry entry{
         .valid                      = id_query.valid,
-        .scene_mesh                 = id_query.mesh,
+        .scene_mesh                 = id_query.mesh.get(),
         .scene_mesh_primitive_index = id_query.primitive_index,
         .position                   = position_in_world_viewport_depth(id_query.depth),
         .triangle                   = static_cast<uint32_t>(id_query.triangle_id) // TODO Consider these types
@@ -408,6 +414,7 @@ void Viewport_scene_view::update_hover_with_id_render()
     set_hover(Hover_entry::tool_slot        , hover_tool         ? entry : Hover_entry{});
     set_hover(Hover_entry::brush_slot       , hover_brush        ? entry : Hover_entry{});
     set_hover(Hover_entry::rendertarget_slot, hover_rendertarget ? entry : Hover_entry{});
+    return true;
 }
 
 auto Viewport_scene_view::get_position_in_viewport() const -> std::optional<glm::vec2>
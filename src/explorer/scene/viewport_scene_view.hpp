@@ -130,7 +130,8 @@ public:
 private:
     [[nodiscard]] auto get_override_shader_stages() const -> const erhe::graphics::Shader_stages*;
 
-    void update_hover_with_id_render();
+    // Returns false when no id result covering the position is ready yet
+    auto update_hover_with_id_render() -> bool;
 
     static int s_serial;
 
@@ -104,6 +104,7 @@ Debug_visualizations::Debug_visualizations(
     explorer_rendering.add(this);
 
     explorer_message_bus.add_receiver(
+        Message_flag_bit::c_flag_bit_hover_scene_view,
         [&](Explorer_message& message) {
             using namespace erhe::bit;
             if (test_all_rhs_bits_set(message.update_flags, Message_flag_bit::c_flag_bit_hover_scene_view)) {
@@ -1009,7 +1010,7 @@ void Debug_visualizations::mesh_labels(const Render_context& context, erhe::scen
 
                 GEO::vec3f normal_sum{0.0f, 0.0f, 0.0f};
 
-                const std::vector<GEO::index_t>& facets = geometry->get_edge_facets(edge);
+                const std::span<const GEO::index_t> facets = geometry->get_edge_facets(edge);
                 for (GEO::index_t facet : facets) {
                     GEO::vec3f facet_normal = GEO::normalize(mesh_facet_normalf(geo_mesh, facet));
                     normal_sum += facet_normal;
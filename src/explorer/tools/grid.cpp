@@ -180,7 +180,10 @@ void Grid::render(const Render_context& context, bool major)
 
 void Grid::imgui(Explorer_context& context)
 {
-    ImGui::InputText  ("Name",             &m_name);
+    std::string name = get_name();
+    if (ImGui::InputText("Name", &name)) {
+        set_name(name);
+    }
     ImGui::Separator();
     bool visible = is_visible();
     if (ImGui::Checkbox("Visible", &visible)) {
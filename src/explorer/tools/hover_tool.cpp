@@ -43,6 +43,7 @@ Hover_tool::Hover_tool(
     tools.register_tool(this);
 
     explorer_message_bus.add_receiver(
+        Message_flag_bit::c_flag_bit_hover_scene_view | Message_flag_bit::c_flag_bit_render_scene_view,
         [&](Explorer_message& message) {
             Tool::on_message(message);
         }
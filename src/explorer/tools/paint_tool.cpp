@@ -178,6 +178,7 @@ Paint_tool::Paint_tool(
     m_ngon_colors.emplace_back(  0.0f / 255.0f,   0.0f / 255.0f,   0.0f / 255.0f, 1.0f);
 
     explorer_message_bus.add_receiver(
+        Message_flag_bit::c_flag_bit_hover_scene_view | Message_flag_bit::c_flag_bit_render_scene_view,
         [&](Explorer_message& message) {
             Tool::on_message(message);
         }
@@ -441,7 +442,7 @@ void Paint_tool::paint()
         }
         case Paint_mode::Point: {
             const GEO::index_t vertex = geo_mesh.facet_corners.vertex(nearest_corner);
-            const std::vector<GEO::index_t>& vertex_corners = geometry.get_vertex_corners(vertex);
+            const std::span<const GEO::index_t> vertex_corners = geometry.get_vertex_corners(vertex);
             for (GEO::index_t corner : vertex_corners) {
                 paint_corner(*content.scene_mesh, content.scene_mesh_primitive_index, corner, color);
             }
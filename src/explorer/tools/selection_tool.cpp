@@ -295,6 +295,7 @@ Selection::Selection(Explorer_context& explorer_context, Explorer_message_bus& e
     , m_range_selection               {*this}
 {
     explorer_message_bus.add_receiver(
+        Message_flag_bit::c_flag_bit_hover_scene_view,
         [&](Explorer_message& message) {
             using namespace erhe::bit;
             if (test_all_rhs_bits_set(message.update_flags, Message_flag_bit::c_flag_bit_hover_scene_view)) {
@@ -484,51 +485,18 @@ auto Selection::get(erhe::Item_filter filter, const std::size_t index) -> std::s
 }
 
 
-template <typename T>
-[[nodiscard]] auto is_in(const T& item, const std::vector<T>& items) -> bool
-{
-    return std::find(
-        items.begin(),
-        items.end(),
-        item
-    ) != items.end();
-}
-
-auto item_set_sort_predicate(const std::shared_ptr<erhe::Item_base>& lhs, const std::shared_ptr<erhe::Item_base>& rhs) -> bool {
-    const auto lhs_hierarchy = std::dynamic_pointer_cast<erhe::Hierarchy>(lhs);
-    const auto rhs_hierarchy = std::dynamic_pointer_cast<erhe::Hierarchy>(rhs);
-    if (lhs_hierarchy && rhs_hierarchy) {
-        const auto lhs_depth = lhs_hierarchy->get_depth();
-        const auto rhs_depth = rhs_hierarchy->get_depth();
-        if (lhs_depth != rhs_depth) {
-            return lhs_depth < rhs_depth;
-        }
-    }
-
-    const auto lhs_type = lhs->get_type();
-    const auto rhs_type = rhs->get_type();
-    if (lhs_type != rhs_type) {
-        return lhs_type < rhs_type;
-    }
-
-    const auto lhs_id = lhs->get_id();
-    const auto rhs_id = rhs->get_id();
-    return lhs_id < rhs_id;
-}
-
-[[nodiscard]] auto get_sorted(const std::vector<std::shared_ptr<erhe::Item_base>>& in_items) -> std::vector<std::shared_ptr<erhe::Item_base>>
-{
-    std::vector<std::shared_ptr<erhe::Item_base>> out_items = in_items;
-    std::sort(out_items.begin(), out_items.end(), item_set_sort_predicate);
-    return out_items;
-}
-
 void Selection::set_selection(const std::vector<std::shared_ptr<erhe::Item_base>>& selection)
 {
     Scoped_selection_change selection_change{*this};
 
+    std::unordered_set<const erhe::Item_base*> selection_set;
+    selection_set.reserve(selection.size());
+    for (const auto& item : selection) {
+        selection_set.insert(item.get());
+    }
+
     for (auto& item : m_selection) {
-        if (item->is_selected() && !is_in(item, selection)) {
+        if (item->is_selected() && !selection_set.contains(item.get())) {
             item->set_selected(false);
         }
     }
@@ -537,7 +505,8 @@ void Selection::set_selection(const std::vector<std::shared_ptr<erhe::Item_base>
         update_last_selected(item);
     }
 
-    m_selection = selection;
+    m_selection     = selection;
+    m_selection_set = std::move(selection_set);
 }
 
 Scoped_selection_change::Scoped_selection_change(Selection& selection)
@@ -566,26 +535,31 @@ void Selection::end_selection_change()
     if (m_selection_change_depth > 0) {
         return;
     }
-    const auto sorted_old = get_sorted(m_begin_selection_change_state);
-    const auto sorted_new = get_sorted(m_selection);
 
+    // Membership tests use the selection index, so computing the change is
+    // linear in selection size. Nothing is sent if the selection did not change.
     Explorer_message selection_changed_message{
         .update_flags = Message_flag_bit::c_flag_bit_selection,
     };
 
-    std::set_difference(
-        sorted_old.begin(), sorted_old.end(),
-        sorted_new.begin(), sorted_new.end(),
-        std::back_inserter(selection_changed_message.no_longer_selected),
-        item_set_sort_predicate
-    );
+    std::unordered_set<const erhe::Item_base*> old_selection_set;
+    old_selection_set.reserve(m_begin_selection_change_state.size());
+    for (const auto& item : m_begin_selection_change_state) {
+        old_selection_set.insert(item.get());
+        if (!m_selection_set.contains(item.get())) {
+            selection_changed_message.no_longer_selected.push_back(item);
+        }
+    }
+    for (const auto& item : m_selection) {
+        if (!old_selection_set.contains(item.get())) {
+            selection_changed_message.newly_selected.push_back(item);
+        }
+    }
+    m_begin_selection_change_state.clear();
 
-    std::set_difference(
-        sorted_new.begin(), sorted_new.end(),
-        sorted_old.begin(), sorted_old.end(),
-        std::back_inserter(selection_changed_message.newly_selected),
-        item_set_sort_predicate
-    );
+    if (selection_changed_message.no_longer_selected.empty() && selection_changed_message.newly_selected.empty()) {
+        return;
+    }
 
     m_context.explorer_message_bus->send_message(selection_changed_message);
 }
@@ -673,6 +647,7 @@ auto Selection::clear_selection() -> bool
 
     log_selection->trace("Clearing selection ({} items were selected)", m_selection.size());
     m_selection.clear();
+    m_selection_set.clear();
     m_range_selection.reset();
 #if !defined(NDEBUG)
     sanity_check();
@@ -739,7 +714,7 @@ auto Selection::is_in_selection(const std::shared_ptr<erhe::Item_base>& item) co
         return false;
     }
 
-    return std::find(m_selection.begin(), m_selection.end(), item) != m_selection.end();
+    return m_selection_set.contains(item.get());
 }
 
 auto Selection::add_to_selection(const std::shared_ptr<erhe::Item_base>& item) -> bool
@@ -755,7 +730,7 @@ auto Selection::add_to_selection(const std::shared_ptr<erhe::Item_base>& item) -
 
     item->set_selected(true);
 
-    if (!is_in_selection(item)) {
+    if (m_selection_set.insert(item.get()).second) {
         log_selection->trace("Adding {} to selection", item->get_name());
         m_selection.push_back(item);
         return true;
@@ -765,6 +740,26 @@ auto Selection::add_to_selection(const std::shared_ptr<erhe::Item_base>& item) -
     return false;
 }
 
+auto Selection::add_to_selection(const std::vector<std::shared_ptr<erhe::Item_base>>& items) -> std::size_t
+{
+    Scoped_selection_change selection_change{*this};
+
+    std::size_t added_count = 0;
+    for (const auto& item : items) {
+        if (!item) {
+            continue;
+        }
+        update_last_selected(item);
+        item->set_selected(true);
+        if (m_selection_set.insert(item.get()).second) {
+            m_selection.push_back(item);
+            ++added_count;
+        }
+    }
+    log_selection->trace("Added {} of {} items to selection", added_count, items.size());
+    return added_count;
+}
+
 auto Selection::remove_from_selection(const std::shared_ptr<erhe::Item_base>& item) -> bool
 {
     Scoped_selection_change selection_change{*this};
@@ -776,9 +771,9 @@ auto Selection::remove_from_selection(const std::shared_ptr<erhe::Item_base>& it
 
     item->set_selected(false);
 
-    const auto i = std::remove(m_selection.begin(), m_selection.end(), item);
-    if (i != m_selection.end()) {
+    if (m_selection_set.erase(item.get()) > 0) {
         log_selection->trace("Removing item {} from selection", item->get_name());
+        const auto i = std::remove(m_selection.begin(), m_selection.end(), item);
         m_selection.erase(i, m_selection.end());
         return true;
     }
@@ -787,21 +782,48 @@ auto Selection::remove_from_selection(const std::shared_ptr<erhe::Item_base>& it
     return false;
 }
 
+auto Selection::remove_from_selection(const std::vector<std::shared_ptr<erhe::Item_base>>& items) -> std::size_t
+{
+    Scoped_selection_change selection_change{*this};
+
+    std::size_t removed_count = 0;
+    for (const auto& item : items) {
+        if (!item) {
+            continue;
+        }
+        item->set_selected(false);
+        if (m_selection_set.erase(item.get()) > 0) {
+            ++removed_count;
+        }
+    }
+    if (removed_count > 0) {
+        // Single compaction pass keeps the order of remaining items
+        const auto i = std::remove_if(
+            m_selection.begin(),
+            m_selection.end(),
+            [this](const std::shared_ptr<erhe::Item_base>& item) {
+                return !m_selection_set.contains(item.get());
+            }
+        );
+        m_selection.erase(i, m_selection.end());
+    }
+    log_selection->trace("Removed {} of {} items from selection", removed_count, items.size());
+    return removed_count;
+}
+
 void Selection::update_selection_from_scene_item(const std::shared_ptr<erhe::Item_base>& item, const bool added)
 {
     Scoped_selection_change selection_change{*this};
 
     if (item->is_selected() && added) {
-        if (!is_in(item, m_selection)) {
+        if (m_selection_set.insert(item.get()).second) {
             m_selection.push_back(item);
             update_last_selected(item);
         }
     } else {
-        if (is_in(item, m_selection)) {
+        if (m_selection_set.erase(item.get()) > 0) {
             const auto i = std::remove(m_selection.begin(), m_selection.end(), item);
-            if (i != m_selection.end()) {
-                m_selection.erase(i, m_selection.end());
-            }
+            m_selection.erase(i, m_selection.end());
         }
     }
 }
@@ -819,13 +841,13 @@ void Selection::sanity_check()
             const auto item = std::static_pointer_cast<erhe::Item_base>(node);
             if (
                 node->is_selected() &&
-                !is_in(item, m_selection)
+                !is_in_selection(item)
             ) {
                 log_selection->error("Node has selection flag set without being in selection");
                 ++error_count;
             } else if (
                 !node->is_selected() &&
-                is_in(item, m_selection)
+                is_in_selection(item)
             ) {
                 log_selection->error("Node does not have selection flag set while being in selection");
                 ++error_count;
@@ -10,6 +10,7 @@
 
 #include <memory>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace erhe::commands {
@@ -182,8 +183,10 @@ public:
 
     void set_selection                   (const std::vector<std::shared_ptr<erhe::Item_base>>& selection);
     auto add_to_selection                (const std::shared_ptr<erhe::Item_base>& item) -> bool;
+    auto add_to_selection                (const std::vector<std::shared_ptr<erhe::Item_base>>& items) -> std::size_t;
     auto clear_selection                 () -> bool;
     auto remove_from_selection           (const std::shared_ptr<erhe::Item_base>& item) -> bool;
+    auto remove_from_selection           (const std::vector<std::shared_ptr<erhe::Item_base>>& items) -> std::size_t;
     void update_selection_from_scene_item(const std::shared_ptr<erhe::Item_base>& item, const bool added);
     void sanity_check                    ();
 
@@ -209,6 +212,7 @@ private:
 
     Scene_view*                                   m_hover_scene_view{nullptr};
     std::vector<std::shared_ptr<erhe::Item_base>> m_selection;
+    std::unordered_set<const erhe::Item_base*>    m_selection_set; // index for membership tests, same items as m_selection
     Range_selection                               m_range_selection;
     erhe::scene::Mesh*                            m_hover_mesh   {nullptr};
     bool                                          m_hover_content{false};
@@ -71,9 +71,7 @@ void Depth_to_color_rendergraph_node::execute_rendergraph_node()
 {
     SPDLOG_LOGGER_TRACE(log_render, "Depth_to_color_rendergraph_node::execute_rendergraph_node()");
 
-    // Execute base class in order to update texture and framebuffer
-    Texture_rendergraph_node::execute_rendergraph_node();
-
+    // Texture and framebuffer were updated by Texture_rendergraph_node::bind_transient_textures()
     if (!m_framebuffer) {
         // Likely because output ImGui window has no viewport size yet.
         return;
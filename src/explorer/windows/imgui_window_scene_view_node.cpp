@@ -7,6 +7,7 @@
 
 #include "explorer_context.hpp"
 #include "explorer_log.hpp"
+#include "redraw_tracker.hpp"
 #include "scene/viewport_scene_view.hpp"
 
 #include "erhe_defer/defer.hpp"
@@ -279,6 +280,9 @@ void Imgui_window_scene_view_node::imgui()
             const auto rect_min = ImGui::GetItemRectMin();
             const auto rect_max = ImGui::GetItemRectMax();
             drag_and_drop_target(rect_min.x, rect_min.y, rect_max.x, rect_max.y);
+            if (m_explorer_context.redraw_tracker != nullptr) {
+                m_explorer_context.redraw_tracker->hud_imgui(rect_min.x + 8.0f, rect_min.y + 8.0f);
+            }
             //ERHE_VERIFY(m_viewport.width  == static_cast<int>(rect_max.x - rect_min.x));
             //ERHE_VERIFY(m_viewport.height == static_cast<int>(rect_max.y - rect_min.y));
 
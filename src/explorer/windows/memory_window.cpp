@@ -0,0 +1,74 @@
+#include "windows/memory_window.hpp"
+
+#include "erhe_imgui/imgui_windows.hpp"
+#include "erhe_item/interned_string.hpp"
+#include "erhe_item/item_memory.hpp"
+#include "erhe_item/item_pool.hpp"
+#include "erhe_profile/profile.hpp"
+
+#include <imgui/imgui.h>
+
+#include <string>
+
+namespace explorer {
+
+Memory_window::Memory_window(
+    erhe::imgui::Imgui_renderer& imgui_renderer,
+    erhe::imgui::Imgui_windows&  imgui_windows
+)
+    : erhe::imgui::Imgui_window{imgui_renderer, imgui_windows, "Memory", "memory"}
+{
+}
+
+void Memory_window::imgui()
+{
+    ERHE_PROFILE_FUNCTION();
+
+    const std::vector<erhe::Item_type_memory> item_types = erhe::get_item_type_memory();
+    std::size_t total_count = 0;
+    std::size_t total_bytes = 0;
+    for (const erhe::Item_type_memory& item_type : item_types) {
+        total_count += item_type.live_count;
+        total_bytes += item_type.byte_count;
+    }
+
+    if (ImGui::CollapsingHeader("Items", ImGuiTreeNodeFlags_DefaultOpen)) {
+        ImGui::Text("%zu items, %zu bytes", total_count, total_bytes);
+        const ImGuiTableFlags flags = ImGuiTableFlags_Resizable | ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV;
+        if (ImGui::BeginTable("items", 4, flags)) {
+            ImGui::TableSetupColumn("Type",  ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableSetupColumn("Count", ImGuiTableColumnFlags_WidthFixed, 80.0f);
+            ImGui::TableSetupColumn("Size",  ImGuiTableColumnFlags_WidthFixed, 60.0f);
+            ImGui::TableSetupColumn("Bytes", ImGuiTableColumnFlags_WidthFixed, 100.0f);
+            ImGui::TableHeadersRow();
+            for (const erhe::Item_type_memory& item_type : item_types) {
+                if (item_type.live_count == 0) {
+                    continue;
+                }
+                const std::string type_name{item_type.type_name};
+                ImGui::TableNextRow();
+                ImGui::TableSetColumnIndex(0); ImGui::TextUnformatted(type_name.c_str());
+                ImGui::TableSetColumnIndex(1); ImGui::Text("%zu", item_type.live_count);
+                ImGui::TableSetColumnIndex(2); ImGui::Text("%zu", item_type.item_size);
+                ImGui::TableSetColumnIndex(3); ImGui::Text("%zu", item_type.byte_count);
+            }
+            ImGui::EndTable();
+        }
+    }
+
+    if (ImGui::CollapsingHeader("Interned Strings", ImGuiTreeNodeFlags_DefaultOpen)) {
+        const erhe::Interned_string_statistics strings = erhe::get_interned_string_statistics();
+        ImGui::Text("Entries:    %zu", strings.entry_count);
+        ImGui::Text("References: %zu", strings.reference_count);
+        ImGui::Text("Bytes:      %zu", strings.byte_count);
+    }
+
+    if (ImGui::CollapsingHeader("Item Pool", ImGuiTreeNodeFlags_DefaultOpen)) {
+        const erhe::Item_pool_statistics pool = erhe::get_item_pool_statistics();
+        ImGui::Text("Allocations: %zu", pool.allocation_count);
+        ImGui::Text("Used:        %zu bytes", pool.used_byte_count);
+        ImGui::Text("Reserved:    %zu bytes", pool.reserved_byte_count);
+    }
+}
+
+} // namespace explorer
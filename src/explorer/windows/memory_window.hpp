@@ -0,0 +1,25 @@
+#pragma once
+
+#include "erhe_imgui/imgui_window.hpp"
+
+namespace erhe::imgui {
+    class Imgui_windows;
+}
+
+namespace explorer {
+
+// Live item counts and sizes per item type, interned string table and
+// item pool usage
+class Memory_window : public erhe::imgui::Imgui_window
+{
+public:
+    Memory_window(
+        erhe::imgui::Imgui_renderer& imgui_renderer,
+        erhe::imgui::Imgui_windows&  imgui_windows
+    );
+
+    // Implements Imgui_window
+    void imgui() override;
+};
+
+}
@@ -21,12 +21,15 @@ Network_window::Network_window(
 )
     : erhe::imgui::Imgui_window{imgui_renderer, imgui_windows, "Network", "network"}
     , m_context                {explorer_context}
+    , m_graph_stream_client    {explorer_context}
 {
     const auto& ini = erhe::configuration::get_ini_file_section("erhe.ini", "network");
-    ini.get("upstream_address",   m_upstream_address);
-    ini.get("upstream_port",      m_upstream_port);
-    ini.get("downstream_address", m_downstream_address);
-    ini.get("downstream_port",    m_downstream_port);
+    ini.get("upstream_address",     m_upstream_address);
+    ini.get("upstream_port",        m_upstream_port);
+    ini.get("downstream_address",   m_downstream_address);
+    ini.get("downstream_port",      m_downstream_port);
+    ini.get("graph_stream_address", m_graph_stream_address);
+    ini.get("graph_stream_port",    m_graph_stream_port);
 
     m_client.set_receive_handler(
         [this](const uint8_t* data, const std::size_t length) {
@@ -43,14 +46,23 @@ Network_window::Network_window(
     set_developer();
 }
 
-void Network_window::update_network()
+auto Network_window::update_network() -> bool
 {
-    if (m_server.get_state() != erhe::net::Socket::State::CLOSED) {
+    const std::size_t              message_count = m_upstream_messages.size() + m_downstream_messages.size();
+    const erhe::net::Socket::State client_state  = m_client.get_state();
+    const erhe::net::Socket::State server_state  = m_server.get_state();
+    if (server_state != erhe::net::Socket::State::CLOSED) {
         m_server.poll(0);
     }
-    if (m_client.get_state() != erhe::net::Socket::State::CLOSED) {
+    if (client_state != erhe::net::Socket::State::CLOSED) {
         m_client.poll(0);
     }
+    const bool graph_stream_changed = m_graph_stream_client.update();
+    return
+        graph_stream_changed ||
+        (m_upstream_messages.size() + m_downstream_messages.size() != message_count) ||
+        (m_client.get_state() != client_state) ||
+        (m_server.get_state() != server_state);
 }
 
 void Network_window::imgui()
@@ -118,6 +130,25 @@ void Network_window::imgui()
         }
         ImGui::PopID();
     }
+
+    {
+        ImGui::PushID("Graph Stream");
+        ImGui::Text     ("Graph Stream");
+        ImGui::InputText("Producer Address", &m_graph_stream_address);
+        ImGui::DragInt  ("Producer Port",    &m_graph_stream_port, 0.1f, 1, 65535);
+        ImGui::Text     ("State: %s", c_str(m_graph_stream_client.get_state()));
+        if (m_graph_stream_client.get_state() == Socket::State::CLOSED) {
+            if (ImGui::Button("Connect")) {
+                m_graph_stream_client.connect(m_graph_stream_address.c_str(), m_graph_stream_port);
+            }
+        } else {
+            if (ImGui::Button("Disconnect")) {
+                m_graph_stream_client.disconnect();
+            }
+        }
+        m_graph_stream_client.imgui();
+        ImGui::PopID();
+    }
     ImGui::PopID();
 }
 
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "net/graph_stream_client.hpp"
+
 #include "erhe_imgui/imgui_window.hpp"
 #include "erhe_net/client.hpp"
 #include "erhe_net/server.hpp"
@@ -27,13 +29,15 @@ public:
     // Implements Imgui_window
     void imgui() override;
 
-    void update_network();
+    // Returns true if anything shown by the explorer may have changed
+    auto update_network() -> bool;
 
 private:
 
     Explorer_context&          m_context;
     erhe::net::Client        m_client;
     erhe::net::Server        m_server;
+    Graph_stream_client      m_graph_stream_client;
 
     // Network client
     std::string              m_upstream_address;
@@ -44,6 +48,10 @@ private:
     std::string              m_downstream_address;
     int                      m_downstream_port{0};
     std::vector<std::string> m_downstream_messages;
+
+    // Graph stream viewer
+    std::string              m_graph_stream_address;
+    int                      m_graph_stream_port{0};
 };
 
 } // namespace explorer
@@ -37,6 +37,9 @@ void Post_processing_window::imgui()
     if (node == nullptr) {
         return;
     }
+    // Keeps intermediate textures from being aliased before they are shown below
+    node->debug_view_visible = true;
+
     bool edited = false;
     if (ImGui::IsItemEdited()) edited = true;
     ImGui::SliderFloat("Size", &m_size, 0.0f, 1.0f, "%.3f", ImGuiSliderFlags_NoRoundToFormat);
@@ -13,6 +13,7 @@
 #include "erhe_imgui/imgui_renderer.hpp"
 #include "erhe_imgui/imgui_windows.hpp"
 #include "erhe_imgui/imgui_node_editor.h"
+#include "erhe_item/item_pool.hpp"
 
 #include <dfa/dfa.hpp>
 
@@ -254,6 +255,10 @@ auto Domain_flow_graph_file::load() -> bool
     m_dfg.reset();
     m_ui_nodes.clear();
 
+    // DomainFlowGraph::load() is the only parse. Graph editor nodes, hulls,
+    // wavefronts and properties all come from it, so node ids always agree.
+    // There is no mapped file fast path for .dfg: DomainFlowGraph can only
+    // be populated by its own stream parser.
     try {
         std::string file_name = erhe::file::to_string(get_source_path());
         m_dfg = std::make_shared<DomainFlowGraph>(file_name);
@@ -289,11 +294,12 @@ void Domain_flow_graph_file::show_in_graph_window(Graph_window* graph_window)
         const std::size_t     node_id = i.first;
         const DomainFlowNode& node    = i.second;
 
-        std::shared_ptr<Graph_node> ui_node = std::make_shared<Graph_node>(node.getName(), node_id);
+        std::shared_ptr<Graph_node> ui_node = erhe::make_pooled_item<Graph_node>(node.getName(), node_id);
         constexpr uint64_t flags = erhe::Item_flags::visible | erhe::Item_flags::content | erhe::Item_flags::show_in_ui;
         ui_node->enable_flag_bits(flags);
 
 		int depth = node.getDepth();
+        ui_node->set_depth(depth);
 		if (column_row_count.find(depth) == column_row_count.end()) {
 			column_row_count[depth] = 0;
 		}
@@ -326,8 +332,14 @@ void Domain_flow_graph_file::show_in_graph_window(Graph_window* graph_window)
         const std::size_t dst_slot    = edge.dstSlot;
         log_graph->info("  node link from node {} slot {} to node {} slot {}", src_node_id, src_slot, dst_node_id, dst_slot);
 
-        const std::shared_ptr<Graph_node>& src_node = m_ui_nodes.at(src_node_id);
-        const std::shared_ptr<Graph_node>& dst_node = m_ui_nodes.at(dst_node_id);
+        const auto src_i = m_ui_nodes.find(src_node_id);
+        const auto dst_i = m_ui_nodes.find(dst_node_id);
+        if ((src_i == m_ui_nodes.end()) || (dst_i == m_ui_nodes.end())) {
+            log_graph->error("edge from node {} to node {} refers to missing node", src_node_id, dst_node_id);
+            continue;
+        }
+        const std::shared_ptr<Graph_node>& src_node = src_i->second;
+        const std::shared_ptr<Graph_node>& dst_node = dst_i->second;
         if (src_node == nullptr) {
             log_graph->error("src_node is null");
             continue;
@@ -8,8 +8,6 @@
 #include <glm/gtc/constants.hpp>
 #include <glm/gtc/noise.hpp>
 
-#include <imgui/imgui.h>
-
 namespace hextiles
 {
 
@@ -25,15 +23,6 @@ void Fbm_noise::prepare()
     m_bounding = 1.0f / amp_fractal;
 }
 
-void Fbm_noise::imgui()
-{
-    ImGui::DragInt   ("Octaves",    &m_octaves,     0.1f,     1,         9);
-    ImGui::DragFloat ("Frequency",  &m_frequency,   0.1f,     0.001f,   10.0f);
-    ImGui::DragFloat ("Lacunarity", &m_lacunarity,  0.1f,     0.001f,   10.0f);
-    ImGui::DragFloat ("Gain",       &m_gain,        0.1f,     0.001f,    1.0f);
-    ImGui::DragFloat2("Location",   &m_location[0], 0.1f, -1000.0f,   1000.0f);
-}
-
 auto Fbm_noise::generate(const float s, const float t, const glm::vec4 seed) -> float
 {
     const float x = m_location[0] + std::cos(s * glm::two_pi<float>()) * m_frequency;
@@ -63,6 +52,42 @@ auto Fbm_noise::generate(float x, float y, float z, float w, const glm::vec4 see
     return sum;
 }
 
+auto Fbm_noise::get_wrap(const float u) const -> glm::vec2
+{
+    return glm::vec2{
+        std::cos(u * glm::two_pi<float>()) * m_frequency,
+        std::sin(u * glm::two_pi<float>()) * m_frequency
+    };
+}
+
+void Fbm_noise::generate_batch(
+    const glm::vec2        s_wrap,
+    const glm::vec2        t_wrap,
+    const glm::vec4* const seeds,
+    float* const           out_values,
+    const std::size_t      seed_count
+) const
+{
+    glm::vec4 position{
+        m_location[0] + s_wrap.x,
+        m_location[1] + t_wrap.x,
+        m_location[0] + s_wrap.y,
+        m_location[1] + t_wrap.y
+    };
+    for (std::size_t i = 0; i < seed_count; ++i) {
+        out_values[i] = 0.0f;
+    }
+
+    float amp = m_bounding;
+    for (int octave = 0; octave < m_octaves; ++octave) {
+        for (std::size_t i = 0; i < seed_count; ++i) {
+            out_values[i] += glm::simplex(seeds[i] + position) * amp;
+        }
+        position *= m_lacunarity;
+        amp *= m_gain;
+    }
+}
+
 } // namespace hextiles
 
 #ifdef _MSC_VER
@@ -2,6 +2,8 @@
 
 #include <glm/glm.hpp>
 
+#include <cstddef>
+
 namespace hextiles {
 
 class Fbm_noise
@@ -9,7 +11,22 @@ class Fbm_noise
 public:
     void prepare ();
     auto generate(float s, float t, glm::vec4 seed) -> float;
-    void imgui   ();
+    auto imgui   () -> bool; // returns true if parameters were changed; in fbm_noise_imgui.cpp
+
+    // Returns {cos, sin} of u around the unit circle, scaled by frequency.
+    // Map coordinates are wrapped this way so that noise tiles seamlessly.
+    [[nodiscard]] auto get_wrap(float u) const -> glm::vec2;
+
+    // Evaluates noise for several seeds at a single tile, using coordinates
+    // prepared with get_wrap(). Octaves are the outer loop so the octave
+    // coordinates are computed once and shared by all seeds.
+    void generate_batch(
+        glm::vec2        s_wrap,
+        glm::vec2        t_wrap,
+        const glm::vec4* seeds,
+        float*           out_values,
+        std::size_t      seed_count
+    ) const;
 
 private:
     auto generate(float x, float y, float z, float w, glm::vec4 seed) -> float;
@@ -0,0 +1,19 @@
+#include "map_generator/fbm_noise.hpp"
+
+#include <imgui/imgui.h>
+
+namespace hextiles
+{
+
+auto Fbm_noise::imgui() -> bool
+{
+    bool changed = false;
+    changed |= ImGui::DragInt   ("Octaves",    &m_octaves,     0.1f,     1,         9);
+    changed |= ImGui::DragFloat ("Frequency",  &m_frequency,   0.1f,     0.001f,   10.0f);
+    changed |= ImGui::DragFloat ("Lacunarity", &m_lacunarity,  0.1f,     0.001f,   10.0f);
+    changed |= ImGui::DragFloat ("Gain",       &m_gain,        0.1f,     0.001f,    1.0f);
+    changed |= ImGui::DragFloat2("Location",   &m_location[0], 0.1f, -1000.0f,   1000.0f);
+    return changed;
+}
+
+} // namespace hextiles
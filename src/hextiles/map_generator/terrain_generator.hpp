@@ -0,0 +1,61 @@
+#pragma once
+
+#include "map_generator/biome.hpp"
+#include "map_generator/fbm_noise.hpp"
+#include "map_generator/variations.hpp"
+
+#include "coordinate.hpp"
+#include "terrain_type.hpp"
+#include "types.hpp"
+
+#include "etl/vector.h"
+
+namespace tf {
+    class Executor;
+}
+
+namespace hextiles {
+
+class Map;
+class Tiles;
+
+// Generates map terrain from noise. Has no UI dependencies, so it can be
+// used by Map_generator window and by headless tools.
+class Terrain_generator
+{
+public:
+    // Noise and per tile passes are split by map column across executor
+    // workers. Without executor, all passes run on the calling thread.
+    Terrain_generator(Tiles& tiles, tf::Executor* executor);
+
+    void generate                 (Map& map);
+    void update_elevation_terrains();
+
+    [[nodiscard]] auto get_noise                () -> Fbm_noise&;
+    [[nodiscard]] auto get_elevation_generator  () -> Variations&;
+    [[nodiscard]] auto get_last_generate_time_ms() const -> float;
+
+private:
+    void generate_noise_pass       (Map& map);
+    void generate_base_terrain_pass(Map& map);
+    auto get_variation             (terrain_t base_terrain, float temperature, float humidity) const -> terrain_t;
+    void generate_variation_pass   (Map& map);
+    void apply_rule                (Map& map, const Terrain_replacement_rule& rule);
+    void generate_apply_rules_pass (Map& map);
+    void generate_group_fix_pass   (Map& map);
+
+    Tiles&        m_tiles;
+    tf::Executor* m_executor{nullptr};
+
+    Fbm_noise     m_noise;
+    Variations    m_elevation_generator  {};
+    Variations    m_temperature_generator{};
+    Variations    m_humidity_generator   {};
+    Variations    m_variation_generator  {};
+
+    etl::vector<Biome, max_biome_count> m_biomes;
+
+    float         m_last_generate_time_ms{0.0f};
+};
+
+} // namespace hextiles
@@ -10,17 +10,25 @@ namespace hextiles
 
 void Variations::reset(size_t count)
 {
-    m_values.reserve(count);
-    m_values.clear();
+    m_values.resize(count);
     m_min_value = std::numeric_limits<float>::max();
     m_max_value = std::numeric_limits<float>::lowest();
 }
 
-void Variations::push(float value)
+void Variations::set(size_t index, float value)
 {
-    m_values.push_back(value);
-    m_min_value = std::min(m_min_value, value);
-    m_max_value = std::max(m_max_value, value);
+    ERHE_VERIFY(index < m_values.size());
+    m_values[index] = value;
+}
+
+void Variations::update_value_range()
+{
+    m_min_value = std::numeric_limits<float>::max();
+    m_max_value = std::numeric_limits<float>::lowest();
+    for (const float value : m_values) {
+        m_min_value = std::min(m_min_value, value);
+        m_max_value = std::max(m_max_value, value);
+    }
 }
 
 auto Variations::get_noise_value(size_t index) const -> float
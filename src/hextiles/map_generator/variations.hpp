@@ -11,7 +11,8 @@ class Variations
 {
 public:
     void reset                   (size_t count);
-    void push                    (float value);
+    void set                     (size_t index, float value); // safe to call concurrently for distinct indices
+    void update_value_range      ();                          // call after all values have been set
     auto get_noise_value         (size_t index) const -> float;
     auto normalize               ();
     void compute_threshold_values();
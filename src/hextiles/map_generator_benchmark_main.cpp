@@ -0,0 +1,132 @@
+// Headless map generator benchmark. Loads terrain definitions from res/,
+// generates maps of several sizes without executor and with an executor,
+// and checks that both produce identical terrain tiles. Run from the
+// hextiles directory.
+//
+//   map-generator-benchmark --iterations 5
+
+#include "hextiles_log.hpp"
+#include "map.hpp"
+#include "map_generator/terrain_generator.hpp"
+#include "tiles.hpp"
+
+#include "erhe_log/log.hpp"
+
+#include <cxxopts.hpp>
+#include <fmt/format.h>
+#include <taskflow/taskflow.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+class Options
+{
+public:
+    Options(int argc, char** argv)
+    {
+        cxxopts::Options options{"map-generator-benchmark", "Times serial and parallel hextiles map generation"};
+
+        options.add_options()
+            ("iterations", "Number of timed runs for each map size and mode",  cxxopts::value<int>()->default_value("5"), "<count>")
+            ("threads",    "Executor worker count, 0 for hardware concurrency", cxxopts::value<int>()->default_value("0"), "<count>")
+            ("help",       "Print help");
+
+        try {
+            auto arguments = options.parse(argc, argv);
+            if (arguments.count("help")) {
+                fmt::print("{}\n", options.help());
+                return;
+            }
+            iterations = std::max(1, arguments["iterations"].as<int>());
+            threads    = std::max(0, arguments["threads"   ].as<int>());
+            valid      = true;
+        } catch (const std::exception& e) {
+            fmt::print("Error parsing command line arguments: {}\n", e.what());
+        }
+    }
+
+    bool valid     {false};
+    int  iterations{0};
+    int  threads   {0};
+};
+
+namespace {
+
+using hextiles::coordinate_t;
+using hextiles::Map;
+using hextiles::Terrain_generator;
+using hextiles::Tile_coordinate;
+
+// Map storage holds at most 160 x 160 tiles
+constexpr int c_map_sizes[] = { 32, 64, 96, 128, 160 };
+
+auto time_generate(Terrain_generator& generator, Map& map, const int size, const int iterations) -> double
+{
+    double best_ms = 0.0;
+    for (int i = 0; i < iterations; ++i) {
+        map.reset(size, size);
+        const auto start = std::chrono::steady_clock::now();
+        generator.generate(map);
+        const auto end = std::chrono::steady_clock::now();
+        const double ms = std::chrono::duration<double, std::milli>(end - start).count();
+        best_ms = (i == 0) ? ms : std::min(best_ms, ms);
+    }
+    return best_ms;
+}
+
+auto same_terrain(const Map& lhs, const Map& rhs) -> bool
+{
+    if ((lhs.width() != rhs.width()) || (lhs.height() != rhs.height())) {
+        return false;
+    }
+    for (coordinate_t tx = 0; tx < lhs.width(); ++tx) {
+        for (coordinate_t ty = 0; ty < lhs.height(); ++ty) {
+            const Tile_coordinate position{tx, ty};
+            if (lhs.get_terrain_tile(position) != rhs.get_terrain_tile(position)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+auto main(int argc, char** argv) -> int
+{
+    Options options{argc, argv};
+    if (!options.valid) {
+        return 1;
+    }
+
+    erhe::log::console_init();
+    erhe::log::log_to_console();
+    erhe::log::initialize_log_sinks();
+    hextiles::initialize_logging();
+
+    hextiles::Tiles tiles;
+    tf::Executor    executor{(options.threads > 0) ? static_cast<std::size_t>(options.threads) : std::max(1u, std::thread::hardware_concurrency())};
+
+    Terrain_generator serial_generator  {tiles, nullptr};
+    Terrain_generator parallel_generator{tiles, &executor};
+
+    // Map is large for the stack
+    const std::unique_ptr<Map> serial_map   = std::make_unique<Map>();
+    const std::unique_ptr<Map> parallel_map = std::make_unique<Map>();
+
+    fmt::print("best of {}, {} workers\n", options.iterations, executor.num_workers());
+    bool all_match = true;
+    for (const int size : c_map_sizes) {
+        const double serial_ms   = time_generate(serial_generator,   *serial_map,   size, options.iterations);
+        const double parallel_ms = time_generate(parallel_generator, *parallel_map, size, options.iterations);
+        const bool   match       = same_terrain(*serial_map, *parallel_map);
+        all_match = all_match && match;
+        fmt::print(
+            "{:3} x {:3}  serial {:8.2f} ms  parallel {:8.2f} ms  speedup {:5.2f}x{}\n",
+            size, size, serial_ms, parallel_ms, serial_ms / parallel_ms, match ? "" : "  DIFFERS"
+        );
+    }
+    return all_match ? 0 : 1;
+}